@@ -23,5 +23,5 @@ void Ram_session_component::_revoke_ram_ds(Dataspace_component *ds) { }
 
 void Ram_session_component::_clear_ds(Dataspace_component *ds)
 {
-	memset((void *)ds->phys_addr(), 0, ds->size());
+	memclear((void *)ds->phys_addr(), ds->size());
 }
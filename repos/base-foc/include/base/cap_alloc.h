@@ -18,6 +18,7 @@
 #include <base/native_types.h>
 #include <util/assert.h>
 #include <util/construct_at.h>
+#include <util/misc_math.h>
 
 namespace Genode {
 
@@ -45,6 +46,30 @@ namespace Genode {
 				START_IDX = Fiasco::USER_BASE_CAP >> Fiasco::L4_CAP_SHIFT
 			};
 
+			unsigned _next = START_IDX; /* start of next search */
+
+			/**
+			 * Find and initialize 'cnt' unused, consecutive entries within
+			 * the index range from 'first' to 'last'
+			 */
+			T *_alloc_range(unsigned first, unsigned last, size_t cnt)
+			{
+				for (unsigned i = first, j = 0; (i+cnt) < last; i+=j+1, j=0) {
+					for (; j < cnt; j++)
+						if (_indices[i+j].used())
+							break;
+
+					/* if we found a fitting hole, initialize the objects */
+					if (j == cnt) {
+						for (j = 0; j < cnt; j++)
+							new (&_indices[i+j]) T();
+						_next = i + cnt;
+						return &_indices[i];
+					}
+				}
+				return 0;
+			}
+
 		protected:
 
 			unsigned char _data[SZ*sizeof(T)];
@@ -65,20 +90,19 @@ namespace Genode {
 				Lock_guard<Spin_lock> guard(_lock);
 
 				/*
-				 * iterate through array and find unused, consecutive entries
+				 * Search the array in a next-fit manner, beginning behind
+				 * the most recent allocation. This way, the costs of an
+				 * allocation do not grow with the number of indices in use
+				 * as long as there are unused entries at the end of the
+				 * array. Only if the end is reached, we search from the
+				 * start for the holes left behind by freed indices.
 				 */
-				for (unsigned i = START_IDX, j = 0; (i+cnt) < SZ; i+=j+1, j=0) {
-					for (; j < cnt; j++)
-						if (_indices[i+j].used())
-							break;
+				if (T *obj = _alloc_range(_next, SZ, cnt))
+					return obj;
+
+				if (T *obj = _alloc_range(START_IDX, min<size_t>(_next + cnt, SZ), cnt))
+					return obj;
 
-					/* if we found a fitting hole, initialize the objects */
-					if (j == cnt) {
-						for (j = 0; j < cnt; j++)
-							new (&_indices[i+j]) T();
-						return &_indices[i];
-					}
-				}
 				ASSERT(0, "cap index allocation failed");
 				return 0;
 			}
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -21,3 +21,21 @@ void Genode::cache_coherent(Genode::addr_t addr, Genode::size_t size)
 {
 	Fiasco::l4_cache_coherent(addr, addr + size);
 }
+
+
+void Genode::cache_clean(Genode::addr_t addr, Genode::size_t size)
+{
+	Fiasco::l4_cache_clean_data(addr, addr + size);
+}
+
+
+void Genode::cache_invalidate(Genode::addr_t addr, Genode::size_t size)
+{
+	Fiasco::l4_cache_inv_data(addr, addr + size);
+}
+
+
+void Genode::cache_clean_invalidate(Genode::addr_t addr, Genode::size_t size)
+{
+	Fiasco::l4_cache_flush_data(addr, addr + size);
+}
@@ -14,6 +14,7 @@
 /* core includes */
 #include <rm_session_component.h>
 #include <map_local.h>
+#include <platform_pd.h>
 
 using namespace Genode;
 
@@ -22,3 +23,54 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 	// TODO unmap it only from target space
 	unmap_local(core_local_base, size >> get_page_size_log2());
 }
+
+
+void Rm_client::prefault(Rm_region const &region)
+{
+	using namespace Fiasco;
+
+	Dataspace_component * const dsc = region.dataspace();
+
+	/* I/O memory is not mapped within core, leave it to the pager */
+	if (dsc->is_io_mem())
+		return;
+
+	Locked_ptr<Address_space> locked_address_space(_address_space);
+	if (!locked_address_space.is_valid())
+		return;
+
+	Platform_pd &pd = static_cast<Platform_pd &>(*locked_address_space);
+
+	l4_umword_t cache = L4_FPAGE_CACHEABLE << 4;
+	if (dsc->cacheability() != CACHED)
+		cache = L4_FPAGE_BUFFERABLE << 4;
+
+	unsigned char const rights = dsc->writable() ? L4_FPAGE_RWX : L4_FPAGE_RX;
+
+	addr_t src  = dsc->core_local_addr() + region.offset();
+	addr_t dst  = region.base();
+	size_t size = region.size();
+
+	/* map the region with a few large flexpages instead of page by page */
+	while (size >= get_page_size()) {
+
+		/* largest flexpage aligned at both addresses that fits the rest */
+		size_t order = get_page_size_log2();
+		while (order < get_super_page_size_log2()
+		    && !((src | dst) & ((1UL << (order + 1)) - 1))
+		    && size >= (1UL << (order + 1)))
+			order++;
+
+		l4_msgtag_t tag = l4_task_map(pd.native_task().dst(), L4_BASE_TASK_CAP,
+		                              l4_fpage(src, order, rights),
+		                              dst | L4_ITEM_MAP | cache);
+		if (l4_msgtag_has_error(tag)) {
+			PWRN("could not prefault 0x%lx", dst);
+			return;
+		}
+
+		src  += 1UL << order;
+		dst  += 1UL << order;
+		size -= 1UL << order;
+	}
+}
@@ -25,6 +25,11 @@ namespace Kernel
 
 	constexpr capid_t cap_id_invalid() { return 0; }
 
+	/**
+	 * Maximum number of signal contexts delivered by one 'await_signals'
+	 */
+	constexpr unsigned max_signal_batch() { return 32; }
+
 	/**
 	 * Kernel names of the kernel calls
 	 */
@@ -43,6 +48,8 @@ namespace Kernel
 	constexpr Call_arg call_id_update_instr_region()  { return 12; }
 	constexpr Call_arg call_id_ack_cap()              { return 13; }
 	constexpr Call_arg call_id_delete_cap()           { return 14; }
+	constexpr Call_arg call_id_await_signals()        { return 38; }
+	constexpr Call_arg call_id_ack_signals()          { return 39; }
 
 
 	/*****************************************************************
@@ -228,6 +235,29 @@ namespace Kernel
 	}
 
 
+	/**
+	 * Await any contexts of a receiver and receive them all at once
+	 *
+	 * \param receiver_id  capability id of the targeted signal receiver
+	 * \param max          maximum number of contexts to receive
+	 *
+	 * \retval  0  suceeded
+	 * \retval -1  failed
+	 *
+	 * Like 'await_signal' but if this call returns 0, an array of up to 'max'
+	 * instances of 'Signal::Data' is located at the base of the callers
+	 * UTCB, one for each context with pending signals. If less than 'max'
+	 * contexts were delivered, the array is terminated by an instance with
+	 * an invalid context pointer. Each delivered context must be
+	 * acknowledged, e.g., via 'ack_signals'. The value of 'max' is limited
+	 * to 'max_signal_batch()'.
+	 */
+	inline int await_signals(capid_t const receiver_id, unsigned const max)
+	{
+		return call(call_id_await_signals(), receiver_id, max);
+	}
+
+
 	/**
 	 * Trigger a specific signal context
 	 *
@@ -254,6 +284,20 @@ namespace Kernel
 	}
 
 
+	/**
+	 * Acknowledge the last deliveries of multiple signal contexts
+	 *
+	 * \param num  number of contexts, limited to 'max_signal_batch()'
+	 *
+	 * The capability ids of the targeted contexts are expected as an array
+	 * of 'capid_t' at the base of the callers UTCB.
+	 */
+	inline void ack_signals(unsigned const num)
+	{
+		call(call_id_ack_signals(), num);
+	}
+
+
 	/**
 	 * Halt processing of a signal context synchronously
 	 *
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -19,3 +19,22 @@ void Genode::cache_coherent(Genode::addr_t addr, Genode::size_t size)
 {
 	Kernel::update_instr_region(addr, size);
 }
+
+
+/*
+ * The kernel has no selective maintenance of the data cache for user-level
+ * callers. It writes back and invalidates the whole data cache instead,
+ * which is a correct implementation of all three operations. Hence, one
+ * kernel call suffices for a buffer of any size.
+ */
+
+void Genode::cache_clean(Genode::addr_t addr, Genode::size_t size) {
+	Kernel::update_data_region(addr, size); }
+
+
+void Genode::cache_invalidate(Genode::addr_t addr, Genode::size_t size) {
+	Kernel::update_data_region(addr, size); }
+
+
+void Genode::cache_clean_invalidate(Genode::addr_t addr, Genode::size_t size) {
+	Kernel::update_data_region(addr, size); }
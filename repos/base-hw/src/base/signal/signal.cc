@@ -15,6 +15,7 @@
 #include <base/thread.h>
 #include <base/signal.h>
 #include <signal_session/connection.h>
+#include <util/string.h>
 
 /* base-hw includes */
 #include <kernel/interface.h>
@@ -117,24 +118,31 @@ Signal_context_capability Signal_receiver::manage(Signal_context * const c)
 
 void Signal_receiver::block_for_signal()
 {
-	/* wait for a signal */
-	if (Kernel::await_signal(_cap.dst())) {
+	enum { MAX = Kernel::max_signal_batch() };
+
+	/* wait for signals, receive all pending contexts at once */
+	if (Kernel::await_signals(_cap.dst(), MAX)) {
 		PERR("failed to receive signal");
 		return;
 	}
 	/* read signal data */
-	const void * const     utcb    = Thread_base::myself()->utcb()->base();
-	Signal::Data * const   data    = (Signal::Data *)utcb;
-	Signal_context * const context = data->context;
-	{
+	void * const         utcb = Thread_base::myself()->utcb()->base();
+	Signal::Data * const data = (Signal::Data *)utcb;
+	Kernel::capid_t      acks[MAX];
+	unsigned             num  = 0;
+	for (; num < MAX && data[num].context; num++) {
+
 		/* update signal context */
+		Signal_context * const context = data[num].context;
 		Lock::Guard lock_guard(context->_lock);
-		unsigned const num    = context->_curr_signal.num + data->num;
+		unsigned const n      = context->_curr_signal.num + data[num].num;
 		context->_pending     = true;
-		context->_curr_signal = Signal::Data(context, num);
+		context->_curr_signal = Signal::Data(context, n);
+		acks[num]             = context->_cap.dst();
 	}
-	/* end kernel-aided life-time management */
-	Kernel::ack_signal(data->context->_cap.dst());
+	/* end kernel-aided life-time management of all contexts at once */
+	memcpy(utcb, acks, num * sizeof(acks[0]));
+	Kernel::ack_signals(num);
 }
 
 
@@ -19,6 +19,9 @@ namespace Kernel
 	enum {
 		DEFAULT_STACK_SIZE = 16 * 1024,
 		DEFAULT_TRANSLATION_TABLE_MAX = 128,
+
+		/* tables per PD that core pays for, further ones are on the PD */
+		DEFAULT_TRANSLATION_TABLE_POOL = 16,
 	};
 
 	/* amount of priority bands amongst quota owners in CPU scheduling */
@@ -29,6 +32,12 @@ namespace Kernel
 
 	/* time slice for the round-robin mode and the idle in CPU scheduling */
 	constexpr unsigned cpu_fill_ms = 10;
+
+	/* let idle CPUs take over best-effort threads of loaded CPUs */
+	constexpr bool cpu_balancing = false;
+
+	/* program the CPU timer for the next scheduling event only */
+	constexpr bool cpu_tickless = true;
 }
 
 #endif /* _KERNEL__CONFIGURATION_H_ */
@@ -101,15 +101,17 @@ namespace Kernel
 	 * \param cpu_id  kernel name of the targeted CPU
 	 * \param pd      pointer to pd kernel object
 	 * \param utcb    core local pointer to userland thread-context
+	 * \param mask    bit mask of the CPUs the thread may be migrated to
 	 *
 	 * \retval   0  suceeded
 	 * \retval !=0  failed
 	 */
 	inline int start_thread(Thread * const thread, unsigned const cpu_id,
-	                        Pd * const pd, Native_utcb * const utcb)
+	                        Pd * const pd, Native_utcb * const utcb,
+	                        unsigned const mask = 0)
 	{
 		return call(call_id_start_thread(), (Call_arg)thread, cpu_id,
-		            (Call_arg)pd, (Call_arg)utcb);
+		            (Call_arg)pd, (Call_arg)utcb, mask);
 	}
 
 
@@ -20,6 +20,7 @@
 #include <cpu.h>
 #include <kernel/cpu_scheduler.h>
 #include <kernel/irq.h>
+#include <kernel/perf_counter.h>
 
 namespace Genode { class Translation_table; }
 
@@ -121,7 +122,10 @@ class Kernel::Cpu_job : public Genode::Cpu::User_context, public Cpu_share
 {
 	protected:
 
-		Cpu * _cpu;
+		Cpu *    _cpu;
+		unsigned _cpu_mask; /* CPUs the job may be migrated to */
+
+		Genode::Trace::Perf_counters _perf_counters;
 
 		/**
 		 * Handle interrupt exception that occured during execution on CPU 'id'
@@ -165,6 +169,11 @@ class Kernel::Cpu_job : public Genode::Cpu::User_context, public Cpu_share
 		 */
 		virtual Cpu_job * helping_sink() = 0;
 
+		/**
+		 * Return wether the job may currently be moved to another CPU
+		 */
+		virtual bool migratable() { return false; }
+
 		/**
 		 * Construct a job with scheduling priority 'p' and time quota 'q'
 		 */
@@ -190,11 +199,31 @@ class Kernel::Cpu_job : public Genode::Cpu::User_context, public Cpu_share
 		 */
 		bool own_share_active() { return Cpu_share::ready(); }
 
+		/**
+		 * Move the ready job from its current CPU to CPU 'cpu'
+		 */
+		void migrate(Cpu * const cpu);
+
+		/**
+		 * Allow migration of the job to the CPUs set in mask 'm'
+		 */
+		void cpu_mask(unsigned const m) { _cpu_mask = m; }
+
+		/**
+		 * Return wether the job may be migrated to CPU 'id'
+		 */
+		bool cpu_allowed(unsigned const id) const {
+			return _cpu_mask & (1U << id); }
+
 		/***************
 		 ** Accessors **
 		 ***************/
 
 		void cpu(Cpu * const cpu) { _cpu = cpu; }
+		Cpu * cpu() const { return _cpu; }
+
+		Genode::Trace::Perf_counters &       perf_counters()       { return _perf_counters; }
+		Genode::Trace::Perf_counters const & perf_counters() const { return _perf_counters; }
 };
 
 class Kernel::Cpu_idle : public Cpu_job
@@ -273,6 +302,13 @@ class Kernel::Cpu : public Genode::Cpu,
 		unsigned _quota() const { return _timer->ms_to_tics(cpu_quota_ms); }
 		unsigned _fill() const  { return _timer->ms_to_tics(cpu_fill_ms); }
 
+		/**
+		 * Take over a best-effort job of the most loaded other CPU
+		 *
+		 * \return  wether a job was migrated to this CPU
+		 */
+		bool _pull_job();
+
 	public:
 
 		/**
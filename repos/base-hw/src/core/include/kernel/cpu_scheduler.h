@@ -89,6 +89,7 @@ class Kernel::Cpu_share : public Cpu_claim, public Cpu_fill
 		unsigned     _claim;
 		unsigned     _fill;
 		bool         _ready;
+		bool         _boosted;
 
 	public:
 
@@ -99,13 +100,22 @@ class Kernel::Cpu_share : public Cpu_claim, public Cpu_fill
 		 * \param q  claimed quota
 		 */
 		Cpu_share(signed const p, unsigned const q)
-		: _prio(p), _quota(q), _claim(q), _ready(0) { }
+		: _prio(p), _quota(q), _claim(q), _ready(0), _boosted(0) { }
+
+		/**
+		 * Prefer the share over all others when it becomes ready next
+		 *
+		 * The boost lasts until the share gets unready or has consumed
+		 * one fill slice, whichever comes first.
+		 */
+		void boost() { if (!_ready) { _boosted = 1; } }
 
 		/*
 		 * Accessors
 		 */
 
 		bool ready() const { return _ready; }
+		bool boosted() const { return _boosted; }
 		void quota(unsigned const q) { _quota = q; }
 };
 
@@ -131,6 +141,8 @@ class Kernel::Cpu_scheduler
 		unsigned const _quota;
 		unsigned       _residual;
 		unsigned const _fill;
+		unsigned       _ready_fills;
+		bool const     _tickless;
 
 		template <typename F> void _for_each_prio(F f) {
 			for (signed p = Prio::MAX; p > Prio::MIN - 1; p--) { f(p); } }
@@ -147,10 +159,16 @@ class Kernel::Cpu_scheduler
 		void     _next_fill();
 		void     _head_claimed(unsigned const r);
 		void     _head_filled(unsigned const r);
+		bool     _boost_for_head();
 		bool     _claim_for_head();
 		bool     _fill_for_head();
 		unsigned _trim_consumption(unsigned & q);
 
+		/**
+		 * Return time slice of fill 's' if it becomes the head
+		 */
+		unsigned _fill_slice(Share * const s) const;
+
 		/**
 		 * Fill 's' becomes a claim due to a quota donation
 		 */
@@ -175,8 +193,13 @@ class Kernel::Cpu_scheduler
 		 *           is schedulable. Unremovable. All values get ignored.
 		 * \param q  total amount of time quota that can be claimed by shares
 		 * \param f  time-slice length of the fill round-robin
+		 * \param t  tickless mode, the head quota then lasts until the
+		 *           next event that may change the head, i.e., the
+		 *           end of a claim, the end of the super period, or
+		 *           the end of the fill slice if other fills are ready
 		 */
-		Cpu_scheduler(Share * const i, unsigned const q, unsigned const f);
+		Cpu_scheduler(Share * const i, unsigned const q, unsigned const f,
+		              bool const t = false);
 
 		/**
 		 * Update head according to the consumption of quota 'q'
@@ -218,6 +241,23 @@ class Kernel::Cpu_scheduler
 		 */
 		void quota(Share * const s, unsigned const q);
 
+		/**
+		 * Return a ready share without quota that satisfies 'f', or 0
+		 *
+		 * The head is never returned. The returned share may be moved to
+		 * another scheduler without affecting the claims of this one.
+		 */
+		template <typename F> Share * migratable_fill(F const &f)
+		{
+			Share * result = nullptr;
+			_fills.for_each([&] (Fill * const fill) {
+				Share * const s = _share(fill);
+				if (!result && s != _head && !s->_quota && f(s)) {
+					result = s; }
+			});
+			return result;
+		}
+
 		/*
 		 * Accessors
 		 */
@@ -227,6 +267,7 @@ class Kernel::Cpu_scheduler
 			return Genode::min(_head_quota, _residual); }
 		unsigned quota() const { return _quota; }
 		unsigned residual() const { return _residual; }
+		unsigned ready_fills() const { return _ready_fills; }
 };
 
 #endif /* _KERNEL__CPU_SCHEDULER_H_ */
@@ -132,6 +132,11 @@ class Kernel::Ipc_node : public Ipc_node_queue::Element
 		 */
 		virtual void _await_request_failed() = 0;
 
+		/**
+		 * The caller of the request in the inbuf cancelled its request
+		 */
+		virtual void _inbuf_request_cancelled() = 0;
+
 	protected:
 
 		Pd * _pd; /* pointer to PD this IPC node is part of */
@@ -115,30 +115,51 @@ class Kernel::Irq : public Genode::Avl_node<Irq>
 };
 
 
-class Kernel::User_irq : public Kernel::Irq, public Kernel::Object
+class Kernel::User_irq : public Kernel::Irq, public Kernel::Object,
+                         public Kernel::Signal_delivery_handler
 {
 	private:
 
 		Signal_context &_context;
+		unsigned        _cpu; /* kernel name of the CPU that gets the IRQ */
 
 		/**
 		 * Get map that provides all user interrupts by their kernel names
 		 */
 		static Irq::Pool * _pool();
 
+
+		/*****************************
+		 ** Signal_delivery_handler **
+		 *****************************/
+
+		void _signal_delivered(Signal_handler & h);
+
 	public:
 
 		/**
 		 * Construct object that signals interrupt 'irq' via signal 'context'
+		 *
+		 * \param cpu  kernel name of the CPU that initially gets the IRQ
 		 */
-		User_irq(unsigned const irq, Signal_context &context)
-		: Irq(irq, *_pool()), _context(context) { disable(); }
+		User_irq(unsigned const irq, Signal_context &context,
+		         unsigned const cpu)
+		: Irq(irq, *_pool()), _context(context), _cpu(cpu)
+		{
+			disable();
+			_context.delivery_handler(this);
+		}
 
 		/**
 		 * Destructor
 		 */
 		~User_irq() { disable(); }
 
+		/**
+		 * Allow the interrupt to occur again at the CPU of its handler
+		 */
+		void ack() const;
+
 		/**
 		 * Handle occurence of the interrupt
 		 */
@@ -165,6 +165,11 @@ class Kernel::Pd : public Cpu::Pd,
 		 */
 		void admit(Cpu::Context * const c);
 
+		/**
+		 * Prepare CPU 'cpu' for executing the PD member 'c'
+		 */
+		void activate(Cpu::Context * const c, unsigned const cpu);
+
 
 		static capid_t syscall_create(void * const dst,
 		                              Genode::Translation_table * tt,
@@ -14,6 +14,9 @@
 #ifndef _KERNEL__PERF_COUNTER_H_
 #define _KERNEL__PERF_COUNTER_H_
 
+/* Genode includes */
+#include <base/trace/types.h>
+
 namespace Kernel
 {
 	/**
@@ -27,6 +30,15 @@ namespace Kernel
 			 * Enable counting
 			 */
 			void enable();
+
+			/**
+			 * Add events counted since the last call to 'counters'
+			 *
+			 * The event counters are restarted afterwards. Hence,
+			 * calling this function on each kernel entry attributes
+			 * the events to the job that was executed before.
+			 */
+			void account(Genode::Trace::Perf_counters &counters);
 	};
 
 
@@ -32,6 +32,11 @@ namespace Kernel
 	 */
 	class Signal_ack_handler;
 
+	/**
+	 * Ability to get informed about the delivery of signals
+	 */
+	class Signal_delivery_handler;
+
 	/**
 	 * Ability to destruct signal contexts
 	 */
@@ -74,6 +79,37 @@ class Kernel::Signal_ack_handler
 		virtual ~Signal_ack_handler();
 };
 
+class Kernel::Signal_delivery_handler
+{
+	friend class Signal_context;
+	friend class Signal_receiver;
+
+	private:
+
+		Signal_context * _signal_context;
+
+	protected:
+
+		/**
+		 * Provide custom handler for the delivery of a signal context
+		 *
+		 * \param h  handler that receives the signal
+		 *
+		 * The function is called before the handler gets informed.
+		 */
+		virtual void _signal_delivered(Signal_handler & h) = 0;
+
+		/**
+		 * Constructor
+		 */
+		Signal_delivery_handler() : _signal_context(0) { }
+
+		/**
+		 * Destructor
+		 */
+		virtual ~Signal_delivery_handler();
+};
+
 class Kernel::Signal_handler
 {
 	friend class Signal_receiver;
@@ -84,6 +120,7 @@ class Kernel::Signal_handler
 
 		Fifo_element      _handlers_fe;
 		Signal_receiver * _receiver;
+		unsigned          _batch; /* max contexts to receive at once */
 
 		/**
 		 * Let the handler block for signal receipt
@@ -194,6 +231,7 @@ class Kernel::Signal_context : public Kernel::Object
 		Signal_context_killer * _killer;
 		Default_ack_handler     _default_ack_handler;
 		Signal_ack_handler    * _ack_handler;
+		Signal_delivery_handler * _delivery_handler;
 
 		/**
 		 * Tell receiver about the submits of the context if any
@@ -234,6 +272,13 @@ class Kernel::Signal_context : public Kernel::Object
 		 */
 		void ack_handler(Signal_ack_handler * const h);
 
+		/**
+		 * Attach or detach a handler for deliveries of this context
+		 *
+		 * \param h  handler that shall be attached or 0 to detach handler
+		 */
+		void delivery_handler(Signal_delivery_handler * const h);
+
 		/**
 		 * Submit the signal
 		 *
@@ -334,10 +379,12 @@ class Kernel::Signal_receiver : public Kernel::Object
 		/**
 		 * Let a handler 'h' wait for signals of the receiver
 		 *
+		 * \param batch  maximum number of contexts to deliver at once
+		 *
 		 * \retval  0 succeeded
 		 * \retval -1 failed
 		 */
-		int add_handler(Signal_handler * const h);
+		int add_handler(Signal_handler * const h, unsigned const batch = 1);
 
 		/**
 		 * Syscall to create a signal receiver
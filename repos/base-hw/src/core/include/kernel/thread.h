@@ -107,6 +107,12 @@ class Kernel::Thread
 		Signal_receiver *  _signal_receiver;
 		char const * const _label;
 
+		/*
+		 * Wether the thread is active but runs solely on the CPU share of
+		 * its caller, which was donated by an IPC fast path
+		 */
+		bool               _donated = false;
+
 		void _init();
 
 		/**
@@ -161,6 +167,11 @@ class Kernel::Thread
 		 */
 		void _deactivate_used_shares();
 
+		/**
+		 * Stop running on a donated share and activate our own one
+		 */
+		void _revoke_donation();
+
 		/**
 		 * Pause execution
 		 */
@@ -230,9 +241,10 @@ class Kernel::Thread
 		void _call_update_data_region();
 		void _call_update_instr_region();
 		void _call_print_char();
-		void _call_await_signal();
+		void _call_await_signal(unsigned const batch);
 		void _call_submit_signal();
 		void _call_ack_signal();
+		void _call_ack_signals();
 		void _call_kill_signal_context();
 		void _call_new_vm();
 		void _call_delete_vm();
@@ -289,6 +301,7 @@ class Kernel::Thread
 		void _send_request_failed();
 		void _await_request_succeeded();
 		void _await_request_failed();
+		void _inbuf_request_cancelled();
 
 
 		/***********************
@@ -343,6 +356,7 @@ class Kernel::Thread
 		void exception(unsigned const cpu);
 		void proceed(unsigned const cpu);
 		Cpu_job * helping_sink();
+		bool migratable();
 
 
 		/***************
@@ -59,6 +59,9 @@ class Genode::Kernel_object
 
 		T * kernel_object() { return reinterpret_cast<T*>(_data); }
 
+		T const * kernel_object() const {
+			return reinterpret_cast<T const *>(_data); }
+
 		/**
 		 * Create the kernel object explicitely via this function
 		 */
@@ -42,8 +42,18 @@ namespace Genode
 	 */
 	class Pager_object;
 
+	/**
+	 * Handles the page faults of the pager objects of one CPU
+	 */
+	class Pager_activation;
+
 	/**
 	 * Paging entry point that manages a pool of pager objects
+	 *
+	 * A page fault is handled by the activation of the CPU that the
+	 * faulting thread was assigned to when it became a pager client.
+	 * Hence, fault storms caused by the startup of a component on one
+	 * CPU don't delay the page faults of components on other CPUs.
 	 */
 	class Pager_entrypoint;
 
@@ -125,23 +135,30 @@ class Genode::Pager_object
 
 	private:
 
-		Thread_capability   _thread_cap;
-		unsigned long const _badge;
+		Thread_capability        _thread_cap;
+		unsigned long const      _badge;
+		Affinity::Location const _location;
 
 	public:
 
 		/**
 		 * Constructor
 		 *
-		 * \param badge  user identifaction of pager object
+		 * \param badge     user identifaction of pager object
+		 * \param location  affinity of the paged thread to physical CPUs
 		 */
-		Pager_object(unsigned const badge, Affinity::Location);
+		Pager_object(unsigned const badge, Affinity::Location location);
 
 		/**
 		 * User identification of pager object
 		 */
 		unsigned long badge() const { return _badge; }
 
+		/**
+		 * Affinity of the paged thread at the time it became a client
+		 */
+		Affinity::Location location() const { return _location; }
+
 		/**
 		 * Resume faulter
 		 */
@@ -190,17 +207,48 @@ class Genode::Pager_object
 };
 
 
-class Genode::Pager_entrypoint : public Object_pool<Pager_object>,
-                                 public Thread<PAGER_EP_STACK_SIZE>,
+class Genode::Pager_activation : public Thread<PAGER_EP_STACK_SIZE>,
                                  public Kernel_object<Kernel::Signal_receiver>,
                                  public Ipc_pager
 {
+	private:
+
+		Pager_entrypoint &_ep;
+
 	public:
 
 		/**
 		 * Constructor
 		 *
-		 * \param a  activation that shall handle the objects of the entrypoint
+		 * \param ep   entrypoint whose pager objects get handled
+		 * \param cpu  CPU the activation is executed on
+		 */
+		Pager_activation(Pager_entrypoint &ep, unsigned const cpu);
+
+
+		/**********************
+		 ** Thread interface **
+		 **********************/
+
+		void entry();
+};
+
+
+class Genode::Pager_entrypoint : public Object_pool<Pager_object>
+{
+	private:
+
+		Pager_activation * _activations[NR_OF_CPUS];
+
+		Pager_activation & _activation(Affinity::Location const location);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param cap_session  unused as pager capabilities are kernel
+		 *                     signal contexts
 		 */
 		Pager_entrypoint(Cap_session * cap_session);
 
@@ -213,13 +261,6 @@ class Genode::Pager_entrypoint : public Object_pool<Pager_object>,
 		 * Dissolve pager object 'obj' from entry point
 		 */
 		void dissolve(Pager_object * const obj);
-
-
-		/**********************
-		 ** Thread interface **
-		 **********************/
-
-		void entry();
 };
 
 #endif /* _CORE__INCLUDE__PAGER_H_ */
@@ -19,7 +19,7 @@
 #include <translation_table.h>
 #include <platform.h>
 #include <address_space.h>
-#include <translation_table_allocator.h>
+#include <quota_translation_table_allocator.h>
 #include <object.h>
 #include <kernel/configuration.h>
 #include <kernel/object.h>
@@ -62,7 +62,7 @@ class Hw::Address_space : public Genode::Address_space
 		friend class Genode::Mapped_mem_allocator;
 
 		using Table_allocator =
-			Translation_table_allocator_tpl<DEFAULT_TRANSLATION_TABLE_MAX>;
+			Quota_translation_table_allocator<DEFAULT_TRANSLATION_TABLE_POOL>;
 
 		Genode::Lock                          _lock;     /* table lock      */
 		Genode::Translation_table           * _tt;       /* table virt addr */
@@ -92,9 +92,10 @@ class Hw::Address_space : public Genode::Address_space
 		/**
 		 * Constructor
 		 *
-		 * \param pd    pointer to kernel's pd object
+		 * \param pd     pointer to kernel's pd object
+		 * \param quota  quota that pays for additional translation tables
 		 */
-		Address_space(Kernel::Pd* pd);
+		Address_space(Kernel::Pd* pd, Genode::Allocator_guard &quota);
 
 		~Address_space();
 
@@ -176,9 +177,11 @@ class Genode::Platform_pd : public Hw::Address_space,
 		/**
 		 * Constructor for non-core pd
 		 *
-		 * \param label  name of protection domain
+		 * \param md_alloc  session quota that pays for the metadata of
+		 *                  the protection domain
+		 * \param label     name of protection domain
 		 */
-		Platform_pd(Allocator * md_alloc, char const *label);
+		Platform_pd(Allocator_guard * md_alloc, char const *label);
 
 		/**
 		 * Destructor
@@ -16,6 +16,7 @@
 #define _CORE__INCLUDE__PLATFORM_THREAD_H_
 
 /* Genode includes */
+#include <base/trace/types.h>
 #include <ram_session/ram_session.h>
 #include <base/native_types.h>
 #include <base/thread.h>
@@ -183,6 +184,12 @@ namespace Genode {
 			 */
 			unsigned long long execution_time() const { return 0; }
 
+			/**
+			 * Return hardware events counted for the thread
+			 */
+			Trace::Perf_counters perf_counters() const {
+				return kernel_object()->perf_counters(); }
+
 
 			/***************
 			 ** Accessors **
@@ -0,0 +1,145 @@
+/*
+ * \brief  Translation table allocator that grows at the expense of a session
+ * \author Norman Feske
+ * \date   2015-12-07
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _CORE__INCLUDE__QUOTA_TRANSLATION_TABLE_ALLOCATOR_H_
+#define _CORE__INCLUDE__QUOTA_TRANSLATION_TABLE_ALLOCATOR_H_
+
+/* Genode includes */
+#include <base/allocator_guard.h>
+
+/* core includes */
+#include <translation_table_allocator_tpl.h>
+
+namespace Genode {
+
+	/**
+	 * Translation table allocator with a pool of tables provided by core
+	 *
+	 * /param TABLES  count of tables that are provided by core
+	 */
+	template <unsigned TABLES> class Quota_translation_table_allocator;
+}
+
+
+/**
+ * Allocator of the tables of one address space
+ *
+ * Each address space gets a small pool of 'TABLES' tables from core. If the
+ * pool is exhausted, further tables are allocated on demand from core's
+ * memory and accounted to the quota of the session that owns the address
+ * space. Hence, the size of an address space is limited only by the quota
+ * that its owner donates, while small address spaces no longer reserve
+ * core memory for tables they never use.
+ */
+template <unsigned TABLES>
+class Genode::Quota_translation_table_allocator
+: public Translation_table_allocator
+{
+	private:
+
+		using Pool = Translation_table_allocator_tpl<TABLES>;
+
+		enum {
+			TABLE_SIZE_LOG2 = Translation_table::TABLE_LEVEL_X_SIZE_LOG2,
+			TABLE_SIZE      = 1 << TABLE_SIZE_LOG2,
+			POOL_SIZE       = TABLES * TABLE_SIZE,
+		};
+
+		Core_mem_allocator          &_cma;
+		Allocator_guard             &_quota;
+		Pool                        &_pool;
+		Translation_table_allocator &_pool_alloc;
+		addr_t const                 _pool_virt;
+		addr_t const                 _pool_phys;
+		size_t                       _consumed = 0;
+
+		bool _pool_virt_addr(void * const addr) const {
+			return (addr_t)addr - _pool_virt < POOL_SIZE; }
+
+		bool _pool_phys_addr(void * const addr) const {
+			return (addr_t)addr - _pool_phys < POOL_SIZE; }
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param cma    core-memory allocator that backs all tables
+		 * \param quota  quota of the session that pays for extra tables
+		 */
+		Quota_translation_table_allocator(Core_mem_allocator &cma,
+		                                  Allocator_guard    &quota)
+		:
+			_cma(cma), _quota(quota), _pool(*new (&cma) Pool(&cma)),
+			_pool_alloc(*_pool.alloc()), _pool_virt((addr_t)&_pool),
+			_pool_phys((addr_t)cma.phys_addr(&_pool))
+		{ }
+
+		/**
+		 * Destructor
+		 *
+		 * All tables must have been freed beforehand.
+		 */
+		~Quota_translation_table_allocator() { destroy(&_cma, &_pool); }
+
+		void * phys_addr(void * addr) override
+		{
+			return _pool_virt_addr(addr) ? _pool_alloc.phys_addr(addr)
+			                             : _cma.phys_addr(addr);
+		}
+
+		void * virt_addr(void * addr) override
+		{
+			return _pool_phys_addr(addr) ? _pool_alloc.virt_addr(addr)
+			                             : _cma.virt_addr(addr);
+		}
+
+
+		/************************
+		 * Allocator interface **
+		 ************************/
+
+		bool alloc(size_t size, void **addr) override
+		{
+			if (_pool_alloc.alloc(size, addr)) { return true; }
+
+			if (!_quota.withdraw(TABLE_SIZE)) { return false; }
+
+			if (_cma.alloc_aligned(TABLE_SIZE, addr, TABLE_SIZE_LOG2).is_ok()) {
+				_consumed += TABLE_SIZE;
+				return true;
+			}
+			_quota.refund(TABLE_SIZE);
+			return false;
+		}
+
+		void free(void *addr, size_t size) override
+		{
+			if (_pool_virt_addr(addr)) {
+				_pool_alloc.free(addr, size);
+				return;
+			}
+			_cma.free(addr, TABLE_SIZE);
+			_quota.refund(TABLE_SIZE);
+			_consumed -= TABLE_SIZE;
+		}
+
+		/**
+		 * Return amount of memory accounted to the quota
+		 */
+		size_t consumed()           const override { return _consumed; }
+		size_t overhead(size_t)     const override { return 0; }
+		bool   need_size_for_free() const override { return false; }
+};
+
+#endif /* _CORE__INCLUDE__QUOTA_TRANSLATION_TABLE_ALLOCATOR_H_ */
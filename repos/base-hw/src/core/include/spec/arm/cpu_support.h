@@ -382,9 +382,10 @@ class Genode::Arm
 		 */
 		struct Pd
 		{
-			Genode::uint8_t asid; /* address space id */
+			Genode::uint8_t asid;       /* address space id */
+			unsigned        generation; /* ASID generation of 'asid' */
 
-			Pd(Genode::uint8_t id) : asid(id) {}
+			Pd() : asid(0), generation(0) {}
 		};
 
 		/**
@@ -510,6 +511,12 @@ class Genode::Arm
 		static constexpr addr_t line_size = 1 << Board::CACHE_LINE_SIZE_LOG2;
 		static constexpr addr_t line_align_mask = ~(line_size - 1);
 
+		/**
+		 * Region size above which maintaining the whole data cache by
+		 * set/way is cheaper than maintaining the region line by line
+		 */
+		static constexpr size_t max_cache_region_size = 1024 * 1024;
+
 		/**
 		 * Clean and invalidate data-cache for virtual region
 		 * 'base' - 'base + size'
@@ -532,6 +532,7 @@ class Genode::Translation_table : public Level_1_stage_1_translation_table
 	public:
 
 		enum {
+			MAX_PAGE_SIZE_LOG2      = SIZE_LOG2_2MB,
 			TABLE_LEVEL_X_SIZE_LOG2 = SIZE_LOG2_4KB,
 			TABLE_LEVEL_X_ENTRIES   = (1 << SIZE_LOG2_4KB) / sizeof(addr_t),
 			CORE_VM_AREA_SIZE       = 1024 * 1024 * 1024,
@@ -41,7 +41,21 @@ class Genode::Cpu
 {
 	public:
 
-		struct Pd {};
+		/**
+		 * This class comprises x86 specific protection domain attributes
+		 */
+		struct Pd
+		{
+			Genode::uint16_t pcid; /* process-context id */
+
+			Pd(Genode::uint16_t id) : pcid(id) {}
+		};
+
+		/*
+		 * Process-context id that is shared by all protection domains
+		 * that could not get an id of their own
+		 */
+		enum { PCID_SHARED = (1 << 12) - 1 };
 
 		struct Cr0; /* Control register 0 */
 		struct Cr2; /* Control register 2 */
@@ -67,9 +81,10 @@ class Genode::Cpu
 			 * Initialize context
 			 *
 			 * \param table  physical base of appropriate translation table
+			 * \param pcid   process-context id of the protection domain
 			 * \param core   whether it is a core thread or not
 			 */
-			void init(addr_t const table, bool core);
+			void init(addr_t const table, unsigned const pcid, bool core);
 		};
 
 
@@ -111,6 +126,16 @@ class Genode::Cpu
 
 		Fpu & fpu() { return _fpu; }
 
+		/**
+		 * Return wether the CPU can tag TLB entries with process-context ids
+		 */
+		static bool pcid_supported();
+
+		/**
+		 * Invalidate all TLB entries of all process contexts
+		 */
+		static void invalidate_tlb();
+
 		static constexpr addr_t exception_entry = 0xffff0000;
 		static constexpr addr_t mtc_size        = 1 << 13;
 
@@ -195,9 +220,11 @@ struct Genode::Cpu::Cr2 : Register<64>
  */
 struct Genode::Cpu::Cr3 : Register<64>
 {
-	struct Pwt : Bitfield<3,1> { };    /* Page-level write-through    */
-	struct Pcd : Bitfield<4,1> { };    /* Page-level cache disable    */
-	struct Pdb : Bitfield<12, 36> { }; /* Page-directory base address */
+	struct Pcid    : Bitfield<0,12> { };  /* Process-context identifier  */
+	struct Pwt     : Bitfield<3,1> { };   /* Page-level write-through    */
+	struct Pcd     : Bitfield<4,1> { };   /* Page-level cache disable    */
+	struct Pdb     : Bitfield<12, 36> { }; /* Page-directory base address */
+	struct Noflush : Bitfield<63,1> { };  /* Keep TLB entries of PCID    */
 
 	static void write(access_t const v) {
 		asm volatile ("mov %0, %%cr3" :: "r" (v) : ); }
@@ -216,6 +243,24 @@ struct Genode::Cpu::Cr3 : Register<64>
 	 */
 	static access_t init(addr_t const table) {
 		return Pdb::masked(table); }
+
+	/**
+	 * Return initialized value for a process-context
+	 *
+	 * \param table  base of targeted translation table
+	 * \param pcid   process-context id of the table
+	 * \param keep   whether to keep the TLB entries tagged with 'pcid'
+	 *
+	 * Only valid if CR4.PCIDE is set.
+	 */
+	static access_t init(addr_t const table, unsigned const pcid,
+	                     bool const keep)
+	{
+		access_t v = Pdb::masked(table);
+		Pcid::set(v, pcid);
+		Noflush::set(v, keep);
+		return v;
+	}
 };
 
 
@@ -45,6 +45,7 @@ struct Genode::Irte : Register<64>
 	struct Pol  : Bitfield<13, 1> { };
 	struct Trg  : Bitfield<15, 1> { };
 	struct Mask : Bitfield<16, 1> { };
+	struct Dest : Bitfield<56, 8> { }; /* APIC ID in physical mode */
 };
 
 class Genode::Ioapic : public Mmio
@@ -183,6 +184,26 @@ class Genode::Ioapic : public Mmio
 			write<Iowin>(irte);
 		}
 
+		/**
+		 * Route IRQ of given vector to the local APIC of CPU 'cpu'
+		 *
+		 * We expect the APIC IDs to equal the kernel names of the CPUs.
+		 */
+		void route(unsigned const vector, unsigned const cpu)
+		{
+			if (vector < REMAP_BASE || vector >= REMAP_BASE + IRTE_COUNT) {
+				return;
+			}
+
+			const unsigned irq = vector - REMAP_BASE;
+
+			/* the destination is located in the upper half of the entry */
+			Irte::access_t irte = 0;
+			Irte::Dest::set(irte, cpu);
+			write<Ioregsel>(IOREDTBL + 2 * irq + 1);
+			write<Iowin>(irte >> Iowin::ACCESS_WIDTH);
+		}
+
 		/**
 		 * Setup mode of an IRQ to specified trigger mode and polarity
 		 *
@@ -709,6 +709,7 @@ class Genode::Translation_table : public Pml4_table
 	public:
 
 		enum {
+			MAX_PAGE_SIZE_LOG2      = SIZE_LOG2_2MB,
 			TABLE_LEVEL_X_SIZE_LOG2 = SIZE_LOG2_4KB,
 			CORE_VM_AREA_SIZE       = 1024 * 1024 * 1024,
 			CORE_TRANS_TABLE_COUNT  =
@@ -86,12 +86,11 @@ namespace Genode
 	 * argument. If a kernel only supports a certain set of map sizes such
 	 * as 4K and 4M, this function should select one of those smaller or
 	 * equal to the argument.
+	 *
+	 * The translation tables of base-hw split a mapping into the largest
+	 * blocks that fit, so we only limit the size to the largest block.
 	 */
-	inline size_t constrain_map_size_log2(size_t size_log2)
-	{
-		if (size_log2<20) return 12;
-		return 20;
-	}
+	size_t constrain_map_size_log2(size_t size_log2);
 
 	/**
 	 * Print debug output on page faults
@@ -88,8 +88,18 @@ void Cpu_job::quota(unsigned const q)
 }
 
 
+void Cpu_job::migrate(Cpu * const cpu)
+{
+	_cpu->scheduler()->unready(this);
+	_cpu->scheduler()->remove(this);
+	_cpu = cpu;
+	_cpu->scheduler()->insert(this);
+	_cpu->scheduler()->ready(this);
+}
+
+
 Cpu_job::Cpu_job(Cpu_priority const p, unsigned const q)
-: Cpu_share(p, q), _cpu(0) { }
+: Cpu_share(p, q), _cpu(0), _cpu_mask(0) { }
 
 
 Cpu_job::~Cpu_job()
@@ -129,6 +139,30 @@ bool Cpu::interrupt(unsigned const irq_id)
 }
 
 
+bool Cpu::_pull_job()
+{
+	/* a CPU is loaded if fills are waiting besides the current one */
+	Cpu * busiest = nullptr;
+	for (unsigned i = 0; i < NR_OF_CPUS; i++) {
+		Cpu * const cpu = cpu_pool()->cpu(i);
+		unsigned const load = cpu->_scheduler.ready_fills();
+		if (cpu == this || load < 2) { continue; }
+		if (!busiest || load > busiest->_scheduler.ready_fills()) {
+			busiest = cpu; }
+	}
+	if (!busiest) { return false; }
+
+	Cpu_share * const share =
+		busiest->_scheduler.migratable_fill([&] (Cpu_share * const s) {
+			Job * const job = static_cast<Job *>(s);
+			return job->cpu_allowed(_id) && job->migratable(); });
+	if (!share) { return false; }
+
+	static_cast<Job *>(share)->migrate(this);
+	return true;
+}
+
+
 Cpu_job & Cpu::schedule()
 {
 	/* get new job */
@@ -140,6 +174,10 @@ Cpu_job & Cpu::schedule()
 	unsigned quota = old_time > new_time ? old_time - new_time : 1;
 	_scheduler.update(quota);
 
+	/* instead of idling, relieve a loaded CPU */
+	if (cpu_balancing && NR_OF_CPUS > 1 && _scheduler.head() == &_idle &&
+	    _pull_job()) { _scheduler.update(0); }
+
 	/* get new job */
 	Job & new_job = scheduled_job();
 	quota = _scheduler.head_quota();
@@ -156,7 +194,7 @@ Cpu_job & Cpu::schedule()
 
 Cpu::Cpu(unsigned const id, Timer * const timer)
 : _id(id), _idle(this), _timer(timer),
-  _scheduler(&_idle, _quota(), _fill()),
+  _scheduler(&_idle, _quota(), _fill(), cpu_tickless),
   _ipi_irq(*this),
   _timer_irq(_timer->interrupt_id(_id), *this) { }
 
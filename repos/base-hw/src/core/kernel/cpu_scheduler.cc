@@ -53,6 +53,7 @@ void Cpu_scheduler::_set_head(Share * const s, unsigned const q, bool const c)
 
 void Cpu_scheduler::_next_fill()
 {
+	_head->_boosted = 0;
 	_head->_fill = _fill;
 	_fills.head_to_tail();
 }
@@ -70,11 +71,21 @@ void Cpu_scheduler::_head_claimed(unsigned const r)
 void Cpu_scheduler::_head_filled(unsigned const r)
 {
 	if (_fills.head() != _head) { return; }
-	if (r) { _head->_fill = r; }
+	if (r) { _head->_fill = Genode::min(r, _fill); }
 	else { _next_fill(); }
 }
 
 
+bool Cpu_scheduler::_boost_for_head()
+{
+	/* boosted shares always enter the fill list at its head */
+	Share * const s = _share(_fills.head());
+	if (!s || !s->_boosted) { return 0; }
+	_set_head(s, _fill_slice(s), 0);
+	return 1;
+}
+
+
 bool Cpu_scheduler::_claim_for_head()
 {
 	for (signed p = Prio::MAX; p > Prio::MIN - 1; p--) {
@@ -92,11 +103,19 @@ bool Cpu_scheduler::_fill_for_head()
 {
 	Share * const s = _share(_fills.head());
 	if (!s) { return 0; }
-	_set_head(s, s->_fill, 0);
+	_set_head(s, _fill_slice(s), 0);
 	return 1;
 }
 
 
+unsigned Cpu_scheduler::_fill_slice(Share * const s) const
+{
+	/* a lone fill competes with nobody until the super period ends */
+	if (_tickless && _ready_fills == 1) { return _residual; }
+	return s->_fill;
+}
+
+
 unsigned Cpu_scheduler::_trim_consumption(unsigned & q)
 {
 	q = Genode::min(Genode::min(q, _head_quota), _residual);
@@ -133,9 +152,10 @@ void Cpu_scheduler::update(unsigned q)
 	if (_head_claims) { _head_claimed(r); }
 	else { _head_filled(r); }
 	_consumed(q);
+	if (_boost_for_head()) { return; }
 	if (_claim_for_head()) { return; }
 	if (_fill_for_head()) { return; }
-	_set_head(_idle, _fill, 0);
+	_set_head(_idle, _tickless ? _residual : _fill, 0);
 }
 
 
@@ -143,7 +163,12 @@ bool Cpu_scheduler::ready_check(Share * const s1)
 {
 	ready(s1);
 	Share * s2 = _head;
-	if (!s1->_claim) { return s2 == _idle; }
+	if (s1->_boosted) { return !s2->_boosted; }
+	if (s2->_boosted) { return 0; }
+	if (!s1->_claim) {
+
+		/* a lone fill may run beyond its slice in tickless mode */
+		return s2 == _idle || (_tickless && !_head_claims); }
 	if (!_head_claims) { return 1; }
 	if (s1->_prio != s2->_prio) { return s1->_prio > s2->_prio; }
 	for (; s2 && s2 != s1; s2 = _share(Claim_list::next(s2))) ;
@@ -156,7 +181,9 @@ void Cpu_scheduler::ready(Share * const s)
 	assert(!s->_ready && s != _idle);
 	s->_ready = 1;
 	s->_fill = _fill;
-	_fills.insert_tail(s);
+	if (s->_boosted) { _fills.insert_head(s); }
+	else { _fills.insert_tail(s); }
+	_ready_fills++;
 	if (!s->_quota) { return; }
 	_ucl[s->_prio].remove(s);
 	if (s->_claim) { _rcl[s->_prio].insert_head(s); }
@@ -168,7 +195,9 @@ void Cpu_scheduler::unready(Share * const s)
 {
 	assert(s->_ready && s != _idle);
 	s->_ready = 0;
+	s->_boosted = 0;
 	_fills.remove(s);
+	_ready_fills--;
 	if (!s->_quota) { return; }
 	_rcl[s->_prio].remove(s);
 	_ucl[s->_prio].insert_tail(s);
@@ -192,7 +221,10 @@ void Cpu_scheduler::remove(Share * const s)
 		PERR("Removing the head of the CPU scheduler isn't supported by now.");
 		while (1) ;
 	}
-	if (s->_ready) { _fills.remove(s); }
+	if (s->_ready) {
+		_fills.remove(s);
+		_ready_fills--;
+	}
 	if (!s->_quota) { return; }
 	if (s->_ready) { _rcl[s->_prio].remove(s); }
 	else { _ucl[s->_prio].remove(s); }
@@ -218,6 +250,7 @@ void Cpu_scheduler::quota(Share * const s, unsigned const q)
 
 
 Cpu_scheduler::Cpu_scheduler(Share * const i, unsigned const q,
-                             unsigned const f)
-: _idle(i), _head_yields(0), _quota(q), _residual(q), _fill(f)
+                             unsigned const f, bool const t)
+: _idle(i), _head_yields(0), _quota(q), _residual(q), _fill(f),
+  _ready_fills(0), _tickless(t)
 { _set_head(i, f, 0); }
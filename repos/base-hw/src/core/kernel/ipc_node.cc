@@ -135,8 +135,10 @@ void Ipc_node::_cancel_inbuf_request()
 
 void Ipc_node::_announced_request_cancelled(Ipc_node * const node)
 {
-	if (_caller == node) _caller = nullptr;
-	else _request_queue.remove(node);
+	if (_caller == node) {
+		_caller = nullptr;
+		_inbuf_request_cancelled();
+	} else _request_queue.remove(node);
 }
 
 
@@ -15,6 +15,7 @@
 #include <kernel/kernel.h>
 #include <kernel/cpu.h>
 #include <kernel/irq.h>
+#include <kernel/thread.h>
 #include <pic.h>
 
 
@@ -24,6 +25,22 @@ void Kernel::Irq::disable() const { pic()->mask(_irq_nr); }
 void Kernel::Irq::enable() const { pic()->unmask(_irq_nr, Cpu::executing_id()); }
 
 
+void Kernel::User_irq::_signal_delivered(Signal_handler & h)
+{
+	/*
+	 * Let the receiving thread take precedence over all other jobs until
+	 * it blocks, e.g., for the acknowledgement of the interrupt, and route
+	 * further occurrences to its CPU to avoid inter-processor interrupts.
+	 */
+	Thread * const t = static_cast<Thread *>(&h);
+	t->boost();
+	_cpu = t->cpu()->id();
+}
+
+
+void Kernel::User_irq::ack() const { pic()->unmask(_irq_nr, _cpu); }
+
+
 Kernel::Irq::Pool * Kernel::User_irq::_pool()
 {
 	static Irq::Pool p;
@@ -21,6 +21,7 @@ extern "C" void kernel()
 	using namespace Kernel;
 
 	Cpu * const cpu = cpu_pool()->cpu(Cpu::executing_id());
+	perf_counter()->account(cpu->scheduled_job().perf_counters());
 	cpu->scheduled_job().exception(cpu->id());
 	cpu->schedule().proceed(cpu->id());
 }
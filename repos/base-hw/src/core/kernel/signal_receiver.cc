@@ -27,6 +27,16 @@ Signal_ack_handler::~Signal_ack_handler()
 }
 
 
+/*****************************
+ ** Signal_delivery_handler **
+ *****************************/
+
+Signal_delivery_handler::~Signal_delivery_handler()
+{
+	if (_signal_context) { _signal_context->delivery_handler(0); }
+}
+
+
 /********************
  ** Signal_handler **
  ********************/
@@ -41,7 +51,7 @@ void Signal_handler::cancel_waiting()
 
 
 Signal_handler::Signal_handler()
-: _handlers_fe(this), _receiver(0) { }
+: _handlers_fe(this), _receiver(0), _batch(1) { }
 
 
 Signal_handler::~Signal_handler() { cancel_waiting(); }
@@ -90,6 +100,14 @@ void Signal_context::ack_handler(Signal_ack_handler * const h)
 }
 
 
+void Signal_context::delivery_handler(Signal_delivery_handler * const h)
+{
+	if (_delivery_handler) { _delivery_handler->_signal_context = 0; }
+	_delivery_handler = h;
+	if (h) { h->_signal_context = this; }
+}
+
+
 int Signal_context::submit(unsigned const n)
 {
 	if (_killed || _submits >= (unsigned)~0 - n) { return -1; }
@@ -140,6 +158,7 @@ int Signal_context::kill(Signal_context_killer * const k)
 Signal_context::~Signal_context()
 {
 	if (_killer) { _killer->_signal_context_kill_failed(); }
+	delivery_handler(0);
 	_receiver->_context_destructed(this);
 }
 
@@ -154,7 +173,8 @@ Signal_context::Signal_context(Signal_receiver * const r, unsigned const imprint
 	_ack(1),
 	_killed(0),
 	_killer(0),
-	_ack_handler(&_default_ack_handler)
+	_ack_handler(&_default_ack_handler),
+	_delivery_handler(0)
 {
 	r->_add_context(this);
 }
@@ -180,18 +200,27 @@ void Signal_receiver::_listen()
 		/* check for deliverable signals and waiting handlers */
 		if (_deliver.empty() || _handlers.empty()) { return; }
 
-		/* create a signal data-object */
+		auto const handler = _handlers.dequeue()->object();
+		handler->_receiver = 0;
+
+		/* create signal data-objects for as many contexts as requested */
 		typedef Genode::Signal_context * Signal_imprint;
-		auto const context = _deliver.dequeue()->object();
-		auto const imprint =
-			reinterpret_cast<Signal_imprint>(context->_imprint);
-		Signal::Data data(imprint, context->_submits);
+		Signal::Data data[max_signal_batch()];
+		unsigned num = 0;
+		while (num < handler->_batch && !_deliver.empty()) {
+			auto const context = _deliver.dequeue()->object();
+			auto const imprint =
+				reinterpret_cast<Signal_imprint>(context->_imprint);
+			data[num++] = Signal::Data(imprint, context->_submits);
+			if (context->_delivery_handler) {
+				context->_delivery_handler->_signal_delivered(*handler); }
+			context->_delivered();
+		}
+		/* a batch that isn't full gets terminated by an invalid context */
+		size_t const size = num < handler->_batch ? num + 1 : num;
 
 		/* communicate signal data to handler */
-		auto const handler = _handlers.dequeue()->object();
-		handler->_receiver = 0;
-		handler->_receive_signal(&data, sizeof(data));
-		context->_delivered();
+		handler->_receive_signal(data, size * sizeof(Signal::Data));
 	}
 }
 
@@ -212,11 +241,13 @@ void Signal_receiver::_add_context(Signal_context * const c) {
 	_contexts.enqueue(&c->_contexts_fe); }
 
 
-int Signal_receiver::add_handler(Signal_handler * const h)
+int Signal_receiver::add_handler(Signal_handler * const h,
+                                 unsigned const batch)
 {
 	if (h->_receiver) { return -1; }
 	_handlers.enqueue(&h->_handlers_fe);
 	h->_receiver = this;
+	h->_batch    = Genode::max(1U, Genode::min(batch, max_signal_batch()));
 	h->_await_signal(this);
 	_listen();
 	return 0;
@@ -77,7 +77,7 @@ void Thread::_send_request_succeeded()
 	assert(_state == AWAITS_IPC);
 	user_arg_0(0);
 	_state = ACTIVE;
-	if (!Cpu_job::own_share_active()) { _activate_used_shares(); }
+	if (!Cpu_job::own_share_active() && !_donated) { _activate_used_shares(); }
 }
 
 
@@ -86,7 +86,7 @@ void Thread::_send_request_failed()
 	assert(_state == AWAITS_IPC);
 	user_arg_0(-1);
 	_state = ACTIVE;
-	if (!Cpu_job::own_share_active()) { _activate_used_shares(); }
+	if (!Cpu_job::own_share_active() && !_donated) { _activate_used_shares(); }
 }
 
 
@@ -94,6 +94,12 @@ void Thread::_await_request_succeeded()
 {
 	assert(_state == AWAITS_IPC);
 	user_arg_0(0);
+
+	/* run on the share of the caller without entering the scheduler */
+	if (_donated) {
+		_state = ACTIVE;
+		return;
+	}
 	_become_active();
 }
 
@@ -106,6 +112,16 @@ void Thread::_await_request_failed()
 }
 
 
+void Thread::_inbuf_request_cancelled()
+{
+	/*
+	 * If we ran on the share of the caller, we are either active or help
+	 * our own callee. In both cases, our own share must take over.
+	 */
+	_revoke_donation();
+}
+
+
 bool Thread::_resume()
 {
 	switch (_state) {
@@ -137,7 +153,8 @@ void Thread::_pause()
 
 void Thread::_deactivate_used_shares()
 {
-	Cpu_job::_deactivate_own_share();
+	if (_donated) { _donated = false; }
+	else { Cpu_job::_deactivate_own_share(); }
 	Ipc_node::for_each_helper([&] (Ipc_node * const h) {
 		static_cast<Thread *>(h)->_deactivate_used_shares(); });
 }
@@ -149,6 +166,13 @@ void Thread::_activate_used_shares()
 		static_cast<Thread *>(h)->_activate_used_shares(); });
 }
 
+void Thread::_revoke_donation()
+{
+	if (!_donated) { return; }
+	_donated = false;
+	Cpu_job::_activate_own_share();
+}
+
 void Thread::_become_active()
 {
 	if (_state != ACTIVE) { _activate_used_shares(); }
@@ -170,6 +194,16 @@ Cpu_job * Thread::helping_sink() {
 	return static_cast<Thread *>(Ipc_node::helping_sink()); }
 
 
+bool Thread::migratable()
+{
+	/* an active thread helps nobody, but others may execute on its behalf */
+	if (_state != ACTIVE) { return false; }
+	bool helped = false;
+	Ipc_node::for_each_helper([&] (Ipc_node * const) { helped = true; });
+	return !helped;
+}
+
+
 void Thread::_receive_yielded_cpu()
 {
 	if (_state == AWAITS_RESUME) { _become_active(); }
@@ -177,7 +211,11 @@ void Thread::_receive_yielded_cpu()
 }
 
 
-void Thread::proceed(unsigned const cpu) { mtc()->switch_to_user(this, cpu); }
+void Thread::proceed(unsigned const cpu)
+{
+	_pd->activate(this, cpu);
+	mtc()->switch_to_user(this, cpu);
+}
 
 
 size_t Thread::_core_to_kernel_quota(size_t const quota) const
@@ -223,6 +261,7 @@ void Thread::_call_start_thread()
 	assert(thread->_state == AWAITS_START)
 
 	thread->affinity(cpu);
+	thread->cpu_mask(user_arg_5() | (1U << cpu->id()));
 
 	/* join protection domain */
 	thread->_pd = (Pd *) user_arg_3();
@@ -288,6 +327,7 @@ void Thread::_call_await_request_msg()
 {
 	if (Ipc_node::await_request(user_arg_1())) {
 		user_arg_0(0);
+		_revoke_donation();
 		return;
 	}
 	_become_inactive(AWAITS_IPC);
@@ -307,10 +347,19 @@ void Thread::_call_send_request_msg()
 	bool const help = Cpu_job::_helping_possible(dst);
 	oir = oir->find(dst->pd());
 
+	/*
+	 * Fast path: if the destination waits for a request on our CPU, we
+	 * donate our share to it instead of readying its own share. The
+	 * scheduler keeps selecting our share, which now executes 'dst'.
+	 */
+	if (help && dst->Ipc_node::state() == Ipc_node::AWAIT_REQUEST) {
+		dst->_donated = true; }
+
 	Ipc_node::send_request(dst, oir ? oir->capid() : cap_id_invalid(),
 	                       help, user_arg_2());
 	_state = AWAITS_IPC;
-	if (!help || !dst->own_share_active()) { _deactivate_used_shares(); }
+	if (!help || !(dst->own_share_active() || dst->_donated)) {
+		_deactivate_used_shares(); }
 }
 
 
@@ -319,7 +368,10 @@ void Thread::_call_send_reply_msg()
 	Ipc_node::send_reply();
 	bool const await_request_msg = user_arg_2();
 	if (await_request_msg) { _call_await_request_msg(); }
-	else { user_arg_0(0); }
+	else {
+		user_arg_0(0);
+		_revoke_donation();
+	}
 }
 
 
@@ -411,7 +463,7 @@ void Thread::_print_activity_when_awaits_ipc()
 void Thread::_call_print_char() { Genode::printf("%c", (char)user_arg_1()); }
 
 
-void Thread::_call_await_signal()
+void Thread::_call_await_signal(unsigned const batch)
 {
 	/* lookup receiver */
 	Signal_receiver * const r = pd()->cap_tree().find<Signal_receiver>(user_arg_1());
@@ -422,7 +474,7 @@ void Thread::_call_await_signal()
 		return;
 	}
 	/* register handler at the receiver */
-	if (r->add_handler(this)) {
+	if (r->add_handler(this, batch)) {
 		PWRN("failed to register handler at signal receiver");
 		user_arg_0(-1);
 		return;
@@ -467,6 +519,28 @@ void Thread::_call_ack_signal()
 }
 
 
+void Thread::_call_ack_signals()
+{
+	capid_t const * const ids = (capid_t const *)utcb()->base();
+	unsigned const num = Genode::min((unsigned)user_arg_1(),
+	                                 max_signal_batch());
+
+	for (unsigned i = 0; i < num; i++) {
+
+		/* lookup signal context */
+		Signal_context * const c = pd()->cap_tree().find<Signal_context>(ids[i]);
+		if (!c) {
+			PWRN("%s -> %s: cannot ack unknown signal context",
+			     pd_label(), label());
+			continue;
+		}
+
+		/* acknowledge */
+		c->ack();
+	}
+}
+
+
 void Thread::_call_kill_signal_context()
 {
 	/* lookup signal context */
@@ -497,13 +571,13 @@ void Thread::_call_new_irq()
 		return;
 	}
 
-	new ((void *)user_arg_1()) User_irq(user_arg_2(), *c);
+	new ((void *)user_arg_1()) User_irq(user_arg_2(), *c, Cpu::executing_id());
 	user_arg_0(0);
 }
 
 
 void Thread::_call_ack_irq() {
-	reinterpret_cast<User_irq*>(user_arg_1())->enable(); }
+	reinterpret_cast<User_irq*>(user_arg_1())->ack(); }
 
 
 void Thread::_call_new_obj()
@@ -568,8 +642,10 @@ void Thread::_call()
 	case call_id_await_request_msg():    _call_await_request_msg(); return;
 	case call_id_kill_signal_context():  _call_kill_signal_context(); return;
 	case call_id_submit_signal():        _call_submit_signal(); return;
-	case call_id_await_signal():         _call_await_signal(); return;
+	case call_id_await_signal():         _call_await_signal(1); return;
 	case call_id_ack_signal():           _call_ack_signal(); return;
+	case call_id_await_signals():        _call_await_signal(user_arg_2()); return;
+	case call_id_ack_signals():          _call_ack_signals(); return;
 	case call_id_print_char():           _call_print_char(); return;
 	case call_id_ack_cap():              _call_ack_cap(); return;
 	case call_id_delete_cap():           _call_delete_cap(); return;
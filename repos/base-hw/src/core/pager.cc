@@ -16,6 +16,7 @@
 
 /* core includes*/
 #include <pager.h>
+#include <platform.h>
 #include <platform_thread.h>
 #include <platform_pd.h>
 
@@ -92,12 +93,26 @@ void Pager_object::unresolved_page_fault_occurred()
 		     pt->kernel_object()->sp, pt->kernel_object()->fault_addr());
 }
 
-Pager_object::Pager_object(unsigned const badge, Affinity::Location)
+Pager_object::Pager_object(unsigned const badge,
+                           Affinity::Location location)
 : Object_pool<Pager_object>::Entry(Kernel_object<Kernel::Signal_context>::_cap),
-  _badge(badge)
+  _badge(badge), _location(location)
 { }
 
 
+/**********************
+ ** Pager_activation **
+ **********************/
+
+Pager_activation::Pager_activation(Pager_entrypoint &ep, unsigned const cpu)
+: Thread<PAGER_EP_STACK_SIZE>("pager_ep"),
+  Kernel_object<Kernel::Signal_receiver>(true), _ep(ep)
+{
+	tid().platform_thread->affinity(Affinity::Location(cpu, 0));
+	start();
+}
+
+
 /**********************
  ** Pager_entrypoint **
  **********************/
@@ -109,14 +124,24 @@ void Pager_entrypoint::dissolve(Pager_object * const o)
 
 
 Pager_entrypoint::Pager_entrypoint(Cap_session *)
-: Thread<PAGER_EP_STACK_SIZE>("pager_ep"),
-  Kernel_object<Kernel::Signal_receiver>(true)
-{ start(); }
+{
+	for (unsigned i = 0; i < NR_OF_CPUS; i++)
+		_activations[i] = new (platform()->core_mem_alloc())
+			Pager_activation(*this, i);
+}
+
+
+Pager_activation & Pager_entrypoint::_activation(Affinity::Location const l)
+{
+	/* threads without a valid location are paged on the primary CPU */
+	unsigned const cpu = l.valid() ? l.xpos() : Cpu::primary_id();
+	return *_activations[cpu < NR_OF_CPUS ? cpu : Cpu::primary_id()];
+}
 
 
 Pager_capability Pager_entrypoint::manage(Pager_object * const o)
 {
-	o->start_paging(kernel_object());
+	o->start_paging(_activation(o->location()).kernel_object());
 	insert(o);
 	return reinterpret_cap_cast<Pager_object>(o->cap());
 }
@@ -18,6 +18,9 @@
 void Kernel::Perf_counter::enable() { }
 
 
+void Kernel::Perf_counter::account(Genode::Trace::Perf_counters &) { }
+
+
 Kernel::Perf_counter* Kernel::perf_counter()
 {
 	static Kernel::Perf_counter inst;
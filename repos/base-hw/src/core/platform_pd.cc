@@ -83,10 +83,10 @@ Hw::Address_space::Address_space(Kernel::Pd* pd, Translation_table * tt,
 : _tt(tt), _tt_phys(tt), _tt_alloc(tt_alloc), _kernel_pd(pd) { }
 
 
-Hw::Address_space::Address_space(Kernel::Pd * pd)
+Hw::Address_space::Address_space(Kernel::Pd * pd, Allocator_guard &quota)
 : _tt(construct_at<Translation_table>(_table_alloc())),
   _tt_phys(reinterpret_cast<Translation_table*>(_cma()->phys_addr(_tt))),
-  _tt_alloc((new (_cma()) Table_allocator(_cma()))->alloc()),
+  _tt_alloc(new (_cma()) Table_allocator(*_cma(), quota)),
   _kernel_pd(pd)
 {
 	Lock::Guard guard(_lock);
@@ -97,7 +97,7 @@ Hw::Address_space::Address_space(Kernel::Pd * pd)
 Hw::Address_space::~Address_space()
 {
 	flush(platform()->vm_start(), platform()->vm_size());
-	destroy(_cma(), Table_allocator::base(_tt_alloc));
+	destroy(_cma(), static_cast<Table_allocator *>(_tt_alloc));
 	destroy(_cma(), _tt);
 }
 
@@ -162,8 +162,8 @@ Platform_pd::Platform_pd(Translation_table * tt,
   _label("core") { }
 
 
-Platform_pd::Platform_pd(Allocator * md_alloc, char const *label)
-: Hw::Address_space(kernel_object()),
+Platform_pd::Platform_pd(Allocator_guard * md_alloc, char const *label)
+: Hw::Address_space(kernel_object(), *md_alloc),
   Kernel_object<Kernel::Pd>(true, translation_table_phys(), this),
   _label(label)
 {
@@ -164,6 +164,13 @@ int Platform_thread::start(void * const ip, void * const sp)
 	unsigned const cpu =
 		_location.valid() ? _location.xpos() : Cpu::primary_id();
 
+	/* the location spans the CPUs the kernel may migrate the thread to */
+	unsigned mask = 0;
+	if (_location.valid())
+		for (unsigned i = 0; i < _location.width(); i++)
+			if (cpu + i < NR_OF_CPUS)
+				mask |= 1U << (cpu + i);
+
 	Native_utcb * utcb = Thread_base::myself()->utcb();
 
 	/* reset capability counter */
@@ -174,7 +181,7 @@ int Platform_thread::start(void * const ip, void * const sp)
 		utcb->cap_add(_utcb.dst());
 	}
 	Kernel::start_thread(kernel_object(), cpu, _pd->kernel_pd(),
-	                     _utcb_core_addr);
+	                     _utcb_core_addr, mask);
 	return 0;
 }
 
@@ -48,7 +48,7 @@ void Ram_session_component::_clear_ds (Dataspace_component * ds)
 	}
 
 	/* clear dataspace */
-	memset(virt_addr, 0, page_rounded_size);
+	memclear(virt_addr, page_rounded_size);
 
 	/* uncached dataspaces need to be flushed from the data cache */
 	if (ds->cacheability() != CACHED)
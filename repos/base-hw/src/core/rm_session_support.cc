@@ -23,6 +23,13 @@
 using namespace Genode;
 
 
+size_t Genode::constrain_map_size_log2(size_t size_log2)
+{
+	constexpr size_t max = Translation_table::MAX_PAGE_SIZE_LOG2;
+	return size_log2 > max ? max : size_log2;
+}
+
+
 /***************
  ** Rm_client **
  ***************/
@@ -36,11 +43,28 @@ void Rm_client::unmap(addr_t, addr_t virt_base, size_t size)
 }
 
 
+void Rm_client::prefault(Rm_region const &region)
+{
+	Locked_ptr<Address_space> locked_address_space(_address_space);
+	if (!locked_address_space.is_valid()) return;
+
+	/* the translation table uses the largest pages that fit the region */
+	Dataspace_component * const dsc = region.dataspace();
+	Hw::Address_space * as =
+		static_cast<Hw::Address_space*>(&*locked_address_space);
+	Page_flags const flags =
+		Page_flags::apply_mapping(dsc->writable(), dsc->cacheability(),
+		                          dsc->is_io_mem());
+	as->insert_translation(region.base(), dsc->phys_addr() + region.offset(),
+	                       region.size(), flags);
+}
+
+
 /**********************
- ** Pager_entrypoint **
+ ** Pager_activation **
  **********************/
 
-void Pager_entrypoint::entry()
+void Pager_activation::entry()
 {
 	while (1)
 	{
@@ -91,6 +115,6 @@ void Pager_entrypoint::entry()
 			/* let pager object go back to no-fault state */
 			po->wake_up();
 		};
-		apply(cap, lambda);
+		_ep.apply(cap, lambda);
 	}
 }
@@ -11,14 +11,102 @@
  * under the terms of the GNU General Public License version 2.
  */
 
-/* Genode includes */
-#include <util/bit_allocator.h>
-
 /* core includes */
 #include <assert.h>
 #include <kernel/pd.h>
 
-using Asid_allocator = Genode::Bit_allocator<256>;
+using namespace Kernel;
+
+
+/**
+ * Allocator of address-space IDs that recycles IDs in generations
+ *
+ * ASIDs are not freed individually. If all of them are in use, a new
+ * generation starts, which revokes the ASIDs of all PDs except for the
+ * PDs that are currently active on a CPU. Those keep their ASID. Each CPU
+ * flushes its TLB once before it executes a PD of the new generation,
+ * and PDs of an old generation obtain a new ASID on their next
+ * activation. In contrast to flushing the TLB on each address-space
+ * switch, the costs of a new generation are shared by 255 PDs. ASID 0 is
+ * owned by core, which is never subject to recycling.
+ */
+class Asid_allocator
+{
+	private:
+
+		enum { MAX_ASIDS = 256 };
+
+		bool     _used[MAX_ASIDS];
+		unsigned _next       = 0;
+		unsigned _generation = 1;
+		Pd *     _active[NR_OF_CPUS];
+		bool     _flush[NR_OF_CPUS];
+
+		void _new_generation()
+		{
+			_generation++;
+			_next = 1;
+			for (unsigned i = 1; i < MAX_ASIDS; i++) { _used[i] = false; }
+
+			for (unsigned i = 0; i < NR_OF_CPUS; i++) {
+				_flush[i] = true;
+				if (!_active[i]) { continue; }
+				_used[_active[i]->asid]  = true;
+				_active[i]->generation = _generation;
+			}
+		}
+
+	public:
+
+		Asid_allocator()
+		{
+			for (unsigned i = 0; i < MAX_ASIDS; i++) { _used[i] = false; }
+			for (unsigned i = 0; i < NR_OF_CPUS; i++) {
+				_active[i] = nullptr;
+				_flush[i]  = false;
+			}
+		}
+
+		/**
+		 * Assign an ASID of the current generation to 'pd'
+		 */
+		void assign(Pd &pd)
+		{
+			for (;;) {
+				for (; _next < MAX_ASIDS; _next++) {
+					if (_used[_next]) { continue; }
+					_used[_next]  = true;
+					pd.asid       = _next++;
+					pd.generation = _generation;
+					return;
+				}
+				_new_generation();
+			}
+		}
+
+		/**
+		 * Prepare CPU 'cpu' for executing 'pd'
+		 */
+		void activate(Pd &pd, unsigned const cpu)
+		{
+			if (pd.asid && pd.generation != _generation) { assign(pd); }
+			_active[cpu] = &pd;
+
+			if (!_flush[cpu]) { return; }
+			_flush[cpu] = false;
+			cpu_pool()->cpu(cpu)->invalidate_tlb();
+		}
+
+		/**
+		 * Forget about 'pd' as it gets destructed
+		 */
+		void release(Pd &pd)
+		{
+			for (unsigned i = 0; i < NR_OF_CPUS; i++) {
+				if (_active[i] == &pd) { _active[i] = nullptr; } }
+		}
+};
+
 
 static Asid_allocator &alloc() {
 	return *unmanaged_singleton<Asid_allocator>(); }
@@ -26,9 +114,11 @@ static Asid_allocator &alloc() {
 
 Kernel::Pd::Pd(Kernel::Pd::Table * const table,
                Genode::Platform_pd * const platform_pd)
-: Kernel::Cpu::Pd((Genode::uint8_t)alloc().alloc()),
-  _table(table), _platform_pd(platform_pd)
+: _table(table), _platform_pd(platform_pd)
 {
+	/* core is the first PD and thereby obtains ASID 0 */
+	alloc().assign(*this);
+
 	capid_t invalid = _capid_alloc.alloc();
 	assert(invalid == cap_id_invalid());
 }
@@ -44,7 +134,7 @@ Kernel::Pd::~Pd() {
 	cpu->clean_invalidate_data_cache();
 	cpu->invalidate_instr_cache();
 	cpu->invalidate_tlb_by_pid(asid);
-	alloc().free(asid);
+	alloc().release(*this);
 }
 
 
@@ -53,3 +143,10 @@ void Kernel::Pd::admit(Kernel::Cpu::Context * const c)
 	c->protection_domain(asid);
 	c->translation_table((addr_t)translation_table());
 }
+
+
+void Kernel::Pd::activate(Kernel::Cpu::Context * const c, unsigned const cpu)
+{
+	alloc().activate(*this, cpu);
+	c->protection_domain(asid);
+}
@@ -98,7 +98,13 @@ void Kernel::Thread::_call_update_data_region()
 	}
 	auto base = (addr_t)user_arg_1();
 	auto const size = (size_t)user_arg_2();
-	cpu->clean_invalidate_data_cache_by_virt_region(base, size);
+
+	/* core clears and thereby maintains whole dataspaces of any size */
+	if (size > Cpu::max_cache_region_size)
+		cpu->clean_invalidate_data_cache();
+	else
+		cpu->clean_invalidate_data_cache_by_virt_region(base, size);
+
 	cpu->invalidate_instr_cache();
 }
 
@@ -123,6 +129,12 @@ void Kernel::Thread::_call_update_instr_region()
 	}
 	auto base = (addr_t)user_arg_1();
 	auto const size = (size_t)user_arg_2();
+
+	if (size > Cpu::max_cache_region_size) {
+		cpu->clean_invalidate_data_cache();
+		cpu->invalidate_instr_cache();
+		return;
+	}
 	cpu->clean_invalidate_data_cache_by_virt_region(base, size);
 	cpu->invalidate_instr_cache_by_virt_region(base, size);
 }
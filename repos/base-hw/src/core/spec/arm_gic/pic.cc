@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -22,11 +22,10 @@ void Pic::_init()
 	_distr.write<Distr::Ctlr::Enable>(0);
 
 	/* configure every shared peripheral interrupt */
-	for (unsigned i = min_spi; i <= _max_irq; i++) {
-		_distr.write<Distr::Icfgr::Edge_triggered>(0, i);
-		_distr.write<Distr::Ipriorityr::Priority>(0, i);
-		_distr.write<Distr::Icenabler::Clear_enable>(1, i);
-	}
+	unsigned const spis = _max_irq - min_spi + 1;
+	_distr.write<Distr::Icfgr::Edge_triggered>(0, min_spi, spis);
+	_distr.write<Distr::Ipriorityr::Priority>(0, min_spi, spis);
+	_distr.write<Distr::Icenabler::Clear_enable>(1, min_spi, spis);
 	/* enable device */
 	_distr.write<Distr::Ctlr::Enable>(1);
 }
@@ -31,6 +31,15 @@ struct Pmcr : Register<32>
 	struct C : Bitfield<2,1> { }; /* cycle counter reset */
 	struct D : Bitfield<3,1> { }; /* cycle counter divider */
 
+	struct Evt_count_1 : Bitfield<12,8> { }; /* event of count register 1 */
+	struct Evt_count_0 : Bitfield<20,8> { }; /* event of count register 0 */
+
+	enum {
+		BR_MIS_PRED    = 0x06, /* branch mispredicted */
+		INSTR_EXECUTED = 0x07, /* instruction executed */
+		DCACHE_MISS    = 0x0b, /* data cache miss */
+	};
+
 	static access_t enable_and_reset()
 	{
 		access_t v = 0;
@@ -52,6 +61,34 @@ struct Pmcr : Register<32>
 };
 
 
+/**
+ * Count Register 0
+ */
+struct Cr0 : Register<32>
+{
+	static access_t read()
+	{
+		access_t v;
+		asm volatile("mrc p15, 0, %[v], c15, c12, 2" : [v]"=r"(v) :: );
+		return v;
+	}
+};
+
+
+/**
+ * Count Register 1
+ */
+struct Cr1 : Register<32>
+{
+	static access_t read()
+	{
+		access_t v;
+		asm volatile("mrc p15, 0, %[v], c15, c12, 3" : [v]"=r"(v) :: );
+		return v;
+	}
+};
+
+
 /**
  * System Validation Counter Register
  */
@@ -97,6 +134,8 @@ void Kernel::Perf_counter::enable()
 	/* enable counters and disable overflow interrupt. */
 	Pmcr::access_t v = Pmcr::enable_and_reset();
 	Pmcr::D::set(v, 1); /* count every 64 cycles */
+	Pmcr::Evt_count_0::set(v, Pmcr::INSTR_EXECUTED);
+	Pmcr::Evt_count_1::set(v, Pmcr::DCACHE_MISS);
 	Pmcr::write(v);
 
 	Sysvalcntrr::write(Sysvalcntrr::reset_counter());
@@ -106,6 +145,20 @@ void Kernel::Perf_counter::enable()
 }
 
 
+void Kernel::Perf_counter::account(Trace::Perf_counters &counters)
+{
+	/* the two count registers do not suffice for branch mispredictions */
+	counters.value[Trace::Perf_counters::INSTRUCTIONS] += Cr0::read();
+	counters.value[Trace::Perf_counters::CACHE_MISSES] += Cr1::read();
+
+	/* restart the count registers but leave the cycle counter running */
+	Pmcr::access_t v = Pmcr::read();
+	Pmcr::P::set(v, 1);
+	Pmcr::C::set(v, 0);
+	Pmcr::write(v);
+}
+
+
 Kernel::Perf_counter* Kernel::perf_counter()
 {
 	static Kernel::Perf_counter inst;
@@ -167,6 +167,60 @@ struct Pmuseren : Register<32>
 };
 
 
+/**
+ * Event Counter Selection Register
+ */
+struct Pmselr : Register<32>
+{
+	struct Sel : Bitfield<0,5> { }; /* counter accessed via Pmxev* */
+
+	static void write(access_t const v) {
+		asm volatile("mcr p15, 0, %[v], c9, c12, 5" :: [v]"r"(v) : ); }
+};
+
+
+/**
+ * Event Type Select Register of the selected counter
+ */
+struct Pmxevtyper : Register<32>
+{
+	struct Evt_count : Bitfield<0,8> { }; /* event that is counted */
+
+	enum {
+		L1D_CACHE_REFILL = 0x03, /* level 1 data cache refill */
+		INSTR_EXECUTED   = 0x08, /* instruction architecturally executed */
+		BR_MIS_PRED      = 0x10, /* mispredicted or not predicted branch */
+	};
+
+	static void write(access_t const v) {
+		asm volatile("mcr p15, 0, %[v], c9, c13, 1" :: [v]"r"(v) : ); }
+};
+
+
+/**
+ * Event Count Register of the selected counter
+ */
+struct Pmxevcntr : Register<32>
+{
+	static access_t read()
+	{
+		access_t v;
+		asm volatile("mrc p15, 0, %[v], c9, c13, 2" : [v]"=r"(v) :: );
+		return v;
+	}
+};
+
+
+/**
+ * Events counted by the event counters 0 to 2
+ *
+ * The order corresponds to 'Trace::Perf_counters::Event'.
+ */
+static Pmxevtyper::access_t const events[Trace::Perf_counters::NUM_EVENTS] = {
+	Pmxevtyper::INSTR_EXECUTED, Pmxevtyper::L1D_CACHE_REFILL,
+	Pmxevtyper::BR_MIS_PRED };
+
+
 void Kernel::Perf_counter::enable()
 {
 	/* program PMU and enable all counters */
@@ -177,6 +231,27 @@ void Kernel::Perf_counter::enable()
 	/* enable user-mode access to counters and disable overflow interrupt. */
 	Pmuseren::write(Pmuseren::enable());
 	Pmintenclr::write(Pmintenclr::disable_overflow_intr());
+
+	/* select the events of the counters that are accounted per job */
+	for (unsigned i = 0; i < Trace::Perf_counters::NUM_EVENTS; i++) {
+		Pmselr::write(Pmselr::Sel::bits(i));
+		Pmxevtyper::write(Pmxevtyper::Evt_count::bits(events[i]));
+	}
+}
+
+
+void Kernel::Perf_counter::account(Trace::Perf_counters &counters)
+{
+	for (unsigned i = 0; i < Trace::Perf_counters::NUM_EVENTS; i++) {
+		Pmselr::write(Pmselr::Sel::bits(i));
+		counters.value[i] += Pmxevcntr::read();
+	}
+
+	/* restart the event counters but leave the cycle counter running */
+	Pmcr::access_t v = Pmcr::read();
+	Pmcr::P::set(v, 1);
+	Pmcr::C::set(v, 0);
+	Pmcr::write(v);
 }
 
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -22,13 +22,14 @@ void Pic::_init()
 	_distr.write<Distr::Ctlr>(0);
 
 	/* configure every shared peripheral interrupt */
-	for (unsigned i = min_spi; i <= _max_irq; i++) {
-		/* mark as non-secure */
-		_distr.write<Distr::Igroupr::Group_status>(1, i);
-		_distr.write<Distr::Icfgr::Edge_triggered>(0, i);
-		_distr.write<Distr::Ipriorityr::Priority>(0, i);
-		_distr.write<Distr::Icenabler::Clear_enable>(1, i);
-	}
+	unsigned const spis = _max_irq - min_spi + 1;
+
+	/* mark as non-secure */
+	_distr.write<Distr::Igroupr::Group_status>(1, min_spi, spis);
+	_distr.write<Distr::Icfgr::Edge_triggered>(0, min_spi, spis);
+	_distr.write<Distr::Ipriorityr::Priority>(0, min_spi, spis);
+	_distr.write<Distr::Icenabler::Clear_enable>(1, min_spi, spis);
+
 	/* enable device */
 	Distr::Ctlr::access_t v = 0;
 	Distr::Ctlr::Enable_grp0::set(v, 1);
@@ -29,6 +29,7 @@ extern "C" void kernel()
 
 		cpu_id = Cpu::executing_id();
 		Cpu * const cpu  = cpu_pool()->cpu(cpu_id);
+		perf_counter()->account(cpu->scheduled_job().perf_counters());
 		cpu->scheduled_job().exception(cpu_id);
 		new_job = &cpu->schedule();
 	}
@@ -29,7 +29,27 @@ Genode::Cpu::Cpu()
 }
 
 
-void Genode::Cpu::Context::init(addr_t const table, bool core)
+bool Genode::Cpu::pcid_supported()
+{
+	enum { CPUID_FEATURES = 1, ECX_PCID = 1 << 17 };
+
+	unsigned eax = CPUID_FEATURES, ebx, ecx = 0, edx;
+	asm volatile ("cpuid" : "+a" (eax), "=b" (ebx), "+c" (ecx), "=d" (edx));
+	return ecx & ECX_PCID;
+}
+
+
+void Genode::Cpu::invalidate_tlb()
+{
+	/* each change of CR4.PGE drops all TLB entries of all PCIDs */
+	Cr4::access_t const cr4 = Cr4::read();
+	Cr4::write(cr4 ^ Cr4::Pge::bits(1));
+	Cr4::write(cr4);
+}
+
+
+void Genode::Cpu::Context::init(addr_t const table, unsigned const pcid,
+                                bool core)
 {
 	/* Constants to handle IF, IOPL values */
 	enum {
@@ -37,7 +57,12 @@ void Genode::Cpu::Context::init(addr_t const table, bool core)
 		EFLAGS_IOPL_3 = 3 << 12,
 	};
 
-	cr3 = Cr3::init(table);
+	/*
+	 * With PCIDs, an address-space switch keeps the TLB entries of the
+	 * targeted PD unless they may belong to another PD as well.
+	 */
+	cr3 = pcid_supported() ? Cr3::init(table, pcid, pcid != PCID_SHARED)
+	                       : Cr3::init(table);
 
 	/*
 	 * Enable interrupts for all threads, set I/O privilege level
@@ -25,7 +25,7 @@ Cpu_idle::Cpu_idle(Cpu * const cpu) : Cpu_job(Cpu_priority::MIN, 0)
 	Cpu_job::cpu(cpu);
 	ip = (addr_t)&_main;
 	sp = (addr_t)&_stack[stack_size];
-	init((addr_t)core_pd()->translation_table(), true);
+	init((addr_t)core_pd()->translation_table(), core_pd()->pcid, true);
 }
 
 
@@ -45,6 +45,18 @@ void Kernel::Cpu::init(Pic &pic, Kernel::Pd &core_pd, Genode::Board&)
 
 	Cr3::write(Cr3::init((addr_t)core_pd.translation_table()));
 
+	/*
+	 * Tag TLB entries with the process-context id of their PD to avoid
+	 * flushing the TLB on each switch between two address spaces. This
+	 * requires the PCID of the current CR3 value to be zero, which is the
+	 * case for core.
+	 */
+	if (pcid_supported()) {
+		Cr4::access_t cr4 = Cr4::read();
+		Cr4::Pcide::set(cr4);
+		Cr4::write(cr4);
+	}
+
 	/* enable timer interrupt */
 	unsigned const cpu = Cpu::executing_id();
 	pic.unmask(Timer::interrupt_id(cpu), cpu);
@@ -11,13 +11,32 @@
  * under the terms of the GNU General Public License version 2.
  */
 
+/* Genode includes */
+#include <util/bit_allocator.h>
+
 /* core includes */
 #include <platform_pd.h>
 #include <kernel/pd.h>
 
+using Pcid_allocator = Genode::Bit_allocator<Kernel::Cpu::PCID_SHARED>;
+
+static Pcid_allocator &alloc() {
+	return *unmanaged_singleton<Pcid_allocator>(); }
+
+
+/**
+ * Return unused process-context id, core obtains the first one, 0
+ */
+static Genode::uint16_t alloc_pcid()
+{
+	try { return alloc().alloc(); }
+	catch (Pcid_allocator::Out_of_indices) { return Kernel::Cpu::PCID_SHARED; }
+}
+
+
 Kernel::Pd::Pd(Kernel::Pd::Table   * const table,
                Genode::Platform_pd * const platform_pd)
-: _table(table), _platform_pd(platform_pd)
+: Kernel::Cpu::Pd(alloc_pcid()), _table(table), _platform_pd(platform_pd)
 {
 	capid_t invalid = _capid_alloc.alloc();
 	assert(invalid == cap_id_invalid());
@@ -28,8 +47,17 @@ Kernel::Pd::~Pd()
 {
 	while (Object_identity_reference *oir = _cap_tree.first())
 		oir->~Object_identity_reference();
+
+	if (pcid == Cpu::PCID_SHARED) return;
+
+	/* drop the translations of the PCID before it gets reused */
+	if (Cpu::pcid_supported()) Cpu::invalidate_tlb();
+	alloc().free(pcid);
 }
 
 
 void Kernel::Pd::admit(Kernel::Cpu::Context * const c) {
-	c->init((addr_t)translation_table(), this == Kernel::core_pd()); }
+	c->init((addr_t)translation_table(), pcid, this == Kernel::core_pd()); }
+
+
+void Kernel::Pd::activate(Kernel::Cpu::Context * const, unsigned const) { }
@@ -73,8 +73,9 @@ void Pic::finish_request()
 	write<EOI>(0);
 }
 
-void Pic::unmask(unsigned const i, unsigned)
+void Pic::unmask(unsigned const i, unsigned const cpu)
 {
+	ioapic.route(i, cpu);
 	ioapic.toggle_mask(i, false);
 }
 
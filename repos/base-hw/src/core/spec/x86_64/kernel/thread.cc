@@ -40,4 +40,11 @@ void Kernel::Thread::_mmu_exception()
 void Kernel::Thread::_init() { }
 
 
-void Kernel::Thread::_call_update_pd() { }
+void Kernel::Thread::_call_update_pd()
+{
+	/*
+	 * Without PCIDs, the TLB is flushed on each switch between address
+	 * spaces anyway. Otherwise, stale entries may survive the switch.
+	 */
+	if (Cpu::Cr4::Pcide::get(Cpu::Cr4::read())) Cpu::invalidate_tlb();
+}
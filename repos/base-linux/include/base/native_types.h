@@ -77,7 +77,18 @@ namespace Genode {
 		 */
 		Thread_meta_data *meta_data;
 
-		Native_thread() : is_ipc_server(false), futex_counter(0), meta_data(0) { }
+		/**
+		 * Socket pair used as reply channel of the thread's RPC calls
+		 *
+		 * The pair is created on the first call and reused for all further
+		 * calls, which spares the creation and closing of sockets per call.
+		 */
+		int reply_sd[2];
+
+		Native_thread() : is_ipc_server(false), futex_counter(0), meta_data(0)
+		{
+			reply_sd[0] = reply_sd[1] = -1;
+		}
 	};
 
 	inline bool operator == (Native_thread_id t1, Native_thread_id t2) {
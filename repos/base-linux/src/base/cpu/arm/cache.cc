@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -19,3 +19,15 @@ void Genode::cache_coherent(Genode::addr_t addr, Genode::size_t size)
 {
 	lx_syscall(__ARM_NR_cacheflush, addr, addr + size, 0);
 }
+
+
+/*
+ * Linux does not offer data-cache maintenance to user space. Devices are
+ * not driven by Genode components on this platform anyway.
+ */
+
+void Genode::cache_clean(Genode::addr_t, Genode::size_t) { }
+
+void Genode::cache_invalidate(Genode::addr_t, Genode::size_t) { }
+
+void Genode::cache_clean_invalidate(Genode::addr_t, Genode::size_t) { }
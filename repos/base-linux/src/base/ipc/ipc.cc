@@ -300,47 +300,80 @@ static void extract_sds_from_message(unsigned start_index, Message const &msg,
 }
 
 
-/**
- * Send request to server and wait for reply
- */
-static inline void lx_call(int dst_sd,
-                           Genode::Msgbuf_base &send_msgbuf, Genode::size_t send_msg_len,
-                           Genode::Msgbuf_base &recv_msgbuf)
-{
-	int ret;
-	Message send_msg(send_msgbuf.buf, send_msg_len);
+namespace {
 
-	/*
-	 * Create reply channel
+	/**
+	 * Reply channel of the calling thread
 	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
+	 * The remote socket is passed to the server with each request, which
+	 * replies to it and closes its copy afterwards. Because the client blocks
+	 * until the reply arrived, the channel of a thread carries no more than
+	 * one reply at a time and can be reused for the thread's next call.
 	 */
 	struct Reply_channel
 	{
 		enum { LOCAL_SOCKET = 0, REMOTE_SOCKET = 1 };
-		int sd[2];
 
-		Reply_channel()
+		int * const sd;
+
+		/**
+		 * Constructor
+		 *
+		 * \param sd  socket pair of the calling thread, created on demand
+		 */
+		Reply_channel(int *sd) : sd(sd)
 		{
-			sd[LOCAL_SOCKET] = -1; sd[REMOTE_SOCKET] = -1;
+			if (sd[LOCAL_SOCKET] != -1)
+				return;
 
 			int ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
 			if (ret < 0) {
+				sd[LOCAL_SOCKET] = sd[REMOTE_SOCKET] = -1;
 				PRAW("[%d] lx_socketpair failed with %d", lx_getpid(), ret);
 				throw Genode::Ipc_error();
 			}
 		}
 
-		~Reply_channel()
+		/**
+		 * Close channel such that the next call creates a fresh one
+		 */
+		void discard()
 		{
-			if (sd[LOCAL_SOCKET]  != -1) lx_close(sd[LOCAL_SOCKET]);
-			if (sd[REMOTE_SOCKET] != -1) lx_close(sd[REMOTE_SOCKET]);
+			lx_close(sd[LOCAL_SOCKET]);
+			lx_close(sd[REMOTE_SOCKET]);
+			sd[LOCAL_SOCKET] = sd[REMOTE_SOCKET] = -1;
 		}
 
 		int local_socket()  const { return sd[LOCAL_SOCKET];  }
 		int remote_socket() const { return sd[REMOTE_SOCKET]; }
+	};
 
-	} reply_channel;
+} /* unnamed namespace */
+
+
+static int *reply_channel_of_myself()
+{
+	Genode::Thread_base *myself = Genode::Thread_base::myself();
+	if (myself)
+		return myself->tid().reply_sd;
+
+	/* the main thread is the only thread without a 'Thread_base' */
+	static int main_reply_sd[2] = { -1, -1 };
+	return main_reply_sd;
+}
+
+
+/**
+ * Send request to server and wait for reply
+ */
+static inline void lx_call(int dst_sd,
+                           Genode::Msgbuf_base &send_msgbuf, Genode::size_t send_msg_len,
+                           Genode::Msgbuf_base &recv_msgbuf)
+{
+	int ret;
+	Message send_msg(send_msgbuf.buf, send_msg_len);
+
+	Reply_channel reply_channel(reply_channel_of_myself());
 
 	/* assemble message */
 
@@ -365,6 +398,13 @@ static inline void lx_call(int dst_sd,
 
 	ret = lx_recvmsg(reply_channel.local_socket(), recv_msg.msg(), 0);
 
+	/*
+	 * If the call is not completed, the reply may still arrive later. So
+	 * the channel must not be reused for the next call.
+	 */
+	if (ret < 0)
+		reply_channel.discard();
+
 	/* system call got interrupted by a signal */
 	if (ret == -LX_EINTR)
 		throw Genode::Blocking_canceled();
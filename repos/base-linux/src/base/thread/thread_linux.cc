@@ -112,6 +112,11 @@ void Thread_base::_deinit_platform_thread()
 		lx_nanosleep(&ts, 0);
 	}
 
+	/* close the reply channel of the thread's RPC calls */
+	for (unsigned i = 0; i < 2; i++)
+		if (_tid.reply_sd[i] != -1)
+			lx_close(_tid.reply_sd[i]);
+
 	/* inform core about the killed thread */
 	_cpu_session->kill_thread(_thread_cap);
 }
@@ -17,6 +17,7 @@
 #define _CORE__INCLUDE__LINUX__PLATFORM_THREAD_H_
 
 /* Genode includes */
+#include <base/trace/types.h>
 #include <base/thread_state.h>
 #include <cpu_session/cpu_session.h>
 
@@ -166,6 +167,12 @@ namespace Genode {
 			 * Return execution time consumed by the thread
 			 */
 			unsigned long long execution_time() const { return 0; }
+
+			/**
+			 * Return hardware events counted for the thread
+			 */
+			Trace::Perf_counters perf_counters() const {
+				return Trace::Perf_counters(); }
 	};
 }
 
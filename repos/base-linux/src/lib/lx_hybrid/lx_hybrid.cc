@@ -462,6 +462,11 @@ Thread_base::~Thread_base()
 
 	_tid.meta_data = 0;
 
+	/* close the reply channel of the thread's RPC calls */
+	for (unsigned i = 0; i < 2; i++)
+		if (_tid.reply_sd[i] != -1)
+			lx_close(_tid.reply_sd[i]);
+
 	/* inform core about the killed thread */
 	cpu_session(_cpu_session)->kill_thread(_thread_cap);
 }
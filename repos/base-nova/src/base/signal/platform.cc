@@ -17,6 +17,10 @@
 
 using namespace Genode;
 
+
+extern bool local_signal_submit(Signal_context_capability, unsigned);
+
+
 /************************
  ** Signal transmitter **
  ************************/
@@ -29,6 +33,14 @@ void Signal_transmitter::submit(unsigned cnt)
 	if (!_context.valid())
 		return;
 
+	/*
+	 * If the context belongs to a receiver of our own process, hand over
+	 * the signal directly instead of taking the detour via the kernel
+	 * semaphore and the signal-handler thread.
+	 */
+	if (local_signal_submit(_context, cnt))
+		return;
+
 	using namespace Nova;
 
 	uint8_t res = NOVA_OK;
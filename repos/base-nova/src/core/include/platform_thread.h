@@ -16,6 +16,7 @@
 #define _CORE__INCLUDE__PLATFORM_THREAD_H_
 
 /* Genode includes */
+#include <base/trace/types.h>
 #include <thread/capability.h>
 #include <base/thread_state.h>
 #include <base/native_types.h>
@@ -175,6 +176,12 @@ namespace Genode {
 			 * Return execution time consumed by the thread
 			 */
 			unsigned long long execution_time() const;
+
+			/**
+			 * Return hardware events counted for the thread
+			 */
+			Trace::Perf_counters perf_counters() const {
+				return Trace::Perf_counters(); }
 	};
 }
 
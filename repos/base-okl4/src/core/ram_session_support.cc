@@ -52,9 +52,7 @@ void Ram_session_component::_clear_ds (Dataspace_component *ds)
 	}
 
 	/* clear dataspace */
-	size_t num_longwords = page_rounded_size/sizeof(long);
-	for (long *dst = (long *)virt_addr; num_longwords--;)
-		*dst++ = 0;
+	memclear(virt_addr, page_rounded_size);
 
 	/* unmap dataspace from core */
 	if (!unmap_local((addr_t)virt_addr, num_pages))
@@ -48,3 +48,9 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 		L4_Unmap(L4_FpageAddRightsTo(&fp, L4_FullyAccessible));
 	}
 }
+
+
+/*
+ * Mappings are established as response of page faults only.
+ */
+void Rm_client::prefault(Rm_region const &) { }
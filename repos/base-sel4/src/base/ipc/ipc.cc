@@ -28,14 +28,18 @@
 using namespace Genode;
 
 
-/**
- * Message-register definitions
+/*
+ * Message layout
+ *
+ * The number of capabilities is transferred as message label. The message
+ * registers hold the RPC object keys of the capabilities followed by the
+ * data payload. The first data word of the message buffer is not
+ * transferred because it is reserved for the badge of the invoked object
+ * at the receiver. Hence, an RPC without capability arguments and with at
+ * most one argument besides the opcode fits into the message registers
+ * that qualify for the seL4 fastpath.
  */
-enum {
-	MR_IDX_NUM_CAPS = 0,
-	MR_IDX_CAPS     = 1,
-	MR_IDX_DATA     = MR_IDX_CAPS + Msgbuf_base::MAX_CAPS_PER_MSG,
-};
+enum { FIRST_DATA_MWORD = 1 };
 
 
 /**
@@ -70,9 +74,9 @@ static seL4_MessageInfo_t new_seL4_message(Msgbuf_base &msg,
 	/*
 	 * Supply capabilities to kernel IPC message
 	 */
-	seL4_SetMR(MR_IDX_NUM_CAPS, msg.used_caps());
+	size_t const num_caps = msg.used_caps();
 	size_t sel4_sel_cnt = 0;
-	for (size_t i = 0; i < msg.used_caps(); i++) {
+	for (size_t i = 0; i < num_caps; i++) {
 
 		Native_capability &cap = msg.cap(i);
 
@@ -80,20 +84,13 @@ static seL4_MessageInfo_t new_seL4_message(Msgbuf_base &msg,
 			Capability_space::Ipc_cap_data const ipc_cap_data =
 				Capability_space::ipc_cap_data(cap);
 
-			seL4_SetMR(MR_IDX_CAPS + i, ipc_cap_data.rpc_obj_key.value());
+			seL4_SetMR(i, ipc_cap_data.rpc_obj_key.value());
 			seL4_SetCap(sel4_sel_cnt++, ipc_cap_data.sel);
 		} else {
-			seL4_SetMR(MR_IDX_CAPS + i, Rpc_obj_key::INVALID);
+			seL4_SetMR(i, Rpc_obj_key::INVALID);
 		}
 	}
 
-	/*
-	 * Pad unused capability slots with invalid capabilities to avoid
-	 * leakage of any information that happens to be in the IPC buffer.
-	 */
-	for (size_t i = msg.used_caps(); i < Msgbuf_base::MAX_CAPS_PER_MSG; i++)
-		seL4_SetMR(MR_IDX_CAPS + i, Rpc_obj_key::INVALID);
-
 	/*
 	 * Allocate and define receive selector
 	 */
@@ -105,15 +102,15 @@ static seL4_MessageInfo_t new_seL4_message(Msgbuf_base &msg,
 	 * Supply data payload
 	 */
 	size_t const num_data_mwords =
-		align_natural(data_length) / sizeof(umword_t);
+		align_natural(data_length) / sizeof(umword_t) - FIRST_DATA_MWORD;
 
-	umword_t const *src = (umword_t const *)msg.data();
+	umword_t const *src = (umword_t const *)msg.data() + FIRST_DATA_MWORD;
 	for (size_t i = 0; i < num_data_mwords; i++)
-		seL4_SetMR(MR_IDX_DATA + i, *src++);
+		seL4_SetMR(num_caps + i, *src++);
 
 	seL4_MessageInfo_t const msg_info =
-		seL4_MessageInfo_new(0, 0, sel4_sel_cnt,
-		                     MR_IDX_DATA + num_data_mwords);
+		seL4_MessageInfo_new(num_caps, 0, sel4_sel_cnt,
+		                     num_caps + num_data_mwords);
 	return msg_info;
 }
 
@@ -129,12 +126,15 @@ static void decode_seL4_message(umword_t badge,
 	 * Extract Genode capabilities from seL4 IPC message
 	 */
 	dst_msg.reset_caps();
-	size_t const num_caps = seL4_GetMR(MR_IDX_NUM_CAPS);
+	size_t const length   = seL4_MessageInfo_get_length(msg_info);
+	size_t const num_caps = min(seL4_MessageInfo_get_label(msg_info),
+	                            min((size_t)Msgbuf_base::MAX_CAPS_PER_MSG,
+	                                length));
 	size_t curr_sel4_cap_idx = 0;
 
 	for (size_t i = 0; i < num_caps; i++) {
 
-		Rpc_obj_key const rpc_obj_key(seL4_GetMR(MR_IDX_CAPS + i));
+		Rpc_obj_key const rpc_obj_key(seL4_GetMR(i));
 
 		/*
 		 * Detect passing of invalid capabilities as arguments
@@ -246,9 +246,9 @@ static void decode_seL4_message(umword_t badge,
 	 * Extract message data payload
 	 */
 
-	umword_t *dst = (umword_t *)dst_msg.data();
-	for (size_t i = 0; i < seL4_MessageInfo_get_length(msg_info); i++)
-		*dst++ = seL4_GetMR(MR_IDX_DATA + i);
+	umword_t *dst = (umword_t *)dst_msg.data() + FIRST_DATA_MWORD;
+	for (size_t i = num_caps; i < length; i++)
+		*dst++ = seL4_GetMR(i);
 
 	/*
 	 * Store RPC object key of invoked object to be picked up by server.cc
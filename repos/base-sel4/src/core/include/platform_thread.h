@@ -15,6 +15,7 @@
 #define _CORE__INCLUDE__PLATFORM_THREAD_H_
 
 /* Genode includes */
+#include <base/trace/types.h>
 #include <base/thread_state.h>
 #include <base/native_types.h>
 #include <util/string.h>
@@ -131,6 +132,12 @@ class Genode::Platform_thread : public List<Platform_thread>::Element
 		 */
 		unsigned long long execution_time() const { return 0; }
 
+		/**
+		 * Return hardware events counted for the thread
+		 */
+		Trace::Perf_counters perf_counters() const {
+			return Trace::Perf_counters(); }
+
 
 		/************************
 		 ** Accessor functions **
@@ -24,3 +24,9 @@ void Rm_client::unmap(addr_t core_local_base, addr_t virt_base, size_t size)
 	if (locked_address_space.is_valid())
 		locked_address_space->flush(virt_base, size);
 }
+
+
+/*
+ * Mappings are established as response of page faults only.
+ */
+void Rm_client::prefault(Rm_region const &) { }
@@ -50,8 +50,10 @@ class Genode::Allocator_avl_base : public Range_allocator
 				addr_t _addr;       /* base address    */
 				size_t _size;       /* size of block   */
 				bool   _used;       /* block is in use */
+				bool   _cached;     /* block is held in a free list */
 				short  _id;         /* for debugging   */
 				size_t _max_avail;  /* biggest free block size of subtree */
+				Block *_next_cached;
 
 				/**
 				 * Request max_avail value of subtree
@@ -104,6 +106,19 @@ class Genode::Allocator_avl_base : public Range_allocator
 
 				inline void used(bool used) { _used = used; }
 
+				/**
+				 * Return true if the block was freed but is kept in a
+				 * segregated free list
+				 *
+				 * Such a block remains marked as used within the AVL
+				 * tree.
+				 */
+				inline bool   cached()      const { return _cached; }
+				inline Block *next_cached() const { return _next_cached; }
+
+				inline void cached(bool cached, Block *next = 0) {
+					_cached = cached, _next_cached = next; }
+
 
 				enum { FREE = false, USED = true };
 
@@ -114,14 +129,16 @@ class Genode::Allocator_avl_base : public Range_allocator
 				 * This constructor is called from meta-data allocator during
 				 * initialization of new meta-data blocks.
 				 */
-				Block() : _addr(0), _size(0), _used(0), _max_avail(0) { }
+				Block()
+				: _addr(0), _size(0), _used(0), _cached(0), _max_avail(0),
+				  _next_cached(0) { }
 
 				/**
 				 * Constructor
 				 */
 				Block(addr_t addr, size_t size, bool used)
-				: _addr(addr), _size(size), _used(used),
-				  _max_avail(used ? 0 : size)
+				: _addr(addr), _size(size), _used(used), _cached(false),
+				  _max_avail(used ? 0 : size), _next_cached(0)
 				{
 					static int num_blocks;
 					_id = ++num_blocks;
@@ -161,10 +178,56 @@ class Genode::Allocator_avl_base : public Range_allocator
 
 	private:
 
+		enum {
+			NUM_SIZE_CLASSES = 32,
+			MAX_CACHED       = 16,  /* cached blocks per size class */
+		};
+
 		Avl_tree<Block>  _addr_tree;      /* blocks sorted by base address */
 		Allocator       *_md_alloc;       /* meta-data allocator           */
 		size_t           _md_entry_size;  /* size of block meta-data entry */
 
+		/*
+		 * Segregated free lists of recently freed blocks
+		 */
+		bool      _segregated_fit;
+		unsigned  _size_step_log2;
+		size_t    _cached_bytes;
+		Block    *_cached_blocks[NUM_SIZE_CLASSES];
+		unsigned  _num_cached[NUM_SIZE_CLASSES];
+
+		/**
+		 * Return size class of block size, or 'NUM_SIZE_CLASSES' if blocks
+		 * of this size are not cached
+		 */
+		unsigned _size_class(size_t size) const
+		{
+			size_t const c = size ? (size - 1) >> _size_step_log2 : 0;
+			return c < NUM_SIZE_CLASSES ? c : NUM_SIZE_CLASSES;
+		}
+
+		/**
+		 * Keep freed block in segregated free list
+		 *
+		 * \return false if the block must be merged with its neighbours
+		 */
+		bool _cache_block(Block *b);
+
+		/**
+		 * Take cached block of exactly the requested size
+		 */
+		Block *_take_cached_block(size_t size, int align, addr_t from, addr_t to);
+
+		/**
+		 * Merge all cached blocks with their free neighbours
+		 */
+		void _flush_cached_blocks();
+
+		/**
+		 * Free block that is known to be in use
+		 */
+		void _free_block(Block *b);
+
 		/**
 		 * Alloc meta-data block
 		 */
@@ -217,10 +280,36 @@ class Genode::Allocator_avl_base : public Range_allocator
 		 * we can attach custom information to block meta data.
 		 */
 		Allocator_avl_base(Allocator *md_alloc, size_t md_entry_size) :
-			_md_alloc(md_alloc), _md_entry_size(md_entry_size) { }
+			_md_alloc(md_alloc), _md_entry_size(md_entry_size),
+			_segregated_fit(false), _size_step_log2(0), _cached_bytes(0)
+		{
+			for (unsigned i = 0; i < NUM_SIZE_CLASSES; i++) {
+				_cached_blocks[i] = 0;
+				_num_cached[i]    = 0;
+			}
+		}
 
 	public:
 
+		/**
+		 * Enable segregated free lists for small blocks
+		 *
+		 * \param size_step_log2  size difference between two of the 32
+		 *                        size classes
+		 *
+		 * Freed blocks of up to 32 << 'size_step_log2' bytes are not
+		 * merged with their neighbours right away but kept in a free list
+		 * per size class. A subsequent allocation of the same size is then
+		 * served from the list without walking the AVL tree and without
+		 * allocating block meta data. If the AVL tree cannot satisfy an
+		 * allocation, the cached blocks are merged back before giving up.
+		 */
+		void enable_segregated_fit(unsigned size_step_log2)
+		{
+			_size_step_log2 = size_step_log2;
+			_segregated_fit = true;
+		}
+
 		/**
 		 * Return address of any block of the allocator
 		 *
@@ -334,7 +423,7 @@ class Genode::Allocator_avl_tpl : public Allocator_avl_base
 		BMDT* metadata(void *addr) const
 		{
 			Block *b = static_cast<Block *>(_find_by_address((addr_t)addr));
-			return b && b->used() ? b : 0;
+			return b && b->used() && !b->cached() ? b : 0;
 		}
 
 		int add_range(addr_t base, size_t size)
@@ -56,6 +56,11 @@ class Genode::Allocator_guard : public Allocator
 			return true;
 		}
 
+		/**
+		 * Give back bytes that were consumed via 'withdraw'
+		 */
+		void refund(size_t size) { _consumed -= size; }
+
 		/*************************
 		 ** Allocator interface **
 		 *************************/
@@ -0,0 +1,202 @@
+/*
+ * \brief  Allocator wrapper that records usage statistics
+ * \author Norman Feske
+ * \date   2015-12-02
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__ALLOCATOR_STATISTICS_H_
+#define _INCLUDE__BASE__ALLOCATOR_STATISTICS_H_
+
+#include <base/allocator.h>
+#include <base/lock.h>
+#include <util/list.h>
+#include <util/misc_math.h>
+#include <util/string.h>
+
+namespace Genode { class Allocator_statistics; }
+
+
+/**
+ * Allocator that records the usage of a wrapped allocator
+ *
+ * The wrapper keeps track of the number of live bytes and blocks, the peak
+ * of live bytes, and a histogram of live blocks per power-of-two size class.
+ * Optionally, every 'sample_interval'-th allocation is attributed to the
+ * return address of its caller, which allows for spotting the call sites
+ * that hold most memory. Note that the recorded address is the one of the
+ * immediate caller of 'alloc', which is the 'new' operator for objects
+ * created via 'new (alloc)'.
+ *
+ * To obtain sizes on 'free', the wrapped allocator must be used with
+ * correct size arguments as is the case for 'destroy'.
+ */
+class Genode::Allocator_statistics : public Allocator,
+                                     public List<Allocator_statistics>::Element
+{
+	public:
+
+		enum { NUM_SIZE_CLASSES = 32, NUM_SITES = 32, NAME_LEN = 32 };
+
+		struct Size_class
+		{
+			unsigned long live;  /* number of live blocks */
+			unsigned long peak;  /* maximum of live blocks */
+		};
+
+		struct Site
+		{
+			addr_t        ip;     /* return address of the caller */
+			unsigned long count;  /* sampled allocations */
+			unsigned long bytes;  /* sampled bytes */
+		};
+
+	private:
+
+		Allocator &_alloc;
+		char       _name[NAME_LEN];
+		Lock mutable _lock;
+
+		size_t        _live_bytes  = 0;
+		size_t        _peak_bytes  = 0;
+		unsigned long _num_allocs  = 0;
+		unsigned long _num_frees   = 0;
+		unsigned      _sample_interval;
+
+		Size_class _size_classes[NUM_SIZE_CLASSES];
+		Site       _sites[NUM_SITES];
+
+		static unsigned _size_class(size_t size)
+		{
+			unsigned const c = size > 1 ? log2(size - 1) + 1 : 0;
+			return min(c, (unsigned)NUM_SIZE_CLASSES - 1);
+		}
+
+		void _sample(addr_t ip, size_t size)
+		{
+			/* look up site or replace the one with the fewest samples */
+			Site *victim = &_sites[0];
+			for (unsigned i = 0; i < NUM_SITES; i++) {
+				if (_sites[i].ip == ip) {
+					_sites[i].count++;
+					_sites[i].bytes += size;
+					return;
+				}
+				if (_sites[i].count < victim->count)
+					victim = &_sites[i];
+			}
+			victim->ip    = ip;
+			victim->count = 1;
+			victim->bytes = size;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc            allocator to account
+		 * \param name             name used in reports
+		 * \param sample_interval  record call site of every n-th
+		 *                         allocation, 0 disables sampling
+		 */
+		Allocator_statistics(Allocator &alloc, char const *name,
+		                     unsigned sample_interval = 0)
+		: _alloc(alloc), _sample_interval(sample_interval)
+		{
+			strncpy(_name, name, sizeof(_name));
+			memset(_size_classes, 0, sizeof(_size_classes));
+			memset(_sites, 0, sizeof(_sites));
+		}
+
+		char const *name() const { return _name; }
+
+		/**
+		 * Call 'fn' with a consistent snapshot of the statistics
+		 *
+		 * \param fn  functor taking the arguments
+		 *            'size_t live_bytes, size_t peak_bytes,
+		 *             unsigned long allocs, unsigned long frees,
+		 *             Size_class const *classes, Site const *sites'
+		 */
+		template <typename FN>
+		void with_snapshot(FN const &fn) const
+		{
+			size_t        live_bytes, peak_bytes;
+			unsigned long allocs, frees;
+			Size_class    classes[NUM_SIZE_CLASSES];
+			Site          sites[NUM_SITES];
+
+			{
+				Lock::Guard guard(_lock);
+				live_bytes = _live_bytes;
+				peak_bytes = _peak_bytes;
+				allocs     = _num_allocs;
+				frees      = _num_frees;
+				memcpy(classes, _size_classes, sizeof(classes));
+				memcpy(sites, _sites, sizeof(sites));
+			}
+
+			fn(live_bytes, peak_bytes, allocs, frees, classes, sites);
+		}
+
+		/**
+		 * Return the upper size bound of size class 'i'
+		 */
+		static size_t size_class_limit(unsigned i) { return 1UL << i; }
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool alloc(size_t size, void **out_addr) override
+		{
+			addr_t const ip = (addr_t)__builtin_return_address(0);
+
+			if (!_alloc.alloc(size, out_addr))
+				return false;
+
+			Lock::Guard guard(_lock);
+
+			_live_bytes += size;
+			_peak_bytes  = max(_peak_bytes, _live_bytes);
+
+			Size_class &c = _size_classes[_size_class(size)];
+			c.peak = max(c.peak, ++c.live);
+
+			if (_sample_interval && (_num_allocs % _sample_interval) == 0)
+				_sample(ip, size);
+
+			_num_allocs++;
+			return true;
+		}
+
+		void free(void *addr, size_t size) override
+		{
+			_alloc.free(addr, size);
+
+			Lock::Guard guard(_lock);
+
+			_live_bytes -= min(size, _live_bytes);
+			_num_frees++;
+
+			Size_class &c = _size_classes[_size_class(size)];
+			if (c.live)
+				c.live--;
+		}
+
+		size_t consumed() const override { return _alloc.consumed(); }
+
+		size_t overhead(size_t size) const override { return _alloc.overhead(size); }
+
+		bool need_size_for_free() const override { return _alloc.need_size_for_free(); }
+};
+
+#endif /* _INCLUDE__BASE__ALLOCATOR_STATISTICS_H_ */
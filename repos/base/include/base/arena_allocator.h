@@ -0,0 +1,214 @@
+/*
+ * \brief  Bump-pointer allocator for short-lived objects
+ * \author Norman Feske
+ * \date   2015-12-01
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__ARENA_ALLOCATOR_H_
+#define _INCLUDE__BASE__ARENA_ALLOCATOR_H_
+
+#include <base/allocator.h>
+#include <util/misc_math.h>
+#include <util/noncopyable.h>
+
+namespace Genode { class Arena_allocator; }
+
+
+/**
+ * Allocator that hands out blocks of chunks by advancing a pointer
+ *
+ * Freeing an individual block has no effect. Instead, all blocks are
+ * released at once by calling 'reset' or by leaving a 'Scope'. This makes
+ * the arena suitable for scratch memory that is needed while handling a
+ * single RPC or configuration update, e.g., for temporary strings or lists.
+ *
+ * The chunks are obtained from a backing allocator, which may be an
+ * 'Allocator_guard' to account the arena to a session. One spare chunk is
+ * kept across resets to avoid calls of the backing allocator for
+ * recurring handlers.
+ *
+ * The arena is not synchronized. It is meant to be used by one thread.
+ */
+class Genode::Arena_allocator : public Allocator, Noncopyable
+{
+	private:
+
+		struct Chunk
+		{
+			Chunk *next;  /* older chunk */
+			size_t size;  /* size including this header */
+			size_t used;  /* bytes used including this header */
+		};
+
+		/* align blocks to machine words */
+		enum { ALIGN_LOG2 = sizeof(addr_t) == 8 ? 3 : 2 };
+
+		Allocator    &_backing;
+		size_t const  _chunk_size;
+		Chunk        *_top      = nullptr;  /* current chunk */
+		Chunk        *_spare    = nullptr;
+		size_t        _consumed = 0;
+
+		static size_t _header_size() {
+			return align_addr(sizeof(Chunk), ALIGN_LOG2); }
+
+		Chunk *_new_chunk(size_t size)
+		{
+			Chunk *c = 0;
+
+			if (size == _chunk_size && _spare) {
+				c = _spare;
+				_spare = 0;
+			} else {
+				void *addr = 0;
+				if (!_backing.alloc(size, &addr))
+					return 0;
+				c = (Chunk *)addr;
+				_consumed += size;
+			}
+
+			c->size = size;
+			c->used = _header_size();
+			c->next = _top;
+			_top    = c;
+			return c;
+		}
+
+		void _release_top()
+		{
+			Chunk *c = _top;
+			_top = c->next;
+
+			if (c->size == _chunk_size && !_spare) {
+				_spare = c;
+				return;
+			}
+
+			_consumed -= c->size;
+			_backing.free(c, c->size);
+		}
+
+	public:
+
+		/**
+		 * Position within the arena, used to release all blocks allocated
+		 * after a certain point
+		 */
+		class Mark
+		{
+			private:
+
+				friend class Arena_allocator;
+
+				Chunk *_chunk;
+				size_t _used;
+
+				Mark(Chunk *chunk, size_t used) : _chunk(chunk), _used(used) { }
+		};
+
+		/**
+		 * RAII guard that releases all blocks allocated during its lifetime
+		 *
+		 * Scopes may be nested. Blocks that must outlive a scope must not
+		 * be allocated from the arena while the scope is active.
+		 */
+		class Scope : Noncopyable
+		{
+			private:
+
+				Arena_allocator &_arena;
+				Mark const       _mark;
+
+			public:
+
+				Scope(Arena_allocator &arena) : _arena(arena), _mark(arena.mark()) { }
+
+				~Scope() { _arena.release(_mark); }
+		};
+
+		/**
+		 * Constructor
+		 *
+		 * \param backing     allocator used for obtaining chunks
+		 * \param chunk_size  size of the chunks, larger blocks get a chunk
+		 *                    of their own
+		 */
+		Arena_allocator(Allocator &backing, size_t chunk_size = 16*1024)
+		: _backing(backing), _chunk_size(chunk_size) { }
+
+		~Arena_allocator()
+		{
+			reset();
+
+			if (_spare) {
+				_consumed -= _spare->size;
+				_backing.free(_spare, _spare->size);
+			}
+		}
+
+		/**
+		 * Return current position in the arena
+		 */
+		Mark mark() const { return Mark(_top, _top ? _top->used : 0); }
+
+		/**
+		 * Release all blocks allocated after 'mark' was taken
+		 */
+		void release(Mark const &mark)
+		{
+			while (_top && _top != mark._chunk)
+				_release_top();
+
+			if (_top)
+				_top->used = mark._used;
+		}
+
+		/**
+		 * Release all blocks
+		 */
+		void reset() { release(Mark(0, 0)); }
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool alloc(size_t size, void **out_addr) override
+		{
+			size = align_addr(size, ALIGN_LOG2);
+
+			if (!_top || _top->size - _top->used < size) {
+
+				size_t const needed = _header_size() + size;
+				if (!_new_chunk(max(needed, _chunk_size)))
+					return false;
+			}
+
+			*out_addr = (void *)((addr_t)_top + _top->used);
+			_top->used += size;
+			return true;
+		}
+
+		/**
+		 * Individual blocks are released by 'reset' or 'release' only
+		 */
+		void free(void *, size_t) override { }
+
+		/**
+		 * Return number of bytes obtained from the backing allocator
+		 */
+		size_t consumed() const override { return _consumed; }
+
+		size_t overhead(size_t) const override { return 0; }
+
+		bool need_size_for_free() const override { return false; }
+};
+
+#endif /* _INCLUDE__BASE__ARENA_ALLOCATOR_H_ */
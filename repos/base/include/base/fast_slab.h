@@ -0,0 +1,254 @@
+/*
+ * \brief  Slab allocator with constant-time operations
+ * \author Norman Feske
+ * \date   2015-12-01
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__FAST_SLAB_H_
+#define _INCLUDE__BASE__FAST_SLAB_H_
+
+#include <base/allocator.h>
+#include <base/lock.h>
+#include <base/thread.h>
+#include <util/construct_at.h>
+#include <util/list.h>
+#include <util/misc_math.h>
+#include <util/noncopyable.h>
+
+namespace Genode { class Fast_slab; }
+
+
+/**
+ * Thread-safe slab allocator for objects of one size
+ *
+ * In contrast to 'Slab', each slab block maintains a free list of its
+ * entries, and the allocator keeps the blocks with free entries in a list
+ * of partially used blocks. Hence, neither 'alloc' nor 'free' has to search
+ * for a block. The allocator is internally synchronized and needs no
+ * 'Synced_allocator' wrapper.
+ *
+ * To let threads allocate in parallel, the blocks are distributed among
+ * 'NUM_STRIPES' stripes with a lock each. A thread allocates from the
+ * stripe selected by the address of its thread object. An entry is always
+ * returned to the stripe of its block, regardless of the freeing thread.
+ * Blocks that become completely free are kept for reuse and returned to
+ * the backing store only if a stripe holds more than 'MAX_EMPTY' of them.
+ */
+class Genode::Fast_slab : public Allocator, Noncopyable
+{
+	public:
+
+		enum { NUM_STRIPES = 4, MAX_EMPTY = 1 };
+
+	private:
+
+		struct Stripe;
+		struct Block;
+
+		struct Entry
+		{
+			Block *block;
+
+			/* the first word of the payload links free entries */
+			Entry *&next() { return *(Entry **)(this + 1); }
+
+			void *data() { return this + 1; }
+
+			static Entry *from_data(void *data) { return (Entry *)data - 1; }
+		};
+
+		struct Block : List<Block>::Element
+		{
+			Stripe   *stripe;
+			Block    *prev_partial = nullptr;
+			Block    *next_partial = nullptr;
+			Entry    *free_entries = nullptr;
+			unsigned  used         = 0;
+			unsigned  carved       = 0;  /* entries initialized so far */
+
+			Block(Stripe *stripe) : stripe(stripe) { }
+
+			Entry *entry(Fast_slab const &slab, unsigned i) {
+				return (Entry *)((addr_t)(this + 1) + i*slab._entry_size); }
+		};
+
+		struct Stripe
+		{
+			Lock        lock;
+			List<Block> blocks;         /* all blocks of the stripe */
+			Block      *partial = nullptr;
+			unsigned    num_blocks = 0;
+			unsigned    num_empty  = 0;
+
+			void insert_partial(Block *b)
+			{
+				b->prev_partial = nullptr;
+				b->next_partial = partial;
+				if (partial) partial->prev_partial = b;
+				partial = b;
+			}
+
+			void remove_partial(Block *b)
+			{
+				if (b->prev_partial) b->prev_partial->next_partial = b->next_partial;
+				else                 partial = b->next_partial;
+
+				if (b->next_partial) b->next_partial->prev_partial = b->prev_partial;
+
+				b->prev_partial = b->next_partial = nullptr;
+			}
+		};
+
+		size_t const _object_size;
+		size_t const _entry_size;
+		size_t const _block_size;
+		unsigned const _entries_per_block;
+		Allocator   &_backing_store;
+		Stripe       _stripes[NUM_STRIPES];
+
+		Stripe &_stripe()
+		{
+			addr_t const t = (addr_t)Thread_base::myself();
+			return _stripes[((t >> 6) ^ (t >> 12)) % NUM_STRIPES];
+		}
+
+		/**
+		 * Allocate and register new block, called with stripe locked
+		 */
+		Block *_new_block(Stripe &stripe)
+		{
+			void *addr = 0;
+			if (!_backing_store.alloc(_block_size, &addr))
+				return 0;
+
+			Block *b = construct_at<Block>(addr, &stripe);
+			stripe.blocks.insert(b);
+			stripe.num_blocks++;
+			stripe.num_empty++;
+			stripe.insert_partial(b);
+			return b;
+		}
+
+		void _release_block(Stripe &stripe, Block *b)
+		{
+			stripe.remove_partial(b);
+			stripe.blocks.remove(b);
+			stripe.num_blocks--;
+			stripe.num_empty--;
+			b->~Block();
+			_backing_store.free(b, _block_size);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param object_size    size of the allocated objects
+		 * \param block_size     size of the blocks requested from the
+		 *                       backing store
+		 * \param backing_store  allocator for slab blocks
+		 */
+		Fast_slab(size_t object_size, size_t block_size, Allocator &backing_store)
+		:
+			_object_size(object_size),
+			_entry_size(align_addr(sizeof(Entry) + max(object_size, sizeof(Entry *)),
+			                       log2(sizeof(addr_t)))),
+			_block_size(block_size),
+			_entries_per_block((block_size - sizeof(Block))/_entry_size),
+			_backing_store(backing_store)
+		{ }
+
+		~Fast_slab()
+		{
+			for (unsigned i = 0; i < NUM_STRIPES; i++) {
+				Stripe &stripe = _stripes[i];
+				while (Block *b = stripe.blocks.first()) {
+					stripe.blocks.remove(b);
+					b->~Block();
+					_backing_store.free(b, _block_size);
+				}
+			}
+		}
+
+		size_t object_size() const { return _object_size; }
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool alloc(size_t size, void **out_addr) override
+		{
+			if (size > _object_size || !_entries_per_block)
+				return false;
+
+			Stripe &stripe = _stripe();
+			Lock::Guard guard(stripe.lock);
+
+			Block *b = stripe.partial ? stripe.partial : _new_block(stripe);
+			if (!b)
+				return false;
+
+			Entry *e = b->free_entries;
+			if (e)
+				b->free_entries = e->next();
+			else
+				e = b->entry(*this, b->carved++);
+
+			e->block = b;
+
+			if (b->used++ == 0)
+				stripe.num_empty--;
+
+			if (b->used == _entries_per_block)
+				stripe.remove_partial(b);
+
+			*out_addr = e->data();
+			return true;
+		}
+
+		void free(void *addr, size_t) override
+		{
+			Entry  *e      = Entry::from_data(addr);
+			Block  *b      = e->block;
+			Stripe &stripe = *b->stripe;
+
+			Lock::Guard guard(stripe.lock);
+
+			if (b->used == _entries_per_block)
+				stripe.insert_partial(b);
+
+			e->next() = b->free_entries;
+			b->free_entries = e;
+
+			if (--b->used)
+				return;
+
+			/* return surplus empty blocks to the backing store */
+			if (++stripe.num_empty > MAX_EMPTY)
+				_release_block(stripe, b);
+		}
+
+		size_t consumed() const override
+		{
+			size_t blocks = 0;
+			for (unsigned i = 0; i < NUM_STRIPES; i++)
+				blocks += _stripes[i].num_blocks;
+			return blocks*_block_size;
+		}
+
+		size_t overhead(size_t) const override {
+			return _block_size/_entries_per_block - _object_size; }
+
+		bool need_size_for_free() const override { return false; }
+};
+
+#endif /* _INCLUDE__BASE__FAST_SLAB_H_ */
@@ -51,7 +51,12 @@ class Genode::Heap : public Allocator
 			 * to smaller allocations, this memory is released to
 			 * the RAM session when 'free()' is called.
 			 */
-			BIG_ALLOCATION_THRESHOLD = 64*1024 /* in bytes */
+			BIG_ALLOCATION_THRESHOLD = 64*1024, /* in bytes */
+			/*
+			 * Freed blocks of up to 32 << SIZE_STEP_LOG2 bytes are kept
+			 * in segregated free lists of the AVL allocator.
+			 */
+			SIZE_STEP_LOG2 = 3
 		};
 
 		class Dataspace : public List<Dataspace>::Element
@@ -102,6 +107,19 @@ class Genode::Heap : public Allocator
 		size_t         _quota_limit;
 		size_t         _quota_used;
 		size_t         _chunk_size;
+		size_t         _max_chunk_size;
+		unsigned       _large_page_log2;
+
+		/**
+		 * Round dataspace size up to a multiple of the large-page size
+		 */
+		size_t _backing_store_size(size_t size) const
+		{
+			if (!_large_page_log2 || size < (1UL << _large_page_log2))
+				return size;
+
+			return align_addr(size, _large_page_log2);
+		}
 
 		/**
 		 * Allocate a new dataspace of the specified size
@@ -143,8 +161,16 @@ class Genode::Heap : public Allocator
 			_ds_pool(ram_session, rm_session),
 			_alloc(0),
 			_quota_limit(quota_limit), _quota_used(0),
-			_chunk_size(MIN_CHUNK_SIZE)
+			_chunk_size(MIN_CHUNK_SIZE),
+			_max_chunk_size(MAX_CHUNK_SIZE),
+			_large_page_log2(0)
 		{
+			/*
+			 * Heap allocations are dominated by small objects of few
+			 * distinct sizes, which are often freed and reallocated.
+			 */
+			_alloc.enable_segregated_fit(SIZE_STEP_LOG2);
+
 			if (static_addr)
 				_alloc.add_range((addr_t)static_addr, static_size);
 		}
@@ -157,6 +183,47 @@ class Genode::Heap : public Allocator
 		 */
 		int quota_limit(size_t new_quota_limit);
 
+		/**
+		 * Configure the growth of the heap
+		 *
+		 * \param min_chunk  size of the next dataspace allocated for
+		 *                   small blocks in bytes
+		 * \param max_chunk  limit for the size of those dataspaces
+		 *
+		 * The heap allocates the dataspaces for small blocks with
+		 * exponentially increasing sizes, starting with 'min_chunk' and
+		 * growing until 'max_chunk' is reached. Large chunks result in
+		 * fewer regions attached to the RM session at the cost of a coarser
+		 * granularity of the RAM quota consumption.
+		 */
+		void growth_policy(size_t min_chunk, size_t max_chunk)
+		{
+			Lock::Guard lock_guard(_lock);
+
+			size_t const min_words = align_addr(min_chunk, 12)/sizeof(umword_t);
+			_max_chunk_size = max(align_addr(max_chunk, 12)/sizeof(umword_t), min_words);
+			_chunk_size     = min_words;
+		}
+
+		/**
+		 * Request dataspaces that can be mapped via large pages
+		 *
+		 * \param size_log2  large-page size supported by the kernel, e.g.,
+		 *                   21 for 2 MiB pages on x86 or 20 for 1 MiB
+		 *                   sections on ARM, 0 disables the rounding
+		 *
+		 * Core allocates RAM dataspaces naturally aligned and attaches them
+		 * at naturally aligned virtual addresses, which allows kernels such
+		 * as NOVA and base-hw to use large-page mappings. To benefit from
+		 * that, the heap rounds the size of each dataspace that is at least
+		 * one large page up to a multiple of the large-page size.
+		 */
+		void large_page_size_log2(unsigned size_log2)
+		{
+			Lock::Guard lock_guard(_lock);
+			_large_page_log2 = size_log2;
+		}
+
 		/**
 		 * Re-assign RAM and RM sessions
 		 */
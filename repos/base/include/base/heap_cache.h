@@ -0,0 +1,204 @@
+/*
+ * \brief  Per-thread caching front end of an allocator
+ * \author Norman Feske
+ * \date   2015-11-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__HEAP_CACHE_H_
+#define _INCLUDE__BASE__HEAP_CACHE_H_
+
+#include <base/allocator.h>
+#include <base/lock.h>
+#include <base/thread.h>
+#include <util/noncopyable.h>
+
+namespace Genode { class Heap_cache; }
+
+
+/**
+ * Allocator that caches small blocks of a backing allocator per thread
+ *
+ * Each thread is assigned to one of 'NUM_MAGAZINES' magazines according to
+ * the address of its thread object. A magazine holds a free list for each
+ * size class. Allocations and deallocations are served from the magazine
+ * of the calling thread and reach the backing allocator only if the
+ * magazine runs empty or exceeds 'MAX_CACHED' blocks of a size class. In
+ * the latter case, half of the cached blocks of the class are returned.
+ * Because each magazine has a lock of its own, threads rarely contend with
+ * each other while the lock of the backing allocator is taken only
+ * occasionally.
+ *
+ * The cache is meant to be put in front of a 'Heap' by components with many
+ * threads, e.g.,
+ *
+ * ! static Genode::Heap_cache heap(*Genode::env()->heap());
+ *
+ * Like 'Heap', the cache relies on the size argument of 'free' to match
+ * the size of the original allocation.
+ */
+class Genode::Heap_cache : public Allocator, Noncopyable
+{
+	public:
+
+		enum {
+			NUM_MAGAZINES    = 8,
+			GRANULARITY_LOG2 = 4,  /* size classes are 16 bytes apart */
+			NUM_CLASSES      = 32, /* blocks up to 512 bytes are cached */
+			MAX_CACHED       = 64, /* cached blocks per magazine and class */
+		};
+
+	private:
+
+		struct Block { Block *next; };
+
+		struct Free_list
+		{
+			Block    *head  = nullptr;
+			unsigned  count = 0;
+
+			void push(Block *b) { b->next = head; head = b; count++; }
+
+			Block *pop()
+			{
+				Block *b = head;
+				if (b) { head = b->next; count--; }
+				return b;
+			}
+		};
+
+		struct Magazine
+		{
+			Lock      lock;
+			Free_list lists[NUM_CLASSES];
+		};
+
+		Allocator &_backing;
+		Magazine   _magazines[NUM_MAGAZINES];
+
+		static size_t _class_size(unsigned c) {
+			return (c + 1) << GRANULARITY_LOG2; }
+
+		/**
+		 * Return size class for block size, or NUM_CLASSES if not cached
+		 */
+		static unsigned _size_class(size_t size)
+		{
+			if (size == 0)
+				return 0;
+
+			size_t const c = (size - 1) >> GRANULARITY_LOG2;
+			return c < NUM_CLASSES ? c : NUM_CLASSES;
+		}
+
+		Magazine &_magazine()
+		{
+			/* the main thread may have no thread object, use magazine 0 */
+			addr_t const t = (addr_t)Thread_base::myself();
+
+			return _magazines[((t >> 6) ^ (t >> 12)) % NUM_MAGAZINES];
+		}
+
+		/**
+		 * Return 'count' blocks of a free list to the backing allocator
+		 */
+		void _release(Free_list &list, unsigned c, unsigned count)
+		{
+			for (; count; count--)
+				_backing.free(list.pop(), _class_size(c));
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param backing  thread-safe allocator used as backing store
+		 */
+		Heap_cache(Allocator &backing) : _backing(backing) { }
+
+		~Heap_cache() { flush(); }
+
+		/**
+		 * Return all cached blocks to the backing allocator
+		 */
+		void flush()
+		{
+			for (unsigned m = 0; m < NUM_MAGAZINES; m++) {
+				Lock::Guard guard(_magazines[m].lock);
+
+				for (unsigned c = 0; c < NUM_CLASSES; c++) {
+					Free_list &list = _magazines[m].lists[c];
+					_release(list, c, list.count);
+				}
+			}
+		}
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool alloc(size_t size, void **out_addr) override
+		{
+			unsigned const c = _size_class(size);
+			if (c == NUM_CLASSES)
+				return _backing.alloc(size, out_addr);
+
+			{
+				Magazine &m = _magazine();
+				Lock::Guard guard(m.lock);
+
+				if (Block *b = m.lists[c].pop()) {
+					*out_addr = b;
+					return true;
+				}
+			}
+
+			return _backing.alloc(_class_size(c), out_addr);
+		}
+
+		void free(void *addr, size_t size) override
+		{
+			unsigned const c = _size_class(size);
+			if (c == NUM_CLASSES) {
+				_backing.free(addr, size);
+				return;
+			}
+
+			Magazine &m = _magazine();
+			Lock::Guard guard(m.lock);
+
+			Free_list &list = m.lists[c];
+			list.push((Block *)addr);
+
+			/* keep the cache bounded */
+			if (list.count > MAX_CACHED)
+				_release(list, c, MAX_CACHED/2);
+		}
+
+		/**
+		 * Return bytes consumed at the backing allocator
+		 *
+		 * This value includes the blocks held in the cache.
+		 */
+		size_t consumed() const override { return _backing.consumed(); }
+
+		size_t overhead(size_t size) const override
+		{
+			unsigned const c = _size_class(size);
+			return c == NUM_CLASSES ? _backing.overhead(size)
+			                        : _backing.overhead(_class_size(c))
+			                          + _class_size(c) - size;
+		}
+
+		bool need_size_for_free() const override { return true; }
+};
+
+#endif /* _INCLUDE__BASE__HEAP_CACHE_H_ */
@@ -16,7 +16,6 @@
 #ifndef _INCLUDE__BASE__OBJECT_POOL_H_
 #define _INCLUDE__BASE__OBJECT_POOL_H_
 
-#include <util/avl_tree.h>
 #include <util/noncopyable.h>
 #include <base/capability.h>
 #include <base/weak_ptr.h>
@@ -31,18 +30,21 @@ namespace Genode { template <typename> class Object_pool; }
  *
  * The local names of a capabilities are used to differentiate multiple server
  * objects managed by one and the same object pool.
+ *
+ * The entries are kept in a hash table indexed by the local name. So the
+ * lookup of each incoming request takes constant time, and the pool lock
+ * is held only briefly, regardless of the number of objects.
  */
 template <typename OBJ_TYPE>
 class Genode::Object_pool
 {
 	public:
 
-		class Entry : public Avl_node<Entry>
+		class Entry
 		{
 			private:
 
 				friend class Object_pool;
-				friend class Avl_tree<Entry>;
 
 				struct Entry_lock : Weak_object<Entry_lock>, Noncopyable
 				{
@@ -55,6 +57,7 @@ class Genode::Object_pool
 
 				Untyped_capability _cap;
 				Entry_lock         _lock { *this };
+				Entry             *_next = nullptr;  /* next in hash bucket */
 
 				inline unsigned long _obj_id() { return _cap.local_name(); }
 
@@ -65,24 +68,6 @@ class Genode::Object_pool
 
 				virtual ~Entry() { }
 
-				/**
-				 * Avl_node interface
-				 */
-				bool higher(Entry *e) { return e->_obj_id() > _obj_id(); }
-				void recompute() { }  /* for gcc-3.4 compatibility */
-
-				/**
-				 * Support for object pool
-				 */
-				Entry *find_by_obj_id(unsigned long obj_id)
-				{
-					if (obj_id == _obj_id()) return this;
-
-					Entry *obj = this->child(obj_id > _obj_id());
-
-					return obj ? obj->find_by_obj_id(obj_id) : 0;
-				}
-
 				/**
 				 * Assign capability to object pool entry
 				 */
@@ -93,29 +78,88 @@ class Genode::Object_pool
 
 	private:
 
-		Avl_tree<Entry> _tree;
-		Lock            _lock;
+		enum { NUM_BUCKETS = 64 };
+
+		Entry *_buckets[NUM_BUCKETS];
+		Lock   _lock;
+
+		static unsigned _bucket(unsigned long obj_id) {
+			return (obj_id ^ (obj_id >> 6) ^ (obj_id >> 12)) % NUM_BUCKETS; }
+
+		/**
+		 * Look up entry, called with the pool lock held
+		 */
+		Entry *_find(unsigned long obj_id)
+		{
+			Entry *e = _buckets[_bucket(obj_id)];
+			for (; e && e->_obj_id() != obj_id; e = e->_next);
+			return e;
+		}
+
+		/**
+		 * Return any entry of the pool, called with the pool lock held
+		 */
+		Entry *_first()
+		{
+			for (unsigned i = 0; i < NUM_BUCKETS; i++)
+				if (_buckets[i])
+					return _buckets[i];
+			return nullptr;
+		}
+
+		void _remove(Entry *obj)
+		{
+			Entry **e = &_buckets[_bucket(obj->_obj_id())];
+			for (; *e && *e != obj; e = &(*e)->_next);
+			if (*e)
+				*e = obj->_next;
+			obj->_next = nullptr;
+		}
 
 	protected:
 
 		bool empty()
 		{
 			Lock::Guard lock_guard(_lock);
-			return _tree.first() == nullptr;
+			return _first() == nullptr;
 		}
 
 	public:
 
+		Object_pool()
+		{
+			for (unsigned i = 0; i < NUM_BUCKETS; i++)
+				_buckets[i] = nullptr;
+		}
+
 		void insert(OBJ_TYPE *obj)
 		{
 			Lock::Guard lock_guard(_lock);
-			_tree.insert(obj);
+
+			Entry *e = obj;
+			Entry *&bucket = _buckets[_bucket(e->_obj_id())];
+			e->_next = bucket;
+			bucket   = e;
 		}
 
 		void remove(OBJ_TYPE *obj)
 		{
 			Lock::Guard lock_guard(_lock);
-			_tree.remove(obj);
+			_remove(obj);
+		}
+
+		/**
+		 * Return true if 'obj' is a member of the pool
+		 *
+		 * In contrast to 'apply', the object is not locked. Hence, the
+		 * method can be called while the object is in use.
+		 */
+		bool contains(OBJ_TYPE *obj)
+		{
+			Lock::Guard lock_guard(_lock);
+
+			Entry *e = obj;
+			return _find(e->_obj_id()) == e;
 		}
 
 		template <typename FUNC>
@@ -132,8 +176,7 @@ class Genode::Object_pool
 			{
 				Lock::Guard lock_guard(_lock);
 
-				Entry * entry = _tree.first() ?
-					_tree.first()->find_by_obj_id(capid) : nullptr;
+				Entry * entry = _find(capid);
 
 				if (entry) ptr = entry->_lock.weak_ptr();
 			}
@@ -165,14 +208,14 @@ class Genode::Object_pool
 				{
 					Lock::Guard lock_guard(_lock);
 
-					if (!((obj = (OBJ_TYPE*) _tree.first()))) return;
+					if (!((obj = (OBJ_TYPE*) _first()))) return;
 
 					Weak_ptr ptr = obj->_lock.weak_ptr();
 					{
 						Locked_ptr lock_ptr(ptr);
 						if (!lock_ptr.is_valid()) return;
 
-						_tree.remove(obj);
+						_remove(obj);
 					}
 				}
 
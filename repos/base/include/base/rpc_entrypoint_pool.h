@@ -0,0 +1,156 @@
+/*
+ * \brief  Pool of entrypoints that serve the RPC objects of one server
+ * \author Norman Feske
+ * \date   2015-12-09
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_
+#define _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_
+
+#include <base/rpc_server.h>
+#include <base/allocator.h>
+#include <base/snprintf.h>
+#include <base/lock.h>
+#include <util/noncopyable.h>
+
+namespace Genode { template <unsigned> class Rpc_entrypoint_pool; }
+
+
+/**
+ * Set of entrypoints that share the RPC objects of a server
+ *
+ * \param MAX_EPS  maximum number of entrypoints
+ *
+ * On all supported kernels, the capability of an RPC object refers to
+ * exactly one thread. Hence, the pool does not let several threads wait
+ * for the same objects but distributes the objects among its entrypoints.
+ * Requests to different objects are processed concurrently whereas the
+ * requests to one object are always serialized. Objects that share state
+ * can be managed with the same 'key' to serialize them among each other,
+ * which spares the server the synchronization of this state.
+ *
+ * If a CPU affinity space is specified, the entrypoints are spread over
+ * the CPUs of the space. Otherwise, they inherit the affinity of the
+ * component.
+ */
+template <unsigned MAX_EPS>
+class Genode::Rpc_entrypoint_pool : Noncopyable
+{
+	private:
+
+		enum { NAME_LEN = 32 };
+
+		Allocator      &_alloc;
+		unsigned const  _count;
+		Rpc_entrypoint *_eps[MAX_EPS];
+		unsigned        _next = 0;
+		Lock            _lock;
+
+		Rpc_entrypoint &_ep_of(Rpc_object_base *obj)
+		{
+			for (unsigned i = 0; i + 1 < _count; i++)
+				if (_eps[i]->contains(obj))
+					return *_eps[i];
+
+			return *_eps[_count - 1];
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param cap_session  'Cap_session' for creating capabilities
+		 * \param alloc        allocator for the entrypoint objects
+		 * \param count        number of entrypoints, constrained to
+		 *                     'MAX_EPS'
+		 * \param stack_size   stack size of each entrypoint thread
+		 * \param name         name prefix of the entrypoint threads
+		 * \param space        CPUs to distribute the entrypoints over,
+		 *                     an empty space leaves the affinity unset
+		 */
+		Rpc_entrypoint_pool(Cap_session *cap_session, Allocator &alloc,
+		                    unsigned count, size_t stack_size,
+		                    char const *name,
+		                    Affinity::Space space = Affinity::Space())
+		:
+			_alloc(alloc), _count(max(1U, min(count, MAX_EPS)))
+		{
+			for (unsigned i = 0; i < _count; i++) {
+
+				char ep_name[NAME_LEN];
+				snprintf(ep_name, sizeof(ep_name), "%s.%u", name, i);
+
+				Affinity::Location const location = space.total()
+					? space.location_of_index(i) : Affinity::Location();
+
+				_eps[i] = new (&_alloc)
+					Rpc_entrypoint(cap_session, stack_size, ep_name, true,
+					               location);
+			}
+		}
+
+		/**
+		 * Destructor
+		 *
+		 * All objects must have been dissolved beforehand.
+		 */
+		~Rpc_entrypoint_pool()
+		{
+			for (unsigned i = 0; i < _count; i++)
+				destroy(&_alloc, _eps[i]);
+		}
+
+		unsigned count() const { return _count; }
+
+		/**
+		 * Return entrypoint that serves the objects of 'key'
+		 */
+		Rpc_entrypoint &entrypoint(unsigned key) { return *_eps[key % _count]; }
+
+		/**
+		 * Associate RPC object with the next entrypoint in turn
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		Capability<RPC_INTERFACE>
+		manage(Rpc_object<RPC_INTERFACE, RPC_SERVER> *obj)
+		{
+			unsigned key;
+			{
+				Lock::Guard guard(_lock);
+				key = _next++;
+			}
+			return entrypoint(key).manage(obj);
+		}
+
+		/**
+		 * Associate RPC object with the entrypoint of 'key'
+		 *
+		 * All objects managed with the same key are served by the same
+		 * thread and are thereby serialized among each other.
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		Capability<RPC_INTERFACE>
+		manage(Rpc_object<RPC_INTERFACE, RPC_SERVER> *obj, unsigned key)
+		{
+			return entrypoint(key).manage(obj);
+		}
+
+		/**
+		 * Dissolve RPC object from the entrypoint that serves it
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		void dissolve(Rpc_object<RPC_INTERFACE, RPC_SERVER> *obj)
+		{
+			_ep_of(obj).dissolve(obj);
+		}
+};
+
+#endif /* _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_ */
@@ -0,0 +1,99 @@
+/*
+ * \brief  Reader-writer lock
+ * \author Norman Feske
+ * \date   2015-12-10
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__RW_LOCK_H_
+#define _INCLUDE__BASE__RW_LOCK_H_
+
+#include <base/lock.h>
+#include <util/noncopyable.h>
+
+namespace Genode { class Rw_lock; }
+
+
+/**
+ * Lock that admits either one writer or any number of readers
+ *
+ * The lock is meant for read-mostly data structures such as registries
+ * that are looked up often but modified seldom. A writer that waits for
+ * the lock stops the admission of further readers. Hence, writers don't
+ * starve in the presence of a steady stream of readers.
+ *
+ * The lock is not recursive. A reader must not acquire the lock for
+ * writing.
+ */
+class Genode::Rw_lock : Noncopyable
+{
+	private:
+
+		Lock     _turnstile;  /* held by a waiting writer */
+		Lock     _readers_lock;
+		Lock     _write_lock; /* held by a writer or the readers as a group */
+		unsigned _readers = 0;
+
+	public:
+
+		void lock_read()
+		{
+			/* wait for a pending writer */
+			_turnstile.lock();
+			_turnstile.unlock();
+
+			Lock::Guard guard(_readers_lock);
+			if (_readers++ == 0)
+				_write_lock.lock();
+		}
+
+		void unlock_read()
+		{
+			/*
+			 * The last reader may differ from the first one, which is fine
+			 * because 'Lock' can be released by any thread.
+			 */
+			Lock::Guard guard(_readers_lock);
+			if (--_readers == 0)
+				_write_lock.unlock();
+		}
+
+		void lock_write()
+		{
+			_turnstile.lock();
+			_write_lock.lock();
+			_turnstile.unlock();
+		}
+
+		void unlock_write() { _write_lock.unlock(); }
+
+		/**
+		 * Lock guard for shared access
+		 */
+		struct Read_guard : Noncopyable
+		{
+			Rw_lock &lock;
+
+			Read_guard(Rw_lock &lock) : lock(lock) { lock.lock_read(); }
+			~Read_guard() { lock.unlock_read(); }
+		};
+
+		/**
+		 * Lock guard for exclusive access
+		 */
+		struct Write_guard : Noncopyable
+		{
+			Rw_lock &lock;
+
+			Write_guard(Rw_lock &lock) : lock(lock) { lock.lock_write(); }
+			~Write_guard() { lock.unlock_write(); }
+		};
+};
+
+#endif /* _INCLUDE__BASE__RW_LOCK_H_ */
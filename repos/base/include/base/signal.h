@@ -95,6 +95,7 @@ class Genode::Signal
 		friend class Kernel::Signal_receiver;
 		friend class Signal_receiver;
 		friend class Signal_context;
+		friend class Signal_context_registry;
 
 		void _dec_ref_and_unlock();
 		void _inc_ref();
@@ -384,6 +385,14 @@ class Genode::Signal_context
 struct Genode::Signal_dispatcher_base : Signal_context
 {
 	virtual void dispatch(unsigned num) = 0;
+
+	/**
+	 * Return dispatch priority
+	 *
+	 * If several signals are pending at once, a server entrypoint
+	 * dispatches the ones of higher priority first.
+	 */
+	virtual unsigned priority() const { return 0; }
 };
 
 
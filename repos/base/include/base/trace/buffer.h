@@ -142,6 +142,41 @@ class Genode::Trace::Buffer
 
 			return Entry((_Entry const *)((addr_t)entry.data() + entry.length()));
 		}
+
+		/*
+		 * The following functions allow for consuming the buffer
+		 * incrementally. The position of the writer is given by the
+		 * number of wraps and the head offset. Entries behind the head
+		 * offset stem from the previous round and remain intact until the
+		 * writer reaches them again.
+		 */
+
+		unsigned head_offset() const { return _head_offset; }
+
+		/**
+		 * Return entry located at 'offset'
+		 *
+		 * If no complete entry is located at 'offset', the returned entry
+		 * is the last one.
+		 */
+		Entry entry(unsigned offset) const
+		{
+			if (offset + sizeof(_Entry) > _size)
+				return Entry(0);
+
+			_Entry const *e = (_Entry const *)((addr_t)_entries + offset);
+
+			if (e->len == 0 || offset + sizeof(_Entry) + e->len > _size)
+				return Entry(0);
+
+			return Entry(e);
+		}
+
+		/**
+		 * Return offset of the entry that follows 'entry'
+		 */
+		unsigned offset_after(Entry entry) const {
+			return (addr_t)entry.data() + entry.length() - (addr_t)_entries; }
 };
 
 #endif /* _INCLUDE__BASE__TRACE__BUFFER_H_ */
@@ -10,6 +10,7 @@
 /* Genode includes */
 #include <util/string.h>
 #include <base/affinity.h>
+#include <base/exception.h>
 
 namespace Genode { namespace Trace {
 
@@ -32,6 +33,7 @@ namespace Genode { namespace Trace {
 	struct Policy_id;
 	struct Subject_id;
 	struct Execution_time;
+	struct Perf_counters;
 	struct Subject_info;
 } }
 
@@ -78,6 +80,26 @@ struct Genode::Trace::Execution_time
 };
 
 
+/**
+ * Hardware events caused by the execution of a trace subject
+ *
+ * The counters are maintained only by kernels that virtualize the
+ * performance-monitoring unit per thread. Otherwise, they remain zero.
+ */
+struct Genode::Trace::Perf_counters
+{
+	enum Event { INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, NUM_EVENTS };
+
+	unsigned long long value[NUM_EVENTS];
+
+	Perf_counters() { for (unsigned i = 0; i < NUM_EVENTS; i++) value[i] = 0; }
+
+	unsigned long long instructions()  const { return value[INSTRUCTIONS];  }
+	unsigned long long cache_misses()  const { return value[CACHE_MISSES];  }
+	unsigned long long branch_misses() const { return value[BRANCH_MISSES]; }
+};
+
+
 /**
  * Subject information
  */
@@ -108,6 +130,7 @@ class Genode::Trace::Subject_info
 		Policy_id          _policy_id;
 		Execution_time     _execution_time;
 		Affinity::Location _affinity;
+		Perf_counters      _perf_counters;
 
 	public:
 
@@ -117,11 +140,13 @@ class Genode::Trace::Subject_info
 		             Thread_name   const &thread_name,
 		             State state, Policy_id policy_id,
 		             Execution_time execution_time,
-		             Affinity::Location affinity)
+		             Affinity::Location affinity,
+		             Perf_counters perf_counters = Perf_counters())
 		:
 			_session_label(session_label), _thread_name(thread_name),
 			_state(state), _policy_id(policy_id),
-			_execution_time(execution_time), _affinity(affinity)
+			_execution_time(execution_time), _affinity(affinity),
+			_perf_counters(perf_counters)
 		{ }
 
 		Session_label const &session_label()  const { return _session_label; }
@@ -130,6 +155,7 @@ class Genode::Trace::Subject_info
 		Policy_id            policy_id()      const { return _policy_id; }
 		Execution_time       execution_time() const { return _execution_time; }
 		Affinity::Location   affinity()       const { return _affinity; }
+		Perf_counters        perf_counters()  const { return _perf_counters; }
 };
 
 #endif /* _INCLUDE__BASE__TRACE__TYPES_H_ */
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -22,6 +22,32 @@ namespace Genode {
 	 * Make D-Cache and I-Cache coherent
 	 */
 	void cache_coherent(Genode::addr_t addr, Genode::size_t size);
+
+	/*
+	 * The following operations are meant for drivers that use cached memory
+	 * for the DMA of non-coherent devices. On platforms that cannot maintain
+	 * the data cache selectively for the caller, the operations are applied
+	 * to the whole data cache. In this case, an invalidation writes back
+	 * dirty cache lines before, so callers must not rely on discarding
+	 * dirty data.
+	 */
+
+	/*
+	 * Write back dirty D-Cache lines of region, e.g., before a device reads
+	 * the region
+	 */
+	void cache_clean(Genode::addr_t addr, Genode::size_t size);
+
+	/*
+	 * Invalidate D-Cache lines of region, e.g., after a device wrote to the
+	 * region
+	 */
+	void cache_invalidate(Genode::addr_t addr, Genode::size_t size);
+
+	/*
+	 * Write back and invalidate D-Cache lines of region
+	 */
+	void cache_clean_invalidate(Genode::addr_t addr, Genode::size_t size);
 }
 
 #endif /* _INCLUDE__CPU__CACHE_H_ */
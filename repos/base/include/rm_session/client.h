@@ -38,6 +38,9 @@ struct Genode::Rm_session_client : Rpc_client<Rm_session>
 	void detach(Local_addr local_addr) override {
 		call<Rpc_detach>(local_addr); }
 
+	void prefault(Local_addr local_addr) override {
+		call<Rpc_prefault>(local_addr); }
+
 	Pager_capability add_client(Thread_capability thread) override {
 		return call<Rpc_add_client>(thread); }
 
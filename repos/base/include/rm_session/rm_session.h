@@ -152,6 +152,19 @@ struct Genode::Rm_session : Session
 	 */
 	virtual void detach(Local_addr local_addr) = 0;
 
+	/**
+	 * Populate region eagerly
+	 *
+	 * \param local_addr  address of an attached region
+	 *
+	 * The region's dataspace is mapped into the address spaces of all
+	 * clients using the largest page sizes possible, which spares the
+	 * clients the page faults on the first access. Since the mappings may
+	 * be revoked at any time, this is merely a hint. Kernels, on which core
+	 * can establish mappings as response of page faults only, ignore it.
+	 */
+	virtual void prefault(Local_addr local_addr) { }
+
 	/**
 	 * Add client to pager
 	 *
@@ -204,6 +217,7 @@ struct Genode::Rm_session : Session
 	                                  Out_of_metadata, Invalid_args),
 	                 Dataspace_capability, size_t, off_t, bool, Local_addr, bool);
 	GENODE_RPC(Rpc_detach, void, detach, Local_addr);
+	GENODE_RPC(Rpc_prefault, void, prefault, Local_addr);
 	GENODE_RPC_THROW(Rpc_add_client, Pager_capability, add_client,
 	                 GENODE_TYPE_LIST(Unbound_thread, Invalid_thread, Out_of_metadata),
 	                 Thread_capability);
@@ -212,9 +226,9 @@ struct Genode::Rm_session : Session
 	GENODE_RPC(Rpc_state, State, state);
 	GENODE_RPC(Rpc_dataspace, Dataspace_capability, dataspace);
 
-	GENODE_RPC_INTERFACE(Rpc_attach, Rpc_detach, Rpc_add_client,
-	                     Rpc_remove_client, Rpc_fault_handler, Rpc_state,
-	                     Rpc_dataspace);
+	GENODE_RPC_INTERFACE(Rpc_attach, Rpc_detach, Rpc_prefault,
+	                     Rpc_add_client, Rpc_remove_client, Rpc_fault_handler,
+	                     Rpc_state, Rpc_dataspace);
 };
 
 #endif /* _INCLUDE__RM_SESSION__RM_SESSION_H_ */
@@ -64,6 +64,39 @@ namespace Genode {
 			              :: "r3");
 		return size;
 	}
+
+
+	/**
+	 * Fill memory block with zeros
+	 *
+	 * \param dst   destination memory block
+	 * \param size  number of bytes to clear
+	 *
+	 * \return      Number of bytes not cleared at the end of the block
+	 */
+	inline size_t memclear_cpu(void *dst, size_t size)
+	{
+		unsigned char *d = (unsigned char *)dst;
+
+		/* clear to 4 byte alignment */
+		for (; (size > 0) && ((size_t)d & 0x3); *d++ = 0, size--);
+
+		/* clear 32 byte chunks */
+		for (; size >= 32; size -= 32) {
+			asm volatile ("mov r3,  #0      \n\t"
+			              "mov r4,  #0      \n\t"
+			              "mov r5,  #0      \n\t"
+			              "mov r6,  #0      \n\t"
+			              "mov r7,  #0      \n\t"
+			              "mov r8,  #0      \n\t"
+			              "mov r9,  #0      \n\t"
+			              "mov r10, #0      \n\t"
+			              "stmia %0!, {r3 - r10} \n\t"
+			              : "+r" (d)
+			              :: "r3","r4","r5","r6","r7","r8","r9","r10", "memory");
+		}
+		return size;
+	}
 }
 
 #endif /* _INCLUDE__SPEC__ARM__VFP__CPU__STRING_H_ */
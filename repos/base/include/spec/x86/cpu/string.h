@@ -1,5 +1,5 @@
 /*
- * \brief  CPU-specific memcpy
+ * \brief  CPU-specific memcpy and memory clearing
  * \author Sebastian Sumpf
  * \date   2012-08-02
  */
@@ -26,6 +26,40 @@ namespace Genode {
 	 * \return      number of bytes not copied
 	 */
 	inline size_t memcpy_cpu(void *, const void *, size_t size) { return size; }
+
+
+	/**
+	 * Fill memory block with zeros
+	 *
+	 * \param dst   destination memory block
+	 * \param size  number of bytes to clear
+	 *
+	 * \return      number of bytes not cleared at the end of the block
+	 *
+	 * Large blocks are cleared with non-temporal stores, which bypass the
+	 * caches. This way, clearing a block that is not accessed right
+	 * afterwards, e.g., the backing store of a fresh RAM dataspace, does
+	 * not evict the working set of the caller. Small blocks are left to
+	 * the generic code because they are likely to be touched soon.
+	 */
+	inline size_t memclear_cpu(void *dst, size_t size)
+	{
+#ifdef __SSE2__
+		enum { MIN_SIZE = 64*1024, CHUNK = 64 };
+
+		if (size < MIN_SIZE || ((unsigned long)dst & (sizeof(long) - 1)))
+			return size;
+
+		unsigned long *d = (unsigned long *)dst;
+		for (; size >= CHUNK; size -= CHUNK)
+			for (unsigned i = 0; i < CHUNK/sizeof(long); i++, d++)
+				asm volatile ("movnti %1, %0" : "=m" (*d) : "r" (0UL));
+
+		/* order the weakly-ordered stores before subsequent stores */
+		asm volatile ("sfence" : : : "memory");
+#endif
+		return size;
+	}
 }
 
 #endif /* _INCLUDE__SPEC__X86__CPU__STRING_H_ */
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -59,27 +59,16 @@ class Genode::Bit_allocator
 		addr_t alloc(size_t const num_log2 = 0)
 		{
 			addr_t const step = 1UL << num_log2;
-			addr_t max = ~0UL;
+			addr_t index = 0;
 
-			do {
-				try {
-					/* throws exception if array is accessed outside bounds */
-					for (addr_t i = _next & ~(step - 1); i < max; i += step) {
-						if (_array.get(i, step))
-							continue;
+			/* search from the last allocation on, wrap around once */
+			if (!_array.find_clear(_next, step, index)
+			 && !_array.find_clear(0, step, index))
+				throw Out_of_indices();
 
-						_array.set(i, step);
-						_next = i + step;
-						return i;
-					}
-				} catch (typename Array::Invalid_index_access) { }
-
-				max = _next;
-				_next = 0;
-
-			} while (max != 0);
-
-			throw Out_of_indices();
+			_array.set(index, step);
+			_next = index + step;
+			return index;
 		}
 
 		void free(addr_t const bit_start, size_t const num_log2 = 0)
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -26,6 +26,15 @@ namespace Genode {
 }
 
 
+/**
+ * Bit array, searchable for clear ranges a machine word at a time
+ *
+ * Besides the bits, the array maintains a summary bitmap with one bit per
+ * word of the array, which is set if the word is completely set. The search
+ * for clear bits skips over the words marked as full, and over whole
+ * summary words at once. So the search cost stays low even if the array is
+ * densely populated.
+ */
 class Genode::Bit_array_base
 {
 	public:
@@ -35,20 +44,66 @@ class Genode::Bit_array_base
 		class Invalid_clear        : public Exception {};
 		class Invalid_set          : public Exception {};
 
-	private:
+	protected:
 
 		enum {
 			BITS_PER_BYTE = 8UL,
 			BITS_PER_WORD = sizeof(addr_t) * BITS_PER_BYTE
 		};
 
+		/**
+		 * Return number of summary words needed for 'words' words
+		 */
+		static constexpr size_t _summary_word_cnt(size_t words) {
+			return (words + BITS_PER_WORD - 1) / BITS_PER_WORD; }
+
+	private:
+
 		unsigned _bit_cnt;
 		unsigned _word_cnt;
 		addr_t  *_words;
+		addr_t  *_summary;   /* bit per word, set if the word is full */
 
 		addr_t _word(addr_t index) const {
 			return index / BITS_PER_WORD; }
 
+		static addr_t _bit(addr_t i) { return 1UL << (i % BITS_PER_WORD); }
+
+		bool _full(addr_t word) const {
+			return _summary[word / BITS_PER_WORD] & _bit(word); }
+
+		void _update_summary(addr_t word)
+		{
+			if (_words[word] == ~0UL) _summary[word / BITS_PER_WORD] |=  _bit(word);
+			else                      _summary[word / BITS_PER_WORD] &= ~_bit(word);
+		}
+
+		/**
+		 * Return mask of the bit positions that are multiples of 'step'
+		 */
+		static addr_t _aligned_positions(addr_t step)
+		{
+			addr_t mask = 1;
+			for (addr_t s = step; s < BITS_PER_WORD; s <<= 1)
+				mask |= mask << s;
+			return mask;
+		}
+
+		/**
+		 * Return mask of the bit positions that start a run of 'cnt' set
+		 * bits within 'bits'
+		 */
+		static addr_t _run_starts(addr_t bits, addr_t cnt)
+		{
+			/* double the tested run length with each step */
+			for (addr_t len = 1; bits && len < cnt; ) {
+				addr_t const step = (len < cnt - len) ? len : cnt - len;
+				bits &= bits >> step;
+				len  += step;
+			}
+			return bits;
+		}
+
 		void _check_range(addr_t const index,
 		                  addr_t const width) const
 		{
@@ -89,6 +144,8 @@ class Genode::Bit_array_base
 					_words[word] |= mask;
 				}
 
+				_update_summary(word);
+
 				index = (_word(index) + 1) * BITS_PER_WORD;
 				width = rest;
 			} while (rest);
@@ -96,14 +153,28 @@ class Genode::Bit_array_base
 
 	public:
 
-		Bit_array_base(unsigned bits, addr_t *addr, bool clear)
+		/**
+		 * Constructor
+		 *
+		 * \param bits     number of bits, must be a multiple of the word size
+		 * \param addr     backing store of the bits
+		 * \param summary  backing store of the summary bitmap, must hold
+		 *                 '_summary_word_cnt(bits/BITS_PER_WORD)' words
+		 * \param clear    clear the bits, otherwise keep the bits at 'addr'
+		 */
+		Bit_array_base(unsigned bits, addr_t *addr, addr_t *summary, bool clear)
 		: _bit_cnt(bits),
 		  _word_cnt(_bit_cnt / BITS_PER_WORD),
-		  _words(addr)
+		  _words(addr),
+		  _summary(summary)
 		{
 			if (!bits || bits % BITS_PER_WORD) throw Invalid_bit_count();
 
 			if (clear) memset(_words, 0, sizeof(addr_t)*_word_cnt);
+
+			memset(_summary, 0, sizeof(addr_t)*_summary_word_cnt(_word_cnt));
+			for (addr_t w = 0; w < _word_cnt; w++)
+				_update_summary(w);
 		}
 
 		/**
@@ -131,6 +202,60 @@ class Genode::Bit_array_base
 
 		void clear(addr_t const index, addr_t const width) {
 			_set(index, width, true); }
+
+		/**
+		 * Find first range of 'step' clear bits at or after 'index'
+		 *
+		 * \param step  power of two, the range is aligned to 'step'
+		 *
+		 * \return  true if a clear range exists, its first bit is returned
+		 *          in 'out_index'
+		 */
+		bool find_clear(addr_t index, addr_t step, addr_t &out_index) const
+		{
+			index &= ~(step - 1);
+
+			/* ranges of whole words */
+			if (step >= BITS_PER_WORD) {
+				addr_t const words = step / BITS_PER_WORD;
+
+				for (addr_t w = _word(index); w + words <= _word_cnt; w += words) {
+					addr_t i = 0;
+					for (; i < words && !_words[w + i]; i++);
+
+					if (i == words) {
+						out_index = w * BITS_PER_WORD;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			/* ranges within a word, 'step' divides the word size */
+			addr_t const aligned = _aligned_positions(step);
+
+			for (addr_t w = _word(index); w < _word_cnt; w++) {
+
+				/* skip full words, whole summary words at once */
+				if (w % BITS_PER_WORD == 0 && _summary[w / BITS_PER_WORD] == ~0UL) {
+					w += BITS_PER_WORD - 1;
+					continue;
+				}
+				if (_full(w))
+					continue;
+
+				addr_t clear = ~_words[w];
+				if (w == _word(index))
+					clear &= ~0UL << (index % BITS_PER_WORD);
+
+				addr_t const starts = _run_starts(clear, step) & aligned;
+				if (starts) {
+					out_index = w * BITS_PER_WORD + __builtin_ctzl(starts);
+					return true;
+				}
+			}
+			return false;
+		}
 };
 
 
@@ -145,10 +270,11 @@ class Genode::Bit_array : public Bit_array_base
 		              "Count of bits need to be word aligned!");
 
 		addr_t _array[_WORDS];
+		addr_t _summary_array[_summary_word_cnt(_WORDS)];
 
 	public:
 
-		Bit_array() : Bit_array_base(BITS, _array, true) { }
+		Bit_array() : Bit_array_base(BITS, _array, _summary_array, true) { }
 };
 
 #endif /* _INCLUDE__UTIL__BIT_ARRAY_H_ */
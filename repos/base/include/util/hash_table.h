@@ -0,0 +1,243 @@
+/*
+ * \brief  Open-addressing hash table of objects
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__UTIL__HASH_TABLE_H_
+#define _INCLUDE__UTIL__HASH_TABLE_H_
+
+#include <base/allocator.h>
+#include <util/noncopyable.h>
+#include <util/string.h>
+
+namespace Genode {
+
+	template <typename KEY> struct Hash;
+	template <typename KEY, typename ELEM, typename HASH = Hash<KEY> >
+	class Hash_table;
+
+	/**
+	 * FNV-1a hash of a null-terminated string
+	 *
+	 * Because the function is 'constexpr', the hash of a string literal can
+	 * be computed at compile time.
+	 */
+	constexpr uint32_t hash_string(char const *s, uint32_t h = 2166136261U)
+	{
+		return *s ? hash_string(s + 1, (h ^ (uint8_t)*s)*16777619U) : h;
+	}
+
+	/**
+	 * FNV-1a hash of 'len' bytes at 'data'
+	 */
+	inline uint32_t hash_bytes(void const *data, size_t len,
+	                           uint32_t h = 2166136261U)
+	{
+		uint8_t const *p = (uint8_t const *)data;
+		for (size_t i = 0; i < len; i++)
+			h = (h ^ p[i])*16777619U;
+		return h;
+	}
+}
+
+
+/**
+ * Default hash function, which hashes the object representation of the key
+ *
+ * The default is suited for integers and plain structures without padding.
+ * For other key types, the 'Hash' template must be specialized.
+ */
+template <typename KEY>
+struct Genode::Hash
+{
+	static uint32_t value(KEY const &key) { return hash_bytes(&key, sizeof(key)); }
+};
+
+
+/**
+ * Hash table of objects, keyed by a property of the objects
+ *
+ * \param KEY   key type, must be comparable via 'operator =='
+ * \param ELEM  element type, which must provide a 'KEY key() const' method
+ * \param HASH  type providing the static 'uint32_t value(KEY const &)'
+ *              function
+ *
+ * The table merely stores pointers to the elements, which are owned by the
+ * user of the table. Collisions are resolved by linear probing within one
+ * array of slots. So a lookup touches only a few adjacent cache lines
+ * instead of chasing pointers. The slot array grows by allocating from the
+ * allocator passed to the constructor. Inserting elements is the only
+ * operation that allocates.
+ *
+ * The table is not synchronized.
+ */
+template <typename KEY, typename ELEM, typename HASH>
+class Genode::Hash_table : Noncopyable
+{
+	private:
+
+		enum { INITIAL_CAPACITY = 16 };
+
+		Allocator &_alloc;
+		ELEM     **_slots    = nullptr;
+		unsigned   _capacity = 0;  /* number of slots, power of two  */
+		unsigned   _used     = 0;  /* slots occupied or tombstoned   */
+		unsigned   _count    = 0;  /* slots occupied                 */
+
+		/**
+		 * Marker of a removed element, needed to keep probe chains intact
+		 */
+		static ELEM *_tombstone() { return reinterpret_cast<ELEM *>(~0UL); }
+
+		static bool _live(ELEM *elem) { return elem && elem != _tombstone(); }
+
+		unsigned _first_slot(KEY const &key, unsigned capacity) const {
+			return HASH::value(key) & (capacity - 1); }
+
+		static void _insert_into(ELEM **slots, unsigned capacity, unsigned i,
+		                         ELEM *elem)
+		{
+			while (_live(slots[i]))
+				i = (i + 1) & (capacity - 1);
+			slots[i] = elem;
+		}
+
+		/**
+		 * Re-hash all elements into an array of 'capacity' slots
+		 */
+		void _resize(unsigned capacity)
+		{
+			size_t const size = capacity*sizeof(ELEM *);
+			ELEM ** const slots = (ELEM **)_alloc.alloc(size);
+			memset(slots, 0, size);
+
+			for (unsigned i = 0; i < _capacity; i++)
+				if (_live(_slots[i]))
+					_insert_into(slots, capacity,
+					             _first_slot(_slots[i]->key(), capacity),
+					             _slots[i]);
+
+			if (_slots)
+				_alloc.free(_slots, _capacity*sizeof(ELEM *));
+
+			_slots    = slots;
+			_capacity = capacity;
+			_used     = _count;
+		}
+
+		/**
+		 * Return index of the slot holding 'elem', or '_capacity'
+		 */
+		unsigned _slot_of(ELEM const &elem) const
+		{
+			if (!_capacity)
+				return 0;
+
+			for (unsigned i = _first_slot(elem.key(), _capacity); _slots[i];
+			     i = (i + 1) & (_capacity - 1))
+				if (_slots[i] == &elem)
+					return i;
+
+			return _capacity;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  backing store of the slot array, which is not
+		 *               allocated before the first insertion
+		 */
+		Hash_table(Allocator &alloc) : _alloc(alloc) { }
+
+		~Hash_table()
+		{
+			if (_slots)
+				_alloc.free(_slots, _capacity*sizeof(ELEM *));
+		}
+
+		/**
+		 * Look up element by key
+		 *
+		 * \return  element, or 0 if no element with the key exists
+		 */
+		ELEM *find(KEY const &key) const
+		{
+			if (!_capacity)
+				return nullptr;
+
+			for (unsigned i = _first_slot(key, _capacity); _slots[i];
+			     i = (i + 1) & (_capacity - 1))
+				if (_live(_slots[i]) && _slots[i]->key() == key)
+					return _slots[i];
+
+			return nullptr;
+		}
+
+		/**
+		 * Insert element
+		 *
+		 * The table does not check for duplicate keys. A lookup yields
+		 * one of the elements with the same key.
+		 *
+		 * \throw Allocator::Out_of_memory  the table remains unchanged
+		 */
+		void insert(ELEM &elem)
+		{
+			/* keep the load factor below one half, including tombstones */
+			if (2*(_used + 1) > _capacity)
+				_resize(!_capacity ? INITIAL_CAPACITY
+				      : 2*(_count + 1) > _capacity/2 ? 2*_capacity : _capacity);
+
+			_insert_into(_slots, _capacity, _first_slot(elem.key(), _capacity),
+			             &elem);
+			_used++;
+			_count++;
+		}
+
+		/**
+		 * Remove element
+		 *
+		 * The key of the element must not have changed since its insertion.
+		 *
+		 * \return  false if the element is not present in the table
+		 */
+		bool remove(ELEM &elem)
+		{
+			unsigned const i = _slot_of(elem);
+			if (i == _capacity)
+				return false;
+
+			_slots[i] = _tombstone();
+			_count--;
+			return true;
+		}
+
+		bool contains(ELEM const &elem) const { return _slot_of(elem) != _capacity; }
+
+		unsigned count() const { return _count; }
+
+		/**
+		 * Apply functor to each element, in no particular order
+		 *
+		 * The functor must not modify the table.
+		 */
+		template <typename FN>
+		void for_each(FN const &fn) const
+		{
+			for (unsigned i = 0; i < _capacity; i++)
+				if (_live(_slots[i]))
+					fn(*_slots[i]);
+		}
+};
+
+#endif /* _INCLUDE__UTIL__HASH_TABLE_H_ */
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -79,6 +79,81 @@ class Genode::Mmio
 		return value;
 	}
 
+	/**
+	 * Accumulate the masks of the bitfields 'T...' of register 'REG'
+	 */
+	template <typename REG>
+	static constexpr typename REG::access_t _fields_mask() { return 0; }
+
+	template <typename REG, typename T, typename... TN>
+	static constexpr typename REG::access_t _fields_mask()
+	{
+		static_assert(T::Bitfield_base::Compound_reg::OFFSET  == REG::OFFSET,
+		              "bitfields must belong to the same register");
+		return T::reg_mask() | _fields_mask<REG, TN...>();
+	}
+
+	/**
+	 * Accumulate the values of the bitfields 'T...' of register 'REG'
+	 */
+	template <typename REG>
+	static inline typename REG::access_t _fields_bits() { return 0; }
+
+	template <typename REG, typename T, typename... TN>
+	static inline typename REG::access_t
+	_fields_bits(typename REG::access_t const v,
+	             typename TN::Bitfield_base::Compound_reg::access_t const... vn)
+	{
+		return T::bits(v) | _fields_bits<REG, TN...>(vn...);
+	}
+
+	/**
+	 * Override the bits 'item_mask' of successive items of register array
+	 *
+	 * Items that share one access-width instance are written with a single
+	 * access. The instance is read before only if the items do not cover
+	 * all of its bits and the array is not strict.
+	 */
+	template <typename ARRAY>
+	inline void _write_items(unsigned long index, unsigned long count,
+	                         typename ARRAY::access_t const item_mask,
+	                         typename ARRAY::access_t const item_bits)
+	{
+		typedef typename ARRAY::access_t access_t;
+
+		enum { ITEMS_PER_ACCESS = ARRAY::ACCESS_WIDTH / ARRAY::ITEM_WIDTH };
+
+		/* ignore writes outside the array */
+		if (index > ARRAY::MAX_INDEX) return;
+		if (count > ARRAY::ITEMS - index) count = ARRAY::ITEMS - index;
+
+		while (count) {
+
+			off_t offset;
+			long unsigned shift;
+			ARRAY::dst(offset, shift, index);
+
+			unsigned long const first = shift >> ARRAY::ITEM_WIDTH_LOG2;
+			unsigned long const n     = (count < ITEMS_PER_ACCESS - first)
+			                          ? count : ITEMS_PER_ACCESS - first;
+
+			access_t mask = 0, bits = 0;
+			for (unsigned long i = 0; i < n; i++) {
+				mask |= item_mask << (shift + i*ARRAY::ITEM_WIDTH);
+				bits |= item_bits << (shift + i*ARRAY::ITEM_WIDTH);
+			}
+
+			access_t write_value = 0;
+			if (!ARRAY::STRICT_WRITE && mask != (access_t)~0)
+				write_value = _read<access_t>(offset) & ~mask;
+
+			_write<access_t>(offset, write_value | bits);
+
+			index += n;
+			count -= n;
+		}
+	}
+
 	protected:
 
 		/*
@@ -376,6 +451,35 @@ class Genode::Mmio
 			write<Register>(write_value);
 		}
 
+		/**
+		 * Override several bitfields of one register at once
+		 *
+		 * \param v0, v1, vn  values that shall be written to the bitfields
+		 *                    'T0', 'T1', 'TN...'
+		 *
+		 * In contrast to writing the bitfields one by one, the register is
+		 * read and written only once. The masks of the bitfields are
+		 * combined at compile time.
+		 */
+		template <typename T0, typename T1, typename... TN>
+		inline void
+		write(typename T0::Bitfield_base::Compound_reg::access_t const v0,
+		      typename T1::Bitfield_base::Compound_reg::access_t const v1,
+		      typename TN::Bitfield_base::Compound_reg::access_t const... vn)
+		{
+			typedef typename T0::Bitfield_base::Compound_reg Register;
+			typedef typename Register::access_t access_t;
+
+			constexpr access_t mask = _fields_mask<Register, T0, T1, TN...>();
+
+			access_t write_value = 0;
+			if (!Register::STRICT_WRITE)
+				write_value = read<Register>() & (access_t)~mask;
+
+			write_value |= _fields_bits<Register, T0, T1, TN...>(v0, v1, vn...);
+			write<Register>(write_value);
+		}
+
 
 		/*******************************
 		 ** Access to register arrays **
@@ -457,6 +561,27 @@ class Genode::Mmio
 			}
 		}
 
+		/**
+		 * Override successive items of the register array 'T'
+		 *
+		 * \param value  value that shall be written to each item
+		 * \param index  index of the first targeted item
+		 * \param count  number of targeted items
+		 *
+		 * Items that share one access-width instance are written with a
+		 * single access.
+		 */
+		template <typename T>
+		inline void
+		write(typename T::Register_array_base::access_t const value,
+		      unsigned long const index, unsigned long const count)
+		{
+			typedef typename T::Register_array_base Array;
+
+			_write_items<Array>(index, count, Array::ITEM_MASK,
+			                    value & Array::ITEM_MASK);
+		}
+
 
 		/*****************************************************
 		 ** Access to bitfields within register array items **
@@ -508,6 +633,30 @@ class Genode::Mmio
 			write<Array>(write_value, index);
 		}
 
+		/**
+		 * Override the bitfield 'T' of successive register array items
+		 *
+		 * \param value  value that shall be written to the bitfield of
+		 *               each item
+		 * \param index  index of the first targeted item
+		 * \param count  number of targeted items
+		 *
+		 * Items that share one access-width instance are written with a
+		 * single access.
+		 */
+		template <typename T>
+		inline void
+		write(typename T::Array_bitfield_base::Compound_array::access_t const value,
+		      unsigned long const index, unsigned long const count)
+		{
+			typedef typename T::Array_bitfield_base Bitfield;
+			typedef typename Bitfield::Compound_array Array;
+
+			_write_items<Array>(index, count,
+			                    Bitfield::reg_mask() & Array::ITEM_MASK,
+			                    Bitfield::bits(value) & Array::ITEM_MASK);
+		}
+
 
 		/***********************
 		 ** Access to bitsets **
@@ -0,0 +1,168 @@
+/*
+ * \brief  Array of objects sorted by key
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__UTIL__SORTED_ARRAY_H_
+#define _INCLUDE__UTIL__SORTED_ARRAY_H_
+
+#include <base/allocator.h>
+#include <util/noncopyable.h>
+#include <util/string.h>
+
+namespace Genode { template <typename KEY, typename ELEM> class Sorted_array; }
+
+
+/**
+ * Array of objects sorted by a property of the objects
+ *
+ * \param KEY   key type, must be ordered via 'operator <'
+ * \param ELEM  element type, which must provide a 'KEY key() const' method
+ *
+ * Compared to an 'Avl_tree', the elements need no node meta data and a
+ * lookup is a binary search over one contiguous array. In return, inserting
+ * and removing elements costs linear time. Hence, the array is suited for
+ * sets that are looked up much more often than they change. Like
+ * 'Hash_table', the array stores pointers to elements owned by its user and
+ * allocates on insertion only.
+ *
+ * The array is not synchronized.
+ */
+template <typename KEY, typename ELEM>
+class Genode::Sorted_array : Noncopyable
+{
+	private:
+
+		enum { INITIAL_CAPACITY = 8 };
+
+		Allocator &_alloc;
+		ELEM     **_elems    = nullptr;
+		unsigned   _capacity = 0;
+		unsigned   _count    = 0;
+
+		/**
+		 * Return index of the first element with a key not less than 'key'
+		 */
+		unsigned _lower_bound(KEY const &key) const
+		{
+			unsigned lo = 0, hi = _count;
+			while (lo < hi) {
+				unsigned const mid = lo + (hi - lo)/2;
+				if (_elems[mid]->key() < key)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+
+		void _grow()
+		{
+			unsigned const capacity = _capacity ? 2*_capacity : INITIAL_CAPACITY;
+
+			ELEM ** const elems = (ELEM **)_alloc.alloc(capacity*sizeof(ELEM *));
+
+			if (_elems) {
+				memcpy(elems, _elems, _count*sizeof(ELEM *));
+				_alloc.free(_elems, _capacity*sizeof(ELEM *));
+			}
+
+			_elems    = elems;
+			_capacity = capacity;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  backing store of the array, which is not allocated
+		 *               before the first insertion
+		 */
+		Sorted_array(Allocator &alloc) : _alloc(alloc) { }
+
+		~Sorted_array()
+		{
+			if (_elems)
+				_alloc.free(_elems, _capacity*sizeof(ELEM *));
+		}
+
+		/**
+		 * Look up element by key
+		 *
+		 * \return  element, or 0 if no element with the key exists
+		 */
+		ELEM *find(KEY const &key) const
+		{
+			unsigned const i = _lower_bound(key);
+			return (i < _count && !(key < _elems[i]->key())) ? _elems[i] : nullptr;
+		}
+
+		/**
+		 * Insert element
+		 *
+		 * Elements with equal keys are kept in the order of their insertion.
+		 *
+		 * \throw Allocator::Out_of_memory  the array remains unchanged
+		 */
+		void insert(ELEM &elem)
+		{
+			if (_count == _capacity)
+				_grow();
+
+			/* insert behind all elements with a key not greater than ours */
+			unsigned i = _lower_bound(elem.key());
+			while (i < _count && !(elem.key() < _elems[i]->key()))
+				i++;
+
+			memmove(_elems + i + 1, _elems + i, (_count - i)*sizeof(ELEM *));
+			_elems[i] = &elem;
+			_count++;
+		}
+
+		/**
+		 * Remove element
+		 *
+		 * The key of the element must not have changed since its insertion.
+		 *
+		 * \return  false if the element is not present in the array
+		 */
+		bool remove(ELEM &elem)
+		{
+			for (unsigned i = _lower_bound(elem.key());
+			     i < _count && !(elem.key() < _elems[i]->key()); i++) {
+
+				if (_elems[i] != &elem)
+					continue;
+
+				_count--;
+				memmove(_elems + i, _elems + i + 1, (_count - i)*sizeof(ELEM *));
+				return true;
+			}
+			return false;
+		}
+
+		unsigned count() const { return _count; }
+
+		/**
+		 * Apply functor to each element in the order of their keys
+		 *
+		 * The functor must not modify the array.
+		 */
+		template <typename FN>
+		void for_each(FN const &fn) const
+		{
+			for (unsigned i = 0; i < _count; i++)
+				fn(*_elems[i]);
+		}
+};
+
+#endif /* _INCLUDE__UTIL__SORTED_ARRAY_H_ */
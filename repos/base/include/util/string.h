@@ -222,6 +222,41 @@ namespace Genode {
 	}
 
 
+	/**
+	 * Fill destination buffer with zeros
+	 *
+	 * \param dst   destination memory block
+	 * \param size  number of bytes to clear
+	 *
+	 * \return      pointer to destination memory block
+	 *
+	 * In contrast to 'memset', the buffer is cleared by machine words and
+	 * CPU-specific means are used where available, e.g., non-temporal
+	 * stores for large buffers on x86.
+	 */
+	inline void *memclear(void *dst, size_t size)
+	{
+		char *d = (char *)dst;
+		size_t i = size - memclear_cpu(dst, size);
+
+		d += i; size -= i;
+
+		/* clear to word alignment */
+		for (; size && ((addr_t)d & (sizeof(long) - 1)); size--)
+			*d++ = 0;
+
+		/* clear word-sized chunks */
+		for (; size >= sizeof(long); size -= sizeof(long), d += sizeof(long))
+			*(long *)d = 0;
+
+		/* clear remaining bytes */
+		for (; size; size--)
+			*d++ = 0;
+
+		return dst;
+	}
+
+
 	/**
 	 * Convert ASCII character to digit
 	 *
@@ -180,9 +180,23 @@ USED_SO_FILES    := $(filter-out %$(DYNAMIC_LINKER).lib.so,$(USED_SO_FILES))
 #
 ENTRY_POINT      ?= 0x0
 
+#
+# Link shared library at a fixed base address
+#
+# If 'LIB_SO_ADDR' is defined by the library description, the library is
+# linked at the specified address. The dynamic linker places the library at
+# this address if the address range is free, which spares the relocation of
+# all base-relative addresses at load time. Hence, the base addresses of
+# libraries that are used together should not overlap.
+#
+ifneq ($(LIB_SO_ADDR),)
+LD_OPT += -Ttext-segment=$(LIB_SO_ADDR)
+endif
+
 $(LIB_SO): $(STATIC_LIBS) $(OBJECTS) $(wildcard $(LD_SCRIPT_SO))
 	$(MSG_MERGE)$(LIB_SO)
 	$(VERBOSE)libs=$(LIB_CACHE_DIR); $(LD) -o $(LIB_SO) -shared --eh-frame-hdr \
+	                --hash-style=both \
 	                $(LD_OPT) \
 	                -T $(LD_SCRIPT_SO) \
 	                --entry=$(ENTRY_POINT) \
@@ -173,6 +173,79 @@ void Allocator_avl_base::_cut_from_block(Block *b, addr_t addr, size_t size,
 }
 
 
+bool Allocator_avl_base::_cache_block(Block *b)
+{
+	if (!_segregated_fit)
+		return false;
+
+	unsigned const c = _size_class(b->size());
+	if (c == NUM_SIZE_CLASSES || _num_cached[c] >= MAX_CACHED)
+		return false;
+
+	b->cached(true, _cached_blocks[c]);
+	_cached_blocks[c] = b;
+	_num_cached[c]++;
+	_cached_bytes += b->size();
+	return true;
+}
+
+
+Allocator_avl_base::Block *
+Allocator_avl_base::_take_cached_block(size_t size, int align, addr_t from, addr_t to)
+{
+	unsigned const c = _size_class(size);
+	if (!_segregated_fit || c == NUM_SIZE_CLASSES)
+		return 0;
+
+	Block *prev = 0;
+	for (Block *b = _cached_blocks[c]; b; prev = b, b = b->next_cached()) {
+
+		addr_t const addr = b->addr();
+		if (b->size() != size || addr < from || addr + size - 1 > to
+		 || align_addr(addr, align) != addr)
+			continue;
+
+		/* unlink block from free list, it stays marked as used */
+		if (prev)
+			prev->cached(true, b->next_cached());
+		else
+			_cached_blocks[c] = b->next_cached();
+
+		b->cached(false);
+		_num_cached[c]--;
+		_cached_bytes -= size;
+		return b;
+	}
+	return 0;
+}
+
+
+void Allocator_avl_base::_flush_cached_blocks()
+{
+	for (unsigned c = 0; c < NUM_SIZE_CLASSES; c++) {
+		while (Block *b = _cached_blocks[c]) {
+			_cached_blocks[c] = b->next_cached();
+			_num_cached[c]--;
+			_cached_bytes -= b->size();
+
+			b->cached(false);
+			_free_block(b);
+		}
+	}
+}
+
+
+void Allocator_avl_base::_free_block(Block *b)
+{
+	addr_t new_addr = b->addr();
+	size_t new_size = b->size();
+
+	_destroy_block(b);
+
+	add_range(new_addr, new_size);
+}
+
+
 int Allocator_avl_base::add_range(addr_t new_addr, size_t new_size)
 {
 	Block *b;
@@ -214,6 +287,9 @@ int Allocator_avl_base::remove_range(addr_t base, size_t size)
 	/* sanity check for insane users ;-) */
 	if (!size) return -1;
 
+	/* cached blocks look like used blocks, which cannot be removed */
+	_flush_cached_blocks();
+
 	Block *dst1, *dst2;
 	if (!_alloc_two_blocks_metadata(&dst1, &dst2))
 		return -2;
@@ -250,6 +326,12 @@ int Allocator_avl_base::remove_range(addr_t base, size_t size)
 
 Range_allocator::Alloc_return Allocator_avl_base::alloc_aligned(size_t size, void **out_addr, int align, addr_t from, addr_t to)
 {
+	/* try to reuse a recently freed block of the same size */
+	if (Block *b = _take_cached_block(size, align, from, to)) {
+		*out_addr = reinterpret_cast<void *>(b->addr());
+		return Alloc_return(Alloc_return::OK);
+	}
+
 	Block *dst1, *dst2;
 	if (!_alloc_two_blocks_metadata(&dst1, &dst2))
 		return Alloc_return(Alloc_return::OUT_OF_METADATA);
@@ -261,6 +343,12 @@ Range_allocator::Alloc_return Allocator_avl_base::alloc_aligned(size_t size, voi
 	if (!b) {
 		_md_alloc->free(dst1, sizeof(Block));
 		_md_alloc->free(dst2, sizeof(Block));
+
+		/* merge cached blocks and retry */
+		if (_cached_bytes) {
+			_flush_cached_blocks();
+			return alloc_aligned(size, out_addr, align, from, to);
+		}
 		return Alloc_return(Alloc_return::RANGE_CONFLICT);
 	}
 
@@ -297,6 +385,13 @@ Range_allocator::Alloc_return Allocator_avl_base::alloc_addr(size_t size, addr_t
 	Block *b = _addr_tree.first();
 	b = b ? b->find_by_address(addr, size) : 0;
 
+	/* a cached block covering the address must be merged first */
+	if (b && b->cached()) {
+		_flush_cached_blocks();
+		b = _addr_tree.first();
+		b = b ? b->find_by_address(addr, size) : 0;
+	}
+
 	/* skip if there's no block or block is used */
 	if (!b || b->used())
 	{
@@ -325,18 +420,15 @@ void Allocator_avl_base::free(void *addr)
 	/* lookup corresponding block */
 	Block *b = _find_by_address(reinterpret_cast<addr_t>(addr));
 
-	if (!b || !(b->used())) return;
+	if (!b || !(b->used()) || b->cached()) return;
 
-	addr_t new_addr = b->addr();
-	size_t new_size = b->size();
-
-	if (new_addr != (addr_t)addr)
+	if (b->addr() != (addr_t)addr)
 		PERR("%s: given address (0x%p) is not the block start address (0x%lx)",
-		     __PRETTY_FUNCTION__, addr, new_addr);
+		     __PRETTY_FUNCTION__, addr, b->addr());
+	else if (_cache_block(b))
+		return;
 
-	_destroy_block(b);
-
-	add_range(new_addr, new_size);
+	_free_block(b);
 }
 
 
@@ -345,7 +437,7 @@ size_t Allocator_avl_base::size_at(void const *addr) const
 	/* lookup corresponding block */
 	Block *b = _find_by_address(reinterpret_cast<addr_t>(addr));
 
-	return (b && b->used()) ? b->size() : 0;
+	return (b && b->used() && !b->cached()) ? b->size() : 0;
 }
 
 
@@ -361,7 +453,7 @@ bool Allocator_avl_base::any_block_addr(addr_t *out_addr)
 size_t Allocator_avl_base::avail() const
 {
 	Block *b = static_cast<Block *>(_addr_tree.first());
-	return b ? b->avail_in_subtree() : 0;
+	return (b ? b->avail_in_subtree() : 0) + _cached_bytes;
 }
 
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2006-2013 Genode Labs GmbH
+ * Copyright (C) 2006-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -32,6 +32,7 @@ class Log_console : public Console
 		Log_connection _log;
 		char           _buf[_BUF_SIZE];
 		unsigned       _num_chars;
+		unsigned       _num_complete_chars;  /* chars up to the last line break */
 		Lock           _lock;
 
 		void _flush()
@@ -41,11 +42,35 @@ class Log_console : public Console
 			_log.write(_buf);
 
 			/* restart with empty buffer */
-			_num_chars = 0;
+			_num_chars = _num_complete_chars = 0;
+		}
+
+		/**
+		 * Flush complete lines, keep the incomplete last line buffered
+		 */
+		void _flush_complete_lines()
+		{
+			if (!_num_complete_chars)
+				return;
+
+			unsigned const num_incomplete = _num_chars - _num_complete_chars;
+			char           incomplete[_BUF_SIZE];
+
+			memcpy(incomplete, _buf + _num_complete_chars, num_incomplete);
+			_num_chars = _num_complete_chars;
+			_flush();
+
+			memcpy(_buf, incomplete, num_incomplete);
+			_num_chars = num_incomplete;
 		}
 
 	protected:
 
+		/*
+		 * Line breaks do not trigger a flush. Instead, all lines produced
+		 * by one 'vprintf' call are written with as few LOG RPCs as
+		 * possible.
+		 */
 		void _out_char(char c)
 		{
 			/* ensure enough buffer space for complete escape sequence */
@@ -53,9 +78,11 @@ class Log_console : public Console
 
 			_buf[_num_chars++] = c;
 
-			/* flush immediately on line break */
-			if (c == '\n' || _num_chars >= sizeof(_buf) - 1)
-                          _flush();
+			if (c == '\n')
+				_num_complete_chars = _num_chars;
+
+			if (_num_chars >= sizeof(_buf) - 1)
+				_flush();
 		}
 
 	public:
@@ -65,7 +92,7 @@ class Log_console : public Console
 		 */
 		Log_console()
 		:
-			_num_chars(0)
+			_num_chars(0), _num_complete_chars(0)
 		{ }
 
 		/**
@@ -75,6 +102,7 @@ class Log_console : public Console
 		{
 			Lock::Guard lock_guard(_lock);
 			Console::vprintf(format, list);
+			_flush_complete_lines();
 		}
 
 		/**
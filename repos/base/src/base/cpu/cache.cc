@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -14,8 +14,14 @@
 #include <cpu/cache.h>
 
 /*
- * This function needs to be implemented only for base platforms with ARM
+ * These functions need to be implemented only for base platforms with ARM
  * support right now, so the default implementation does nothing.
  */
-void cache_coherent(Genode::addr_t, Genode::size_t) { }
+void Genode::cache_coherent(Genode::addr_t, Genode::size_t) { }
+
+void Genode::cache_clean(Genode::addr_t, Genode::size_t) { }
+
+void Genode::cache_invalidate(Genode::addr_t, Genode::size_t) { }
+
+void Genode::cache_clean_invalidate(Genode::addr_t, Genode::size_t) { }
 
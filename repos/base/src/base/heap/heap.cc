@@ -60,6 +60,8 @@ Heap::Dataspace *Heap::_allocate_dataspace(size_t size, bool enforce_separate_me
 	void *ds_meta_data_addr = 0;
 	Heap::Dataspace *ds = 0;
 
+	size = _backing_store_size(size);
+
 	/* make new ram dataspace available at our local address space */
 	try {
 		new_ds_cap = _ds_pool.ram_session->alloc(size);
@@ -165,9 +167,9 @@ bool Heap::_unsynchronized_alloc(size_t size, void **out_addr)
 
 		/*
 		 * Exponentially increase chunk size with each allocated chunk until
-		 * we hit 'MAX_CHUNK_SIZE'.
+		 * we hit the maximum chunk size.
 		 */
-		_chunk_size = min(2*_chunk_size, (size_t)MAX_CHUNK_SIZE);
+		_chunk_size = min(2*_chunk_size, _max_chunk_size);
 
 	} else {
 
@@ -17,6 +17,7 @@
 
 /* local includes */
 #include <spin_lock.h>
+#include <spin_backoff.h>
 
 using namespace Genode;
 
@@ -70,19 +71,36 @@ void Cancelable_lock::lock()
 {
 	Applicant myself(Thread_base::myself());
 
-	spinlock_lock(&_spinlock_state);
+	/*
+	 * Critical sections are mostly short. Before blocking, which costs
+	 * kernel entries for us and the lock holder, we spin with exponential
+	 * backoff for the lock to become free. If other applicants are queued
+	 * already, 'unlock' hands the lock over to them and the lock state
+	 * stays 'LOCKED'. In this case, the spinning ends with the backoff.
+	 */
+	for (unsigned backoff = 1; ; ) {
+
+		spinlock_lock(&_spinlock_state);
+
+		/* reset ownership if one thread 'lock' twice */
+		if (_owner == myself)
+			_owner = Applicant(invalid_thread_base());
 
-	/* reset ownership if one thread 'lock' twice */
-	if (_owner == myself)
-		_owner = Applicant(invalid_thread_base());
+		if (cmpxchg(&_state, UNLOCKED, LOCKED)) {
 
-	if (cmpxchg(&_state, UNLOCKED, LOCKED)) {
+			/* we got the lock */
+			_owner          =  myself;
+			_last_applicant = &_owner;
+			spinlock_unlock(&_spinlock_state);
+			return;
+		}
+
+		if (!backoff)
+			break;
 
-		/* we got the lock */
-		_owner          =  myself;
-		_last_applicant = &_owner;
 		spinlock_unlock(&_spinlock_state);
-		return;
+
+		backoff = spin_backoff(&_state, LOCKED, backoff);
 	}
 
 	/*
@@ -0,0 +1,43 @@
+/*
+ * \brief  Bounded busy waiting for locks
+ * \author Norman Feske
+ * \date   2015-12-10
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__LOCK__SPIN_BACKOFF_H_
+#define _INCLUDE__BASE__LOCK__SPIN_BACKOFF_H_
+
+/*
+ * Upper bound of busy-waiting iterations between two attempts to acquire
+ * a lock
+ *
+ * On multi-core machines, the lock holder is likely running on another
+ * CPU and about to leave its short critical section. So we first wait
+ * with exponential backoff and resort to yielding the CPU only if the
+ * lock is still taken after the backoff reached its limit.
+ */
+enum { SPIN_BACKOFF_MAX = 1 << 10 };
+
+
+/**
+ * Busy-wait until '*lock_variable' changes or 'backoff' iterations passed
+ *
+ * \return  doubled backoff, or 0 if the backoff limit is exceeded
+ */
+static inline unsigned spin_backoff(volatile int *lock_variable, int locked,
+                                    unsigned backoff)
+{
+	for (unsigned i = 0; i < backoff && *lock_variable == locked; i++)
+		asm volatile ("" ::: "memory");
+
+	return backoff < SPIN_BACKOFF_MAX ? backoff << 1 : 0;
+}
+
+#endif /* _INCLUDE__BASE__LOCK__SPIN_BACKOFF_H_ */
@@ -21,6 +21,7 @@
 
 /* local includes */
 #include <lock_helper.h>
+#include <spin_backoff.h>
 
 /*
  * Spinlock functions used for protecting the critical sections within the
@@ -33,7 +34,15 @@ enum State { SPINLOCK_LOCKED, SPINLOCK_UNLOCKED };
 
 static inline void spinlock_lock(volatile int *lock_variable)
 {
+	unsigned backoff = 1;
+
 	while (!Genode::cmpxchg(lock_variable, SPINLOCK_UNLOCKED, SPINLOCK_LOCKED)) {
+
+		if (backoff) {
+			backoff = spin_backoff(lock_variable, SPINLOCK_LOCKED, backoff);
+			continue;
+		}
+
 		/*
 		 * Yield our remaining time slice to help the spinlock holder to pass
 		 * the critical section.
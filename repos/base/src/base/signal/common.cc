@@ -131,12 +131,16 @@ Signal Signal_receiver::wait_for_signal()
 {
 	for (;;) {
 
-		/* block until the receiver has received a signal */
-		block_for_signal();
-
+		/*
+		 * A single 'block_for_signal' may have marked several contexts as
+		 * pending, return those before blocking again
+		 */
 		try {
 			return pending_signal();
 		} catch (Signal_not_pending) { }
+
+		/* block until the receiver has received a signal */
+		block_for_signal();
 	}
 }
 
@@ -137,6 +137,36 @@ namespace Genode {
 				}
 				return false;
 			}
+
+			/**
+			 * Submit signal to the context that is referred to by 'cap'
+			 *
+			 * \return  false if 'cap' does not refer to a context of this
+			 *          process
+			 */
+			bool submit(Signal_context_capability cap, unsigned num) const
+			{
+				if (!cap.valid())
+					return false;
+
+				Lock::Guard guard(_lock);
+
+				List_element<Signal_context> const *le = _list.first();
+				for ( ; le; le = le->next()) {
+
+					Signal_context * const context = le->object();
+					if (context->_cap.local_name() != cap.local_name())
+						continue;
+
+					Lock::Guard context_guard(context->_lock);
+
+					if (context->_receiver)
+						context->_receiver->local_submit(Signal::Data(context, num));
+
+					return true;
+				}
+				return false;
+			}
 	};
 }
 
@@ -151,6 +181,17 @@ Genode::Signal_context_registry *signal_context_registry()
 }
 
 
+/**
+ * Submit signal to a context of this process without the kernel's help
+ *
+ * \return  false if 'cap' does not refer to a context of this process
+ */
+bool local_signal_submit(Signal_context_capability cap, unsigned num)
+{
+	return signal_context_registry()->submit(cap, num);
+}
+
+
 /********************
  ** Signal context **
  ********************/
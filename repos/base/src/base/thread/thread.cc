@@ -33,6 +33,89 @@ namespace Genode {
 }
 
 
+namespace {
+
+	using namespace Genode;
+
+	/**
+	 * Cache of the contexts of destroyed threads
+	 *
+	 * Allocating and attaching the backing store of a stack costs two RPCs
+	 * to core, detaching and freeing it another two. To spare software
+	 * that creates and destroys threads at a high rate, e.g., thread-per-
+	 * request servers or pthread-based programs, these round trips, the
+	 * contexts of a few destroyed threads are kept with their stacks still
+	 * attached and handed out to new threads with a matching stack size.
+	 */
+	class Context_cache
+	{
+		public:
+
+			enum { MAX_CONTEXTS = 8 };
+
+			struct Entry
+			{
+				Thread_base::Context     *context = nullptr;
+				addr_t                    stack_base = 0;
+				Ram_dataspace_capability  ds_cap;
+			};
+
+		private:
+
+			Entry    _entries[MAX_CONTEXTS];
+			unsigned _count = 0;
+
+		public:
+
+			/**
+			 * Lock that synchronizes the allocation of contexts
+			 */
+			Lock lock;
+
+			/**
+			 * Take entry with a sufficiently large stack out of the cache
+			 *
+			 * \param stack_base  functor that returns the requested stack
+			 *                    base for a given context
+			 */
+			template <typename FN>
+			bool take(FN const &stack_base, Entry &entry)
+			{
+				for (unsigned i = 0; i < _count; i++) {
+					if (_entries[i].stack_base > stack_base(_entries[i].context))
+						continue;
+
+					entry = _entries[i];
+					_entries[i] = _entries[--_count];
+					return true;
+				}
+				return false;
+			}
+
+			/**
+			 * Put entry into the cache
+			 *
+			 * \return  false if the cache is full
+			 */
+			bool put(Entry const &entry)
+			{
+				if (_count == MAX_CONTEXTS)
+					return false;
+
+				_entries[_count++] = entry;
+				return true;
+			}
+	};
+
+
+	Context_cache &context_cache()
+	{
+		static Context_cache inst;
+		return inst;
+	}
+}
+
+
 void Thread_base::Context::stack_size(size_t const size)
 {
 	/* check if the stack needs to be enhanced */
@@ -67,21 +150,29 @@ void Thread_base::Context::stack_size(size_t const size)
 }
 
 
+/**
+ * Return context address that lies behind the stack of 'context'
+ */
+static addr_t stack_end(Thread_base::Context const *context)
+{
+	enum { PAGE_SIZE_LOG2 = 12 };
+
+	addr_t const base = (addr_t)context &
+	                    ~(Native_config::context_virtual_size() - 1);
+	addr_t end = base + Native_config::context_virtual_size();
+
+	/* add padding for UTCB if defined for the platform */
+	if (sizeof(Native_utcb) >= (1 << PAGE_SIZE_LOG2))
+		end -= sizeof(Native_utcb);
+
+	return end;
+}
+
+
 Thread_base::Context *
 Thread_base::_alloc_context(size_t stack_size, bool main_thread)
 {
-	/*
-	 * Synchronize context list when creating new threads from multiple threads
-	 *
-	 * XXX: remove interim fix
-	 */
-	static Lock alloc_lock;
-	Lock::Guard _lock_guard(alloc_lock);
-
-	/* allocate thread context */
-	Context *context = _context_allocator()->alloc(this, main_thread);
-	if (!context)
-		throw Context_alloc_failed();
+	Lock::Guard _lock_guard(context_cache().lock);
 
 	/* determine size of dataspace to allocate for context members and stack */
 	enum { PAGE_SIZE_LOG2 = 12 };
@@ -96,23 +187,37 @@ Thread_base::_alloc_context(size_t stack_size, bool main_thread)
 	 *
 	 * The stack is always located at the top of the context.
 	 */
-	addr_t ds_addr = Context_allocator::addr_to_base(context) +
-	                 Native_config::context_virtual_size() -
-	                 ds_size;
-
-	/* add padding for UTCB if defined for the platform */
-	if (sizeof(Native_utcb) >= (1 << PAGE_SIZE_LOG2))
-		ds_addr -= sizeof(Native_utcb);
-
-	/* allocate and attach backing store for the stack */
-	Ram_dataspace_capability ds_cap;
-	try {
-		ds_cap = env_context_area_ram_session()->alloc(ds_size);
-		addr_t attach_addr = ds_addr - Native_config::context_area_virtual_base();
-		if (attach_addr != (addr_t)env_context_area_rm_session()->attach_at(ds_cap, attach_addr, ds_size))
-			throw Stack_alloc_failed();
+	auto stack_base = [&] (Context const *context) {
+		return stack_end(context) - ds_size; };
+
+	Context                  *context = nullptr;
+	addr_t                    ds_addr = 0;
+	Ram_dataspace_capability  ds_cap;
+
+	/* reuse the context of a destroyed thread if its stack suffices */
+	Context_cache::Entry entry;
+	if (!main_thread && context_cache().take(stack_base, entry)) {
+		context = entry.context;
+		ds_addr = entry.stack_base;
+		ds_cap  = entry.ds_cap;
+	} else {
+
+		/* allocate thread context */
+		context = _context_allocator()->alloc(this, main_thread);
+		if (!context)
+			throw Context_alloc_failed();
+
+		ds_addr = stack_base(context);
+
+		/* allocate and attach backing store for the stack */
+		try {
+			ds_cap = env_context_area_ram_session()->alloc(ds_size);
+			addr_t attach_addr = ds_addr - Native_config::context_area_virtual_base();
+			if (attach_addr != (addr_t)env_context_area_rm_session()->attach_at(ds_cap, attach_addr, ds_size))
+				throw Stack_alloc_failed();
+		}
+		catch (Ram_session::Alloc_failed) { throw Stack_alloc_failed(); }
 	}
-	catch (Ram_session::Alloc_failed) { throw Stack_alloc_failed(); }
 
 	/*
 	 * Now the thread context is backed by memory, so it is safe to access its
@@ -134,14 +239,24 @@ Thread_base::_alloc_context(size_t stack_size, bool main_thread)
 
 void Thread_base::_free_context(Context* context)
 {
-	addr_t ds_addr = context->stack_base - Native_config::context_area_virtual_base();
-	Ram_dataspace_capability ds_cap = context->ds_cap;
+	Context_cache::Entry entry;
+	entry.context    = context;
+	entry.stack_base = context->stack_base;
+	entry.ds_cap     = context->ds_cap;
+
+	addr_t ds_addr = entry.stack_base - Native_config::context_area_virtual_base();
 
 	/* call de-constructor explicitly before memory gets detached */
 	context->~Context();
 
+	Lock::Guard _lock_guard(context_cache().lock);
+
+	/* keep the context including its stack for the next thread */
+	if (context_cache().put(entry))
+		return;
+
 	Genode::env_context_area_rm_session()->detach((void *)ds_addr);
-	Genode::env_context_area_ram_session()->free(ds_cap);
+	Genode::env_context_area_ram_session()->free(entry.ds_cap);
 
 	/* context area ready for reuse */
 	_context_allocator()->free(context);
@@ -104,7 +104,8 @@ namespace Genode {
 			{
 				return { _session_label, _name,
 				         _platform_thread.execution_time(),
-				         _platform_thread.affinity() };
+				         _platform_thread.affinity(),
+				         _platform_thread.perf_counters() };
 			}
 
 
@@ -195,6 +195,17 @@ namespace Genode {
 			 */
 			void unmap(addr_t core_local_base, addr_t virt_base, size_t size);
 
+			/**
+			 * Establish memory mappings for a region of the client's
+			 * RM session in advance
+			 *
+			 * \param region  attached region of a leaf dataspace
+			 *
+			 * On kernels that populate address spaces as response of
+			 * page faults only, the function has no effect.
+			 */
+			void prefault(Rm_region const &region);
+
 			bool has_same_address_space(Rm_client const &other)
 			{
 				return other._address_space == _address_space;
@@ -388,6 +399,7 @@ namespace Genode {
 
 			Local_addr       attach        (Dataspace_capability, size_t, off_t, bool, Local_addr, bool);
 			void             detach        (Local_addr);
+			void             prefault      (Local_addr);
 			Pager_capability add_client    (Thread_capability);
 			void             remove_client (Pager_capability);
 			void             fault_handler (Signal_context_capability handler);
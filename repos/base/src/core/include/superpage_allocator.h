@@ -0,0 +1,215 @@
+/*
+ * \brief  Physical-memory allocator that keeps superpages intact
+ * \author Norman Feske
+ * \date   2015-12-03
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _CORE__INCLUDE__SUPERPAGE_ALLOCATOR_H_
+#define _CORE__INCLUDE__SUPERPAGE_ALLOCATOR_H_
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/lock.h>
+
+/* core includes */
+#include <util.h>
+
+namespace Genode { class Superpage_allocator; }
+
+
+/**
+ * Range allocator that segregates small from large physical allocations
+ *
+ * Allocations of at least one superpage are passed to the backing
+ * allocator. Smaller allocations are served from superpage-sized and
+ * superpage-aligned chunks, which are obtained from the backing allocator
+ * on demand and returned as soon as they become completely free. Similar
+ * to a two-level buddy allocator, small allocations are thereby packed
+ * into few chunks instead of being scattered over the physical memory,
+ * which leaves naturally aligned ranges for large dataspaces. Those can
+ * then be mapped with superpages by kernels that support it.
+ *
+ * A small allocation is taken directly from the backing allocator only if
+ * no aligned chunk is available anymore.
+ *
+ * The allocator is tailored to the RAM service, which asks for natural
+ * alignment first and weakens the constraint step by step. A small
+ * allocation with an alignment above the page size fails if the chunks
+ * have room for the allocation at page alignment only. This way, the
+ * request is eventually served from an existing chunk rather than
+ * occupying a new one.
+ */
+class Genode::Superpage_allocator : public Range_allocator
+{
+	public:
+
+		/*
+		 * A chunk of 4 MiB is aligned for the superpages of all supported
+		 * architectures, i.e., 1 MiB ARM sections, 2 MiB x86_64 large
+		 * pages, and 4 MiB x86_32 large pages.
+		 */
+		enum { DEFAULT_CHUNK_SIZE_LOG2 = 22 };
+
+	private:
+
+		using Chunk_alloc = Allocator_avl_tpl<Empty, get_page_size()>;
+
+		Lock mutable     _lock;
+		Range_allocator &_backing;
+		Chunk_alloc      _small;
+		unsigned const   _chunk_size_log2;
+
+		size_t _chunk_size() const { return 1UL << _chunk_size_log2; }
+
+		addr_t _chunk_base(addr_t addr) const {
+			return addr & ~(_chunk_size() - 1); }
+
+		/**
+		 * Obtain new chunk within 'from' and 'to' from the backing store
+		 */
+		bool _add_chunk(addr_t from, addr_t to)
+		{
+			void *chunk = 0;
+			if (!_backing.alloc_aligned(_chunk_size(), &chunk, _chunk_size_log2,
+			                            from, to).is_ok())
+				return false;
+
+			if (_small.add_range((addr_t)chunk, _chunk_size()) == 0)
+				return true;
+
+			_backing.free(chunk, _chunk_size());
+			return false;
+		}
+
+		/**
+		 * Return chunk to the backing store if it is no longer used
+		 */
+		void _release_chunk_if_unused(addr_t chunk)
+		{
+			/* the chunk is unused if it can be allocated as a whole */
+			if (!_small.alloc_addr(_chunk_size(), chunk).is_ok())
+				return;
+
+			_small.free((void *)chunk);
+
+			if (_small.remove_range(chunk, _chunk_size()) == 0)
+				_backing.free((void *)chunk, _chunk_size());
+		}
+
+		bool _small_size(size_t size) const { return size < _chunk_size(); }
+
+		Alloc_return _alloc_small(size_t size, void **out_addr, int align,
+		                          addr_t from, addr_t to)
+		{
+			Alloc_return const ret =
+				_small.alloc_aligned(size, out_addr, align, from, to);
+			if (ret.is_ok())
+				return ret;
+
+			/* let the caller weaken the alignment if the chunks have room */
+			if ((size_t)align > get_page_size_log2()) {
+				void *probe = 0;
+				if (_small.alloc_aligned(size, &probe, get_page_size_log2(),
+				                         from, to).is_ok()) {
+					_small.free(probe);
+					return ret;
+				}
+			}
+
+			if (_add_chunk(from, to))
+				return _small.alloc_aligned(size, out_addr, align, from, to);
+
+			/* no chunk left, resort to breaking up a larger range */
+			return _backing.alloc_aligned(size, out_addr, align, from, to);
+		}
+
+		void _free(void *addr)
+		{
+			Lock::Guard guard(_lock);
+
+			if (!_small.valid_addr((addr_t)addr)) {
+				_backing.free(addr);
+				return;
+			}
+
+			_small.free(addr);
+			_release_chunk_if_unused(_chunk_base((addr_t)addr));
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param backing          allocator of physical memory
+		 * \param md_alloc         allocator for the meta data of chunks
+		 * \param chunk_size_log2  superpage size
+		 */
+		Superpage_allocator(Range_allocator &backing, Allocator &md_alloc,
+		                    unsigned chunk_size_log2 = DEFAULT_CHUNK_SIZE_LOG2)
+		:
+			_backing(backing), _small(&md_alloc),
+			_chunk_size_log2(chunk_size_log2)
+		{ }
+
+
+		/*******************************
+		 ** Range allocator interface **
+		 *******************************/
+
+		int add_range(addr_t base, size_t size) override {
+			return _backing.add_range(base, size); }
+
+		int remove_range(addr_t base, size_t size) override {
+			return _backing.remove_range(base, size); }
+
+		Alloc_return alloc_aligned(size_t size, void **out_addr, int align = 0,
+		                           addr_t from = 0, addr_t to = ~0UL) override
+		{
+			if (!_small_size(size))
+				return _backing.alloc_aligned(size, out_addr, align, from, to);
+
+			Lock::Guard guard(_lock);
+			return _alloc_small(size, out_addr, align, from, to);
+		}
+
+		Alloc_return alloc_addr(size_t size, addr_t addr) override {
+			return _backing.alloc_addr(size, addr); }
+
+		void free(void *addr) override { _free(addr); }
+
+		size_t avail() const override
+		{
+			Lock::Guard guard(_lock);
+			return _backing.avail() + _small.avail();
+		}
+
+		bool valid_addr(addr_t addr) const override {
+			return _backing.valid_addr(addr); }
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool alloc(size_t size, void **out_addr) override {
+			return alloc_aligned(size, out_addr).is_ok(); }
+
+		void free(void *addr, size_t) override { _free(addr); }
+
+		size_t consumed() const override { return _backing.consumed(); }
+
+		size_t overhead(size_t size) const override {
+			return _backing.overhead(size); }
+
+		bool need_size_for_free() const override { return false; }
+};
+
+#endif /* _CORE__INCLUDE__SUPERPAGE_ALLOCATOR_H_ */
@@ -56,6 +56,7 @@ class Genode::Trace::Source
 			Thread_name        name;
 			Execution_time     execution_time;
 			Affinity::Location affinity;
+			Perf_counters      perf_counters;
 		};
 
 		/**
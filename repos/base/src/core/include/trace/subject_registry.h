@@ -238,6 +238,7 @@ class Genode::Trace::Subject
 		{
 			Execution_time execution_time;
 			Affinity::Location affinity;
+			Perf_counters perf_counters;
 
 			{
 				Locked_ptr<Source> source(_source);
@@ -246,11 +247,12 @@ class Genode::Trace::Subject
 					Trace::Source::Info const info = source->info();
 					execution_time = info.execution_time;
 					affinity       = info.affinity;
+					perf_counters  = info.perf_counters;
 				}
 			}
 
 			return Subject_info(_label, _name, _state(), _policy_id,
-			                    execution_time, affinity);
+			                    execution_time, affinity, perf_counters);
 		}
 
 		Dataspace_capability buffer() const { return _buffer.dataspace(); }
@@ -36,6 +36,7 @@
 #include <signal_root.h>
 #include <trace/root.h>
 #include <platform_services.h>
+#include <superpage_allocator.h>
 
 using namespace Genode;
 
@@ -223,8 +224,15 @@ int main()
 	static Local_service signal_service(signal_name, &signal_root);
 	local_services.insert(&signal_service);
 
+	/*
+	 * Keep small dataspaces from fragmenting the physical memory to
+	 * preserve superpage-aligned ranges for large dataspaces
+	 */
+	static Superpage_allocator ram_alloc(*platform()->ram_alloc(),
+	                                     *platform()->core_mem_alloc());
+
 	static Cap_root     cap_root     (e, &sliced_heap);
-	static Ram_root     ram_root     (e, e, platform()->ram_alloc(), &sliced_heap);
+	static Ram_root     ram_root     (e, e, &ram_alloc, &sliced_heap);
 	static Rom_root     rom_root     (e, e, platform()->rom_fs(), &sliced_heap);
 	static Rm_root      rm_root      (e, e, e, &sliced_heap, core_env()->cap_session(),
 	                                  platform()->vm_start(), platform()->vm_size());
@@ -565,6 +565,35 @@ void Rm_session_component::detach(Local_addr local_addr)
 }
 
 
+void Rm_session_component::prefault(Local_addr local_addr)
+{
+	/* serialize access */
+	Lock::Guard lock_guard(_lock);
+
+	Rm_region *region = _map.metadata(local_addr);
+	if (!region) {
+		PDBG("no attachment at %p", (void *)local_addr);
+		return;
+	}
+
+	/* mappings of managed dataspaces are still established on demand */
+	Dataspace_component *dsc = region->dataspace();
+	if (!dsc || dsc->is_managed())
+		return;
+
+	/* populate each address space only once, see 'detach' */
+	Rm_client *prev_rc = 0;
+	Rm_client *rc = _clients.first();
+	for (; rc; prev_rc = rc, rc = rc->List<Rm_client>::Element::next()) {
+
+		if (prev_rc && prev_rc->has_same_address_space(*rc))
+			continue;
+
+		rc->prefault(*region);
+	}
+}
+
+
 Pager_capability Rm_session_component::add_client(Thread_capability thread)
 {
 	unsigned long badge;
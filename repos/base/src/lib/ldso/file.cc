@@ -117,6 +117,7 @@ struct Linker::Elf_file : File
 	Rom_connection           rom;
 	Ram_dataspace_capability ram_cap[Phdr::MAX_PHDR];
 	bool                     loaded;
+	bool                     shared_object = false;
 	Elf_file(char const *name, bool load = true)
 	:
 	 rom(name), loaded(load)
@@ -162,8 +163,9 @@ struct Linker::Elf_file : File
 			throw Incompatible();
 
 		/* set entry point and program header information */
-		phdr.count = ehdr->e_phnum;
-		entry      = (Entry)ehdr->e_entry;
+		phdr.count    = ehdr->e_phnum;
+		entry         = (Entry)ehdr->e_entry;
+		shared_object = (ehdr->e_type == ET_DYN);
 
 		/* copy program headers */
 		addr_t header = (addr_t)ehdr + ehdr->e_phoff;
@@ -207,6 +209,31 @@ struct Linker::Elf_file : File
 	bool is_rw(Elf::Phdr const &ph) {
 		return ((ph.p_flags & PF_MASK) == (PF_R | PF_W)); }
 
+	bool is_ro(Elf::Phdr const &ph) {
+		return ((ph.p_flags & PF_MASK) == PF_R); }
+
+	/**
+	 * Allocate virtual memory region for the loadable segments
+	 *
+	 * A shared object linked at a non-zero base address is placed at its
+	 * link address if possible, which spares the relocation of
+	 * base-relative addresses. If the region is occupied, the object is
+	 * placed anywhere and relocated as usual.
+	 */
+	addr_t alloc_region()
+	{
+		try { return Rm_area::r(start)->alloc_region(size, start); }
+		catch (Rm_session::Region_conflict) {
+			if (!start || !shared_object)
+				throw;
+		}
+
+		if (verbose_loading)
+			PDBG("link address " EFMT " is occupied, relocate object", start);
+
+		return Rm_area::r()->alloc_region(size);
+	}
+
 	/**
 	 * Load PT_LOAD segments
 	 */
@@ -218,7 +245,7 @@ struct Linker::Elf_file : File
 		loadable_segments(p);
 
 		/* allocate region */
-		reloc_base = Rm_area::r(start)->alloc_region(size, start);
+		reloc_base = alloc_region();
 		reloc_base = (start == reloc_base) ?  0 : reloc_base;
 
 		if (verbose_loading)
@@ -234,8 +261,11 @@ struct Linker::Elf_file : File
 			else if (is_rw(*ph))
 				load_segment_rw(*ph, i);
 
+			else if (is_ro(*ph))
+				load_segment_ro(*ph);
+
 			else {
-				PERR("LD: Non-RW/RX segment");
+				PERR("LD: Non-RW/RX/RO segment");
 				throw Invalid_file();
 			}
 		}
@@ -252,23 +282,41 @@ struct Linker::Elf_file : File
 		                                trunc_page(p.p_offset));
 	}
 
+	/**
+	 * Map read-only, non-executable segment
+	 *
+	 * Like the executable segment, the segment is not copied but refers
+	 * to the ROM dataspace, which is shared by all programs that use the
+	 * same ROM module.
+	 */
+	void load_segment_ro(Elf::Phdr const &p)
+	{
+		Rm_area::r()->attach_at(rom.dataspace(),
+		                        trunc_page(p.p_vaddr) + reloc_base,
+		                        round_page(p.p_memsz),
+		                        trunc_page(p.p_offset));
+	}
+
 	/**
 	 * Copy read-write segment
 	 */
 	void load_segment_rw(Elf::Phdr const &p, int nr)
 	{
-		void  *src = env()->rm_session()->attach(rom.dataspace(), 0, p.p_offset);
+		/* attach only the part of the ROM module that is actually copied */
+		void  *src = env()->rm_session()->attach(rom.dataspace(),
+		                                         round_page(p.p_filesz),
+		                                         p.p_offset);
 		addr_t dst = p.p_vaddr + reloc_base;
 
 		ram_cap[nr] = env()->ram_session()->alloc(p.p_memsz);
 		Rm_area::r()->attach_at(ram_cap[nr], dst);
 
+		/*
+		 * RAM dataspaces are handed out zero-initialized, so there is no
+		 * need to clear the part of the segment beyond the file size
+		 */
 		memcpy((void*)dst, src, p.p_filesz);
 
-		/* clear if file size < memory size */
-		if (p.p_filesz < p.p_memsz)
-			memset((void *)(dst + p.p_filesz), 0, p.p_memsz - p.p_filesz);
-
 		env()->rm_session()->detach(src);
 	}
 
@@ -18,6 +18,9 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	struct Symbol_hash;
+	struct Symbol_cache;
 	struct Dynamic;
 }
 
@@ -51,6 +54,164 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU hash table and hash function
+ *
+ * In contrast to the ELF hash table, the table contains only the symbols
+ * defined by the object, uses a better hash function, and is preceded by a
+ * bloom filter, which rejects most lookups of symbols the object does not
+ * define without touching the hash chains. The layout is described in
+ * 'bfd/elf.c' of binutils.
+ */
+struct Linker::Gnu_hash_table
+{
+	typedef Genode::uint32_t uint32_t;
+
+	enum { BLOOM_WORD_BITS = 8*sizeof(Elf::Addr) };
+
+	uint32_t const _nbuckets;
+	uint32_t const _symoffset;   /* index of first symbol in the table */
+	uint32_t const _bloom_size;  /* number of bloom-filter words */
+	uint32_t const _bloom_shift;
+
+	Elf::Addr const *bloom() const { return (Elf::Addr const *)(this + 1); }
+
+	uint32_t const *buckets() const { return (uint32_t const *)(bloom() + _bloom_size); }
+
+	/**
+	 * Return chain entries, indexed by symbol index
+	 */
+	uint32_t const *chains() const { return buckets() + _nbuckets - _symoffset; }
+
+	/**
+	 * Return true if the bloom filter does not rule out symbol with 'hash'
+	 */
+	bool may_contain(uint32_t hash) const
+	{
+		Elf::Addr const word = bloom()[(hash / BLOOM_WORD_BITS) % _bloom_size];
+		Elf::Addr const mask = ((Elf::Addr)1 << (hash % BLOOM_WORD_BITS))
+		                     | ((Elf::Addr)1 << ((hash >> _bloom_shift) % BLOOM_WORD_BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Call 'fn' with the index of each symbol whose hash matches 'hash'
+	 *
+	 * The traversal stops as soon as 'fn' returns true.
+	 */
+	template <typename FN>
+	void for_each_candidate(uint32_t hash, FN const &fn) const
+	{
+		if (!_nbuckets || !_bloom_size || !may_contain(hash))
+			return;
+
+		uint32_t sym_index = buckets()[hash % _nbuckets];
+		if (sym_index < _symoffset)
+			return;
+
+		for (;; sym_index++) {
+
+			/* the lowest bit of a chain entry marks the end of the chain */
+			uint32_t const chain = chains()[sym_index];
+
+			if ((chain | 1) == (hash | 1) && fn(sym_index))
+				return;
+
+			if (chain & 1)
+				return;
+		}
+	}
+
+	/**
+	 * Return number of entries of the dynamic symbol table
+	 *
+	 * The GNU hash table lacks an explicit symbol count. The count is
+	 * derived from the end of the last hash chain.
+	 */
+	unsigned long nsymbols() const
+	{
+		uint32_t last = 0;
+		for (uint32_t i = 0; i < _nbuckets; i++)
+			last = Genode::max(last, buckets()[i]);
+
+		if (last < _symoffset)
+			return _symoffset;
+
+		while (!(chains()[last] & 1))
+			last++;
+
+		return last + 1;
+	}
+
+	/**
+	 * Hash function of the GNU hash table (Bernstein)
+	 */
+	static uint32_t hash(char const *name)
+	{
+		uint32_t h = 5381;
+
+		for (unsigned char const *p = (unsigned char const *)name; *p; p++)
+			h = h*33 + *p;
+
+		return h;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name for both kinds of hash tables
+ */
+struct Linker::Symbol_hash
+{
+	unsigned long    const elf;
+	Genode::uint32_t const gnu;
+
+	Symbol_hash(char const *name)
+	: elf(Hash_table::hash(name)), gnu(Gnu_hash_table::hash(name)) { }
+};
+
+
+/**
+ * Cache of the symbol lookups performed while relocating an object
+ *
+ * Many relocations of an object refer to the same symbol, e.g., the GOT
+ * entry and the data relocations of a function. The cache remembers the
+ * result of each lookup by symbol index so that the remaining relocations
+ * of the same symbol do not need to search the dependencies again. The
+ * cache is valid only while the dependencies of the object stay the same
+ * and therefore exists only during the relocation of the object.
+ */
+struct Linker::Symbol_cache
+{
+	struct Entry
+	{
+		Elf::Sym const *sym;
+		Elf::Addr       base;
+	};
+
+	Dependency    const *dep;
+	unsigned long const  count;
+	Entry             *  entries;
+
+	Symbol_cache(Dependency const *dep, unsigned long count)
+	:
+		dep(dep), count(count),
+		entries(count ? (Entry *)Genode::env()->heap()->alloc(count*sizeof(Entry))
+		              : nullptr)
+	{
+		if (entries)
+			Genode::memset(entries, 0, count*sizeof(Entry));
+	}
+
+	~Symbol_cache()
+	{
+		if (entries)
+			Genode::env()->heap()->free(entries, count*sizeof(Entry));
+	}
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -77,7 +238,14 @@ struct Linker::Dynamic
 	Object     const     *obj;
 	Elf::Dyn   const     *dynamic;
 
-	Hash_table          *hash_table    = nullptr;
+	Hash_table          *hash_table     = nullptr;
+	Gnu_hash_table      *gnu_hash_table = nullptr;
+
+	/* number of entries of the dynamic symbol table */
+	unsigned long        symbol_count   = 0;
+
+	/* lookup cache, present during relocation */
+	Symbol_cache        *symbol_cache   = nullptr;
 
 	Elf::Rela           *reloca        = nullptr;
 	unsigned long        reloca_size   = 0;
@@ -97,6 +265,9 @@ struct Linker::Dynamic
 	Elf::Rel            *rel           = nullptr;
 	unsigned long        rel_size      = 0;
 
+	/* number of relative relocations at the start of the 'rel' table */
+	unsigned long        rel_count     = 0;
+
 	Genode::Fifo<Needed> needed;
 
 	Dynamic(Dependency const *dep)
@@ -156,6 +327,7 @@ struct Linker::Dynamic
 				case DT_PLTRELSZ: pltrel_size = d->un.val;                           break;
 				case DT_PLTGOT  : section<typeof(pltgot)>(&pltgot, d);               break;
 				case DT_HASH    : section<typeof(hash_table)>(&hash_table, d);       break;
+				case DT_GNU_HASH: section<typeof(gnu_hash_table)>(&gnu_hash_table, d); break;
 				case DT_RELA    : section<typeof(reloca)>(&reloca, d);               break;
 				case DT_RELASZ  : reloca_size = d->un.val;                           break;
 				case DT_SYMTAB  : section<typeof(symtab)>(&symtab, d);               break;
@@ -166,15 +338,45 @@ struct Linker::Dynamic
 				case DT_JMPREL  : section<typeof(pltrel)>(&pltrel, d);               break;
 				case DT_REL     : section<typeof(rel)>(&rel, d);                     break;
 				case DT_RELSZ   : rel_size = d->un.val;                              break;
+				case DT_RELCOUNT: rel_count = d->un.val;                             break;
 				case DT_DEBUG   : section_dt_debug(d);                               break;
 				default:
 					break;
 			}
 		}
+
+		if (hash_table)
+			symbol_count = hash_table->nchains();
+		else if (gnu_hash_table)
+			symbol_count = gnu_hash_table->nsymbols();
+	}
+
+	/**
+	 * Return the address of the first hash table of the object
+	 */
+	Elf::Addr hash_table_address() const
+	{
+		return hash_table ? (Elf::Addr)hash_table : (Elf::Addr)gnu_hash_table;
 	}
 
+	/**
+	 * Cache symbol lookups for the lifetime of the guard
+	 */
+	struct Symbol_cache_guard
+	{
+		Dynamic      &dyn;
+		Symbol_cache  cache;
+
+		Symbol_cache_guard(Dynamic &dyn)
+		: dyn(dyn), cache(dyn.dep, dyn.symbol_count) { dyn.symbol_cache = &cache; }
+
+		~Symbol_cache_guard() { dyn.symbol_cache = nullptr; }
+	};
+
 	void relocate()
 	{
+		Symbol_cache_guard guard(*this);
+
 		plt_setup();
 
 		if (pltrel_size) {
@@ -204,8 +406,23 @@ struct Linker::Dynamic
 		if (reloca)
 			Reloc_non_plt r(dep, reloca, reloca_size);
 
-		if (rel)
-			Reloc_non_plt r(dep, rel, rel_size, second_pass);
+		if (rel) {
+
+			/*
+			 * For an object loaded at its link address, e.g., a shared
+			 * library linked at a fixed base address via 'LIB_SO_ADDR',
+			 * the relative relocations would leave the addresses
+			 * unchanged. Because the linker sorts those relocations to
+			 * the front of the table, we can skip them altogether.
+			 */
+			unsigned long skip = 0;
+			if (!obj->reloc_base() && !second_pass
+			 && rel_count <= rel_size / sizeof(Elf::Rel))
+				skip = rel_count;
+
+			Reloc_non_plt r(dep, rel + skip, rel_size - skip*sizeof(Elf::Rel),
+			                second_pass);
+		}
 
 		if (bind_now)
 			Reloc_bind_now r(dep, pltrel, pltrel_size);
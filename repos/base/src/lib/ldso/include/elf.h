@@ -179,6 +179,9 @@ namespace Linker {
 		DT_PLTREL   = 20,  /* PLT relcation */
 		DT_DEBUG    = 21,  /* debug structure location */
 		DT_JMPREL   = 23,  /* address of PLT relocation */
+		DT_GNU_HASH = 0x6ffffef5, /* address of GNU symbol hash table */
+		DT_RELACOUNT = 0x6ffffff9, /* number of leading RELATIVE relocations in RELA */
+		DT_RELCOUNT  = 0x6ffffffa, /* number of leading RELATIVE relocations in REL  */
 	};
 
 
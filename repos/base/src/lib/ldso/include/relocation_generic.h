@@ -70,6 +70,10 @@ struct Linker::Reloc_plt_generic
 			throw Incompatible();
 		}
 
+		/* jump slots of objects loaded at their link address stay unchanged */
+		if (!obj->reloc_base())
+			return;
+
 		REL const *rel = (REL const *)start;
 		REL const *end = rel + (size / sizeof(REL));
 		for (; rel < end; rel++) {
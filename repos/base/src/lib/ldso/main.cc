@@ -105,7 +105,7 @@ struct Linker::Elf_object : Object, Genode::Fifo<Elf_object>::Element
 	 */
 	Elf::Sym const *symbol(unsigned sym_index) const
 	{
-		if (sym_index > dyn.hash_table->nchains())
+		if (sym_index >= dyn.symbol_count)
 			return 0;
 
 		return dyn.symtab + sym_index;
@@ -118,40 +118,69 @@ struct Linker::Elf_object : Object, Genode::Fifo<Elf_object>::Element
 		return dyn.strtab + sym->st_name;
 	}
 
+	/**
+	 * Return true if 'sym' is the definition of the symbol 'name'
+	 */
+	bool _matches(Elf::Sym const *sym, char const *name) const
+	{
+		/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+		if (sym->type() > STT_FUNC)
+			return false;
+
+		if (sym->st_value == 0)
+			return false;
+
+		/* check for symbol name */
+		char const *sym_name = symbol_name(sym);
+		return name[0] == sym_name[0] && !Genode::strcmp(name, sym_name);
+	}
+
 	/**
 	 * Lookup symbol name in this ELF
+	 *
+	 * The GNU hash table is preferred over the ELF hash table if the object
+	 * provides both.
 	 */
-	Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+	Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 	{
+		if (Gnu_hash_table const *g = dyn.gnu_hash_table) {
+
+			Elf::Sym const *result = nullptr;
+
+			g->for_each_candidate(hash.gnu, [&] (unsigned long sym_index) {
+
+				/* bad object */
+				if (sym_index >= dyn.symbol_count)
+					return true;
+
+				Elf::Sym const *sym = symbol(sym_index);
+				if (!_matches(sym, name))
+					return false;
+
+				result = sym;
+				return true;
+			});
+			return result;
+		}
+
 		Hash_table *h = dyn.hash_table;
 
-		if (!h->buckets())
+		if (!h || !h->buckets())
 			return nullptr;
 
-		unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
+		unsigned long sym_index = h->buckets()[hash.elf % h->nbuckets()];
 
 		/* traverse hash chain */
 		for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
 		{
 			/* bad object */
-			if (sym_index > h->nchains())
+			if (sym_index >= h->nchains())
 				return nullptr;
 
-			Elf::Sym const *sym      = symbol(sym_index);
-			char const     *sym_name = symbol_name(sym);
-
-			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-			if (sym->type() > STT_FUNC)
-				continue;
-
-			if (sym->st_value == 0)
-				continue;
-
-			/* check for symbol name */
-			if (name[0] != sym_name[0] || Genode::strcmp(name, sym_name))
-				continue;
+			Elf::Sym const *sym = symbol(sym_index);
 
-			return sym;
+			if (_matches(sym, name))
+				return sym;
 		}
 
 		return nullptr;
@@ -187,9 +216,7 @@ struct Linker::Elf_object : Object, Genode::Fifo<Elf_object>::Element
 		info.base = map.addr;
 		info.addr = 0;
 
-		Hash_table *h = dyn.hash_table;
-
-		for (unsigned long sym_index = 0; sym_index < h->nchains(); sym_index++)
+		for (unsigned long sym_index = 0; sym_index < dyn.symbol_count; sym_index++)
 		{
 			Elf::Sym const *sym = symbol(sym_index);
 
@@ -260,10 +287,10 @@ struct Linker::Ld : Dependency, Elf_object
 		Elf_object::setup_link_map();
 
 		/**
-		 * Use DT_HASH table address for linker, assuming that it will always be at
+		 * Use hash-table address for linker, assuming that it will always be at
 		 * the beginning of the file
 		 */
-		map.addr = trunc_page((Elf::Addr)dynamic()->hash_table);
+		map.addr = trunc_page(dynamic()->hash_table_address());
 	}
 
 	void load_phdr()
@@ -355,7 +382,7 @@ struct Linker::Binary : Root_object, Elf_object
 	{
 		Elf::Sym const *symbol = 0;
 
-		if ((symbol = Elf_object::lookup_symbol(name, Hash_table::hash(name))))
+		if ((symbol = Elf_object::lookup_symbol(name, Symbol_hash(name))))
 			return reloc_base() + symbol->st_value;
 
 		return 0;
@@ -442,7 +469,21 @@ Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const *dep,
 		return symbol;
 	}
 
-	return lookup_symbol(e->symbol_name(symbol), dep, base, undef, other);
+	/* only the default kind of lookup is cached */
+	Symbol_cache *cache = e->dyn.symbol_cache;
+	if (!cache || cache->dep != dep || undef || other)
+		return lookup_symbol(e->symbol_name(symbol), dep, base, undef, other);
+
+	Symbol_cache::Entry &entry = cache->entries[sym_index];
+	if (!entry.sym) {
+		entry.sym = lookup_symbol(e->symbol_name(symbol), dep, &entry.base);
+
+		if (verbose_lookup && dep->root)
+			PDBG("cache %s at index %u", e->symbol_name(symbol), sym_index);
+	}
+
+	*base = entry.base;
+	return entry.sym;
 }
 
 
@@ -450,7 +491,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const *dep,
                                       Elf::Addr *base, bool undef, bool other)
 {
 	Dependency const *curr        = dep->root ? dep->root->dep.head() : dep;
-	unsigned long     hash        = Hash_table::hash(name);
+	Symbol_hash const hash(name);
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
 	Elf::Sym   const *symbol      = 0;
@@ -0,0 +1,429 @@
+/*
+ * \brief  Benchmark of the allocators of the base API
+ * \author Norman Feske
+ * \date   2015-12-27
+ *
+ * Each benchmark run applies one size distribution to one allocator using
+ * one or more threads. Each thread keeps a working set of live blocks. In
+ * each step, it replaces a randomly picked block by a new block of random
+ * size. Thereby, the allocator is exercised with interleaved allocations
+ * and deallocations of varying sizes, which fragments its free space over
+ * time. Each run prints one '<result>' line with the latencies of the
+ * allocations and deallocations in cycles, the throughput, and the ratio
+ * of the backing store consumed by the allocator to the live bytes.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <base/env.h>
+#include <base/heap.h>
+#include <base/heap_cache.h>
+#include <base/slab.h>
+#include <base/allocator_avl.h>
+#include <base/synced_allocator.h>
+#include <base/thread.h>
+#include <timer_session/connection.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+namespace Alloc_bench {
+
+	enum Sizes { FIXED, SMALL, MIXED };
+
+	enum { FIXED_SIZE = 64 };
+
+	struct Samples;
+	struct Worker;
+	struct Run;
+}
+
+
+/**
+ * Latencies of one kind of operation, in cycles
+ */
+struct Alloc_bench::Samples
+{
+	uint32_t * const values;
+	unsigned   const capacity;
+	unsigned         count = 0;
+
+	Samples(unsigned capacity)
+	:
+		values((uint32_t *)env()->heap()->alloc(capacity*sizeof(uint32_t))),
+		capacity(capacity)
+	{ }
+
+	~Samples() { env()->heap()->free(values, capacity*sizeof(uint32_t)); }
+
+	void add(Trace::Timestamp start, Trace::Timestamp end)
+	{
+		if (count < capacity)
+			values[count++] = (uint32_t)(Trace::Timestamp)(end - start);
+	}
+};
+
+
+/**
+ * Thread that replaces blocks of its working set
+ */
+struct Alloc_bench::Worker : Thread<0x4000>
+{
+	struct Block { void *ptr; size_t size; };
+
+	Allocator     &alloc;
+	Sizes    const sizes;
+	unsigned const working_set;
+	unsigned const ops;
+	bool     const touch;
+
+	Block * const blocks;
+
+	Samples alloc_samples { ops };
+	Samples free_samples  { ops };
+
+	unsigned rand_state;
+	bool     failed = false;
+
+	/* number of bytes of the working set at the end of the run */
+	size_t live_bytes = 0;
+
+	Worker(Allocator &alloc, Sizes sizes, unsigned working_set,
+	       unsigned ops, bool touch, unsigned seed)
+	:
+		Thread<0x4000>("worker"), alloc(alloc), sizes(sizes),
+		working_set(working_set), ops(ops), touch(touch),
+		blocks((Block *)env()->heap()->alloc(working_set*sizeof(Block))),
+		rand_state(seed)
+	{ }
+
+	~Worker() { env()->heap()->free(blocks, working_set*sizeof(Block)); }
+
+	/**
+	 * Xorshift pseudo-random number generator
+	 */
+	unsigned _random()
+	{
+		rand_state ^= rand_state << 13;
+		rand_state ^= rand_state >> 17;
+		rand_state ^= rand_state << 5;
+		return rand_state;
+	}
+
+	/**
+	 * Return size according to the size distribution
+	 *
+	 * The mixed distribution resembles the allocations of typical
+	 * components, which are dominated by small objects with an occasional
+	 * buffer of a few pages.
+	 */
+	size_t _size()
+	{
+		unsigned const r = _random();
+
+		switch (sizes) {
+		case FIXED: return FIXED_SIZE;
+		case SMALL: return 8 + r % 249;
+		case MIXED: break;
+		}
+
+		unsigned const percent = r % 100;
+		if (percent < 80) return 16   + (r >> 8) % 241;
+		if (percent < 98) return 256  + (r >> 8) % 3841;
+		return                   4096 + (r >> 8) % 61441;
+	}
+
+	bool _alloc(Block &block, bool measure)
+	{
+		block.size = _size();
+
+		Trace::Timestamp const start = Trace::timestamp();
+		bool const ok = alloc.alloc(block.size, &block.ptr);
+		if (measure)
+			alloc_samples.add(start, Trace::timestamp());
+
+		if (!ok) {
+			PERR("allocation of %zu bytes failed", block.size);
+			block.ptr = nullptr;
+			failed = true;
+			return false;
+		}
+
+		/* touch the block like a user of the allocator would do */
+		if (touch)
+			*(char volatile *)block.ptr = 1;
+		return true;
+	}
+
+	void _free(Block &block, bool measure)
+	{
+		Trace::Timestamp const start = Trace::timestamp();
+		alloc.free(block.ptr, block.size);
+		if (measure)
+			free_samples.add(start, Trace::timestamp());
+
+		block.ptr = nullptr;
+	}
+
+	void entry()
+	{
+		for (unsigned i = 0; i < working_set; i++)
+			if (!_alloc(blocks[i], false))
+				return;
+
+		for (unsigned i = 0; i < ops; i++) {
+			Block &block = blocks[_random() % working_set];
+			_free(block, true);
+			if (!_alloc(block, true))
+				return;
+		}
+
+		for (unsigned i = 0; i < working_set; i++)
+			live_bytes += blocks[i].size;
+	}
+
+	/**
+	 * Free the working set, called after the measurement
+	 */
+	void release()
+	{
+		for (unsigned i = 0; i < working_set; i++)
+			if (blocks[i].ptr)
+				_free(blocks[i], false);
+	}
+};
+
+
+/**
+ * Benchmark run of one allocator with one size distribution
+ */
+struct Alloc_bench::Run
+{
+	char     const *name;
+	Sizes    const  sizes;
+	unsigned const  threads;
+	unsigned const  working_set;
+	unsigned const  ops;
+	bool     const  touch;  /* access blocks after allocation */
+
+	/*
+	 * Shell sort suffices for the samples of a run and does not need any
+	 * memory besides the samples.
+	 */
+	static void _sort(uint32_t *values, unsigned count)
+	{
+		for (unsigned gap = count/2; gap > 0; gap /= 2)
+			for (unsigned i = gap; i < count; i++) {
+				uint32_t const v = values[i];
+				unsigned j = i;
+				for (; j >= gap && values[j - gap] > v; j -= gap)
+					values[j] = values[j - gap];
+				values[j] = v;
+			}
+	}
+
+	struct Stats { unsigned long long mean = 0, p50 = 0, p99 = 0, max = 0; };
+
+	/**
+	 * Return statistics of the samples of all workers
+	 */
+	Stats _stats(Worker **workers, Samples Worker::*samples)
+	{
+		unsigned count = 0;
+		for (unsigned i = 0; i < threads; i++)
+			count += (workers[i]->*samples).count;
+
+		Stats stats;
+		if (!count)
+			return stats;
+
+		uint32_t *values = (uint32_t *)env()->heap()->alloc(count*sizeof(uint32_t));
+
+		unsigned n = 0;
+		for (unsigned i = 0; i < threads; i++) {
+			Samples const &s = workers[i]->*samples;
+			memcpy(values + n, s.values, s.count*sizeof(uint32_t));
+			n += s.count;
+		}
+
+		_sort(values, count);
+
+		unsigned long long sum = 0;
+		for (unsigned i = 0; i < count; i++)
+			sum += values[i];
+
+		stats.mean = sum/count;
+		stats.p50  = values[((count - 1)*50)/100];
+		stats.p99  = values[((count - 1)*99)/100];
+		stats.max  = values[count - 1];
+
+		env()->heap()->free(values, count*sizeof(uint32_t));
+		return stats;
+	}
+
+	/**
+	 * Execute run
+	 *
+	 * \param alloc     allocator to benchmark
+	 * \param consumed  functor returning the backing store consumed by
+	 *                  the allocator
+	 *
+	 * \return false if an allocation failed
+	 */
+	template <typename FN>
+	bool execute(Allocator &alloc, Timer::Session &timer, FN const &consumed)
+	{
+		Worker *workers[threads];
+		for (unsigned i = 0; i < threads; i++)
+			workers[i] = new (env()->heap())
+				Worker(alloc, sizes, working_set, ops, touch, 1 + i*7919);
+
+		unsigned long const start_ms = timer.elapsed_ms();
+
+		for (unsigned i = 0; i < threads; i++)
+			workers[i]->start();
+
+		bool   failed     = false;
+		size_t live_bytes = 0;
+		for (unsigned i = 0; i < threads; i++) {
+			workers[i]->join();
+			failed     |= workers[i]->failed;
+			live_bytes += workers[i]->live_bytes;
+		}
+
+		unsigned long const ms = max(timer.elapsed_ms() - start_ms, 1UL);
+
+		size_t const consumed_bytes = consumed();
+
+		Stats const a = _stats(workers, &Worker::alloc_samples);
+		Stats const f = _stats(workers, &Worker::free_samples);
+
+		for (unsigned i = 0; i < threads; i++) {
+			workers[i]->release();
+			destroy(env()->heap(), workers[i]);
+		}
+
+		/* each step consists of one deallocation and one allocation */
+		unsigned long long const total_ops = 2ULL*ops*threads;
+
+		static char const *size_names[] = { "fixed", "small", "mixed" };
+
+		printf("<result allocator=\"%s\" sizes=\"%s\" threads=\"%u\""
+		       " ops=\"%llu\" ms=\"%lu\" ops_per_s=\"%llu\""
+		       " alloc_mean=\"%llu\" alloc_p50=\"%llu\" alloc_p99=\"%llu\""
+		       " alloc_max=\"%llu\" free_mean=\"%llu\" free_p50=\"%llu\""
+		       " free_p99=\"%llu\" free_max=\"%llu\""
+		       " live_bytes=\"%zu\" consumed_bytes=\"%zu\"",
+		       name, size_names[sizes], threads, total_ops, ms,
+		       (total_ops*1000)/ms,
+		       a.mean, a.p50, a.p99, a.max, f.mean, f.p50, f.p99, f.max,
+		       live_bytes, consumed_bytes);
+
+		/* allocators that do not track their backing store report 0 */
+		if (consumed_bytes && live_bytes)
+			printf(" overhead_percent=\"%zu\"",
+			       consumed_bytes > live_bytes
+			       ? ((consumed_bytes - live_bytes)*100)/live_bytes : 0);
+
+		printf("/>\n");
+
+		return !failed;
+	}
+};
+
+
+int main(int, char **)
+{
+	using namespace Alloc_bench;
+
+	printf("--- alloc_bench started ---\n");
+
+	enum { THREADS = 4, WORKING_SET = 1024, OPS = 50000 };
+
+	Timer::Connection timer;
+
+	/* calibrate the cycle counter against the timer */
+	{
+		unsigned long    const ms = timer.elapsed_ms();
+		Trace::Timestamp const ts = Trace::timestamp();
+		timer.msleep(100);
+		unsigned long const elapsed_ms = max(timer.elapsed_ms() - ms, 1UL);
+
+		Trace::Timestamp const t0 = Trace::timestamp();
+		Trace::Timestamp const t1 = Trace::timestamp();
+
+		printf("<calibration cycles_per_ms=\"%llu\" timestamp_cycles=\"%llu\"/>\n",
+		       (unsigned long long)(Trace::Timestamp)(t0 - ts)/elapsed_ms,
+		       (unsigned long long)(Trace::Timestamp)(t1 - t0));
+	}
+
+	bool ok = true;
+
+	for (unsigned threads = 1; threads <= THREADS; threads += THREADS - 1) {
+
+		for (unsigned s = SMALL; s <= MIXED; s++) {
+
+			Sizes const sizes = (Sizes)s;
+
+			{
+				Heap heap(env()->ram_session(), env()->rm_session());
+				Run run { "heap", sizes, threads, WORKING_SET, OPS, true };
+				ok &= run.execute(heap, timer, [&] () { return heap.consumed(); });
+			}
+
+			{
+				Heap heap(env()->ram_session(), env()->rm_session());
+				{
+					Heap_cache cache(heap);
+					Run run { "heap_cache", sizes, threads, WORKING_SET, OPS, true };
+					ok &= run.execute(cache, timer, [&] () { return heap.consumed(); });
+				}
+			}
+
+			/* each block of the sliced heap is a dataspace of its own */
+			{
+				Sliced_heap sliced_heap(env()->ram_session(), env()->rm_session());
+				Run run { "sliced_heap", sizes, threads, WORKING_SET/16, OPS/100, true };
+				ok &= run.execute(sliced_heap, timer,
+				                  [&] () { return sliced_heap.consumed(); });
+			}
+
+			/*
+			 * The AVL allocator manages a virtual range without any memory
+			 * behind. Hence, the blocks must not be touched. The consumed
+			 * backing store is the meta data allocated from the heap.
+			 */
+			{
+				Heap heap(env()->ram_session(), env()->rm_session());
+				Synced_allocator<Allocator_avl> avl(&heap);
+				avl()->add_range(0x10000000, 0x40000000);
+
+				Run run { "allocator_avl", sizes, threads, WORKING_SET, OPS, false };
+				ok &= run.execute(avl, timer, [&] () { return heap.consumed(); });
+			}
+		}
+
+		/* the slab allocator hands out blocks of one size only */
+		{
+			Heap heap(env()->ram_session(), env()->rm_session());
+			Synced_allocator<Slab> slab(FIXED_SIZE, 4096, nullptr, &heap);
+			Run run { "slab", FIXED, threads, WORKING_SET, OPS, true };
+			ok &= run.execute(slab, timer, [&] () { return heap.consumed(); });
+		}
+	}
+
+	if (!ok) {
+		PERR("benchmark failed");
+		return -1;
+	}
+
+	printf("--- alloc_bench finished ---\n");
+	return 0;
+}
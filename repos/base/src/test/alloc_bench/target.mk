@@ -0,0 +1,3 @@
+TARGET = test-alloc_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,112 @@
+/*
+ * \brief  Test for the per-thread caching heap front end
+ * \author Norman Feske
+ * \date   2015-11-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <base/env.h>
+#include <base/heap.h>
+#include <base/heap_cache.h>
+#include <base/thread.h>
+
+using namespace Genode;
+
+
+enum { NUM_THREADS = 4, NUM_BLOCKS = 256, ROUNDS = 64 };
+
+
+/**
+ * Thread that repeatedly allocates and frees blocks of various sizes
+ *
+ * Each block is filled with a thread-specific pattern that is checked
+ * before the block gets freed. Thereby, blocks handed out twice are
+ * detected.
+ */
+struct Worker : Thread<0x4000>
+{
+	Allocator &alloc;
+	unsigned   id;
+	bool       failed = false;
+
+	struct { unsigned char *ptr; size_t size; } blocks[NUM_BLOCKS];
+
+	Worker(Allocator &alloc, unsigned id)
+	: Thread<0x4000>("worker"), alloc(alloc), id(id) { }
+
+	unsigned char pattern(unsigned i) const { return (id << 5) + i; }
+
+	void entry()
+	{
+		for (unsigned r = 0; r < ROUNDS; r++) {
+
+			for (unsigned i = 0; i < NUM_BLOCKS; i++) {
+				blocks[i].size = 1 + (i*37 + r*11) % 1024;
+				if (!alloc.alloc(blocks[i].size, (void **)&blocks[i].ptr)) {
+					PERR("allocation failed");
+					failed = true;
+					return;
+				}
+				memset(blocks[i].ptr, pattern(i), blocks[i].size);
+			}
+
+			for (unsigned i = 0; i < NUM_BLOCKS; i++) {
+				for (size_t j = 0; j < blocks[i].size; j++)
+					if (blocks[i].ptr[j] != pattern(i)) {
+						PERR("block %p corrupted", blocks[i].ptr);
+						failed = true;
+					}
+				alloc.free(blocks[i].ptr, blocks[i].size);
+			}
+		}
+	}
+};
+
+
+int main(int, char **)
+{
+	printf("--- heap-cache test ---\n");
+
+	Heap heap(env()->ram_session(), env()->rm_session());
+
+	size_t const consumed_before = heap.consumed();
+
+	bool failed = false;
+	{
+		Heap_cache cache(heap);
+
+		Worker *workers[NUM_THREADS];
+		for (unsigned i = 0; i < NUM_THREADS; i++) {
+			workers[i] = new (env()->heap()) Worker(cache, i);
+			workers[i]->start();
+		}
+
+		for (unsigned i = 0; i < NUM_THREADS; i++) {
+			workers[i]->join();
+			failed |= workers[i]->failed;
+			destroy(env()->heap(), workers[i]);
+		}
+
+		cache.flush();
+	}
+
+	if (heap.consumed() != consumed_before) {
+		PERR("%zd bytes not returned to the heap",
+		     heap.consumed() - consumed_before);
+		failed = true;
+	}
+
+	if (failed)
+		return -1;
+
+	printf("--- finished heap-cache test ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-heap_cache
+SRC_CC = main.cc
+LIBS   = base
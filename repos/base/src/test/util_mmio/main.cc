@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -444,6 +444,53 @@ int main()
 		error(__LINE__);
 	}
 
+	/* write several bitfields of a register at once */
+	zero_mem(mmio_mem, sizeof(mmio_mem));
+	mmio_mem[4] = 0b11110000;
+	mmio.write<Test_mmio::Reg::Bit_1,
+	           Test_mmio::Reg::Area,
+	           Test_mmio::Reg::Bit_2>(1, 0b1101, 0);
+	static uint8_t mmio_cmpr_20[MMIO_SIZE] = {0,0,0,0,0b11101011,0,0,0};
+	if (compare_mem(mmio_mem, mmio_cmpr_20, sizeof(mmio_mem)) ||
+	    mmio.read<Test_mmio::Reg::Area>() != 0b101)
+	{ error(__LINE__); }
+
+	/* write several bitfields of a register with 'STRICT_WRITE' set */
+	zero_mem(mmio_mem, sizeof(mmio_mem));
+	mmio_mem[1] = 0xff;
+	mmio_mem[4] = 0xaa;
+	mmio.write<Test_mmio::Strict_reg::A, Test_mmio::Strict_reg::B>(0xff, 0xff);
+	static uint8_t mmio_cmpr_21[MMIO_SIZE] = {0b00011000,0,0,0b11000000,0b10101010,0,0,0};
+	if (compare_mem(mmio_mem, mmio_cmpr_21, sizeof(mmio_mem))) {
+		error(__LINE__); }
+
+	/* write successive register array items at once */
+	zero_mem(mmio_mem, sizeof(mmio_mem));
+	mmio_mem[7] = 0xff;
+	mmio.write<Test_mmio::Array>(0x5, 1, 20);
+	static uint8_t mmio_cmpr_22[MMIO_SIZE] = {0,0,0x50,0x55,0x55,0x55,0x55,0xff};
+	if (compare_mem(mmio_mem, mmio_cmpr_22, sizeof(mmio_mem)) ||
+	    mmio.read<Test_mmio::Array>(0) != 0 ||
+	    mmio.read<Test_mmio::Array>(9) != 0x5)
+	{ error(__LINE__); }
+
+	/* write bitfield of successive register array items at once */
+	zero_mem(mmio_mem, sizeof(mmio_mem));
+	mmio_mem[3] = 0x90;
+	mmio.write<Test_mmio::Array::B>(0x3, 2, 3);
+	static uint8_t mmio_cmpr_23[MMIO_SIZE] = {0,0,0,0xf6,0x06,0,0,0};
+	if (compare_mem(mmio_mem, mmio_cmpr_23, sizeof(mmio_mem))) {
+		error(__LINE__); }
+
+	/* write successive register array items with 'STRICT_WRITE' set */
+	zero_mem(mmio_mem, sizeof(mmio_mem));
+	mmio_mem[0] = 0xff;
+	mmio_mem[2] = 0xaa;
+	mmio.write<Test_mmio::Strict_array>(0xa, 1, 2);
+	static uint8_t mmio_cmpr_24[MMIO_SIZE] = {0xa0,0x0a,0xaa,0,0,0,0,0};
+	if (compare_mem(mmio_mem, mmio_cmpr_24, sizeof(mmio_mem))) {
+		error(__LINE__); }
+
 	/**********************************
 	 ** Test access widths of 64 bit **
 	 **********************************/
@@ -477,6 +524,13 @@ int main()
 		if (mmio.read<Reg::Bits_3>() != BITS_3) { error(__LINE__); }
 		if (compare_mem(mmio_mem, cmp_mem, MMIO_SIZE)) { error(__LINE__); }
 
+		/* several bitfields at once */
+		zero_mem(mmio_mem, MMIO_SIZE);
+		mmio.write<Reg::Bits_0, Reg::Bits_1, Reg::Bits_2, Reg::Bits_3>(
+			BITS_0 | BITS_TRASH, BITS_1 | BITS_TRASH,
+			BITS_2 | BITS_TRASH, BITS_3 | BITS_TRASH);
+		if (compare_mem(mmio_mem, cmp_mem, MMIO_SIZE)) { error(__LINE__); }
+
 		/* bitsets */
 		typedef Test_mmio::Bitset_64 Bitset;
 		enum { BITSET = 0x4abcdef056789123 };
@@ -9,7 +9,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -48,6 +48,14 @@ namespace Audio {
 
 	int play(short *data, Genode::size_t size);
 
+	/**
+	 * Play frames of the left and right channel
+	 *
+	 * The samples are converted to the format of the device while they
+	 * are copied into its ring buffer.
+	 */
+	int play(float const *left, float const *right, Genode::size_t frames);
+
 	int record(short *data, Genode::size_t size);
 }
 
@@ -123,16 +123,9 @@ class Audio_out::Out
 			Packet *p_right = right()->get(rpos);
 
 			if (p_left->valid() && p_right->valid()) {
-				/* convert float to S16LE */
-				static short data[Audio_out::PERIOD * Audio_out::MAX_CHANNELS];
-
-				for (int i = 0; i < Audio_out::PERIOD * Audio_out::MAX_CHANNELS; i += 2) {
-					data[i] = p_left->content()[i / 2] * 32767;
-					data[i + 1] = p_right->content()[i / 2] * 32767;
-				}
-
-				/* send to driver */
-				if (int err = Audio::play(data, sizeof(data)))
+				/* send to driver, which converts the frames to S16LE */
+				if (int err = Audio::play(p_left->content(), p_right->content(),
+				                          Audio_out::PERIOD))
 					PWRN("Error %d during playback", err);
 
 				p_left->invalidate();
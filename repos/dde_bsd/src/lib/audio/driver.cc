@@ -497,13 +497,100 @@ void Audio::record_sigh(Genode::Signal_context_capability sigh) {
 
 int Audio::play(short *data, Genode::size_t size)
 {
-	struct uio uio = { 0, size, UIO_READ, data, size };
+	struct uio uio = { 0, size, UIO_READ, data, size, nullptr };
+	return audiowrite(adev, &uio, IO_NDELAY);
+}
+
+
+/**
+ * Frames of the left and right channel, which are played back
+ */
+struct Play_frames { float const *left, *right; };
+
+
+/**
+ * Interleave left and right samples and convert them to S16LE
+ */
+static void convert_to_s16le(short *dst, float const *left, float const *right,
+                             Genode::size_t frames)
+{
+	Genode::size_t i = 0;
+
+#ifdef __SSE2__
+	/*
+	 * Convert four frames at once, the conversion to 16 bit saturates.
+	 * The compiler built-ins are used directly because the SSE headers of
+	 * the compiler depend on the C library.
+	 */
+	typedef float Float4 __attribute__((vector_size(16)));
+	typedef int   Int4   __attribute__((vector_size(16)));
+	typedef short Short8 __attribute__((vector_size(16), aligned(sizeof(short))));
+
+	Float4 const scale = { 32767, 32767, 32767, 32767 };
+
+	for (; i + 4 <= frames; i += 4) {
+		Float4 const l = __builtin_ia32_loadups(left  + i) * scale;
+		Float4 const r = __builtin_ia32_loadups(right + i) * scale;
+
+		Int4 const lo = __builtin_ia32_cvttps2dq(__builtin_ia32_unpcklps(l, r));
+		Int4 const hi = __builtin_ia32_cvttps2dq(__builtin_ia32_unpckhps(l, r));
+
+		*(Short8 *)(dst + 2*i) = __builtin_ia32_packssdw128(lo, hi);
+	}
+#endif
+
+	for (; i < frames; i++) {
+		dst[2*i]     = left[i]  * 32767;
+		dst[2*i + 1] = right[i] * 32767;
+	}
+}
+
+
+/**
+ * Copy function of the uio, which converts the frames directly into the
+ * ring buffer of the audio device
+ *
+ * The offset and length are given in bytes of the S16LE stream. The ring
+ * buffer may split the stream at arbitrary sample boundaries.
+ */
+static void copy_in_frames(void *dst, struct uio *uio, size_t len)
+{
+	Play_frames const &f = *(Play_frames const *)uio->buf;
+
+	short          *d      = (short *)dst;
+	Genode::size_t  sample = uio->uio_offset / sizeof(short);
+	Genode::size_t  count  = len / sizeof(short);
+
+	/* right sample of a frame split by the previous copy */
+	if (count && (sample & 1)) {
+		*d++ = f.right[sample / 2] * 32767;
+		sample++; count--;
+	}
+
+	Genode::size_t const frames = count / 2;
+	convert_to_s16le(d, f.left + sample / 2, f.right + sample / 2, frames);
+	d      += 2*frames;
+	sample += 2*frames;
+
+	/* left sample of a frame split by this copy */
+	if (count & 1)
+		*d = f.left[sample / 2] * 32767;
+}
+
+
+int Audio::play(float const *left, float const *right, Genode::size_t frames)
+{
+	Play_frames data = { left, right };
+
+	Genode::size_t const size = frames * Audio_out::MAX_CHANNELS * sizeof(short);
+
+	struct uio uio = { 0, size, UIO_READ, &data, size, copy_in_frames };
 	return audiowrite(adev, &uio, IO_NDELAY);
 }
 
 
 int Audio::record(short *data, Genode::size_t size)
 {
-	struct uio uio = { 0, size, UIO_WRITE, data, size };
+	struct uio uio = { 0, size, UIO_WRITE, data, size, nullptr };
 	return audioread(adev, &uio, IO_NDELAY);
 }
@@ -180,6 +180,12 @@ struct uio
 	/* emul specific fields */
 	void *buf;
 	size_t buflen;
+
+	/*
+	 * Optional function for copying 'len' bytes at 'uio_offset' from 'buf'
+	 * to 'dst', used instead of 'memcpy' for UIO_READ
+	 */
+	void (*copy_in)(void *dst, struct uio *uio, size_t len);
 };
 
 
@@ -396,7 +396,10 @@ extern "C" int uiomovei(void *buf, int n, struct uio *uio)
 		break;
 	}
 
-	Genode::memcpy(dst, src, len);
+	if (uio->uio_rw == UIO_READ && uio->copy_in)
+		uio->copy_in(dst, uio, len);
+	else
+		Genode::memcpy(dst, src, len);
 
 	uio->uio_resid  -= len;
 	uio->uio_offset += len;
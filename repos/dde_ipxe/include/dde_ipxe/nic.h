@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2010-2013 Genode Labs GmbH
+ * Copyright (C) 2010-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -33,17 +33,27 @@ typedef void (*dde_ipxe_nic_link_cb)(void);
  */
 typedef void (*dde_ipxe_nic_rx_cb)(unsigned if_index, const char *packet, unsigned packet_len);
 
+/**
+ * Reception-done callback
+ *
+ * Called after a batch of packets was passed to the packet-reception
+ * callback.
+ */
+typedef void (*dde_ipxe_nic_rx_done_cb)(void);
+
 /**
  * Register packet reception callback
  *
- * \param   rx_cb    packet-reception callback function
- * \param   link_cb  link-state change callback function
+ * \param   rx_cb       packet-reception callback function
+ * \param   rx_done_cb  reception-done callback function
+ * \param   link_cb     link-state change callback function
  *
  * This registers a function pointer as rx callback. Incoming ethernet packets
  * are passed to this function.
  */
-extern void dde_ipxe_nic_register_callbacks(dde_ipxe_nic_rx_cb rx_cb,
-                                            dde_ipxe_nic_link_cb link_cb);
+extern void dde_ipxe_nic_register_callbacks(dde_ipxe_nic_rx_cb      rx_cb,
+                                            dde_ipxe_nic_rx_done_cb rx_done_cb,
+                                            dde_ipxe_nic_link_cb    link_cb);
 
 /**
  * Clear callbacks
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -34,6 +34,15 @@ class Ipxe_session_component  : public Nic::Session_component
 
 		Nic::Mac_address _mac_addr;
 
+		/*
+		 * Received packets are submitted to the client in batches, once
+		 * per invocation of the driver's interrupt handler
+		 */
+		enum { RX_BATCH = 64 };
+
+		Nic::Packet_descriptor _rx_batch[RX_BATCH];
+		unsigned               _rx_batch_len = 0;
+
 		static void _rx_callback(unsigned    if_index,
 		                         const char *packet,
 		                         unsigned    packet_len)
@@ -42,6 +51,12 @@ class Ipxe_session_component  : public Nic::Session_component
 				instance->_receive(packet, packet_len);
 		}
 
+		static void _rx_done_callback()
+		{
+			if (instance)
+				instance->_receive_done();
+		}
+
 		static void _link_callback()
 		{
 			if (instance)
@@ -58,7 +73,7 @@ class Ipxe_session_component  : public Nic::Session_component
 			if (!_tx.sink()->packet_avail())
 				return false;
 
-			Packet_descriptor packet = _tx.sink()->get_packet();
+			Nic::Packet_descriptor packet = _tx.sink()->get_packet();
 			if (!packet.valid()) {
 				PWRN("Invalid tx packet");
 				return true;
@@ -73,20 +88,41 @@ class Ipxe_session_component  : public Nic::Session_component
 
 		void _receive(const char *packet, unsigned packet_len)
 		{
-			_handle_packet_stream();
+			/* free RX buffer space of packets processed by the client */
+			while (_rx.source()->ack_avail())
+				_rx.source()->release_packet(_rx.source()->get_acked_packet());
+
+			if (_rx_batch_len == RX_BATCH)
+				_submit_rx_batch();
 
-			if (!_rx.source()->ready_to_submit())
+			/* drop packet if the submit queue cannot take it */
+			if (_rx_batch_len >= _rx.source()->submit_slots_free())
 				return;
 
 			try {
 				Nic::Packet_descriptor p = _rx.source()->alloc_packet(packet_len);
 				Genode::memcpy(_rx.source()->packet_content(p), packet, packet_len);
-				_rx.source()->submit_packet(p);
+				_rx_batch[_rx_batch_len++] = p;
 			} catch (...) {
 				PDBG("failed to process received packet");
 			}
 		}
 
+		void _submit_rx_batch()
+		{
+			if (!_rx_batch_len)
+				return;
+
+			_rx.source()->submit_packets(_rx_batch, _rx_batch_len);
+			_rx_batch_len = 0;
+		}
+
+		void _receive_done()
+		{
+			_submit_rx_batch();
+			_handle_packet_stream();
+		}
+
 		void _handle_packet_stream() override
 		{
 			while (_rx.source()->ack_avail())
@@ -107,7 +143,8 @@ class Ipxe_session_component  : public Nic::Session_component
 			instance = this;
 
 			PINF("--- init callbacks");
-			dde_ipxe_nic_register_callbacks(_rx_callback, _link_callback);
+			dde_ipxe_nic_register_callbacks(_rx_callback, _rx_done_callback,
+			                                _link_callback);
 
 			dde_ipxe_nic_get_mac_addr(1, _mac_addr.addr);
 			PINF("--- get MAC address %02x:%02x:%02x:%02x:%02x:%02x",
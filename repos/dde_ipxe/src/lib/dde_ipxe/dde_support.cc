@@ -294,6 +294,10 @@ struct Irq_handler
 
 	typedef void (*irq_handler)(void*);
 
+	/* used for invoking the handler again without an interrupt */
+	Genode::Signal_rpc_member<Irq_handler>  repeat_dispatcher;
+	Genode::Signal_transmitter              repeat_transmitter;
+
 	irq_handler  handler;
 	void        *priv;
 
@@ -303,10 +307,14 @@ struct Irq_handler
 		irq.ack_irq();
 	}
 
+	void handle_repeat(unsigned) { handler(priv); }
+
 	Irq_handler(Server::Entrypoint &ep, Genode::Irq_session_capability cap,
 	            irq_handler handler, void *priv)
 	:
 		ep(ep), irq(cap), dispatcher(ep, *this, &Irq_handler::handle),
+		repeat_dispatcher(ep, *this, &Irq_handler::handle_repeat),
+		repeat_transmitter(repeat_dispatcher),
 		handler(handler), priv(priv)
 	{
 		irq.sigh(dispatcher);
@@ -335,6 +343,13 @@ extern "C" int dde_interrupt_attach(void(*handler)(void *), void *priv)
 }
 
 
+extern "C" void dde_interrupt_repeat(void)
+{
+	if (_irq_handler)
+		_irq_handler->repeat_transmitter.submit();
+}
+
+
 /***************************************************
  ** Support for aligned and DMA memory allocation **
  ***************************************************/
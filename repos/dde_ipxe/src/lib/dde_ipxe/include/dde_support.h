@@ -73,6 +73,9 @@ void dde_lock_leave(void);
 
 int dde_interrupt_attach(void (*handler)(void *), void *priv);
 
+/* invoke interrupt handler again without an interrupt, e.g., for polling */
+void dde_interrupt_repeat(void);
+
 
 /******************
  ** PCI handling **
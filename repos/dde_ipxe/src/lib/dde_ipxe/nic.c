@@ -16,6 +16,8 @@
 #include <ipxe/netdevice.h>
 #include <ipxe/pci.h>
 #include <ipxe/iobuf.h>
+#include <ipxe/io.h>
+#include <drivers/net/intel.h>
 
 #include <dde_ipxe/nic.h>
 /* local includes */
@@ -30,8 +32,9 @@ static struct net_device *net_dev;
 /**
  * Callback function pointers
  */
-static dde_ipxe_nic_link_cb link_callback;
-static dde_ipxe_nic_rx_cb   rx_callback;
+static dde_ipxe_nic_link_cb    link_callback;
+static dde_ipxe_nic_rx_cb      rx_callback;
+static dde_ipxe_nic_rx_done_cb rx_done_callback;
 
 /**
  * Known iPXE driver structures (located in the driver binaries)
@@ -176,8 +179,24 @@ static unsigned scan_pci(void)
 }
 
 
+enum {
+	/* maximum number of packets received per invocation of the IRQ handler */
+	RX_BUDGET = 64,
+
+	/* interrupt throttling of Intel NICs, max. 8000 interrupts per second */
+	INTEL_ITR_REG      = 0x000c4,
+	INTEL_ITR_INTERVAL = 1000000000 / (8000 * 256),  /* in 256 ns units */
+};
+
+
 /**
  * IRQ handler registered at DDE
+ *
+ * Interrupts of the device are disabled while received packets are
+ * pending. At most 'RX_BUDGET' packets are processed per invocation. If
+ * packets are left, the handler is invoked again after other pending
+ * requests, e.g., transmit requests of the client, were handled. Device
+ * interrupts are enabled not before the RX ring is drained.
  */
 static void irq_handler(void *p)
 {
@@ -186,20 +205,47 @@ static void irq_handler(void *p)
 	/* check for the link-state to change on each interrupt */
 	int link_ok = netdev_link_ok(net_dev);
 
+	netdev_irq(net_dev, 0);
+
 	/* poll the device for packets and also link-state changes */
 	netdev_poll(net_dev);
 
-	struct io_buffer *iobuf;
-	while ((iobuf = netdev_rx_dequeue(net_dev))) {
+	unsigned received = 0;
+	int      drained  = 0;
+
+	while (received < RX_BUDGET) {
+
+		struct io_buffer *iobuf = netdev_rx_dequeue(net_dev);
+		if (!iobuf) {
+
+			/* look for packets received meanwhile */
+			netdev_poll(net_dev);
+			iobuf = netdev_rx_dequeue(net_dev);
+			if (!iobuf) {
+				drained = 1;
+				break;
+			}
+		}
+
 		dde_lock_leave();
 		if (rx_callback)
 			rx_callback(1, iobuf->data, iob_len(iobuf));
 		dde_lock_enter();
 		free_iob(iobuf);
+		received++;
 	}
 
+	if (drained)
+		netdev_irq(net_dev, 1);
+
 	dde_lock_leave();
 
+	if (received && rx_done_callback)
+		rx_done_callback();
+
+	if (!drained)
+		dde_interrupt_repeat();
+
 	if (link_ok != netdev_link_ok(net_dev))
 		/* report link-state changes */
 		if (link_callback)
@@ -207,17 +253,31 @@ static void irq_handler(void *p)
 }
 
 
+/**
+ * Configure interrupt moderation of the device
+ */
+static void init_irq_moderation(struct pci_device *pci_dev)
+{
+	if (pci_dev->driver == &intel_driver) {
+		struct intel_nic *intel = netdev_priv(net_dev);
+		writel(INTEL_ITR_INTERVAL, intel->regs + INTEL_ITR_REG);
+	}
+}
+
+
 /************************
  ** API implementation **
  ************************/
 
-void dde_ipxe_nic_register_callbacks(dde_ipxe_nic_rx_cb rx_cb,
-                                     dde_ipxe_nic_link_cb link_cb)
+void dde_ipxe_nic_register_callbacks(dde_ipxe_nic_rx_cb      rx_cb,
+                                     dde_ipxe_nic_rx_done_cb rx_done_cb,
+                                     dde_ipxe_nic_link_cb    link_cb)
 {
 	dde_lock_enter();
 
-	rx_callback   = rx_cb;
-	link_callback = link_cb;
+	rx_callback      = rx_cb;
+	rx_done_callback = rx_done_cb;
+	link_callback    = link_cb;
 
 	dde_lock_leave();
 }
@@ -227,8 +287,9 @@ void dde_ipxe_nic_unregister_callbacks(void)
 {
 	dde_lock_enter();
 
-	rx_callback   = (dde_ipxe_nic_rx_cb)0;
-	link_callback = (dde_ipxe_nic_link_cb)0;
+	rx_callback      = (dde_ipxe_nic_rx_cb)0;
+	rx_done_callback = (dde_ipxe_nic_rx_done_cb)0;
+	link_callback    = (dde_ipxe_nic_link_cb)0;
 
 	dde_lock_leave();
 }
@@ -321,6 +382,7 @@ int dde_ipxe_nic_init(void *ep)
 		LOG("attaching to IRQ %02x failed", net_dev->dev->desc.irq);
 		return 0;
 	}
+	init_irq_moderation(container_of(net_dev->dev, struct pci_device, dev));
 	netdev_irq(net_dev, 1);
 
 	dde_lock_leave();
@@ -7,7 +7,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -76,6 +76,32 @@ class Lx::Pci_dev : public pci_dev, public Lx::List<Pci_dev>::Element
 			}
 		}
 
+		/**
+		 * Snapshot of the config-space header of the device
+		 *
+		 * The header is inspected register by register during the
+		 * construction of the 'pci_dev'. Reading it in blocks avoids an RPC
+		 * to the platform driver per register.
+		 */
+		struct Config_header
+		{
+			typedef Platform::Device::Config_block Block;
+
+			enum { NUM_BLOCKS = 256 / Block::SIZE };
+
+			Block blocks[NUM_BLOCKS];
+
+			Config_header(Platform::Device_client &client)
+			{
+				for (unsigned i = 0; i < NUM_BLOCKS; i++)
+					blocks[i] = client.config_read_block(i*Block::SIZE);
+			}
+
+			unsigned read(unsigned char address,
+			              Platform::Device::Access_size size) const {
+				return blocks[address / Block::SIZE].value(address, size); }
+		};
+
 	public:
 
 		/**
@@ -89,10 +115,12 @@ class Lx::Pci_dev : public pci_dev, public Lx::List<Pci_dev>::Element
 
 			Genode::memset(static_cast<pci_dev *>(this), 0, sizeof(pci_dev));
 
+			Config_header const header(_client);
+
 			this->vendor   = _client.vendor_id();
 			this->device   = _client.device_id();
 			this->class_   = _client.class_code();
-			this->revision = _client.config_read(REV, Device::ACCESS_8BIT);
+			this->revision = header.read(REV, Device::ACCESS_8BIT);
 
 			/* dummy dma mask used to mark device as DMA capable */
 			this->dev._dma_mask_buf = ~(u64)0;
@@ -100,7 +128,7 @@ class Lx::Pci_dev : public pci_dev, public Lx::List<Pci_dev>::Element
 			this->dev.coherent_dma_mask = ~0;
 
 			/* read interrupt line */
-			this->irq = _client.config_read(IRQ, Device::ACCESS_8BIT);
+			this->irq = header.read(IRQ, Device::ACCESS_8BIT);
 
 			/* hide ourselfs in  bus structure */
 			this->bus = (struct pci_bus *)this;
@@ -139,7 +167,7 @@ class Lx::Pci_dev : public pci_dev, public Lx::List<Pci_dev>::Element
 			}
 
 			/* enable bus master and io bits */
-			uint16_t cmd = _client.config_read(CMD, Device::ACCESS_16BIT);
+			uint16_t cmd = header.read(CMD, Device::ACCESS_16BIT);
 			cmd |= io ? 0x1 : 0;
 
 			/* enable bus master */
@@ -148,21 +176,21 @@ class Lx::Pci_dev : public pci_dev, public Lx::List<Pci_dev>::Element
 
 			/* get pci express capability */
 			this->pcie_cap = 0;
-			uint16_t status = _client.config_read(STATUS, Device::ACCESS_32BIT) >> 16;
+			uint16_t status = header.read(STATUS, Device::ACCESS_32BIT) >> 16;
 			if (status & CAP_LIST) {
-				uint8_t offset = _client.config_read(CAP, Device::ACCESS_8BIT);
+				uint8_t offset = header.read(CAP, Device::ACCESS_8BIT);
 				while (offset != 0x00) {
-					uint8_t value = _client.config_read(offset, Device::ACCESS_8BIT);
+					uint8_t value = header.read(offset, Device::ACCESS_8BIT);
 
 					if (value == CAP_EXP)
 						this->pcie_cap = offset;
 
-					offset = _client.config_read(offset + 1, Device::ACCESS_8BIT);
+					offset = header.read(offset + 1, Device::ACCESS_8BIT);
 				}
 			}
 
 			if (this->pcie_cap) {
-				uint16_t reg_val = _client.config_read(this->pcie_cap, Device::ACCESS_16BIT);
+				uint16_t reg_val = header.read(this->pcie_cap, Device::ACCESS_16BIT);
 				this->pcie_flags_reg = reg_val;
 			}
 		}
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -20,6 +20,12 @@
 
 static struct net_device *_dev;
 
+/*
+ * NAPI context used solely for generic receive offload, received segments of
+ * a TCP flow are merged into one skb before they enter the IP layer
+ */
+static struct napi_struct _napi;
+
 static int driver_net_open(struct net_device *dev)
 {
 	printk("%s called\n",__func__);
@@ -52,34 +58,104 @@ int driver_net_xmit(struct sk_buff *skb, struct net_device *dev)
 }
 
 
-void net_driver_rx(void *addr, unsigned long size)
+/*
+ * Packets up to 'RX_COPYBREAK' bytes are copied into the socket buffer. Of
+ * larger packets, only the first 'RX_HEADER_LEN' bytes, which contain the
+ * protocol headers, are copied. The payload is referenced as page fragment
+ * of the socket buffer directly within the RX buffer of the NIC session
+ * until the IP stack releases it, e.g., after it got copied to the user.
+ */
+enum { RX_COPYBREAK = 256, RX_HEADER_LEN = 128 };
+
+
+static void rx_page_release(struct page *page)
+{
+	net_rx_release((void *)page->private);
+	kfree(page);
+}
+
+
+static struct sk_buff *rx_skb_referenced(void *addr, unsigned long size,
+                                         void *packet)
+{
+	struct page    *page;
+	struct sk_buff *skb = dev_alloc_skb(RX_HEADER_LEN + 4);
+	if (!skb)
+		return 0;
+
+	page = (struct page *)kzalloc(sizeof(struct page), 0);
+	if (!page) {
+		dev_kfree_skb(skb);
+		return 0;
+	}
+
+	page->addr    = addr;
+	page->private = (unsigned long)packet;
+	page->release = rx_page_release;
+	atomic_set(&page->_count, 1);
+
+	memcpy(skb_put(skb, RX_HEADER_LEN), addr, RX_HEADER_LEN);
+	skb_add_rx_frag(skb, 0, page, RX_HEADER_LEN, size - RX_HEADER_LEN,
+	                size - RX_HEADER_LEN);
+	return skb;
+}
+
+
+int net_driver_rx(void *addr, unsigned long size, void *packet,
+                  int csum_verified)
 {
 	struct net_device_stats *stats;
+	struct sk_buff          *skb        = 0;
+	int                      referenced = 0;
 
 	if (!_dev)
-		return;
+		return 0;
 
 	stats = (struct net_device_stats*) netdev_priv(_dev);
 
-	/* allocate skb */
-	struct sk_buff *skb = dev_alloc_skb(size + 4);
-	if (!skb) {
-		printk(KERN_NOTICE "genode_net_rx: low on mem - packet dropped!\n");
-		stats->rx_dropped++;
-		return;
+	if (packet && size > RX_COPYBREAK) {
+		skb        = rx_skb_referenced(addr, size, packet);
+		referenced = !!skb;
 	}
 
-	/* copy packet */
-	memcpy(skb_put(skb, size), addr, size);
+	if (!skb) {
+
+		/* allocate skb */
+		skb = dev_alloc_skb(size + 4);
+		if (!skb) {
+			printk(KERN_NOTICE "genode_net_rx: low on mem - packet dropped!\n");
+			stats->rx_dropped++;
+			return 0;
+		}
+
+		/* copy packet */
+		memcpy(skb_put(skb, size), addr, size);
+	}
 
 	skb->dev       = _dev;
 	skb->protocol  = eth_type_trans(skb, _dev);
-	skb->ip_summed = CHECKSUM_NONE;
-
-	netif_receive_skb(skb);
+	skb->ip_summed = csum_verified ? CHECKSUM_UNNECESSARY : CHECKSUM_NONE;
 
 	stats->rx_packets++;
 	stats->rx_bytes += size;
+
+	napi_gro_receive(&_napi, skb);
+
+	return referenced;
+}
+
+
+void net_driver_rx_flush(void)
+{
+	/* hand coalesced segments to the IP layer */
+	napi_gro_flush(&_napi, false);
+}
+
+
+static int driver_net_poll(struct napi_struct *napi, int budget)
+{
+	/* packets are pushed by the nic-session handler, there's nothing to poll */
+	return 0;
 }
 
 
@@ -102,6 +178,15 @@ static int driver_init(void)
 
 	dev->netdev_ops = &driver_net_ops;
 
+	/*
+	 * Segmentation and receive offload are done in software, software GSO
+	 * requires scatter-gather to be announced by the device
+	 */
+	dev->hw_features |= NETIF_F_SG;
+	dev->features    |= NETIF_F_SG;
+
+	netif_napi_add(dev, &_napi, driver_net_poll, 64);
+
 	/* set MAC */
 	net_mac(dev->dev_addr, ETH_ALEN);
 
@@ -58,6 +58,7 @@ DUMMY_RET(0, net_hash_mix)
 DUMMY_RET(0, netdev_kobject_init)
 DUMMY_RET(0, netdev_register_kobject)
 DUMMY_RET(0, netpoll_rx)
+DUMMY_RET(0, netpoll_rx_on)
 DUMMY_RET(0, nla_put)
 DUMMY_RET(1, ns_capable)
 DUMMY_RET(1, num_possible_cpus)
@@ -228,7 +229,6 @@ DUMMY(-1, get_net_ns_by_pid)
 DUMMY(-1, getnstimeofday)
 DUMMY(-1, get_nulls_value)
 DUMMY(-1, get_options)
-DUMMY(-1, get_page)
 DUMMY(-1, gfp_pfmemalloc_allowed)
 DUMMY(-1, gid_lte)
 DUMMY(-1, hash32_ptr)
@@ -335,7 +335,6 @@ DUMMY(-1, net_namespace_list)
 DUMMY(-1, netpoll_poll_lock)
 DUMMY(-1, netpoll_poll_unlock)
 DUMMY(-1, netpoll_rx_enable)
-DUMMY(-1, netpoll_rx_on)
 DUMMY(-1, next_pseudo_random32)
 DUMMY(-1, nf_bridge_pad)
 DUMMY(-1, nf_ct_attach)
@@ -924,6 +924,9 @@ struct page
 	atomic_t _count;
 	void     *addr;
 	unsigned long private;
+
+	/* called on the last 'put_page' of pages not obtained by 'alloc_pages' */
+	void    (*release)(struct page *);
 } __attribute((packed));
 
 
@@ -19,7 +19,23 @@ extern "C" {
 
 void net_mac(void* mac, unsigned long size);
 int  net_tx(void* addr, unsigned long len);
-void net_driver_rx(void *addr, unsigned long size);
+
+/**
+ * Hand received packet to the driver
+ *
+ * \param packet         opaque handle of the packet, or 0 if the packet
+ *                       content must not be referenced after returning
+ * \param csum_verified  non-zero if the TCP or UDP checksum of the packet
+ *                       was verified by the network adapter
+ *
+ * \return 1 if the packet content is referenced by the IP stack, the
+ *         packet must then not be acknowledged before 'net_rx_release'
+ *         is called for 'packet'
+ */
+int  net_driver_rx(void *addr, unsigned long size, void *packet,
+                   int csum_verified);
+void net_rx_release(void *packet);
+void net_driver_rx_flush(void);
 
 #ifdef __cplusplus
 }
@@ -13,9 +13,90 @@ enum {
 
 namespace Net {
 	class Nic;
+	class Rx_packets;
 }
 
 
+/**
+ * Received packets whose content is referenced by the IP stack
+ *
+ * Such packets are acknowledged not before the IP stack released their
+ * content. To keep the NIC server able to deliver further packets, at most
+ * half of the RX queue is held this way. Further packets are copied.
+ */
+class Net::Rx_packets
+{
+	private:
+
+		enum { MAX_HELD = ::Nic::Session::QUEUE_SIZE / 2 };
+
+		struct Slot
+		{
+			Packet_descriptor packet;
+			bool              used     = false;
+			bool              released = false;
+		};
+
+		Slot     _slots[MAX_HELD];
+		unsigned _num_released = 0;
+
+	public:
+
+		/**
+		 * Allocate slot for holding 'packet'
+		 *
+		 * \return slot, or 0 if the packet cannot be held
+		 */
+		void *alloc(Packet_descriptor packet)
+		{
+			for (unsigned i = 0; i < MAX_HELD; i++) {
+				Slot &s = _slots[i];
+				if (s.used)
+					continue;
+
+				s.packet   = packet;
+				s.used     = true;
+				s.released = false;
+				return &s;
+			}
+			return 0;
+		}
+
+		void free(void *slot) { static_cast<Slot *>(slot)->used = false; }
+
+		void release(void *slot)
+		{
+			static_cast<Slot *>(slot)->released = true;
+			_num_released++;
+		}
+
+		/**
+		 * Acknowledge released packets as far as the ack queue permits
+		 */
+		void acknowledge(Packet_stream_sink< ::Nic::Session::Policy> &sink)
+		{
+			for (unsigned i = 0; _num_released && i < MAX_HELD; i++) {
+				Slot &s = _slots[i];
+				if (!s.used || !s.released)
+					continue;
+
+				if (!sink.ready_to_ack())
+					return;
+
+				sink.acknowledge_packet(s.packet);
+				s.used = false;
+				_num_released--;
+			}
+		}
+
+		static Rx_packets &rx_packets()
+		{
+			static Rx_packets inst;
+			return inst;
+		}
+};
+
+
 class Net::Nic : public Net::Packet_handler
 {
 	private:
@@ -90,16 +171,35 @@ void Net::Packet_handler::_packet_avail(unsigned)
 	using namespace Net;
 	enum { MAX_PACKETS = 20 };
 
+	Rx_packets &held = Rx_packets::rx_packets();
+
+	/* acknowledge packets released by the IP stack meanwhile */
+	held.acknowledge(*Nic::n()->rx());
+
 	int count = 0;
 	while(Nic::n()->rx()->packet_avail() &&
 	      Nic::n()->rx()->ready_to_ack() &&
 	      count++ < MAX_PACKETS)
 	{
-		Packet_descriptor p = Nic::n()->rx()->get_packet();
-		net_driver_rx(Net::Nic::n()->rx()->packet_content(p), p.size());
+		Packet_descriptor p    = Nic::n()->rx()->get_packet();
+		void             *slot = held.alloc(p);
+
+		int const csum_verified = p.checksum() & Packet_descriptor::CSUM_L4;
+
+		if (net_driver_rx(Net::Nic::n()->rx()->packet_content(p), p.size(), slot,
+		                  csum_verified))
+			continue;
+
+		if (slot)
+			held.free(slot);
+
 		Nic::n()->rx()->acknowledge_packet(p);
 	}
 
+	/* deliver segments merged during this batch */
+	if (count)
+		net_driver_rx_flush();
+
 	if (Nic::n()->rx()->packet_avail())
 		Genode::Signal_transmitter(_sink_submit).submit();
 }
@@ -130,6 +230,15 @@ void net_mac(void* mac, unsigned long size)
 }
 
 
+void net_rx_release(void *slot)
+{
+	Net::Rx_packets &held = Net::Rx_packets::rx_packets();
+
+	held.release(slot);
+	held.acknowledge(*Net::Nic::n()->rx());
+}
+
+
 int net_tx(void* addr, unsigned long len)
 {
 	try {
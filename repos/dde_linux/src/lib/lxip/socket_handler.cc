@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -14,6 +14,9 @@
 #include <base/signal.h>
 #include <base/printf.h>
 #include <base/thread.h>
+#include <base/lock.h>
+#include <base/semaphore.h>
+#include <util/fifo.h>
 
 #include <lxip/lxip.h>
 #include <env.h>
@@ -41,6 +44,7 @@ namespace Linux {
 
 namespace Net
 {
+		class Stack_guard;
 		class Socketcall;
 
 		enum Opcode { OP_SOCKET   = 0,  OP_CLOSE  = 1, OP_BIND     = 2,  OP_LISTEN  = 3,
@@ -109,6 +113,76 @@ namespace Net
 };
 
 
+/**
+ * Arbitration of the execution of the Linux TCP/IP stack
+ *
+ * The stack must not be executed by more than one thread at a time. It is
+ * entered by the socketcall thread for handling signals, e.g., for NIC and
+ * timer events and for queued socket calls, and directly by the callers of
+ * socket operations that cannot block. A caller never waits for the stack
+ * but falls back to queueing its call. So a socket operation never waits
+ * behind a blocking call that is currently executed by the socketcall
+ * thread.
+ */
+class Net::Stack_guard
+{
+	private:
+
+		Genode::Lock      _lock;
+		bool              _inside  = false;
+		unsigned          _waiting = 0;
+		Genode::Semaphore _left;
+
+	public:
+
+		/**
+		 * Enter the stack if no other thread is inside
+		 *
+		 * \return true if the stack was entered
+		 */
+		bool try_enter()
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			if (_inside)
+				return false;
+
+			_inside = true;
+			return true;
+		}
+
+		/**
+		 * Enter the stack, wait for the thread inside to leave
+		 */
+		void enter()
+		{
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_lock);
+
+					if (!_inside) {
+						_inside = true;
+						return;
+					}
+					_waiting++;
+				}
+				_left.down();
+			}
+		}
+
+		void leave()
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			_inside = false;
+			if (_waiting) {
+				_waiting--;
+				_left.up();
+			}
+		}
+};
+
+
 class Net::Socketcall : public Genode::Signal_dispatcher_base,
                         public Genode::Signal_context_capability,
                         public Lxip::Socketcall,
@@ -116,20 +190,85 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 {
 	private:
 
+		/**
+		 * Socket call issued by a caller
+		 */
+		struct Request : Genode::Fifo<Request>::Element
+		{
+			Call const       &call;
+			Result            result;
+			Lxip::Handle      handle;
+			Genode::Semaphore done;
+
+			Request(Call const &call) : call(call) { }
+		};
+
+		/*
+		 * The call arguments and results of the request that is currently
+		 * executed. They are accessed only from inside the stack.
+		 */
 		Call         _call;
 		Result       _result;
 		Lxip::Handle _handle;
 
+		Stack_guard _stack;
+
+		Genode::Lock          _queue_lock;
+		Genode::Fifo<Request> _queue;
+
 		Genode::Signal_transmitter _signal;
-		Genode::Semaphore          _block;
 
-		void _submit_and_block()
+		Request *_dequeue()
+		{
+			Genode::Lock::Guard guard(_queue_lock);
+			return _queue.dequeue();
+		}
+
+		/**
+		 * Execute request, must be called from inside the stack
+		 */
+		void _execute(Request &request)
 		{
+			_call = request.call;
+
+			_dispatch_call();
+
+			request.result = _result;
+			request.handle = _handle;
+		}
+
+		/**
+		 * Perform socket call
+		 *
+		 * \param may_block  true if the call may block inside the stack
+		 *
+		 * A call that cannot block is executed in the context of the caller
+		 * if no other thread is inside the stack. Otherwise, the call is
+		 * queued for the socketcall thread, which executes all queued calls
+		 * at once.
+		 */
+		Request &_perform(Request &request, bool may_block)
+		{
+			if (!may_block && _stack.try_enter()) {
+				_execute(request);
+				_stack.leave();
+				return request;
+			}
+
+			{
+				Genode::Lock::Guard guard(_queue_lock);
+				_queue.enqueue(&request);
+			}
+
 			_signal.submit(); /* global submit */
-			_block.down();
+			request.done.down();
+			return request;
 		}
 
-		void _unblock() { _block.up(); }
+		bool _non_blocking(Call const &call, int msg_flags) const
+		{
+			return call.handle.non_block || (msg_flags & MSG_DONTWAIT);
+		}
 
 		struct Linux::socket * call_socket()
 		{
@@ -137,7 +276,8 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 		}
 
 
-		Lxip::uint32_t _family_handler(Lxip::uint16_t family, void *addr)
+		static Lxip::uint32_t _family_handler(Call &call, Lxip::uint16_t family,
+		                                      void *addr)
 		{
 			using namespace Linux;
 
@@ -149,7 +289,7 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 				case AF_INET:
 
 					struct sockaddr_in *in  = (struct sockaddr_in *)addr;
-					struct sockaddr_in *out = (struct sockaddr_in *)&_call.addr;
+					struct sockaddr_in *out = (struct sockaddr_in *)&call.addr;
 
 					out->sin_family       = family;
 					out->sin_port         = in->sin_port;
@@ -381,30 +521,7 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 			kfree(s);
 		}
 
-	public:
-
-		Socketcall()
-		  : Thread("socketcall"),
-		    _signal(Genode::Signal_context_capability(Env::receiver()->manage(this)))
-		{
-			start();
-		}
-
-		~Socketcall() { Env::receiver()->dissolve(this); }
-
-		void entry()
-		{
-			while (true) {
-				Genode::Signal s = Net::Env::receiver()->wait_for_signal();
-				static_cast<Genode::Signal_dispatcher_base *>(s.context())->dispatch(s.num());
-			}
-		}
-
-		/***********************
-		 ** Signal dispatcher **
-		 ***********************/
-
-		void dispatch(unsigned num)
+		void _dispatch_call()
 		{
 			if (verbose)
 				PDBG("SOCKET dispatch %u", _call.opcode);
@@ -431,10 +548,44 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 					_handle.socket = 0;
 					PWRN("Unkown opcode: %u\n", _call.opcode);
 			}
+		}
+
+	public:
 
-			_unblock();
+		Socketcall()
+		  : Thread("socketcall"),
+		    _signal(Genode::Signal_context_capability(Env::receiver()->manage(this)))
+		{
+			start();
 		}
 
+		~Socketcall() { Env::receiver()->dissolve(this); }
+
+		void entry()
+		{
+			while (true) {
+				Genode::Signal s = Net::Env::receiver()->wait_for_signal();
+
+				_stack.enter();
+				static_cast<Genode::Signal_dispatcher_base *>(s.context())->dispatch(s.num());
+				_stack.leave();
+			}
+		}
+
+		/***********************
+		 ** Signal dispatcher **
+		 ***********************/
+
+		/**
+		 * Execute all queued socket calls in one pass
+		 */
+		void dispatch(unsigned)
+		{
+			while (Request *request = _dequeue()) {
+				_execute(*request);
+				request->done.up();
+			}
+		}
 
 		/**************************
 		 ** Socketcall interface **
@@ -442,186 +593,188 @@ class Net::Socketcall : public Genode::Signal_dispatcher_base,
 
 		Lxip::Handle accept(Lxip::Handle h, void *addr, Lxip::uint32_t *len)
 		{
-			_call.opcode      = OP_ACCEPT;
-			_call.handle      = h;
-			_call.accept.addr = addr;
-			_call.accept.len  = len;
-
-			_submit_and_block();
+			Call call { };
+			call.opcode      = OP_ACCEPT;
+			call.handle      = h;
+			call.accept.addr = addr;
+			call.accept.len  = len;
 
-			return _handle;
+			Request request(call);
+			return _perform(request, true).handle;
 		}
 
 		int bind(Lxip::Handle h, Lxip::uint16_t family, void *addr)
 		{
-			_call.opcode   = OP_BIND;
-			_call.handle   = h;
-			_call.addr_len = _family_handler(family, addr);
+			Call call { };
+			call.opcode   = OP_BIND;
+			call.handle   = h;
+			call.addr_len = _family_handler(call, family, addr);
 
-			_submit_and_block();
-
-			return _result.err;
+			Request request(call);
+			return _perform(request, false).result.err;
 		}
 
 		void close(Lxip::Handle h)
 		{
-			_call.opcode = OP_CLOSE;
-			_call.handle = h;
+			Call call { };
+			call.opcode = OP_CLOSE;
+			call.handle = h;
 
-			_submit_and_block();
+			Request request(call);
+			_perform(request, true);
 		}
 
 		int connect(Lxip::Handle h, Lxip::uint16_t family, void *addr)
 		{
-			_call.opcode   = OP_CONNECT;
-			_call.handle   = h;
-			_call.addr_len = _family_handler(family, addr);
-
-			_submit_and_block();
+			Call call { };
+			call.opcode   = OP_CONNECT;
+			call.handle   = h;
+			call.addr_len = _family_handler(call, family, addr);
 
-			return _result.err;
+			Request request(call);
+			return _perform(request, true).result.err;
 		}
 
 		int getpeername(Lxip::Handle h, void *addr, Lxip::uint32_t *len)
 		{
-			_call.opcode      = OP_PEERNAME;
-			_call.handle      = h;
-			_call.accept.len  = len;
-			_call.accept.addr = addr;
+			Call call { };
+			call.opcode      = OP_PEERNAME;
+			call.handle      = h;
+			call.accept.len  = len;
+			call.accept.addr = addr;
 
-			_submit_and_block();
-
-			return _result.err;
+			Request request(call);
+			return _perform(request, false).result.err;
 		}
 
 		int getsockname(Lxip::Handle h, void *addr, Lxip::uint32_t *len)
 		{
-			_call.opcode      = OP_GETNAME;
-			_call.handle      = h;
-			_call.accept.len  = len;
-			_call.accept.addr = addr;
-
-			_submit_and_block();
+			Call call { };
+			call.opcode      = OP_GETNAME;
+			call.handle      = h;
+			call.accept.len  = len;
+			call.accept.addr = addr;
 
-			return _result.err;
+			Request request(call);
+			return _perform(request, false).result.err;
 		}
 
 		int getsockopt(Lxip::Handle h, int level, int optname,
 		               void *optval, int *optlen)
 		{
-			_call.opcode             = OP_GETOPT;
-			_call.handle             = h;
-			_call.sockopt.level      = level;
-			_call.sockopt.optname    = optname;
-			_call.sockopt.optval     = optval;
-			_call.sockopt.optlen_ptr = optlen;
+			Call call { };
+			call.opcode             = OP_GETOPT;
+			call.handle             = h;
+			call.sockopt.level      = level;
+			call.sockopt.optname    = optname;
+			call.sockopt.optval     = optval;
+			call.sockopt.optlen_ptr = optlen;
 
-			_submit_and_block();
-
-			return _result.err;
+			Request request(call);
+			return _perform(request, false).result.err;
 		}
 
 		int ioctl(Lxip::Handle h, int request, char *arg)
 		{
-			_call.opcode        = OP_IOCTL;
-			_call.handle        = h;
-			_call.ioctl.request = request;
-			_call.ioctl.arg     = (unsigned long)arg;
-
-			_submit_and_block();
+			Call call { };
+			call.opcode        = OP_IOCTL;
+			call.handle        = h;
+			call.ioctl.request = request;
+			call.ioctl.arg     = (unsigned long)arg;
 
-			return _result.err;
+			Request ioctl_request(call);
+			return _perform(ioctl_request, false).result.err;
 		}
 
 		int listen(Lxip::Handle h, int backlog)
 		{
-			_call.opcode         = OP_LISTEN;
-			_call.handle         = h;
-			_call.listen.backlog = backlog;
-
-			_submit_and_block();
+			Call call { };
+			call.opcode         = OP_LISTEN;
+			call.handle         = h;
+			call.listen.backlog = backlog;
 
-			return _result.err;
+			Request request(call);
+			return _perform(request, false).result.err;
 		}
 
 		int poll(Lxip::Handle h, bool block)
 		{
-			_call.opcode     = OP_POLL;
-			_call.handle     = h;
-			_call.poll.block = block;
+			Call call { };
+			call.opcode     = OP_POLL;
+			call.handle     = h;
+			call.poll.block = block;
 
-			_submit_and_block();
-
-			return _result.err;
+			Request request(call);
+			return _perform(request, block).result.err;
 		}
 
 		Lxip::ssize_t recv(Lxip::Handle h, void *buf, Lxip::size_t len, int flags,
 		                   Lxip::uint16_t family, void *addr,
 		                   Lxip::uint32_t *addr_len)
 		{
-			_call.opcode       = OP_RECV;
-			_call.handle       = h;
-			_call.msg.buf      = buf;
-			_call.msg.len      = len;
-			_call.msg.addr     = addr;
-			_call.msg.addr_len = addr_len;
-			_call.msg.flags    = flags;
-			_call.addr_len     = _family_handler(family, addr);
-
-			_submit_and_block();
+			Call call { };
+			call.opcode       = OP_RECV;
+			call.handle       = h;
+			call.msg.buf      = buf;
+			call.msg.len      = len;
+			call.msg.addr     = addr;
+			call.msg.addr_len = addr_len;
+			call.msg.flags    = flags;
+			call.addr_len     = _family_handler(call, family, addr);
 
-			return _result.len;
+			Request request(call);
+			return _perform(request, !_non_blocking(call, flags)).result.len;
 		}
 
 		Lxip::ssize_t send(Lxip::Handle h, const void *buf, Lxip::size_t len, int flags,
 		                   Lxip::uint16_t family, void *addr)
 		{
-			_call.opcode     = OP_SEND;
-			_call.handle     = h;
-			_call.msg.buf    = (void *)buf;
-			_call.msg.len    = len;
-			_call.msg.flags  = flags;
-			_call.addr_len   = _family_handler(family, addr);
-
-			_submit_and_block();
+			Call call { };
+			call.opcode     = OP_SEND;
+			call.handle     = h;
+			call.msg.buf    = (void *)buf;
+			call.msg.len    = len;
+			call.msg.flags  = flags;
+			call.addr_len   = _family_handler(call, family, addr);
 
-			return _result.len;
+			Request request(call);
+			return _perform(request, !_non_blocking(call, flags)).result.len;
 		}
 
 		int setsockopt(Lxip::Handle h, int level, int optname,
 		               const void *optval, Lxip::uint32_t optlen)
 		{
-			_call.opcode          = OP_SETOPT,
-			_call.handle          = h;
-			_call.sockopt.level   = level;
-			_call.sockopt.optname = optname;
-			_call.sockopt.optval  = optval;
-			_call.sockopt.optlen  = optlen;
+			Call call { };
+			call.opcode          = OP_SETOPT,
+			call.handle          = h;
+			call.sockopt.level   = level;
+			call.sockopt.optname = optname;
+			call.sockopt.optval  = optval;
+			call.sockopt.optlen  = optlen;
 
-			_submit_and_block();
-
-			return _result.err;
+			Request request(call);
+			return _perform(request, false).result.err;
 		}
 
 		int shutdown(Lxip::Handle h, int how)
 		{
-			_call.opcode       = OP_SHUTDOWN;
-			_call.handle       = h;
-			_call.shutdown.how = how;
-
-			_submit_and_block();
+			Call call { };
+			call.opcode       = OP_SHUTDOWN;
+			call.handle       = h;
+			call.shutdown.how = how;
 
-			return _result.err;
+			Request request(call);
+			return _perform(request, false).result.err;
 		}
 
 		Lxip::Handle socket(Lxip::Type type)
 		{
-			_call.opcode      = OP_SOCKET;
-			_call.socket.type = type;
-
-			_submit_and_block();
+			Call call { };
+			call.opcode      = OP_SOCKET;
+			call.socket.type = type;
 
-			return _handle;
+			Request request(call);
+			return _perform(request, false).handle;
 		}
 };
 
@@ -48,6 +48,18 @@ void scsi_alloc_buffer(size_t size, struct scsi_cmnd *cmnd);
 void scsi_setup_buffer(struct scsi_cmnd *cmnd, size_t size, void *virt, dma_addr_t addr);
 
 
+/**
+ * Fill command with a buffer consisting of several DMA segments
+ *
+ * \param cmnd   Command buffer to setup
+ * \param count  Number of segments
+ * \param sizes  Data size of each segment
+ * \param addrs  DMA address of each segment
+ */
+void scsi_setup_buffer_sg(struct scsi_cmnd *cmnd, unsigned count,
+                          size_t const *sizes, dma_addr_t const *addrs);
+
+
 /**
  * Free data buffer of command
  *
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -43,6 +43,11 @@ struct Usb_nic::Device
 	 */
 	virtual bool link_state() = 0;
 
+	/**
+	 * Return checksum-offload capabilities of device
+	 */
+	virtual Nic::Offload offload() = 0;
+
 	/**
 	 * Set session belonging to this driver
 	 */
@@ -94,7 +99,7 @@ class Usb_nic::Session_component : public Nic::Session_component
 		void _send_burst()
 		{
 			static sk_buff work_skb; /* dummy skb for fixup calls */
-			static Packet_descriptor save;
+			static Nic::Packet_descriptor save;
 
 			sk_buff       *skb = nullptr;
 			unsigned char *ptr = nullptr;
@@ -111,8 +116,8 @@ class Usb_nic::Session_component : public Nic::Session_component
 					work_skb.data = nullptr;
 				}
 
-				Packet_descriptor packet = save.valid() ? save : _tx.sink()->get_packet();
-				save                     = Packet_descriptor();
+				Nic::Packet_descriptor packet = save.valid() ? save : _tx.sink()->get_packet();
+				save                          = Nic::Packet_descriptor();
 
 				if (!_device->skb_fill(&work_skb, ptr, packet.size(), skb->end)) {
 					/* submit batch */
@@ -146,7 +151,7 @@ class Usb_nic::Session_component : public Nic::Session_component
 			if (!_tx.sink()->packet_avail())
 				return false;
 
-			Genode::Packet_descriptor packet = _tx.sink()->get_packet();
+			Nic::Packet_descriptor packet = _tx.sink()->get_packet();
 			if (!packet.valid()) {
 				PWRN("Invalid tx packet");
 				return true;
@@ -187,12 +192,16 @@ class Usb_nic::Session_component : public Nic::Session_component
 
 		Nic::Mac_address mac_address() override { return _device->mac_address(); }
 		bool link_state()              override { return _device->link_state(); }
+		Nic::Offload offload()         override { return _device->offload(); }
 		void link_state_changed()               { _link_state_changed(); }
 
 		/**
 		 * Send packet to client (called from driver)
+		 *
+		 * \param checksum  bit mask of 'Nic::Packet_descriptor::Checksum'
+		 *                  flags of the checksums verified by the device
 		 */
-		void rx(addr_t virt, size_t size)
+		void rx(addr_t virt, size_t size, unsigned checksum)
 		{
 			_handle_packet_stream();
 
@@ -200,8 +209,9 @@ class Usb_nic::Session_component : public Nic::Session_component
 				return;
 
 			try {
-				Packet_descriptor p =_rx.source()->alloc_packet(size);
+				Nic::Packet_descriptor p =_rx.source()->alloc_packet(size);
 				Genode::memcpy(_rx.source()->packet_content(p), (void*)virt, size);
+				p.checksum(checksum);
 				_rx.source()->submit_packet(p);
 			} catch (...) {
 				/* drop */
@@ -1105,7 +1105,7 @@ struct scatterlist *sg_next(struct scatterlist *sg)
 	if (sg->last)
 		return 0;
 
-	return sg++;
+	return ++sg;
 }
 
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -126,6 +126,46 @@ static Skb *skb_rx(unsigned const elements = 0, unsigned const buffer_size = 0)
 }
 
 
+/**
+ * Transfer parameters obtained from the '<nic>' config node
+ */
+struct Nic_config
+{
+	enum Burst { BURST_AUTO, BURST_ON, BURST_OFF };
+
+	unsigned rx_urbs = 0;  /* in-flight RX URBs, 0 selects the default */
+	unsigned tx_urbs = 0;  /* in-flight TX URBs, 0 selects the default */
+	Burst    burst   = BURST_AUTO;
+
+	Nic_config()
+	{
+		using namespace Genode;
+
+		try {
+			Xml_node nic = config()->xml_node().sub_node("nic");
+
+			rx_urbs = nic.attribute_value("rx_urbs", 0U);
+			tx_urbs = nic.attribute_value("tx_urbs", 0U);
+
+			if (nic.has_attribute("burst"))
+				burst = nic.attribute("burst").has_value("yes") ? BURST_ON
+				                                                : BURST_OFF;
+		} catch (...) { }
+	}
+};
+
+
+static Nic_config const &nic_config()
+{
+	static Nic_config inst;
+	return inst;
+}
+
+
+extern "C" unsigned genode_usbnet_rx_urbs(void) { return nic_config().rx_urbs; }
+extern "C" unsigned genode_usbnet_tx_urbs(void) { return nic_config().tx_urbs; }
+
+
 /**
  * Prototype of fixup function
  */
@@ -146,18 +186,57 @@ class Nic_device : public Usb_nic::Device
 		bool const         _burst;
 		bool               _has_link { false };
 
+	public:
+
+		/**
+		 * Return true if multiple frames are sent per bulk transfer
+		 *
+		 * Burst mode relies on the 'tx_fixup' function of the driver to
+		 * frame each packet. If not configured explicitly, it is used for
+		 * devices with large RX URBs, which aggregate received frames too.
+		 */
+		static bool _use_burst(struct net_device *ndev)
+		{
+			struct usbnet *dev = (usbnet *)netdev_priv(ndev);
+
+			if (!dev->driver_info->tx_fixup)
+				return false;
+
+			switch (nic_config().burst) {
+			case Nic_config::BURST_ON:  return true;
+			case Nic_config::BURST_OFF: return false;
+			default:                    return dev->rx_urb_size > 2048;
+			}
+		}
+
+		/**
+		 * Return number of skbs per allocator
+		 *
+		 * Each in-flight URB occupies one skb. Twice the number of
+		 * configured URBs leaves room for the packets being processed.
+		 */
+		static unsigned _skb_count(struct usbnet *dev)
+		{
+			unsigned const urbs = Genode::max(nic_config().rx_urbs,
+			                                  nic_config().tx_urbs);
+
+			unsigned const cnt = Genode::max(dev->rx_urb_size <= 2048 ? 128U : 64U,
+			                                 2*urbs);
+
+			/* the allocator manages skbs in chunks of 32 */
+			return Genode::align_addr(cnt, 5);
+		}
+
 	public:
 
 		Nic_device(struct net_device *ndev)
 		:
-			_ndev(ndev),
-			/* XXX should be configurable instead of guessing burst mode */
-			_burst(((usbnet *)netdev_priv(ndev))->rx_urb_size > 2048)
+			_ndev(ndev), _burst(_use_burst(ndev))
 		{
 			struct usbnet *dev = (usbnet *)netdev_priv(_ndev);
 
 			/* initialize skb allocators */
-			unsigned urb_cnt = dev->rx_urb_size <= 2048 ? 128 : 64;
+			unsigned urb_cnt = _skb_count(dev);
 			skb_rx(urb_cnt, dev->rx_urb_size);
 			skb_tx(urb_cnt, dev->rx_urb_size);
 
@@ -281,8 +360,19 @@ class Nic_device : public Usb_nic::Device
 
 		/**
 		 * Submit packet for session
+		 *
+		 * Drivers that verified the checksums of a packet in hardware mark
+		 * its SKB with 'CHECKSUM_UNNECESSARY'.
 		 */
-		inline void rx(sk_buff *skb) { _session->rx((Genode::addr_t)skb->data, skb->len); }
+		inline void rx(sk_buff *skb)
+		{
+			unsigned const checksum = skb->ip_summed == CHECKSUM_UNNECESSARY
+			                        ? Nic::Packet_descriptor::CSUM_IP |
+			                          Nic::Packet_descriptor::CSUM_L4
+			                        : 0;
+
+			_session->rx((Genode::addr_t)skb->data, skb->len, checksum);
+		}
 
 		/**
 		 * Return mac address
@@ -295,6 +385,15 @@ class Nic_device : public Usb_nic::Device
 		}
 
 		bool burst() { return _burst; }
+
+		Nic::Offload offload()
+		{
+			Nic::Offload offload;
+			if (_ndev->features & NETIF_F_RXCSUM)
+				offload.rx_checksum = Nic::Packet_descriptor::CSUM_IP
+				                    | Nic::Packet_descriptor::CSUM_L4;
+			return offload;
+		}
 };
 
 
@@ -414,6 +513,9 @@ struct sk_buff *_alloc_skb(unsigned int size, bool tx)
 	skb->tail = skb->start;
 	skb->truesize = size;
 
+	/* SKBs are recycled, drop the checksum status of the previous use */
+	skb->ip_summed = CHECKSUM_NONE;
+
 	return skb;
 }
 
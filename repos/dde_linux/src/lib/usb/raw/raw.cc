@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -161,10 +161,34 @@ class Usb::Worker
 		unsigned                  _p_in_flight = 0;
 		bool                      _device_ready = false;
 
+		/*
+		 * Acknowledgements are collected and handed to the client in
+		 * batches, i.e., all packets completed by one interrupt or handled
+		 * by one '_dispatch' call result in at most one signal to the
+		 * client. Because at most 'ack_slots_free' packets are in flight,
+		 * the pending acknowledgements always fit into the ack queue.
+		 */
+		enum { MAX_ACKS = Session::TX_QUEUE_SIZE };
+
+		Packet_descriptor _acks[MAX_ACKS];
+		unsigned          _num_acks = 0;
+
+		void _flush_acks()
+		{
+			if (!_num_acks)
+				return;
+
+			_sink->acknowledge_packets(_acks, _num_acks);
+			_p_in_flight -= _num_acks;
+			_num_acks     = 0;
+		}
+
 		void _ack_packet(Packet_descriptor &p)
 		{
-			_sink->acknowledge_packet(p);
-			_p_in_flight--;
+			if (_num_acks == MAX_ACKS)
+				_flush_acks();
+
+			_acks[_num_acks++] = p;
 		}
 
 		/**
@@ -249,15 +273,56 @@ class Usb::Worker
 					               urb->actual_length);
 			}
 
+			_ack_async(p);
+		}
+
+		void _isoc_finish(Packet_descriptor &p, urb *urb, bool read)
+		{
+			unsigned const n      = urb->number_of_packets;
+			Isoc_frame    *frames = (Isoc_frame *)_sink->packet_content(p);
+
+			for (unsigned i = 0; i < n; i++) {
+				frames[i].actual_length = urb->iso_frame_desc[i].actual_length;
+				frames[i].status        = urb->iso_frame_desc[i].status;
+			}
+
+			if (urb->status == 0) {
+				p.transfer.actual_size = urb->actual_length;
+				p.succeded             = true;
+
+				if (read)
+					Genode::memcpy(_sink->packet_content(p) + Isoc_frame::header_size(n),
+					               urb->transfer_buffer,
+					               urb->transfer_buffer_length);
+			}
+
+			_ack_async(p);
+		}
+
+		/**
+		 * Acknowledge packet completed outside of the worker routine
+		 */
+		void _ack_async(Packet_descriptor &p)
+		{
+			bool const wakeup = (_num_acks == 0);
+
 			_ack_packet(p);
+
+			/* let the worker flush the acknowledgements */
+			if (wakeup)
+				::complete(&_packet_avail);
 		}
 
 		static void _async_complete(urb *urb)
 		{
 			Complete_data *data = (Complete_data *)urb->context;
+			bool const     read = !!(data->packet.transfer.ep & USB_DIR_IN);
+
+			if (data->packet.type == Packet_descriptor::ISOC)
+				data->worker->_isoc_finish(data->packet, urb, read);
+			else
+				data->worker->_async_finish(data->packet, urb, read);
 
-			data->worker->_async_finish(data->packet, urb,
-			                            !!(data->packet.transfer.ep & USB_DIR_IN));
 			kfree (data);
 			dma_free(urb->transfer_buffer);
 			usb_free_urb(urb);
@@ -281,7 +346,7 @@ class Usb::Worker
 			urb *bulk_urb = usb_alloc_urb(0, GFP_KERNEL);
 			if (!bulk_urb) {
 				PERR("Failed to allocate bulk URB");
-				kfree(buf);
+				dma_free(buf);
 				return false;
 			}
 
@@ -316,7 +381,7 @@ class Usb::Worker
 			urb *irq_urb = usb_alloc_urb(0, GFP_KERNEL);
 			if (!irq_urb) {
 				PERR("Failed to allocate interrupt URB");
-				kfree(buf);
+				dma_free(buf);
 				return false;
 			}
 
@@ -333,6 +398,83 @@ class Usb::Worker
 			return true;
 		}
 
+		/**
+		 * Isochronous transfer
+		 *
+		 * All frames of the packet are transferred with one URB.
+		 */
+		bool _isoc(Packet_descriptor &p, bool read)
+		{
+			unsigned const n      = p.transfer.number_of_packets;
+			size_t   const header = Isoc_frame::header_size(n);
+
+			if (!n || header > p.size()) {
+				PERR("Invalid isochronous packet");
+				return false;
+			}
+
+			Isoc_frame *frames = (Isoc_frame *)_sink->packet_content(p);
+
+			size_t length = 0;
+			for (unsigned i = 0; i < n; i++)
+				length += frames[i].length;
+
+			if (length > p.size() - header) {
+				PERR("Isochronous frames exceed packet size");
+				return false;
+			}
+
+			unsigned const pipe = read
+			                    ? usb_rcvisocpipe(_device->udev, p.transfer.ep)
+			                    : usb_sndisocpipe(_device->udev, p.transfer.ep);
+
+			usb_host_endpoint *ep = usb_pipe_endpoint(_device->udev, pipe);
+			if (!ep) {
+				PERR("Invalid isochronous endpoint %x", p.transfer.ep);
+				return false;
+			}
+
+			void *buf = dma_malloc(length);
+			if (!read)
+				Genode::memcpy(buf, _sink->packet_content(p) + header, length);
+
+			urb *isoc_urb = usb_alloc_urb(n, GFP_KERNEL);
+			if (!isoc_urb) {
+				PERR("Failed to allocate isochronous URB");
+				dma_free(buf);
+				return false;
+			}
+
+			Complete_data *data = (Complete_data *)kmalloc(sizeof(Complete_data), GFP_KERNEL);
+			data->packet   = p;
+			data->worker   = this;
+
+			isoc_urb->dev                    = _device->udev;
+			isoc_urb->pipe                   = pipe;
+			isoc_urb->transfer_flags         = URB_ISO_ASAP;
+			isoc_urb->interval               = 1 << (Genode::min(16U, Genode::max(1U, (unsigned)ep->desc.bInterval)) - 1);
+			isoc_urb->transfer_buffer        = buf;
+			isoc_urb->transfer_buffer_length = length;
+			isoc_urb->number_of_packets      = n;
+			isoc_urb->complete               = _async_complete;
+			isoc_urb->context                = data;
+
+			for (unsigned i = 0, offset = 0; i < n; offset += frames[i++].length) {
+				isoc_urb->iso_frame_desc[i].offset = offset;
+				isoc_urb->iso_frame_desc[i].length = frames[i].length;
+			}
+
+			if (usb_submit_urb(isoc_urb, GFP_KERNEL)) {
+				PERR("Failed to submit URB");
+				kfree(data);
+				dma_free(buf);
+				usb_free_urb(isoc_urb);
+				return false;
+			}
+
+			return true;
+		}
+
 		/**
 		 * Change alternate settings for device
 		 */
@@ -420,10 +562,17 @@ class Usb::Worker
 					case Packet_descriptor::BULK:
 						if (_bulk(p, !!(p.transfer.ep & USB_DIR_IN)))
 							continue;
+						break;
 
 					case Packet_descriptor::IRQ:
 						if (_irq(p, !!(p.transfer.ep & USB_DIR_IN)))
 							continue;
+						break;
+
+					case Packet_descriptor::ISOC:
+						if (_isoc(p, !!(p.transfer.ep & USB_DIR_IN)))
+							continue;
+						break;
 
 					case Packet_descriptor::ALT_SETTING:
 						_alt_setting(p);
@@ -440,6 +589,8 @@ class Usb::Worker
 
 				_ack_packet(p);
 			}
+
+			_flush_acks();
 		}
 
 		void _wait_for_device()
@@ -466,6 +617,7 @@ class Usb::Worker
 			while (true) {
 				wait_for_completion(&_packet_avail);
 
+				_flush_acks();
 				_dispatch();
 				Routine::schedule_all();
 			}
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -27,8 +27,19 @@ class Event_context
 
 		Genode::Signal_rpc_member<Event_context> _dispatcher;
 
-		void _handle(unsigned) {
-			Routine::schedule_all(); }
+		/*
+		 * A completion merely causes all routines to be scheduled once.
+		 * Hence, all completions that happen before the signal is
+		 * dispatched, e.g., the URBs completed by one interrupt, are
+		 * covered by a single signal.
+		 */
+		bool _pending = false;
+
+		void _handle(unsigned)
+		{
+			_pending = false;
+			Routine::schedule_all();
+		}
 
 		Event_context()
 		: _dispatcher(_signal->ep(), *this, &Event_context::_handle) {
@@ -42,8 +53,14 @@ class Event_context
 			return &_e;
 		}
 
-		void submit() {
-			_signal->sender().submit(); }
+		void submit()
+		{
+			if (_pending)
+				return;
+
+			_pending = true;
+			_signal->sender().submit();
+		}
 
 		char const *debug() { return "Event_context"; }
 };
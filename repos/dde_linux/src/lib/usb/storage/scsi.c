@@ -105,6 +105,46 @@ void scsi_setup_buffer(struct scsi_cmnd *cmnd, size_t size, void *virt, dma_addr
 }
 
 
+void scsi_setup_buffer_sg(struct scsi_cmnd *cmnd, unsigned count,
+                          size_t const *sizes, dma_addr_t const *addrs)
+{
+	unsigned i;
+
+	if (count < 2) {
+		scsi_setup_buffer(cmnd, sizes[0], 0, addrs[0]);
+		return;
+	}
+
+	/*
+	 * Replace the single-entry list of the command. The pages are allocated
+	 * as one block referenced by the first entry, which keeps
+	 * '_scsi_free_command' unchanged.
+	 */
+	kfree((void *)cmnd->sdb.table.sgl->page_link);
+	kfree(cmnd->sdb.table.sgl);
+
+	struct scatterlist *sgl = (struct scatterlist *)kcalloc(count, sizeof(*sgl), GFP_KERNEL);
+	struct page *pages      = (struct page *)kcalloc(count, sizeof(*pages), GFP_KERNEL);
+
+	cmnd->sdb.table.sgl   = sgl;
+	cmnd->sdb.table.nents = count;
+	cmnd->sdb.length      = 0;
+
+	for (i = 0; i < count; i++) {
+		pages[i].virt = 0;
+		pages[i].phys = addrs[i];
+
+		sgl[i].page_link   = (unsigned long)&pages[i];
+		sgl[i].offset      = 0;
+		sgl[i].length      = sizes[i];
+		sgl[i].dma_address = addrs[i];
+		sgl[i].last        = (i + 1 == count);
+
+		cmnd->sdb.length += sizes[i];
+	}
+}
+
+
 void scsi_free_buffer(struct scsi_cmnd *cmnd)
 {
 	struct page *page = _page(cmnd);
@@ -78,21 +78,106 @@ class Storage_device : public Genode::List<Storage_device>::Element,
 			_scsi_free_command(cmnd);
 		}
 
-		void _io(Block::sector_t block_nr, Genode::size_t block_count,
-		         Block::Packet_descriptor packet,
-		         Genode::addr_t phys, bool read)
+		enum {
+			QUEUE_SIZE   = 64,     /* requests waiting for the SCSI layer    */
+			MAX_SEGMENTS = 32,     /* requests combined in one SCSI command  */
+			MAX_BLOCKS   = 0xffff, /* limit of the READ_10/WRITE_10 count    */
+		};
+
+		/**
+		 * Block request not yet handed to the SCSI layer
+		 */
+		struct Request
 		{
-			if (block_nr > _block_count)
-				throw Io_error();
+			Block::Packet_descriptor packet;
+			Block::sector_t          block_nr;
+			Genode::size_t           block_count;
+			Genode::addr_t           phys;
+			bool                     read;
+		};
+
+		Request  _queue[QUEUE_SIZE];
+		unsigned _queue_head  = 0;
+		unsigned _queue_count = 0;
+		bool     _busy        = false; /* SCSI command in flight */
 
-			if (verbose)
-				PDBG("PACKET: phys: %lx block: %llu count: %zu %s",
-				     phys, block_nr, block_count, read ? "read" : "write");
+	public:
+
+		/**
+		 * Packets covered by one SCSI command
+		 */
+		struct Command
+		{
+			Block::Packet_descriptor packets[MAX_SEGMENTS];
+			unsigned                 count = 0;
+		};
+
+	private:
+
+		Request &_queued(unsigned i) {
+			return _queue[(_queue_head + i) % QUEUE_SIZE]; }
+
+		/**
+		 * Return number of queued requests that can be combined with the first
+		 */
+		unsigned _mergeable()
+		{
+			Request const &first = _queued(0);
+			Block::sector_t next = first.block_nr + first.block_count;
+			Genode::size_t blocks = first.block_count;
+
+			unsigned n = 1;
+			for (; n < _queue_count && n < MAX_SEGMENTS; n++) {
+				Request const &r = _queued(n);
+				if (r.read != first.read || r.block_nr != next ||
+				    blocks + r.block_count > MAX_BLOCKS)
+					break;
+
+				next   += r.block_count;
+				blocks += r.block_count;
+			}
+			return n;
+		}
+
+		/**
+		 * Issue queued requests as one SCSI command if the host is idle
+		 */
+		void _submit()
+		{
+			if (_busy || !_queue_count)
+				return;
 
 			/* check if we can call queuecommand */
 			struct us_data *us = (struct us_data *) _sdev->host->hostdata;
 			if (us->srb != NULL)
-				throw Request_congestion();
+				return;
+
+			unsigned const n = _mergeable();
+			Request const &first = _queued(0);
+			bool const read = first.read;
+			Block::sector_t const block_nr = first.block_nr;
+
+			/* the segment sizes are passed to the SCSI layer with its type */
+			Command *command = new (Genode::env()->heap()) Command();
+			size_t           sizes[MAX_SEGMENTS];
+			dma_addr_t       addrs[MAX_SEGMENTS];
+			Genode::size_t   block_count = 0;
+			for (unsigned i = 0; i < n; i++) {
+				Request const &r = _queued(i);
+				command->packets[i] = r.packet;
+				sizes[i]     = r.block_count * _block_size;
+				addrs[i]     = r.phys;
+				block_count += r.block_count;
+			}
+			command->count = n;
+
+			_queue_head   = (_queue_head + n) % QUEUE_SIZE;
+			_queue_count -= n;
+			_busy         = true;
+
+			if (verbose)
+				PDBG("COMMAND: block: %llu count: %zu packets: %u %s",
+				     block_nr, block_count, n, read ? "read" : "write");
 
 			struct scsi_cmnd *cmnd = _scsi_alloc_command();
 
@@ -101,20 +186,16 @@ class Storage_device : public Genode::List<Storage_device>::Element,
 			cmnd->device            = _sdev;
 			cmnd->sc_data_direction = read ? DMA_FROM_DEVICE : DMA_TO_DEVICE;
 			cmnd->scsi_done         = _async_done;
-
-			Block::Packet_descriptor *p = new (Genode::env()->heap()) Block::Packet_descriptor();
-			*p = packet;
-			cmnd->packet  = (void *)p;
+			cmnd->packet            = (void *)command;
 
 			Genode::uint32_t be_block_nr = host_to_big_endian<Genode::uint32_t>(block_nr);
 			memcpy(&cmnd->cmnd[2], &be_block_nr, 4);
 
-			/* transfer one block */
 			Genode::uint16_t be_block_count = host_to_big_endian<Genode::uint16_t>(block_count);
 			memcpy(&cmnd->cmnd[7], &be_block_count, 2);
 
-			/* setup command */
-			scsi_setup_buffer(cmnd, block_count * _block_size, (void *)0, phys);
+			/* setup command, one segment per packet */
+			scsi_setup_buffer_sg(cmnd, n, sizes, addrs);
 
 			/*
 			 * Required by 'last_sector_hacks' in 'drivers/usb/storage/transprot.c
@@ -127,6 +208,30 @@ class Storage_device : public Genode::List<Storage_device>::Element,
 			_sdev->host->hostt->queuecommand(_sdev->host, cmnd);
 		}
 
+		void _io(Block::sector_t block_nr, Genode::size_t block_count,
+		         Block::Packet_descriptor packet,
+		         Genode::addr_t phys, bool read)
+		{
+			if (block_nr > _block_count || block_count > MAX_BLOCKS)
+				throw Io_error();
+
+			if (verbose)
+				PDBG("PACKET: phys: %lx block: %llu count: %zu %s",
+				     phys, block_nr, block_count, read ? "read" : "write");
+
+			if (_queue_count == QUEUE_SIZE)
+				throw Request_congestion();
+
+			Request &r = _queued(_queue_count++);
+			r.packet      = packet;
+			r.block_nr    = block_nr;
+			r.block_count = block_count;
+			r.phys        = phys;
+			r.read        = read;
+
+			_submit();
+		}
+
 	public:
 
 		Storage_device(struct scsi_device *sdev)
@@ -161,6 +266,24 @@ class Storage_device : public Genode::List<Storage_device>::Element,
 
 		bool dma_enabled() { return true; }
 
+		/**
+		 * Acknowledge packets of a finished SCSI command and issue the next
+		 */
+		void complete(Command &command)
+		{
+			_busy = false;
+
+			for (unsigned i = 0; i < command.count; i++) {
+				if (verbose)
+					PDBG("ACK packet for block: %llu",
+					     command.packets[i].block_number());
+
+				ack_packet(command.packets[i]);
+			}
+
+			_submit();
+		}
+
 		Genode::Ram_dataspace_capability alloc_dma_buffer(Genode::size_t size) {
 			return Backend_memory::alloc(size, Genode::UNCACHED); }
 
@@ -190,14 +313,11 @@ static work_struct delayed;
 
 extern "C" void ack_packet(work_struct *work)
 {
-	Block::Packet_descriptor *packet =
-		static_cast<Block::Packet_descriptor *>(work->data);
-
-	if (verbose)
-		PDBG("ACK packet for block: %llu", packet->block_number());
+	Storage_device::Command *command =
+		static_cast<Storage_device::Command *>(work->data);
 
-	device->ack_packet(*packet);
-	Genode::destroy(Genode::env()->heap(), packet);
+	device->complete(*command);
+	Genode::destroy(Genode::env()->heap(), command);
 }
 
 
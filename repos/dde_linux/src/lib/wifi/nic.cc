@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -46,34 +46,50 @@ class Wifi_session_component : public Nic::Session_component
 		net_device *_ndev;
 		bool        _has_link = !(_ndev->state & 1UL << __LINK_STATE_NOCARRIER);
 
-	protected:
+		/*
+		 * Packets are processed in batches
+		 *
+		 * Received frames are collected while the Linux tasks run and are
+		 * submitted to the client at once via a locally triggered signal,
+		 * which is handled after the current scheduling round. Reordered
+		 * frames released from an A-MPDU thereby result in one batch.
+		 */
+		enum { BATCH = 64 };
+
+		Nic::Packet_descriptor _rx_batch[BATCH];
+		unsigned               _rx_batch_len = 0;
+
+		Nic::Packet_descriptor _tx_batch[BATCH];
 
-		bool _send()
+		void _submit_rx_batch()
 		{
-			using namespace Genode;
+			if (!_rx_batch_len)
+				return;
 
-			if (!_tx.sink()->ready_to_ack())
-				return false;
+			_rx.source()->submit_packets(_rx_batch, _rx_batch_len);
+			_rx_batch_len = 0;
+		}
 
-			if (!_tx.sink()->packet_avail())
-				return false;
+		void _handle_rx_flush(unsigned) { _submit_rx_batch(); }
 
-			Packet_descriptor packet = _tx.sink()->get_packet();
-			if (!packet.valid()) {
-				PWRN("Invalid tx packet");
-				return true;
-			}
+		Genode::Signal_rpc_member<Wifi_session_component> _rx_flush_dispatcher {
+			_ep, *this, &Wifi_session_component::_handle_rx_flush };
 
+	protected:
+
+		void _send(Nic::Packet_descriptor packet)
+		{
 			struct sk_buff *skb = ::alloc_skb(packet.size() + HEAD_ROOM, GFP_KERNEL);
+			if (!skb) {
+				PWRN("could not allocate skb, tx packet dropped");
+				return;
+			}
 			skb_reserve(skb, HEAD_ROOM);
 
 			unsigned char *data = skb_put(skb, packet.size());
 			Genode::memcpy(data, _tx.sink()->packet_content(packet), packet.size());
 
 			_ndev->netdev_ops->ndo_start_xmit(skb, _ndev);
-			_tx.sink()->acknowledge_packet(packet);
-
-			return true;
 		}
 
 		void _handle_packet_stream()
@@ -81,7 +97,24 @@ class Wifi_session_component : public Nic::Session_component
 			while (_rx.source()->ack_avail())
 				_rx.source()->release_packet(_rx.source()->get_acked_packet());
 
-			while (_send()) ;
+			while (_tx.sink()->packet_avail()) {
+
+				unsigned const slots = Genode::min(_tx.sink()->ack_slots_free(),
+				                                   (unsigned)BATCH);
+				if (!slots)
+					return;
+
+				unsigned const received = _tx.sink()->get_packets(_tx_batch, slots);
+
+				for (unsigned i = 0; i < received; i++) {
+					if (_tx_batch[i].valid())
+						_send(_tx_batch[i]);
+					else
+						PWRN("Invalid tx packet");
+				}
+
+				_tx.sink()->acknowledge_packets(_tx_batch, received);
+			}
 		}
 
 	public:
@@ -117,44 +150,49 @@ class Wifi_session_component : public Nic::Session_component
 
 		void receive(struct sk_buff *skb)
 		{
-			_handle_packet_stream();
+			/* free RX buffer space of packets processed by the client */
+			while (_rx.source()->ack_avail())
+				_rx.source()->release_packet(_rx.source()->get_acked_packet());
 
-			if (!_rx.source()->ready_to_submit())
+			if (_rx_batch_len == BATCH)
+				_submit_rx_batch();
+
+			/* drop packet if the submit queue cannot take it */
+			if (_rx_batch_len >= _rx.source()->submit_slots_free())
 				return;
 
 			/* get mac header back */
 			skb_push(skb, ETH_HLEN);
 
-			void *packet       = skb->data;
-			size_t packet_size = ETH_HLEN;
-			void *frag         = 0;
-			size_t frag_size   = 0;
-
-			/**
-			 * If received packets are too large (as of now 128 bytes) the actually
-			 * payload is put into a fragment. Otherwise the payload is stored directly
-			 * in the sk_buff.
+			/*
+			 * Large frames, e.g., the subframes of an A-MSDU, are received
+			 * into pages. Their payload is then attached to the sk_buff as
+			 * fragments whereas the linear part holds the headers only.
 			 */
-			if (skb_shinfo(skb)->nr_frags) {
-				if (skb_shinfo(skb)->nr_frags > 1)
-					PERR("more than 1 fragment in skb");
-
-				skb_frag_t *f = &skb_shinfo(skb)->frags[0];
-				frag          = skb_frag_address(f);
-				frag_size     = skb_frag_size(f);
-			}
-			else
-				packet_size += skb->len;
+			struct skb_shared_info *shinfo = skb_shinfo(skb);
 
+			size_t const head_size = skb_headlen(skb);
+			size_t       size      = head_size;
+			for (unsigned i = 0; i < shinfo->nr_frags; i++)
+				size += skb_frag_size(&shinfo->frags[i]);
 
 			try {
-				Nic::Packet_descriptor p = _rx.source()->alloc_packet(packet_size + frag_size);
-				void *buffer = _rx.source()->packet_content(p);
-				memcpy(buffer, packet, packet_size);
-				if (frag_size)
-					memcpy((char *)buffer + packet_size, frag, frag_size);
+				Nic::Packet_descriptor p = _rx.source()->alloc_packet(size);
+				char *dst = _rx.source()->packet_content(p);
+
+				memcpy(dst, skb->data, head_size);
+				dst += head_size;
+
+				for (unsigned i = 0; i < shinfo->nr_frags; i++) {
+					skb_frag_t const *f = &shinfo->frags[i];
+					memcpy(dst, skb_frag_address(f), skb_frag_size(f));
+					dst += skb_frag_size(f);
+				}
+
+				if (!_rx_batch_len)
+					Genode::Signal_transmitter(_rx_flush_dispatcher).submit();
 
-				_rx.source()->submit_packet(p);
+				_rx_batch[_rx_batch_len++] = p;
 			} catch (...) {
 				PDBG("failed to process received packet");
 			}
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -20,6 +20,7 @@ extern "C" {
 #include <rump/rump.h>
 }
 
+#include <base/env.h>
 #include <base/thread.h>
 
 
@@ -71,9 +72,24 @@ class Hard_context_thread : public Hard_context,
 
 	public:
 
-		Hard_context_thread(char const *name, func f, void *arg, int cookie, bool run = true)
+		/**
+		 * Constructor
+		 *
+		 * \param location  CPU the thread is bound to, by default the
+		 *                  thread is not bound
+		 */
+		Hard_context_thread(char const *name, func f, void *arg, int cookie,
+		                    bool run = true,
+		                    Genode::Affinity::Location location =
+		                        Genode::Affinity::Location())
 		: Hard_context(cookie), Thread(name),
-			_func(f), _arg(arg) { if (run) start(); }
+			_func(f), _arg(arg)
+		{
+			if (location.valid())
+				Genode::env()->cpu_session()->affinity(Thread_base::cap(), location);
+
+			if (run) start();
+		}
 };
 
 
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2013-2014 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -15,6 +15,7 @@
 #include "sched.h"
 
 #include <base/env.h>
+#include <base/lock.h>
 #include <base/printf.h>
 #include <base/sleep.h>
 #include <os/timed_semaphore.h>
@@ -104,15 +105,40 @@ struct lwp * rumpuser_curlwp(void)
 }
 
 
+/**
+ * Return affinity space of the CPUs used by the rump kernel
+ */
+static Genode::Affinity::Space affinity_space()
+{
+	static Genode::Affinity::Space inst =
+		Genode::env()->cpu_session()->affinity_space();
+	return inst;
+}
+
+
 int rumpuser_thread_create(func f, void *arg, const char *name,
                            int mustjoin, int priority, int cpui_dx, void **cookie)
 {
-	static long count = 0;
+	static Genode::Lock count_lock;
+	static long         count = 0;
+
+	long id = 0;
+	if (mustjoin) {
+		Genode::Lock::Guard guard(count_lock);
+		id = ++count;
+		*cookie = (void *)id;
+	}
 
-	if (mustjoin)
-		*cookie = (void *)++count;
+	/*
+	 * Threads bound to a virtual CPU of the rump kernel, e.g., the soft
+	 * interrupt threads, are bound to the corresponding physical CPU.
+	 */
+	Genode::Affinity::Location location;
+	if (cpui_dx >= 0 && affinity_space().total() > 1)
+		location = affinity_space().location_of_index(cpui_dx);
 
-	new (Genode::env()->heap()) Hard_context_thread(name, f, arg, mustjoin ? count : 0);
+	new (Genode::env()->heap())
+		Hard_context_thread(name, f, arg, id, true, location);
 
 	return 0;
 }
@@ -136,10 +162,15 @@ int rumpuser_getparam(const char *name, void *buf, size_t buflen)
 {
 	enum { RESERVE_MEM = 2U * 1024 * 1024 };
 
-	/* support one cpu */
 	PDBG("%s", name);
+
+	/*
+	 * Provide one virtual CPU per physical CPU of the component's affinity
+	 * space, which is defined by the parent
+	 */
 	if (!Genode::strcmp(name, "_RUMPUSER_NCPU")) {
-		Genode::strncpy((char *)buf, "1", 2);
+		unsigned const ncpu = Genode::max(affinity_space().total(), 1U);
+		Genode::snprintf((char *)buf, buflen, "%u", ncpu);
 		return 0;
 	}
 
@@ -180,21 +211,36 @@ void rumpuser_putchar(int ch)
 	static unsigned char buf[256];
 	static int count = 0;
 
-	buf[count++] = (unsigned char)ch;
+	/*
+	 * The buffer is shared by the threads running on all virtual CPUs. The
+	 * lock must not be held while the rump kernel is unscheduled because
+	 * the rescheduling may wait for the CPU of a thread that blocks on the
+	 * lock.
+	 */
+	static Genode::Lock lock;
 
-	if (ch == '\n') {
-		buf[count] = 0;
-		int nlocks;
-		if (myself() != main_thread())
-			rumpkern_unsched(&nlocks, 0);
+	unsigned char line[sizeof(buf)];
+	{
+		Genode::Lock::Guard guard(lock);
 
-		PLOG("rump: %s", buf);
+		buf[count++] = (unsigned char)ch;
 
-		if (myself() != main_thread())
-			rumpkern_sched(nlocks, 0);
+		if (ch != '\n' && count < (int)sizeof(buf) - 1)
+			return;
 
+		buf[count] = 0;
+		Genode::memcpy(line, buf, count + 1);
 		count = 0;
 	}
+
+	int nlocks;
+	if (myself() != main_thread())
+		rumpkern_unsched(&nlocks, 0);
+
+	PLOG("rump: %s", line);
+
+	if (myself() != main_thread())
+		rumpkern_sched(nlocks, 0);
 }
 
 
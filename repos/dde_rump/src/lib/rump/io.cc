@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013-2014 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -17,6 +17,7 @@
 #include <block_session/connection.h>
 #include <rump_fs/fs.h>
 #include <util/list.h>
+#include <util/misc_math.h>
 #include <util/string.h>
 
 
@@ -34,8 +35,11 @@ struct Packet : Genode::List<Packet>::Element
 	rump_biodone_fn                  biodone;
 	void                            *donearg;
 	bool                             valid;
+	bool                             submitted;
 	bool                             pending;
 	bool                             sync;
+	Packet                          *cluster; /* next packet of the same
+	                                             block request */
 };
 
 
@@ -44,10 +48,20 @@ class Backend : public Hard_context_thread
 
 	private:
 
-		enum { COUNT = Block::Session::TX_QUEUE_SIZE };
+		enum {
+			COUNT        = Block::Session::TX_QUEUE_SIZE,
+			TX_BUF_MIN   = 128 * 1024,
+			TX_BUF_MAX   = 16 * 1024 * 1024,
+			TX_BUF_PROBE = 4096,
+
+			/* cluster size used if the server has no preference */
+			CLUSTER_MAX  = 128 * 1024,
+		};
 
 		Genode::Allocator_avl              _alloc;
+		Genode::size_t const               _buf_size;
 		Block::Connection                  _session;
+		Genode::size_t                     _cluster_max; /* in bytes */
 		Genode::size_t                     _blk_size; /* block size of the device   */
 		Block::sector_t                    _blk_cnt;  /* number of blocks of device */
 		Block::Session::Operations         _blk_ops;
@@ -63,6 +77,25 @@ class Backend : public Hard_context_thread
 		Genode::Signal_dispatcher<Backend> _disp_submit;
 
 
+		/**
+		 * Determine transmission-buffer size from the server's preferences
+		 *
+		 * The buffer size of a session cannot be changed after its creation.
+		 * Hence, we query the transfer characteristics via a short-lived
+		 * session with a minimal buffer first.
+		 */
+		static Genode::size_t _tx_buf_size()
+		{
+			Genode::Allocator_avl alloc(Genode::env()->heap());
+			Block::Connection     probe(&alloc, TX_BUF_PROBE);
+			Genode::size_t const size =
+				probe.transfer_info().tx_buf_size(TX_BUF_MIN, TX_BUF_MAX);
+
+			if (verbose)
+				PDBG("tx buffer size %zu", size);
+			return size;
+		}
+
 		Genode::List<Packet> *_pending()
 		{
 			static Genode::List<Packet> _p;
@@ -90,10 +123,12 @@ class Backend : public Hard_context_thread
 		
 		Packet *_dequeue()
 		{
+			Genode::Lock::Guard guard(_alloc_lock);
+
 			int idx;
 			for (int i = 0; i < COUNT; i++) {
 				idx = (_index_thread + i) % COUNT;
-				if (_p[idx].valid && !_p[idx].pending) {
+				if (_p[idx].submitted && !_p[idx].pending) {
 					_index_thread   = idx;
 					_p[idx].pending = true;
 					return &_p[idx];
@@ -103,11 +138,67 @@ class Backend : public Hard_context_thread
 			return 0;
 		}
 
+		/**
+		 * Dequeue submitted packet that continues the block request 'head'
+		 *
+		 * The rump kernel issues the I/O of adjacent buffers as individual
+		 * requests. Combining them into one block request saves the
+		 * per-request overhead of the block server and the device.
+		 *
+		 * \param blk    first block after the packets of the request
+		 * \param bytes  size of the request so far
+		 */
+		Packet *_dequeue_adjacent(Packet const *head, Block::sector_t blk,
+		                          Genode::size_t bytes)
+		{
+			Genode::Lock::Guard guard(_alloc_lock);
+
+			for (int i = 0; i < COUNT; i++) {
+				Packet &p = _p[i];
+				if (!p.submitted || p.pending || p.sync || !p.cnt
+				 || p.opcode != head->opcode || p.blk != blk
+				 || bytes + p.cnt * _blk_size > _cluster_max)
+					continue;
+
+				p.pending = true;
+				return &p;
+			}
+			return 0;
+		}
+
+		/**
+		 * Append adjacent requests already submitted to block request 'head'
+		 *
+		 * \return  number of blocks of the combined request
+		 */
+		Genode::size_t _cluster(Packet *head)
+		{
+			Genode::size_t cnt  = head->cnt;
+			Packet        *last = head;
+
+			/* the semaphore is decremented by this thread only */
+			while (_packet_sem.cnt() > 0) {
+				Packet *p = _dequeue_adjacent(head, head->blk + cnt,
+				                              cnt * _blk_size);
+				if (!p)
+					break;
+
+				_packet_sem.down();
+				last->cluster = p;
+				last          = p;
+				cnt          += p->cnt;
+			}
+			return cnt;
+		}
 
 		void _free(Packet *p)
 		{
-			p->valid   = false;
-			p->pending = false;
+			Genode::Lock::Guard guard(_alloc_lock);
+
+			p->valid     = false;
+			p->submitted = false;
+			p->pending   = false;
+			p->cluster   = 0;
 			_alloc_sem.up();
 		}
 
@@ -119,30 +210,41 @@ class Backend : public Hard_context_thread
 
 			while (_session.tx()->ack_avail()) {
 				Block::Packet_descriptor packet = _session.tx()->get_acked_packet();
-				Packet *p = _find(packet);
-
-				if (p->opcode == Block::Packet_descriptor::READ)
-					Genode::memcpy(p->data, _session.tx()->packet_content(packet),
-					               packet.block_count() * _blk_size);
-
+				Packet *head = _find(packet);
+
+				if (head->opcode == Block::Packet_descriptor::READ) {
+					char const *content = _session.tx()->packet_content(packet);
+					for (Packet *p = head; p; p = p->cluster) {
+						Genode::memcpy(p->data, content, p->cnt * _blk_size);
+						content += p->cnt * _blk_size;
+					}
+				}
 
 				/* sync session if requested  */
-				if (p->sync)
+				if (head->sync)
 					_session.sync();
 
+				/* complete all requests of the cluster at once */
 				int dummy;
-				if (verbose)
-					PDBG("BIO done  p: %p bio %p", p, p->donearg);
-
 				rumpkern_sched(0, 0);
-				if (p->biodone)
-					p->biodone(p->donearg, p->cnt * _blk_size,
-					           packet.succeeded() ? 0 : EIO);
+				for (Packet *p = head; p; p = p->cluster) {
+
+					if (verbose)
+						PDBG("BIO done  p: %p bio %p", p, p->donearg);
+
+					if (p->biodone)
+						p->biodone(p->donearg, p->cnt * _blk_size,
+						           packet.succeeded() ? 0 : EIO);
+				}
 				rumpkern_unsched(&dummy, 0);
 
 				_session.tx()->release_packet(packet);
-				_pending()->remove(p);
-				_free(p);
+				_pending()->remove(head);
+
+				for (Packet *p = head, *next; p; p = next) {
+					next = p->cluster;
+					_free(p);
+				}
 			}
 		}
 
@@ -187,15 +289,21 @@ class Backend : public Hard_context_thread
 					continue;
 				}
 
+				Genode::size_t const cnt = _cluster(p);
+
 				for (bool done = false; !done;)
 					try {
 						Block::Packet_descriptor packet(
-						_session.dma_alloc_packet(p->cnt * _blk_size),
-						                          p->opcode, p->blk, p->cnt);
+						_session.dma_alloc_packet(cnt * _blk_size),
+						                          p->opcode, p->blk, cnt);
 						/* got packet copy data */
-						if (p->opcode == Block::Packet_descriptor::WRITE)
-							Genode::memcpy(_session.tx()->packet_content(packet),
-							               p->data, p->cnt * _blk_size);
+						if (p->opcode == Block::Packet_descriptor::WRITE) {
+							char *content = _session.tx()->packet_content(packet);
+							for (Packet *c = p; c; c = c->cluster) {
+								Genode::memcpy(content, c->data, c->cnt * _blk_size);
+								content += c->cnt * _blk_size;
+							}
+						}
 						_session.tx()->submit_packet(packet);
 
 						/* mark as pending */
@@ -213,7 +321,9 @@ class Backend : public Hard_context_thread
 		Backend()
 		: Hard_context_thread("block_io", 0, 0, 0, false),
 		_alloc(Genode::env()->heap()),
-		_session(&_alloc),
+		_buf_size(_tx_buf_size()),
+		_session(&_alloc, _buf_size),
+		_cluster_max(CLUSTER_MAX),
 		_alloc_sem(COUNT),
 		_disp_ack(_receiver, *this, &Backend::_ack_avail),
 		_disp_submit(_receiver, *this, &Backend::_ready_to_submit)
@@ -222,6 +332,16 @@ class Backend : public Hard_context_thread
 			_session.tx_channel()->sigh_ready_to_submit(_disp_submit);
 			_session.info(&_blk_cnt, &_blk_size, &_blk_ops);
 			PDBG("Backend blk_size %zu", _blk_size);
+
+			/*
+			 * Follow the preference of the server but leave room for at
+			 * least two requests in the transmission buffer
+			 */
+			Genode::size_t const max_transfer = _session.transfer_info().max_transfer;
+			if (max_transfer)
+				_cluster_max = max_transfer;
+			_cluster_max = Genode::min(_cluster_max, _buf_size / 2);
+
 			Genode::memset(_p, 0, sizeof(_p));
 			start();
 		}
@@ -252,7 +372,14 @@ class Backend : public Hard_context_thread
 			return 0;
 		}
 
-		void submit() { _packet_sem.up(); }
+		void submit(Packet *p)
+		{
+			{
+				Genode::Lock::Guard guard(_alloc_lock);
+				p->submitted = true;
+			}
+			_packet_sem.up();
+		}
 };
 
 
@@ -326,7 +453,7 @@ void rumpuser_bio(int fd, int op, void *data, size_t dlen, int64_t off,
 	p->biodone = biodone;
 	p->donearg = donearg;
 	p->sync    = !!(op & RUMPUSER_BIO_SYNC);
-	backend()->submit();
+	backend()->submit(p);
 	rumpkern_sched(nlocks, 0);
 }
 
@@ -337,7 +464,7 @@ void rump_io_backend_sync()
 	Packet *p = backend()->alloc();
 	p->cnt    = 0;
 	p->sync   = true;
-	backend()->submit();
+	backend()->submit(p);
 }
 
 
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -389,70 +389,109 @@ void rumpuser_cv_has_waiters(struct rumpuser_cv *cv, int *nwaiters)
  ** Read/write lock **
  *********************/
 
-struct Rw_lock {
+/**
+ * Read/write lock
+ *
+ * The lock is held either by one writer or by any number of readers. Once a
+ * writer waits, new readers are held back so that a steady stream of readers
+ * cannot starve the writer. Similar to the mutex, blocked applicants wait in
+ * a FIFO and retry once the lock becomes available.
+ */
+struct Rw_lock
+{
+	struct Applicant : Genode::Fifo<Applicant>::Element
+	{
+		Genode::Lock lock { Genode::Lock::LOCKED };
+		bool         writer;
+
+		Applicant(bool writer) : writer(writer) { }
 
-	Genode::Semaphore  _lock;
-	Genode::Lock       _inc;
-	Genode::Lock       _write;
+		void block()   { lock.lock();   }
+		void wake_up() { lock.unlock(); }
+	};
 
-	int _read;
+	Genode::Fifo<Applicant> _fifo;
+	Genode::Lock            _meta_lock;
 
-	Rw_lock() : _lock(1), _read(0) {}
+	int  _readers         = 0;
+	bool _writer          = false;
+	int  _waiting_writers = 0;
 
-	bool read_lock(bool try_lock)
+	void _wake_up_all()
 	{
-		Genode::Lock::Guard guard(_inc);
-
-		if (_read > 0) {
-			_read++;
-			return true;
+		while (Applicant *applicant = _fifo.dequeue()) {
+			if (applicant->writer)
+				_waiting_writers--;
+			applicant->wake_up();
 		}
+	}
 
-		bool locked = lock(true);
+	bool enter(bool writer, bool try_enter)
+	{
+		while (true) {
+			Applicant applicant(writer);
+			{
+				Genode::Lock::Guard guard(_meta_lock);
 
-		if (locked) {
-			_read = 1;
-			return true;
-		}
+				if (writer && !_writer && !_readers) {
+					_writer = true;
+					return true;
+				}
 
-		if (try_lock)
-			return false;
+				if (!writer && !_writer && !_waiting_writers) {
+					_readers++;
+					return true;
+				}
 
-		lock(false);
-		_read = 1;
-		return true;
+				if (try_enter)
+					return false;
+
+				if (writer)
+					_waiting_writers++;
+
+				_fifo.enqueue(&applicant);
+			}
+			applicant.block();
+		}
 	}
 
-	void read_unlock()
+	void exit()
 	{
-		Genode::Lock::Guard guard(_inc);
-		if (--_read == 0)
-			unlock();
+		Genode::Lock::Guard guard(_meta_lock);
+
+		if (_writer)
+			_writer = false;
+		else
+			_readers--;
+
+		if (!_readers)
+			_wake_up_all();
 	}
 
-	bool lock(bool try_lock)
+	bool try_upgrade()
 	{
-		Genode::Lock::Guard guard(_write);
-		if (_lock.cnt() > 0) {
-			_lock.down();
-			return true;
-		}
+		Genode::Lock::Guard guard(_meta_lock);
 
-		if (try_lock)
+		if (_writer || _readers != 1)
 			return false;
 
-		_lock.down();
+		_readers = 0;
+		_writer  = true;
 		return true;
 	}
 
-	void unlock()
+	void downgrade()
 	{
-		Genode::Lock::Guard guard(_write);
-		_lock.up();
+		Genode::Lock::Guard guard(_meta_lock);
+
+		_writer  = false;
+		_readers = 1;
+
+		_wake_up_all();
 	}
 
-	int readers() { return _read; }
-	int writer()  { return (_lock.cnt() <= 0 && !_read) ? 1 : 0; }
+	int readers() { return _readers; }
+	int writer()  { return _writer ? 1 : 0; }
 };
 
 
@@ -470,55 +509,39 @@ void rumpuser_rw_init(struct rumpuser_rw **rw)
 
 void rumpuser_rw_enter(int enum_rumprwlock, struct rumpuser_rw *rw)
 {
-	int nlocks;
-	bool try_lock = true;
-	bool locked   = false;
-
-
-	while (!locked) {
-
-		if (!try_lock)
-			rumpkern_unsched(&nlocks, 0);
+	bool const writer = enum_rumprwlock == RUMPUSER_RW_WRITER;
 
-		if (enum_rumprwlock == RUMPUSER_RW_WRITER)
-			locked = rw->rw.lock(try_lock);
-		else
-			locked = rw->rw.read_lock(try_lock);
-
-		if (!try_lock)
-			rumpkern_sched(nlocks, 0);
+	if (rw->rw.enter(writer, true))
+		return;
 
-		try_lock = false;
-	}
+	int nlocks;
+	rumpkern_unsched(&nlocks, 0);
+	rw->rw.enter(writer, false);
+	rumpkern_sched(nlocks, 0);
 }
 
 
 int rumpuser_rw_tryenter(int enum_rumprwlock, struct rumpuser_rw *rw)
 {
-	bool locked = enum_rumprwlock == RUMPUSER_RW_WRITER ?
-	              rw->rw.lock(true) : rw->rw.read_lock(true);
-
-	return locked ? 0 : 1;
+	return rw->rw.enter(enum_rumprwlock == RUMPUSER_RW_WRITER, true) ? 0 : 1;
 }
 
 
 int rumpuser_rw_tryupgrade(struct rumpuser_rw *rw)
 {
-	return 1;
+	return rw->rw.try_upgrade() ? 0 : 1;
 }
 
 
 void rumpuser_rw_downgrade(struct rumpuser_rw *rw)
 {
+	rw->rw.downgrade();
 }
 
 
 void rumpuser_rw_exit(struct rumpuser_rw *rw)
 {
-	if (rw->rw.readers())
-		rw->rw.read_unlock();
-	else
-		rw->rw.unlock();
+	rw->rw.exit();
 }
 
 
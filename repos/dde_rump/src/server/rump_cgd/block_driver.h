@@ -15,10 +15,15 @@
 #define _BLOCK_DRIVER_H_
 
 /* General includes */
+#include <base/lock.h>
 #include <base/printf.h>
+#include <base/semaphore.h>
 #include <block_session/connection.h>
 #include <block/component.h>
+#include <os/config.h>
 #include <os/packet_allocator.h>
+#include <os/server.h>
+#include <util/hard_context.h>
 
 /* local includes */
 #include "cgd.h"
@@ -28,18 +33,173 @@ class Driver : public Block::Driver
 {
 	private:
 
+		enum {
+			MAX_JOBS    = Block::Session::TX_QUEUE_SIZE,
+			MAX_WORKERS = 8,
+		};
+
+		/**
+		 * Block request processed by a worker thread
+		 */
+		struct Job
+		{
+			enum State { FREE, PENDING, RUNNING, DONE };
+
+			State                    state = FREE;
+			bool                     write = false;
+			bool                     success = false;
+			Block::sector_t          block_number = 0;
+			Genode::size_t           block_count = 0;
+			char                    *buffer = 0;
+			Block::Packet_descriptor packet;
+		};
+
 		Block::Session::Operations         _ops;
 		Genode::size_t                     _blk_sz;
 		Block::sector_t                    _blk_cnt;
 
 		Cgd::Device                       *_cgd_device;
 
+		/*
+		 * Jobs are kept in submission order. A worker picks the oldest
+		 * pending job, so several requests travel through cgd(4)
+		 * concurrently while one of them waits for the backend. The jobs
+		 * are acknowledged in submission order.
+		 */
+		Job                                _jobs[MAX_JOBS];
+		unsigned                           _head  = 0;
+		unsigned                           _count = 0;
+		Genode::Lock                       _lock;
+		Genode::Semaphore                  _pending;
+		Genode::Signal_rpc_member<Driver>  _done_dispatcher;
+		Genode::Signal_transmitter         _done;
+		Genode::Semaphore                  _finished;
+		bool                               _draining = false;
+		Hard_context_thread               *_workers[MAX_WORKERS];
+		unsigned                           _num_workers;
+
+		static unsigned _config_workers()
+		{
+			unsigned workers = 1;
+			try {
+				Genode::config()->xml_node().attribute("workers").value(&workers);
+			} catch (...) { }
+
+			return Genode::max(1U, Genode::min(workers, (unsigned)MAX_WORKERS));
+		}
+
+		Job &_job(unsigned i) { return _jobs[(_head + i) % MAX_JOBS]; }
+
+		void _process(Job &job)
+		{
+			Genode::size_t const len = job.block_count * _blk_sz;
+			Cgd::seek_off_t const off = job.block_number * _blk_sz;
+
+			job.success = job.write
+			            ? _cgd_device->write(job.buffer, len, off) == len
+			            : _cgd_device->read(job.buffer, len, off)  == len;
+		}
+
+		static void *_worker_entry(void *arg)
+		{
+			Driver &driver = *static_cast<Driver *>(arg);
+			for (;;) {
+				driver._pending.down();
+
+				Job *job = 0;
+				{
+					Genode::Lock::Guard guard(driver._lock);
+					for (unsigned i = 0; i < driver._count; i++)
+						if (driver._job(i).state == Job::PENDING) {
+							job = &driver._job(i);
+							break;
+						}
+					if (!job)
+						continue;
+
+					job->state = Job::RUNNING;
+				}
+
+				driver._process(*job);
+
+				bool draining;
+				{
+					Genode::Lock::Guard guard(driver._lock);
+					job->state = Job::DONE;
+					draining   = driver._draining;
+				}
+				driver._done.submit();
+
+				if (draining)
+					driver._finished.up();
+			}
+			return 0;
+		}
+
+		/**
+		 * Acknowledge finished jobs in submission order
+		 */
+		void _handle_done(unsigned)
+		{
+			for (;;) {
+				Block::Packet_descriptor packet;
+				bool success;
+				{
+					Genode::Lock::Guard guard(_lock);
+					if (!_count || _job(0).state != Job::DONE)
+						return;
+
+					Job &job = _job(0);
+					packet    = job.packet;
+					success   = job.success;
+					job.state = Job::FREE;
+					_head     = (_head + 1) % MAX_JOBS;
+					_count--;
+				}
+				ack_packet(packet, success);
+			}
+		}
+
+		void _io(bool write, Block::sector_t block_number,
+		         Genode::size_t block_count, char *buffer,
+		         Block::Packet_descriptor &packet)
+		{
+			/* process request in the context of the entrypoint */
+			if (_num_workers == 1) {
+				Job job;
+				job.write        = write;
+				job.block_number = block_number;
+				job.block_count  = block_count;
+				job.buffer       = buffer;
+				_process(job);
+				ack_packet(packet, job.success);
+				return;
+			}
+
+			{
+				Genode::Lock::Guard guard(_lock);
+				if (_count == MAX_JOBS)
+					throw Request_congestion();
+
+				Job &job = _job(_count++);
+				job.state        = Job::PENDING;
+				job.write        = write;
+				job.block_number = block_number;
+				job.block_count  = block_count;
+				job.buffer       = buffer;
+				job.packet       = packet;
+			}
+			_pending.up();
+		}
 
 	public:
 
 		Driver(Server::Entrypoint &ep)
 		:
-			_blk_sz(0), _blk_cnt(0), _cgd_device(0)
+			_blk_sz(0), _blk_cnt(0), _cgd_device(0),
+			_done_dispatcher(ep, *this, &Driver::_handle_done),
+			_done(_done_dispatcher),
+			_num_workers(_config_workers())
 		{
 			try {
 				_cgd_device = Cgd::init(Genode::env()->heap(), ep);
@@ -57,10 +217,37 @@ class Driver : public Block::Driver
 			 */
 			_ops.set_operation(Block::Packet_descriptor::READ);
 			_ops.set_operation(Block::Packet_descriptor::WRITE);
+
+			if (_num_workers > 1) {
+				PINF("processing requests with %u worker threads", _num_workers);
+				for (unsigned i = 0; i < _num_workers; i++)
+					_workers[i] = new (Genode::env()->heap())
+						Hard_context_thread("cgd_worker", _worker_entry, this, 0);
+			}
 		}
 
 		~Driver()
 		{
+			/*
+			 * Wait until the workers left cgd(4). They stay blocked
+			 * afterwards because the rump kernel is halted below.
+			 */
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_lock);
+					_draining = true;
+
+					bool busy = false;
+					for (unsigned i = 0; i < _count; i++)
+						if (_job(i).state == Job::PENDING ||
+						    _job(i).state == Job::RUNNING)
+							busy = true;
+					if (!busy)
+						break;
+				}
+				_finished.down();
+			}
+
 			Cgd::deinit(Genode::env()->heap(), _cgd_device);
 		}
 
@@ -83,6 +270,11 @@ class Driver : public Block::Driver
 		Block::sector_t block_count()    { return _blk_cnt; }
 		Block::Session::Operations ops() { return _ops;     }
 
+		Block::Session::Transfer_info transfer_info()
+		{
+			return Block::Session::Transfer_info(0, _num_workers, 0);
+		}
+
 		void read(Block::sector_t           block_number,
 		          Genode::size_t            block_count,
 		          char*                     buffer,
@@ -94,8 +286,7 @@ class Driver : public Block::Driver
 			if(!_range_valid(block_number, block_count))
 				throw Io_error();
 
-			_cgd_device->read(buffer, block_count * _blk_sz, block_number * _blk_sz);
-			ack_packet(packet);
+			_io(false, block_number, block_count, buffer, packet);
 		}
 
 		void write(Block::sector_t           block_number,
@@ -109,8 +300,8 @@ class Driver : public Block::Driver
 			if(!_range_valid(block_number, block_count))
 				throw Io_error();
 
-			_cgd_device->write(buffer, block_count * _blk_sz, block_number * _blk_sz);
-			ack_packet(packet);
+			_io(true, block_number, block_count, const_cast<char *>(buffer),
+			    packet);
 		}
 
 		void sync() { }
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -18,10 +18,112 @@
 #include <util/dither_matrix.h>
 #include <os/surface.h>
 #include <os/texture.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
 
 
 struct Dither_painter
 {
+	/**
+	 * Convert one line of pixels
+	 *
+	 * \param x  horizontal position of the first pixel, used to look up
+	 *           the dither value
+	 */
+	template <typename DST_PT, typename SRC_PT>
+	static inline void _paint_line(DST_PT *dst, SRC_PT const *src_pixel,
+	                               unsigned char const *src_alpha,
+	                               Genode::Dither_matrix::Row dither_row,
+	                               int x, int w)
+	{
+		for (; w--; x++) {
+
+			int const v = dither_row.value(x) >> 4;
+
+			SRC_PT        const pixel = *src_pixel++;
+			unsigned char const alpha = *src_alpha++;
+
+			int const r = pixel.r() - v;
+			int const g = pixel.g() - v;
+			int const b = pixel.b() - v;
+			int const a = alpha ? (int)alpha - v : 0;
+
+			using Genode::min;
+			using Genode::max;
+
+			*dst++ = DST_PT(max(0, r), max(0, g), max(0, b), max(0, a));
+		}
+	}
+
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+
+	/**
+	 * Specialization for the conversion of RGB888 to RGB565
+	 *
+	 * This is the conversion from the back buffer to the front buffer of
+	 * 'Nitpicker_buffer'. Four pixels are processed at once using the
+	 * vector extension of GCC. Because RGB565 has no alpha channel, the
+	 * alpha values are not needed. The results are identical to those of
+	 * the generic version.
+	 */
+	static inline void _paint_line(Genode::Pixel_rgb565 *dst,
+	                               Genode::Pixel_rgb888 const *src_pixel,
+	                               unsigned char const *src_alpha,
+	                               Genode::Dither_matrix::Row dither_row,
+	                               int x, int w)
+	{
+		enum { N = 4 };
+
+		typedef int Vector __attribute__((vector_size(4*N)));
+
+		auto splat = [] (int v) {
+			Vector const res = { v, v, v, v };
+			return res; };
+
+		/* clamp negative values to zero */
+		auto clamp = [&] (Vector v) { return v & ~(v >> splat(31)); };
+
+		/* dither values repeat every 16 pixels, i.e., every four vectors */
+		auto dither_values = [&] (int x) {
+			Vector const res = { dither_row.value(x)     >> 4,
+			                     dither_row.value(x + 1) >> 4,
+			                     dither_row.value(x + 2) >> 4,
+			                     dither_row.value(x + 3) >> 4 };
+			return res; };
+
+		Vector const dither[4] = { dither_values(x),     dither_values(x + 4),
+		                           dither_values(x + 8), dither_values(x + 12) };
+
+		Vector const mask = splat(0xff);
+
+		for (unsigned i = 0; w >= N; w -= N, x += N, i++) {
+
+			Vector p;
+			__builtin_memcpy(&p, src_pixel, sizeof(p));
+
+			Vector const v = dither[i & 3];
+			Vector const r = clamp(((p >> splat(16)) & mask) - v);
+			Vector const g = clamp(((p >> splat(8))  & mask) - v);
+			Vector const b = clamp(( p               & mask) - v);
+
+			Vector const res = ((r << splat(8)) & splat(0xf800))
+			                 | ((g << splat(3)) & splat(0x07e0))
+			                 | ((b >> splat(3)) & splat(0x001f));
+
+			for (int j = 0; j < N; j++)
+				dst[j].pixel = res[j];
+
+			dst       += N;
+			src_pixel += N;
+			src_alpha += N;
+		}
+
+		_paint_line<Genode::Pixel_rgb565, Genode::Pixel_rgb888>(dst, src_pixel,
+		                                                         src_alpha,
+		                                                         dither_row, x, w);
+	}
+#endif /* __SSE2__ || __ARM_NEON__ */
+
 	/*
 	 * Surface and texture must have the same size
 	 */
@@ -37,35 +139,16 @@ struct Dither_painter
 
 		unsigned const offset = surface.size().w()*clipped.y1() + clipped.x1();
 
-		DST_PT              *dst,       *dst_line       = surface.addr()  + offset;
-		SRC_PT        const *src_pixel, *src_pixel_line = texture.pixel() + offset;
-		unsigned char const *src_alpha, *src_alpha_line = texture.alpha() + offset;
+		DST_PT              *dst_line       = surface.addr()  + offset;
+		SRC_PT        const *src_pixel_line = texture.pixel() + offset;
+		unsigned char const *src_alpha_line = texture.alpha() + offset;
 
 		unsigned const line_len = surface.size().w();
 
 		for (int y = clipped.y1(), h = clipped.h() ; h--; y++) {
 
-			src_pixel = src_pixel_line;
-			src_alpha = src_alpha_line;
-			dst       = dst_line;
-
-			for (int x = clipped.x1(), w = clipped.w(); w--; x++) {
-
-				int const v = Genode::Dither_matrix::value(x, y) >> 4;
-
-				SRC_PT        const pixel = *src_pixel++;
-				unsigned char const alpha = *src_alpha++;
-
-				int const r = pixel.r() - v;
-				int const g = pixel.g() - v;
-				int const b = pixel.b() - v;
-				int const a = alpha ? (int)alpha - v : 0;
-
-				using Genode::min;
-				using Genode::max;
-
-				*dst++ = DST_PT(max(0, r), max(0, g), max(0, b), max(0, a));
-			}
+			_paint_line(dst_line, src_pixel_line, src_alpha_line,
+			            Genode::Dither_matrix::row(y), clipped.x1(), clipped.w());
 
 			src_pixel_line += line_len;
 			src_alpha_line += line_len;
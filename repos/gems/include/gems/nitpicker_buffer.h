@@ -37,8 +37,9 @@ struct Nitpicker_buffer
 	typedef Genode::Surface<Pixel_rgb888> Pixel_surface;
 	typedef Genode::Surface<Pixel_alpha8> Alpha_surface;
 
-	typedef Genode::Surface_base::Area Area;
-	typedef Genode::Surface_base::Rect Rect;
+	typedef Genode::Surface_base::Point Point;
+	typedef Genode::Surface_base::Area  Area;
+	typedef Genode::Surface_base::Rect  Rect;
 
 	typedef Genode::Attached_ram_dataspace Ram_ds;
 
@@ -118,6 +119,23 @@ struct Nitpicker_buffer
 		Genode::memset(pixel_surface().addr(), 0, num_pixels*sizeof(Pixel_rgb888));
 	}
 
+	/**
+	 * Reset back buffer within 'rect' only
+	 */
+	void reset_surface(Rect rect)
+	{
+		rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+
+		unsigned const w = size().w();
+
+		for (int y = rect.y1(); y <= rect.y2(); y++) {
+			unsigned const offset = y*w + rect.x1();
+			Genode::memset(alpha_surface().addr() + offset, 0, rect.w());
+			Genode::memset(pixel_surface().addr() + offset, 0,
+			               rect.w()*sizeof(Pixel_rgb888));
+		}
+	}
+
 	template <typename DST_PT, typename SRC_PT>
 	void _convert_back_to_front(DST_PT                        *front_base,
 	                            Genode::Texture<SRC_PT> const &texture,
@@ -130,7 +148,7 @@ struct Nitpicker_buffer
 		Dither_painter::paint(surface, texture);
 	}
 
-	void _update_input_mask()
+	void _update_input_mask(Rect const rect)
 	{
 		unsigned const num_pixels = size().count();
 
@@ -139,9 +157,6 @@ struct Nitpicker_buffer
 
 		unsigned char * const input_base = alpha_base + num_pixels;
 
-		unsigned char const *src = alpha_base;
-		unsigned char       *dst = input_base;
-
 		/*
 		 * Set input mask for all pixels where the alpha value is above a
 		 * given threshold. The threshold is defines such that typical
@@ -149,29 +164,43 @@ struct Nitpicker_buffer
 		 */
 		unsigned char const threshold = 100;
 
-		for (unsigned i = 0; i < num_pixels; i++)
-			*dst++ = (*src++) > threshold;
+		for (int y = rect.y1(); y <= rect.y2(); y++) {
+
+			unsigned const offset = y*size().w() + rect.x1();
+
+			unsigned char const *src = alpha_base + offset;
+			unsigned char       *dst = input_base + offset;
+
+			for (unsigned i = 0; i < rect.w(); i++)
+				*dst++ = (*src++) > threshold;
+		}
 	}
 
-	void flush_surface()
+	void flush_surface() { flush_surface(Rect(Point(0, 0), size())); }
+
+	/**
+	 * Transfer the part 'rect' of the back buffer to the virtual framebuffer
+	 */
+	void flush_surface(Rect rect)
 	{
+		rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+		if (!rect.valid())
+			return;
+
 		/* represent back buffer as texture */
 		Genode::Texture<Pixel_rgb888>
 			texture(pixel_surface_ds.local_addr<Pixel_rgb888>(),
 			        alpha_surface_ds.local_addr<unsigned char>(),
 			        size());
 
-		// XXX track dirty rectangles
-		Rect const clip_rect(Genode::Surface_base::Point(0, 0), size());
-
 		Pixel_rgb565 *pixel_base = fb_ds.local_addr<Pixel_rgb565>();
 		Pixel_alpha8 *alpha_base = fb_ds.local_addr<Pixel_alpha8>()
 		                         + mode.bytes_per_pixel()*size().count();
 
-		_convert_back_to_front(pixel_base, texture, clip_rect);
-		_convert_back_to_front(alpha_base, texture, clip_rect);
+		_convert_back_to_front(pixel_base, texture, rect);
+		_convert_back_to_front(alpha_base, texture, rect);
 
-		_update_input_mask();
+		_update_input_mask(rect);
 	}
 };
 
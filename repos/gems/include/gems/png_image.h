@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -147,6 +147,21 @@ class Png_image
 			return Genode::Surface_base::Area(_info.img_w, _info.img_h);
 		}
 
+		/**
+		 * Fill texture with the PNG image data
+		 *
+		 * The texture must have the size of the image. The image data can
+		 * be read only once.
+		 */
+		template <typename PT>
+		void read(Genode::Texture<PT> &texture)
+		{
+			for (unsigned i = 0; i < size().h(); i++) {
+				png_read_row(_read_struct.png_ptr, _row.row_ptr, NULL);
+				texture.rgba((unsigned char *)_row.row_ptr, size().w()*4, i);
+			}
+		}
+
 		/**
 		 * Obtain PNG image as texture
 		 */
@@ -156,11 +171,7 @@ class Png_image
 			Genode::Texture<PT> *texture = new (Genode::env()->heap())
 				Chunky_texture<PT>(*Genode::env()->ram_session(), size());
 
-			/* fill texture with PNG image data */
-			for (unsigned i = 0; i < size().h(); i++) {
-				png_read_row(_read_struct.png_ptr, _row.row_ptr, NULL);
-				texture->rgba((unsigned char *)_row.row_ptr, size().w()*4, i);
-			}
+			read(*texture);
 
 			return texture;
 		}
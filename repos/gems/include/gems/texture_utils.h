@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -16,44 +16,172 @@
 
 #include <os/texture.h>
 
+namespace Texture_utils {
+
+	/**
+	 * Interpolate linearly between two rows of 8-bit values
+	 *
+	 * \param weight  weight of 'row1' in the range 0...255
+	 */
+	static inline void interpolate_rows(unsigned char       *dst,
+	                                    unsigned char const *row0,
+	                                    unsigned char const *row1,
+	                                    unsigned weight, unsigned n)
+	{
+		unsigned const w0 = 256 - weight, w1 = weight;
+
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+
+		/*
+		 * Process 16 values at once using the vector extension of GCC
+		 *
+		 * The values are processed in 16-bit lanes, each holding two values.
+		 * Because the weights sum up to 256, the intermediate results of
+		 * both the low and the high byte of each lane fit into 16 bits. The
+		 * results are identical to those of the loop below.
+		 */
+		enum { N = 16 };
+
+		typedef Genode::uint16_t Vector __attribute__((vector_size(N)));
+
+		auto splat = [] (Genode::uint16_t v) {
+			Vector const res = { v, v, v, v, v, v, v, v };
+			return res; };
+
+		auto load = [] (void const *src) {
+			Vector res;
+			__builtin_memcpy(&res, src, sizeof(res));
+			return res; };
+
+		Vector const low_mask = splat(0xff), v0 = splat(w0), v1 = splat(w1);
+
+		for (; n >= N; n -= N, dst += N, row0 += N, row1 += N) {
+
+			Vector const a = load(row0), b = load(row1);
+
+			Vector const low  = ((a & low_mask)*v0 + (b & low_mask)*v1) >> 8;
+			Vector const high = ((a >> 8)*v0       + (b >> 8)*v1) & ~low_mask;
+
+			Vector const res = low | high;
+			__builtin_memcpy(dst, &res, sizeof(res));
+		}
+#endif /* __SSE2__ || __ARM_NEON__ */
+
+		for (; n--; dst++, row0++, row1++)
+			*dst = (*row0*w0 + *row1*w1) >> 8;
+	}
+}
+
+
+/**
+ * Scale texture using bilinear filtering
+ *
+ * Each source line is converted to RGBA values and scaled horizontally only
+ * once. The destination lines are interpolated between two horizontally
+ * scaled lines, which is the part of the work that scales with the
+ * destination size in both dimensions.
+ */
 template <typename PT>
 static void scale(Genode::Texture<PT> const &src, Genode::Texture<PT> &dst)
 {
 	/* sanity check to prevent division by zero */
-	if (dst.size().count() == 0)
+	if (dst.size().count() == 0 || src.size().count() == 0)
 		return;
 
-	Genode::size_t const row_num_bytes = dst.size().w()*4;
-	unsigned char *row = (unsigned char *)Genode::env()->heap()->alloc(row_num_bytes);
+	unsigned const src_w = src.size().w(), src_h = src.size().h();
+	unsigned const dst_w = dst.size().w(), dst_h = dst.size().h();
+
+	/*
+	 * Buffer layout: source line as RGBA, two horizontally scaled lines,
+	 * the resulting line, and the horizontal sampling positions of the
+	 * destination pixels
+	 */
+	Genode::size_t const src_row_bytes = src_w*4;
+	Genode::size_t const dst_row_bytes = dst_w*4;
+	Genode::size_t const num_bytes     = src_row_bytes + 3*dst_row_bytes
+	                                   + dst_w*(sizeof(unsigned) + 1);
+
+	unsigned char * const buf = (unsigned char *)Genode::env()->heap()->alloc(num_bytes);
+
+	unsigned char * const src_row   = buf;
+	unsigned char *       scaled[2] = { src_row + src_row_bytes,
+	                                    src_row + src_row_bytes + dst_row_bytes };
+	unsigned char * const row       = scaled[1] + dst_row_bytes;
+	unsigned      * const x_offset  = (unsigned *)(row + dst_row_bytes);
+	unsigned char * const x_weight  = (unsigned char *)(x_offset + dst_w);
+
+	/*
+	 * Return sampling position for the center of destination pixel 'i' in
+	 * 24.8 fixpoint format, 'm' is the 16.16 scale factor
+	 */
+	auto sample_pos = [] (unsigned i, unsigned m) {
+		int const pos = (int)(((2*i + 1)*m) >> 9) - 128;
+		return pos < 0 ? 0u : (unsigned)pos; };
+
+	unsigned const mx = (src_w << 16) / dst_w;
+	unsigned const my = (src_h << 16) / dst_h;
+
+	for (unsigned x = 0; x < dst_w; x++) {
+		unsigned const pos = sample_pos(x, mx);
+		x_offset[x] = Genode::min(pos >> 8, src_w - 1);
+		x_weight[x] = pos & 0xff;
+	}
 
-	unsigned const mx = (src.size().w() << 16) / dst.size().w();
-	unsigned const my = (src.size().h() << 16) / dst.size().h();
+	/*
+	 * Obtain source line 'y' scaled horizontally
+	 */
+	auto scale_line = [&] (unsigned y, unsigned char *dst_row) {
 
-	for (unsigned y = 0, src_y = 0; y < dst.size().h(); y++, src_y += my) {
+		PT            const *pixel = src.pixel() + src_w*y;
+		unsigned char const *alpha = src.alpha() + src_w*y;
 
-		unsigned const src_line_offset = src.size().w()*(src_y >> 16);
+		unsigned char *s = src_row;
+		for (unsigned x = 0; x < src_w; x++) {
+			*s++ = pixel[x].r();
+			*s++ = pixel[x].g();
+			*s++ = pixel[x].b();
+			*s++ = alpha[x];
+		}
 
-		PT            const *pixel_line = src.pixel() + src_line_offset;
-		unsigned char const *alpha_line = src.alpha() + src_line_offset;
+		unsigned char *d = dst_row;
+		for (unsigned x = 0; x < dst_w; x++) {
 
-		unsigned char *d = row;
-		for (unsigned x = 0, src_x = 0; x < dst.size().w(); x++, src_x += mx) {
+			unsigned char const *p0 = src_row + 4*x_offset[x];
+			unsigned char const *p1 = p0 + (x_offset[x] + 1 < src_w ? 4 : 0);
 
-			unsigned const pixel_offset = src_x >> 16;
+			unsigned const w1 = x_weight[x], w0 = 256 - w1;
 
-			PT            const pixel = pixel_line[pixel_offset];
-			unsigned char const alpha = alpha_line[pixel_offset];
+			for (unsigned i = 0; i < 4; i++)
+				*d++ = (p0[i]*w0 + p1[i]*w1) >> 8;
+		}
+	};
+
+	/* source lines currently present in 'scaled[0]' and 'scaled[1]' */
+	int line[2] = { -1, -1 };
+
+	for (unsigned y = 0; y < dst_h; y++) {
+
+		unsigned const pos = sample_pos(y, my);
+		unsigned const y0  = Genode::min(pos >> 8, src_h - 1);
+		unsigned const y1  = Genode::min(y0 + 1,   src_h - 1);
 
-			*d++ = pixel.r();
-			*d++ = pixel.g();
-			*d++ = pixel.b();
-			*d++ = alpha;
+		/* reuse lower line of previous destination line as upper line */
+		if (line[1] == (int)y0 && line[0] != (int)y0) {
+			unsigned char * const tmp = scaled[0];
+			scaled[0] = scaled[1]; scaled[1] = tmp;
+			line[0]   = line[1];   line[1]   = -1;
 		}
 
-		dst.rgba(row, dst.size().w(), y);
+		if (line[0] != (int)y0) { scale_line(y0, scaled[0]); line[0] = y0; }
+		if (line[1] != (int)y1) { scale_line(y1, scaled[1]); line[1] = y1; }
+
+		Texture_utils::interpolate_rows(row, scaled[0], scaled[1],
+		                                pos & 0xff, dst_row_bytes);
+
+		dst.rgba(row, dst_w, y);
 	}
 
-	Genode::env()->heap()->free(row, row_num_bytes);
+	Genode::env()->heap()->free(buf, num_bytes);
 }
 
 
@@ -52,6 +52,64 @@ inline void Polygon::interpolate_rgba(Color start, Color end, Pixel_rgb565 *dst,
 	    b = start.b<<16,
 	    a = start.a<<16;
 
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+
+	/*
+	 * Process four pixels at once using the vector extension of GCC
+	 *
+	 * Because of the dithering, the alpha value may exceed 255, which
+	 * makes 'Pixel_rgb565::mix' operate with a negative alpha value. Hence,
+	 * the pixels are mixed in 32-bit lanes that follow 'Pixel_rgb565::blend'
+	 * literally. The results are identical to those of the loop below.
+	 */
+	enum { N = 4 };
+
+	typedef int      Int_vector  __attribute__((vector_size(4*N)));
+	typedef unsigned Uint_vector __attribute__((vector_size(4*N)));
+
+	auto blend = [] (Int_vector p, Int_vector alpha) {
+		return ((((alpha >> 3) * (p & 0xf81f)) >> 5) & 0xf81f)
+		     | ((( alpha       * (p & 0x07c0)) >> 8) & 0x07c0); };
+
+	Int_vector const steps = { 0, 1, 2, 3 };
+
+	Genode::Dither_matrix::Row const dither_row = Genode::Dither_matrix::row(y);
+
+	for ( ; num_values >= N; num_values -= N, dst += N, dst_alpha += N, x += N) {
+
+		Int_vector dither, d, da;
+		for (unsigned i = 0; i < N; i++) {
+			dither[i] = dither_row.value(x + i) << 12;
+			d[i]      = dst[i].pixel;
+			da[i]     = dst_alpha[i];
+		}
+
+		Int_vector const rv = (r + steps*r_ascent + dither) >> 16,
+		                 gv = (g + steps*g_ascent + dither) >> 16,
+		                 bv = (b + steps*b_ascent + dither) >> 16,
+		                 av =  a + steps*a_ascent + dither;
+
+		Int_vector const src   = ((rv << 8) & 0xf800) | ((gv << 3) & 0x07e0)
+		                       | ((bv >> 3) & 0x001f);
+		Int_vector const alpha = av >> 16;
+		Int_vector const mixed = blend(d, 264 - alpha) + blend(src, alpha);
+
+		/* multiply unsigned because the product may exceed the signed range */
+		Int_vector const coverage =
+			(Int_vector)((Uint_vector)(255 - da) * (Uint_vector)av) >> (16 + 8);
+
+		for (unsigned i = 0; i < N; i++) {
+			dst[i].pixel  = mixed[i];
+			dst_alpha[i] += coverage[i];
+		}
+
+		r += N*r_ascent;
+		g += N*g_ascent;
+		b += N*b_ascent;
+		a += N*a_ascent;
+	}
+#endif /* __SSE2__ || __ARM_NEON__ */
+
 	for ( ; num_values--; dst++, dst_alpha++, x++) {
 
 		int const dither_value = Genode::Dither_matrix::value(x, y) << 12;
@@ -0,0 +1,145 @@
+/*
+ * \brief  Cache of decoded PNG images
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _IMAGE_CACHE_H_
+#define _IMAGE_CACHE_H_
+
+/* Genode includes */
+#include <util/list.h>
+#include <util/string.h>
+#include <util/volatile_object.h>
+#include <os/pixel_rgb888.h>
+#include <os/texture_rgb888.h>
+
+/* gems includes */
+#include <gems/chunky_texture.h>
+#include <gems/png_image.h>
+#include <gems/file.h>
+
+namespace Backdrop { class Image_cache; }
+
+
+/**
+ * Decoded images, kept across config and mode changes
+ *
+ * An image is identified by its file name and a checksum of the file
+ * content. Hence, a modified file is decoded anew. Images not used by the
+ * latest configuration are evicted by calling 'evict_unused'.
+ */
+class Backdrop::Image_cache
+{
+	public:
+
+		typedef Genode::String<256> Name;
+
+		typedef Chunky_texture<Genode::Pixel_rgb888> Texture;
+
+	private:
+
+		struct Entry : Genode::List<Entry>::Element
+		{
+			Name           const name;
+			Genode::size_t const file_size;
+			unsigned       const checksum;
+
+			Genode::Lazy_volatile_object<Texture> texture;
+
+			bool used = true;
+
+			Entry(Name const &name, File &file, unsigned checksum)
+			:
+				name(name), file_size(file.size()), checksum(checksum)
+			{
+				Png_image png_image(file.data<void>());
+
+				texture.construct(*Genode::env()->ram_session(), png_image.size());
+				png_image.read(*texture);
+			}
+
+			bool matches(Name const &other_name, File &file, unsigned other_checksum) const
+			{
+				return name == other_name && file_size == file.size()
+				    && checksum == other_checksum;
+			}
+		};
+
+		Genode::Allocator &_alloc;
+
+		Genode::List<Entry> _entries;
+
+		static unsigned _checksum(File &file)
+		{
+			/* FNV-1a */
+			unsigned char const *p = file.data<unsigned char const>();
+
+			unsigned h = 2166136261U;
+			for (Genode::size_t i = 0; i < file.size(); i++)
+				h = (h ^ p[i])*16777619U;
+
+			return h;
+		}
+
+	public:
+
+		Image_cache(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Image_cache()
+		{
+			while (Entry *e = _entries.first()) {
+				_entries.remove(e);
+				Genode::destroy(_alloc, e);
+			}
+		}
+
+		/**
+		 * Return texture of the PNG image contained in 'file'
+		 *
+		 * \throw Png_image::Read_struct_failed
+		 * \throw Png_image::Info_failed
+		 */
+		Texture const &texture(Name const &name, File &file)
+		{
+			unsigned const checksum = _checksum(file);
+
+			for (Entry *e = _entries.first(); e; e = e->next())
+				if (e->matches(name, file, checksum)) {
+					e->used = true;
+					return *e->texture;
+				}
+
+			Entry * const e = new (_alloc) Entry(name, file, checksum);
+			_entries.insert(e);
+			return *e->texture;
+		}
+
+		/**
+		 * Evict the images not requested since the last call
+		 */
+		void evict_unused()
+		{
+			for (Entry *e = _entries.first(), *next = 0; e; e = next) {
+
+				next = e->next();
+
+				if (e->used) {
+					e->used = false;
+					continue;
+				}
+
+				_entries.remove(e);
+				Genode::destroy(_alloc, e);
+			}
+		}
+};
+
+#endif /* _IMAGE_CACHE_H_ */
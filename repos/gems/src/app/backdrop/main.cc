@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2009-2014 Genode Labs GmbH
+ * Copyright (C) 2009-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -30,6 +30,9 @@
 #include <gems/xml_anchor.h>
 #include <gems/texture_utils.h>
 
+/* local includes */
+#include "image_cache.h"
+
 using namespace Genode;
 
 
@@ -104,6 +107,9 @@ struct Backdrop::Main
 
 	Lazy_volatile_object<Buffer> buffer;
 
+	/* decoded images, reused when the config or the screen mode changes */
+	Image_cache image_cache { *env()->heap() };
+
 	Nitpicker::Session::View_handle view_handle = nitpicker.create_view();
 
 	void _update_view()
@@ -234,9 +240,11 @@ void Backdrop::Main::apply_image(Xml_node operation)
 
 	Anchor anchor(operation);
 
-	Png_image png_image(file.data<void>());
+	/* obtain texture containing the pixels of the PNG image */
+	Texture<Pixel_rgb888> const &png_texture =
+		image_cache.texture(Image_cache::Name(png_file_name), file);
 
-	Area const scaled_size = calc_scaled_size(operation, png_image.size(),
+	Area const scaled_size = calc_scaled_size(operation, png_texture.size(),
 	                                          Area(buffer->mode.width(),
 	                                               buffer->mode.height()));
 	/*
@@ -264,14 +272,9 @@ void Backdrop::Main::apply_image(Xml_node operation)
 
 	unsigned alpha = Decorator::attribute(operation, "alpha", 256U);
 
-	/* obtain texture containing the pixels of the PNG image */
-	Texture<Pixel_rgb888> *png_texture = png_image.texture<Pixel_rgb888>();
-
 	/* create texture with the scaled image */
 	Chunky_texture<Pixel_rgb888> scaled_texture(*env()->ram_session(), scaled_size);
-	scale(*png_texture, scaled_texture);
-
-	png_image.release_texture(png_texture);
+	scale(png_texture, scaled_texture);
 
 	/*
 	 * Code specific for the screen mode's pixel format
@@ -336,6 +339,8 @@ void Backdrop::Main::handle_config(unsigned)
 		}
 	} catch (...) { /* ignore failure to obtain config */ }
 
+	image_cache.evict_unused();
+
 	/* schedule buffer refresh */
 	nitpicker.framebuffer()->sync_sigh(sync_dispatcher);
 }
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013-2014 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -23,6 +23,7 @@
 /* decorator includes */
 #include <decorator/window_stack.h>
 #include <decorator/xml_utils.h>
+#include <decorator/pointer.h>
 
 /* local includes */
 #include "canvas.h"
@@ -69,7 +70,7 @@ struct Decorator::Main : Window_factory_base
 	Signal_rpc_member<Main> pointer_dispatcher = {
 		ep, *this, &Main::handle_pointer_update };
 
-	Attached_rom_dataspace pointer { "pointer" };
+	Pointer pointer { *nitpicker.input(), pointer_dispatcher };
 
 	Window_base::Hover hover;
 
@@ -119,7 +120,6 @@ struct Decorator::Main : Window_factory_base
 		handle_config(0);
 
 		window_layout.sigh(window_layout_dispatcher);
-		pointer.sigh(pointer_dispatcher);
 
 		nitpicker.framebuffer()->sync_sigh(nitpicker_sync_dispatcher);
 
@@ -188,23 +188,22 @@ void Decorator::Main::handle_config(unsigned)
 
 
 static Decorator::Window_base::Hover
-find_hover(Genode::Xml_node pointer_node, Decorator::Window_stack &window_stack)
+find_hover(Decorator::Pointer const &pointer, Decorator::Window_stack &window_stack)
 {
-	if (!pointer_node.has_attribute("xpos")
-	 || !pointer_node.has_attribute("ypos"))
+	if (!pointer.valid())
 		return Decorator::Window_base::Hover();
 
-	return window_stack.hover(Decorator::point_attribute(pointer_node));
+	return window_stack.hover(pointer.position());
 }
 
 
-static void update_hover_report(Genode::Xml_node pointer_node,
+static void update_hover_report(Decorator::Pointer const &pointer,
                                 Decorator::Window_stack &window_stack,
                                 Decorator::Window_base::Hover &hover,
                                 Genode::Reporter &hover_reporter)
 {
 	Decorator::Window_base::Hover const new_hover =
-		find_hover(pointer_node, window_stack);
+		find_hover(pointer, window_stack);
 
 	/* produce report only if hover state changed */
 	if (new_hover != hover) {
@@ -265,9 +264,7 @@ void Decorator::Main::handle_nitpicker_sync(unsigned)
 			 * A decorator element might have appeared or disappeared under
 			 * the pointer.
 			 */
-			if (pointer.is_valid())
-				update_hover_report(Xml_node(pointer.local_addr<char>()),
-				                    window_stack, hover, hover_reporter);
+			update_hover_report(pointer, window_stack, hover, hover_reporter);
 
 		} catch (Xml_node::Invalid_syntax) {
 
@@ -307,11 +304,8 @@ void Decorator::Main::handle_nitpicker_sync(unsigned)
 
 void Decorator::Main::handle_pointer_update(unsigned)
 {
-	pointer.update();
-
-	if (pointer.is_valid())
-		update_hover_report(Xml_node(pointer.local_addr<char>()),
-		                    window_stack, hover, hover_reporter);
+	if (pointer.update())
+		update_hover_report(pointer, window_stack, hover, hover_reporter);
 }
 
 
@@ -293,7 +293,7 @@ struct Floating_window_layouter::Main : Operations
 
 	Attached_dataspace input_ds { input.dataspace() };
 
-	Reporter window_layout_reporter  = { "window_layout" };
+	Reporter window_layout_reporter  = { "window_layout", 4096, 64*1024 };
 	Reporter resize_request_reporter = { "resize_request" };
 	Reporter focus_reporter          = { "focus" };
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -109,6 +109,8 @@ void Launcher::Main::_handle_config(unsigned)
 
 	_focus_prefix = config()->xml_node().attribute_value("focus_prefix", Label());
 
+	_subsystem_manager.keep_warm(config()->xml_node());
+
 	_panel_dialog.update(config()->xml_node());
 }
 
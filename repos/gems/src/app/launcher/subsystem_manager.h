@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -74,7 +74,8 @@ class Launcher::Subsystem_manager
 			      size_t                    ram_quota,
 			      size_t                    ram_limit,
 			      Signal_context_capability yield_response_sig_cap,
-			      Signal_context_capability exit_sig_cap)
+			      Signal_context_capability exit_sig_cap,
+			      Dataspace_capability      binary_ds)
 			:
 				Child_base(ram,
 				           label.string(),
@@ -83,12 +84,44 @@ class Launcher::Subsystem_manager
 				           ram_quota,
 				           ram_limit,
 				           yield_response_sig_cap,
-				           exit_sig_cap)
+				           exit_sig_cap,
+				           binary_ds)
 			{ }
 		};
 
 		List<Child> _children;
 
+		/**
+		 * Binary of a subsystem that is kept warm
+		 *
+		 * For subsystems declared with 'keep_warm="yes"', the ROM session
+		 * of the binary is opened when the config is imported and retained
+		 * while the subsystem is not running. So starting the subsystem
+		 * does not involve fetching the binary, e.g., from a file system.
+		 */
+		struct Warm_binary : List<Warm_binary>::Element
+		{
+			Child::Binary_name const name;
+			Rom_connection           rom;
+			Dataspace_capability     ds = rom.dataspace();
+
+			bool declared = true;  /* still present in the config */
+
+			Warm_binary(Child::Binary_name const &name, Child::Label const &label)
+			: name(name), rom(name.string(), label.string()) { }
+		};
+
+		List<Warm_binary> _warm_binaries;
+
+		Warm_binary *_warm_binary(Child::Binary_name const &name)
+		{
+			for (Warm_binary *b = _warm_binaries.first(); b; b = b->next())
+				if (b->name == name)
+					return b;
+
+			return nullptr;
+		}
+
 		void _try_response_to_resource_request()
 		{
 			for (Child *child = _children.first(); child; child = child->next())
@@ -189,6 +222,56 @@ class Launcher::Subsystem_manager
 			_ep(ep), _cap(cap), _exited_child_sig_cap(exited_child_sig_cap)
 		{ }
 
+		~Subsystem_manager()
+		{
+			while (Warm_binary *b = _warm_binaries.first()) {
+				_warm_binaries.remove(b);
+				destroy(env()->heap(), b);
+			}
+		}
+
+		/**
+		 * Import the subsystems to be kept warm from the config
+		 *
+		 * Binaries that are no longer declared as 'keep_warm' are released.
+		 */
+		void keep_warm(Xml_node config)
+		{
+			for (Warm_binary *b = _warm_binaries.first(); b; b = b->next())
+				b->declared = false;
+
+			config.for_each_sub_node("subsystem", [&] (Xml_node subsystem) {
+
+				if (!subsystem.attribute_value("keep_warm", false))
+					return;
+
+				try {
+					Child::Binary_name const name = _binary_name(subsystem);
+
+					if (Warm_binary *b = _warm_binary(name)) {
+						b->declared = true;
+						return;
+					}
+
+					Child::Label const label = string_attribute(subsystem, "name",
+					                                            Child::Label(""));
+
+					_warm_binaries.insert(new (env()->heap()) Warm_binary(name, label));
+
+				} catch (Invalid_config) {
+				} catch (Rom_connection::Rom_connection_failed) {
+					PWRN("cannot keep binary of subsystem warm"); }
+			});
+
+			for (Warm_binary *b = _warm_binaries.first(), *next = nullptr; b; b = next) {
+				next = b->next();
+				if (!b->declared) {
+					_warm_binaries.remove(b);
+					destroy(env()->heap(), b);
+				}
+			}
+		}
+
 		/**
 		 * Start subsystem
 		 *
@@ -205,12 +288,15 @@ class Launcher::Subsystem_manager
 
 			PINF("starting child '%s'", label.string());
 
+			Warm_binary const * const warm_binary = _warm_binary(binary_name);
+
 			try {
 				Child *child = new (env()->heap())
 					Child(_ram, label, binary_name.string(), _cap,
 					      ram_config.quantum, ram_config.limit,
 					      _yield_broadcast_dispatcher,
-					      _exited_child_sig_cap);
+					      _exited_child_sig_cap,
+					      warm_binary ? warm_binary->ds : Dataspace_capability());
 
 				/* configure child */
 				try {
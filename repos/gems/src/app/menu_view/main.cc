@@ -254,23 +254,38 @@ void Menu_view::Main::handle_frame_timer(unsigned)
 		Area const old_size = buffer.is_constructed() ? buffer->size() : Area();
 		Area const size     = root_widget.min_size();
 
-		if (!buffer.is_constructed() || size != old_size)
+		bool const resized = !buffer.is_constructed() || size != old_size;
+		if (resized)
 			buffer.construct(nitpicker, size, *env()->ram_session());
-		else
-			buffer->reset_surface();
 
 		root_widget.size(size);
 		root_widget.position(Point(0, 0));
 
+		/* determine the areas affected by the dialog update */
+		Dirty_rect dirty;
+		root_widget.mark_changes(dirty, Point(0, 0));
+
+		/* a new buffer must be painted completely */
+		if (resized)
+			dirty.mark_as_dirty(Rect(Point(0, 0), buffer->size()));
+
 		Surface<Pixel_rgb888> pixel_surface = buffer->pixel_surface();
 		Surface<Pixel_alpha8> alpha_surface = buffer->alpha_surface();
 
-		// XXX restrict redraw to dirty regions
-		//     don't perform a full dialog update
-		root_widget.draw(pixel_surface, alpha_surface, Point(0, 0));
+		dirty.flush([&] (Rect const &rect) {
+
+			buffer->reset_surface(rect);
+
+			pixel_surface.clip(rect);
+			alpha_surface.clip(rect);
+
+			root_widget.draw(pixel_surface, alpha_surface, Point(0, 0));
+
+			buffer->flush_surface(rect);
+			nitpicker.framebuffer()->refresh(rect.x1(), rect.y1(),
+			                                 rect.w(),  rect.h());
+		});
 
-		buffer->flush_surface();
-		nitpicker.framebuffer()->refresh(0, 0, buffer->size().w(), buffer->size().h());
 		_update_view();
 
 		schedule_redraw = false;
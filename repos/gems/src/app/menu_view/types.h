@@ -29,6 +29,7 @@
 #include <os/texture_rgb888.h>
 #include <util/volatile_object.h>
 #include <nitpicker_gfx/text_painter.h>
+#include <util/dirty_rect.h>
 
 namespace Menu_view {
 
@@ -37,6 +38,8 @@ namespace Menu_view {
 	typedef Surface_base::Point Point;
 	typedef Surface_base::Area  Area;
 	typedef Surface_base::Rect  Rect;
+
+	typedef Genode::Dirty_rect<Rect, 3> Dirty_rect;
 }
 
 #endif /* _TYPES_H_ */
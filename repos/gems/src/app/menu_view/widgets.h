@@ -119,10 +119,21 @@ class Menu_view::Widget : public List<Widget>::Element
 
 		Unique_id const _unique_id;
 
+		/*
+		 * Absolute geometry at the time of the last redraw
+		 */
+		Rect _drawn_geometry;
+
 	protected:
 
 		Widget_factory &_factory;
 
+		/*
+		 * True if the appearance of the widget changed since the last
+		 * redraw, set by the 'update' method of the widget types
+		 */
+		bool _changed = true;
+
 		List<Widget> _children;
 
 		Widget *_lookup_child(Name const &name)
@@ -162,6 +173,9 @@ class Menu_view::Widget : public List<Widget>::Element
 		{
 			_children.remove(w);
 			_factory.destroy(w);
+
+			/* reveal the area formerly covered by the child */
+			_changed = true;
 		}
 
 		void _update_child(Xml_node node)
@@ -270,8 +284,17 @@ class Menu_view::Widget : public List<Widget>::Element
 		                    Surface<Pixel_alpha8> &alpha_surface,
 		                    Point at) const
 		{
-			for (Widget const *w = _children.first(); w; w = w->next())
-				w->draw(pixel_surface, alpha_surface, at + w->geometry.p1());
+			for (Widget const *w = _children.first(); w; w = w->next()) {
+
+				Point const child_at = at + w->geometry.p1();
+
+				/* skip children outside the area to redraw */
+				if (!Rect::intersect(Rect(child_at, w->geometry.area()),
+				                     pixel_surface.clip()).valid())
+					continue;
+
+				w->draw(pixel_surface, alpha_surface, child_at);
+			}
 		}
 
 		virtual void _layout() { }
@@ -330,6 +353,33 @@ class Menu_view::Widget : public List<Widget>::Element
 			geometry = Rect(position, geometry.area());
 		}
 
+		/**
+		 * Mark areas affected by changes since the last redraw as dirty
+		 *
+		 * \param at  absolute position of the parent widget
+		 *
+		 * A widget is regarded as changed if its appearance or its
+		 * absolute geometry differs from the last redraw. In this case,
+		 * both its old and new area must be repainted.
+		 */
+		void mark_changes(Dirty_rect &dirty, Point at)
+		{
+			Rect const abs_geometry(at + geometry.p1(), geometry.area());
+
+			if (_changed || abs_geometry.p1()   != _drawn_geometry.p1()
+			             || abs_geometry.area() != _drawn_geometry.area()) {
+
+				if (_drawn_geometry.valid()) dirty.mark_as_dirty(_drawn_geometry);
+				if (abs_geometry.valid())    dirty.mark_as_dirty(abs_geometry);
+			}
+
+			_drawn_geometry = abs_geometry;
+			_changed        = false;
+
+			for (Widget *w = _children.first(); w; w = w->next())
+				w->mark_changes(dirty, abs_geometry.p1());
+		}
+
 		/**
 		 * Return unique ID of inner-most hovered widget
 		 *
@@ -440,7 +490,11 @@ struct Menu_view::Frame_widget : Widget
 
 	void update(Xml_node node) override
 	{
-		texture = _factory.styles.texture(node, "background");
+		Texture<Pixel_rgb888> const * const new_texture =
+			_factory.styles.texture(node, "background");
+
+		_changed |= (new_texture != texture);
+		texture   = new_texture;
 
 		_update_child(node);
 
@@ -671,6 +725,8 @@ struct Menu_view::Button_widget : Widget, Animator::Item
 		bool const new_hovered  = _enabled(node, "hovered");
 		bool const new_selected = _enabled(node, "selected");
 
+		_changed |= (new_hovered != hovered) || (new_selected != selected);
+
 		if (new_selected) {
 			default_texture = _factory.styles.texture(node, "selected");
 			hovered_texture = _factory.styles.texture(node, "hselected");
@@ -766,6 +822,8 @@ struct Menu_view::Button_widget : Widget, Animator::Item
 	{
 		blend.animate();
 
+		_changed = true;
+
 		animated(blend != blend.dst());
 	}
 };
@@ -787,8 +845,14 @@ struct Menu_view::Label_widget : Widget
 
 	void update(Xml_node node)
 	{
-		font = _factory.styles.font(node, "font");
-		text = Decorator::string_attribute(node, "text", Text(""));
+		Text_painter::Font const * const new_font = _factory.styles.font(node, "font");
+		Text                       const new_text =
+			Decorator::string_attribute(node, "text", Text(""));
+
+		_changed |= (new_font != font) || (new_text != text);
+
+		font = new_font;
+		text = new_text;
 	}
 
 	Area min_size() const override
@@ -21,6 +21,7 @@
 /* decorator includes */
 #include <decorator/window_stack.h>
 #include <decorator/xml_utils.h>
+#include <decorator/pointer.h>
 
 /* local includes */
 #include "window.h"
@@ -56,17 +57,17 @@ struct Decorator::Main : Window_factory_base
 	Signal_rpc_member<Main> pointer_dispatcher = {
 		ep, *this, &Main::handle_pointer_update };
 
-	Lazy_volatile_object<Attached_rom_dataspace> pointer;
-
-	Window_base::Hover hover;
-
-	Reporter hover_reporter = { "hover" };
-
 	/**
 	 * Nitpicker connection used to sync animations
 	 */
 	Nitpicker::Connection nitpicker;
 
+	Pointer pointer { *nitpicker.input(), pointer_dispatcher };
+
+	Window_base::Hover hover;
+
+	Reporter hover_reporter = { "hover" };
+
 	bool window_layout_update_needed = false;
 
 	Animator animator;
@@ -125,15 +126,6 @@ struct Decorator::Main : Window_factory_base
 
 		window_layout.sigh(window_layout_dispatcher);
 
-		try {
-			pointer.construct("pointer");
-			pointer->sigh(pointer_dispatcher);
-		} catch (Genode::Rom_connection::Rom_connection_failed) {
-			PINF("pointer information unavailable");
-
-			PDBG("is_constructed=%d", pointer.is_constructed());
-		}
-
 		nitpicker.framebuffer()->sync_sigh(nitpicker_sync_dispatcher);
 
 		hover_reporter.enabled(true);
@@ -192,23 +184,22 @@ void Decorator::Main::handle_config(unsigned)
 
 
 static Decorator::Window_base::Hover
-find_hover(Genode::Xml_node pointer_node, Decorator::Window_stack &window_stack)
+find_hover(Decorator::Pointer const &pointer, Decorator::Window_stack &window_stack)
 {
-	if (!pointer_node.has_attribute("xpos")
-	 || !pointer_node.has_attribute("ypos"))
+	if (!pointer.valid())
 		return Decorator::Window_base::Hover();
 
-	return window_stack.hover(Decorator::point_attribute(pointer_node));
+	return window_stack.hover(pointer.position());
 }
 
 
-static void update_hover_report(Genode::Xml_node pointer_node,
+static void update_hover_report(Decorator::Pointer const &pointer,
                                 Decorator::Window_stack &window_stack,
                                 Decorator::Window_base::Hover &hover,
                                 Genode::Reporter &hover_reporter)
 {
 	Decorator::Window_base::Hover const new_hover =
-		find_hover(pointer_node, window_stack);
+		find_hover(pointer, window_stack);
 
 	/* produce report only if hover state changed */
 	if (new_hover != hover) {
@@ -269,9 +260,7 @@ void Decorator::Main::handle_nitpicker_sync(unsigned)
 			 * A decorator element might have appeared or disappeared under
 			 * the pointer.
 			 */
-			if (pointer.is_constructed() && pointer->is_valid())
-				update_hover_report(Xml_node(pointer->local_addr<char>()),
-				                    window_stack, hover, hover_reporter);
+			update_hover_report(pointer, window_stack, hover, hover_reporter);
 
 		} catch (Xml_node::Invalid_syntax) {
 
@@ -304,14 +293,8 @@ void Decorator::Main::handle_nitpicker_sync(unsigned)
 
 void Decorator::Main::handle_pointer_update(unsigned)
 {
-	if (!pointer.is_constructed())
-		return;
-
-	pointer->update();
-
-	if (pointer->is_valid())
-		update_hover_report(Xml_node(pointer->local_addr<char>()),
-		                    window_stack, hover, hover_reporter);
+	if (pointer.update())
+		update_hover_report(pointer, window_stack, hover, hover_reporter);
 }
 
 
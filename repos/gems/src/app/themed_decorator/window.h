@@ -248,33 +248,77 @@ class Decorator::Window : public Window_base, public Animator::Item
 
 		Nitpicker_view _content_view { _nitpicker, (unsigned)id() };
 
-		void _reallocate_nitpicker_buffers()
+		/**
+		 * Visual state of the decorations
+		 *
+		 * The nitpicker buffers serve as cache of the pre-rendered
+		 * decorations. A buffer is repainted only if the appearance changed
+		 * or if the buffer got reallocated. Moving the window merely
+		 * re-positions the views.
+		 */
+		struct Appearance
+		{
+			int          alpha = -1;
+			Color        color;
+			int          closer_alpha = -1, maximizer_alpha = -1;
+			Window_title title;
+
+			bool operator != (Appearance const &other) const
+			{
+				return alpha           != other.alpha
+				    || color           != other.color
+				    || closer_alpha    != other.closer_alpha
+				    || maximizer_alpha != other.maximizer_alpha
+				    || title           != other.title;
+			}
+		};
+
+		Appearance _painted_appearance;
+
+		bool _top_bottom_painted = false;
+		bool _left_right_painted = false;
+
+		Appearance _appearance() const
 		{
-			Area const theme_size = _theme.background_size();
-			bool const use_alpha = true;
+			Appearance appearance;
+			appearance.alpha           = _alpha;
+			appearance.color           = _color();
+			appearance.closer_alpha    = _closer.alpha;
+			appearance.maximizer_alpha = _maximizer.alpha;
+			appearance.title           = _title;
+			return appearance;
+		}
 
-			Area const inner_size = geometry().area();
-			Area const outer_size = outer_geometry().area();
+		/*
+		 * The width of the top and bottom decorations depends on the window
+		 * width only whereas the height of the left and right decorations
+		 * depends on the window height only. So a resize operation in one
+		 * dimension leaves the other buffer intact.
+		 */
 
-			Area const size_top_bottom(outer_size.w(),
-			                           theme_size.h());
+		void _reallocate_top_bottom_buffer()
+		{
+			Area const size(outer_geometry().w(), _theme.background_size().h());
 
-			_nitpicker_top_bottom.buffer(Framebuffer::Mode(size_top_bottom.w(),
-			                                               size_top_bottom.h(),
+			_nitpicker_top_bottom.buffer(Framebuffer::Mode(size.w(), size.h(),
 			                                               Framebuffer::Mode::RGB565),
-			                             use_alpha);
+			                             true);
 
-			_buffer_top_bottom.construct(_nitpicker_top_bottom, size_top_bottom, _ram);
+			_buffer_top_bottom.construct(_nitpicker_top_bottom, size, _ram);
+			_top_bottom_painted = false;
+		}
 
-			Area const size_left_right(outer_size.w() - inner_size.w(),
-			                           outer_size.h());
+		void _reallocate_left_right_buffer()
+		{
+			Area const size(outer_geometry().w() - geometry().w(),
+			                outer_geometry().h());
 
-			_nitpicker_left_right.buffer(Framebuffer::Mode(size_left_right.w(),
-			                                               size_left_right.h(),
+			_nitpicker_left_right.buffer(Framebuffer::Mode(size.w(), size.h(),
 			                                               Framebuffer::Mode::RGB565),
-			                             use_alpha);
+			                             true);
 
-			_buffer_left_right.construct(_nitpicker_left_right, size_left_right, _ram);
+			_buffer_left_right.construct(_nitpicker_left_right, size, _ram);
+			_left_right_painted = false;
 		}
 
 		void _repaint_decorations(Nitpicker_buffer &buffer)
@@ -323,7 +367,8 @@ class Decorator::Window : public Window_base, public Animator::Item
 			_ram(ram), _theme(theme), _animator(animator),
 			_nitpicker(nitpicker), _config(config)
 		{
-			_reallocate_nitpicker_buffers();
+			_reallocate_top_bottom_buffer();
+			_reallocate_left_right_buffer();
 			_alpha.dst(_focused ? 256 : 200, 20);
 			animate();
 		}
@@ -442,14 +487,15 @@ class Decorator::Window : public Window_base, public Animator::Item
 			/*
 			 * Detect size changes
 			 */
-			if (geometry().w() != old_geometry.w()
-			 || geometry().h() != old_geometry.h()) {
+			if (geometry().w() != old_geometry.w())
+				_reallocate_top_bottom_buffer();
 
-				_reallocate_nitpicker_buffers();
+			if (geometry().h() != old_geometry.h())
+				_reallocate_left_right_buffer();
 
-				/* triggering the animation has the side effect of repainting */
+			/* triggering the animation has the side effect of repainting */
+			if (!_top_bottom_painted || !_left_right_painted)
 				trigger_animation = true;
-			}
 
 			bool focused = window_node.attribute_value("focused", false);
 
@@ -531,8 +577,17 @@ class Decorator::Window : public Window_base, public Animator::Item
 
 			Animator::Item::animated(animated());
 
-			_repaint_decorations(*_buffer_top_bottom);
-			_repaint_decorations(*_buffer_left_right);
+			Appearance const appearance = _appearance();
+			bool const appearance_changed = appearance != _painted_appearance;
+
+			if (appearance_changed || !_top_bottom_painted)
+				_repaint_decorations(*_buffer_top_bottom);
+
+			if (appearance_changed || !_left_right_painted)
+				_repaint_decorations(*_buffer_left_right);
+
+			_painted_appearance = appearance;
+			_top_bottom_painted = _left_right_painted = true;
 		}
 };
 
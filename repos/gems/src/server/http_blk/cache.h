@@ -0,0 +1,147 @@
+/*
+ * \brief  Cache of recently fetched file ranges
+ * \author Sebastian Sumpf <Sebastian.Sumpf@genode-labs.com>
+ * \date   2015-11-23
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+#include <base/env.h>
+#include <util/string.h>
+
+/**
+ * File content cached in units of aligned chunks
+ *
+ * Chunks are replaced in least-recently-used order. A cache of size zero
+ * is disabled.
+ */
+class Cache
+{
+	typedef Genode::size_t size_t;
+
+	public:
+
+		enum { CHUNK_SIZE = 64 * 1024 };
+
+	private:
+
+		struct Slot
+		{
+			size_t        chunk;
+			bool          valid;
+			unsigned long used;   /* time stamp of last access */
+		};
+
+		unsigned const _count;
+		Slot          *_slots;
+		char          *_data;
+		unsigned long  _now;
+
+		char *_slot_data(unsigned i) { return _data + (size_t)i * CHUNK_SIZE; }
+
+		int _lookup(size_t chunk)
+		{
+			for (unsigned i = 0; i < _count; i++)
+				if (_slots[i].valid && _slots[i].chunk == chunk) {
+					_slots[i].used = ++_now;
+					return i;
+				}
+			return -1;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param size  cache size in bytes
+		 */
+		Cache(size_t size) : _count(size / CHUNK_SIZE), _slots(0), _data(0), _now(0)
+		{
+			if (!_count)
+				return;
+
+			Genode::env()->heap()->alloc(_count * sizeof(Slot), &_slots);
+			Genode::env()->heap()->alloc((size_t)_count * CHUNK_SIZE, &_data);
+			for (unsigned i = 0; i < _count; i++)
+				_slots[i].valid = false;
+		}
+
+		~Cache()
+		{
+			if (!_count)
+				return;
+
+			Genode::env()->heap()->free(_slots, _count * sizeof(Slot));
+			Genode::env()->heap()->free(_data, (size_t)_count * CHUNK_SIZE);
+		}
+
+		bool enabled() const { return _count > 0; }
+
+		/**
+		 * Return number of bytes the cache is able to hold
+		 */
+		size_t capacity() const { return (size_t)_count * CHUNK_SIZE; }
+
+		/**
+		 * Return buffer for the content of 'chunk'
+		 *
+		 * The least recently used slot gets evicted if the chunk is not
+		 * cached yet.
+		 */
+		char *insert(size_t chunk)
+		{
+			int i = _lookup(chunk);
+			if (i >= 0)
+				return _slot_data(i);
+
+			unsigned victim = 0;
+			for (unsigned j = 0; j < _count; j++) {
+				if (!_slots[j].valid) { victim = j; break; }
+				if (_slots[j].used < _slots[victim].used) victim = j;
+			}
+
+			_slots[victim].chunk = chunk;
+			_slots[victim].valid = true;
+			_slots[victim].used  = ++_now;
+			return _slot_data(victim);
+		}
+
+		/**
+		 * Copy file range out of the cache
+		 *
+		 * \return false if the range is not completely cached
+		 */
+		bool read(size_t offset, size_t size, char *dst)
+		{
+			if (!_count)
+				return false;
+
+			/* check first, to not copy partially */
+			for (size_t c = offset / CHUNK_SIZE; c * CHUNK_SIZE < offset + size; c++)
+				if (_lookup(c) < 0)
+					return false;
+
+			while (size) {
+				size_t const chunk = offset / CHUNK_SIZE;
+				size_t const off   = offset % CHUNK_SIZE;
+				size_t const n     = Genode::min(size, CHUNK_SIZE - off);
+
+				Genode::memcpy(dst, _slot_data(_lookup(chunk)) + off, n);
+				dst    += n;
+				offset += n;
+				size   -= n;
+			}
+			return true;
+		}
+};
+
+#endif /* _CACHE_H_ */
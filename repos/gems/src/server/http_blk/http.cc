@@ -83,7 +83,12 @@ void Http::connect()
 }
 
 
-void Http::reconnect(){ close(_fd); connect(); }
+void Http::reconnect()
+{
+	close(_fd);
+	_rx_pos = _rx_len = 0;
+	connect();
+}
 
 
 void Http::resolve_uri()
@@ -104,8 +109,7 @@ Genode::size_t Http::read_header()
 	bool header = true; size_t i = 0;
 
 	while (header) {
-		if (!read(_fd, &_http_buf[i], 1))
-			throw Http::Socket_closed();
+		_http_buf[i] = read_char();
 
 		/* DEBUG: Genode::printf("%c", _http_buf[i]); */
 
@@ -138,6 +142,21 @@ Genode::size_t Http::read_header()
 }
 
 
+char Http::read_char()
+{
+	if (_rx_pos == _rx_len) {
+		int const n = read(_fd, _rx_buf, HTTP_BUF);
+		if (n <= 0)
+			throw Http::Socket_closed();
+
+		_rx_pos = 0;
+		_rx_len = n;
+	}
+
+	return _rx_buf[_rx_pos++];
+}
+
+
 void Http::get_capacity()
 {
 	cmd_head();
@@ -176,6 +195,13 @@ void Http::do_read(void * buf, size_t size)
 {
 	size_t buf_fill = 0;
 
+	/* consume data already received along with the header */
+	if (_rx_pos < _rx_len) {
+		buf_fill = Genode::min(size, _rx_len - _rx_pos);
+		Genode::memcpy(buf, _rx_buf + _rx_pos, buf_fill);
+		_rx_pos += buf_fill;
+	}
+
 	while (buf_fill < size) {
 
 		int part;
@@ -193,9 +219,10 @@ void Http::do_read(void * buf, size_t size)
 }
 
 
-Http::Http(char *uri) : _port((char *)"80")
+Http::Http(char *uri) : _port((char *)"80"), _rx_pos(0), _rx_len(0)
 {
 	env()->heap()->alloc(HTTP_BUF, &_http_buf);
+	env()->heap()->alloc(HTTP_BUF, &_rx_buf);
 
 	/* parse URI */
 	parse_uri(uri);
@@ -216,6 +243,7 @@ Http::~Http()
 	env()->heap()->free(_host, Genode::strlen(_host) + 1);
 	env()->heap()->free(_path, Genode::strlen(_path) + 2);
 	env()->heap()->free(_http_buf, HTTP_BUF);
+	env()->heap()->free(_rx_buf, HTTP_BUF);
 	env()->heap()->free(_info, sizeof(struct addrinfo));
 }
 
@@ -255,42 +283,55 @@ void Http::parse_uri(char *uri)
 }
 
 
-void Http::cmd_get(size_t file_offset, size_t size, addr_t buffer)
+void Http::send_get(size_t file_offset, size_t size)
 {
 	if (verbose)
-		PDBG("Read: offs %zu  size: %zu I/O buffer: %lx", file_offset, size, buffer);
+		PDBG("Request: offs %zu  size: %zu", file_offset, size);
 
-	while (true) {
+	const char *http_templ = "GET %s HTTP/1.1\r\n"
+	                         "Host: %s\r\n"
+	                         "Range: bytes=%lu-%lu\r\n"
+	                         "\r\n";
 
-		const char *http_templ = "GET %s HTTP/1.1\r\n"
-		                         "Host: %s\r\n"
-		                         "Range: bytes=%lu-%lu\r\n"
-		                         "\r\n";
+	int length = snprintf(_http_buf, HTTP_BUF, http_templ, _path, _host,
+	                      file_offset, file_offset + size - 1);
 
-		int length = snprintf(_http_buf, HTTP_BUF, http_templ, _path, _host,
-		                      file_offset, file_offset + size - 1);
+	if (write(_fd, _http_buf, length) < 0) {
 
-		if (write(_fd, _http_buf, length) < 0) {
+		if (errno == ESHUTDOWN)
+			throw Http::Socket_closed();
 
-			if (errno == ESHUTDOWN)
-				reconnect();
+		throw Http::Socket_error();
+	}
+}
+
+
+void Http::recv_get()
+{
+	read_header();
+
+	if (_http_ret != HTTP_SUCC_PARTIAL) {
+		PERR("Error: Server returned %u", _http_ret);
+		throw Http::Server_error();
+	}
+}
 
-			if (write(_fd, _http_buf, length) < 0)
-				throw Http::Socket_error();
-		}
+
+void Http::cmd_get(size_t file_offset, size_t size, addr_t buffer)
+{
+	if (verbose)
+		PDBG("Read: offs %zu  size: %zu I/O buffer: %lx", file_offset, size, buffer);
+
+	while (true) {
 
 		try {
-			read_header();
+			send_get(file_offset, size);
+			recv_get();
 		} catch (Http::Socket_closed) {
 			reconnect();
 			continue;
 		}
 
-		if (_http_ret != HTTP_SUCC_PARTIAL) {
-			PERR("Error: Server returned %u", _http_ret);
-			throw Http::Server_error();
-		}
-
 		do_read((void *)(buffer), size);
 		return;
 	}
@@ -35,6 +35,9 @@ class Http
 		struct addrinfo *_info;      /* Resolved address info for host */
 		int              _fd;        /* Socket file handle */
 		addr_t          _base_addr; /* Address of I/O dataspace */
+		char            *_rx_buf;    /* socket receive buffer */
+		size_t           _rx_pos;    /* first unconsumed byte in '_rx_buf' */
+		size_t           _rx_len;    /* number of valid bytes in '_rx_buf' */
 
 		/*
 		 * Send 'HEAD' command
@@ -46,11 +49,6 @@ class Http
 		 */
 		void connect();
 
-		/*
-		 * Re-connect to host
-		 */
-		void reconnect();
-
 		/*
 		 * Set URI of remote file
 		 */
@@ -66,6 +64,11 @@ class Http
 		 */
 		size_t read_header();
 
+		/*
+		 * Read one character of the response
+		 */
+		char read_char();
+
 		/*
 		 * Determine remote-file size
 		 */
@@ -111,6 +114,37 @@ class Http
 		 */
 		void cmd_get(size_t file_offset, size_t size, addr_t buffer);
 
+		/**
+		 * Send 'GET' command without waiting for the response
+		 *
+		 * Several requests may be sent before their responses are received
+		 * in the same order via 'recv_get' and 'recv_body' (pipelining).
+		 *
+		 * \param file_offset  Read from offset of remote file
+		 * \param size         Number of bytes to request
+		 *
+		 * \throw Socket_closed  server closed the connection
+		 */
+		void send_get(size_t file_offset, size_t size);
+
+		/**
+		 * Receive header of response to the oldest pending 'GET' command
+		 *
+		 * \throw Socket_closed  server closed the connection
+		 * \throw Server_error   server did not return the requested range
+		 */
+		void recv_get();
+
+		/**
+		 * Receive 'size' bytes of the response body
+		 */
+		void recv_body(void *buffer, size_t size) { do_read(buffer, size); }
+
+		/*
+		 * Re-connect to host, dropping all pending responses
+		 */
+		void reconnect();
+
 		/* Exceptions */
 		class Exception     : public ::Genode::Exception { };
 		class Uri_error     : public Exception { };
@@ -18,6 +18,7 @@
 #include <os/config.h>
 
 /* local includes */
+#include "cache.h"
 #include "http.h"
 
 using namespace Genode;
@@ -26,13 +27,177 @@ class Driver : public Block::Driver
 {
 	private:
 
-		size_t _block_size;
-		Http   _http;
+		enum {
+			MAX_REQUESTS = 16,
+			MAX_RANGE    = 1024 * 1024, /* maximum bytes per 'GET' command */
+		};
+
+		struct Request
+		{
+			Block::Packet_descriptor packet;
+			size_t                   offset;
+			size_t                   size;
+			char                    *buffer;
+			bool                     success;
+		};
+
+		/*
+		 * Contiguous file range fetched by one 'GET' command on behalf of
+		 * the requests 'first' to 'last'
+		 */
+		struct Range
+		{
+			size_t   offset;
+			size_t   size;
+			unsigned first;
+			unsigned last;
+			bool     cached;
+		};
+
+		size_t   _block_size;
+		Http     _http;
+		Cache    _cache;
+		Request  _requests[MAX_REQUESTS];
+		unsigned _count;
+
+		size_t _max_range() const
+		{
+			return _cache.enabled() ? min((size_t)MAX_RANGE, _cache.capacity() / 2)
+			                        : (size_t)MAX_RANGE;
+		}
+
+		size_t _align_down(size_t o) const {
+			return o & ~((size_t)Cache::CHUNK_SIZE - 1); }
+
+		size_t _align_up(size_t o) {
+			return min(_http.file_size(), _align_down(o + Cache::CHUNK_SIZE - 1)); }
+
+		/**
+		 * Coalesce requests to adjacent file ranges
+		 *
+		 * With the cache enabled, ranges cover whole chunks so that
+		 * neighboring data is fetched along with the request.
+		 */
+		unsigned _coalesce(Request const *requests, unsigned count, Range *ranges)
+		{
+			unsigned n = 0;
+			for (unsigned i = 0; i < count; i++) {
+
+				Request const &r = requests[i];
+
+				bool   const cached = _cache.enabled() &&
+				                      _align_up(r.offset + r.size) - _align_down(r.offset)
+				                      <= _max_range();
+				size_t const start  = cached ? _align_down(r.offset) : r.offset;
+				size_t const end    = cached ? _align_up(r.offset + r.size)
+				                             : r.offset + r.size;
+
+				if (n) {
+					Range &last = ranges[n - 1];
+					size_t const last_end = last.offset + last.size;
+
+					bool const adjacent = cached ? start <= last_end && start >= last.offset
+					                             : start == last_end;
+
+					if (last.cached == cached && adjacent &&
+					    max(end, last_end) - last.offset <= _max_range()) {
+						last.size = max(end, last_end) - last.offset;
+						last.last = i;
+						continue;
+					}
+				}
+				ranges[n++] = { start, end - start, i, i, cached };
+			}
+			return n;
+		}
+
+		/**
+		 * Receive response body of 'range'
+		 */
+		void _receive(Range const &range, Request *requests)
+		{
+			if (!range.cached) {
+				for (unsigned i = range.first; i <= range.last; i++) {
+					_http.recv_body(requests[i].buffer, requests[i].size);
+					requests[i].success = true;
+				}
+				return;
+			}
+
+			for (size_t o = range.offset; o < range.offset + range.size; o += Cache::CHUNK_SIZE)
+				_http.recv_body(_cache.insert(o / Cache::CHUNK_SIZE),
+				                min((size_t)Cache::CHUNK_SIZE, range.offset + range.size - o));
+
+			for (unsigned i = range.first; i <= range.last; i++) {
+				Request &r = requests[i];
+				r.success = _cache.read(r.offset, r.size, r.buffer);
+			}
+		}
+
+		/**
+		 * Fetch all recorded requests
+		 *
+		 * The 'GET' commands for all ranges are sent before receiving the
+		 * first response, so the round trips to the server overlap.
+		 */
+		void _submit()
+		{
+			if (!_count)
+				return;
+
+			/* take over requests, 'ack_packet' may record new ones */
+			Request  requests[MAX_REQUESTS];
+			unsigned const count = _count;
+			for (unsigned i = 0; i < count; i++)
+				requests[i] = _requests[i];
+			_count = 0;
+
+			Range    ranges[MAX_REQUESTS];
+			unsigned const num_ranges = _coalesce(requests, count, ranges);
+
+			unsigned next = 0;
+			while (next < num_ranges) {
+				try {
+					for (unsigned i = next; i < num_ranges; i++)
+						_http.send_get(ranges[i].offset, ranges[i].size);
+
+					for (; next < num_ranges; next++) {
+						_http.recv_get();
+						_receive(ranges[next], requests);
+					}
+				}
+				catch (Http::Socket_closed) {
+
+					/* re-send commands without a response */
+					_http.reconnect();
+				}
+				catch (Http::Exception) {
+
+					/* pending responses are out of sync */
+					_http.reconnect();
+					next++;
+				}
+			}
+
+			/* retry failed requests one by one */
+			for (unsigned i = 0; i < count; i++) {
+				Request &r = requests[i];
+				if (r.success)
+					continue;
+				try {
+					_http.cmd_get(r.offset, r.size, (addr_t)r.buffer);
+					r.success = true;
+				} catch (Http::Exception) { }
+			}
+
+			for (unsigned i = 0; i < count; i++)
+				ack_packet(requests[i].packet, requests[i].success);
+		}
 
 	public:
 
-		Driver(size_t block_size, char *uri)
-		: _block_size(block_size), _http(uri) {}
+		Driver(size_t block_size, char *uri, size_t cache_size)
+		: _block_size(block_size), _http(uri), _cache(cache_size), _count(0) {}
 
 
 		/*******************************
@@ -54,10 +219,23 @@ class Driver : public Block::Driver
 		          char                     *buffer,
 		          Block::Packet_descriptor &packet)
 		{
-			_http.cmd_get(block_nr * _block_size, block_count * _block_size,
-			              (addr_t)buffer);
-			ack_packet(packet);
+			size_t const offset = block_nr * _block_size;
+			size_t const size   = block_count * _block_size;
+
+			if (_cache.read(offset, size, buffer)) {
+				ack_packet(packet);
+				return;
+			}
+
+			if (_count == MAX_REQUESTS)
+				_submit();
+
+			_requests[_count++] = { packet, offset, size, buffer, false };
 		}
+
+		void submit_deferred() { _submit(); }
+
+		void sync() { _submit(); }
 	};
 
 
@@ -67,10 +245,11 @@ class Factory : public Block::Driver_factory
 
 		char   _uri[64];
 		size_t _blk_sz;
+		size_t _cache_sz;
 
 	public:
 
-		Factory() : _blk_sz(512)
+		Factory() : _blk_sz(512), _cache_sz(0)
 		{
 			try {
 				config()->xml_node().attribute("uri").value(_uri, sizeof(_uri));
@@ -78,11 +257,20 @@ class Factory : public Block::Driver_factory
 			}
 			catch (...) { }
 
+			try {
+				Number_of_bytes cache_sz = 0;
+				config()->xml_node().attribute("cache_size").value(&cache_sz);
+				_cache_sz = cache_sz;
+			}
+			catch (...) { }
+
 			PINF("Using file=%s as device with block size %zx.", _uri, _blk_sz);
+			if (_cache_sz)
+				PINF("Caching %zu KiB of the file.", _cache_sz / 1024);
 		}
 
 		Block::Driver *create() {
-			return new (env()->heap()) Driver(_blk_sz, _uri); }
+			return new (env()->heap()) Driver(_blk_sz, _uri, _cache_sz); }
 
 	void destroy(Block::Driver *driver) {
 		Genode::destroy(env()->heap(), driver); }
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -17,8 +17,10 @@
 #include <base/printf.h>
 #include <base/rpc_server.h>
 #include <base/heap.h>
+#include <base/thread.h>
 #include <root/component.h>
 #include <terminal_session/terminal_session.h>
+#include <terminal_session/ring.h>
 #include <cap_session/connection.h>
 #include <os/attached_ram_dataspace.h>
 #include <os/session_policy.h>
@@ -384,23 +386,106 @@ Open_socket::~Open_socket()
 }
 
 
+/**
+ * Signal context of a write ring
+ */
+struct Write_ring_handler : Genode::Signal_context
+{
+	virtual void handle_write_ring() = 0;
+};
+
+
+/**
+ * Thread that transfers the content of the write rings to the sockets
+ *
+ * The main thread blocks in 'select' and the entrypoint serves the RPC
+ * requests. Hence, the signals indicating new data in the write rings are
+ * handled by a thread of their own.
+ */
+class Write_ring_thread : public Genode::Thread<4*4096>
+{
+	private:
+
+		Genode::Signal_receiver _sig_rec;
+
+		void entry()
+		{
+			for (;;) {
+				Genode::Signal sig = _sig_rec.wait_for_signal();
+				static_cast<Write_ring_handler *>(sig.context())->handle_write_ring();
+			}
+		}
+
+	public:
+
+		Write_ring_thread() : Thread("write_ring") { start(); }
+
+		Genode::Signal_context_capability manage(Write_ring_handler &handler) {
+			return _sig_rec.manage(&handler); }
+
+		void dissolve(Write_ring_handler &handler) { _sig_rec.dissolve(&handler); }
+};
+
+
+static Write_ring_thread &write_ring_thread()
+{
+	static Write_ring_thread inst;
+	return inst;
+}
+
+
 namespace Terminal {
 
 	class Session_component : public Genode::Rpc_object<Session, Session_component>,
-	                          public Open_socket
+	                          public Open_socket,
+	                          private Write_ring_handler
 	{
 		private:
 
 			Genode::Attached_ram_dataspace _io_buffer;
 
+			/*
+			 * Ring for the write direction
+			 */
+			Genode::Attached_ram_dataspace    _ring_ds;
+			Ring                              _ring { _ring_ds.local_addr<void>(),
+			                                          _ring_ds.size() };
+			Genode::Signal_context_capability _space_avail_sigh;
+			Genode::Signal_context_capability _data_avail_sigh;
+
+			/**
+			 * Write_ring_handler interface, called by the write-ring thread
+			 */
+			void handle_write_ring() override
+			{
+				bool const writer_waiting =
+					_ring.consume([&] (char const *src, Genode::size_t n) {
+
+						ssize_t const written = ::write(sd(), src, n);
+						if (written > 0)
+							return (Genode::size_t)written;
+
+						PERR("write error, dropping data");
+						return n;
+					});
+
+				if (writer_waiting && _space_avail_sigh.valid())
+					Genode::Signal_transmitter(_space_avail_sigh).submit();
+			}
+
 		public:
 
-			Session_component(Genode::size_t io_buffer_size, int tcp_port)
+			Session_component(Genode::size_t io_buffer_size,
+			                  Genode::size_t write_ring_size, int tcp_port)
 			:
 				Open_socket(tcp_port),
-				_io_buffer(Genode::env()->ram_session(), io_buffer_size)
+				_io_buffer(Genode::env()->ram_session(), io_buffer_size),
+				_ring_ds(Genode::env()->ram_session(), write_ring_size),
+				_data_avail_sigh(write_ring_thread().manage(*this))
 			{ }
 
+			~Session_component() { write_ring_thread().dissolve(*this); }
+
 			/********************************
 			 ** Terminal session interface **
 			 ********************************/
@@ -443,6 +528,18 @@ namespace Terminal {
 				return _io_buffer.cap();
 			}
 
+			Genode::Dataspace_capability _write_ring()
+			{
+				return _ring_ds.cap();
+			}
+
+			Genode::Signal_context_capability
+			_write_ring_sigh(Genode::Signal_context_capability sigh)
+			{
+				_space_avail_sigh = sigh;
+				return _data_avail_sigh;
+			}
+
 			void read_avail_sigh(Genode::Signal_context_capability sigh)
 			{
 				Open_socket::read_avail_sigh(sigh);
@@ -467,7 +564,8 @@ namespace Terminal {
 				/*
 				 * XXX read I/O buffer size from args
 				 */
-				Genode::size_t io_buffer_size = 4096;
+				Genode::size_t io_buffer_size  = 4096;
+				Genode::size_t write_ring_size = 16*1024;
 
 				try {
 					Genode::Session_label  label(args);
@@ -476,7 +574,8 @@ namespace Terminal {
 					unsigned tcp_port = 0;
 					policy.attribute("port").value(&tcp_port);
 					return new (md_alloc())
-					       Session_component(io_buffer_size, tcp_port);
+					       Session_component(io_buffer_size, write_ring_size,
+					                         tcp_port);
 
 				} catch (Genode::Xml_node::Nonexistent_attribute) {
 					PERR("Missing \"port\" attribute in policy definition");
@@ -25,6 +25,7 @@
 #include <os/config.h>
 #include <util/color.h>
 #include <os/pixel_rgb565.h>
+#include <blit/blit.h>
 
 /* terminal includes */
 #include <terminal/decoder.h>
@@ -310,6 +311,56 @@ namespace Terminal {
 				return _framebuffer->dataspace();
 			}
 
+			/**
+			 * Move the pixels of the lines 'src' to 'dst'
+			 */
+			void _move_lines(int src, int dst, int num_lines)
+			{
+				Genode::size_t const line_bytes =
+					_fb_mode.width()*_char_height*sizeof(Pixel_rgb565);
+
+				char * const fb = (char *)_fb_addr;
+
+				blit(fb + src*line_bytes, _fb_mode.width()*sizeof(Pixel_rgb565),
+				     fb + dst*line_bytes, _fb_mode.width()*sizeof(Pixel_rgb565),
+				     _fb_mode.width()*sizeof(Pixel_rgb565),
+				     num_lines*_char_height);
+			}
+
+			/**
+			 * Apply pending scrolling by moving the framebuffer content
+			 *
+			 * Only the lines revealed by the scrolling remain to be drawn.
+			 * Because 'blit' does not support overlapping areas, the
+			 * lines are moved in chunks of at most the scroll distance.
+			 *
+			 * \return  scrolled region, or an empty scroll if nothing moved
+			 */
+			Cell_array<Char_cell>::Scroll _apply_scroll()
+			{
+				typedef Cell_array<Char_cell>::Scroll Scroll;
+
+				Scroll const scroll = _char_cell_array.pending_scroll();
+				_char_cell_array.mark_scroll_as_applied();
+
+				int const n = scroll.lines > 0 ? scroll.lines : -scroll.lines;
+
+				/* all lines of the region are dirty if shifted out entirely */
+				if (!scroll.pending() || n > scroll.end - scroll.start)
+					return Scroll();
+
+				if (scroll.lines > 0) {
+					for (int l = scroll.start; l <= scroll.end - n; l += n)
+						_move_lines(l + n, l, Genode::min(n, scroll.end - n - l + 1));
+				} else {
+					for (int l = scroll.end; l >= scroll.start + n; l -= n) {
+						int const cnt = Genode::min(n, l - scroll.start - n + 1);
+						_move_lines(l - cnt + 1 - n, l - cnt + 1, cnt);
+					}
+				}
+				return scroll;
+			}
+
 		public:
 
 			/**
@@ -344,6 +395,8 @@ namespace Terminal {
 			{
 				using namespace Genode;
 
+				_char_cell_array.track_scroll(true);
+
 				printf("new terminal session:\n");
 				printf("  framebuffer has %dx%d pixels\n", _fb_mode.width(), _fb_mode.height());
 				printf("  character size is %dx%d pixels\n", _char_width, _char_height);
@@ -363,16 +416,23 @@ namespace Terminal {
 			{
 				Genode::Lock::Guard guard(_lock);
 
+				/* all scrolling since the last flush is applied at once */
+				Cell_array<Char_cell>::Scroll const scroll = _apply_scroll();
+
 				convert_char_array_to_pixels<Pixel_rgb565>(&_char_cell_array,
 				                                           (Pixel_rgb565 *)_fb_addr,
 				                                           _fb_mode.width(),
 				                                           _fb_mode.height(),
 				                                          *_font_family);
 
-				
 				int first_dirty_line =  10000,
 				    last_dirty_line  = -10000;
 
+				if (scroll.pending()) {
+					first_dirty_line = scroll.start;
+					last_dirty_line  = scroll.end;
+				}
+
 				for (int line = 0; line < (int)_char_cell_array.num_lines(); line++) {
 					if (!_char_cell_array.line_dirty(line)) continue;
 
@@ -1,4 +1,4 @@
 TARGET  = terminal
 SRC_CC  = main.cc
-LIBS    = base config
+LIBS    = base config blit
 SRC_BIN = $(notdir $(wildcard $(PRG_DIR)/*.tff))
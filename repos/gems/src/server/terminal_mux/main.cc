@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -234,6 +234,7 @@ namespace Terminal {
 				_char_cell_array_character_screen(_char_cell_array),
 				_decoder(_char_cell_array_character_screen)
 			{
+				_char_cell_array.track_scroll(true);
 				_session_manager.add(this);
 			}
 
@@ -248,25 +249,41 @@ namespace Terminal {
 			 ** Registry::Entry interface **
 			 *******************************/
 
+			/*
+			 * The screen is updated periodically, which batches the output
+			 * of bursty clients. Pending scrolling is applied to the ncurses
+			 * window first, so that only the revealed lines and the lines
+			 * changed otherwise must be transferred. Within those lines,
+			 * ncurses emits only the changed characters.
+			 */
 			void flush()
 			{
-				convert_char_array_to_window(&_char_cell_array, _window);
+				Terminal::Position const cursor_pos =
+					_char_cell_array_character_screen.cursor_pos();
 
-				int first_dirty_line =  10000,
-				    last_dirty_line  = -10000;
+				Cell_array<Char_cell>::Scroll const scroll =
+					_char_cell_array.pending_scroll();
 
-				for (int line = 0; line < (int)_char_cell_array.num_lines(); line++) {
-					if (!_char_cell_array.line_dirty(line)) continue;
+				bool dirty = scroll.pending() || cursor_pos != _last_cursor_pos;
+				for (unsigned line = 0; line < _char_cell_array.num_lines(); line++)
+					dirty |= _char_cell_array.line_dirty(line);
 
-					first_dirty_line = Genode::min(line, first_dirty_line);
-					last_dirty_line  = Genode::max(line, last_dirty_line);
+				/* skip the update of an unchanged screen */
+				if (!dirty)
+					return;
 
-					_char_cell_array.mark_line_as_clean(line);
+				if (scroll.pending()) {
+					_window.scroll(scroll.start, scroll.end, scroll.lines);
+					_char_cell_array.mark_scroll_as_applied();
 				}
 
-				Terminal::Position cursor_pos =
-					_char_cell_array_character_screen.cursor_pos();
+				convert_char_array_to_window(&_char_cell_array, _window);
+
+				for (unsigned line = 0; line < _char_cell_array.num_lines(); line++)
+					_char_cell_array.mark_line_as_clean(line);
+
 				_window.move_cursor(cursor_pos.x, cursor_pos.y);
+				_last_cursor_pos = cursor_pos;
 
 				_window.refresh();
 			}
@@ -276,6 +293,9 @@ namespace Terminal {
 				for (unsigned line = 0; line < _char_cell_array.num_lines(); line++)
 					_char_cell_array.mark_line_as_dirty(line);
 
+				/* the whole window gets redrawn anyway */
+				_char_cell_array.mark_scroll_as_applied();
+
 				_window.erase();
 				flush();
 			}
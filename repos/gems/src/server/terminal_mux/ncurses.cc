@@ -25,8 +25,11 @@ struct Ncurses::Window::Ncurses_window : WINDOW { };
 Ncurses::Window::Window(unsigned x, unsigned y, unsigned w, unsigned h)
 :
 	_window(static_cast<Ncurses::Window::Ncurses_window *>(newwin(h, w, y, x))),
-	_w(w)
-{ }
+	_w(w), _h(h)
+{
+	/* allow ncurses to use the line-scrolling capabilities of the terminal */
+	idlok(_window, true);
+}
 
 
 Ncurses::Window::~Window()
@@ -66,6 +69,16 @@ void Ncurses::Window::horizontal_line(int line)
 }
 
 
+void Ncurses::Window::scroll(int start, int end, int lines)
+{
+	scrollok(_window, true);
+	wsetscrreg(_window, start, end);
+	wscrl(_window, lines);
+	wsetscrreg(_window, 0, _h - 1);
+	scrollok(_window, false);
+}
+
+
 Ncurses::Window *Ncurses::create_window(int x, int y, int w, int h)
 {
 	return new (Genode::env()->heap()) Ncurses::Window(x, y, w, h);
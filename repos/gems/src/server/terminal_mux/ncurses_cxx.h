@@ -26,7 +26,7 @@ class Ncurses
 
 				Ncurses_window * const _window;
 
-				int _w;
+				int _w, _h;
 
 				Window(unsigned x, unsigned y, unsigned w, unsigned h);
 
@@ -43,6 +43,16 @@ class Ncurses
 				void erase();
 
 				void horizontal_line(int line);
+
+				/**
+				 * Scroll the lines 'start' to 'end' by 'lines' upwards
+				 *
+				 * Negative values of 'lines' scroll downwards. On the next
+				 * update, ncurses applies the scrolling by using the
+				 * scroll-region capability of the terminal instead of
+				 * redrawing the region.
+				 */
+				void scroll(int start, int end, int lines);
 		};
 
 		Window *create_window(int x, int y, int w, int h);
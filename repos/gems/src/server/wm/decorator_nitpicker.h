@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -175,7 +175,9 @@ struct Wm::Decorator_nitpicker_session : Genode::Rpc_object<Nitpicker::Session>,
 
 	Attached_dataspace _nitpicker_input_ds { _nitpicker_input.dataspace() };
 
-	Reporter &_pointer_reporter;
+	/* pointer position supplied to the decorator as motion events */
+	Input::Session_component &_pointer_input;
+	Input::Session_capability _pointer_input_cap;
 
 	Last_motion &_last_motion;
 
@@ -200,13 +202,15 @@ struct Wm::Decorator_nitpicker_session : Genode::Rpc_object<Nitpicker::Session>,
 	 */
 	Decorator_nitpicker_session(Ram_session_capability ram,
 	                            Entrypoint &ep, Allocator &md_alloc,
-	                            Reporter &pointer_reporter,
+	                            Input::Session_component &pointer_input,
+	                            Input::Session_capability pointer_input_cap,
 	                            Last_motion &last_motion,
 	                            Input::Session_component &window_layouter_input,
 	                            Decorator_content_callback &content_callback)
 	:
 		_ram(ram),
-		_pointer_reporter(pointer_reporter),
+		_pointer_input(pointer_input),
+		_pointer_input_cap(pointer_input_cap),
 		_last_motion(last_motion),
 		_window_layouter_input(window_layouter_input),
 		_content_callback(content_callback),
@@ -234,11 +238,13 @@ struct Wm::Decorator_nitpicker_session : Genode::Rpc_object<Nitpicker::Session>,
 
 					_last_motion = LAST_MOTION_DECORATOR;
 
-					Reporter::Xml_generator xml(_pointer_reporter, [&] ()
-					{
-						xml.attribute("xpos", ev.ax());
-						xml.attribute("ypos", ev.ay());
-					});
+					/*
+					 * Consecutive motion events are merged when the
+					 * decorator flushes its input session. So the decorator
+					 * observes only the latest position if it cannot keep up.
+					 */
+					_pointer_input.submit(Input::Event(Input::Event::MOTION, 0,
+					                                   ev.ax(), ev.ay(), 0, 0));
 				}
 
 				if (ev.type() == Input::Event::LEAVE) {
@@ -252,10 +258,9 @@ struct Wm::Decorator_nitpicker_session : Genode::Rpc_object<Nitpicker::Session>,
 					 * update the pointer model with the entered position
 					 * already.
 					 */
-					if (_last_motion == LAST_MOTION_DECORATOR) {
-						Reporter::Xml_generator xml(_pointer_reporter, [&] ()
-						{ });
-					}
+					if (_last_motion == LAST_MOTION_DECORATOR)
+						_pointer_input.submit(Input::Event(Input::Event::LEAVE,
+						                                   0, 0, 0, 0, 0));
 				}
 
 				_window_layouter_input.submit(ev);
@@ -378,10 +383,11 @@ struct Wm::Decorator_nitpicker_session : Genode::Rpc_object<Nitpicker::Session>,
 	Input::Session_capability input_session() override
 	{
 		/*
-		 * Deny input to the decorator. User input referring to the
-		 * window decorations is routed to the window manager.
+		 * User input referring to the window decorations is routed to the
+		 * window manager. The decorator obtains only the pointer position,
+		 * which it needs for its hover model.
 		 */
-		return Input::Session_capability();
+		return _pointer_input_cap;
 	}
 
 	View_handle create_view(View_handle parent) override
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -48,11 +48,8 @@ struct Wm::Main
 	/* resize requests, issued by the layouter */
 	Attached_rom_dataspace resize_request_rom { "resize_request" };
 
-	/* pointer position to be consumed by the layouter */
-	Reporter pointer_reporter = { "pointer" };
-
 	/* list of present windows, to be consumed by the layouter */
-	Reporter window_list_reporter = { "window_list" };
+	Reporter window_list_reporter = { "window_list", 4096, 64*1024 };
 
 	/* request to the layouter to set the focus */
 	Reporter focus_request_reporter = { "focus_request" };
@@ -63,7 +60,7 @@ struct Wm::Main
 
 	Nitpicker::Root nitpicker_root { ep, window_registry,
 	                                 *env()->heap(), env()->ram_session_cap(),
-	                                 pointer_reporter, focus_request_reporter,
+	                                 focus_request_reporter,
 	                                 focus_nitpicker_session };
 
 	void handle_focus_update(unsigned)
@@ -123,8 +120,6 @@ struct Wm::Main
 
 	Main(Server::Entrypoint &ep) : ep(ep)
 	{
-		pointer_reporter.enabled(true);
-
 		/* initially report an empty window list */
 		window_list_reporter.enabled(true);
 		Genode::Reporter::Xml_generator xml(window_list_reporter, [&] () { });
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -993,8 +993,6 @@ class Wm::Nitpicker::Root : public Genode::Rpc_object<Genode::Typed_root<Session
 
 		enum { STACK_SIZE = 1024*sizeof(long) };
 
-		Reporter &_pointer_reporter;
-
 		Reporter &_focus_request_reporter;
 
 		unsigned _focus_request_cnt = 0;
@@ -1008,11 +1006,23 @@ class Wm::Nitpicker::Root : public Genode::Rpc_object<Genode::Typed_root<Session
 		Input::Session_capability _window_layouter_input_cap {
 			_ep.manage(_window_layouter_input) };
 
+		/*
+		 * Pointer position consumed by the decorator
+		 *
+		 * The position changes with each pointer motion. Instead of
+		 * generating a report each time, the position is propagated as
+		 * input events, which are transferred via shared memory.
+		 */
+		Input::Session_component _decorator_pointer_input;
+
+		Input::Session_capability _decorator_pointer_input_cap {
+			_ep.manage(_decorator_pointer_input) };
+
 		/* handler that forwards clicks into unfocused windows to the layouter */
 		struct Click_handler : Nitpicker::Click_handler
 		{
 			Input::Session_component &window_layouter_input;
-			Reporter                 &pointer_reporter;
+			Input::Session_component &pointer_input;
 			Last_motion              &last_motion;
 
 			void _submit_button_event(Input::Event::Type type, Nitpicker::Point pos)
@@ -1021,15 +1031,17 @@ class Wm::Nitpicker::Root : public Genode::Rpc_object<Genode::Typed_root<Session
 				                                          pos.x(), pos.y(), 0, 0));
 			}
 
+			void _submit_pointer_position(Nitpicker::Point pos)
+			{
+				pointer_input.submit(Input::Event(Input::Event::MOTION, 0,
+				                                  pos.x(), pos.y(), 0, 0));
+			}
+
 			void handle_enter(Nitpicker::Point pos) override
 			{
 				last_motion = LAST_MOTION_NITPICKER;
 
-				Reporter::Xml_generator xml(pointer_reporter, [&] ()
-				{
-					xml.attribute("xpos", pos.x());
-					xml.attribute("ypos", pos.y());
-				});
+				_submit_pointer_position(pos);
 			}
 
 			void handle_click(Nitpicker::Point pos) override
@@ -1038,11 +1050,7 @@ class Wm::Nitpicker::Root : public Genode::Rpc_object<Genode::Typed_root<Session
 				 * Propagate clicked-at position to decorator such that it can
 				 * update its hover model.
 				 */
-				Reporter::Xml_generator xml(pointer_reporter, [&] ()
-				{
-					xml.attribute("xpos", pos.x());
-					xml.attribute("ypos", pos.y());
-				});
+				_submit_pointer_position(pos);
 
 				/*
 				 * Supply artificial mouse click to the decorator's input session
@@ -1053,15 +1061,15 @@ class Wm::Nitpicker::Root : public Genode::Rpc_object<Genode::Typed_root<Session
 			}
 
 			Click_handler(Input::Session_component &window_layouter_input,
-			              Reporter                 &pointer_reporter,
+			              Input::Session_component &pointer_input,
 			              Last_motion              &last_motion)
 			:
 				window_layouter_input(window_layouter_input),
-				pointer_reporter(pointer_reporter),
+				pointer_input(pointer_input),
 				last_motion(last_motion)
 			{ }
 
-		} _click_handler { _window_layouter_input, _pointer_reporter,
+		} _click_handler { _window_layouter_input, _decorator_pointer_input,
 		                   _last_motion };
 
 		/**
@@ -1086,16 +1094,16 @@ class Wm::Nitpicker::Root : public Genode::Rpc_object<Genode::Typed_root<Session
 		Root(Entrypoint &ep,
 		     Window_registry &window_registry, Allocator &md_alloc,
 		     Ram_session_capability ram,
-		     Reporter &pointer_reporter, Reporter &focus_request_reporter,
+		     Reporter &focus_request_reporter,
 		     Nitpicker::Session &focus_nitpicker_session)
 		:
 			_ep(ep), _md_alloc(md_alloc), _ram(ram),
-			_pointer_reporter(pointer_reporter),
 			_focus_request_reporter(focus_request_reporter),
 			_window_registry(window_registry),
 			_focus_nitpicker_session(focus_nitpicker_session)
 		{
 			_window_layouter_input.event_queue().enabled(true);
+			_decorator_pointer_input.event_queue().enabled(true);
 
 			Genode::env()->parent()->announce(_ep.manage(*this));
 		}
@@ -1151,7 +1159,8 @@ class Wm::Nitpicker::Root : public Genode::Rpc_object<Genode::Typed_root<Session
 				{
 					auto session = new (_md_alloc)
 						Decorator_nitpicker_session(_ram, _ep, _md_alloc,
-						                            _pointer_reporter,
+						                            _decorator_pointer_input,
+						                            _decorator_pointer_input_cap,
 						                            _last_motion,
 						                            _window_layouter_input,
 						                            *this);
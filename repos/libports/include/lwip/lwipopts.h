@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2009-2013 Genode Labs GmbH
+ * Copyright (C) 2009-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -41,6 +41,15 @@
 #define LWIP_WND_SCALE              1  /* enable window scaling */
 #define TCP_RCV_SCALE               2  /* receive scale factor IETF RFC 1323 */
 
+/*
+ * Execute API calls in the context of the calling thread while holding the
+ * lock of the stack's core instead of passing each call to the tcpip thread
+ * via its mailbox. Received packets are likewise processed by the thread of
+ * the NIC session. The tcpip thread is thereby left with handling timeouts.
+ */
+#define LWIP_TCPIP_CORE_LOCKING        1
+#define LWIP_TCPIP_CORE_LOCKING_INPUT  1
+
 #if LWIP_DHCP
 #define LWIP_NETIF_STATUS_CALLBACK  1  /* callback function used for interface changes */
 #define LWIP_NETIF_LINK_CALLBACK    1  /* callback function used for link-state changes */
@@ -0,0 +1,4 @@
+SRC_CC = plugin.cc
+LIBS  += libc
+
+vpath plugin.cc $(REP_DIR)/src/lib/libc_local_socket
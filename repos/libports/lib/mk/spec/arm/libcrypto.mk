@@ -3,4 +3,10 @@ INC_DIR += $(REP_DIR)/src/lib/openssl/spec/arm
 
 CC_OPTS += -DL_ENDIAN
 
+#
+# The ARM assembly implementations depend on the probing of the CPU features
+# via SIGILL, which is not supported.
+#
+CC_OPT += -DOPENSSL_NO_ASM
+
 include $(REP_DIR)/lib/mk/libcrypto.inc
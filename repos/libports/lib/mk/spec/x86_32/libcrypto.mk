@@ -3,4 +3,22 @@ INC_DIR += $(REP_DIR)/src/lib/openssl/spec/x86_32
 
 CC_OPTS += -DL_ENDIAN
 
+#
+# Assembly implementations of AES (AES-NI, SSSE3), GHASH (PCLMULQDQ), and SHA,
+# selected at runtime according to the CPU features
+#
+CC_OPT += -DOPENSSL_CPUID_OBJ -DOPENSSL_IA32_SSE2 -DAES_ASM -DVPAES_ASM \
+          -DGHASH_ASM -DSHA1_ASM -DSHA256_ASM -DSHA512_ASM
+
+SRC_S += x86cpuid.s aes-586.s vpaes-x86.s aesni-x86.s ghash-x86.s \
+         sha1-586.s sha256-586.s sha512-586.s
+
+vpath %.s          $(call select_from_ports,openssl)/src/lib/openssl/x86_32
+vpath cpuid_setup.c $(REP_DIR)/src/lib/openssl
+
 include $(REP_DIR)/lib/mk/libcrypto.inc
+
+# replaced by the assembly implementations
+SRC_C := $(filter-out mem_clr.c aes/aes_core.c aes/aes_cbc.c,$(SRC_C))
+
+SRC_C += cpuid_setup.c
@@ -3,9 +3,25 @@ INC_DIR += $(REP_DIR)/src/lib/openssl/spec/x86_64
 
 CC_OPTS += -DL_ENDIAN
 
+#
+# Assembly implementations of AES (AES-NI, SSSE3), GHASH (PCLMULQDQ), and SHA,
+# selected at runtime according to the CPU features
+#
+CC_OPT += -DOPENSSL_CPUID_OBJ -DOPENSSL_IA32_SSE2 -DAES_ASM -DVPAES_ASM \
+          -DBSAES_ASM -DGHASH_ASM -DSHA1_ASM -DSHA256_ASM -DSHA512_ASM
+
 SRC_S += modexp512.s
 SRC_S += rc4_md5.s
+SRC_S += x86_64cpuid.s aes-x86_64.s vpaes-x86_64.s bsaes-x86_64.s \
+         aesni-x86_64.s aesni-sha1-x86_64.s ghash-x86_64.s \
+         sha1-x86_64.s sha256-x86_64.s sha512-x86_64.s
 
-vpath %.s $(call select_from_ports,openssl)/src/lib/openssl/x86_64
+vpath %.s          $(call select_from_ports,openssl)/src/lib/openssl/x86_64
+vpath cpuid_setup.c $(REP_DIR)/src/lib/openssl
 
 include $(REP_DIR)/lib/mk/libcrypto.inc
+
+# replaced by the assembly implementations
+SRC_C := $(filter-out mem_clr.c aes/aes_core.c aes/aes_cbc.c,$(SRC_C))
+
+SRC_C += cpuid_setup.c
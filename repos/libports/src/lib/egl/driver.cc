@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2010-2013 Genode Labs GmbH
+ * Copyright (C) 2010-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -106,6 +106,7 @@ static Genode_framebuffer *genode_framebuffer()
 class Pipe_buffer : public pipe_buffer
 {
 	void *_data;
+	bool  _external;  /* memory is not owned by the buffer */
 
 	public:
 
@@ -122,13 +123,30 @@ class Pipe_buffer : public pipe_buffer
 			pipe_buffer::size      = size;
 
 			/* align to 16-byte multiple for Cell */
-			_data = align_malloc(size, Genode::max(alignment, 16U));
+			_data     = align_malloc(size, Genode::max(alignment, 16U));
+			_external = false;
+		}
+
+		/**
+		 * Constructor for using memory provided by the caller
+		 */
+		Pipe_buffer(unsigned usage, unsigned size, void *data)
+		: _data(data), _external(true)
+		{
+			pipe_reference_init(&reference, 1);
+			pipe_buffer::alignment = 1;
+			pipe_buffer::usage     = usage;
+			pipe_buffer::size      = size;
 		}
 
 		/**
 		 * Destructor
 		 */
-		~Pipe_buffer() { align_free(_data); }
+		~Pipe_buffer()
+		{
+			if (!_external)
+				align_free(_data);
+		}
 
 		void *data() const { return _data; }
 };
@@ -204,6 +222,16 @@ class Winsys : public pipe_winsys
 
 		unsigned nblocksy = util_format_get_nblocksy(format, height);
 
+		/* render directly into the window buffer, using its line stride */
+		Winsys *ws = static_cast<Winsys *>(winsys);
+		if (ws->_target_addr) {
+			*stride = util_format_get_stride(format, width);
+
+			void *addr = ws->_target_addr;
+			ws->_target_addr = 0;
+			return new (Genode::env()->heap()) Pipe_buffer(usage, *stride * nblocksy, addr);
+		}
+
 		enum { ALIGNMENT = 64 };
 		*stride = align(util_format_get_stride(format, width), ALIGNMENT);
 
@@ -254,6 +282,8 @@ class Winsys : public pipe_winsys
 		PDBG("not implemented"); return 0;
 	}
 
+	void *_target_addr = 0;
+
 	public:
 
 		/**
@@ -276,6 +306,11 @@ class Winsys : public pipe_winsys
 			fence_signalled       = _fence_signalled;
 			fence_finish          = _fence_finish;
 		}
+
+		/**
+		 * Define memory to be used by the next surface buffer
+		 */
+		void surface_buffer_target(void *addr) { _target_addr = addr; }
 };
 
 
@@ -325,6 +360,9 @@ class Surface : public native_surface
 			PDBG("not implemented"); return 0;
 		}
 
+		static pipe_texture *
+		_create_texture(Surface *surface, struct pipe_texture *templ);
+
 		static boolean
 		_validate(struct native_surface *nsurf, uint attachment_mask,
 		          unsigned int *seq_num, struct pipe_texture **textures,
@@ -368,7 +406,7 @@ class Surface : public native_surface
 					 * to an 'INTEL_NEW_SCANOUT' argument passed to 'buffer_create'
 					 * (ending up in 'intel_drm_buffer_create'.
 					 */
-					ptex = screen->texture_create(screen, &templ);
+					ptex = _create_texture(this_surface, &templ);
 					this_surface->_textures[i] = ptex;
 				}
 
@@ -439,6 +477,8 @@ class Display : public native_display
 	drm_api *_api;
 	Winsys _winsys;
 
+	friend class Surface;
+
 	enum { NUM_MODES = 1 };
 	struct native_mode _mode;
 	const struct native_mode *_mode_list[NUM_MODES];
@@ -684,6 +724,33 @@ class Display : public native_display
 };
 
 
+pipe_texture *Surface::_create_texture(Surface *surface, struct pipe_texture *templ)
+{
+	Display     *display = static_cast<Display *>(surface->_display);
+	pipe_screen *screen  = display->screen;
+
+	/*
+	 * With software rendering, the first texture of a window surface is
+	 * placed directly in the window buffer, which makes the copy on each
+	 * buffer swap unnecessary. The softpipe driver obtains the memory of
+	 * the texture via 'Winsys::_surface_buffer_create' if the texture is
+	 * marked as primary. A GPU driver cannot render into the window buffer
+	 * because the buffer is not part of the graphics aperture.
+	 */
+	bool const direct = !display->_api && surface->_type == TYPE_WINDOW
+	                 && surface->_addr && !surface->texture();
+	if (direct) {
+		templ->tex_usage |= PIPE_TEXTURE_USAGE_PRIMARY;
+		display->_winsys.surface_buffer_target(surface->_addr);
+	}
+
+	pipe_texture *ptex = screen->texture_create(screen, templ);
+
+	display->_winsys.surface_buffer_target(0);
+	return ptex;
+}
+
+
 boolean Surface::_swap_buffers(struct native_surface *nsurf)
 {
 	Surface *this_surface = static_cast<Surface *>(nsurf);
@@ -692,9 +759,14 @@ boolean Surface::_swap_buffers(struct native_surface *nsurf)
 	pipe_texture *texture = this_surface->texture();
 	pipe_transfer *transfer = 0;
 
-	static Timer::Connection timer;
-
-	timer.msleep(5);
+	/*
+	 * The delay is retained for the GPU drivers only. Software rendering
+	 * is complete at this point.
+	 */
+	if (display->_api) {
+		static Timer::Connection timer;
+		timer.msleep(5);
+	}
 
 	if (!texture) {
 		PERR("surface has no texture");
@@ -735,7 +807,7 @@ boolean Surface::_swap_buffers(struct native_surface *nsurf)
 	if (this_surface->_type == TYPE_SCANOUT)
 		blit(data, transfer->stride, genode_framebuffer()->local_addr(),
 		     transfer->stride, transfer->stride, transfer->height);
-	else if (this_surface->_type == TYPE_WINDOW)
+	else if (this_surface->_type == TYPE_WINDOW && data != this_surface->_addr)
 		blit(data, transfer->stride, this_surface->_addr,
 		     transfer->stride, transfer->stride, transfer->height);
 
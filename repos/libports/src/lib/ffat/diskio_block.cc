@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -32,6 +32,155 @@ static Block::sector_t _blk_cnt  = 0;
 static Block::Session::Tx::Source *_source;
 
 
+enum {
+	TX_BUF_SIZE       = 256*1024,
+
+	/* leave room in the packet buffer for the allocator's meta data */
+	MAX_REQUEST_BYTES = TX_BUF_SIZE / 2,
+};
+
+
+/**
+ * Transfer consecutive blocks from or to the device
+ *
+ * Large transfers are split into requests of at most 'MAX_REQUEST_BYTES'.
+ */
+static bool _transfer(Block::Packet_descriptor::Opcode op, Block::sector_t sector,
+                      size_t count, void *buff)
+{
+	size_t const max_count = Genode::max((size_t)1, MAX_REQUEST_BYTES / _blk_size);
+
+	for (char *dst = (char *)buff; count; ) {
+
+		size_t const num   = Genode::min(count, max_count);
+		size_t const bytes = num * _blk_size;
+
+		Block::Packet_descriptor p(_source->alloc_packet(bytes), op, sector, num);
+
+		if (op == Block::Packet_descriptor::WRITE)
+			memcpy(_source->packet_content(p), dst, bytes);
+
+		_source->submit_packet(p);
+		p = _source->get_acked_packet();
+
+		bool const succeeded = p.succeeded();
+
+		if (succeeded && op == Block::Packet_descriptor::READ)
+			memcpy(dst, _source->packet_content(p), bytes);
+
+		_source->release_packet(p);
+
+		if (!succeeded)
+			return false;
+
+		dst    += bytes;
+		sector += num;
+		count  -= num;
+	}
+	return true;
+}
+
+
+/**
+ * Cache of the blocks accessed one at a time
+ *
+ * FatFs reads the FAT, directories, and partial sectors of files via its
+ * single-sector window, which results in one device request per sector
+ * without the cache. The cache fetches an aligned line of consecutive
+ * blocks at once, so that following the FAT chain of a file or scanning a
+ * directory usually hits the cache. Multi-block reads of file content
+ * bypass the cache. Writes go through to the device and update the cached
+ * copies, so the cache never holds data that is not on the device.
+ */
+class Block_cache
+{
+	private:
+
+		enum { LINE_BYTES = 4096, NUM_LINES = 64 };
+
+		struct Line
+		{
+			Block::sector_t first  = 0;
+			size_t          count  = 0;  /* 0 if unused */
+			char           *data   = 0;
+		};
+
+		size_t   const _line_blocks;
+		Line           _lines[NUM_LINES];
+		unsigned       _next_victim = 0;
+
+		Line *_lookup(Block::sector_t sector)
+		{
+			for (unsigned i = 0; i < NUM_LINES; i++)
+				if (_lines[i].count && sector >= _lines[i].first
+				 && sector - _lines[i].first < _lines[i].count)
+					return &_lines[i];
+			return 0;
+		}
+
+	public:
+
+		Block_cache()
+		:
+			_line_blocks(Genode::max((size_t)1, LINE_BYTES / _blk_size))
+		{
+			char *mem = (char *)env()->heap()->alloc(NUM_LINES * _line_blocks * _blk_size);
+			for (unsigned i = 0; i < NUM_LINES; i++)
+				_lines[i].data = mem + i * _line_blocks * _blk_size;
+		}
+
+		bool read(Block::sector_t sector, void *buff)
+		{
+			Line *line = _lookup(sector);
+
+			if (!line) {
+				line = &_lines[_next_victim];
+				_next_victim = (_next_victim + 1) % NUM_LINES;
+
+				Block::sector_t const first = sector - sector % _line_blocks;
+
+				line->count = 0;
+				line->first = first;
+
+				size_t const count = Genode::min((Block::sector_t)_line_blocks,
+				                                 _blk_cnt - first);
+				if (!_transfer(Block::Packet_descriptor::READ, first, count,
+				               line->data))
+					return false;
+
+				line->count = count;
+			}
+
+			memcpy(buff, line->data + (sector - line->first) * _blk_size, _blk_size);
+			return true;
+		}
+
+		/**
+		 * Update cached copies of written blocks
+		 */
+		void written(Block::sector_t sector, size_t count, void const *buff)
+		{
+			for (size_t i = 0; i < count; i++)
+				if (Line *line = _lookup(sector + i))
+					memcpy(line->data + (sector + i - line->first) * _blk_size,
+					       (char const *)buff + i * _blk_size, _blk_size);
+		}
+
+		/**
+		 * Drop cached copies of blocks with unknown device content
+		 */
+		void invalidate(Block::sector_t sector, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+				if (Line *line = _lookup(sector + i))
+					line->count = 0;
+		}
+};
+
+
+static Block_cache *_cache;
+
+
 extern "C" DSTATUS disk_initialize (BYTE drv)
 {
 	static bool initialized = false;
@@ -50,7 +199,8 @@ extern "C" DSTATUS disk_initialize (BYTE drv)
 	}
 
 	try {
-		_block_connection = new (Genode::env()->heap()) Block::Connection(&_block_alloc);
+		_block_connection = new (Genode::env()->heap())
+			Block::Connection(&_block_alloc, TX_BUF_SIZE);
 	} catch(...) {
 		PERR("could not open block connection");
 		return STA_NOINIT;
@@ -75,6 +225,8 @@ extern "C" DSTATUS disk_initialize (BYTE drv)
 		PDBG("We have %llu blocks with a size of %zu bytes",
 		     _blk_cnt, _blk_size);
 
+	_cache = new (env()->heap()) Block_cache;
+
 	initialized = true;
 
 	return 0;
@@ -103,29 +255,16 @@ extern "C" DRESULT disk_read(BYTE drv, BYTE *buff, DWORD sector, BYTE count)
 		return RES_ERROR;
 	}
 
-	/* allocate packet-descriptor for reading */
-	Block::Packet_descriptor p(_source->alloc_packet(_blk_size),
-	                           Block::Packet_descriptor::READ, sector, count);
-	_source->submit_packet(p);
-	p = _source->get_acked_packet();
+	bool const succeeded = (count == 1)
+	                     ? _cache->read(sector, buff)
+	                     : _transfer(Block::Packet_descriptor::READ, sector, count, buff);
 
 	/* check for success of operation */
-	if (!p.succeeded()) {
+	if (!succeeded) {
 		PERR("Could not read block(s)");
-		_source->release_packet(p);
 		return RES_ERROR;
 	}
 
-	memcpy(buff, _source->packet_content(p), count * _blk_size);
-
-#if 0
-	PDBG("read() successful, contents of buff = \n");
-
-	for (unsigned int i = 0; i < count * _blk_size; i++)
-		PDBG("%8x: %2x %c", i, buff[i], buff[i] >= 32 ? buff[i] : '-');
-#endif
-
-	_source->release_packet(p);
 	return RES_OK;
 }
 
@@ -142,23 +281,17 @@ extern "C" DRESULT disk_write(BYTE drv, const BYTE *buff, DWORD sector, BYTE cou
 		return RES_ERROR;
 	}
 
-	/* allocate packet-descriptor for writing */
-	Block::Packet_descriptor p(_source->alloc_packet(_blk_size),
-	                           Block::Packet_descriptor::WRITE, sector, count);
-
-	memcpy(_source->packet_content(p), buff, count * _blk_size);
-
-	_source->submit_packet(p);
-	p = _source->get_acked_packet();
+	bool const succeeded = _transfer(Block::Packet_descriptor::WRITE, sector,
+	                                 count, (void *)buff);
 
 	/* check for success of operation */
-	if (!p.succeeded()) {
+	if (!succeeded) {
 		PERR("Could not write block(s)");
-		_source->release_packet(p);
+		_cache->invalidate(sector, count);
 		return RES_ERROR;
 	}
 
-	_source->release_packet(p);
+	_cache->written(sector, count, buff);
 	return RES_OK;
 }
 #endif /* _READONLY */
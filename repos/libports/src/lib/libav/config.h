@@ -63,7 +63,7 @@
 #define HAVE_VIS 0
 #define HAVE_BIGENDIAN 0
 #define HAVE_FAST_UNALIGNED 1
-#define HAVE_PTHREADS 0
+#define HAVE_PTHREADS 1
 #define HAVE_W32THREADS 0
 #define HAVE_ALIGNED_STACK 1
 #define HAVE_ALSA_ASOUNDLIB_H 1
@@ -157,7 +157,7 @@
 #define HAVE_SYS_SELECT_H 1
 #define HAVE_SYS_SOUNDCARD_H 1
 #define HAVE_SYS_VIDEOIO_H 0
-#define HAVE_THREADS 0
+#define HAVE_THREADS 1
 #define HAVE_TRUNC 1
 #define HAVE_TRUNCF 1
 #define HAVE_VFP_ARGS 0
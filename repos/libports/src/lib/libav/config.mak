@@ -900,3 +900,8 @@ CONFIG_RTP_PROTOCOL=yes
 CONFIG_TCP_PROTOCOL=yes
 !CONFIG_TLS_PROTOCOL=yes
 CONFIG_UDP_PROTOCOL=yes
+
+# HAVE_* evaluated by the Makefiles of the libraries
+
+HAVE_PTHREADS=yes
+HAVE_THREADS=yes
@@ -0,0 +1,173 @@
+/*
+ * \brief  POSIX asynchronous I/O
+ * \author Emery Hemingway
+ * \date   2015-11-26
+ *
+ * Requests are executed at submission time, which POSIX permits. Hence,
+ * 'aio_error' never reports 'EINPROGRESS' and 'aio_suspend' returns
+ * immediately. The overlap of consecutive requests is achieved by the
+ * underlying VFS, which pipelines large transfers and optionally buffers
+ * small sequential ones ('read_ahead' and 'write_behind' attributes of the
+ * 'fs' VFS plugin). Only 'SIGEV_NONE' is supported as notification method.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* libc plugin interface */
+#include <libc-plugin/fd_alloc.h>
+
+/* libc includes */
+#include <aio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+static bool valid_sigevent(struct sigevent const *sigev)
+{
+	return !sigev || sigev->sigev_notify == SIGEV_NONE;
+}
+
+
+/**
+ * Execute request and record its result in the control block
+ */
+static void execute(struct aiocb *cb, int opcode)
+{
+	ssize_t result = 0;
+
+	switch (opcode) {
+	case LIO_READ:
+		result = pread(cb->aio_fildes, (void *)cb->aio_buf, cb->aio_nbytes,
+		               cb->aio_offset);
+		break;
+	case LIO_WRITE:
+		result = pwrite(cb->aio_fildes, (void const *)cb->aio_buf,
+		                cb->aio_nbytes, cb->aio_offset);
+		break;
+	case O_SYNC:
+		result = fsync(cb->aio_fildes);
+		break;
+	}
+
+	cb->_aiocb_private.status = result;
+	cb->_aiocb_private.error  = result < 0 ? errno : 0;
+}
+
+
+static int submit(struct aiocb *cb, int opcode)
+{
+	if (!cb || !valid_sigevent(&cb->aio_sigevent)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (!Libc::file_descriptor_allocator()->find_by_libc_fd(cb->aio_fildes)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	execute(cb, opcode);
+	return 0;
+}
+
+
+extern "C" int aio_read(struct aiocb *cb)
+{
+	return submit(cb, LIO_READ);
+}
+
+
+extern "C" int aio_write(struct aiocb *cb)
+{
+	return submit(cb, LIO_WRITE);
+}
+
+
+extern "C" int aio_fsync(int op, struct aiocb *cb)
+{
+	if (op != O_SYNC) {
+		errno = EINVAL;
+		return -1;
+	}
+	return submit(cb, O_SYNC);
+}
+
+
+extern "C" int aio_error(const struct aiocb *cb)
+{
+	return cb->_aiocb_private.error;
+}
+
+
+extern "C" ssize_t aio_return(struct aiocb *cb)
+{
+	return cb->_aiocb_private.status;
+}
+
+
+extern "C" int aio_cancel(int fd, struct aiocb *)
+{
+	if (!Libc::file_descriptor_allocator()->find_by_libc_fd(fd)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* requests are completed at submission time */
+	return AIO_ALLDONE;
+}
+
+
+extern "C" int aio_suspend(const struct aiocb * const[], int,
+                           const struct timespec *)
+{
+	/* requests are completed at submission time */
+	return 0;
+}
+
+
+extern "C" int lio_listio(int mode, struct aiocb * const list[], int nent,
+                          struct sigevent *sig)
+{
+	if ((mode != LIO_WAIT && mode != LIO_NOWAIT) || nent < 0
+	 || nent > AIO_LISTIO_MAX || !valid_sigevent(sig)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	bool failed = false;
+
+	for (int i = 0; i < nent; i++) {
+
+		struct aiocb *cb = list[i];
+
+		if (!cb || cb->aio_lio_opcode == LIO_NOP)
+			continue;
+
+		if (cb->aio_lio_opcode != LIO_READ && cb->aio_lio_opcode != LIO_WRITE) {
+			cb->_aiocb_private.status = -1;
+			cb->_aiocb_private.error  = EINVAL;
+			failed = true;
+			continue;
+		}
+
+		if (submit(cb, cb->aio_lio_opcode) == -1) {
+			cb->_aiocb_private.status = -1;
+			cb->_aiocb_private.error  = errno;
+		}
+
+		if (cb->_aiocb_private.error)
+			failed = true;
+	}
+
+	if (failed) {
+		errno = EIO;
+		return -1;
+	}
+	return 0;
+}
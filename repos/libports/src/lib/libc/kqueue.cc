@@ -0,0 +1,323 @@
+/*
+ * \brief  'kqueue()' and 'kevent()' implementation
+ * \author Norman Feske
+ * \date   2015-12-30
+ *
+ * In contrast to 'select()' and 'poll()', the set of events of interest is
+ * kept by the kqueue across calls of 'kevent()'. Hence, an event-driven
+ * server does not need to rebuild its interest set for each iteration of
+ * its main loop. The readiness of the registered file descriptors is
+ * obtained from the plugins in one pass over the interest set. Waiting for
+ * readiness is based on the notification mechanism of 'select()' so that
+ * all plugins that support 'select()' work with kqueues as well.
+ *
+ * The filters 'EVFILT_READ' and 'EVFILT_WRITE' are supported. Events are
+ * level-triggered. The 'EV_CLEAR' flag is accepted but has no effect
+ * because the plugins do not signal state transitions of individual file
+ * descriptors.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/lock.h>
+#include <util/list.h>
+#include <util/misc_math.h>
+
+/* libc plugin interface */
+#include <libc-plugin/plugin.h>
+#include <libc-plugin/fd_alloc.h>
+
+/* libc includes */
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <errno.h>
+
+namespace Libc {
+
+	struct Knote;
+	struct Kqueue;
+	struct Kqueue_plugin;
+}
+
+
+/**
+ * Registered event of interest
+ */
+struct Libc::Knote : List<Knote>::Element
+{
+	uintptr_t const ident;
+	short     const filter;
+
+	/* file descriptor the knote was registered for */
+	File_descriptor * const fd;
+
+	u_short flags   = 0;
+	u_int   fflags  = 0;
+	void   *udata   = 0;
+	bool    enabled = true;
+
+	Knote(uintptr_t ident, short filter, File_descriptor *fd)
+	: ident(ident), filter(filter), fd(fd) { }
+
+	/**
+	 * Return true if the file descriptor of the knote was closed
+	 *
+	 * Knotes of closed file descriptors are removed lazily.
+	 */
+	bool stale() const {
+		return file_descriptor_allocator()->find_by_libc_fd(ident) != fd; }
+};
+
+
+struct Libc::Kqueue : Plugin_context
+{
+	Lock        lock;
+	List<Knote> knotes;
+
+	Knote *lookup(uintptr_t ident, short filter)
+	{
+		for (Knote *k = knotes.first(); k; k = k->next())
+			if (k->ident == ident && k->filter == filter)
+				return k;
+
+		return 0;
+	}
+
+	void remove(Knote *k)
+	{
+		knotes.remove(k);
+		destroy(env()->heap(), k);
+	}
+
+	~Kqueue()
+	{
+		while (Knote *k = knotes.first())
+			remove(k);
+	}
+
+	/**
+	 * Apply change to the interest set
+	 *
+	 * \return 0 on success, or error number
+	 */
+	int apply(struct kevent const &change)
+	{
+		if (change.filter != EVFILT_READ && change.filter != EVFILT_WRITE)
+			return EINVAL;
+
+		Knote *k = lookup(change.ident, change.filter);
+
+		if (k && k->stale()) {
+			remove(k);
+			k = 0;
+		}
+
+		if (change.flags & EV_DELETE) {
+			if (!k)
+				return ENOENT;
+
+			remove(k);
+			return 0;
+		}
+
+		if (!k && !(change.flags & EV_ADD))
+			return ENOENT;
+
+		if (!k) {
+			File_descriptor *fd =
+				file_descriptor_allocator()->find_by_libc_fd(change.ident);
+
+			if (!fd)
+				return EBADF;
+
+			/* the readiness is obtained via 'select()' */
+			if (change.ident >= FD_SETSIZE)
+				return EINVAL;
+
+			k = new (env()->heap()) Knote(change.ident, change.filter, fd);
+			knotes.insert(k);
+		}
+
+		if (change.flags & EV_ADD) {
+			k->flags  = change.flags & (EV_ONESHOT | EV_CLEAR | EV_DISPATCH);
+			k->fflags = change.fflags;
+			k->udata  = change.udata;
+			k->enabled = true;
+		}
+
+		if (change.flags & EV_ENABLE)  k->enabled = true;
+		if (change.flags & EV_DISABLE) k->enabled = false;
+
+		return 0;
+	}
+};
+
+
+/**
+ * Plugin that owns the file descriptors of kqueues
+ *
+ * The plugin is not responsible for any other file descriptors.
+ */
+struct Libc::Kqueue_plugin : Plugin
+{
+	int close(File_descriptor *fd) override
+	{
+		destroy(env()->heap(), static_cast<Kqueue *>(fd->context));
+		file_descriptor_allocator()->free(fd);
+		return 0;
+	}
+};
+
+
+static Libc::Kqueue_plugin &kqueue_plugin()
+{
+	static Libc::Kqueue_plugin inst;
+	return inst;
+}
+
+
+static Libc::Kqueue *lookup_kqueue(int kq)
+{
+	Libc::File_descriptor *fd = Libc::file_descriptor_allocator()->find_by_libc_fd(kq);
+
+	if (!fd || fd->plugin != &kqueue_plugin())
+		return 0;
+
+	return static_cast<Libc::Kqueue *>(fd->context);
+}
+
+
+extern "C" int
+__attribute__((weak))
+kqueue(void)
+{
+	using namespace Libc;
+
+	Kqueue *kqueue = new (env()->heap()) Kqueue;
+
+	File_descriptor *fd = file_descriptor_allocator()->alloc(&kqueue_plugin(), kqueue);
+	if (!fd) {
+		destroy(env()->heap(), kqueue);
+		errno = EMFILE;
+		return -1;
+	}
+
+	return fd->libc_fd;
+}
+
+
+extern "C" int
+__attribute__((weak))
+kevent(int kq, const struct kevent *changelist, int nchanges,
+       struct kevent *eventlist, int nevents, const struct timespec *timeout)
+{
+	using namespace Libc;
+
+	Kqueue *kqueue = lookup_kqueue(kq);
+	if (!kqueue) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (nchanges < 0 || nevents < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	int num_events = 0;
+
+	fd_set readfds, writefds;
+	FD_ZERO(&readfds);
+	FD_ZERO(&writefds);
+	int nfds = 0;
+
+	{
+		Lock::Guard guard(kqueue->lock);
+
+		/* apply changes, errors are reported via the event list */
+		for (int i = 0; i < nchanges; i++) {
+
+			int const error = kqueue->apply(changelist[i]);
+
+			if (!error && !(changelist[i].flags & EV_RECEIPT))
+				continue;
+
+			if (num_events == nevents) {
+				errno = error;
+				return -1;
+			}
+
+			struct kevent &ev = eventlist[num_events++];
+			ev        = changelist[i];
+			ev.flags  = EV_ERROR;
+			ev.data   = error;
+		}
+
+		if (num_events || !nevents)
+			return num_events;
+
+		/* collect file descriptors of enabled knotes */
+		for (Knote *k = kqueue->knotes.first(), *next = 0; k; k = next) {
+			next = k->next();
+
+			if (k->stale()) {
+				kqueue->remove(k);
+				continue;
+			}
+
+			if (!k->enabled)
+				continue;
+
+			FD_SET(k->ident, k->filter == EVFILT_READ ? &readfds : &writefds);
+			nfds = Genode::max(nfds, (int)k->ident + 1);
+		}
+	}
+
+	struct timeval tv, *tvp = 0;
+	if (timeout) {
+		tv.tv_sec  = timeout->tv_sec;
+		tv.tv_usec = timeout->tv_nsec / 1000;
+		tvp = &tv;
+	}
+
+	/*
+	 * Wait without holding the lock of the kqueue to allow other threads to
+	 * modify the interest set meanwhile.
+	 */
+	int const nready = select(nfds, &readfds, &writefds, 0, tvp);
+	if (nready <= 0)
+		return nready;
+
+	Lock::Guard guard(kqueue->lock);
+
+	for (Knote *k = kqueue->knotes.first(), *next = 0;
+	     k && num_events < nevents; k = next) {
+		next = k->next();
+
+		if (!k->enabled || k->stale())
+			continue;
+
+		fd_set const &set = k->filter == EVFILT_READ ? readfds : writefds;
+		if ((int)k->ident >= nfds || !FD_ISSET(k->ident, &set))
+			continue;
+
+		struct kevent &ev = eventlist[num_events++];
+		EV_SET(&ev, k->ident, k->filter, k->flags, k->fflags, 0, k->udata);
+
+		if (k->flags & EV_ONESHOT)
+			kqueue->remove(k);
+		else if (k->flags & EV_DISPATCH)
+			k->enabled = false;
+	}
+
+	return num_events;
+}
@@ -16,6 +16,7 @@
 #include <base/env.h>
 #include <base/printf.h>
 #include <base/slab.h>
+#include <base/thread.h>
 #include <util/construct_at.h>
 #include <util/string.h>
 #include <util/misc_math.h>
@@ -55,43 +56,184 @@ namespace Genode {
 
 /**
  * Allocator that uses slabs for small objects sizes
+ *
+ * Small blocks are grouped into size classes. Up to 128 bytes, the classes
+ * are 16 bytes apart. Above, each power of two is divided into four
+ * classes, which limits the internal fragmentation to 25%. Each size class
+ * has a slab allocator of its own, protected by a lock of its own.
+ *
+ * In front of the slabs, blocks are cached in free lists per thread. Each
+ * thread is assigned to one of 'NUM_CACHES' caches according to the address
+ * of its thread object. Blocks are moved between a cache and the slab of a
+ * size class in batches. Hence, the slab lock is taken only once per batch.
+ * Blocks freed by a thread other than the allocating one end up in the
+ * cache of the freeing thread and are returned to the slab in batches,
+ * too.
  */
 class Malloc : public Genode::Allocator
 {
 	private:
 
 		enum {
-			SLAB_START = 2,  /* 4 Byte (log2) */
-			SLAB_STOP  = 11, /* 2048 Byte (log2) */
-			NUM_SLABS = (SLAB_STOP - SLAB_START) + 1
+			SMALL_STEP_LOG2  = 4,    /* 16 byte */
+			SMALL_MAX_LOG2   = 7,    /* 128 byte */
+			NUM_SMALL        = 1 << (SMALL_MAX_LOG2 - SMALL_STEP_LOG2),
+			SUB_CLASSES_LOG2 = 2,    /* classes per power of two */
+			SLAB_STOP        = 13,   /* 8192 Byte (log2) */
+			NUM_CLASSES      = NUM_SMALL + ((SLAB_STOP - SMALL_MAX_LOG2) << SUB_CLASSES_LOG2),
+			MAX_SLAB_SIZE    = 1 << SLAB_STOP,
+
+			NUM_CACHES       = 8,
+			CACHE_BYTES      = 16*1024, /* per cache and size class */
+			MIN_BATCH        = 4,
+		};
+
+		struct Block { Block *next; };
+
+		struct Free_list
+		{
+			Block    *head;
+			unsigned  count;
+
+			Free_list() : head(0), count(0) { }
+		};
+
+		struct Size_class
+		{
+			Genode::Lock        lock;
+			Genode::Slab_alloc *slab;
+		};
+
+		struct Cache
+		{
+			Genode::Lock lock;
+			Free_list    lists[NUM_CLASSES];
 		};
 
-		Genode::Allocator  *_backing_store;        /* back-end allocator */
-		Genode::Slab_alloc *_allocator[NUM_SLABS]; /* slab allocators */
-		Genode::Lock        _lock;
+		Genode::Allocator *_backing_store;        /* back-end allocator */
+		Size_class         _classes[NUM_CLASSES];
+		Cache              _caches[NUM_CACHES];
+
+		/**
+		 * Return index of size class for a block of 'size' bytes
+		 */
+		static unsigned _class_index(unsigned long size)
+		{
+			if (size <= (1UL << SMALL_MAX_LOG2))
+				return size ? (size - 1) >> SMALL_STEP_LOG2 : 0;
+
+			unsigned const msb  = Genode::log2(size - 1);
+			unsigned const step = msb - SUB_CLASSES_LOG2;
+
+			return NUM_SMALL + ((msb - SMALL_MAX_LOG2) << SUB_CLASSES_LOG2)
+			                 + ((size - 1 - (1UL << msb)) >> step);
+		}
+
+		static unsigned long _class_size(unsigned index)
+		{
+			if (index < NUM_SMALL)
+				return (index + 1UL) << SMALL_STEP_LOG2;
+
+			unsigned const rel = index - NUM_SMALL;
+			unsigned const msb = SMALL_MAX_LOG2 + (rel >> SUB_CLASSES_LOG2);
+			unsigned const sub = rel & ((1 << SUB_CLASSES_LOG2) - 1);
+
+			return (1UL << msb) + ((sub + 1UL) << (msb - SUB_CLASSES_LOG2));
+		}
+
+		/**
+		 * Number of blocks moved between a cache and a slab at once
+		 */
+		static unsigned _batch(unsigned index)
+		{
+			return Genode::max((unsigned long)MIN_BATCH,
+			                   CACHE_BYTES/2/_class_size(index));
+		}
+
+		Cache &_cache()
+		{
+			/* the main thread may have no thread object, use cache 0 */
+			Genode::addr_t const t = (Genode::addr_t)Genode::Thread_base::myself();
+
+			return _caches[((t >> 6) ^ (t >> 12)) % NUM_CACHES];
+		}
+
+		/**
+		 * Fill free list with a batch of blocks from the slab
+		 */
+		void _refill(Free_list &list, unsigned index)
+		{
+			Size_class &c = _classes[index];
+			Genode::Lock::Guard lock_guard(c.lock);
+
+			for (unsigned i = _batch(index); i; i--) {
+				Block *b = (Block *)c.slab->alloc();
+				if (!b)
+					return;
 
-		unsigned long _slab_log2(unsigned long size) const
+				b->next = list.head;
+				list.head = b;
+				list.count++;
+			}
+		}
+
+		/**
+		 * Return a batch of blocks from a free list to the slab
+		 */
+		void _drain(Free_list &list, unsigned index, unsigned count)
 		{
-			unsigned msb = Genode::log2(size);
-			/* size is greater than msb */
-			if (size > (1U << msb))
-				msb++;
+			Size_class &c = _classes[index];
+			Genode::Lock::Guard lock_guard(c.lock);
 
-			/* use smallest slab */
-			if (size < (1U << SLAB_START))
-				msb = SLAB_START;
+			for (; count && list.head; count--) {
+				Block *b = list.head;
+				list.head = b->next;
+				list.count--;
 
-			return msb;
+				Genode::Slab::free(b);
+			}
+		}
+
+		void *_alloc_small(unsigned index)
+		{
+			Cache &cache = _cache();
+			Genode::Lock::Guard lock_guard(cache.lock);
+
+			Free_list &list = cache.lists[index];
+			if (!list.head)
+				_refill(list, index);
+
+			Block *b = list.head;
+			if (b) {
+				list.head = b->next;
+				list.count--;
+			}
+			return b;
+		}
+
+		void _free_small(void *addr, unsigned index)
+		{
+			Cache &cache = _cache();
+			Genode::Lock::Guard lock_guard(cache.lock);
+
+			Free_list &list = cache.lists[index];
+
+			Block *b = (Block *)addr;
+			b->next = list.head;
+			list.head = b;
+			list.count++;
+
+			if (list.count >= 2*_batch(index))
+				_drain(list, index, _batch(index));
 		}
 
 	public:
 
 		Malloc(Genode::Allocator *backing_store) : _backing_store(backing_store)
 		{
-			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++) {
-				_allocator[i - SLAB_START] = new (backing_store)
-				                                 Genode::Slab_alloc(1U << i, backing_store);
-			}
+			for (unsigned i = 0; i < NUM_CLASSES; i++)
+				_classes[i].slab = new (backing_store)
+				                   Genode::Slab_alloc(_class_size(i), backing_store);
 		}
 
 		~Malloc() { PDBG("CALLED"); }
@@ -102,8 +244,6 @@ class Malloc : public Genode::Allocator
 
 		bool alloc(size_t size, void **out_addr) override
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
 			/* enforce size to be a multiple of 4 bytes */
 			size = (size + 3) & ~3;
 
@@ -114,17 +254,16 @@ class Malloc : public Genode::Allocator
 			 * the size information when freeing the block.
 			 */
 			unsigned long real_size = size + sizeof(Block_header);
-			unsigned long msb = _slab_log2(real_size);
 			void *addr = 0;
 
 			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP) {
+			if (real_size > MAX_SLAB_SIZE) {
 
 				if (!(_backing_store->alloc(real_size, &addr)))
 					return false;
 			}
 			else
-				if (!(addr = _allocator[msb - SLAB_START]->alloc()))
+				if (!(addr = _alloc_small(_class_index(real_size))))
 					return false;
 
 			*(Block_header *)addr = real_size;
@@ -134,27 +273,25 @@ class Malloc : public Genode::Allocator
 
 		void free(void *ptr, size_t /* size */) override
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
 			unsigned long *addr = ((unsigned long *)ptr) - 1;
 			unsigned long  real_size = *addr;
 
-			if (real_size > (1U << SLAB_STOP))
+			if (real_size > MAX_SLAB_SIZE)
 				_backing_store->free(addr, real_size);
-			else {
-				unsigned long msb = _slab_log2(real_size);
-				_allocator[msb - SLAB_START]->free(addr);
-			}
+			else
+				_free_small(addr, _class_index(real_size));
 		}
 
 		size_t overhead(size_t size) const override
 		{
 			size += sizeof(Block_header);
 
-			if (size > (1U << SLAB_STOP))
+			if (size > MAX_SLAB_SIZE)
 				return _backing_store->overhead(size);
 
-			return _allocator[_slab_log2(size) - SLAB_START]->overhead(size);
+			unsigned const index = _class_index(size);
+			return _classes[index].slab->overhead(size)
+			     + _class_size(index) - size;
 		}
 
 		bool need_size_for_free() const override { return false; }
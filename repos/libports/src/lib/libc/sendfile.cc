@@ -0,0 +1,167 @@
+/*
+ * \brief  'sendfile()' implementation
+ * \author Emery Hemingway
+ * \date   2015-11-27
+ *
+ * The file content is transmitted directly from a mapping of the file.
+ * If the VFS provides the dataspace of the file-system server, the content
+ * is thereby passed to the socket without any intermediate copy. Files that
+ * cannot be mapped are transmitted via a bounce buffer.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* libc includes */
+#include <sys/param.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+
+enum { BOUNCE_BUFFER_SIZE = 64*1024 };
+
+
+/**
+ * Write complete buffer to socket
+ *
+ * \return number of bytes written, or -1 if nothing was written
+ */
+static ssize_t write_all(int s, char const *buf, size_t count)
+{
+	size_t written = 0;
+
+	while (written < count) {
+		ssize_t const n = write(s, buf + written, count - written);
+		if (n <= 0)
+			return written ? (ssize_t)written : -1;
+
+		written += n;
+	}
+	return written;
+}
+
+
+/**
+ * Send file range from a mapping of the file
+ *
+ * \return false if the file could not be mapped
+ */
+static bool send_mapped(int fd, int s, off_t offset, size_t nbytes, ssize_t &result)
+{
+	off_t  const map_offset = offset & ~(((off_t)1 << PAGE_SHIFT) - 1);
+	size_t const map_length = offset - map_offset + nbytes;
+
+	void *map = mmap(0, map_length, PROT_READ, MAP_PRIVATE, fd, map_offset);
+	if (map == MAP_FAILED)
+		return false;
+
+	result = write_all(s, (char *)map + (offset - map_offset), nbytes);
+
+	munmap(map, map_length);
+	return true;
+}
+
+
+static ssize_t send_buffered(int fd, int s, off_t offset, size_t nbytes)
+{
+	char *buf = (char *)malloc(BOUNCE_BUFFER_SIZE);
+	if (!buf) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	size_t sent = 0;
+	while (sent < nbytes) {
+
+		ssize_t const n = pread(fd, buf, MIN(nbytes - sent, (size_t)BOUNCE_BUFFER_SIZE),
+		                        offset + sent);
+		if (n <= 0)
+			break;
+
+		ssize_t const written = write_all(s, buf, n);
+		if (written > 0)
+			sent += written;
+
+		if (written != n)
+			break;
+	}
+
+	free(buf);
+	return sent ? (ssize_t)sent : -1;
+}
+
+
+/**
+ * Write headers or trailers
+ *
+ * \return false if not all bytes were written
+ */
+static bool send_iovec(int s, struct iovec *iov, int count, off_t &total)
+{
+	if (!iov || count <= 0)
+		return true;
+
+	size_t expected = 0;
+	for (int i = 0; i < count; i++)
+		expected += iov[i].iov_len;
+
+	ssize_t const n = writev(s, iov, count);
+	if (n > 0)
+		total += n;
+
+	return n >= 0 && (size_t)n == expected;
+}
+
+
+extern "C" int sendfile(int fd, int s, off_t offset, size_t nbytes,
+                        struct sf_hdtr *hdtr, off_t *sbytes, int)
+{
+	off_t total = 0;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || offset < 0) {
+		errno = EINVAL;
+		goto error;
+	}
+
+	if (hdtr && !send_iovec(s, hdtr->headers, hdtr->hdr_cnt, total))
+		goto error;
+
+	/* a byte count of zero means sending up to the end of the file */
+	if (offset >= st.st_size)
+		nbytes = 0;
+	else if (nbytes == 0 || (off_t)nbytes > st.st_size - offset)
+		nbytes = st.st_size - offset;
+
+	if (nbytes) {
+		ssize_t n = -1;
+		if (!send_mapped(fd, s, offset, nbytes, n))
+			n = send_buffered(fd, s, offset, nbytes);
+		if (n > 0)
+			total += n;
+		if (n != (ssize_t)nbytes)
+			goto error;
+	}
+
+	if (hdtr && !send_iovec(s, hdtr->trailers, hdtr->trl_cnt, total))
+		goto error;
+
+	if (sbytes)
+		*sbytes = total;
+	return 0;
+
+error:
+	if (sbytes)
+		*sbytes = total;
+	return -1;
+}
@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <base/env.h>
 #include <base/printf.h>
+#include <util/list.h>
 #include <vfs/dir_file_system.h>
 #include <os/config.h>
 
@@ -159,6 +160,22 @@ class Libc::Vfs_plugin : public Libc::Plugin
 
 		Vfs::Dir_file_system _root_dir;
 
+		/**
+		 * File mapped by attaching the dataspace provided by the VFS
+		 */
+		struct Mapping : Genode::List<Mapping>::Element
+		{
+			void                         * const addr;
+			Genode::Dataspace_capability   const ds;
+			char                                 path[Vfs::MAX_PATH_LEN];
+
+			Mapping(void *addr, Genode::Dataspace_capability ds, char const *path)
+			: addr(addr), ds(ds) { Genode::strncpy(this->path, path, sizeof(this->path)); }
+		};
+
+		Genode::List<Mapping> _mappings;
+		Genode::Lock          _mappings_lock;
+
 		Genode::Xml_node _vfs_config()
 		{
 			try {
@@ -800,10 +817,24 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 		return (void *)-1;
 	}
 
-	/*
-	 * XXX attempt to obtain memory mapping via
-	 *     'Vfs::Directory_service::dataspace'.
-	 */
+	/* attempt to map the file content without copying */
+	if (fd->fd_path && (offset & ((1 << PAGE_SHIFT) - 1)) == 0) {
+
+		Genode::Dataspace_capability ds = _root_dir.dataspace(fd->fd_path);
+
+		if (ds.valid()) {
+			try {
+				void *addr = Genode::env()->rm_session()->attach(ds, length, offset);
+
+				Genode::Lock::Guard guard(_mappings_lock);
+				_mappings.insert(new (Genode::env()->heap())
+				                 Mapping(addr, ds, fd->fd_path));
+				return addr;
+			} catch (...) {
+				_root_dir.release(fd->fd_path, ds);
+			}
+		}
+	}
 
 	void *addr = Libc::mem_alloc()->alloc(length, PAGE_SHIFT);
 	if (addr == (void *)-1) {
@@ -824,6 +855,21 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 
 int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 {
+	{
+		Genode::Lock::Guard guard(_mappings_lock);
+
+		for (Mapping *m = _mappings.first(); m; m = m->next()) {
+			if (m->addr != addr)
+				continue;
+
+			Genode::env()->rm_session()->detach(addr);
+			_root_dir.release(m->path, m->ds);
+			_mappings.remove(m);
+			Genode::destroy(Genode::env()->heap(), m);
+			return 0;
+		}
+	}
+
 	Libc::mem_alloc()->free(addr);
 	return 0;
 }
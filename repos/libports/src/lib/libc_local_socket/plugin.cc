@@ -0,0 +1,723 @@
+/*
+ * \brief  Libc plugin for TCP connections between local components
+ * \author Norman Feske
+ * \date   2015-12-30
+ *
+ * Stream sockets connected or bound to a configured address and port are
+ * backed by a terminal session instead of the TCP/IP stack. The data is
+ * transferred via the shared buffer of the terminal session without any
+ * protocol processing. All other sockets are handed over to the plugin of
+ * the TCP/IP stack once their destination is known, i.e., at 'connect()'
+ * or 'bind()' time.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* libc plugin interface */
+#include <libc-plugin/plugin.h>
+#include <libc-plugin/plugin_registry.h>
+#include <libc-plugin/fd_alloc.h>
+
+/* libc includes */
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+/* Genode includes */
+#include <terminal_session/connection.h>
+#include <util/misc_math.h>
+#include <util/string.h>
+#include <util/volatile_object.h>
+#include <base/printf.h>
+#include <base/env.h>
+#include <base/thread.h>
+#include <os/config.h>
+
+
+extern void (*libc_select_notify)();
+
+
+namespace {
+
+	typedef Genode::Thread<4096> Read_sigh_thread;
+
+
+	/**
+	 * Thread for receiving notifications about data available for reading
+	 * from terminal sessions
+	 */
+	class Read_sigh : Read_sigh_thread
+	{
+		private:
+
+			Genode::Lock _startup_lock;
+
+			Genode::Signal_context            _sig_ctx;
+			Genode::Signal_receiver           _sig_rec;
+			Genode::Signal_context_capability _sig_cap;
+
+			void entry()
+			{
+				_sig_cap = _sig_rec.manage(&_sig_ctx);
+
+				_startup_lock.unlock();
+
+				for (;;) {
+					_sig_rec.wait_for_signal();
+
+					if (libc_select_notify)
+						libc_select_notify();
+				}
+			}
+
+		public:
+
+			Read_sigh()
+			:
+				Read_sigh_thread("local_socket_sigh"),
+				_startup_lock(Genode::Lock::LOCKED)
+			{
+				start();
+
+				/* wait until '_sig_cap' is initialized */
+				_startup_lock.lock();
+			}
+
+			Genode::Signal_context_capability cap() { return _sig_cap; }
+	};
+
+
+	static Genode::Signal_context_capability read_sigh()
+	{
+		static Read_sigh inst;
+		return inst.cap();
+	}
+
+
+	typedef Genode::String<64> Label;
+
+
+	/**
+	 * Address and port served by the local transport
+	 */
+	struct Service
+	{
+		in_addr_t addr;  /* network byte order, INADDR_ANY for all local addresses */
+		in_port_t port;  /* network byte order */
+		Label     label;
+	};
+
+
+	/**
+	 * Convert address in dotted-decimal notation to network byte order
+	 */
+	static bool parse_ipv4(char const *s, in_addr_t &result)
+	{
+		Genode::uint32_t addr = 0;
+
+		for (unsigned i = 0; i < 4; i++) {
+			unsigned long byte = 0;
+			Genode::size_t const n = Genode::ascii_to_unsigned(s, byte, 10);
+			if (!n || byte > 255)
+				return false;
+
+			addr = (addr << 8) | byte;
+			s += n;
+
+			if (i < 3 && *s++ != '.')
+				return false;
+		}
+
+		result = htonl(addr);
+		return *s == 0;
+	}
+
+
+	static bool loopback(in_addr_t addr) {
+		return (ntohl(addr) >> 24) == 127; }
+
+
+	/**
+	 * Services configured via '<local_socket>' nodes of the libc config
+	 */
+	class Service_table
+	{
+		private:
+
+			enum { MAX_SERVICES = 16 };
+
+			Service  _services[MAX_SERVICES];
+			unsigned _num_services = 0;
+
+		public:
+
+			Service_table()
+			{
+				try {
+					Genode::Xml_node libc = Genode::config()->xml_node().sub_node("libc");
+
+					libc.for_each_sub_node("local_socket", [&] (Genode::Xml_node node) {
+
+						if (_num_services == MAX_SERVICES) {
+							PERR("too many local sockets configured");
+							return;
+						}
+
+						typedef Genode::String<16> Address;
+						Address const addr = node.attribute_value("address", Address());
+
+						Service &s = _services[_num_services];
+						s.addr  = INADDR_ANY;
+						s.port  = htons(node.attribute_value("port", 0U));
+						s.label = node.attribute_value("label", Label());
+
+						if (addr.valid() && !parse_ipv4(addr.string(), s.addr)) {
+							PERR("invalid local-socket address \"%s\"", addr.string());
+							return;
+						}
+
+						_num_services++;
+					});
+				} catch (...) { }
+			}
+
+			bool empty() const { return _num_services == 0; }
+
+			/**
+			 * Look up service for a peer address
+			 *
+			 * Services without an address are provided at the loopback
+			 * addresses. A 'bind()' to 'INADDR_ANY' refers to the service
+			 * with matching port.
+			 */
+			Service const *lookup(sockaddr const *addr, socklen_t addrlen) const
+			{
+				if (!addr || addrlen < sizeof(sockaddr_in) || addr->sa_family != AF_INET)
+					return nullptr;
+
+				sockaddr_in const &in = *(sockaddr_in const *)addr;
+
+				for (unsigned i = 0; i < _num_services; i++) {
+					Service const &s = _services[i];
+
+					if (s.port != in.sin_port)
+						continue;
+
+					if (s.addr == in.sin_addr.s_addr
+					 || in.sin_addr.s_addr == INADDR_ANY
+					 || (s.addr == INADDR_ANY && loopback(in.sin_addr.s_addr)))
+						return &s;
+				}
+				return nullptr;
+			}
+	};
+
+
+	static Service_table const &services()
+	{
+		static Service_table inst;
+		return inst;
+	}
+
+
+	/**
+	 * Socket of the plugin
+	 *
+	 * A socket is either unbound, a listening socket of a local service,
+	 * or a connection via a terminal session.
+	 */
+	class Socket_context : public Libc::Plugin_context
+	{
+		public:
+
+			/**
+			 * Socket option set before the socket got handed over to the
+			 * TCP/IP stack
+			 */
+			struct Option { int level, name, value; };
+
+			enum { MAX_OPTIONS = 8 };
+
+			int const domain, type, protocol;
+
+			Option   options[MAX_OPTIONS];
+			unsigned num_options = 0;
+
+			int status_flags = 0;
+
+			Service const *service = nullptr;
+
+			bool listening = false;
+
+			Genode::Lazy_volatile_object<Terminal::Connection> terminal;
+
+			Socket_context(int domain, int type, int protocol)
+			: domain(domain), type(type), protocol(protocol) { }
+
+			bool connected() const { return terminal.is_constructed(); }
+
+			/**
+			 * Establish connection via terminal session of the service
+			 */
+			void connect(Service const &s)
+			{
+				service = &s;
+				terminal.construct(s.label.string());
+				terminal->read_avail_sigh(read_sigh());
+			}
+
+			bool nonblocking() const { return status_flags & O_NONBLOCK; }
+	};
+
+
+	static inline Socket_context *context(Libc::File_descriptor *fd)
+	{
+		return static_cast<Socket_context *>(fd->context);
+	}
+
+
+	class Plugin : public Libc::Plugin
+	{
+		private:
+
+			/*
+			 * Prioritize plugin over the plugins of the TCP/IP stacks
+			 */
+			enum { PLUGIN_PRIORITY = 1 };
+
+			/**
+			 * Return plugin of the TCP/IP stack
+			 */
+			Libc::Plugin *_ip_plugin(int domain, int type, int protocol)
+			{
+				Libc::Plugin *result = nullptr;
+				for (Libc::Plugin *p = Libc::plugin_registry()->first(); p; p = p->next())
+					if (p != this && p->supports_socket(domain, type, protocol)
+					 && (!result || p->priority() > result->priority()))
+						result = p;
+
+				return result;
+			}
+
+			/**
+			 * Hand over socket to the TCP/IP stack
+			 *
+			 * The socket of the TCP/IP stack takes the place of the
+			 * socket of the plugin under the same file descriptor.
+			 */
+			bool _hand_over(Libc::File_descriptor *fd)
+			{
+				Socket_context *ctx = context(fd);
+
+				Libc::Plugin *ip = _ip_plugin(ctx->domain, ctx->type, ctx->protocol);
+				if (!ip) {
+					errno = EAFNOSUPPORT;
+					return false;
+				}
+
+				Libc::File_descriptor *ip_fd = ip->socket(ctx->domain, ctx->type,
+				                                          ctx->protocol);
+				if (!ip_fd) {
+					errno = ENOBUFS;
+					return false;
+				}
+
+				fd->plugin  = ip_fd->plugin;
+				fd->context = ip_fd->context;
+				Libc::file_descriptor_allocator()->free(ip_fd);
+
+				for (unsigned i = 0; i < ctx->num_options; i++) {
+					Socket_context::Option const &o = ctx->options[i];
+					fd->plugin->setsockopt(fd, o.level, o.name, &o.value, sizeof(o.value));
+				}
+
+				if (ctx->status_flags)
+					fd->plugin->fcntl(fd, F_SETFL, ctx->status_flags);
+
+				Genode::destroy(Genode::env()->heap(), ctx);
+				return true;
+			}
+
+			static void _local_address(sockaddr *addr, socklen_t *addrlen,
+			                           Service const *s)
+			{
+				if (!addr || !addrlen)
+					return;
+
+				sockaddr_in in;
+				Genode::memset(&in, 0, sizeof(in));
+				in.sin_len         = sizeof(in);
+				in.sin_family      = AF_INET;
+				in.sin_addr.s_addr = (s && s->addr != INADDR_ANY)
+				                   ? s->addr : htonl(INADDR_LOOPBACK);
+				in.sin_port        = s ? s->port : 0;
+
+				socklen_t const len = Genode::min(*addrlen, (socklen_t)sizeof(in));
+				Genode::memcpy(addr, &in, len);
+				*addrlen = sizeof(in);
+			}
+
+		public:
+
+			Plugin() : Libc::Plugin(PLUGIN_PRIORITY) { }
+
+			bool supports_socket(int domain, int type, int protocol)
+			{
+				return domain == AF_INET && type == SOCK_STREAM
+				    && !services().empty();
+			}
+
+			Libc::File_descriptor *socket(int domain, int type, int protocol)
+			{
+				Socket_context *ctx = new (Genode::env()->heap())
+					Socket_context(domain, type, protocol);
+
+				return Libc::file_descriptor_allocator()->alloc(this, ctx);
+			}
+
+			int connect(Libc::File_descriptor *fd, const struct sockaddr *addr,
+			            socklen_t addrlen)
+			{
+				Service const *s = services().lookup(addr, addrlen);
+
+				if (!s || ((sockaddr_in const *)addr)->sin_addr.s_addr == INADDR_ANY) {
+					if (!_hand_over(fd))
+						return -1;
+
+					return fd->plugin->connect(fd, addr, addrlen);
+				}
+
+				if (context(fd)->connected()) {
+					errno = EISCONN;
+					return -1;
+				}
+
+				try { context(fd)->connect(*s); }
+				catch (...) {
+					errno = ECONNREFUSED;
+					return -1;
+				}
+				return 0;
+			}
+
+			int bind(Libc::File_descriptor *fd, const struct sockaddr *addr,
+			         socklen_t addrlen)
+			{
+				Service const *s = services().lookup(addr, addrlen);
+
+				if (!s) {
+					if (!_hand_over(fd))
+						return -1;
+
+					return fd->plugin->bind(fd, addr, addrlen);
+				}
+
+				context(fd)->service = s;
+				return 0;
+			}
+
+			int listen(Libc::File_descriptor *fd, int)
+			{
+				if (!context(fd)->service || context(fd)->connected()) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				context(fd)->listening = true;
+				return 0;
+			}
+
+			/**
+			 * Accept connection of a local service
+			 *
+			 * Each accepted connection corresponds to a terminal session
+			 * with the label of the service. The session is established
+			 * as soon as the terminal server pairs it with the session of
+			 * a client.
+			 */
+			Libc::File_descriptor *accept(Libc::File_descriptor *fd,
+			                              struct sockaddr *addr,
+			                              socklen_t *addrlen)
+			{
+				Socket_context *listener = context(fd);
+
+				if (!listener->listening) {
+					errno = EINVAL;
+					return 0;
+				}
+
+				Socket_context *ctx = new (Genode::env()->heap())
+					Socket_context(listener->domain, listener->type,
+					               listener->protocol);
+				try { ctx->connect(*listener->service); }
+				catch (...) {
+					Genode::destroy(Genode::env()->heap(), ctx);
+					errno = ECONNABORTED;
+					return 0;
+				}
+
+				_local_address(addr, addrlen, nullptr);
+				return Libc::file_descriptor_allocator()->alloc(this, ctx);
+			}
+
+			int close(Libc::File_descriptor *fd)
+			{
+				Genode::destroy(Genode::env()->heap(), context(fd));
+				Libc::file_descriptor_allocator()->free(fd);
+				return 0;
+			}
+
+			int setsockopt(Libc::File_descriptor *fd, int level, int optname,
+			               const void *optval, socklen_t optlen)
+			{
+				Socket_context *ctx = context(fd);
+
+				/* options do not apply to the local transport */
+				if (ctx->service)
+					return 0;
+
+				/* record integer options for the TCP/IP stack */
+				if (!optval || optlen != sizeof(int)) {
+					PWRN("setsockopt(): option %d ignored - local socket", optname);
+					return 0;
+				}
+
+				if (ctx->num_options == Socket_context::MAX_OPTIONS) {
+					errno = ENOBUFS;
+					return -1;
+				}
+
+				ctx->options[ctx->num_options++] =
+					Socket_context::Option { level, optname, *(int const *)optval };
+				return 0;
+			}
+
+			int getsockopt(Libc::File_descriptor *fd, int level, int optname,
+			               void *optval, socklen_t *optlen)
+			{
+				if (level != SOL_SOCKET || !optval || !optlen || *optlen < sizeof(int)) {
+					errno = ENOPROTOOPT;
+					return -1;
+				}
+
+				int value = 0;
+				switch (optname) {
+				case SO_TYPE:  value = context(fd)->type; break;
+				case SO_ERROR: value = 0;                 break;
+				default:
+					errno = ENOPROTOOPT;
+					return -1;
+				}
+
+				*(int *)optval = value;
+				*optlen = sizeof(int);
+				return 0;
+			}
+
+			int getsockname(Libc::File_descriptor *fd, struct sockaddr *addr,
+			                socklen_t *addrlen)
+			{
+				_local_address(addr, addrlen, context(fd)->listening
+				                              ? context(fd)->service : nullptr);
+				return 0;
+			}
+
+			int getpeername(Libc::File_descriptor *fd, struct sockaddr *addr,
+			                socklen_t *addrlen)
+			{
+				if (!context(fd)->connected()) {
+					errno = ENOTCONN;
+					return -1;
+				}
+
+				_local_address(addr, addrlen, context(fd)->listening
+				                              ? nullptr : context(fd)->service);
+				return 0;
+			}
+
+			int shutdown(Libc::File_descriptor *fd, int)
+			{
+				if (!context(fd)->connected()) {
+					errno = ENOTCONN;
+					return -1;
+				}
+				return 0;
+			}
+
+			int fcntl(Libc::File_descriptor *fd, int cmd, long arg)
+			{
+				switch (cmd) {
+				case F_GETFL: return context(fd)->status_flags;
+				case F_SETFL: context(fd)->status_flags = arg; return 0;
+				default:
+					PERR("fcntl(): command %d args %ld not supported - local socket",
+					     cmd, arg);
+					return -1;
+				}
+			}
+
+			bool supports_select(int nfds,
+			                     fd_set *readfds,
+			                     fd_set *writefds,
+			                     fd_set *exceptfds,
+			                     struct timeval *timeout)
+			{
+				return true;
+			}
+
+			int select(int nfds,
+			           fd_set *readfds,
+			           fd_set *writefds,
+			           fd_set *exceptfds,
+			           struct timeval *timeout)
+			{
+				fd_set in_readfds;
+				fd_set in_writefds;
+				FD_ZERO(&in_readfds);
+				FD_ZERO(&in_writefds);
+
+				if (readfds) {
+					in_readfds = *readfds;
+					FD_ZERO(readfds);
+				}
+
+				if (writefds) {
+					in_writefds = *writefds;
+					FD_ZERO(writefds);
+				}
+
+				if (exceptfds)
+					FD_ZERO(exceptfds);
+
+				int nready = 0;
+				for (int libc_fd = 0; libc_fd < nfds; libc_fd++) {
+					Libc::File_descriptor *fdo =
+						Libc::file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+
+					/* handle only libc_fds that belong to this plugin */
+					if (!fdo || (fdo->plugin != this))
+						continue;
+
+					Socket_context *ctx = context(fdo);
+
+					/* a pending connection is accepted by blocking in 'accept()' */
+					bool const readable = ctx->listening
+					                   || (ctx->connected() && ctx->terminal->avail());
+
+					if (FD_ISSET(libc_fd, &in_readfds) && readable) {
+						if (readfds)
+							FD_SET(libc_fd, readfds);
+						nready++;
+					}
+
+					if (FD_ISSET(libc_fd, &in_writefds) && ctx->connected()) {
+						if (writefds)
+							FD_SET(libc_fd, writefds);
+						nready++;
+					}
+				}
+				return nready;
+			}
+
+			ssize_t write(Libc::File_descriptor *fd, const void *buf, ::size_t count)
+			{
+				Socket_context *ctx = context(fd);
+
+				if (!ctx->connected()) {
+					errno = ENOTCONN;
+					return -1;
+				}
+
+				Genode::size_t const chunk_size = ctx->terminal->io_buffer_size();
+
+				Genode::size_t written_bytes = 0;
+				while (written_bytes < count) {
+
+					Genode::size_t n = Genode::min(count - written_bytes, chunk_size);
+					ctx->terminal->write((char *)buf + written_bytes, n);
+					written_bytes += n;
+				}
+
+				return count;
+			}
+
+			ssize_t read(Libc::File_descriptor *fd, void *buf, ::size_t count)
+			{
+				Socket_context *ctx = context(fd);
+
+				if (!ctx->connected()) {
+					errno = ENOTCONN;
+					return -1;
+				}
+
+				for (;;) {
+					Genode::size_t num_bytes = ctx->terminal->read(buf, count);
+
+					if (num_bytes || !count)
+						return num_bytes;
+
+					if (ctx->nonblocking()) {
+						errno = EAGAIN;
+						return -1;
+					}
+
+					/* read returned 0, block until data becomes available */
+					fd_set rfds;
+					FD_ZERO(&rfds);
+					FD_SET(fd->libc_fd, &rfds);
+					::select(fd->libc_fd + 1, &rfds, 0, 0, 0);
+				}
+			}
+
+			ssize_t send(Libc::File_descriptor *fd, const void *buf,
+			             ::size_t len, int)
+			{
+				return write(fd, buf, len);
+			}
+
+			ssize_t sendto(Libc::File_descriptor *fd, const void *buf,
+			               ::size_t len, int flags, const struct sockaddr *,
+			               socklen_t)
+			{
+				return write(fd, buf, len);
+			}
+
+			ssize_t recv(Libc::File_descriptor *fd, void *buf, ::size_t len,
+			             int flags)
+			{
+				if (!(flags & MSG_DONTWAIT))
+					return read(fd, buf, len);
+
+				int const status_flags = context(fd)->status_flags;
+				context(fd)->status_flags |= O_NONBLOCK;
+				ssize_t const result = read(fd, buf, len);
+				context(fd)->status_flags = status_flags;
+				return result;
+			}
+
+			ssize_t recvfrom(Libc::File_descriptor *fd, void *buf, ::size_t len,
+			                 int flags, struct sockaddr *src_addr,
+			                 socklen_t *addrlen)
+			{
+				ssize_t const result = recv(fd, buf, len, flags);
+				if (result >= 0)
+					getpeername(fd, src_addr, addrlen);
+
+				return result;
+			}
+	};
+
+} /* unnamed namespace */
+
+
+void __attribute__((constructor)) init_libc_local_socket(void)
+{
+	static Plugin plugin;
+}
@@ -0,0 +1,28 @@
+/*
+ * \brief  Detection of the CPU features used by the assembly implementations
+ * \author Norman Feske
+ * \date   2015-12-30
+ *
+ * The OpenSSL CPU-identification code places a call of 'OPENSSL_cpuid_setup'
+ * in the '.init' section. Genode's dynamic linker merely calls the '_init'
+ * function of a shared library, not code fragments that other object files
+ * place in this section. Without the
+ * setup, the capability vector 'OPENSSL_ia32cap_P' remains zero and the
+ * assembly implementations fall back to their slowest variants. As usual,
+ * the detected features can be masked via the 'OPENSSL_ia32cap' environment
+ * variable.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+void OPENSSL_cpuid_setup(void);
+
+static void __attribute__((constructor)) cpuid_setup(void)
+{
+	OPENSSL_cpuid_setup();
+}
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -16,7 +16,9 @@
 #include <base/printf.h>
 #include <base/sleep.h>
 #include <base/thread.h>
+#include <cpu/atomic.h>
 #include <os/timed_semaphore.h>
+#include <util/fifo.h>
 #include <util/list.h>
 
 #include <errno.h>
@@ -202,6 +204,24 @@ extern "C" {
 	/* Mutex */
 
 
+	/*
+	 * The lock state is the number of threads that own or wait for the
+	 * mutex. A thread that increments the state from 0 owns the mutex
+	 * without further ado. Otherwise, it blocks at the semaphore until the
+	 * owner hands over the mutex. In the common case of an uncontended
+	 * mutex, lock and unlock thereby come down to one atomic operation each.
+	 */
+
+	static int atomic_add(volatile int *value, int delta)
+	{
+		for (;;) {
+			int const old = *value;
+			if (cmpxchg(value, old, old + delta))
+				return old;
+		}
+	}
+
+
 	struct pthread_mutex_attr
 	{
 		int type;
@@ -214,105 +234,109 @@ extern "C" {
 	{
 		pthread_mutex_attr mutexattr;
 
-		Lock mutex_lock;
+		int volatile state;
+		Semaphore    handover_sem;
 
+		/* accessed by the owner only */
 		pthread_t owner;
 		int       lock_count;
-		Lock      owner_and_counter_lock;
 
 		pthread_mutex(const pthread_mutexattr_t *__restrict attr)
-		: owner(0),
-		  lock_count(0)
+		: state(0), owner(0), lock_count(0)
 		{
 			if (attr && *attr)
 				mutexattr = **attr;
 		}
 
-		int lock()
+		void acquire()
 		{
-			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
+			if (atomic_add(&state, 1) != 0)
+				handover_sem.down();
+		}
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
+		bool try_acquire() { return cmpxchg(&state, 0, 1); }
 
-				if (lock_count == 0) {
-					owner = pthread_self();
-					lock_count++;
-					mutex_lock.lock();
-					return 0;
-				}
+		void release()
+		{
+			if (atomic_add(&state, -1) != 1)
+				handover_sem.up();
+		}
 
-				/* the mutex is already locked */
-				if (pthread_self() == owner) {
-					lock_count++;
-					return 0;
-				} else {
-					mutex_lock.lock();
-					return 0;
-				}
+		int lock()
+		{
+			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
+			if (mutexattr.type != PTHREAD_MUTEX_RECURSIVE &&
+			    mutexattr.type != PTHREAD_MUTEX_ERRORCHECK) {
+				acquire();
+				return 0;
 			}
 
-			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
-
-				Lock::Guard lock_guard(owner_and_counter_lock);
+			pthread_t const myself = pthread_self();
 
-				if (lock_count == 0) {
-					owner = pthread_self();
-					mutex_lock.lock();
-					return 0;
-				}
-
-				/* the mutex is already locked */
-				if (pthread_self() != owner) {
-					mutex_lock.lock();
-					return 0;
-				} else
+			if (owner == myself) {
+				if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK)
 					return EDEADLK;
+
+				lock_count++;
+				return 0;
 			}
 
-			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			mutex_lock.lock();
+			acquire();
+			owner      = myself;
+			lock_count = 1;
 			return 0;
 		}
 
-		int unlock()
+		int trylock()
 		{
+			if (mutexattr.type != PTHREAD_MUTEX_RECURSIVE &&
+			    mutexattr.type != PTHREAD_MUTEX_ERRORCHECK)
+				return try_acquire() ? 0 : EBUSY;
 
-			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
+			pthread_t const myself = pthread_self();
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (pthread_self() != owner)
-					return EPERM;
+			if (owner == myself && mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
+				lock_count++;
+				return 0;
+			}
 
-				lock_count--;
+			if (!try_acquire())
+				return EBUSY;
 
-				if (lock_count == 0) {
-					owner = 0;
-					mutex_lock.unlock();
-				}
+			owner      = myself;
+			lock_count = 1;
+			return 0;
+		}
 
+		int unlock()
+		{
+			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
+			if (mutexattr.type != PTHREAD_MUTEX_RECURSIVE &&
+			    mutexattr.type != PTHREAD_MUTEX_ERRORCHECK) {
+				release();
 				return 0;
 			}
 
-			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
+			if (owner != pthread_self())
+				return EPERM;
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (pthread_self() != owner)
-					return EPERM;
-
-				owner = 0;
-				mutex_lock.unlock();
+			if (--lock_count > 0)
 				return 0;
-			}
 
-			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			mutex_lock.unlock();
+			owner = 0;
+			release();
 			return 0;
 		}
 	};
 
 
+	/*
+	 * Statically initialized objects are created on first use. The lock
+	 * prevents concurrent first users from creating distinct objects.
+	 */
+	static Lock static_init_lock;
+
+
 	int pthread_mutexattr_init(pthread_mutexattr_t *attr)
 	{
 		if (!attr)
@@ -371,17 +395,36 @@ extern "C" {
 	}
 
 
+	static void mutex_static_init(pthread_mutex_t *mutex)
+	{
+		Lock::Guard guard(static_init_lock);
+
+		if (*mutex == PTHREAD_MUTEX_INITIALIZER)
+			pthread_mutex_init(mutex, 0);
+	}
+
+
 	int pthread_mutex_lock(pthread_mutex_t *mutex)
 	{
 		if (!mutex)
 			return EINVAL;
 
 		if (*mutex == PTHREAD_MUTEX_INITIALIZER)
-			pthread_mutex_init(mutex, 0);
+			mutex_static_init(mutex);
 
-		(*mutex)->lock();
+		return (*mutex)->lock();
+	}
 
-		return 0;
+
+	int pthread_mutex_trylock(pthread_mutex_t *mutex)
+	{
+		if (!mutex)
+			return EINVAL;
+
+		if (*mutex == PTHREAD_MUTEX_INITIALIZER)
+			mutex_static_init(mutex);
+
+		return (*mutex)->trylock();
 	}
 
 
@@ -391,11 +434,9 @@ extern "C" {
 			return EINVAL;
 
 		if (*mutex == PTHREAD_MUTEX_INITIALIZER)
-			pthread_mutex_init(mutex, 0);
-
-		(*mutex)->unlock();
+			mutex_static_init(mutex);
 
-		return 0;
+		return (*mutex)->unlock();
 	}
 
 
@@ -403,19 +444,37 @@ extern "C" {
 
 
 	/*
-	 * Implementation based on
-	 * http://web.archive.org/web/20010914175514/http://www-classic.be.com/aboutbe/benewsletter/volume_III/Issue40.html#Workshop
+	 * Each waiting thread enqueues a waiter object located on its stack.
+	 * Signalling dequeues the waiter and wakes it up without waiting for the
+	 * woken-up thread to respond. Only timed waits involve the timer.
 	 */
 
 	struct pthread_cond
 	{
-		int num_waiters;
-		int num_signallers;
-		Lock counter_lock;
-		Timed_semaphore signal_sem;
-		Semaphore handshake_sem;
+		struct Waiter : Fifo<Waiter>::Element
+		{
+			Timed_semaphore sem;
+			bool            signalled = false;
+		};
+
+		Lock         lock;
+		Fifo<Waiter> waiters;
+
+		/**
+		 * Wake up first waiter
+		 *
+		 * \return  false if no thread waits
+		 */
+		bool wake_one()
+		{
+			Waiter *w = waiters.dequeue();
+			if (!w)
+				return false;
 
-		pthread_cond() : num_waiters(0), num_signallers(0) { }
+			w->signalled = true;
+			w->sem.up();
+			return true;
+		}
 	};
 
 
@@ -477,6 +536,15 @@ extern "C" {
 	}
 
 
+	static void cond_static_init(pthread_cond_t *cond)
+	{
+		Lock::Guard guard(static_init_lock);
+
+		if (*cond == PTHREAD_COND_INITIALIZER)
+			pthread_cond_init(cond, 0);
+	}
+
+
 	static unsigned long timespec_to_ms(const struct timespec ts)
 	{
 		return (ts.tv_sec * 1000) + (ts.tv_nsec / (1000 * 1000));
@@ -490,19 +558,24 @@ extern "C" {
 		int result = 0;
 		Alarm::Time timeout = 0;
 
-		if (!cond || !*cond)
+		if (!cond)
 			return EINVAL;
 
+		if (*cond == PTHREAD_COND_INITIALIZER)
+			cond_static_init(cond);
+
 		pthread_cond *c = *cond;
 
-		c->counter_lock.lock();
-		c->num_waiters++;
-		c->counter_lock.unlock();
+		pthread_cond::Waiter waiter;
+
+		c->lock.lock();
+		c->waiters.enqueue(&waiter);
+		c->lock.unlock();
 
 		pthread_mutex_unlock(mutex);
 
 		if (!abstime)
-			c->signal_sem.down();
+			waiter.sem.down();
 		else {
 			struct timespec currtime;
 			clock_gettime(CLOCK_REALTIME, &currtime);
@@ -511,7 +584,7 @@ extern "C" {
 			if (abstime_ms > currtime_ms)
 				timeout = abstime_ms - currtime_ms;
 			try {
-				c->signal_sem.down(timeout);
+				waiter.sem.down(timeout);
 			} catch (Timeout_exception) {
 				result = ETIMEDOUT;
 			} catch (Genode::Nonblocking_exception) {
@@ -520,15 +593,16 @@ extern "C" {
 			}
 		}
 
-		c->counter_lock.lock();
-		if (c->num_signallers > 0) {
-			if (result == ETIMEDOUT) /* timeout occured */
-				c->signal_sem.down();
-			c->handshake_sem.up();
-			--c->num_signallers;
+		if (result == ETIMEDOUT) {
+			Lock::Guard guard(c->lock);
+
+			/* consume a wakeup that raced with the timeout */
+			if (waiter.signalled) {
+				waiter.sem.down();
+				result = 0;
+			} else
+				c->waiters.remove(&waiter);
 		}
-		c->num_waiters--;
-		c->counter_lock.unlock();
 
 		pthread_mutex_lock(mutex);
 
@@ -545,42 +619,281 @@ extern "C" {
 
 	int pthread_cond_signal(pthread_cond_t *cond)
 	{
-		if (!cond || !*cond)
+		if (!cond)
 			return EINVAL;
 
+		if (*cond == PTHREAD_COND_INITIALIZER)
+			cond_static_init(cond);
+
 		pthread_cond *c = *cond;
 
-		c->counter_lock.lock();
-		if (c->num_waiters > c->num_signallers) {
-		  ++c->num_signallers;
-		  c->signal_sem.up();
-		  c->counter_lock.unlock();
-		  c->handshake_sem.down();
-		} else
-		  c->counter_lock.unlock();
+		Lock::Guard guard(c->lock);
+		c->wake_one();
 
-	   return 0;
+		return 0;
 	}
 
 
 	int pthread_cond_broadcast(pthread_cond_t *cond)
 	{
-		if (!cond || !*cond)
+		if (!cond)
 			return EINVAL;
 
+		if (*cond == PTHREAD_COND_INITIALIZER)
+			cond_static_init(cond);
+
 		pthread_cond *c = *cond;
 
-		c->counter_lock.lock();
-		if (c->num_waiters > c->num_signallers) {
-			int still_waiting = c->num_waiters - c->num_signallers;
-			c->num_signallers = c->num_waiters;
-			for (int i = 0; i < still_waiting; i++)
-				c->signal_sem.up();
-			c->counter_lock.unlock();
-			for (int i = 0; i < still_waiting; i++)
-				c->handshake_sem.down();
-		} else
-			c->counter_lock.unlock();
+		Lock::Guard guard(c->lock);
+		while (c->wake_one());
+
+		return 0;
+	}
+
+
+	/* Read-write lock */
+
+
+	/*
+	 * Waiting writers take precedence over readers that newly arrive, which
+	 * prevents a steady stream of readers from starving the writers.
+	 */
+
+	struct pthread_rwlock
+	{
+		Lock      lock;
+		unsigned  readers         = 0;  /* number of readers owning the lock */
+		bool      writer          = false;
+		unsigned  waiting_readers = 0;
+		unsigned  waiting_writers = 0;
+		Semaphore reader_sem;
+		Semaphore writer_sem;
+
+		bool _read_lockable() const { return !writer && !waiting_writers; }
+		bool _write_lockable() const { return !writer && !readers; }
+
+		int rdlock(bool block)
+		{
+			lock.lock();
+
+			if (_read_lockable()) {
+				readers++;
+				lock.unlock();
+				return 0;
+			}
+
+			if (!block) {
+				lock.unlock();
+				return EBUSY;
+			}
+
+			/* the lock is handed over by 'unlock' */
+			waiting_readers++;
+			lock.unlock();
+			reader_sem.down();
+			return 0;
+		}
+
+		int wrlock(bool block)
+		{
+			lock.lock();
+
+			if (_write_lockable()) {
+				writer = true;
+				lock.unlock();
+				return 0;
+			}
+
+			if (!block) {
+				lock.unlock();
+				return EBUSY;
+			}
+
+			waiting_writers++;
+			lock.unlock();
+			writer_sem.down();
+			return 0;
+		}
+
+		int unlock()
+		{
+			Lock::Guard guard(lock);
+
+			if (writer)
+				writer = false;
+			else if (readers)
+				readers--;
+			else
+				return EPERM;
+
+			if (_write_lockable() && waiting_writers) {
+				waiting_writers--;
+				writer = true;
+				writer_sem.up();
+				return 0;
+			}
+
+			if (!writer && !waiting_writers)
+				for (; waiting_readers; waiting_readers--) {
+					readers++;
+					reader_sem.up();
+				}
+
+			return 0;
+		}
+	};
+
+
+	int pthread_rwlockattr_init(pthread_rwlockattr_t *attr)
+	{
+		if (!attr)
+			return EINVAL;
+
+		*attr = 0;
+
+		return 0;
+	}
+
+
+	int pthread_rwlockattr_destroy(pthread_rwlockattr_t *attr)
+	{
+		if (!attr)
+			return EINVAL;
+
+		return 0;
+	}
+
+
+	int pthread_rwlock_init(pthread_rwlock_t *__restrict rwlock,
+	                        const pthread_rwlockattr_t *__restrict attr)
+	{
+		if (!rwlock)
+			return EINVAL;
+
+		*rwlock = new (env()->heap()) pthread_rwlock;
+
+		return 0;
+	}
+
+
+	int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
+	{
+		if (!rwlock || !*rwlock)
+			return EINVAL;
+
+		destroy(env()->heap(), *rwlock);
+		*rwlock = 0;
+
+		return 0;
+	}
+
+
+	static pthread_rwlock *rwlock_object(pthread_rwlock_t *rwlock)
+	{
+		if (*rwlock == PTHREAD_RWLOCK_INITIALIZER) {
+			Lock::Guard guard(static_init_lock);
+
+			if (*rwlock == PTHREAD_RWLOCK_INITIALIZER)
+				pthread_rwlock_init(rwlock, 0);
+		}
+		return *rwlock;
+	}
+
+
+	int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
+	{
+		return rwlock ? rwlock_object(rwlock)->rdlock(true) : EINVAL;
+	}
+
+
+	int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
+	{
+		return rwlock ? rwlock_object(rwlock)->rdlock(false) : EINVAL;
+	}
+
+
+	int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
+	{
+		return rwlock ? rwlock_object(rwlock)->wrlock(true) : EINVAL;
+	}
+
+
+	int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
+	{
+		return rwlock ? rwlock_object(rwlock)->wrlock(false) : EINVAL;
+	}
+
+
+	int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
+	{
+		return rwlock ? rwlock_object(rwlock)->unlock() : EINVAL;
+	}
+
+
+	/* Spin lock */
+
+
+	/*
+	 * Spinning is not an option because the owner of the lock may be a
+	 * thread of lower priority. Hence, a spin lock is a normal mutex, which
+	 * merely performs one atomic operation if uncontended.
+	 */
+
+	struct pthread_spinlock
+	{
+		pthread_mutex mutex { 0 };
+	};
+
+
+	int pthread_spin_init(pthread_spinlock_t *lock, int pshared)
+	{
+		if (!lock)
+			return EINVAL;
+
+		*lock = new (env()->heap()) pthread_spinlock;
+
+		return 0;
+	}
+
+
+	int pthread_spin_destroy(pthread_spinlock_t *lock)
+	{
+		if (!lock || !*lock)
+			return EINVAL;
+
+		destroy(env()->heap(), *lock);
+		*lock = 0;
+
+		return 0;
+	}
+
+
+	int pthread_spin_lock(pthread_spinlock_t *lock)
+	{
+		if (!lock || !*lock)
+			return EINVAL;
+
+		(*lock)->mutex.acquire();
+
+		return 0;
+	}
+
+
+	int pthread_spin_trylock(pthread_spinlock_t *lock)
+	{
+		if (!lock || !*lock)
+			return EINVAL;
+
+		return (*lock)->mutex.try_acquire() ? 0 : EBUSY;
+	}
+
+
+	int pthread_spin_unlock(pthread_spinlock_t *lock)
+	{
+		if (!lock || !*lock)
+			return EINVAL;
+
+		(*lock)->mutex.release();
 
 		return 0;
 	}
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -162,6 +162,8 @@ class QNitpickerPlatformWindow : public QObject, public QPlatformWindow
 
 	    unsigned char *framebuffer();
 
+	    Framebuffer::Mode framebuffer_mode() const { return _current_mode; }
+
 		void refresh(int x, int y, int w, int h);
 
 
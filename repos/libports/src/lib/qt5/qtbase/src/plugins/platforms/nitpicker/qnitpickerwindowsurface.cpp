@@ -5,15 +5,12 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
  */
 
-/* Genode includes */
-#include <blit/blit.h>
-
 /* Qt includes */
 #include <private/qguiapplication_p.h>
 
@@ -30,7 +27,7 @@ static const bool verbose = false;
 QT_BEGIN_NAMESPACE
 
 QNitpickerWindowSurface::QNitpickerWindowSurface(QWindow *window)
-    : QPlatformBackingStore(window), _backbuffer(0), _framebuffer_changed(true)
+    : QPlatformBackingStore(window), _framebuffer_changed(true)
 {
     //qDebug() << "QNitpickerWindowSurface::QNitpickerWindowSurface:" << (long)this;
 
@@ -41,10 +38,7 @@ QNitpickerWindowSurface::QNitpickerWindowSurface(QWindow *window)
     connect(_platform_window, SIGNAL(framebuffer_changed()), this, SLOT(framebuffer_changed()));
 }
 
-QNitpickerWindowSurface::~QNitpickerWindowSurface()
-{
-	qFree(_backbuffer);
-}
+QNitpickerWindowSurface::~QNitpickerWindowSurface() { }
 
 QPaintDevice *QNitpickerWindowSurface::paintDevice()
 {
@@ -57,19 +51,21 @@ QPaintDevice *QNitpickerWindowSurface::paintDevice()
     		PDBG("framebuffer changed");
 
     	_framebuffer_changed = false;
+
     	/*
-    	 * It can happen that 'resize()' was not called yet, so the size needs
-    	 * to be obtained from the window.
+    	 * Qt paints directly into the nitpicker buffer, which spares the
+    	 * copy of each flushed region from a separate back buffer. The size
+    	 * is taken from the mode of the nitpicker buffer because 'resize()'
+    	 * may not have been called yet.
     	 */
         QImage::Format format = QGuiApplication::primaryScreen()->handle()->format();
-        QRect geo = _platform_window->geometry();
+        Framebuffer::Mode const mode = _platform_window->framebuffer_mode();
         unsigned int const bytes_per_pixel = QGuiApplication::primaryScreen()->depth() / 8;
-		qFree(_backbuffer);
-		_backbuffer = (unsigned char*)qMalloc(geo.width() * geo.height() * bytes_per_pixel);
-		_image = QImage(_backbuffer, geo.width(), geo.height(), geo.width() * bytes_per_pixel, format);
+		_image = QImage(_platform_window->framebuffer(), mode.width(), mode.height(),
+		                mode.width() * bytes_per_pixel, format);
 
         if (verbose)
-        	qDebug() << "QNitpickerWindowSurface::paintDevice(): w =" << geo.width() << ", h =" << geo.height();
+        	qDebug() << "QNitpickerWindowSurface::paintDevice(): w =" << mode.width() << ", h =" << mode.height();
     }
 
     if (verbose)
@@ -91,11 +87,12 @@ void QNitpickerWindowSurface::flush(QWindow *window, const QRegion &region, cons
     	         << ", offset =" << offset
     	         << ")";
 
-	unsigned int const bytes_per_pixel = _image.depth() / 8;
+	/* the pixels are already in place, so only the damage must be refreshed */
+	QVector<QRect> const rects = region.rects();
 
-	for (int i = 0; i < region.rects().size(); i++) {
+	for (int i = 0; i < rects.size(); i++) {
 
-		QRect rect(region.rects()[i]);
+		QRect rect(rects[i]);
 
 		/*
 		 * It happened that after resizing a window, the given flush region was
@@ -104,15 +101,8 @@ void QNitpickerWindowSurface::flush(QWindow *window, const QRegion &region, cons
 
 		rect &= _image.rect();
 
-		unsigned int buffer_offset = ((rect.y() + offset.y()) * _image.bytesPerLine()) +
-		                             ((rect.x() + offset.x()) * bytes_per_pixel);
-
-		blit(_image.bits() + buffer_offset,
-		     _image.bytesPerLine(),
-		     _platform_window->framebuffer() + buffer_offset,
-		     _image.bytesPerLine(),
-		     rect.width() * bytes_per_pixel,
-		     rect.height());
+		if (rect.isEmpty())
+			continue;
 
 		_platform_window->refresh(rect.x() + offset.x(),
 		                          rect.y() + offset.y(),
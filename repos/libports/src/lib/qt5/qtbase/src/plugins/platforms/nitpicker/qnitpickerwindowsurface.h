@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -28,7 +28,6 @@ class QNitpickerWindowSurface : public QObject, public QPlatformBackingStore
 	private:
 
 		QNitpickerPlatformWindow *_platform_window;
-		unsigned char            *_backbuffer;
 		QImage                    _image;
 		bool                      _framebuffer_changed;
 
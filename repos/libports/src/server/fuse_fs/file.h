@@ -9,6 +9,10 @@
 #ifndef _FILE_H_
 #define _FILE_H_
 
+/* Genode includes */
+#include <base/env.h>
+#include <util/misc_math.h>
+
 /* local includes */
 #include <mode_util.h>
 #include <node.h>
@@ -18,6 +22,21 @@
 
 namespace File_system {
 	class File;
+
+	/**
+	 * Return counter of modifications of the file system
+	 *
+	 * Several handles may refer to the same file and the content of a
+	 * file may be changed via any of them. Hence, each modification of
+	 * the file system invalidates the read-ahead buffers of all files.
+	 */
+	inline unsigned long &modification_count()
+	{
+		static unsigned long count;
+		return count;
+	}
+
+	inline void file_system_modified() { modification_count()++; }
 }
 
 
@@ -32,6 +51,42 @@ class File_system::File : public Node
 
 		struct fuse_file_info  _file_info;
 
+		/*
+		 * Read-ahead buffer
+		 *
+		 * Clients tend to read files sequentially in small chunks, each
+		 * resulting in a FUSE operation that involves the look-up of the
+		 * file and its block map by the FUSE file system. Small reads are
+		 * therefore served from a buffer filled with one large read.
+		 * Requests of at least the buffer size are passed through intact.
+		 */
+		enum { READ_AHEAD_SIZE = 32*1024 };
+
+		char          *_ra_buf        = nullptr;
+		seek_off_t     _ra_offset     = 0;
+		size_t         _ra_length     = 0;
+		unsigned long  _ra_generation = 0;
+
+		bool _read_ahead_covers(seek_off_t offset, size_t len) const
+		{
+			if (!_ra_buf || _ra_generation != modification_count())
+				return false;
+
+			if (offset < _ra_offset || offset > _ra_offset + _ra_length)
+				return false;
+
+			/* a partially filled buffer ends at the end of the file */
+			return offset + len <= _ra_offset + _ra_length
+			    || _ra_length < READ_AHEAD_SIZE;
+		}
+
+		size_t _read(char *dst, size_t len, seek_off_t seek_offset)
+		{
+			int ret = Fuse::fuse()->op.read(_path.base(), dst, len,
+			                                seek_offset, &_file_info);
+			return ret < 0 ? 0 : ret;
+		}
+
 		void _open_path(char const *path, Mode mode, bool create, bool trunc)
 		{
 			int res;
@@ -66,6 +121,8 @@ class File_system::File : public Node
 			while (true);
 
 			if (trunc) {
+				file_system_modified();
+
 				res = Fuse::fuse()->op.ftruncate(path, 0, &_file_info);
 
 				if (res != 0) {
@@ -100,6 +157,9 @@ class File_system::File : public Node
 		~File()
 		{
 			Fuse::fuse()->op.release(_path.base(), &_file_info);
+
+			if (_ra_buf)
+				Genode::env()->heap()->free(_ra_buf, READ_AHEAD_SIZE);
 		}
 
 		struct fuse_file_info *file_info() { return &_file_info; }
@@ -124,9 +184,24 @@ class File_system::File : public Node
 			if (seek_offset == ~0ULL)
 				seek_offset = _length();
 
-			int ret = Fuse::fuse()->op.read(_path.base(), dst, len,
-			                                seek_offset, &_file_info);
-			return ret < 0 ? 0 : ret;
+			if (len >= READ_AHEAD_SIZE)
+				return _read(dst, len, seek_offset);
+
+			if (!_read_ahead_covers(seek_offset, len)) {
+
+				if (!_ra_buf)
+					_ra_buf = (char *)Genode::env()->heap()->alloc(READ_AHEAD_SIZE);
+
+				_ra_generation = modification_count();
+				_ra_offset     = seek_offset;
+				_ra_length     = _read(_ra_buf, READ_AHEAD_SIZE, seek_offset);
+			}
+
+			size_t const avail = _ra_offset + _ra_length - seek_offset;
+			size_t const n     = Genode::min(len, avail);
+
+			Genode::memcpy(dst, _ra_buf + (seek_offset - _ra_offset), n);
+			return n;
 		}
 
 		size_t write(char const *src, size_t len, seek_off_t seek_offset)
@@ -135,6 +210,8 @@ class File_system::File : public Node
 			if (seek_offset == ~0ULL)
 				seek_offset = _length();
 
+			file_system_modified();
+
 			int ret = Fuse::fuse()->op.write(_path.base(), src, len,
 			                                 seek_offset, &_file_info);
 			return ret < 0 ? 0 : ret;
@@ -142,6 +219,8 @@ class File_system::File : public Node
 
 		void truncate(file_size_t size)
 		{
+			file_system_modified();
+
 			int res = Fuse::fuse()->op.ftruncate(_path.base(), size,
 			                                     &_file_info);
 			if (res == 0)
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -342,6 +342,8 @@ class File_system::Session_component : public Session_rpc_object
 				throw Invalid_name();
 			}
 
+			file_system_modified();
+
 			/* XXX remove direct use of FUSE operations */
 			int res = Fuse::fuse()->op.unlink(absolute_path.base());
 
@@ -403,6 +405,8 @@ class File_system::Session_component : public Session_rpc_object
 			PDBGV("from_path = %s", absolute_from_path.base());
 			PDBGV("to_path = %s", absolute_to_path.base());
 
+			file_system_modified();
+
 			/* XXX remove direct use of FUSE operations */
 			int res = Fuse::fuse()->op.rename(absolute_to_path.base(),
 			                                  absolute_from_path.base());
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2010-2013 Genode Labs GmbH
+ * Copyright (C) 2010-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -45,6 +45,23 @@ static bool process_config(char **file)
 }
 
 
+/**
+ * Return path of the standard-library archive, or 0 if not configured
+ */
+static char const *stdlib_archive()
+{
+	static char path[128];
+
+	try {
+		Genode::config()->xml_node().sub_node("stdlib")
+		                 .attribute("archive").value(path, sizeof(path));
+		return path;
+	} catch (...) { }
+
+	return 0;
+}
+
+
 int main()
 {
 	using namespace Genode;
@@ -70,6 +87,16 @@ int main()
 	Py_InteractiveFlag = 0;
 	Py_Initialize();
 
+	/*
+	 * Import modules solely from the archive via 'zipimport', which reads
+	 * the archive directory once instead of probing the file system for
+	 * each module.
+	 */
+	if (char const *archive = stdlib_archive()) {
+		PDBG("Using standard library archive: %s", archive);
+		PySys_SetPath(const_cast<char *>(archive));
+	}
+
 	PDBG("Starting python ...");
 	PyRun_SimpleFile(&fp, name);
 
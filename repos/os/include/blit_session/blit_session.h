@@ -0,0 +1,249 @@
+/*
+ * \brief  Session interface of 2D engines
+ * \author Norman Feske
+ * \date   2015-12-17
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BLIT_SESSION__BLIT_SESSION_H_
+#define _INCLUDE__BLIT_SESSION__BLIT_SESSION_H_
+
+#include <session/session.h>
+#include <base/signal.h>
+#include <dataspace/capability.h>
+#include <os/surface.h>
+#include <os/handle_registry.h>
+#include <util/color.h>
+#include <framebuffer_session/framebuffer_session.h>
+
+namespace Blit {
+	struct Surface;
+	struct Session;
+	typedef Genode::Surface_base::Rect  Rect;
+	typedef Genode::Surface_base::Point Point;
+	typedef Genode::Surface_base::Area  Area;
+	typedef Genode::Color               Color;
+}
+
+
+/**
+ * Interface for submitting painting operations to a 2D engine
+ *
+ * The operations refer to surfaces, which are dataspaces registered at the
+ * session. Operations are issued in batches via a command buffer shared
+ * between client and server. The server executes a batch asynchronously
+ * and notifies the client about its completion.
+ */
+struct Blit::Session : Genode::Session
+{
+	static const char *service_name() { return "Blit"; }
+
+	/**
+	 * Session-local surface handle
+	 */
+	typedef Genode::Handle<Surface> Surface_handle;
+
+	struct Command
+	{
+		enum Opcode { OP_FILL, OP_COPY, OP_BLEND, OP_NOP };
+
+		struct Nop { static Opcode opcode() { return OP_NOP; } };
+
+		/**
+		 * Fill rectangle of 'dst' with 'color'
+		 *
+		 * If 'color.a' is lower than 255, the color is mixed with the
+		 * pixels of 'dst'.
+		 */
+		struct Fill
+		{
+			static Opcode opcode() { return OP_FILL; }
+			Surface_handle dst;
+			Rect           rect;
+			Color          color;
+		};
+
+		/**
+		 * Copy 'rect' of 'src' to position 'pos' of 'dst'
+		 */
+		struct Copy
+		{
+			static Opcode opcode() { return OP_COPY; }
+			Surface_handle dst;
+			Surface_handle src;
+			Rect           rect;
+			Point          pos;
+		};
+
+		/**
+		 * Mix 'rect' of 'src' into 'dst' at position 'pos'
+		 *
+		 * The source pixels are weighted by the alpha channel of 'src'
+		 * if present, and by 'alpha' otherwise.
+		 */
+		struct Blend
+		{
+			static Opcode opcode() { return OP_BLEND; }
+			Surface_handle dst;
+			Surface_handle src;
+			Rect           rect;
+			Point          pos;
+			int            alpha;
+		};
+
+		Opcode opcode;
+		union
+		{
+			Nop   nop;
+			Fill  fill;
+			Copy  copy;
+			Blend blend;
+		};
+
+		Command() : opcode(OP_NOP) { }
+
+		template <typename ARGS>
+		Command(ARGS args)
+		{
+			opcode = ARGS::opcode();
+			reinterpret_cast<ARGS &>(nop) = args;
+		}
+	};
+
+
+	/**
+	 * Command buffer shared between server and client
+	 */
+	class Command_buffer
+	{
+		public:
+
+			enum { MAX_COMMANDS = 256 };
+
+		private:
+
+			unsigned _num = 0;
+
+			Command _commands[MAX_COMMANDS];
+
+		public:
+
+			bool is_full() const { return _num >= MAX_COMMANDS; }
+
+			unsigned num() const
+			{
+				/* copy out _num value to avoid use-after-check problems */
+				unsigned const num = _num;
+				return num <= MAX_COMMANDS ? num : 0;
+			}
+
+			void reset() { _num = 0; }
+
+			/**
+			 * Enqueue command
+			 *
+			 * The command will be dropped if the buffer is full. Check for this
+			 * condition by calling 'is_full()' prior calling this method.
+			 */
+			void enqueue(Command const &command)
+			{
+				if (!is_full())
+					_commands[_num++] = command;
+			}
+
+			Command get(unsigned i)
+			{
+				if (i >= MAX_COMMANDS) return Command(Command::Nop());
+
+				return _commands[i];
+			}
+	};
+
+	/**
+	 * Exception types
+	 */
+	struct Out_of_metadata   : Genode::Exception { };
+	struct Invalid_surface   : Genode::Exception { };
+
+	virtual ~Session() { }
+
+	/**
+	 * Register dataspace as surface
+	 *
+	 * \param ds      dataspace holding the pixels
+	 * \param size    size of the surface in pixels
+	 * \param format  pixel format
+	 * \param alpha   true if an alpha channel of one byte per pixel follows
+	 *                the pixels
+	 *
+	 * \throw Out_of_metadata
+	 * \throw Invalid_surface  the engine cannot access the dataspace or
+	 *                         does not support the format
+	 */
+	virtual Surface_handle surface(Genode::Dataspace_capability ds, Area size,
+	                               Framebuffer::Mode::Format format,
+	                               bool alpha) = 0;
+
+	/**
+	 * Release surface
+	 *
+	 * Operations referring to the surface that are not completed yet are
+	 * executed before.
+	 */
+	virtual void release_surface(Surface_handle) = 0;
+
+	/**
+	 * Request dataspace used for issuing commands
+	 */
+	virtual Genode::Dataspace_capability command_dataspace() = 0;
+
+	/**
+	 * Submit batch of commands contained in the command dataspace
+	 *
+	 * \return  sequence number of the batch
+	 *
+	 * The method returns as soon as the server took over the commands. So
+	 * the command buffer can be refilled immediately. However, the
+	 * surfaces affected by the batch must not be accessed by the client
+	 * until the batch is completed.
+	 */
+	virtual unsigned long submit() = 0;
+
+	/**
+	 * Return sequence number of the latest completed batch
+	 */
+	virtual unsigned long completed() = 0;
+
+	/**
+	 * Register signal handler to be notified on the completion of batches
+	 */
+	virtual void completion_sigh(Genode::Signal_context_capability) = 0;
+
+
+	/*********************
+	 ** RPC declaration **
+	 *********************/
+
+	GENODE_RPC_THROW(Rpc_surface, Surface_handle, surface,
+	                 GENODE_TYPE_LIST(Out_of_metadata, Invalid_surface),
+	                 Genode::Dataspace_capability, Area,
+	                 Framebuffer::Mode::Format, bool);
+	GENODE_RPC(Rpc_release_surface, void, release_surface, Surface_handle);
+	GENODE_RPC(Rpc_command_dataspace, Genode::Dataspace_capability, command_dataspace);
+	GENODE_RPC(Rpc_submit, unsigned long, submit);
+	GENODE_RPC(Rpc_completed, unsigned long, completed);
+	GENODE_RPC(Rpc_completion_sigh, void, completion_sigh,
+	           Genode::Signal_context_capability);
+
+	GENODE_RPC_INTERFACE(Rpc_surface, Rpc_release_surface,
+	                     Rpc_command_dataspace, Rpc_submit, Rpc_completed,
+	                     Rpc_completion_sigh);
+};
+
+#endif /* _INCLUDE__BLIT_SESSION__BLIT_SESSION_H_ */
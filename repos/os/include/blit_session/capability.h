@@ -0,0 +1,22 @@
+/*
+ * \brief  Blit session capability type
+ * \author Norman Feske
+ * \date   2015-12-17
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BLIT_SESSION__CAPABILITY_H_
+#define _INCLUDE__BLIT_SESSION__CAPABILITY_H_
+
+#include <base/capability.h>
+#include <blit_session/blit_session.h>
+
+namespace Blit { typedef Genode::Capability<Session> Session_capability; }
+
+#endif /* _INCLUDE__BLIT_SESSION__CAPABILITY_H_ */
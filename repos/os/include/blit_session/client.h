@@ -0,0 +1,88 @@
+/*
+ * \brief  Client-side blit session interface
+ * \author Norman Feske
+ * \date   2015-12-17
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BLIT_SESSION__CLIENT_H_
+#define _INCLUDE__BLIT_SESSION__CLIENT_H_
+
+#include <blit_session/capability.h>
+#include <base/rpc_client.h>
+#include <os/attached_dataspace.h>
+
+namespace Blit { class Session_client; }
+
+
+class Blit::Session_client : public Genode::Rpc_client<Session>
+{
+	private:
+
+		Genode::Attached_dataspace _command_ds;
+
+		Command_buffer &_command_buffer;
+
+	public:
+
+		explicit Session_client(Session_capability session)
+		:
+			Rpc_client<Session>(session),
+			_command_ds(command_dataspace()),
+			_command_buffer(*_command_ds.local_addr<Command_buffer>())
+		{ }
+
+		Surface_handle surface(Genode::Dataspace_capability ds, Area size,
+		                       Framebuffer::Mode::Format format,
+		                       bool alpha) override
+		{
+			return call<Rpc_surface>(ds, size, format, alpha);
+		}
+
+		void release_surface(Surface_handle surface) override {
+			call<Rpc_release_surface>(surface); }
+
+		Genode::Dataspace_capability command_dataspace() override {
+			return call<Rpc_command_dataspace>(); }
+
+		unsigned long submit() override
+		{
+			unsigned long const batch = call<Rpc_submit>();
+			_command_buffer.reset();
+			return batch;
+		}
+
+		unsigned long completed() override { return call<Rpc_completed>(); }
+
+		void completion_sigh(Genode::Signal_context_capability sigh) override {
+			call<Rpc_completion_sigh>(sigh); }
+
+		/**
+		 * Enqueue command to command buffer
+		 *
+		 * The command is not executed before 'submit' is called. If there
+		 * is no space left in the command buffer, the pending commands are
+		 * submitted to make room in the buffer.
+		 */
+		template <typename CMD, typename... ARGS>
+		void enqueue(ARGS... args)
+		{
+			enqueue(Command( CMD { args... } ));
+		}
+
+		void enqueue(Command const &command)
+		{
+			if (_command_buffer.is_full())
+				submit();
+
+			_command_buffer.enqueue(command);
+		}
+};
+
+#endif /* _INCLUDE__BLIT_SESSION__CLIENT_H_ */
@@ -0,0 +1,38 @@
+/*
+ * \brief  Connection to a 2D engine
+ * \author Norman Feske
+ * \date   2015-12-17
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BLIT_SESSION__CONNECTION_H_
+#define _INCLUDE__BLIT_SESSION__CONNECTION_H_
+
+#include <blit_session/client.h>
+#include <base/connection.h>
+
+namespace Blit { struct Connection; }
+
+
+struct Blit::Connection : Genode::Connection<Session>, Session_client
+{
+	/**
+	 * Constructor
+	 *
+	 * The donated quota covers the command buffer and the meta data of the
+	 * registered surfaces.
+	 */
+	Connection(Genode::size_t ram_quota = 2*sizeof(Session::Command_buffer))
+	:
+		Genode::Connection<Session>(session("ram_quota=%zd", ram_quota)),
+		Session_client(cap())
+	{ }
+};
+
+#endif /* _INCLUDE__BLIT_SESSION__CONNECTION_H_ */
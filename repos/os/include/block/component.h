@@ -91,7 +91,8 @@ class Block::Session_component : public Block::Session_component_base,
 		 * Range check packet request
 		 */
 		inline bool _range_check(Packet_descriptor &p) {
-			return p.block_number() + p.block_count() - 1
+			return p.operation() == Block::Packet_descriptor::FLUSH ||
+			       p.block_number() + p.block_count() - 1
 			       < _driver.block_count(); }
 
 		/**
@@ -137,6 +138,15 @@ class Block::Session_component : public Block::Session_component_base,
 						              _p_to_handle);
 					break;
 
+				case Block::Packet_descriptor::TRIM:
+					_driver.trim(packet.block_number(), packet.block_count(),
+					             _p_to_handle);
+					break;
+
+				case Block::Packet_descriptor::FLUSH:
+					_driver.flush(_p_to_handle);
+					break;
+
 				default:
 					throw Driver::Io_error();
 				}
@@ -162,6 +172,8 @@ class Block::Session_component : public Block::Session_component_base,
 			     && tx_sink()->packet_avail();
 				 _ack_queue_full = (++_p_in_fly >= tx_sink()->ack_slots_free()))
 				_handle_packet(tx_sink()->get_packet());
+
+			_driver.submit_deferred();
 		}
 
 		/**
@@ -240,6 +252,8 @@ class Block::Session_component : public Block::Session_component_base,
 		}
 
 		void sync() { _driver.sync(); }
+
+		Transfer_info transfer_info() { return _driver.transfer_info(); }
 };
 
 
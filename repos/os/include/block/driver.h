@@ -95,6 +95,15 @@ class Block::Driver
 		 */
 		virtual Session::Operations ops() = 0;
 
+		/**
+		 * Request transfer characteristics of the device
+		 *
+		 * Note: should be overriden by drivers that process requests
+		 *       concurrently or restrict the request size
+		 */
+		virtual Session::Transfer_info transfer_info() {
+			return Session::Transfer_info(); }
+
 		/**
 		 * Read from medium
 		 *
@@ -167,6 +176,39 @@ class Block::Driver
 		                       Packet_descriptor &packet) {
 			throw Io_error(); }
 
+		/**
+		 * Discard blocks of the medium
+		 *
+		 * \param block_number  number of first block to discard
+		 * \param block_count   number of blocks to discard
+		 * \param packet        packet descriptor from the client
+		 *
+		 * \throw Request_congestion
+		 *
+		 * Note: should be overridden by devices that support it
+		 */
+		virtual void trim(sector_t           block_number,
+		                  Genode::size_t     block_count,
+		                  Packet_descriptor &packet) {
+			throw Io_error(); }
+
+		/**
+		 * Write barrier
+		 *
+		 * \param packet  packet descriptor from the client, to be acknowledged
+		 *                once all writes acknowledged before are durable
+		 *
+		 * \throw Request_congestion
+		 *
+		 * Note: the default implementation suffices for drivers that
+		 *       acknowledge writes only after they reached the medium
+		 */
+		virtual void flush(Packet_descriptor &packet)
+		{
+			sync();
+			ack_packet(packet);
+		}
+
 		/**
 		 * Check if DMA is enabled for driver
 		 *
@@ -201,6 +243,17 @@ class Block::Driver
 		 */
 		virtual void sync() {}
 
+		/**
+		 * Issue requests the driver deferred
+		 *
+		 * The session component calls this function after handing all
+		 * currently available requests to the driver.
+		 *
+		 * Note: should be overriden by drivers that combine adjacent
+		 *       requests instead of processing them immediately
+		 */
+		virtual void submit_deferred() { }
+
 		/**
 		 * Informs the driver that the client session was closed
 		 *
@@ -36,12 +36,18 @@ namespace Block {
  * The data associated with the 'Packet_descriptor' is either
  * the data read from or written to the block indicated by
  * its number.
+ *
+ * A 'TRIM' request marks the given range of blocks as unused, its content
+ * is undefined afterwards. A 'FLUSH' request is acknowledged only after all
+ * write requests acknowledged before have reached stable storage, its
+ * block range is ignored. Neither of both carries payload, but like any
+ * packet, they must refer to a non-empty range of the packet buffer.
  */
 class Block::Packet_descriptor : public Genode::Packet_descriptor
 {
 	public:
 
-		enum Opcode    { READ, WRITE, END };
+		enum Opcode    { READ, WRITE, TRIM, FLUSH, END };
 		enum Alignment { PACKET_ALIGNMENT = 11 };
 
 	private:
@@ -121,6 +127,55 @@ struct Block::Session : public Genode::Session
 	};
 
 
+	/**
+	 * Transfer characteristics preferred by the server
+	 *
+	 * The packet-stream queues are dimensioned statically by
+	 * 'TX_QUEUE_SIZE'. Within this bound, the server advertises how many
+	 * requests the device is able to process concurrently and the largest
+	 * request it handles in one piece. A client uses this information to
+	 * size its transmission buffer and to limit the number of in-flight
+	 * requests. A value of zero denotes that the server has no preference.
+	 */
+	struct Transfer_info
+	{
+		Genode::size_t max_transfer; /* maximum request size in bytes    */
+		unsigned       queue_depth;  /* number of concurrent requests    */
+		unsigned       align_log2;   /* preferred request alignment      */
+
+		Transfer_info() : max_transfer(0), queue_depth(0), align_log2(0) { }
+
+		Transfer_info(Genode::size_t max_transfer, unsigned queue_depth,
+		              unsigned align_log2)
+		: max_transfer(max_transfer), queue_depth(queue_depth),
+		  align_log2(align_log2) { }
+
+		/**
+		 * Return queue depth bounded by the packet-stream queue size
+		 */
+		unsigned depth() const
+		{
+			return (queue_depth && queue_depth < TX_QUEUE_SIZE)
+			       ? queue_depth : (unsigned)TX_QUEUE_SIZE;
+		}
+
+		/**
+		 * Return recommended size of the transmission buffer
+		 *
+		 * \param min  size used if the server has no preference
+		 * \param max  upper bound of the returned size
+		 */
+		Genode::size_t tx_buf_size(Genode::size_t min, Genode::size_t max) const
+		{
+			if (!max_transfer || !queue_depth)
+				return min;
+
+			Genode::size_t const size = max_transfer * depth();
+			return size < min ? min : (size > max ? max : size);
+		}
+	};
+
+
 	typedef Genode::Packet_stream_policy<Block::Packet_descriptor,
 	                                     TX_QUEUE_SIZE, TX_QUEUE_SIZE,
 	                                     char> Tx_policy;
@@ -147,6 +202,11 @@ struct Block::Session : public Genode::Session
 	 */
 	virtual void sync() = 0;
 
+	/**
+	 * Request transfer characteristics of the block device
+	 */
+	virtual Transfer_info transfer_info() { return Transfer_info(); }
+
 	/**
 	 * Request packet-transmission channel
 	 */
@@ -166,7 +226,8 @@ struct Block::Session : public Genode::Session
 	           Genode::size_t *, Operations *);
 	GENODE_RPC(Rpc_tx_cap, Genode::Capability<Tx>, _tx_cap);
 	GENODE_RPC(Rpc_sync, void, sync);
-	GENODE_RPC_INTERFACE(Rpc_info, Rpc_tx_cap, Rpc_sync);
+	GENODE_RPC(Rpc_transfer_info, Transfer_info, transfer_info);
+	GENODE_RPC_INTERFACE(Rpc_info, Rpc_tx_cap, Rpc_sync, Rpc_transfer_info);
 };
 
 #endif /* _INCLUDE__BLOCK_SESSION__BLOCK_SESSION_H_ */
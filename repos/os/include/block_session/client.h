@@ -58,6 +58,9 @@ class Block::Session_client : public Genode::Rpc_client<Session>
 		Tx::Source *tx() { return _tx.source(); }
 		void sync() override { call<Rpc_sync>(); }
 
+		Transfer_info transfer_info() override {
+			return call<Rpc_transfer_info>(); }
+
 		/*
 		 * Wrapper for alloc_packet, allocates 2KB aligned packets
 		 */
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <util/list.h>
+#include <util/volatile_object.h>
 #include <base/child.h>
 #include <init/child_policy.h>
 #include <os/child_policy_dynamic_rom.h>
@@ -73,7 +74,23 @@ class Child_base : public Genode::Child_policy
 		size_t                   _ram_limit;
 		Resources                _resources;
 		Genode::Service_registry _parent_services;
-		Genode::Rom_connection   _binary_rom;
+
+		/*
+		 * The binary ROM session is opened only if the binary dataspace is
+		 * not supplied by the creator of the child.
+		 */
+		Genode::Lazy_volatile_object<Genode::Rom_connection> _binary_rom;
+		Genode::Dataspace_capability const                   _binary_ds;
+
+		Genode::Dataspace_capability _request_binary(char const *binary,
+		                                             Genode::Dataspace_capability ds)
+		{
+			if (ds.valid())
+				return ds;
+
+			_binary_rom.construct(binary, _label.string());
+			return _binary_rom->dataspace();
+		}
 
 		enum { ENTRYPOINT_STACK_SIZE = 12*1024 };
 		Genode::Rpc_entrypoint _entrypoint;
@@ -109,19 +126,21 @@ class Child_base : public Genode::Child_policy
 		           Genode::size_t                    ram_quota,
 		           Genode::size_t                    ram_limit,
 		           Genode::Signal_context_capability yield_response_sig_cap,
-		           Genode::Signal_context_capability exit_sig_cap)
+		           Genode::Signal_context_capability exit_sig_cap,
+		           Genode::Dataspace_capability      binary_ds =
+		                                             Genode::Dataspace_capability())
 		:
 			_ram(ram),
 			_label(label),
 			_ram_quota(ram_quota),
 			_ram_limit(ram_limit),
 			_resources(_label.string(), _ram_quota),
-			_binary_rom(binary, _label.string()),
+			_binary_ds(_request_binary(binary, binary_ds)),
 			_entrypoint(&cap_session, ENTRYPOINT_STACK_SIZE, _label.string(), false),
 			_labeling_policy(_label.string()),
-			_binary_policy("binary", _binary_rom.dataspace(), &_entrypoint),
+			_binary_policy("binary", _binary_ds, &_entrypoint),
 			_config_policy("config", _entrypoint, &_resources.ram),
-			_child(_binary_rom.dataspace(), _resources.pd.cap(),
+			_child(_binary_ds, _resources.pd.cap(),
 			       _resources.ram.cap(), _resources.cpu.cap(),
 			       _resources.rm.cap(), &_entrypoint, this),
 			_yield_response_sigh_cap(yield_response_sig_cap),
@@ -0,0 +1,99 @@
+/*
+ * \brief  Pointer position as observed by the decorator
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__DECORATOR__POINTER_H_
+#define _INCLUDE__DECORATOR__POINTER_H_
+
+/* Genode includes */
+#include <input_session/input_session.h>
+#include <input/event.h>
+#include <os/attached_dataspace.h>
+
+/* decorator includes */
+#include <decorator/types.h>
+
+namespace Decorator { class Pointer; }
+
+
+/**
+ * Pointer state obtained from the input session of the decorator
+ *
+ * The window manager supplies the pointer position to the decorator as
+ * motion events via the input session of the decorator's nitpicker
+ * session. Compared to a report, no XML must be generated and parsed per
+ * motion. Because the window manager merges consecutive motion events, a
+ * decorator that falls behind merely observes the latest position. When
+ * used with nitpicker directly, the decorator sees the motion events
+ * referring to its own views.
+ *
+ * A 'LEAVE' event invalidates the position.
+ */
+class Decorator::Pointer
+{
+	private:
+
+		Input::Session &_input;
+
+		Genode::Attached_dataspace _ev_ds { _input.dataspace() };
+
+		bool  _valid = false;
+		Point _pos;
+
+	public:
+
+		Pointer(Input::Session &input, Genode::Signal_context_capability sigh)
+		:
+			_input(input)
+		{
+			_input.sigh(sigh);
+		}
+
+		/**
+		 * Consume the pending input events
+		 *
+		 * \return  true if the pointer state changed
+		 */
+		bool update()
+		{
+			bool  const orig_valid = _valid;
+			Point const orig_pos   = _pos;
+
+			Input::Event const * const events =
+				_ev_ds.local_addr<Input::Event>();
+
+			while (_input.is_pending()) {
+
+				int const num_events = _input.flush();
+
+				for (int i = 0; i < num_events; i++) {
+
+					Input::Event const &ev = events[i];
+
+					if (ev.is_absolute_motion()) {
+						_pos   = Point(ev.ax(), ev.ay());
+						_valid = true;
+					}
+
+					if (ev.type() == Input::Event::LEAVE)
+						_valid = false;
+				}
+			}
+
+			return (_valid != orig_valid) || (_valid && _pos != orig_pos);
+		}
+
+		bool  valid()    const { return _valid; }
+		Point position() const { return _pos; }
+};
+
+#endif /* _INCLUDE__DECORATOR__POINTER_H_ */
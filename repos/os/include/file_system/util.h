@@ -100,108 +100,153 @@ namespace File_system {
 	}
 
 
+	/**
+	 * Return size of the packets used for transferring 'count' bytes
+	 *
+	 * The size is chosen such that several packets fit into the bulk buffer
+	 * at the same time, allowing the server to process the next packet while
+	 * the client copies the payload of the previous one.
+	 */
+	static inline size_t packet_size(Session::Tx::Source &source, size_t count)
+	{
+		return Genode::min(count, source.bulk_buffer_size() / 4);
+	}
+
+
 	/**
 	 * Read file content
+	 *
+	 * Requests for consecutive parts of the file are submitted before
+	 * waiting for the first acknowledgement.
 	 */
 	static inline size_t read(Session &fs, Node_handle const &node_handle,
 	                          void *dst, size_t count, seek_off_t seek_offset = 0)
 	{
-		bool success = true;
 		Session::Tx::Source &source = *fs.tx();
 
-		size_t const max_packet_size = source.bulk_buffer_size() / 2;
+		collect_acknowledgements(source);
 
-		size_t remaining_count = count;
+		size_t const max_packet_size = packet_size(source, count);
 
-		while (remaining_count && success) {
+		size_t   submitted = 0;     /* number of bytes requested */
+		size_t   end       = count; /* end of valid data */
+		unsigned pending   = 0;     /* number of packets in flight */
 
-			collect_acknowledgements(source);
+		while (pending || submitted < end) {
 
-			size_t const curr_packet_size =
-				Genode::min(remaining_count, max_packet_size);
+			while (submitted < end && source.ready_to_submit()) {
 
-			Packet_descriptor
-				packet(source.alloc_packet(curr_packet_size),
-				       node_handle,
-				       File_system::Packet_descriptor::READ,
-				       curr_packet_size,
-				       seek_offset);
+				size_t const curr_packet_size =
+					Genode::min(end - submitted, max_packet_size);
 
-			/* pass packet to server side */
-			source.submit_packet(packet);
+				Packet_descriptor packet;
+				try {
+					packet = Packet_descriptor(source.alloc_packet(curr_packet_size),
+					                           node_handle,
+					                           File_system::Packet_descriptor::READ,
+					                           curr_packet_size,
+					                           seek_offset + submitted);
+				} catch (Session::Tx::Source::Packet_alloc_failed) {
+					if (!pending) throw;
+					break;
+				}
 
-			packet = source.get_acked_packet();
-			success = packet.succeeded();
+				/* pass packet to server side */
+				source.submit_packet(packet);
 
-			size_t const read_num_bytes =
-				Genode::min(packet.length(), curr_packet_size);
+				submitted += curr_packet_size;
+				pending++;
+			}
 
-			/* copy-out payload into destination buffer */
-			Genode::memcpy(dst, source.packet_content(packet), read_num_bytes);
+			Packet_descriptor packet = source.get_acked_packet();
+			pending--;
 
-			source.release_packet(packet);
+			size_t const offset = packet.position() - seek_offset;
+			size_t const read_num_bytes = packet.succeeded()
+			                            ? Genode::min(packet.length(), packet.size())
+			                            : 0;
 
-			/* prepare next iteration */
-			seek_offset += read_num_bytes;
-			dst = (void *)((Genode::addr_t)dst + read_num_bytes);
-			remaining_count -= read_num_bytes;
+			/* copy-out payload into destination buffer */
+			if (offset < end)
+				Genode::memcpy((void *)((Genode::addr_t)dst + offset),
+				               source.packet_content(packet),
+				               Genode::min(read_num_bytes, end - offset));
 
 			/*
 			 * If we received less bytes than requested, we reached the end
 			 * of the file.
 			 */
-			if (read_num_bytes < curr_packet_size)
-				break;
+			if (read_num_bytes < packet.size())
+				end = Genode::min(end, offset + read_num_bytes);
+
+			source.release_packet(packet);
 		}
 
-		return count - remaining_count;
+		return end;
 	}
 
 
 	/**
 	 * Write file content
+	 *
+	 * Packets are submitted without waiting for the acknowledgement of
+	 * their predecessors.
 	 */
 	static inline size_t write(Session &fs, Node_handle const &node_handle,
 	                          void const *src, size_t count, seek_off_t seek_offset = 0)
 	{
-		bool success = true;
 		Session::Tx::Source &source = *fs.tx();
 
-		size_t const max_packet_size = source.bulk_buffer_size() / 2;
+		collect_acknowledgements(source);
 
-		size_t remaining_count = count;
+		size_t const max_packet_size = packet_size(source, count);
 
-		while (remaining_count && success) {
+		size_t   submitted = 0;     /* number of bytes submitted */
+		size_t   end       = count; /* end of successfully written data */
+		unsigned pending   = 0;     /* number of packets in flight */
 
-			collect_acknowledgements(source);
+		while (pending || submitted < end) {
 
-			size_t const curr_packet_size =
-				Genode::min(remaining_count, max_packet_size);
+			while (submitted < end && source.ready_to_submit()) {
 
-			Packet_descriptor
-				packet(source.alloc_packet(curr_packet_size),
-				       node_handle,
-				       File_system::Packet_descriptor::WRITE,
-				       curr_packet_size,
-				       seek_offset);
+				size_t const curr_packet_size =
+					Genode::min(end - submitted, max_packet_size);
 
-			/* copy-out source buffer into payload */
-			Genode::memcpy(source.packet_content(packet), src, curr_packet_size);
+				Packet_descriptor packet;
+				try {
+					packet = Packet_descriptor(source.alloc_packet(curr_packet_size),
+					                           node_handle,
+					                           File_system::Packet_descriptor::WRITE,
+					                           curr_packet_size,
+					                           seek_offset + submitted);
+				} catch (Session::Tx::Source::Packet_alloc_failed) {
+					if (!pending) throw;
+					break;
+				}
 
-			/* pass packet to server side */
-			source.submit_packet(packet);
+				/* copy-out source buffer into payload */
+				Genode::memcpy(source.packet_content(packet),
+				               (void const *)((Genode::addr_t)src + submitted),
+				               curr_packet_size);
 
-			packet = source.get_acked_packet();;
-			success = packet.succeeded();
-			source.release_packet(packet);
+				/* pass packet to server side */
+				source.submit_packet(packet);
 
-			/* prepare next iteration */
-			seek_offset += curr_packet_size;
-			src = (void *)((Genode::addr_t)src + curr_packet_size);
-			remaining_count -= curr_packet_size;
+				submitted += curr_packet_size;
+				pending++;
+			}
+
+			Packet_descriptor packet = source.get_acked_packet();
+			pending--;
+
+			/* stop at the first failed packet */
+			if (!packet.succeeded())
+				end = Genode::min(end, (size_t)(packet.position() - seek_offset));
+
+			source.release_packet(packet);
 		}
 
-		return count - remaining_count;
+		return end;
 	}
 
 
@@ -15,6 +15,7 @@
 #define _INCLUDE__FILE_SYSTEM_SESSION__FILE_SYSTEM_SESSION_H_
 
 #include <base/exception.h>
+#include <dataspace/capability.h>
 #include <os/packet_stream.h>
 #include <packet_stream_tx/packet_stream_tx.h>
 #include <session/session.h>
@@ -193,7 +194,11 @@ struct File_system::Directory_entry
 
 struct File_system::Session : public Genode::Session
 {
-	enum { TX_QUEUE_SIZE = 16 };
+	/*
+	 * The queue is dimensioned to let clients keep a whole series of
+	 * requests in flight, e.g., the packets of a large read operation.
+	 */
+	enum { TX_QUEUE_SIZE = 64 };
 
 	typedef Genode::Packet_stream_policy<File_system::Packet_descriptor,
 	                                     TX_QUEUE_SIZE, TX_QUEUE_SIZE,
@@ -314,6 +319,22 @@ struct File_system::Session : public Genode::Session
 	 */
 	virtual void sync(Node_handle) { }
 
+	/**
+	 * Request read-only dataspace containing the content of a file
+	 *
+	 * The dataspace is shared by all clients that request it for the same
+	 * file and can be attached to map the file, or a page-aligned range of
+	 * it. Depending on the server, modifications of the file are reflected
+	 * in the dataspace or cause the server to withdraw the dataspace.
+	 * Clients must not write to the dataspace.
+	 *
+	 * \throw Invalid_handle  file handle is invalid
+	 * \return                invalid capability if the server does not
+	 *                         support the mapping of files
+	 */
+	virtual Genode::Dataspace_capability dataspace(File_handle) {
+		return Genode::Dataspace_capability(); }
+
 
 	/*******************
 	 ** RPC interface **
@@ -357,6 +378,9 @@ struct File_system::Session : public Genode::Session
 	                 GENODE_TYPE_LIST(Invalid_handle),
 	                 Node_handle, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_sync, void, sync, Node_handle);
+	GENODE_RPC_THROW(Rpc_dataspace, Genode::Dataspace_capability, dataspace,
+	                 GENODE_TYPE_LIST(Invalid_handle),
+	                 File_handle);
 
 	/*
 	 * Manual type-list definition, needed because the RPC interface
@@ -376,8 +400,9 @@ struct File_system::Session : public Genode::Session
 	        Genode::Meta::Type_tuple<Rpc_move,
 	        Genode::Meta::Type_tuple<Rpc_sigh,
 	        Genode::Meta::Type_tuple<Rpc_sync,
+	        Genode::Meta::Type_tuple<Rpc_dataspace,
 	                         Genode::Meta::Empty>
-	        > > > > > > > > > > > > Rpc_functions;
+	        > > > > > > > > > > > > > Rpc_functions;
 };
 
 #endif /* _INCLUDE__FILE_SYSTEM_SESSION__FILE_SYSTEM_SESSION_H_ */
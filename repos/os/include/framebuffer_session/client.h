@@ -38,6 +38,16 @@ struct Framebuffer::Session_client : Genode::Rpc_client<Session>
 
 	void refresh(int x, int y, int w, int h) override {
 		call<Rpc_refresh>(x, y, w, h); }
+
+	bool scanout(Genode::Dataspace_capability ds) override {
+		return call<Rpc_scanout>(ds); }
+
+	unsigned buffers(unsigned count) override {
+		return call<Rpc_buffers>(count); }
+
+	void flip(unsigned buffer) override { call<Rpc_flip>(buffer); }
+
+	Vsync vsync() override { return call<Rpc_vsync>(); }
 };
 
 #endif /* _INCLUDE__FRAMEBUFFER_SESSION__CLIENT_H_ */
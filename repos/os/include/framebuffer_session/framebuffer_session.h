@@ -21,6 +21,7 @@
 namespace Framebuffer {
 
 	struct Mode;
+	struct Vsync;
 	struct Session;
 }
 
@@ -67,6 +68,22 @@ struct Framebuffer::Mode
 };
 
 
+/**
+ * Vertical-blank info as returned by 'Framebuffer::Session::vsync()'
+ */
+struct Framebuffer::Vsync
+{
+	/* number of vertical blanks since the start of the session */
+	unsigned long count = 0;
+
+	/* time of the latest vertical blank in microseconds */
+	Genode::uint64_t timestamp_us = 0;
+
+	/* index of the buffer displayed since the latest vertical blank */
+	unsigned buffer = 0;
+};
+
+
 struct Framebuffer::Session : Genode::Session
 {
 	static const char *service_name() { return "Framebuffer"; }
@@ -115,6 +132,59 @@ struct Framebuffer::Session : Genode::Session
 	 */
 	virtual void sync_sigh(Genode::Signal_context_capability) = 0;
 
+	/**
+	 * Display the content of the specified dataspace directly
+	 *
+	 * \param ds  dataspace with the pixels of a complete screen in the
+	 *            current mode, or an invalid capability to revert to the
+	 *            framebuffer dataspace
+	 *
+	 * \return    true if the display controller scans out 'ds'
+	 *
+	 * This method allows a client that composes the screen from the
+	 * buffers of other clients, i.e., nitpicker, to hand over a buffer
+	 * that covers the whole screen to the display controller instead of
+	 * copying its content into the framebuffer dataspace. The server
+	 * reverts to the framebuffer dataspace on mode changes. Servers
+	 * without the ability to scan out arbitrary memory decline the
+	 * request.
+	 */
+	virtual bool scanout(Genode::Dataspace_capability ds) { return false; }
+
+	/**
+	 * Request number of buffers within the framebuffer dataspace
+	 *
+	 * \param count  number of buffers, each holding one screen
+	 *
+	 * \return       number of buffers provided by the server
+	 *
+	 * In multi-buffer mode, the buffers follow each other within the
+	 * dataspace returned by the next call of 'dataspace()'. The client
+	 * draws into a buffer that is not displayed and presents it via
+	 * 'flip()'. Servers that scan out a single buffer only return 1.
+	 * Initially, buffer 0 is displayed.
+	 */
+	virtual unsigned buffers(unsigned count) { return 1; }
+
+	/**
+	 * Display buffer from the next vertical blank on
+	 *
+	 * \param buffer  index of the buffer within the framebuffer dataspace
+	 *
+	 * The flip is completed once 'vsync()' reports the buffer as
+	 * displayed. Until then, the previously displayed buffer is still
+	 * scanned out and must not be modified by the client.
+	 */
+	virtual void flip(unsigned buffer) { }
+
+	/**
+	 * Return info about the latest vertical blank
+	 *
+	 * In multi-buffer mode, the signal handler registered via 'sync_sigh'
+	 * is notified at each vertical blank.
+	 */
+	virtual Vsync vsync() { return Vsync(); }
+
 
 	/*********************
 	 ** RPC declaration **
@@ -125,9 +195,14 @@ struct Framebuffer::Session : Genode::Session
 	GENODE_RPC(Rpc_refresh, void, refresh, int, int, int, int);
 	GENODE_RPC(Rpc_mode_sigh, void, mode_sigh, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_sync_sigh, void, sync_sigh, Genode::Signal_context_capability);
+	GENODE_RPC(Rpc_scanout, bool, scanout, Genode::Dataspace_capability);
+	GENODE_RPC(Rpc_buffers, unsigned, buffers, unsigned);
+	GENODE_RPC(Rpc_flip, void, flip, unsigned);
+	GENODE_RPC(Rpc_vsync, Vsync, vsync);
 
 	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_mode, Rpc_mode_sigh, Rpc_refresh,
-	                     Rpc_sync_sigh);
+	                     Rpc_sync_sigh, Rpc_scanout, Rpc_buffers, Rpc_flip,
+	                     Rpc_vsync);
 };
 
 #endif /* _INCLUDE__FRAMEBUFFER_SESSION__FRAMEBUFFER_SESSION_H_ */
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2010-2013 Genode Labs GmbH
+ * Copyright (C) 2010-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -22,7 +22,9 @@
 #include <cap_session/connection.h>
 #include <base/printf.h>
 #include <base/child.h>
+#include <util/noncopyable.h>
 #include <os/session_policy.h>
+#include <os/config.h>
 
 /* init includes */
 #include <init/child_config.h>
@@ -32,7 +34,9 @@ namespace Init {
 
 	class Routed_service;
 	class Name_registry;
+	class Ram_broker;
 	class Child_registry;
+	class Xml_node_copy;
 	class Child;
 }
 
@@ -80,14 +84,89 @@ namespace Init {
 	}
 
 
+	/**
+	 * Maximum length of a chain of affinity references among children
+	 */
+	enum { MAX_AFFINITY_REFERENCES = 8 };
+
 	inline Genode::Affinity::Location
 	read_affinity_location(Genode::Affinity::Space const &space,
-	                       Genode::Xml_node start_node)
+	                       Genode::Xml_node start_node, unsigned depth = 0);
+
+
+	/**
+	 * Return affinity location of the child with the specified name
+	 *
+	 * \return  location as declared by the '<start>' node of the child,
+	 *          or an invalid location if there is no such child
+	 */
+	inline Genode::Affinity::Location
+	affinity_location_of(Genode::Affinity::Space const &space,
+	                     char const *name, unsigned depth)
+	{
+		Genode::Affinity::Location location;
+
+		Genode::config()->xml_node().for_each_sub_node("start",
+			[&] (Genode::Xml_node start) {
+				if (start.has_attribute("name")
+				 && start.attribute("name").has_value(name))
+					location = read_affinity_location(space, start, depth); });
+
+		return location;
+	}
+
+
+	/**
+	 * Return location of the same size as 'other' that does not overlap
+	 *
+	 * The location is placed right of 'other' with wrap-around. If the
+	 * affinity space is too narrow, the location gets clipped. If there is
+	 * no room at all, 'other' is returned.
+	 */
+	inline Genode::Affinity::Location
+	separate_affinity_location(Genode::Affinity::Space    const &space,
+	                           Genode::Affinity::Location const &other)
+	{
+		if (other.width() >= space.width())
+			return other;
+
+		unsigned const x1 = (other.xpos() + other.width()) % space.width();
+
+		unsigned const width = Genode::min(other.width(),
+		                       Genode::min(space.width() - other.width(),
+		                                   space.width() - x1));
+
+		return Genode::Affinity::Location(x1, other.ypos(), width, other.height());
+	}
+
+
+	inline Genode::Affinity::Location
+	read_affinity_location(Genode::Affinity::Space const &space,
+	                       Genode::Xml_node start_node, unsigned depth)
 	{
 		typedef Genode::Affinity::Location Location;
 		try {
 			Genode::Xml_node node = start_node.sub_node("affinity");
 
+			/* location relative to the location of another child */
+			bool const colocate = node.has_attribute("colocate");
+			if (colocate || node.has_attribute("separate")) {
+
+				char name[Genode::Service::MAX_NAME_LEN];
+				node.attribute(colocate ? "colocate" : "separate")
+				    .value(name, sizeof(name));
+
+				Location const other = depth < MAX_AFFINITY_REFERENCES
+				                     ? affinity_location_of(space, name, depth + 1)
+				                     : Location();
+				if (!other.valid()) {
+					PWRN("invalid affinity reference to \"%s\"", name);
+					return Location(0, 0, space.width(), space.height());
+				}
+
+				return colocate ? other : separate_affinity_location(space, other);
+			}
+
 			/* if no position value is specified, select the whole row/column */
 			unsigned long const
 				default_width  = node.has_attribute("xpos") ? 1 : space.width(),
@@ -114,6 +193,19 @@ namespace Init {
 	/**
 	 * Return amount of RAM that is currently unused
 	 */
+	/**
+	 * Lock for serializing accesses to shared state of init
+	 *
+	 * Children may be constructed concurrently. The lock protects the
+	 * steps of the construction that depend on init's quota and the
+	 * registration of the child's services.
+	 */
+	inline Genode::Lock &construction_lock()
+	{
+		static Genode::Lock lock;
+		return lock;
+	}
+
 	static inline Genode::size_t avail_slack_ram_quota()
 	{
 		Genode::size_t const preserve = 128*1024;
@@ -331,6 +423,48 @@ class Init::Routed_service : public Genode::Service
 };
 
 
+/**
+ * Private copy of an XML node
+ *
+ * A child survives config updates that leave its start node untouched.
+ * Because each update replaces the dataspace of the config, the child
+ * keeps a copy of the XML nodes it refers to during its lifetime.
+ */
+class Init::Xml_node_copy : Genode::Noncopyable
+{
+	private:
+
+		Genode::size_t const _size;
+		char         * const _buf;
+		Genode::Xml_node const _node;
+
+		char *_copy(Genode::Xml_node node)
+		{
+			char *buf = (char *)Genode::env()->heap()->alloc(_size);
+			Genode::memcpy(buf, node.addr(), _size);
+			return buf;
+		}
+
+	public:
+
+		Xml_node_copy(Genode::Xml_node node)
+		: _size(node.size()), _buf(_copy(node)), _node(_buf, _size) { }
+
+		~Xml_node_copy() { Genode::env()->heap()->free(_buf, _size); }
+
+		Genode::Xml_node xml_node() const { return _node; }
+
+		/**
+		 * Return true if 'node' has a different content than the copy
+		 */
+		bool differs_from(Genode::Xml_node node) const
+		{
+			return node.size() != _size
+			    || Genode::memcmp(node.addr(), _buf, _size);
+		}
+};
+
+
 /**
  * Interface for name database
  */
@@ -352,6 +486,29 @@ struct Init::Name_registry
 };
 
 
+/**
+ * Interface for balancing RAM between the children
+ *
+ * If init lacks the RAM to satisfy the resource request of a child, the
+ * broker asks the children with reclaimable RAM to yield memory. The
+ * yielded memory is used to satisfy the pending resource requests.
+ */
+struct Init::Ram_broker
+{
+	virtual ~Ram_broker() { }
+
+	/**
+	 * Respond to resource request of 'child', reclaim RAM if needed
+	 */
+	virtual void request_ram(Child &child, Genode::size_t amount) = 0;
+
+	/**
+	 * Withdraw the RAM yielded by 'child'
+	 */
+	virtual void ram_yielded(Child &child) = 0;
+};
+
+
 class Init::Child : Genode::Child_policy
 {
 	public:
@@ -367,12 +524,72 @@ class Init::Child : Genode::Child_policy
 
 		Genode::List_element<Child> _list_element;
 
-		Genode::Xml_node _start_node;
+		Xml_node_copy const _start_node_copy;
+		Xml_node_copy const _default_route_copy;
+
+		Genode::Xml_node const _start_node         = _start_node_copy.xml_node();
+		Genode::Xml_node const _default_route_node = _default_route_copy.xml_node();
+
+		/*
+		 * Servers the child obtained services from
+		 *
+		 * When a server gets restarted on a config update, the clients of
+		 * the server have to be restarted too. If the array is exhausted,
+		 * the child is considered to be a client of all servers.
+		 */
+		enum { MAX_USED_SERVERS = 32 };
+		Genode::Lock          _used_servers_lock;
+		Genode::Server const *_used_servers[MAX_USED_SERVERS];
+		unsigned              _num_used_servers      = 0;
+		bool                  _used_servers_exceeded = false;
+
+		Genode::Service *_used(Genode::Service *service)
+		{
+			Genode::Lock::Guard guard(_used_servers_lock);
 
-		Genode::Xml_node _default_route_node;
+			Genode::Server const *server = service->server();
+
+			for (unsigned i = 0; i < _num_used_servers; i++)
+				if (_used_servers[i] == server)
+					return service;
+
+			if (_num_used_servers < MAX_USED_SERVERS)
+				_used_servers[_num_used_servers++] = server;
+			else
+				_used_servers_exceeded = true;
+
+			return service;
+		}
+
+		bool _started = false;
 
 		Name_registry *_name_registry;
 
+		Ram_broker *_ram_broker;
+
+		/*
+		 * RAM can be reclaimed from children that declare their RAM
+		 * resource as 'reclaimable', e.g., caches that shrink on a yield
+		 * request.
+		 */
+		static bool _read_ram_reclaimable(Genode::Xml_node start_node)
+		{
+			bool reclaimable = false;
+			start_node.for_each_sub_node("resource", [&] (Genode::Xml_node rsc) {
+				try {
+					if (rsc.attribute("name").has_value("RAM"))
+						reclaimable = rsc.attribute_value("reclaimable", false);
+				} catch (...) { }
+			});
+
+			return reclaimable;
+		}
+
+		bool const _ram_reclaimable = _read_ram_reclaimable(_start_node);
+
+		/* amount of a pending resource request, protected by the broker */
+		Genode::size_t _requested_ram_quota = 0;
+
 		/**
 		 * Unique child name and file name of ELF binary
 		 */
@@ -506,6 +723,18 @@ class Init::Child : Genode::Child_policy
 					ram_quota -= session_donations;
 				else ram_quota = 0;
 
+				Genode::Lock::Guard guard(construction_lock());
+
+				/*
+				 * Children constructed concurrently may have consumed quota
+				 * since 'Read_quota' checked the available quota.
+				 */
+				Genode::size_t const ram_avail = avail_slack_ram_quota();
+				if (ram_quota > ram_avail) {
+					ram_quota = ram_avail;
+					warn_insuff_quota(ram_avail);
+				}
+
 				ram.ref_account(Genode::env()->ram_session_cap());
 				Genode::env()->ram_session()->transfer_quota(ram.cap(), ram_quota);
 
@@ -557,6 +786,7 @@ class Init::Child : Genode::Child_policy
 		Child(Genode::Xml_node              start_node,
 		      Genode::Xml_node              default_route_node,
 		      Name_registry                *name_registry,
+		      Ram_broker                   *ram_broker,
 		      long                          prio_levels,
 		      Genode::Affinity::Space const &affinity_space,
 		      Genode::Service_registry      *parent_services,
@@ -564,9 +794,10 @@ class Init::Child : Genode::Child_policy
 		      Genode::Cap_session           *cap_session)
 		:
 			_list_element(this),
-			_start_node(start_node),
-			_default_route_node(default_route_node),
+			_start_node_copy(start_node),
+			_default_route_copy(default_route_node),
 			_name_registry(name_registry),
+			_ram_broker(ram_broker),
 			_name(start_node, name_registry),
 			_pd_args(start_node),
 			_resources(start_node, _name.unique, prio_levels,
@@ -595,7 +826,8 @@ class Init::Child : Genode::Child_policy
 
 			if (config_verbose) {
 				Genode::printf("child \"%s\"\n", _name.unique);
-				Genode::printf("  RAM quota:  %zu\n", _resources.ram_quota);
+				Genode::printf("  RAM quota:  %zu%s\n", _resources.ram_quota,
+				               _ram_reclaimable ? " (reclaimable)" : "");
 				Genode::printf("  ELF binary: %s\n", _name.file);
 				Genode::printf("  priority:   %ld\n", _resources.priority);
 			}
@@ -606,6 +838,8 @@ class Init::Child : Genode::Child_policy
 			try {
 				Xml_node service_node = start_node.sub_node("provides").sub_node("service");
 
+				Lock::Guard guard(construction_lock());
+
 				for (; ; service_node = service_node.next("service")) {
 
 					char name[Genode::Service::MAX_NAME_LEN];
@@ -637,8 +871,133 @@ class Init::Child : Genode::Child_policy
 
 		/**
 		 * Start execution of child
+		 *
+		 * Children that are already running are not affected.
 		 */
-		void start() { _entrypoint.activate(); }
+		void start()
+		{
+			if (_started)
+				return;
+
+			_started = true;
+			_entrypoint.activate();
+		}
+
+		/**
+		 * Return route used for resolving the child's session requests
+		 */
+		Genode::Xml_node route() const
+		{
+			try { return _start_node.sub_node("route"); }
+			catch (...) { }
+			return _default_route_node;
+		}
+
+		/**
+		 * Return true if the child's declaration differs from 'start_node'
+		 *
+		 * The default route is taken into account only if the start node
+		 * lacks a '<route>' declaration.
+		 */
+		bool differs_from(Genode::Xml_node start_node,
+		                  Genode::Xml_node default_route_node) const
+		{
+			if (_start_node_copy.differs_from(start_node))
+				return true;
+
+			return !_start_node.has_sub_node("route")
+			    && _default_route_copy.differs_from(default_route_node);
+		}
+
+		/*
+		 * The following methods are called by the RAM broker, which
+		 * serializes them.
+		 */
+
+		bool ram_reclaimable() const { return _ram_reclaimable; }
+
+		Genode::size_t requested_ram_quota() const { return _requested_ram_quota; }
+
+		void requested_ram_quota(Genode::size_t amount) { _requested_ram_quota = amount; }
+
+		/**
+		 * Ask the child to yield RAM
+		 */
+		void yield_ram(Genode::size_t amount)
+		{
+			char buf[64];
+			Genode::snprintf(buf, sizeof(buf), "ram_quota=%zu", amount);
+			_child.yield(Genode::Parent::Resource_args(buf));
+		}
+
+		/**
+		 * Transfer unused RAM of the child back to init
+		 *
+		 * \param max_amount  upper bound of the withdrawn amount
+		 * 
+eturn            withdrawn amount
+		 */
+		Genode::size_t withdraw_ram(Genode::size_t max_amount)
+		{
+			/* leave the child some slack for its own bookkeeping */
+			enum { RESERVE = 64*1024 };
+
+			Genode::size_t const avail = _resources.ram.avail();
+			Genode::size_t const amount =
+				Genode::min(avail > RESERVE ? avail - RESERVE : 0, max_amount);
+
+			if (!amount || _resources.ram.transfer_quota(Genode::env()->ram_session_cap(),
+			                                             amount))
+				return 0;
+
+			return amount;
+		}
+
+		/**
+		 * Satisfy a pending resource request if init has enough slack RAM
+		 *
+		 * 
+eturn  true if no resource request remains pending
+		 */
+		bool try_response_to_resource_request()
+		{
+			if (!_requested_ram_quota)
+				return true;
+
+			if (avail_slack_ram_quota() < _requested_ram_quota)
+				return false;
+
+			Genode::env()->ram_session()->transfer_quota(_resources.ram.cap(),
+			                                             _requested_ram_quota);
+			_requested_ram_quota = 0;
+
+			/* wake up child that was starved for resources */
+			_child.notify_resource_avail();
+			return true;
+		}
+
+		/**
+		 * Return true if the child may have sessions to 'server'
+		 */
+		bool uses_server(Genode::Server const *server)
+		{
+			Genode::Lock::Guard guard(_used_servers_lock);
+
+			if (_used_servers_exceeded)
+				return true;
+
+			for (unsigned i = 0; i < _num_used_servers; i++)
+				if (_used_servers[i] == server)
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Discard sessions to a server that is about to vanish
+		 */
+		void revoke_server(Genode::Server const *server) {
+			_child.revoke_server(server); }
 
 
 		/****************************
@@ -704,7 +1063,7 @@ class Init::Child : Genode::Child_policy
 
 							service = _child_services->find(service_name, server);
 							if (service)
-								return service;
+								return _used(service);
 
 							if (!service_wildcard) {
 								PWRN("%s: lookup to child service \"%s\" failed", name(), service_name);
@@ -719,7 +1078,7 @@ class Init::Child : Genode::Child_policy
 							}
 							service = _child_services->find(service_name);
 							if (service)
-								return service;
+								return _used(service);
 
 							if (!service_wildcard) {
 								PWRN("%s: lookup for service \"%s\" failed", name(), service_name);
@@ -802,26 +1161,11 @@ class Init::Child : Genode::Child_policy
 				Genode::Arg_string::find_arg(args.string(), "ram_quota")
 					.ulong_value(0);
 
-			if (avail_slack_ram_quota() < requested_ram_quota) {
-				PWRN("Cannot respond to resource request - out of memory");
-				return;
-			}
-
-			/*
-			 * XXX  Synchronize quota transfers from/to env()->ram_session()
-			 *
-			 * If multiple children issue concurrent resource requests, the
-			 * value reported by 'avail_slack_ram_quota' may be out of date
-			 * when calling 'transfer_quota'.
-			 */
-
-			Genode::env()->ram_session()->transfer_quota(_resources.ram.cap(),
-			                                             requested_ram_quota);
-
-			/* wake up child that was starved for resources */
-			_child.notify_resource_avail();
+			_ram_broker->request_ram(*this, requested_ram_quota);
 		}
 
+		void yield_response() override { _ram_broker->ram_yielded(*this); }
+
 		void exit(int exit_value) override
 		{
 			try {
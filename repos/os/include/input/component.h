@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2006-2013 Genode Labs GmbH
+ * Copyright (C) 2006-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -34,6 +34,30 @@ class Input::Session_component : public Genode::Rpc_object<Input::Session>
 
 		Event_queue _event_queue;
 
+		/**
+		 * Merge motion event 'ev' into the preceding event 'prev'
+		 *
+		 * Only consecutive motion events of the same kind are merged. Any
+		 * other event, e.g., a button press, ends the sequence.
+		 *
+		 * \return  true if 'ev' was merged
+		 */
+		static bool _merge_motion(Input::Event &prev, Input::Event const &ev)
+		{
+			if (prev.is_relative_motion() && ev.is_relative_motion()) {
+				prev = Input::Event(Input::Event::MOTION, 0, ev.ax(), ev.ay(),
+				                    prev.rx() + ev.rx(), prev.ry() + ev.ry());
+				return true;
+			}
+
+			if (prev.is_absolute_motion() && ev.is_absolute_motion()) {
+				prev = ev;
+				return true;
+			}
+
+			return false;
+		}
+
 	public:
 
 		/**
@@ -43,11 +67,17 @@ class Input::Session_component : public Genode::Rpc_object<Input::Session>
 
 		/**
 		 * Submit input event to event queue
+		 *
+		 * \param submit_signal_immediately  if false, the client is not
+		 *                                   notified, which allows for
+		 *                                   submitting a batch of events
+		 *                                   followed by a single
+		 *                                   'event_queue().submit_signal()'
 		 */
-		void submit(Input::Event event)
+		void submit(Input::Event event, bool submit_signal_immediately = true)
 		{
 			try {
-				_event_queue.add(event);
+				_event_queue.add(event, submit_signal_immediately);
 			} catch (Input::Event_queue::Overflow) {
 				PWRN("input overflow - resetting queue");
 				_event_queue.reset();
@@ -63,13 +93,37 @@ class Input::Session_component : public Genode::Rpc_object<Input::Session>
 
 		bool is_pending() const override { return !_event_queue.empty(); }
 
+		/*
+		 * Consecutive motion events are coalesced while flushing. So a
+		 * high-rate pointing device results in a single motion event per
+		 * flush instead of one event per device report.
+		 */
 		int flush() override
 		{
 			Input::Event *dst = _ds.local_addr<Input::Event>();
-			
+
 			unsigned cnt = 0;
-			for (; cnt < Event_queue::QUEUE_SIZE && !_event_queue.empty(); cnt++)
-				*dst++ = _event_queue.get();
+			while (cnt < Event_queue::QUEUE_SIZE && !_event_queue.empty()) {
+
+				Input::Event const ev = _event_queue.get();
+
+				if (cnt && _merge_motion(dst[cnt - 1], ev)) {
+
+					/*
+					 * Drop relative motion events that add up to zero.
+					 * Otherwise, such an event would be misinterpreted as
+					 * absolute motion to (0, 0).
+					 */
+					if (dst[cnt - 1].type() == Input::Event::MOTION
+					 && !dst[cnt - 1].rx() && !dst[cnt - 1].ry()
+					 && ev.is_relative_motion())
+						cnt--;
+
+					continue;
+				}
+
+				dst[cnt++] = ev;
+			}
 
 			return cnt;
 		}
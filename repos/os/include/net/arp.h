@@ -8,7 +8,7 @@
  */
 
 /*
- * Copyright (C) 2010-2013 Genode Labs GmbH
+ * Copyright (C) 2010-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -224,6 +224,17 @@ class Net::Arp_packet
 		 ** ARP field write-accessors **
 		 ******************************/
 
+		/**
+		 * Set address types and sizes for IPv4 addresses over ethernet.
+		 */
+		void init_ethernet_ipv4()
+		{
+			_hw_addr_type   = host_to_big_endian((Genode::uint16_t)ETHERNET);
+			_prot_addr_type = host_to_big_endian((Genode::uint16_t)Ethernet_frame::IPV4);
+			_hw_addr_sz     = Ethernet_frame::ADDR_LEN;
+			_prot_addr_sz   = Ipv4_packet::ADDR_LEN;
+		}
+
 		/**
 		 * Set Operation code.
 		 *
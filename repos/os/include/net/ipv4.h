@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2010-2013 Genode Labs GmbH
+ * Copyright (C) 2010-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -158,6 +158,19 @@ class Net::Ipv4_packet
 		void *data() { return &_data; }
 
 
+		/********************************
+		 ** IPv4 field write-accessors **
+		 ********************************/
+
+		void time_to_live(Genode::uint8_t ttl) { _time_to_live = ttl; }
+
+		void checksum(Genode::uint16_t checksum) {
+			_header_checksum = host_to_big_endian(checksum); }
+
+		void dst(Ipv4_address ip) { ip.copy(&_dst_addr); }
+		void src(Ipv4_address ip) { ip.copy(&_src_addr); }
+
+
 		/***************
 		 ** Operators **
 		 ***************/
@@ -120,6 +120,14 @@ class Nic::Session_component : Communication_buffers, public Session_rpc_object
 		 * Return the MAC address of the device
 		 */
 		virtual Mac_address mac_address() = 0;
+
+		/**
+		 * Return the checksum-offload capabilities of the device
+		 *
+		 * By default, the device neither computes nor verifies any
+		 * checksums.
+		 */
+		virtual Offload offload() { return Offload(); }
 };
 
 
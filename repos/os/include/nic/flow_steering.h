@@ -0,0 +1,209 @@
+/*
+ * \brief  Hash-based steering of network flows to queues
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The hash function is the Toeplitz hash used for receive-side scaling
+ * (RSS) by network adaptors. With the default key, drivers of adaptors
+ * with hardware RSS support and software implementations map a flow to the
+ * same queue.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__NIC__FLOW_STEERING_H_
+#define _INCLUDE__NIC__FLOW_STEERING_H_
+
+#include <base/stdint.h>
+#include <util/string.h>
+
+namespace Nic {
+
+	class Flow_hash;
+	template <unsigned> class Flow_steering;
+}
+
+
+/**
+ * Toeplitz hash over the IPv4 addresses and TCP/UDP ports of a frame
+ */
+class Nic::Flow_hash
+{
+	public:
+
+		enum { KEY_LEN = 40 };
+
+	private:
+
+		Genode::uint8_t _key[KEY_LEN];
+
+		enum {
+			ETH_HEADER_LEN = 14,
+			ETH_TYPE_IPV4  = 0x0800,
+			IP_PROTO_TCP   = 6,
+			IP_PROTO_UDP   = 17,
+		};
+
+		static Genode::uint16_t _be16(Genode::uint8_t const *p) {
+			return (p[0] << 8) | p[1]; }
+
+		/**
+		 * Return 32-bit window of the key starting at bit 'bit'
+		 */
+		Genode::uint32_t _key_window(unsigned bit) const
+		{
+			unsigned const byte = bit / 8, shift = bit % 8;
+
+			Genode::uint64_t w = 0;
+			for (unsigned i = 0; i < 5; i++)
+				w = (w << 8) | (byte + i < KEY_LEN ? _key[byte + i] : 0);
+
+			return (Genode::uint32_t)(w >> (8 - shift));
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param key  hash key of 'KEY_LEN' bytes, by default the key
+		 *             recommended by the RSS specification is used
+		 */
+		Flow_hash(Genode::uint8_t const *key = 0)
+		{
+			static Genode::uint8_t const default_key[KEY_LEN] = {
+				0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+				0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+				0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+				0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+				0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa };
+
+			Genode::memcpy(_key, key ? key : default_key, KEY_LEN);
+		}
+
+		/**
+		 * Return Toeplitz hash of 'len' bytes of input
+		 */
+		Genode::uint32_t hash(Genode::uint8_t const *input, unsigned len) const
+		{
+			Genode::uint32_t result = 0;
+
+			for (unsigned i = 0; i < len; i++)
+				for (unsigned b = 0; b < 8; b++)
+					if (input[i] & (0x80 >> b))
+						result ^= _key_window(i*8 + b);
+
+			return result;
+		}
+
+		/**
+		 * Return hash of the flow the Ethernet frame belongs to
+		 *
+		 * For TCP and UDP segments, the hash covers the IPv4 source and
+		 * destination addresses and ports, for other IPv4 packets and
+		 * fragments only the addresses. Non-IPv4 frames yield 0 and
+		 * are thereby steered to the first queue.
+		 */
+		Genode::uint32_t frame(void const *frame, Genode::size_t size) const
+		{
+			Genode::uint8_t const *eth = (Genode::uint8_t const *)frame;
+
+			if (size < ETH_HEADER_LEN + 20 || _be16(eth + 12) != ETH_TYPE_IPV4)
+				return 0;
+
+			Genode::uint8_t const *ip     = eth + ETH_HEADER_LEN;
+			unsigned        const  ip_len = (ip[0] & 0xf)*4;
+			Genode::uint8_t const  proto  = ip[9];
+
+			/* source and destination address, followed by the ports */
+			Genode::uint8_t input[12];
+			Genode::memcpy(input, ip + 12, 8);
+
+			bool const fragment = _be16(ip + 6) & 0x3fff;
+			bool const has_ports = (proto == IP_PROTO_TCP || proto == IP_PROTO_UDP)
+			                    && !fragment
+			                    && size >= ETH_HEADER_LEN + ip_len + 4;
+			if (!has_ports)
+				return hash(input, 8);
+
+			Genode::memcpy(input + 8, ip + ip_len, 4);
+			return hash(input, 12);
+		}
+};
+
+
+/**
+ * Indirection table mapping flow hashes to queue indices
+ *
+ * \param TABLE_SIZE  number of table entries, must be a power of two
+ *
+ * Like the redirection table of RSS-capable adaptors, the table decouples
+ * the hash from the queue assignment. Flows can thereby be rebalanced by
+ * changing individual entries without changing the hash function.
+ */
+template <unsigned TABLE_SIZE = 128>
+class Nic::Flow_steering
+{
+	private:
+
+		static_assert((TABLE_SIZE & (TABLE_SIZE - 1)) == 0,
+		              "table size must be a power of two");
+
+		Flow_hash       _hash;
+		Genode::uint8_t _table[TABLE_SIZE];
+		unsigned        _num_queues;
+
+	public:
+
+		enum { MAX_QUEUES = 256 };
+
+		class Invalid_queue_count { };
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_queues  number of queues to distribute flows to
+		 * \param key         Toeplitz key, see 'Flow_hash'
+		 *
+		 * \throw Invalid_queue_count
+		 */
+		Flow_steering(unsigned num_queues, Genode::uint8_t const *key = 0)
+		: _hash(key), _num_queues(num_queues)
+		{
+			if (!num_queues || num_queues > MAX_QUEUES)
+				throw Invalid_queue_count();
+
+			for (unsigned i = 0; i < TABLE_SIZE; i++)
+				_table[i] = i % num_queues;
+		}
+
+		unsigned num_queues() const { return _num_queues; }
+
+		/**
+		 * Assign table entry 'index' to 'queue'
+		 */
+		void assign(unsigned index, unsigned queue)
+		{
+			if (queue < _num_queues)
+				_table[index % TABLE_SIZE] = queue;
+		}
+
+		/**
+		 * Return queue for flow hash
+		 */
+		unsigned queue(Genode::uint32_t hash) const {
+			return _table[hash & (TABLE_SIZE - 1)]; }
+
+		/**
+		 * Return queue for Ethernet frame
+		 */
+		unsigned queue(void const *frame, Genode::size_t size) const {
+			return queue(_hash.frame(frame, size)); }
+};
+
+#endif /* _INCLUDE__NIC__FLOW_STEERING_H_ */
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2009-2013 Genode Labs GmbH
+ * Copyright (C) 2009-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -24,18 +24,75 @@
 namespace Nic {
 
 	struct Mac_address;
+	class  Packet_descriptor;
+	struct Offload;
 	struct Session;
 
 	using Genode::Packet_stream_sink;
 	using Genode::Packet_stream_source;
-
-	typedef Genode::Packet_descriptor Packet_descriptor;
 }
 
 
 struct Nic::Mac_address { char addr[6]; };
 
 
+/**
+ * Network packet
+ *
+ * Besides the location of the packet within the packet-stream buffer, the
+ * descriptor carries the checksum status of the packet. For a transmitted
+ * packet, the flags name the checksums to be computed by the network
+ * adapter. The client leaves the corresponding checksum fields zero. For a
+ * received packet, the flags name the checksums already verified by the
+ * network adapter. A receiver does not need to check those checksums again.
+ *
+ * Checksum flags must only be set for a transmitted packet if the session
+ * announces the corresponding 'Offload::tx_checksum' capability.
+ */
+class Nic::Packet_descriptor : public Genode::Packet_descriptor
+{
+	public:
+
+		enum Checksum {
+			CSUM_IP = 1 << 0,  /* IPv4 header checksum */
+			CSUM_L4 = 1 << 1,  /* TCP or UDP checksum */
+		};
+
+	private:
+
+		unsigned _checksum :2;
+
+	public:
+
+		/**
+		 * Constructor
+		 */
+		Packet_descriptor(Genode::off_t offset = 0, Genode::size_t size = 0)
+		:
+			Genode::Packet_descriptor(offset, size), _checksum(0)
+		{ }
+
+		/**
+		 * Return bit mask of 'Checksum' flags
+		 */
+		unsigned checksum() const { return _checksum; }
+
+		void checksum(unsigned flags) { _checksum = flags & (CSUM_IP | CSUM_L4); }
+};
+
+
+/**
+ * Checksum-offload capabilities of a network adapter
+ *
+ * Both members are bit masks of 'Packet_descriptor::Checksum' flags.
+ */
+struct Nic::Offload
+{
+	unsigned tx_checksum = 0;  /* checksums computed for transmitted packets */
+	unsigned rx_checksum = 0;  /* checksums verified for received packets */
+};
+
+
 /*
  * NIC session interface
  *
@@ -61,7 +118,7 @@ struct Nic::Session : Genode::Session
 	 * The acknowledgement queue has always the same size as the submit
 	 * queue. We access the packet content as a char pointer.
 	 */
-	typedef Genode::Packet_stream_policy<Genode::Packet_descriptor,
+	typedef Genode::Packet_stream_policy<Nic::Packet_descriptor,
 	                                     QUEUE_SIZE, QUEUE_SIZE, char> Policy;
 
 	typedef Packet_stream_tx::Channel<Policy> Tx;
@@ -106,6 +163,11 @@ struct Nic::Session : Genode::Session
 	 */
 	virtual void link_state_sigh(Genode::Signal_context_capability sigh) = 0;
 
+	/**
+	 * Request checksum-offload capabilities of network adapter
+	 */
+	virtual Offload offload() = 0;
+
 	/*******************
 	 ** RPC interface **
 	 *******************/
@@ -116,9 +178,11 @@ struct Nic::Session : Genode::Session
 	GENODE_RPC(Rpc_link_state, bool, link_state);
 	GENODE_RPC(Rpc_link_state_sigh, void, link_state_sigh,
 	           Genode::Signal_context_capability);
+	GENODE_RPC(Rpc_offload, Offload, offload);
 
 	GENODE_RPC_INTERFACE(Rpc_mac_address, Rpc_link_state,
-	                     Rpc_link_state_sigh, Rpc_tx_cap, Rpc_rx_cap);
+	                     Rpc_link_state_sigh, Rpc_tx_cap, Rpc_rx_cap,
+	                     Rpc_offload);
 };
 
 #endif /* _INCLUDE__NIC_SESSION__NIC_SESSION_H_ */
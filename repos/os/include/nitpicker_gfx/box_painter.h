@@ -15,6 +15,7 @@
 #define _INCLUDE__NITPICKER_GFX__BOX_PAINTER_H_
 
 #include <os/surface.h>
+#include <os/pixel_row.h>
 
 
 struct Box_painter
@@ -47,9 +48,8 @@ struct Box_painter
 					*dst = pix;
 
 		else if (!color.is_transparent())
-			for (int w, h = clipped.h() ; h--; dst_line += surface.size().w())
-				for (dst = dst_line, w = clipped.w(); w--; dst++)
-					*dst = PT::mix(*dst, pix, alpha);
+			for (int h = clipped.h() ; h--; dst_line += surface.size().w())
+				Genode::Pixel_row<PT>::mix(dst_line, pix, alpha, clipped.w());
 
 		surface.flush_pixels(clipped);
 	}
@@ -16,6 +16,7 @@
 
 #include <base/stdint.h>
 #include <os/surface.h>
+#include <os/pixel_row.h>
 
 
 struct Text_painter
@@ -115,14 +116,14 @@ struct Text_painter
 			int const start = Genode::max(0,     surface.clip().x1() - x);
 			int const end   = Genode::min(w - 1, surface.clip().x2() - x);
 
-			PT                  *d = dst + x;
-			unsigned char const *s = src + font.otab[*str];
+			PT                  *d = dst + x + start;
+			unsigned char const *s = src + font.otab[*str] + start;
 
-			for (int j = 0; j < h; j++, s += font.img_w, d += surface.size().w())
-				for (int i = start; i <= end; i++)
-					if (s[i])
-						d[i] = (s[i] == 255 && alpha == 255)
-						     ? pix : PT::mix(d[i], pix, (alpha*s[i]) >> 8);
+			/* the font image holds the coverage of each glyph pixel */
+			if (start <= end)
+				for (int j = 0; j < h; j++, s += font.img_w, d += surface.size().w())
+					Genode::Pixel_row<PT>::paint_masked(d, pix, s, alpha,
+					                                    end - start + 1);
 			x += w;
 		}
 
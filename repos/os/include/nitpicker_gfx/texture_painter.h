@@ -16,6 +16,7 @@
 
 #include <blit/blit.h>
 #include <os/texture.h>
+#include <os/pixel_row.h>
 
 
 struct Texture_painter
@@ -75,9 +76,8 @@ struct Texture_painter
 		PT const mix_pixel(mix_color.r, mix_color.g, mix_color.b);
 
 		int i, j;
-		PT            const *s;
-		PT                  *d;
-		unsigned char const *a;
+		PT const *s;
+		PT       *d;
 
 		switch (mode) {
 
@@ -98,9 +98,7 @@ struct Texture_painter
 			 * Copy texture with alpha blending
 			 */
 			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++)
-					if (*a)
-						*d = PT::mix(*d, *s, *a);
+				Genode::Pixel_row<PT>::mix(dst, src, alpha, clipped.w());
 			break;
 
 		case MIXED:
@@ -113,8 +111,7 @@ struct Texture_painter
 		case MASKED:
 
 			for (j = clipped.h(); j--; src += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, d = dst; i--; s++, d++)
-					if (s->pixel) *d = *s;
+				Genode::Pixel_row<PT>::copy_unmasked(dst, src, clipped.w());
 			break;
 		}
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2005-2013 Genode Labs GmbH
+ * Copyright (C) 2005-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -36,14 +36,25 @@ class Genode::Alarm
 		Time             _deadline;       /* next deadline                */
 		Time             _period;         /* duration between alarms      */
 		int              _active;         /* set to one when active       */
-		Alarm           *_next;           /* next alarm in alarm list     */
 		Alarm_scheduler *_scheduler;      /* currently assigned scheduler */
 
+		/*
+		 * Links within the pairing heap of the scheduler
+		 *
+		 * '_prev' refers to the parent for the leftmost child and to the
+		 * left sibling otherwise.
+		 */
+		Alarm *_child;
+		Alarm *_sibling;
+		Alarm *_prev;
+
 		void _assign(Time period, Time deadline, Alarm_scheduler *scheduler) {
 			_period = period, _deadline = deadline, _scheduler = scheduler; }
 
+		void _unlink() { _child = _sibling = _prev = 0; }
+
 		void _reset() {
-			_assign(0, 0, 0), _active = 0, _next = 0; }
+			_assign(0, 0, 0), _active = 0, _unlink(); }
 
 	protected:
 
@@ -64,28 +75,56 @@ class Genode::Alarm
 };
 
 
+/**
+ * Scheduler of alarms
+ *
+ * The scheduled alarms are kept in a pairing heap ordered by their
+ * deadlines. Scheduling an alarm takes constant time, and removing an
+ * alarm, be it the next pending or an arbitrary one, takes amortized
+ * logarithmic time. So users with many concurrent timeouts, e.g., the
+ * retransmission timers of TCP connections, do not pay for the number
+ * of scheduled alarms.
+ */
 class Genode::Alarm_scheduler
 {
 	private:
 
-		Lock         _lock;   /* protect alarm list                     */
-		Alarm       *_head;   /* head of alarm list                     */
+		Lock         _lock;   /* protect alarm heap                     */
+		Alarm       *_head;   /* alarm with the earliest deadline       */
 		Alarm::Time  _now;    /* recent time (updated by handle method) */
 
 		/**
-		 * Enqueue alarm into alarm queue
+		 * Return true if deadline of 'a' is before the one of 'b'
+		 */
+		bool _earlier(Alarm const *a, Alarm const *b) const {
+			return (int)a->_deadline - (int)_now < (int)b->_deadline - (int)_now; }
+
+		/**
+		 * Meld two heaps
+		 *
+		 * \return  root of the resulting heap
+		 */
+		Alarm *_meld(Alarm *a, Alarm *b);
+
+		/**
+		 * Meld the list of siblings starting at 'first' into one heap
+		 */
+		Alarm *_meld_siblings(Alarm *first);
+
+		/**
+		 * Enqueue alarm into alarm heap
 		 *
 		 * This is a helper for 'schedule' and 'handle'.
 		 */
 		void _unsynchronized_enqueue(Alarm *alarm);
 
 		/**
-		 * Dequeue alarm from alarm queue
+		 * Dequeue alarm from alarm heap
 		 */
 		void _unsynchronized_dequeue(Alarm *alarm);
 
 		/**
-		 * Dequeue next pending alarm from alarm list
+		 * Dequeue next pending alarm from alarm heap
 		 *
 		 * \return  dequeued pending alarm
 		 * \retval  0  no alarm pending
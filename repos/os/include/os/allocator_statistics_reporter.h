@@ -0,0 +1,152 @@
+/*
+ * \brief  Periodic report of allocator statistics
+ * \author Norman Feske
+ * \date   2015-12-02
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__ALLOCATOR_STATISTICS_REPORTER_H_
+#define _INCLUDE__OS__ALLOCATOR_STATISTICS_REPORTER_H_
+
+#include <base/allocator_statistics.h>
+#include <base/snprintf.h>
+#include <os/reporter.h>
+#include <os/server.h>
+#include <os/signal_rpc_dispatcher.h>
+#include <timer_session/connection.h>
+
+namespace Genode { class Allocator_statistics_reporter; }
+
+
+/**
+ * Reporter that publishes the statistics of registered allocators
+ *
+ * The report has the following form:
+ *
+ * ! <allocators>
+ * !   <allocator name="heap" live="..." peak="..." allocs="..." frees="..."
+ * !              consumed="...">
+ * !     <size_class max="64" live="..." peak="..."/>
+ * !     ...
+ * !     <site ip="0x..." count="..." bytes="..."/>
+ * !     ...
+ * !   </allocator>
+ * ! </allocators>
+ *
+ * Size classes and sites without any blocks are omitted.
+ */
+class Genode::Allocator_statistics_reporter
+{
+	private:
+
+		Reporter                   _reporter;
+		List<Allocator_statistics> _allocators;
+		Lock                       _lock;
+
+		Timer::Connection _timer;
+
+		Signal_rpc_member<Allocator_statistics_reporter> _timeout_dispatcher;
+
+		void _handle_timeout(unsigned) { report(); }
+
+		static void _generate(Xml_generator &xml, Allocator_statistics const &stats)
+		{
+			typedef Allocator_statistics::Size_class Size_class;
+			typedef Allocator_statistics::Site       Site;
+
+			stats.with_snapshot([&] (size_t live, size_t peak,
+			                         unsigned long allocs, unsigned long frees,
+			                         Size_class const *classes, Site const *sites) {
+
+				xml.node("allocator", [&] () {
+					xml.attribute("name",     stats.name());
+					xml.attribute("live",     live);
+					xml.attribute("peak",     peak);
+					xml.attribute("allocs",   allocs);
+					xml.attribute("frees",    frees);
+					xml.attribute("consumed", stats.consumed());
+
+					for (unsigned i = 0; i < Allocator_statistics::NUM_SIZE_CLASSES; i++) {
+						if (!classes[i].peak)
+							continue;
+
+						xml.node("size_class", [&] () {
+							xml.attribute("max",  Allocator_statistics::size_class_limit(i));
+							xml.attribute("live", classes[i].live);
+							xml.attribute("peak", classes[i].peak);
+						});
+					}
+
+					for (unsigned i = 0; i < Allocator_statistics::NUM_SITES; i++) {
+						if (!sites[i].count)
+							continue;
+
+						xml.node("site", [&] () {
+							char ip[20];
+							snprintf(ip, sizeof(ip), "0x%lx", sites[i].ip);
+							xml.attribute("ip",    ip);
+							xml.attribute("count", sites[i].count);
+							xml.attribute("bytes", sites[i].bytes);
+						});
+					}
+				});
+			});
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param ep           entrypoint used for handling timeouts
+		 * \param period_ms    report interval, 0 disables periodic reports
+		 * \param buffer_size  size of the report buffer
+		 */
+		Allocator_statistics_reporter(Server::Entrypoint &ep,
+		                              unsigned period_ms,
+		                              size_t buffer_size = 4096)
+		:
+			_reporter("allocators", buffer_size),
+			_timeout_dispatcher(ep, *this, &Allocator_statistics_reporter::_handle_timeout)
+		{
+			_reporter.enabled(true);
+
+			if (period_ms) {
+				_timer.sigh(_timeout_dispatcher);
+				_timer.trigger_periodic(period_ms*1000);
+			}
+		}
+
+		void add(Allocator_statistics &stats)
+		{
+			Lock::Guard guard(_lock);
+			_allocators.insert(&stats);
+		}
+
+		void remove(Allocator_statistics &stats)
+		{
+			Lock::Guard guard(_lock);
+			_allocators.remove(&stats);
+		}
+
+		/**
+		 * Publish statistics of all registered allocators
+		 */
+		void report()
+		{
+			Lock::Guard guard(_lock);
+
+			Reporter::Xml_generator xml(_reporter, [&] () {
+				for (Allocator_statistics *s = _allocators.first(); s; s = s->next())
+					_generate(xml, *s);
+			});
+		}
+};
+
+#endif /* _INCLUDE__OS__ALLOCATOR_STATISTICS_REPORTER_H_ */
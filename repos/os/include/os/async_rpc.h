@@ -0,0 +1,235 @@
+/*
+ * \brief  Utility for issuing RPCs asynchronously
+ * \author Norman Feske
+ * \date   2015-12-11
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__ASYNC_RPC_H_
+#define _INCLUDE__OS__ASYNC_RPC_H_
+
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <base/lock.h>
+#include <base/exception.h>
+#include <util/construct_at.h>
+#include <util/fifo.h>
+#include <util/noncopyable.h>
+
+namespace Genode {
+
+	class Async_rpc_job;
+	template <unsigned, size_t> class Async_rpc_pool;
+	template <typename>         class Async_rpc;
+}
+
+
+/**
+ * Unit of work executed by one of the threads of an 'Async_rpc_pool'
+ */
+class Genode::Async_rpc_job : public Fifo<Async_rpc_job>::Element, Noncopyable
+{
+	private:
+
+		Lock _done { Lock::LOCKED };
+		bool _failed = false;
+
+	protected:
+
+		virtual void _execute() = 0;
+
+		/**
+		 * Block until the job is completed
+		 *
+		 * \return  false if the job was aborted by an exception
+		 */
+		bool _join()
+		{
+			_done.lock();
+			_done.unlock();
+			return !_failed;
+		}
+
+	public:
+
+		virtual ~Async_rpc_job() { }
+
+		/**
+		 * Called by the worker thread
+		 */
+		void execute()
+		{
+			try { _execute(); } catch (...) { _failed = true; }
+			_done.unlock();
+		}
+};
+
+
+/**
+ * Pool of threads that issue RPCs on behalf of a client
+ *
+ * \param THREADS     number of worker threads, which is the number of
+ *                    RPCs in flight at most
+ * \param STACK_SIZE  stack size of each worker thread
+ */
+template <unsigned THREADS, Genode::size_t STACK_SIZE = 4*1024*sizeof(Genode::addr_t)>
+class Genode::Async_rpc_pool : Noncopyable
+{
+	private:
+
+		Lock                _queue_lock;
+		Fifo<Async_rpc_job> _queue;
+		Semaphore           _pending;
+
+		struct Worker : Thread<STACK_SIZE>
+		{
+			Async_rpc_pool &pool;
+
+			Worker(Async_rpc_pool &pool)
+			: Thread<STACK_SIZE>("async_rpc"), pool(pool) { this->start(); }
+
+			void entry() override
+			{
+				for (;;) {
+					pool._pending.down();
+
+					Async_rpc_job *job = nullptr;
+					{
+						Lock::Guard guard(pool._queue_lock);
+						job = pool._queue.dequeue();
+					}
+					if (job)
+						job->execute();
+				}
+			}
+		};
+
+		char _workers[THREADS][sizeof(Worker)]
+			__attribute__((aligned(sizeof(addr_t))));
+
+		Worker &_worker(unsigned i) { return *(Worker *)_workers[i]; }
+
+	public:
+
+		Async_rpc_pool()
+		{
+			for (unsigned i = 0; i < THREADS; i++)
+				construct_at<Worker>(_workers[i], *this);
+		}
+
+		/**
+		 * Destructor
+		 *
+		 * All submitted RPCs must have been joined beforehand.
+		 */
+		~Async_rpc_pool()
+		{
+			for (unsigned i = 0; i < THREADS; i++)
+				_worker(i).~Worker();
+		}
+
+		/**
+		 * Hand over job to the next idle worker
+		 */
+		void submit(Async_rpc_job &job)
+		{
+			{
+				Lock::Guard guard(_queue_lock);
+				_queue.enqueue(&job);
+			}
+			_pending.up();
+		}
+};
+
+
+/**
+ * Asynchronously executed RPC
+ *
+ * \param FN  functor that performs the RPC and returns its result
+ *
+ * The functor is copied and executed by a worker of the pool, which
+ * allows for issuing several independent RPCs to different servers at
+ * once, e.g., during the creation of sessions. On 'join', the caller
+ * blocks until the RPC returned. The destruction of a non-joined object
+ * waits for the RPC as well, so objects referenced by the functor must
+ * outlive the 'Async_rpc' object.
+ *
+ * Exceptions thrown by the RPC are caught by the worker. Because C++
+ * exceptions cannot be passed between threads without runtime support,
+ * 'join' reflects them as 'Failed'. Callers that need to distinguish
+ * exceptions should catch them within the functor.
+ *
+ * ! auto rom_fn = [&] () { return rom.dataspace(); };
+ * ! Async_rpc<decltype(rom_fn)> rom_ds(pool, rom_fn);
+ * ! ...
+ * ! Dataspace_capability ds = rom_ds.join();
+ */
+template <typename FN>
+class Genode::Async_rpc : public Async_rpc_job
+{
+	public:
+
+		typedef decltype((*(FN *)0)()) Result;
+
+		class Failed : public Exception { };
+
+	private:
+
+		/*
+		 * Storage of the result, specialized for RPCs without result
+		 */
+		template <typename T, typename DUMMY = void>
+		struct Slot
+		{
+			T value { };
+
+			void execute(FN &fn) { value = fn(); }
+			T    result()        { return value; }
+		};
+
+		template <typename DUMMY>
+		struct Slot<void, DUMMY>
+		{
+			void execute(FN &fn) { fn(); }
+			void result()        { }
+		};
+
+		FN           _fn;
+		Slot<Result> _slot;
+
+		void _execute() override { _slot.execute(_fn); }
+
+	public:
+
+		/**
+		 * Constructor, submits the RPC to the pool
+		 */
+		template <typename POOL>
+		Async_rpc(POOL &pool, FN const &fn) : _fn(fn) { pool.submit(*this); }
+
+		/**
+		 * Destructor, waits for the completion of a pending RPC
+		 */
+		~Async_rpc() { _join(); }
+
+		/**
+		 * Wait for the completion of the RPC and return its result
+		 *
+		 * \throw Failed  the RPC threw an exception
+		 */
+		Result join()
+		{
+			if (!_join())
+				throw Failed();
+
+			return _slot.result();
+		}
+};
+
+#endif /* _INCLUDE__OS__ASYNC_RPC_H_ */
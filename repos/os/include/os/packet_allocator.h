@@ -16,7 +16,7 @@
 #define _INCLUDE__OS__PACKET_ALLOCATOR__
 
 #include <base/allocator.h>
-#include <util/bit_array.h>
+#include <util/string.h>
 
 namespace Genode { class Packet_allocator; }
 
@@ -25,29 +25,161 @@ namespace Genode { class Packet_allocator; }
  * This allocator is designed to be used as packet allocator for the
  * packet stream interface. It uses a minimal block size, which is the
  * granularity packets will be allocated with. As backend, it uses a
- * simple bit array to manage free, and allocated blocks.
+ * bitmap with one bit per block to manage free, and allocated blocks.
+ *
+ * To keep the allocation cost independent from the fragmentation of large
+ * bulk buffers, the bitmap is searched a machine word at a time. A second,
+ * summary bitmap marks the words of the block bitmap that are completely
+ * allocated so that the search skips over densely used areas without
+ * looking at the individual blocks.
  */
 class Genode::Packet_allocator : public Genode::Range_allocator
 {
 	private:
 
-		Allocator      *_md_alloc;   /* meta-data allocator                 */
-		size_t          _block_size; /* granularity of packet allocations   */
-		void           *_bits;       /* memory chunk containing the bits    */
-		Bit_array_base *_array;      /* bit array managing available blocks */
-		addr_t          _base;       /* allocation base                     */
-		addr_t          _next;       /* next free bit index                 */
+		enum { BITS_PER_WORD = sizeof(addr_t)*8 };
+
+		Allocator *_md_alloc;   /* meta-data allocator                      */
+		size_t     _block_size; /* granularity of packet allocations        */
+		addr_t    *_bits;       /* bit per block, set if block is allocated */
+		addr_t    *_full;       /* bit per word of '_bits', set if full     */
+		size_t     _words;      /* number of words in '_bits'               */
+		size_t     _md_size;    /* size of meta data in bytes               */
+		addr_t     _base;       /* allocation base                          */
+		addr_t     _next;       /* next free bit index                      */
 
 		/*
 		 * Returns the count of blocks fitting the given size
 		 *
 		 * The block count returned is aligned to the bit count
-		 * of a machine word to fit the needs of the used bit array.
+		 * of a machine word to fit the needs of the used bitmap.
 		 */
 		inline size_t _block_cnt(size_t bytes)
 		{
 			bytes /= _block_size;
-			return bytes - (bytes % (sizeof(addr_t)*8));
+			return bytes - (bytes % BITS_PER_WORD);
+		}
+
+		/**
+		 * Return number of blocks needed for a packet of 'size' bytes
+		 */
+		size_t _blocks(size_t size) const
+		{
+			size_t const cnt = (size % _block_size) ? size / _block_size + 1
+			                                        : size / _block_size;
+			return cnt ? cnt : 1;
+		}
+
+		static size_t _summary_words(size_t words) {
+			return (words + BITS_PER_WORD - 1) / BITS_PER_WORD; }
+
+		static addr_t _bit(size_t i) { return 1UL << (i % BITS_PER_WORD); }
+
+		bool _word_full(size_t w) const {
+			return _full[w / BITS_PER_WORD] & _bit(w); }
+
+		/**
+		 * Mark blocks [index, index + cnt) as allocated or free
+		 */
+		void _mark(size_t index, size_t cnt, bool allocated)
+		{
+			while (cnt) {
+				size_t const w     = index / BITS_PER_WORD;
+				size_t const shift = index % BITS_PER_WORD;
+				size_t const width = (cnt < BITS_PER_WORD - shift)
+				                   ? cnt : BITS_PER_WORD - shift;
+				addr_t const mask  = (width == BITS_PER_WORD)
+				                   ? ~0UL : ((1UL << width) - 1) << shift;
+
+				if (allocated) _bits[w] |=  mask;
+				else           _bits[w] &= ~mask;
+
+				if (_bits[w] == ~0UL) _full[w / BITS_PER_WORD] |=  _bit(w);
+				else                  _full[w / BITS_PER_WORD] &= ~_bit(w);
+
+				index += width;
+				cnt   -= width;
+			}
+		}
+
+		/**
+		 * Return mask of bit positions that start a run of 'cnt' free bits
+		 * within the word of free bits 'free'
+		 */
+		static addr_t _run_starts(addr_t free, size_t cnt)
+		{
+			/* double the tested run length with each step */
+			for (size_t len = 1; free && len < cnt; ) {
+				size_t const step = (len < cnt - len) ? len : cnt - len;
+				free &= free >> step;
+				len  += step;
+			}
+			return free;
+		}
+
+		/**
+		 * Return length of the run of free blocks starting at block 'index'
+		 *
+		 * The scan stops as soon as 'cnt' free blocks are found.
+		 */
+		size_t _free_run(size_t index, size_t cnt) const
+		{
+			size_t len = 0;
+			for (size_t w = index / BITS_PER_WORD; w < _words && len < cnt; w++) {
+
+				addr_t used = _bits[w] >> (index % BITS_PER_WORD);
+				size_t const avail = BITS_PER_WORD - index % BITS_PER_WORD;
+
+				if (used) return len + __builtin_ctzl(used);
+
+				len   += avail;
+				index += avail;
+			}
+			return len;
+		}
+
+		/**
+		 * Find run of 'cnt' free blocks starting within the words
+		 * ['first', 'end')
+		 *
+		 * \return true if a run was found, its first block is returned in
+		 *         'out_index'
+		 */
+		bool _find(size_t cnt, size_t first, size_t end, size_t &out_index) const
+		{
+			for (size_t w = first; w < end; w++) {
+
+				/* skip fully allocated words, whole summary words at once */
+				if (w % BITS_PER_WORD == 0 && _full[w / BITS_PER_WORD] == ~0UL) {
+					w += BITS_PER_WORD - 1;
+					continue;
+				}
+				if (_word_full(w))
+					continue;
+
+				addr_t const used = _bits[w];
+
+				/* run located entirely within the word */
+				if (cnt <= BITS_PER_WORD) {
+					addr_t const starts = _run_starts(~used, cnt);
+					if (starts) {
+						out_index = w*BITS_PER_WORD + __builtin_ctzl(starts);
+						return true;
+					}
+				}
+
+				/* run starting at the free upper end of the word */
+				size_t const top = used ? __builtin_clzl(used) : BITS_PER_WORD;
+				if (!top || w + 1 == _words)
+					continue;
+
+				size_t const index = (w + 1)*BITS_PER_WORD - top;
+				if (_free_run(index, cnt) >= cnt) {
+					out_index = index;
+					return true;
+				}
+			}
+			return false;
 		}
 
 	public:
@@ -59,8 +191,23 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 		 * \param block_size     Granularity of packets in stream
 		 */
 		Packet_allocator(Allocator *md_alloc, size_t block_size)
-		: _md_alloc(md_alloc), _block_size(block_size), _bits(0),
-		  _array(nullptr), _base(0) {}
+		: _md_alloc(md_alloc), _block_size(block_size), _bits(nullptr),
+		  _full(nullptr), _words(0), _md_size(0), _base(0), _next(0) {}
+
+		/**
+		 * Allocate several packets of the same size at once
+		 *
+		 * \param size      size of each packet in bytes
+		 * \param out_addr  array of at least 'num' elements for the
+		 *                  allocated packet addresses
+		 * \return          number of allocated packets
+		 */
+		unsigned alloc_n(size_t size, void **out_addr, unsigned num)
+		{
+			unsigned i = 0;
+			for (; i < num && alloc(size, &out_addr[i]); i++);
+			return i;
+		}
 
 
 		/*******************************
@@ -69,13 +216,19 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 
 		int add_range(addr_t base, size_t size) override
 		{
-			if (_base || _array) return -1;
+			if (_base || _bits) return -1;
+
+			size_t const blocks = _block_cnt(size);
+			if (!blocks) return -1;
+
+			_words   = blocks / BITS_PER_WORD;
+			_md_size = (_words + _summary_words(_words))*sizeof(addr_t);
 
-			_base  = base;
-			_bits  = _md_alloc->alloc(_block_cnt(size)/8);
-			_array = new (_md_alloc) Bit_array_base(_block_cnt(size),
-			                                        (addr_t*)_bits,
-			                                        true);
+			_base = base;
+			_bits = (addr_t *)_md_alloc->alloc(_md_size);
+			_full = _bits + _words;
+			_next = 0;
+			memset(_bits, 0, _md_size);
 			return 0;
 		}
 
@@ -83,8 +236,11 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 		{
 			if (_base != base) return -1;
 
-			if (_array) destroy(_md_alloc, _array);
-			if (_bits)  _md_alloc->free(_bits, _block_cnt(size)/8);
+			if (_bits) _md_alloc->free(_bits, _md_size);
+
+			_bits  = _full = nullptr;
+			_words = 0;
+			_base  = 0;
 			return 0;
 		}
 
@@ -97,40 +253,31 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 
 		bool alloc(size_t size, void **out_addr) override
 		{
-			addr_t const cnt = (size % _block_size) ? size / _block_size + 1
-			                                        : size / _block_size;
-			addr_t max = ~0UL;
-
-			do {
-				try {
-					/* throws exception if array is accessed outside bounds */
-					for (addr_t i = _next & ~(cnt - 1); i < max; i += cnt) {
-						if (_array->get(i, cnt))
-							continue;
-
-						_array->set(i, cnt);
-						_next = i + cnt;
-						*out_addr = reinterpret_cast<void *>(i * _block_size
-						                                     + _base);
-						return true;
-					}
-				} catch (typename Bit_array_base::Invalid_index_access) { }
+			if (!_bits) return false;
 
-				max = _next;
-				_next = 0;
+			size_t const cnt   = _blocks(size);
+			size_t const first = (_next / BITS_PER_WORD) % _words;
 
-			} while (max != 0);
+			size_t index = 0;
+			if (!_find(cnt, first, _words, index) && !_find(cnt, 0, first, index))
+				return false;
 
-			return false;
+			_mark(index, cnt, true);
+			_next = index + cnt;
+			*out_addr = reinterpret_cast<void *>(index * _block_size + _base);
+			return true;
 		}
 
 		void free(void *addr, size_t size) override
 		{
-			addr_t i   = (((addr_t)addr) - _base) / _block_size;
-			size_t cnt = (size % _block_size) ? size / _block_size + 1
-			                                  : size / _block_size;
-			try { _array->clear(i, cnt); } catch(...) { }
-			_next = i;
+			size_t const index = (((addr_t)addr) - _base) / _block_size;
+			size_t const cnt   = _blocks(size);
+
+			if (!_bits || index + cnt > _words*BITS_PER_WORD)
+				return;
+
+			_mark(index, cnt, false);
+			_next = index;
 		}
 
 
@@ -61,6 +61,18 @@
  * acknowledge buffers using the methods 'packet_avail',
  * 'ready_to_submit', 'ready_to_ack', and 'ack_avail'.
  *
+ * Signals are not sent for each of these transitions. Instead, each party
+ * requests a signal only if it actually observed the condition it is going
+ * to wait for. Similar to the event-index mechanism of virtio, the request is
+ * expressed as a queue index stored in the shared communication buffer. For
+ * example, a sink that is busy processing packets does not get woken up by
+ * new packets until it finds the submit queue empty.
+ *
+ * For streams with high packet rates, the batch variants 'submit_packets',
+ * 'get_packets', 'acknowledge_packets', and 'get_acked_packets' process
+ * several packets with a single queue-lock acquisition and deliver at most
+ * one signal to the other side per batch.
+ *
  * If bidirectional data exchange between two processes is desired, two pairs
  * of 'Packet_stream_source' and 'Packet_stream_sink' should be instantiated.
  */
@@ -81,12 +93,17 @@
 #include <dataspace/client.h>
 #include <util/string.h>
 #include <util/construct_at.h>
+#include <cpu/memory_barrier.h>
+#include <cpu/atomic.h>
 
 namespace Genode {
 
 	class Packet_descriptor;
 
+	struct Packet_queue_event_index;
+	struct Packet_queue_stats;
 	template <typename, int> class Packet_descriptor_queue;
+	template <typename, int> class Lock_free_packet_descriptor_queue;
 	template <typename>      class Packet_descriptor_transmitter;
 	template <typename>      class Packet_descriptor_receiver;
 
@@ -95,6 +112,9 @@ namespace Genode {
 	template <typename, unsigned, unsigned, typename>
 	struct Packet_stream_policy;
 
+	template <typename, unsigned, unsigned, typename>
+	struct Lock_free_packet_stream_policy;
+
 	/**
 	 * Default configuration for packet-descriptor queues
 	 */
@@ -148,6 +168,50 @@ class Genode::Packet_descriptor
 };
 
 
+/**
+ * Utilities for the notification protocol between producer and consumer
+ *
+ * Each side of a packet-descriptor queue stores the queue index at which it
+ * wants to be notified by the other side. The consumer requests a
+ * notification for the slot it found empty, the producer requests a
+ * notification for the slot that keeps the queue full.
+ *
+ * This class is private to the packet-stream interface.
+ */
+struct Genode::Packet_queue_event_index
+{
+	/**
+	 * Order preceding stores before subsequent loads
+	 *
+	 * The request of a notification and the check for the awaited condition
+	 * must not be reordered. Otherwise, both sides could miss each other's
+	 * update and the notification would get lost. The 'cmpxchg' function
+	 * acts as full memory barrier on all supported architectures.
+	 */
+	static void full_barrier()
+	{
+		int volatile dummy = 0;
+		Genode::cmpxchg(&dummy, 0, 0);
+	}
+
+	/**
+	 * Return true if 'event' lies within the index range ['from', 'to')
+	 *
+	 * An 'event' value of 'queue_size' or higher denotes that no
+	 * notification is requested.
+	 */
+	static bool in_range(unsigned event, unsigned from, unsigned to,
+	                     unsigned queue_size)
+	{
+		if (event >= queue_size)
+			return false;
+
+		return (event + queue_size - from)%queue_size
+		     < (to    + queue_size - from)%queue_size;
+	}
+};
+
+
 /**
  * Ring buffer shared between source and sink, containing packet descriptors
  *
@@ -158,14 +222,28 @@ class Genode::Packet_descriptor_queue
 {
 	private:
 
-		unsigned          _head;
-		unsigned          _tail;
+		unsigned volatile _head;
+		unsigned volatile _tail;
+
+		/* index for which the consumer requests a notification */
+		unsigned volatile _avail_event;
+
+		/* index for which the producer requests a notification */
+		unsigned volatile _space_event;
+
 		PACKET_DESCRIPTOR _queue[QUEUE_SIZE];
 
+		typedef Packet_queue_event_index Event_index;
+
 	public:
 
 		typedef PACKET_DESCRIPTOR Packet_descriptor;
 
+		/**
+		 * Lock used by the transmitter and receiver to serialize queue access
+		 */
+		typedef Genode::Lock Lock;
+
 		enum Role { PRODUCER, CONSUMER };
 
 		/**
@@ -179,10 +257,13 @@ class Genode::Packet_descriptor_queue
 		Packet_descriptor_queue(Role role)
 		{
 			if (role == PRODUCER) {
-				_head = 0;
+				_head        = 0;
+				_space_event = QUEUE_SIZE;
 				Genode::memset(_queue, 0, sizeof(_queue));
-			} else
-				_tail = 0;
+			} else {
+				_tail        = 0;
+				_avail_event = 0;
+			}
 		}
 
 		/**
@@ -197,6 +278,11 @@ class Genode::Packet_descriptor_queue
 
 			_queue[_head%QUEUE_SIZE] = packet;
 			_head = (_head + 1)%QUEUE_SIZE;
+
+			/* request wakeup once the consumer frees the first slot */
+			if (full())
+				_space_event = _tail;
+
 			return true;
 		}
 
@@ -247,6 +333,258 @@ class Genode::Packet_descriptor_queue
 		unsigned slots_free() {
 			return ((_tail > _head) ? _tail - _head
 			                        : QUEUE_SIZE - _head + _tail) - 1; }
+
+		/**
+		 * Return index of the next slot to be filled by the producer
+		 */
+		unsigned head() const { return _head; }
+
+		/**
+		 * Return index of the next slot to be consumed by the consumer
+		 */
+		unsigned tail() const { return _tail; }
+
+		/**
+		 * Request notification for the next packet added to the queue
+		 *
+		 * Called by the consumer before evaluating 'empty()'.
+		 */
+		void request_avail_notification()
+		{
+			_avail_event = _tail;
+			Event_index::full_barrier();
+		}
+
+		/**
+		 * Request notification for the next slot freed in the queue
+		 *
+		 * Called by the producer before evaluating 'full()'.
+		 */
+		void request_space_notification()
+		{
+			_space_event = _tail;
+			Event_index::full_barrier();
+		}
+
+		/**
+		 * Return true if the consumer waits for one of the slots filled
+		 * since the producer's head was at index 'from'
+		 */
+		bool avail_notification_requested(unsigned from)
+		{
+			Event_index::full_barrier();
+			return Event_index::in_range(_avail_event, from, _head, QUEUE_SIZE);
+		}
+
+		/**
+		 * Return true if the producer waits for one of the slots freed
+		 * since the consumer's tail was at index 'from'
+		 */
+		bool space_notification_requested(unsigned from)
+		{
+			Event_index::full_barrier();
+			return Event_index::in_range(_space_event, from, _tail, QUEUE_SIZE);
+		}
+};
+
+
+/**
+ * Single-producer/single-consumer ring buffer of packet descriptors
+ *
+ * In contrast to 'Packet_descriptor_queue', the queue indices are accessed
+ * with acquire/release semantics such that the transmitter and receiver do
+ * not need to take a lock for each queue operation. Head and tail are placed
+ * in distinct cache lines so that the producer and consumer, when running on
+ * different CPUs, do not contend for the same cache line.
+ *
+ * The queue must be used by exactly one thread at the producer side and one
+ * thread at the consumer side.
+ *
+ * This class is private to the packet-stream interface.
+ */
+template <typename PACKET_DESCRIPTOR, int QUEUE_SIZE>
+class Genode::Lock_free_packet_descriptor_queue
+{
+	public:
+
+		/**
+		 * Lock that does not lock
+		 *
+		 * Access to the queue is synchronized by the ordering of the index
+		 * updates only.
+		 */
+		struct Lock
+		{
+			struct Guard { Guard(Lock &) { } };
+		};
+
+	private:
+
+		enum { CACHE_LINE_SIZE = 64 };
+
+		/* written by the producer only */
+		unsigned volatile _head;
+		unsigned volatile _space_event;
+		char              _head_padding[CACHE_LINE_SIZE - 2*sizeof(unsigned)];
+
+		/* written by the consumer only */
+		unsigned volatile _tail;
+		unsigned volatile _avail_event;
+		char              _tail_padding[CACHE_LINE_SIZE - 2*sizeof(unsigned)];
+
+		PACKET_DESCRIPTOR _queue[QUEUE_SIZE];
+
+		typedef Packet_queue_event_index Event_index;
+
+		static unsigned _next(unsigned index) { return (index + 1)%QUEUE_SIZE; }
+
+	public:
+
+		typedef PACKET_DESCRIPTOR Packet_descriptor;
+
+		enum Role { PRODUCER, CONSUMER };
+
+		/**
+		 * Constructor
+		 *
+		 * \param role  role of the local instance, see
+		 *              'Packet_descriptor_queue'
+		 */
+		Lock_free_packet_descriptor_queue(Role role)
+		{
+			if (role == PRODUCER) {
+				Genode::memset(_queue, 0, sizeof(_queue));
+				_space_event = QUEUE_SIZE;
+				Genode::memory_barrier();
+				_head = 0;
+			} else {
+				_tail        = 0;
+				_avail_event = 0;
+			}
+		}
+
+		/**
+		 * Place packet descriptor into queue
+		 *
+		 * Must be called by the producer only.
+		 *
+		 * \return true on success, or
+		 *         false if queue is full
+		 */
+		bool add(PACKET_DESCRIPTOR packet)
+		{
+			unsigned const head = _head;
+
+			if (_next(head) == _tail) return false;
+
+			_queue[head] = packet;
+
+			/* publish the descriptor before the new head becomes visible */
+			Genode::memory_barrier();
+
+			_head = _next(head);
+
+			/* request wakeup once the consumer frees the first slot */
+			if (full())
+				_space_event = _tail;
+
+			return true;
+		}
+
+		/**
+		 * Take packet descriptor from queue
+		 *
+		 * Must be called by the consumer only and only if the queue is not
+		 * empty.
+		 *
+		 * \return  packet descriptor
+		 */
+		PACKET_DESCRIPTOR get()
+		{
+			unsigned const tail = _tail;
+
+			/* read the descriptor not before observing the producer's head */
+			Genode::memory_barrier();
+
+			PACKET_DESCRIPTOR packet = _queue[tail];
+
+			/* finish reading the slot before handing it back to the producer */
+			Genode::memory_barrier();
+
+			_tail = _next(tail);
+			return packet;
+		}
+
+		/**
+		 * Return current packet descriptor
+		 */
+		PACKET_DESCRIPTOR peek() const
+		{
+			unsigned const tail = _tail;
+			Genode::memory_barrier();
+			return _queue[tail];
+		}
+
+		bool empty() { return _tail == _head; }
+
+		bool full() { return _next(_head) == _tail; }
+
+		bool single_element() { return _next(_tail) == _head; }
+
+		bool single_slot_free() { return (_head + 2)%QUEUE_SIZE == _tail; }
+
+		unsigned slots_free()
+		{
+			unsigned const head = _head, tail = _tail;
+			return ((tail > head) ? tail - head : QUEUE_SIZE - head + tail) - 1;
+		}
+
+		unsigned head() const { return _head; }
+
+		unsigned tail() const { return _tail; }
+
+		void request_avail_notification()
+		{
+			_avail_event = _tail;
+			Event_index::full_barrier();
+		}
+
+		void request_space_notification()
+		{
+			_space_event = _tail;
+			Event_index::full_barrier();
+		}
+
+		bool avail_notification_requested(unsigned from)
+		{
+			Event_index::full_barrier();
+			return Event_index::in_range(_avail_event, from, _head, QUEUE_SIZE);
+		}
+
+		bool space_notification_requested(unsigned from)
+		{
+			Event_index::full_barrier();
+			return Event_index::in_range(_space_event, from, _tail, QUEUE_SIZE);
+		}
+};
+
+
+/**
+ * Counters of the traffic through one packet-descriptor queue
+ *
+ * The counters are kept by each side of a queue separately and reflect
+ * the view of the respective side. They are meant for diagnosing stalled
+ * pipelines. Incrementing them is negligible compared to the queue
+ * operations and the signalling.
+ */
+struct Genode::Packet_queue_stats
+{
+	unsigned long    packets          = 0; /* transmitted or received descriptors */
+	Genode::uint64_t bytes            = 0; /* bulk-buffer space of these packets */
+	unsigned long    stalls           = 0; /* blocking on a full or empty queue */
+	unsigned long    signals_sent     = 0;
+	unsigned long    signals_received = 0;
+	unsigned         slots_free       = 0; /* queue slots free at time of query */
 };
 
 
@@ -268,8 +606,16 @@ class Genode::Packet_descriptor_transmitter
 		/* facility to send ready-to-receive signals */
 		Genode::Signal_transmitter         _rx_ready;
 
-		Genode::Lock _tx_queue_lock;
-		TX_QUEUE    *_tx_queue;
+		typename TX_QUEUE::Lock  _tx_queue_lock;
+		TX_QUEUE                *_tx_queue;
+
+		Packet_queue_stats _stats;
+
+		void _submit_rx_ready()
+		{
+			_rx_ready.submit();
+			_stats.signals_sent++;
+		}
 
 	public:
 
@@ -302,40 +648,86 @@ class Genode::Packet_descriptor_transmitter
 			 * a signal has to be send again
 			 */
 			if (!_tx_queue->empty())
-				_rx_ready.submit();
+				_submit_rx_ready();
 		}
 
 		bool ready_for_tx()
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			typename TX_QUEUE::Lock::Guard lock_guard(_tx_queue_lock);
+
+			if (!_tx_queue->full())
+				return true;
+
+			/* the caller will wait for the ready-to-transmit signal */
+			_tx_queue->request_space_notification();
 			return !_tx_queue->full();
 		}
 
-		void tx(typename TX_QUEUE::Packet_descriptor packet)
+		/**
+		 * Transmit batch of packet descriptors
+		 *
+		 * The queue lock is taken only once for the whole batch and the
+		 * receiver gets notified at most once, after the last descriptor
+		 * was added, and only if it asked for it. Only if the queue runs
+		 * full in the middle of the batch, a pending notification is
+		 * delivered before blocking.
+		 */
+		void tx(typename TX_QUEUE::Packet_descriptor const *packets, unsigned num)
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			typename TX_QUEUE::Lock::Guard lock_guard(_tx_queue_lock);
+
+			/* first queue slot not yet announced to the receiver */
+			unsigned from = _tx_queue->head();
+
+			for (unsigned i = 0; i < num; i++) {
+
+				do {
+					/* block for signal if tx queue is full */
+					if (_tx_queue->full()) {
 
-			do {
-				/* block for signal if tx queue is full */
-				if (_tx_queue->full())
-					_tx_ready.wait_for_signal();
+						/* wake up receiver to make room in the queue */
+						if (_tx_queue->avail_notification_requested(from))
+							_submit_rx_ready();
+						from = _tx_queue->head();
 
-				/*
-				 * It could happen that pending signals do not refer to the
-				 * current queue situation. Therefore, we need to double check
-				 * if the queue insertion succeeds and retry if needed.
-				 */
+						_tx_queue->request_space_notification();
+						if (_tx_queue->full()) {
+							_stats.stalls++;
+							_tx_ready.wait_for_signal();
+							_stats.signals_received++;
+						}
+					}
 
-			} while (_tx_queue->add(packet) == false);
+					/*
+					 * It could happen that pending signals do not refer to the
+					 * current queue situation. Therefore, we need to double
+					 * check if the queue insertion succeeds and retry if
+					 * needed.
+					 */
 
-			if (_tx_queue->single_element())
-				_rx_ready.submit();
+				} while (_tx_queue->add(packets[i]) == false);
+
+				_stats.packets++;
+				_stats.bytes += packets[i].size();
+			}
+
+			if (_tx_queue->avail_notification_requested(from))
+				_submit_rx_ready();
 		}
 
+		void tx(typename TX_QUEUE::Packet_descriptor packet) { tx(&packet, 1); }
+
 		/**
 		 * Return number of slots left to be put into the tx queue
 		 */
 		unsigned tx_slots_free() { return _tx_queue->slots_free(); }
+
+		Packet_queue_stats stats()
+		{
+			Packet_queue_stats stats = _stats;
+			stats.slots_free = _tx_queue->slots_free();
+			return stats;
+		}
 };
 
 
@@ -357,8 +749,16 @@ class Genode::Packet_descriptor_receiver
 		/* facility to send ready-to-transmit signals */
 		Genode::Signal_transmitter        _tx_ready;
 
-		Genode::Lock mutable  _rx_queue_lock;
-		RX_QUEUE             *_rx_queue;
+		typename RX_QUEUE::Lock mutable  _rx_queue_lock;
+		RX_QUEUE                        *_rx_queue;
+
+		Packet_queue_stats _stats;
+
+		void _submit_tx_ready()
+		{
+			_tx_ready.submit();
+			_stats.signals_sent++;
+		}
 
 	public:
 
@@ -391,33 +791,77 @@ class Genode::Packet_descriptor_receiver
 			 * a signal has to be send again
 			 */
 			if (!_rx_queue->empty())
-				_tx_ready.submit();
+				_submit_tx_ready();
 		}
 
 		bool ready_for_rx()
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			typename RX_QUEUE::Lock::Guard lock_guard(_rx_queue_lock);
+
+			if (!_rx_queue->empty())
+				return true;
+
+			/* the caller will wait for the ready-to-receive signal */
+			_rx_queue->request_avail_notification();
 			return !_rx_queue->empty();
 		}
 
-		void rx(typename RX_QUEUE::Packet_descriptor *out_packet)
+		/**
+		 * Receive batch of packet descriptors
+		 *
+		 * The method blocks until at least one descriptor is available and
+		 * then dequeues up to 'max' descriptors without blocking. The
+		 * transmitter gets notified at most once per batch.
+		 *
+		 * \return  number of descriptors stored at 'out_packets'
+		 */
+		unsigned rx(typename RX_QUEUE::Packet_descriptor *out_packets, unsigned max)
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			typename RX_QUEUE::Lock::Guard lock_guard(_rx_queue_lock);
+
+			if (max == 0)
+				return 0;
+
+			while (_rx_queue->empty()) {
+				_rx_queue->request_avail_notification();
+				if (_rx_queue->empty()) {
+					_stats.stalls++;
+					_rx_ready.wait_for_signal();
+					_stats.signals_received++;
+				}
+			}
 
-			while (_rx_queue->empty())
-				_rx_ready.wait_for_signal();
+			unsigned const from = _rx_queue->tail();
+			unsigned       num  = 0;
 
-			*out_packet = _rx_queue->get();
+			for (; num < max && !_rx_queue->empty(); num++) {
+				out_packets[num] = _rx_queue->get();
 
-			if (_rx_queue->single_slot_free())
-				_tx_ready.submit();
+				_stats.packets++;
+				_stats.bytes += out_packets[num].size();
+			}
+
+			if (_rx_queue->space_notification_requested(from))
+				_submit_tx_ready();
+
+			return num;
 		}
 
+		void rx(typename RX_QUEUE::Packet_descriptor *out_packet) {
+			rx(out_packet, 1); }
+
 		typename RX_QUEUE::Packet_descriptor rx_peek() const
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			typename RX_QUEUE::Lock::Guard lock_guard(_rx_queue_lock);
 			return _rx_queue->peek();
 		}
+
+		Packet_queue_stats stats()
+		{
+			Packet_queue_stats stats = _stats;
+			stats.slots_free = _rx_queue->slots_free();
+			return stats;
+		}
 };
 
 
@@ -527,6 +971,30 @@ struct Genode::Packet_stream_policy
 };
 
 
+/**
+ * Policy using lock-free single-producer/single-consumer queues
+ *
+ * This policy is suited for streams where the source and the sink are each
+ * driven by a single thread, e.g., the entrypoint of a server and the main
+ * thread of its client. Both parties of a stream must agree on the policy.
+ */
+template <typename PACKET_DESCRIPTOR,
+          unsigned SUBMIT_QUEUE_SIZE,
+          unsigned ACK_QUEUE_SIZE,
+          typename CONTENT_TYPE>
+struct Genode::Lock_free_packet_stream_policy
+:
+	Packet_stream_policy<PACKET_DESCRIPTOR, SUBMIT_QUEUE_SIZE,
+	                     ACK_QUEUE_SIZE, CONTENT_TYPE>
+{
+	typedef Lock_free_packet_descriptor_queue<PACKET_DESCRIPTOR, SUBMIT_QUEUE_SIZE>
+	        Submit_queue;
+
+	typedef Lock_free_packet_descriptor_queue<PACKET_DESCRIPTOR, ACK_QUEUE_SIZE>
+	        Ack_queue;
+};
+
+
 /**
  * Originator of a packet stream
  */
@@ -548,6 +1016,8 @@ class Genode::Packet_stream_source : private Packet_stream_base
 		Packet_descriptor_transmitter<Submit_queue> _submit_transmitter;
 		Packet_descriptor_receiver<Ack_queue>       _ack_receiver;
 
+		unsigned long _alloc_failures = 0;
+
 	public:
 
 		/**
@@ -555,6 +1025,17 @@ class Genode::Packet_stream_source : private Packet_stream_base
 		 */
 		class Packet_alloc_failed { };
 
+		/**
+		 * Counters of the source side of the stream
+		 */
+		struct Stats
+		{
+			Packet_queue_stats submit; /* submitted packets */
+			Packet_queue_stats ack;    /* received acknowledgements */
+
+			unsigned long alloc_failures;
+		};
+
 		/**
 		 * Constructor
 		 *
@@ -645,8 +1126,10 @@ class Genode::Packet_stream_source : private Packet_stream_base
 		Packet_descriptor alloc_packet(Genode::size_t size, int align = POLICY::Packet_descriptor::PACKET_ALIGNMENT)
 		{
 			void *base = 0;
-			if (_packet_alloc->alloc_aligned(size, &base, align).is_error())
+			if (_packet_alloc->alloc_aligned(size, &base, align).is_error()) {
+				_alloc_failures++;
 				throw Packet_alloc_failed();
+			}
 
 			return Packet_descriptor((Genode::off_t)base, size);
 		}
@@ -672,6 +1155,12 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.ready_for_tx();
 		}
 
+		/**
+		 * Return number of slots left in the submit queue
+		 */
+		unsigned submit_slots_free() {
+			return _submit_transmitter.tx_slots_free(); }
+
 		/**
 		 * Tell sink about a packet to process
 		 */
@@ -680,6 +1169,17 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			_submit_transmitter.tx(packet);
 		}
 
+		/**
+		 * Tell sink about a batch of packets to process
+		 *
+		 * In contrast to calling 'submit_packet' for each packet, the sink
+		 * is notified at most once for the whole batch.
+		 */
+		void submit_packets(Packet_descriptor const *packets, unsigned num)
+		{
+			_submit_transmitter.tx(packets, num);
+		}
+
 		/**
 		 * Returns true if one or more packet acknowledgements are available
 		 */
@@ -695,6 +1195,20 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get batch of acknowledged packets
+		 *
+		 * This method blocks until at least one acknowledgement is
+		 * available.
+		 *
+		 * \param packets  destination array of at least 'max' elements
+		 * \return         number of packets stored in 'packets'
+		 */
+		unsigned get_acked_packets(Packet_descriptor *packets, unsigned max)
+		{
+			return _ack_receiver.rx(packets, max);
+		}
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -703,6 +1217,13 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			_packet_alloc->free((void *)packet.offset(), packet.size());
 		}
 
+		Stats stats()
+		{
+			Stats const stats = { _submit_transmitter.stats(),
+			                      _ack_receiver.stats(), _alloc_failures };
+			return stats;
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
@@ -731,6 +1252,15 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 
 	public:
 
+		/**
+		 * Counters of the sink side of the stream
+		 */
+		struct Stats
+		{
+			Packet_queue_stats submit; /* received packets */
+			Packet_queue_stats ack;    /* sent acknowledgements */
+		};
+
 		/**
 		 * Constructor
 		 *
@@ -812,6 +1342,30 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get batch of packets from source
+		 *
+		 * This method blocks until at least one valid packet is available.
+		 * Packets that do not refer to the bulk buffer are dropped the same
+		 * way as done by 'get_packet'.
+		 *
+		 * \param packets  destination array of at least 'max' elements
+		 * \return         number of packets stored in 'packets'
+		 */
+		unsigned get_packets(Packet_descriptor *packets, unsigned max)
+		{
+			unsigned num = 0;
+			while (num == 0 && max > 0) {
+
+				unsigned const received = _submit_receiver.rx(packets, max);
+
+				for (unsigned i = 0; i < received; i++)
+					if (packet_valid(packets[i]))
+						packets[num++] = packets[i];
+			}
+			return num;
+		}
+
 		/**
 		 * Return but do not dequeue next packet
 		 *
@@ -856,6 +1410,20 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			_ack_transmitter.tx(packet);
 		}
 
+		/**
+		 * Acknowledge a batch of packets with at most one signal to the source
+		 */
+		void acknowledge_packets(Packet_descriptor const *packets, unsigned num)
+		{
+			_ack_transmitter.tx(packets, num);
+		}
+
+		Stats stats()
+		{
+			Stats const stats = { _submit_receiver.stats(), _ack_transmitter.stats() };
+			return stats;
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
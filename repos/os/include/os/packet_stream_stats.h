@@ -0,0 +1,73 @@
+/*
+ * \brief  Report the counters of packet streams
+ * \author Norman Feske
+ * \date   2015-12-19
+ *
+ * Servers can use these functions to include the state of their packet
+ * streams in a periodic report. For each queue, the report shows how many
+ * packets passed, whether the side blocked on the queue, and how many
+ * queue slots are free. A full submit queue at the source along with an
+ * idle sink, for example, points to a sink that lost a signal.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__PACKET_STREAM_STATS_H_
+#define _INCLUDE__OS__PACKET_STREAM_STATS_H_
+
+#include <os/packet_stream.h>
+#include <util/xml_generator.h>
+
+namespace Genode {
+
+	inline void generate_stats(Xml_generator &xml, char const *node_type,
+	                           Packet_queue_stats const &stats)
+	{
+		xml.node(node_type, [&] () {
+			xml.attribute("packets",          stats.packets);
+			xml.attribute("bytes",            (unsigned long long)stats.bytes);
+			xml.attribute("stalls",           stats.stalls);
+			xml.attribute("signals_sent",     stats.signals_sent);
+			xml.attribute("signals_received", stats.signals_received);
+			xml.attribute("slots_free",       stats.slots_free);
+		});
+	}
+
+	/**
+	 * Generate '<source>' node with the counters of a packet-stream source
+	 */
+	template <typename POLICY>
+	inline void generate_stats(Xml_generator &xml,
+	                           Packet_stream_source<POLICY> &source)
+	{
+		typename Packet_stream_source<POLICY>::Stats const stats = source.stats();
+
+		xml.node("source", [&] () {
+			xml.attribute("alloc_failures", stats.alloc_failures);
+			generate_stats(xml, "submit", stats.submit);
+			generate_stats(xml, "ack",    stats.ack);
+		});
+	}
+
+	/**
+	 * Generate '<sink>' node with the counters of a packet-stream sink
+	 */
+	template <typename POLICY>
+	inline void generate_stats(Xml_generator &xml,
+	                           Packet_stream_sink<POLICY> &sink)
+	{
+		typename Packet_stream_sink<POLICY>::Stats const stats = sink.stats();
+
+		xml.node("sink", [&] () {
+			generate_stats(xml, "submit", stats.submit);
+			generate_stats(xml, "ack",    stats.ack);
+		});
+	}
+}
+
+#endif /* _INCLUDE__OS__PACKET_STREAM_STATS_H_ */
@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__PIXEL_RGB565_H_
 
 #include <os/pixel_rgba.h>
+#include <os/pixel_row.h>
 
 namespace Genode {
 
@@ -56,6 +57,171 @@ namespace Genode {
 		res.pixel = blend(p1, 264 - alpha).pixel + blend(p2, alpha).pixel;
 		return res;
 	}
+
+
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+
+	/**
+	 * Eight RGB565 pixels processed at once
+	 *
+	 * The operations are based on the vector extension of GCC, which the
+	 * compiler translates to SSE2 or NEON instructions. They are used only
+	 * if the target CPU supports one of these instruction sets, which is
+	 * always the case for x86_64. The results are identical to those of
+	 * the corresponding 'Pixel_rgb565' operations.
+	 */
+	struct Pixel_rgb565_vector
+	{
+		enum { N = 8 };
+
+		typedef uint16_t Type __attribute__((vector_size(2*N)));
+
+		static inline Type splat(uint16_t v)
+		{
+			Type const res = { v, v, v, v, v, v, v, v };
+			return res;
+		}
+
+		static inline Type load(void const *src)
+		{
+			Type res;
+			__builtin_memcpy(&res, src, sizeof(res));
+			return res;
+		}
+
+		static inline void store(void *dst, Type v) {
+			__builtin_memcpy(dst, &v, sizeof(v)); }
+
+		static inline Type alpha(unsigned char const *a)
+		{
+			Type const res = { a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7] };
+			return res;
+		}
+
+		/**
+		 * Select pixels of 'v1' where 'mask' is set and of 'v2' otherwise
+		 */
+		static inline Type select(Type mask, Type v1, Type v2) {
+			return (mask & v1) | (~mask & v2); }
+
+		/**
+		 * Counterpart of 'Pixel_rgb565::blend' operating on single channels
+		 *
+		 * Processing the channels separately keeps all intermediate
+		 * results within 16 bits.
+		 */
+		static inline Type blend(Type p, Type alpha)
+		{
+			Type const mask = splat(0x1f);
+
+			Type const r = (((alpha >> splat(3)) * (p >> splat(11))) >> splat(5)) & mask;
+			Type const b = (((alpha >> splat(3)) * (p & mask))        >> splat(5)) & mask;
+			Type const g = ((alpha * ((p >> splat(6)) & mask))        >> splat(8)) & mask;
+
+			return (r << splat(11)) | (g << splat(6)) | b;
+		}
+
+		static inline Type mix(Type p1, Type p2, Type alpha) {
+			return blend(p1, splat(264) - alpha) + blend(p2, alpha); }
+	};
+
+
+	template <>
+	inline void Pixel_row<Pixel_rgb565>::mix(Pixel_rgb565 *dst,
+	                                         Pixel_rgb565 const *src,
+	                                         unsigned char const *alpha,
+	                                         unsigned n)
+	{
+		typedef Pixel_rgb565_vector V;
+
+		for (; n >= V::N; n -= V::N, dst += V::N, src += V::N, alpha += V::N) {
+
+			V::Type const a = V::alpha(alpha);
+			V::Type const d = V::load(dst);
+
+			V::Type const transparent = (V::Type)(a == V::splat(0));
+
+			V::store(dst, V::select(transparent, d, V::mix(d, V::load(src), a)));
+		}
+
+		for (; n--; dst++, src++, alpha++)
+			if (*alpha)
+				*dst = Pixel_rgb565::mix(*dst, *src, *alpha);
+	}
+
+
+	template <>
+	inline void Pixel_row<Pixel_rgb565>::mix(Pixel_rgb565 *dst,
+	                                         Pixel_rgb565 pixel, int alpha,
+	                                         unsigned n)
+	{
+		typedef Pixel_rgb565_vector V;
+
+		V::Type const a = V::splat(264 - alpha);
+		V::Type const p = V::splat(Pixel_rgb565::blend(pixel, alpha).pixel);
+
+		for (; n >= V::N; n -= V::N, dst += V::N)
+			V::store(dst, V::blend(V::load(dst), a) + p);
+
+		for (; n--; dst++)
+			*dst = Pixel_rgb565::mix(*dst, pixel, alpha);
+	}
+
+
+	template <>
+	inline void Pixel_row<Pixel_rgb565>::paint_masked(Pixel_rgb565 *dst,
+	                                                  Pixel_rgb565 pixel,
+	                                                  unsigned char const *mask,
+	                                                  int alpha, unsigned n)
+	{
+		typedef Pixel_rgb565_vector V;
+
+		V::Type const p = V::splat(pixel.pixel);
+		V::Type const a = V::splat(alpha);
+
+		/* mask value of pixels that are replaced, 256 never matches */
+		V::Type const full = V::splat(alpha == 255 ? 255 : 256);
+
+		for (; n >= V::N; n -= V::N, dst += V::N, mask += V::N) {
+
+			V::Type const m = V::alpha(mask);
+			V::Type const d = V::load(dst);
+
+			V::Type const uncovered = (V::Type)(m == V::splat(0));
+			V::Type const covered   = (V::Type)(m == full);
+
+			V::Type const mixed = V::mix(d, p, (a*m) >> V::splat(8));
+
+			V::store(dst, V::select(uncovered, d, V::select(covered, p, mixed)));
+		}
+
+		for (; n--; dst++, mask++)
+			if (*mask)
+				*dst = (*mask == 255 && alpha == 255)
+				     ? pixel : Pixel_rgb565::mix(*dst, pixel, (alpha*(*mask)) >> 8);
+	}
+
+
+	template <>
+	inline void Pixel_row<Pixel_rgb565>::copy_unmasked(Pixel_rgb565 *dst,
+	                                                   Pixel_rgb565 const *src,
+	                                                   unsigned n)
+	{
+		typedef Pixel_rgb565_vector V;
+
+		for (; n >= V::N; n -= V::N, dst += V::N, src += V::N) {
+
+			V::Type const s = V::load(src);
+			V::Type const masked = (V::Type)(s == V::splat(0));
+
+			V::store(dst, V::select(masked, V::load(dst), s));
+		}
+
+		for (; n--; dst++, src++)
+			if (src->pixel)
+				*dst = *src;
+	}
+#endif /* __SSE2__ || __ARM_NEON__ */
 }
 
 #endif /* _INCLUDE__OS__PIXEL_RGB565_H_ */
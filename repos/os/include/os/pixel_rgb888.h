@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__PIXEL_RGB888_H_
 
 #include <os/pixel_rgba.h>
+#include <os/pixel_row.h>
 
 namespace Genode {
 
@@ -40,6 +41,158 @@ namespace Genode {
 		res.pixel = blend(p1, 255 - alpha).pixel + blend(p2, alpha).pixel;
 		return res;
 	}
+
+
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+
+	/**
+	 * Four RGB888 pixels processed at once
+	 *
+	 * Like 'Pixel_rgb565_vector', the operations are based on the vector
+	 * extension of GCC and yield the results of the corresponding
+	 * 'Pixel_rgb888' operations.
+	 */
+	struct Pixel_rgb888_vector
+	{
+		enum { N = 4 };
+
+		typedef uint32_t Type __attribute__((vector_size(4*N)));
+
+		static inline Type splat(uint32_t v)
+		{
+			Type const res = { v, v, v, v };
+			return res;
+		}
+
+		static inline Type load(void const *src)
+		{
+			Type res;
+			__builtin_memcpy(&res, src, sizeof(res));
+			return res;
+		}
+
+		static inline void store(void *dst, Type v) {
+			__builtin_memcpy(dst, &v, sizeof(v)); }
+
+		static inline Type alpha(unsigned char const *a)
+		{
+			Type const res = { a[0], a[1], a[2], a[3] };
+			return res;
+		}
+
+		/**
+		 * Select pixels of 'v1' where 'mask' is set and of 'v2' otherwise
+		 */
+		static inline Type select(Type mask, Type v1, Type v2) {
+			return (mask & v1) | (~mask & v2); }
+
+		static inline Type blend(Type p, Type alpha)
+		{
+			return ((alpha * ((p & splat(0xff00)) >> splat(8))) & splat(0xff00))
+			     | (((alpha * (p & splat(0xff00ff))) >> splat(8)) & splat(0xff00ff));
+		}
+
+		static inline Type mix(Type p1, Type p2, Type alpha) {
+			return blend(p1, splat(255) - alpha) + blend(p2, alpha); }
+	};
+
+
+	template <>
+	inline void Pixel_row<Pixel_rgb888>::mix(Pixel_rgb888 *dst,
+	                                         Pixel_rgb888 const *src,
+	                                         unsigned char const *alpha,
+	                                         unsigned n)
+	{
+		typedef Pixel_rgb888_vector V;
+
+		for (; n >= V::N; n -= V::N, dst += V::N, src += V::N, alpha += V::N) {
+
+			V::Type const a = V::alpha(alpha);
+			V::Type const d = V::load(dst);
+
+			V::Type const transparent = (V::Type)(a == V::splat(0));
+
+			V::store(dst, V::select(transparent, d, V::mix(d, V::load(src), a)));
+		}
+
+		for (; n--; dst++, src++, alpha++)
+			if (*alpha)
+				*dst = Pixel_rgb888::mix(*dst, *src, *alpha);
+	}
+
+
+	template <>
+	inline void Pixel_row<Pixel_rgb888>::mix(Pixel_rgb888 *dst,
+	                                         Pixel_rgb888 pixel, int alpha,
+	                                         unsigned n)
+	{
+		typedef Pixel_rgb888_vector V;
+
+		V::Type const a = V::splat(255 - alpha);
+		V::Type const p = V::splat(Pixel_rgb888::blend(pixel, alpha).pixel);
+
+		for (; n >= V::N; n -= V::N, dst += V::N)
+			V::store(dst, V::blend(V::load(dst), a) + p);
+
+		for (; n--; dst++)
+			*dst = Pixel_rgb888::mix(*dst, pixel, alpha);
+	}
+
+
+	template <>
+	inline void Pixel_row<Pixel_rgb888>::paint_masked(Pixel_rgb888 *dst,
+	                                                  Pixel_rgb888 pixel,
+	                                                  unsigned char const *mask,
+	                                                  int alpha, unsigned n)
+	{
+		typedef Pixel_rgb888_vector V;
+
+		V::Type const p = V::splat(pixel.pixel);
+		V::Type const a = V::splat(alpha);
+
+		/* mask value of pixels that are replaced, 256 never matches */
+		V::Type const full = V::splat(alpha == 255 ? 255 : 256);
+
+		for (; n >= V::N; n -= V::N, dst += V::N, mask += V::N) {
+
+			V::Type const m = V::alpha(mask);
+			V::Type const d = V::load(dst);
+
+			V::Type const uncovered = (V::Type)(m == V::splat(0));
+			V::Type const covered   = (V::Type)(m == full);
+
+			V::Type const mixed = V::mix(d, p, (a*m) >> V::splat(8));
+
+			V::store(dst, V::select(uncovered, d, V::select(covered, p, mixed)));
+		}
+
+		for (; n--; dst++, mask++)
+			if (*mask)
+				*dst = (*mask == 255 && alpha == 255)
+				     ? pixel : Pixel_rgb888::mix(*dst, pixel, (alpha*(*mask)) >> 8);
+	}
+
+
+	template <>
+	inline void Pixel_row<Pixel_rgb888>::copy_unmasked(Pixel_rgb888 *dst,
+	                                                   Pixel_rgb888 const *src,
+	                                                   unsigned n)
+	{
+		typedef Pixel_rgb888_vector V;
+
+		for (; n >= V::N; n -= V::N, dst += V::N, src += V::N) {
+
+			V::Type const s = V::load(src);
+			V::Type const masked = (V::Type)(s == V::splat(0));
+
+			V::store(dst, V::select(masked, V::load(dst), s));
+		}
+
+		for (; n--; dst++, src++)
+			if (src->pixel)
+				*dst = *src;
+	}
+#endif /* __SSE2__ || __ARM_NEON__ */
 }
 
 #endif /* _INCLUDE__OS__PIXEL_RGB888_H_ */
@@ -0,0 +1,79 @@
+/*
+ * \brief  Operations on rows of pixels
+ * \author Norman Feske
+ * \date   2015-12-14
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__PIXEL_ROW_H_
+#define _INCLUDE__OS__PIXEL_ROW_H_
+
+namespace Genode { template <typename> struct Pixel_row; }
+
+
+/**
+ * Painting operations applied to a row of pixels
+ *
+ * \param PT  pixel type
+ *
+ * The generic implementation processes one pixel at a time. Pixel formats
+ * may specialize the operations to process several pixels at once.
+ */
+template <typename PT>
+struct Genode::Pixel_row
+{
+	/**
+	 * Mix 'n' pixels of 'src' into 'dst' at the ratios given by 'alpha'
+	 *
+	 * Destination pixels with an alpha value of zero stay untouched.
+	 */
+	static inline void mix(PT *dst, PT const *src, unsigned char const *alpha,
+	                       unsigned n)
+	{
+		for (; n--; dst++, src++, alpha++)
+			if (*alpha)
+				*dst = PT::mix(*dst, *src, *alpha);
+	}
+
+	/**
+	 * Mix 'pixel' into 'n' pixels of 'dst' at the ratio 'alpha'
+	 */
+	static inline void mix(PT *dst, PT pixel, int alpha, unsigned n)
+	{
+		for (; n--; dst++)
+			*dst = PT::mix(*dst, pixel, alpha);
+	}
+
+	/**
+	 * Paint 'pixel' into 'n' pixels of 'dst' through the coverage 'mask'
+	 *
+	 * The mask values are scaled by 'alpha'. If 'alpha' is 255, fully
+	 * covered pixels are set to 'pixel'.
+	 */
+	static inline void paint_masked(PT *dst, PT pixel, unsigned char const *mask,
+	                                int alpha, unsigned n)
+	{
+		for (; n--; dst++, mask++)
+			if (*mask)
+				*dst = (*mask == 255 && alpha == 255)
+				     ? pixel : PT::mix(*dst, pixel, (alpha*(*mask)) >> 8);
+	}
+
+	/**
+	 * Copy the 'n' pixels of 'src' to 'dst' except for black ones
+	 */
+	static inline void copy_unmasked(PT *dst, PT const *src, unsigned n)
+	{
+		for (; n--; dst++, src++)
+			if (src->pixel)
+				*dst = *src;
+	}
+};
+
+#endif /* _INCLUDE__OS__PIXEL_ROW_H_ */
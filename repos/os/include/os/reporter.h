@@ -33,7 +33,8 @@ class Genode::Reporter : Noncopyable
 
 		Name const _name;
 
-		size_t const _buffer_size;
+		size_t       _buffer_size;
+		size_t const _max_buffer_size;
 
 		bool _enabled = false;
 
@@ -58,10 +59,45 @@ class Genode::Reporter : Noncopyable
 		 */
 		char *_base() { return _enabled ? _conn->ds.local_addr<char>() : 0; }
 
+		/**
+		 * Re-open report session with a larger buffer
+		 *
+		 * The buffer size is doubled up to the maximum buffer size.
+		 *
+		 * \return false if the buffer cannot grow any further
+		 */
+		bool _grow()
+		{
+			if (!_enabled || _buffer_size >= _max_buffer_size)
+				return false;
+
+			_buffer_size = min(2*_buffer_size, _max_buffer_size);
+
+			_conn.construct(_name.string(), _buffer_size);
+			return true;
+		}
+
 	public:
 
-		Reporter(char const *report_name, size_t buffer_size = 4096)
-		: _name(report_name), _buffer_size(buffer_size) { }
+		/**
+		 * Constructor
+		 *
+		 * \param report_name      name of the report
+		 * \param buffer_size      initial size of the report buffer
+		 * \param max_buffer_size  size up to which the report buffer grows
+		 *                         if a report does not fit
+		 *
+		 * By default, the report buffer does not grow. A report that exceeds
+		 * the buffer is dropped and the XML generator throws a
+		 * 'Buffer_exceeded' exception. Once grown, the buffer keeps its
+		 * size for subsequent reports.
+		 */
+		Reporter(char const *report_name, size_t buffer_size = 4096,
+		         size_t max_buffer_size = 0)
+		:
+			_name(report_name), _buffer_size(buffer_size),
+			_max_buffer_size(max(buffer_size, max_buffer_size))
+		{ }
 
 		/**
 		 * Enable or disable reporting
@@ -95,28 +131,44 @@ class Genode::Reporter : Noncopyable
 		 */
 		void report(void const *data, size_t length)
 		{
-			void *base = _base();
-
-			if (!base || length > _size())
+			if (!_enabled)
 				return;
 
-			memcpy(base, data, length);
+			while (length > _size())
+				if (!_grow())
+					return;
+
+			memcpy(_base(), data, length);
 			_conn->report.submit(length);
 		}
 
 		/**
 		 * XML generator targeting a reporter
+		 *
+		 * The XML output is generated directly into the report buffer. If
+		 * it does not fit, the buffer is grown and the output is generated
+		 * anew, as far as permitted by the maximum buffer size of the
+		 * reporter.
 		 */
 		struct Xml_generator : public Genode::Xml_generator
 		{
 			template <typename FUNC>
 			Xml_generator(Reporter &reporter, FUNC const &func)
 			:
-				Genode::Xml_generator(reporter._base(),
-				                      reporter._size(),
-				                      reporter._name.string(),
-				                      func)
+				Genode::Xml_generator(nullptr, 0, reporter._name.string(), func)
 			{
+				while (reporter._base()) {
+					try {
+						_generate(reporter._base(), reporter._size(),
+						          reporter._name.string(), func);
+						break;
+					}
+					catch (Buffer_exceeded) {
+						if (!reporter._grow())
+							throw;
+					}
+				}
+
 				reporter._conn->report.submit(used());
 			}
 		};
@@ -45,6 +45,7 @@ struct Genode::Signal_rpc_member : Genode::Signal_dispatcher_base,
 	EP &ep;
 	T  &obj;
 	void (T::*member) (unsigned);
+	unsigned const prio;
 
 	/**
 	 * Constructor
@@ -52,10 +53,14 @@ struct Genode::Signal_rpc_member : Genode::Signal_dispatcher_base,
 	 * \param ep          entrypoint managing this signal RPC
 	 * \param obj,member  object and method to call when
 	 *                    the signal occurs
+	 * \param priority    signals of higher priority are handled first
+	 *                    if several signals are pending at once, e.g.,
+	 *                    data-path signals before control signals
 	 */
-	Signal_rpc_member(EP &ep, T &obj, void (T::*member)(unsigned))
+	Signal_rpc_member(EP &ep, T &obj, void (T::*member)(unsigned),
+	                  unsigned priority = 0)
 	: Signal_context_capability(ep.manage(*this)),
-	  ep(ep), obj(obj), member(member) { }
+	  ep(ep), obj(obj), member(member), prio(priority) { }
 
 	~Signal_rpc_member() { ep.dissolve(*this); }
 
@@ -63,6 +68,8 @@ struct Genode::Signal_rpc_member : Genode::Signal_dispatcher_base,
 	 * Interface of Signal_dispatcher_base
 	 */
 	void dispatch(unsigned num) { (obj.*member)(num); }
+
+	unsigned priority() const { return prio; }
 };
 
 #endif /* _INCLUDE__OS__SIGNAL_RPC_DISPATCHER_H_ */
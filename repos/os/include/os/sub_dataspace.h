@@ -0,0 +1,78 @@
+/*
+ * \brief  Dataspace referring to a part of another dataspace
+ * \author Norman Feske
+ * \date   2015-11-27
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__SUB_DATASPACE_H_
+#define _INCLUDE__OS__SUB_DATASPACE_H_
+
+#include <rm_session/connection.h>
+#include <util/misc_math.h>
+#include <util/noncopyable.h>
+
+namespace Genode { class Sub_dataspace; }
+
+
+/**
+ * Page-aligned range of a dataspace, handed out as dataspace of its own
+ *
+ * The range is exported as managed dataspace that is backed by the
+ * original dataspace. Hence, no content is copied.
+ */
+class Genode::Sub_dataspace : Noncopyable
+{
+	public:
+
+		enum { PAGE_SIZE_LOG2 = 12, PAGE_SIZE = 1 << PAGE_SIZE_LOG2 };
+
+		class Unaligned { };
+
+		/**
+		 * Return true if a range at 'offset' can be exported
+		 */
+		static bool aligned(addr_t offset) { return (offset & (PAGE_SIZE - 1)) == 0; }
+
+	private:
+
+		Rm_connection _rm;
+
+		static size_t _checked_size(addr_t offset, size_t size)
+		{
+			if (!aligned(offset) || size == 0)
+				throw Unaligned();
+
+			return align_addr(size, PAGE_SIZE_LOG2);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param ds      dataspace containing the range
+		 * \param offset  page-aligned offset of the range within 'ds'
+		 * \param size    size of the range, extended to the next page
+		 *                boundary
+		 *
+		 * \throw Unaligned
+		 * \throw Parent::Service_denied  no RM session available
+		 * \throw Rm_session::Attach_failed
+		 */
+		Sub_dataspace(Dataspace_capability ds, addr_t offset, size_t size)
+		: _rm(0, _checked_size(offset, size))
+		{
+			_rm.attach_executable(ds, 0, align_addr(size, PAGE_SIZE_LOG2), offset);
+		}
+
+		Dataspace_capability dataspace() { return _rm.dataspace(); }
+};
+
+#endif /* _INCLUDE__OS__SUB_DATASPACE_H_ */
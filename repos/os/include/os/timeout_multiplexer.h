@@ -0,0 +1,275 @@
+/*
+ * \brief  Multiplexer of local timeouts onto a single timer session
+ * \author Norman Feske
+ * \date   2015-12-30
+ *
+ * Components that use many timeouts, e.g., protocol stacks with per-connection
+ * retransmission timers, would otherwise issue a 'trigger_once' RPC for each
+ * timeout they (re-)arm and an 'elapsed_ms' RPC each time they look at the
+ * clock. The multiplexer keeps the timeouts in a local alarm scheduler and
+ * programs only the earliest deadline at the timer session. The current time
+ * is interpolated locally between the synchronization points with the timer.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__TIMEOUT_MULTIPLEXER_H_
+#define _INCLUDE__OS__TIMEOUT_MULTIPLEXER_H_
+
+/* Genode includes */
+#include <base/lock.h>
+#include <os/alarm.h>
+#include <timer_session/timer_session.h>
+#include <trace/timestamp.h>
+
+namespace Genode {
+
+	class Interpolated_time;
+	class Timeout_multiplexer;
+}
+
+
+/**
+ * Time source that avoids an 'elapsed_ms' RPC per query
+ *
+ * The time is extrapolated from the most recent value obtained from the
+ * timer session using the CPU's timestamp counter. The rate of the counter
+ * is calibrated against the timer session. To bound the error caused by a
+ * drifting counter, the time is re-obtained from the timer session whenever
+ * the last synchronization lies more than 'MAX_INTERPOLATION_MS' back.
+ *
+ * Interpolation is used only with a 64-bit timestamp counter. The 32-bit
+ * counters of the ARM platforms wrap within a few seconds, which cannot be
+ * detected after an idle period. On these platforms, each query results in
+ * an RPC to the timer as before.
+ *
+ * The returned time is monotonic.
+ */
+class Genode::Interpolated_time
+{
+	public:
+
+		typedef Alarm::Time Time;
+
+	private:
+
+		enum {
+			CALIBRATION_MS       = 100,  /* minimal calibration interval */
+			MAX_INTERPOLATION_MS = 1000,
+		};
+
+		typedef Trace::Timestamp Timestamp;
+
+		Timer::Session &_timer;
+
+		Lock _lock;
+
+		Timestamp _sync_ts = 0;  /* timestamp at last synchronization */
+		Time      _sync_ms = 0;  /* timer value at last synchronization */
+
+		Timestamp _calib_ts = 0; /* start of current calibration interval */
+		Time      _calib_ms = 0;
+
+		Timestamp _ticks_per_ms = 0;  /* 0 if not calibrated yet */
+
+		Time _last_ms = 0;  /* last returned time, used to stay monotonic */
+
+		static bool _interpolation_supported() {
+			return sizeof(Timestamp) >= sizeof(uint64_t); }
+
+		Time _monotonic(Time ms)
+		{
+			if ((long)(ms - _last_ms) > 0)
+				_last_ms = ms;
+
+			return _last_ms;
+		}
+
+		void _unsynchronized_sync()
+		{
+			Time      const ms = _timer.elapsed_ms();
+			Timestamp const ts = Trace::timestamp();
+
+			_sync_ts = ts;
+			_sync_ms = ms;
+
+			if (!_interpolation_supported())
+				return;
+
+			if (!_calib_ts) {
+				_calib_ts = ts;
+				_calib_ms = ms;
+				return;
+			}
+
+			Time const calib_interval_ms = ms - _calib_ms;
+			if (calib_interval_ms < CALIBRATION_MS)
+				return;
+
+			_ticks_per_ms = (ts - _calib_ts) / calib_interval_ms;
+			_calib_ts     = ts;
+			_calib_ms     = ms;
+		}
+
+	public:
+
+		Interpolated_time(Timer::Session &timer) : _timer(timer) { sync(); }
+
+		/**
+		 * Obtain the current time from the timer session
+		 *
+		 * Besides being called internally, the method should be called
+		 * whenever the timer session is used anyway, in particular on the
+		 * occurrence of a timeout signal. This way, the interpolation
+		 * rarely has to fall back to querying the timer.
+		 */
+		Time sync()
+		{
+			Lock::Guard guard(_lock);
+
+			_unsynchronized_sync();
+			return _monotonic(_sync_ms);
+		}
+
+		/**
+		 * Return time in milliseconds
+		 */
+		Time elapsed_ms()
+		{
+			Lock::Guard guard(_lock);
+
+			if (!_ticks_per_ms) {
+				_unsynchronized_sync();
+				return _monotonic(_sync_ms);
+			}
+
+			Timestamp const ms = (Trace::timestamp() - _sync_ts) / _ticks_per_ms;
+
+			if (ms >= MAX_INTERPOLATION_MS) {
+				_unsynchronized_sync();
+				return _monotonic(_sync_ms);
+			}
+
+			return _monotonic(_sync_ms + ms);
+		}
+};
+
+
+/**
+ * Scheduler of local timeouts, driven by a single timer session
+ *
+ * The timeouts are 'Alarm' objects. Only the earliest deadline is programmed
+ * at the timer session, and only if it lies before the deadline already
+ * programmed. Hence, re-arming a timeout to a later point in time - the
+ * common case of retransmission timers - does not involve the timer at all.
+ *
+ * The signal handler of the timer session is registered by the user of the
+ * multiplexer, who must call 'handle_timeout' on each timer signal. Alarms
+ * are executed in the context of this call.
+ *
+ * When an alarm is discarded, the timer signal programmed for it is not
+ * revoked. On its occurrence, the multiplexer merely programs the next
+ * deadline.
+ */
+class Genode::Timeout_multiplexer : public Alarm_scheduler
+{
+	public:
+
+		typedef Alarm::Time Time;
+
+	private:
+
+		Timer::Session    &_timer;
+		Interpolated_time  _time;
+
+		Lock _lock;         /* protects the state of the programmed timeout */
+		bool _armed = false;
+		Time _programmed_deadline = 0;
+
+		/**
+		 * Program the earliest deadline at the timer if needed
+		 */
+		void _program()
+		{
+			Lock::Guard guard(_lock);
+
+			Time deadline;
+			if (!next_deadline(&deadline))
+				return;
+
+			/* the timer already fires before the deadline */
+			if (_armed && (long)(deadline - _programmed_deadline) >= 0)
+				return;
+
+			Time const now   = _time.elapsed_ms();
+			Time const delay = (long)(deadline - now) > 0 ? deadline - now : 0;
+
+			/* a timeout of zero is rounded up by the timer anyway */
+			_timer.trigger_once(delay*1000);
+
+			_programmed_deadline = deadline;
+			_armed = true;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param timer  timer session used exclusively by the multiplexer
+		 */
+		Timeout_multiplexer(Timer::Session &timer)
+		: _timer(timer), _time(timer) { }
+
+		/**
+		 * Return current time in milliseconds without contacting the timer
+		 * in the common case
+		 */
+		Time elapsed_ms() { return _time.elapsed_ms(); }
+
+		/**
+		 * Schedule one-shot timeout relative to the current time
+		 *
+		 * If the alarm is already scheduled, its deadline is replaced.
+		 */
+		void schedule_once(Alarm &alarm, Time duration_ms)
+		{
+			schedule_absolute(&alarm, elapsed_ms() + duration_ms);
+			_program();
+		}
+
+		/**
+		 * Schedule periodic timeout
+		 *
+		 * As with 'Alarm_scheduler::schedule', the first deadline is
+		 * overdue, i.e., the alarm triggers with the next timer signal.
+		 */
+		void schedule_periodic(Alarm &alarm, Time period_ms)
+		{
+			schedule(&alarm, period_ms);
+			_program();
+		}
+
+		/**
+		 * Execute the pending alarms
+		 *
+		 * To be called by the signal handler of the timer session.
+		 */
+		void handle_timeout()
+		{
+			{
+				Lock::Guard guard(_lock);
+				_armed = false;
+			}
+
+			handle(_time.sync());
+			_program();
+		}
+};
+
+#endif /* _INCLUDE__OS__TIMEOUT_MULTIPLEXER_H_ */
@@ -0,0 +1,313 @@
+/*
+ * \brief  Extent-based storage of sparse files in RAM
+ * \author Norman Feske
+ * \date   2015-11-25
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__RAM_FS__EXTENTS_H_
+#define _INCLUDE__RAM_FS__EXTENTS_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+#include <base/allocator.h>
+#include <util/string.h>
+#include <file_system_session/file_system_session.h>
+
+namespace File_system {
+
+	using namespace Genode;
+
+	template <unsigned, unsigned, unsigned> class Extents;
+}
+
+
+/**
+ * Byte array stored in extents of increasing size
+ *
+ * \param INLINE_SIZE      number of bytes stored within the object itself
+ * \param MIN_EXTENT_LOG2  log2 of the size of the first extent
+ * \param MAX_EXTENT_LOG2  log2 of the size of the largest extents
+ *
+ * The content of small files fits into the object itself. The first extent
+ * covers the offsets up to '2^MIN_EXTENT_LOG2'. It is allocated just as
+ * large as needed and grows with the file. The following extents double in
+ * size up to '2^MAX_EXTENT_LOG2' bytes, beyond which all extents have the
+ * maximum size. Hence, the number of extents grows only logarithmically up
+ * to the maximum extent size, and large files consist of large contiguous
+ * extents. Extents are allocated on the first write only, ranges never
+ * written to are read as zeros and occupy no memory.
+ */
+template <unsigned INLINE_SIZE, unsigned MIN_EXTENT_LOG2, unsigned MAX_EXTENT_LOG2>
+class File_system::Extents : Noncopyable
+{
+	public:
+
+		enum { MIN_EXTENT = 1UL << MIN_EXTENT_LOG2,
+		       MAX_EXTENT = 1UL << MAX_EXTENT_LOG2,
+		       NUM_GROWING = MAX_EXTENT_LOG2 - MIN_EXTENT_LOG2 };
+
+	private:
+
+		Allocator &_alloc;
+
+		char    _inline[INLINE_SIZE];
+		char   *_head;           /* first extent */
+		size_t  _head_size;      /* allocated size of first extent */
+		char  **_index;          /* extents following the first one */
+		size_t  _index_size;     /* number of entries of '_index' */
+
+		static unsigned _log2(file_size_t v)
+		{
+			unsigned l = 0;
+			for (; v >>= 1; l++);
+			return l;
+		}
+
+		/**
+		 * Return number of extent that contains 'offset'
+		 */
+		static size_t _extent(seek_off_t offset)
+		{
+			if (offset < MIN_EXTENT)
+				return 0;
+
+			if (offset < MAX_EXTENT)
+				return _log2(offset) - MIN_EXTENT_LOG2 + 1;
+
+			return NUM_GROWING + 1 + ((offset - MAX_EXTENT) >> MAX_EXTENT_LOG2);
+		}
+
+		static seek_off_t _base(size_t extent)
+		{
+			if (extent == 0)
+				return 0;
+
+			if (extent <= NUM_GROWING)
+				return (seek_off_t)1 << (MIN_EXTENT_LOG2 + extent - 1);
+
+			return MAX_EXTENT + ((seek_off_t)(extent - NUM_GROWING - 1) << MAX_EXTENT_LOG2);
+		}
+
+		static size_t _size(size_t extent)
+		{
+			if (extent == 0)
+				return MIN_EXTENT;
+
+			if (extent <= NUM_GROWING)
+				return (size_t)1 << (MIN_EXTENT_LOG2 + extent - 1);
+
+			return MAX_EXTENT;
+		}
+
+		template <typename T>
+		T *_alloc_zeroed(size_t size)
+		{
+			T *ptr = 0;
+			if (!_alloc.alloc(size, &ptr))
+				throw Allocator::Out_of_memory();
+
+			memset(ptr, 0, size);
+			return ptr;
+		}
+
+		void _free_head()
+		{
+			if (_head)
+				_alloc.free(_head, _head_size);
+
+			_head = 0;
+			_head_size = 0;
+		}
+
+		void _free_extent(size_t i)
+		{
+			if (i >= _index_size || !_index[i])
+				return;
+
+			_alloc.free(_index[i], _size(i));
+			_index[i] = 0;
+		}
+
+		/**
+		 * Return first extent with at least 'size' bytes
+		 */
+		char *_head_for_writing(size_t size)
+		{
+			if (_head && size <= _head_size)
+				return _head;
+
+			size_t new_size = _head ? _head_size : max((size_t)INLINE_SIZE*2, (size_t)16);
+			while (new_size < size)
+				new_size *= 2;
+			new_size = min(new_size, (size_t)MIN_EXTENT);
+
+			char *head = _alloc_zeroed<char>(new_size);
+			if (_head)
+				memcpy(head, _head, _head_size);
+			else
+				memcpy(head, _inline, INLINE_SIZE);
+
+			_free_head();
+			_head      = head;
+			_head_size = new_size;
+			return _head;
+		}
+
+		char *_extent_for_writing(size_t i)
+		{
+			if (i >= _index_size) {
+				size_t new_size = _index_size ? _index_size : 16;
+				while (new_size <= i)
+					new_size *= 2;
+
+				char **index = _alloc_zeroed<char *>(new_size*sizeof(char *));
+				if (_index) {
+					memcpy(index, _index, _index_size*sizeof(char *));
+					_alloc.free(_index, _index_size*sizeof(char *));
+				}
+				_index      = index;
+				_index_size = new_size;
+			}
+
+			if (!_index[i])
+				_index[i] = _alloc_zeroed<char>(_size(i));
+
+			return _index[i];
+		}
+
+	public:
+
+		Extents(Allocator &alloc)
+		: _alloc(alloc), _head(0), _head_size(0), _index(0), _index_size(0)
+		{
+			memset(_inline, 0, INLINE_SIZE);
+		}
+
+		~Extents()
+		{
+			truncate(0);
+			_free_head();
+		}
+
+		/**
+		 * Return number of bytes allocated for the content
+		 *
+		 * The memory used for the index of extents is not included.
+		 */
+		file_size_t allocated() const
+		{
+			file_size_t sum = _head_size;
+			for (size_t i = 0; i < _index_size; i++)
+				if (_index[i])
+					sum += _size(i);
+			return sum;
+		}
+
+		void write(char const *src, size_t len, seek_off_t seek_offset)
+		{
+			while (len > 0) {
+
+				size_t     const i    = _extent(seek_offset);
+				seek_off_t const off  = seek_offset - _base(i);
+				size_t     const curr = min(len, (size_t)(_size(i) - off));
+
+				char *dst;
+				if (i > 0)
+					dst = _extent_for_writing(i);
+				else if (!_head && off + curr <= INLINE_SIZE)
+					dst = _inline;
+				else
+					dst = _head_for_writing(off + curr);
+
+				memcpy(dst + off, src, curr);
+
+				len         -= curr;
+				src         += curr;
+				seek_offset += curr;
+			}
+		}
+
+		void read(char *dst, size_t len, seek_off_t seek_offset) const
+		{
+			while (len > 0) {
+
+				size_t     const i    = _extent(seek_offset);
+				seek_off_t const off  = seek_offset - _base(i);
+				size_t     const curr = min(len, (size_t)(_size(i) - off));
+
+				char const *src   = 0;
+				size_t      avail = 0;
+				if (i > 0) {
+					src   = i < _index_size ? _index[i] : 0;
+					avail = _size(i);
+				} else if (_head) {
+					src   = _head;
+					avail = _head_size;
+				} else {
+					src   = _inline;
+					avail = INLINE_SIZE;
+				}
+
+				/* bytes backed by memory, the rest reads as zeros */
+				size_t const backed = (src && off < avail)
+				                    ? min(curr, (size_t)(avail - off)) : 0;
+
+				if (backed)
+					memcpy(dst, src + off, backed);
+				if (backed < curr)
+					memset(dst + backed, 0, curr - backed);
+
+				len         -= curr;
+				dst         += curr;
+				seek_offset += curr;
+			}
+		}
+
+		/**
+		 * Discard content at and beyond 'size'
+		 */
+		void truncate(file_size_t size)
+		{
+			size_t const last = _extent(size);
+
+			/* release extents that lie completely beyond 'size' */
+			for (size_t i = max(last + 1, (size_t)1); i < _index_size; i++)
+				_free_extent(i);
+
+			/* zero the tail of the extent containing 'size' */
+			seek_off_t const off = size - _base(last);
+			if (last > 0) {
+				if (off == 0)
+					_free_extent(last);
+				else if (last < _index_size && _index[last])
+					memset(_index[last] + off, 0, _size(last) - off);
+			} else {
+				if (_head && off < _head_size)
+					memset(_head + off, 0, _head_size - off);
+				if (off < INLINE_SIZE)
+					memset(_inline + off, 0, INLINE_SIZE - off);
+			}
+
+			/* move small content back into the object */
+			if (_head && size <= INLINE_SIZE) {
+				memcpy(_inline, _head, INLINE_SIZE);
+				_free_head();
+			}
+
+			/* release index if no extent beyond the first one remains */
+			if (_index && size <= MIN_EXTENT) {
+				_alloc.free(_index, _index_size*sizeof(char *));
+				_index      = 0;
+				_index_size = 0;
+			}
+		}
+};
+
+#endif /* _INCLUDE__RAM_FS__EXTENTS_H_ */
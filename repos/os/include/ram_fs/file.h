@@ -16,10 +16,12 @@
 
 /* Genode includes */
 #include <base/allocator.h>
+#include <base/env.h>
+#include <util/misc_math.h>
 
 /* local includes */
 #include <ram_fs/node.h>
-#include <ram_fs/chunk.h>
+#include <ram_fs/extents.h>
 
 namespace File_system { class File; }
 
@@ -28,50 +30,53 @@ class File_system::File : public Node
 {
 	private:
 
-		typedef Chunk<4096>                     Chunk_level_3;
-		typedef Chunk_index<128, Chunk_level_3> Chunk_level_2;
-		typedef Chunk_index<64,  Chunk_level_2> Chunk_level_1;
-		typedef Chunk_index<64,  Chunk_level_1> Chunk_level_0;
+		/*
+		 * Content of up to 64 bytes is stored inline, the extents grow
+		 * from 4 KiB to 1 MiB
+		 */
+		typedef Extents<64, 12, 20> Content;
 
-		Chunk_level_0 _chunk;
+		enum { MAX_FILE_SIZE_LOG2 = 40 };
+
+		Content _content;
 
 		file_size_t _length;
 
+		/*
+		 * Dataspace handed out to clients for mapping the file
+		 */
+		Ram_dataspace_capability _ds;
+		size_t                   _ds_size;
+		char                    *_ds_local;
+
+		void _release_dataspace()
+		{
+			if (!_ds.valid())
+				return;
+
+			env()->rm_session()->detach(_ds_local);
+			env()->ram_session()->free(_ds);
+			_ds = Ram_dataspace_capability();
+		}
+
 	public:
 
 		File(Allocator &alloc, char const *name)
-		: _chunk(alloc, 0), _length(0) { Node::name(name); }
+		: _content(alloc), _length(0), _ds_size(0), _ds_local(0) { Node::name(name); }
+
+		~File() { _release_dataspace(); }
 
 		size_t read(char *dst, size_t len, seek_off_t seek_offset)
 		{
-			file_size_t const chunk_used_size = _chunk.used_size();
-
 			if (seek_offset >= _length)
 				return 0;
 
-			/*
-			 * Constrain read transaction to available chunk data
-			 *
-			 * Note that 'chunk_used_size' may be lower than '_length'
-			 * because 'Chunk' may have truncated tailing zeros.
-			 */
+			/* constrain read transaction to the file length */
 			if (seek_offset + len >= _length)
 				len = _length - seek_offset;
 
-			file_size_t read_len = len;
-
-			if (seek_offset + read_len > chunk_used_size) {
-				if (chunk_used_size >= seek_offset)
-					read_len = chunk_used_size - seek_offset;
-				else
-					read_len = 0;
-			}
-
-			_chunk.read(dst, read_len, seek_offset);
-
-			/* add zero padding if needed */
-			if (read_len < len)
-				memset(dst + read_len, 0, len - read_len);
+			/* unwritten ranges are read as zeros */
+			_content.read(dst, len, seek_offset);
 
 			return len;
 		}
@@ -79,20 +84,23 @@ class File_system::File : public Node
 		size_t write(char const *src, size_t len, seek_off_t seek_offset)
 		{
 			if (seek_offset == (seek_off_t)(~0))
-				seek_offset = _chunk.used_size();
+				seek_offset = _length;
 
-			if (seek_offset + len >= Chunk_level_0::SIZE)
+			if (seek_offset + len >= ((file_size_t)1 << MAX_FILE_SIZE_LOG2))
 				throw Size_limit_reached();
 
-			_chunk.write(src, len, (size_t)seek_offset);
+			_content.write(src, len, seek_offset);
 
-			/*
-			 * Keep track of file length. We cannot use 'chunk.used_size()'
-			 * as file length because trailing zeros may by represented
-			 * by zero chunks, which do not contribute to 'used_size()'.
-			 */
 			_length = max(_length, seek_offset + len);
 
+			/* keep mapped file content up to date */
+			if (_ds.valid()) {
+				if (_length > _ds_size)
+					_release_dataspace();
+				else
+					memcpy(_ds_local + seek_offset, src, len);
+			}
+
 			mark_as_updated();
 			return len;
 		}
@@ -101,13 +109,41 @@ class File_system::File : public Node
 
 		void truncate(file_size_t size)
 		{
-			if (size < _chunk.used_size())
-				_chunk.truncate(size);
+			if (size < _length)
+				_content.truncate(size);
 
 			_length = size;
 
+			_release_dataspace();
+
 			mark_as_updated();
 		}
+
+		/**
+		 * Return dataspace containing the file content
+		 *
+		 * \return  invalid capability if the file is empty or the RAM
+		 *          for the dataspace could not be allocated
+		 */
+		Dataspace_capability dataspace()
+		{
+			if (_ds.valid() || !_length)
+				return _ds;
+
+			try {
+				_ds_size  = align_addr((size_t)_length, 12);
+				_ds       = env()->ram_session()->alloc(_ds_size);
+				_ds_local = env()->rm_session()->attach(_ds);
+			} catch (...) {
+				if (_ds.valid())
+					env()->ram_session()->free(_ds);
+				_ds = Ram_dataspace_capability();
+				return _ds;
+			}
+
+			read(_ds_local, _length, 0);
+			return _ds;
+		}
 };
 
 #endif /* _INCLUDE__RAM_FS__FILE_H_ */
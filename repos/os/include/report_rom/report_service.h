@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -36,11 +36,16 @@ struct Report::Session_component : Genode::Rpc_object<Session>, Rom::Writer
 
 		Genode::Session_label const _label;
 
-		Genode::Attached_ram_dataspace _ds;
+		/*
+		 * The buffer is reference-counted because it may be handed over
+		 * to the ROM module, see 'submit_handover'.
+		 */
+		Rom::Buffer *_buffer;
 
 		Rom::Module &_module;
 
 		bool &_verbose;
+		bool &_handover;
 
 		Rom::Module &_create_module(Rom::Module::Name const &name)
 		{
@@ -59,18 +64,26 @@ struct Report::Session_component : Genode::Rpc_object<Session>, Rom::Writer
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param handover  permit the hand over of reports to the ROM
+		 *                  clients via 'submit_handover'
+		 */
 		Session_component(Genode::Session_label const &label, size_t buffer_size,
-		                  Rom::Registry_for_writer &registry, bool &verbose)
+		                  Rom::Registry_for_writer &registry, bool &verbose,
+		                  bool &handover)
 		:
 			_registry(registry), _label(label),
-			_ds(Genode::env()->ram_session(), buffer_size),
+			_buffer(Rom::Buffer::create(buffer_size + 1)),
 			_module(_create_module(label.string())),
-			_verbose(verbose)
+			_verbose(verbose), _handover(handover)
 		{ }
 
 		~Session_component()
 		{
 			_registry.release(*this, _module);
+			Rom::Buffer::release(_buffer);
 		}
 
 		/**
@@ -78,18 +91,51 @@ struct Report::Session_component : Genode::Rpc_object<Session>, Rom::Writer
 		 */
 		Genode::Session_label label() const override { return _label; }
 
-		Dataspace_capability dataspace() override { return _ds.cap(); }
+		Dataspace_capability dataspace() override { return _buffer->cap(); }
 
 		void submit(size_t length) override
 		{
-			length = Genode::min(length, _ds.size());
+			length = Genode::min(length, _buffer->size());
 
 			if (_verbose) {
 				PLOG("report '%s'", _module.name().string());
-				_log_lines(_ds.local_addr<char>(), length);
+				_log_lines(_buffer->local_addr(), length);
+			}
+
+			_module.write_content(*this, _buffer->local_addr(), length);
+		}
+
+		Dataspace_capability submit_handover(size_t length) override
+		{
+			if (!_handover) {
+				submit(length);
+				return _buffer->cap();
 			}
 
-			_module.write_content(*this, _ds.local_addr<char>(), length);
+			/* reserve space for the zero termination expected by the module */
+			length = Genode::min(length, _buffer->size() - 1);
+
+			if (_verbose) {
+				PLOG("report '%s' (handed over)", _module.name().string());
+				_log_lines(_buffer->local_addr(), length);
+			}
+
+			_buffer->local_addr()[length] = 0;
+
+			if (!_module.hand_over_content(*this, *_buffer, length))
+				return _buffer->cap();
+
+			/*
+			 * Continue with a fresh buffer. A former buffer is never
+			 * recycled because a ROM client may keep it attached. Its
+			 * dataspace is freed once the last ROM client releases it.
+			 */
+			Rom::Buffer * const next = Rom::Buffer::create(_buffer->size());
+
+			Rom::Buffer::release(_buffer);
+			_buffer = next;
+
+			return _buffer->cap();
 		}
 
 		void response_sigh(Genode::Signal_context_capability) override { }
@@ -104,6 +150,7 @@ struct Report::Root : Genode::Root_component<Session_component>
 
 		Rom::Registry_for_writer &_rom_registry;
 		bool                     &_verbose;
+		bool                     &_handover;
 
 	protected:
 
@@ -117,7 +164,7 @@ struct Report::Root : Genode::Root_component<Session_component>
 
 			return new (md_alloc())
 				Session_component(Genode::Session_label(args), buffer_size,
-				                  _rom_registry, _verbose);
+				                  _rom_registry, _verbose, _handover);
 		}
 
 	public:
@@ -125,10 +172,11 @@ struct Report::Root : Genode::Root_component<Session_component>
 		Root(Server::Entrypoint       &ep,
 		     Genode::Allocator        &md_alloc,
 		     Rom::Registry_for_writer &rom_registry,
-		     bool                     &verbose)
+		     bool                     &verbose,
+		     bool                     &handover)
 		:
 			Genode::Root_component<Session_component>(&ep.rpc_ep(), &md_alloc),
-			_rom_registry(rom_registry), _verbose(verbose)
+			_rom_registry(rom_registry), _verbose(verbose), _handover(handover)
 		{ }
 };
 
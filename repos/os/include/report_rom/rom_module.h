@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -37,6 +37,59 @@ namespace Rom {
 }
 
 
+/**
+ * Backing store of module content that is shared with the ROM clients
+ *
+ * A buffer is handed over from a report session to a module, which passes
+ * the buffer's dataspace to the ROM clients instead of copying the content.
+ * The buffer is reference-counted by the report session, the module, and
+ * the ROM sessions. So it stays alive as long as a ROM client may still
+ * have the dataspace attached.
+ */
+class Rom::Buffer : Genode::Noncopyable
+{
+	private:
+
+		Attached_ram_dataspace _ds;
+
+		unsigned _refs = 0;
+
+		Buffer(size_t size) : _ds(Genode::env()->ram_session(), size) { }
+
+	public:
+
+		/**
+		 * Allocate buffer, which is referenced by the caller
+		 */
+		static Buffer *create(size_t size) {
+			return acquire(new (Genode::env()->heap()) Buffer(size)); }
+
+		/**
+		 * Obtain reference to buffer
+		 */
+		static Buffer *acquire(Buffer *buffer)
+		{
+			if (buffer)
+				buffer->_refs++;
+			return buffer;
+		}
+
+		/**
+		 * Drop reference to buffer, destroy buffer if unreferenced
+		 */
+		static void release(Buffer *buffer)
+		{
+			if (buffer && --buffer->_refs == 0)
+				Genode::destroy(Genode::env()->heap(), buffer);
+		}
+
+		char *local_addr() const { return _ds.local_addr<char>(); }
+		size_t size()      const { return _ds.size(); }
+
+		Genode::Ram_dataspace_capability cap() const { return _ds.cap(); }
+};
+
+
 struct Rom::Writer : Writer_list::Element
 {
 	virtual Genode::Session_label label() const = 0;
@@ -57,6 +110,11 @@ struct Rom::Readable_module
 	 */
 	class Buffer_too_small { };
 
+	/**
+	 * Generation counter of the module content
+	 */
+	typedef unsigned long Version;
+
 	/**
 	 * Read content of ROM module
 	 *
@@ -68,6 +126,23 @@ struct Rom::Readable_module
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Return buffer that holds the content as handed over by the writer
+	 *
+	 * \return  buffer to be passed to the reader without copying, or 0 if
+	 *          the content must be obtained via 'read_content'
+	 */
+	virtual Buffer *shared_buffer(Reader const &reader) const = 0;
+
+	/**
+	 * Return version of the module content
+	 *
+	 * The version is incremented each time the content changes. Readers
+	 * that already obtained the content of the current version do not
+	 * need to read it again.
+	 */
+	virtual Version version() const = 0;
 };
 
 
@@ -142,6 +217,30 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 */
 		size_t _size = 0;
 
+		/**
+		 * Content handed over by the writer, superseding '_ds'
+		 */
+		Buffer *_shared = nullptr;
+
+		Version _version = 0;
+
+		void _notify_readers()
+		{
+			for (Reader *r = _readers.first(); r; r = r->next()) {
+
+				if (_read_policy.read_permitted(*this, *_last_writer, *r))
+					r->notify_module_changed();
+				else
+					r->notify_module_invalidated();
+			}
+		}
+
+		void _release_shared()
+		{
+			Buffer::release(_shared);
+			_shared = nullptr;
+		}
+
 
 		/********************************
 		 ** Interface used by registry **
@@ -194,9 +293,13 @@ struct Rom::Module : Module_list::Element, Readable_module
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::memset(_ds->local_addr<char>(), 0, _size);
+				if (_shared)
+					_release_shared();
+				else
+					Genode::memset(_ds->local_addr<char>(), 0, _size);
 				_size = 0;
 				_last_writer = nullptr;
+				_version++;
 			}
 		}
 
@@ -228,7 +331,22 @@ struct Rom::Module : Module_list::Element, Readable_module
 			if (!_write_policy.write_permitted(*this, writer))
 				return;
 
+			/*
+			 * Suppress reports that do not change the content. Many
+			 * reporters send their state periodically or on each event
+			 * regardless of whether it changed. Notifying the readers in
+			 * this case would prompt them to re-obtain and re-parse the
+			 * unchanged content.
+			 */
+			if (!_shared && _last_writer == &writer && _size == src_len
+			 && _ds.is_constructed()
+			 && Genode::memcmp(_ds->local_addr<char>(), src, src_len) == 0)
+				return;
+
+			_release_shared();
+
 			_size = 0;
+			_version++;
 
 			_last_writer = &writer;
 
@@ -250,13 +368,34 @@ struct Rom::Module : Module_list::Element, Readable_module
 			_ds->local_addr<char>()[src_len] = 0;
 
 			/* notify ROM clients that access the module */
-			for (Reader *r = _readers.first(); r; r = r->next()) {
+			_notify_readers();
+		}
 
-				if (_read_policy.read_permitted(*this, *_last_writer, *r))
-					r->notify_module_changed();
-				else
-					r->notify_module_invalidated();
-			}
+		/**
+		 * Assign buffer as new content of the ROM module without copying
+		 *
+		 * Called by report service when a report is handed over. The buffer
+		 * must contain a zero termination behind the 'len' bytes of content.
+		 *
+		 * \return  true if the module took a reference to the buffer
+		 */
+		bool hand_over_content(Writer const &writer, Buffer &buffer, size_t const len)
+		{
+			if (!_write_policy.write_permitted(*this, writer))
+				return false;
+
+			_release_shared();
+
+			/* free the backing store of the former copied content */
+			_ds.destruct();
+
+			_shared      = Buffer::acquire(&buffer);
+			_size        = len;
+			_last_writer = &writer;
+			_version++;
+
+			_notify_readers();
+			return true;
 		}
 
 		/**
@@ -264,7 +403,7 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.is_constructed() || !_last_writer)
+			if ((!_shared && !_ds.is_constructed()) || !_last_writer)
 				return 0;
 
 			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
@@ -273,12 +412,24 @@ struct Rom::Module : Module_list::Element, Readable_module
 			if (dst_len < _size)
 				throw Buffer_too_small();
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
+			Genode::memcpy(dst, _shared ? _shared->local_addr()
+			                            : _ds->local_addr<char>(), _size);
 			return _size;
 		}
 
+		Buffer *shared_buffer(Reader const &reader) const override
+		{
+			if (!_shared || !_last_writer
+			 || !_read_policy.read_permitted(*this, *_last_writer, reader))
+				return nullptr;
+
+			return _shared;
+		}
+
 		virtual size_t size() const override { return _size; }
 
+		Version version() const override { return _version; }
+
 		Name name() const { return _name; }
 };
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -60,8 +60,42 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		 */
 		bool _valid = false;
 
+		/**
+		 * Version of the module content currently present in '_ds'
+		 */
+		Readable_module::Version _version = 0;
+
+		/**
+		 * Handed-over module content passed to the client, superseding '_ds'
+		 */
+		Buffer *_shared = nullptr;
+
 		Genode::Signal_context_capability _sigh;
 
+		/**
+		 * Import module content into '_ds'
+		 */
+		void _read_content()
+		{
+			/* skip copy if the dataspace already holds the current content */
+			if (_valid && _version == _module.version())
+				return;
+
+			_version = _module.version();
+
+			size_t const new_content_size =
+				_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
+
+			/* clear difference between old and new content */
+			if (new_content_size < _content_size)
+				Genode::memset(_ds->local_addr<char>() + new_content_size, 0,
+				               _content_size - new_content_size);
+
+			_content_size = new_content_size;
+
+			_valid = _content_size > 0;
+		}
+
 		void _notify_client()
 		{
 			if (_sigh.valid())
@@ -78,6 +112,7 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		~Session_component()
 		{
+			Buffer::release(_shared);
 			_registry.release(*this, _module);
 		}
 
@@ -87,15 +122,29 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
-				/* replace dataspace by new one */
-				/* XXX we could keep the old dataspace if the size fits */
-				_ds.construct(env()->ram_session(), _module.size());
+				/* pass handed-over content to the client without copying */
+				Buffer * const shared = Buffer::acquire(_module.shared_buffer(*this));
 
-				/* fill dataspace content with report contained in module */
-				_content_size =
-					_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
+				Buffer::release(_shared);
+				_shared = shared;
+
+				if (_shared) {
+					_version = _module.version();
+					_valid   = true;
+
+					Dataspace_capability ds_cap = static_cap_cast<Dataspace>(_shared->cap());
+					return static_cap_cast<Rom_dataspace>(ds_cap);
+				}
 
-				_valid = _content_size > 0;
+				/* replace dataspace by new one if the content does not fit */
+				if (!_ds.is_constructed() || _module.size() > _ds->size()) {
+					_ds.construct(env()->ram_session(), _module.size());
+					_content_size = 0;
+					_valid        = false;
+				}
+
+				/* fill dataspace content with report contained in module */
+				_read_content();
 
 				/* cast RAM into ROM dataspace capability */
 				Dataspace_capability ds_cap = static_cap_cast<Dataspace>(_ds->cap());
@@ -104,21 +153,15 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		bool update() override
 		{
+			/* a handed-over buffer is never modified but replaced */
+			Buffer * const shared = _module.shared_buffer(*this);
+			if (_shared || shared)
+				return _shared == shared;
+
 			if (!_ds.is_constructed() || _module.size() > _ds->size())
 				return false;
 
-			size_t const new_content_size =
-				_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
-
-			/* clear difference between old and new content */
-			if (new_content_size < _content_size)
-				Genode::memset(_ds->local_addr<char>() + new_content_size, 0,
-				               _content_size - new_content_size);
-
-			_content_size = new_content_size;
-
-			_valid = _content_size > 0;
-
+			_read_content();
 			return true;
 		}
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -32,6 +32,9 @@ struct Report::Session_client : Genode::Rpc_client<Session>
 	void submit(size_t length) override {
 		call<Rpc_submit>(length); }
 
+	Dataspace_capability submit_handover(size_t length) override {
+		return call<Rpc_submit_handover>(length); }
+
 	void response_sigh(Signal_context_capability cap) override {
 		call<Rpc_response_sigh>(cap); }
 
@@ -22,7 +22,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -66,6 +66,23 @@ struct Report::Session : Genode::Session
 	 */
 	virtual void submit(size_t length) = 0;
 
+	/**
+	 * Submit report and hand over the dataspace to the recipients
+	 *
+	 * \param length  length of report in bytes
+	 *
+	 * \return  dataspace to be used for the next report
+	 *
+	 * In contrast to 'submit', the server may pass the dataspace to the
+	 * recipients of the report without copying its content. In this case,
+	 * the returned dataspace differs from the former one. The client must
+	 * not access the former dataspace anymore and must write subsequent
+	 * reports to the returned dataspace. A server that does not support
+	 * the hand over treats the report like 'submit' and returns the
+	 * dataspace of the session.
+	 */
+	virtual Dataspace_capability submit_handover(size_t length) = 0;
+
 	/**
 	 * Install signal handler for response notifications
 	 */
@@ -88,10 +105,11 @@ struct Report::Session : Genode::Session
 
 	GENODE_RPC(Rpc_dataspace, Dataspace_capability, dataspace);
 	GENODE_RPC(Rpc_submit, void, submit, size_t);
+	GENODE_RPC(Rpc_submit_handover, Dataspace_capability, submit_handover, size_t);
 	GENODE_RPC(Rpc_response_sigh, void, response_sigh, Signal_context_capability);
 	GENODE_RPC(Rpc_obtain_response, size_t, obtain_response);
-	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_submit, Rpc_response_sigh,
-	                     Rpc_obtain_response);
+	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_submit, Rpc_submit_handover,
+	                     Rpc_response_sigh, Rpc_obtain_response);
 };
 
 #endif /* _INCLUDE__REPORT_SESSION__REPORT_SESSION_H_ */
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2008-2013 Genode Labs GmbH
+ * Copyright (C) 2008-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -48,6 +48,9 @@ struct Platform::Device_client : public Genode::Rpc_client<Device>
 	void config_write(unsigned char address, unsigned value, Access_size size) override {
 		call<Rpc_config_write>(address, value, size); }
 
+	Config_block config_read_block(unsigned char address) override {
+		return call<Rpc_config_read_block>(address); }
+
 	Genode::Irq_session_capability irq(Genode::uint8_t id) override {
 		return call<Rpc_irq>(id); }
 
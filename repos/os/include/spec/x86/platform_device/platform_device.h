@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2008-2013 Genode Labs GmbH
+ * Copyright (C) 2008-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -165,6 +165,44 @@ struct Platform::Device : Platform::Abstract_device
 	virtual void config_write(unsigned char address, unsigned value,
 	                          Access_size size) = 0;
 
+	/**
+	 * Naturally aligned block of the configuration space
+	 */
+	struct Config_block
+	{
+		enum { SIZE = 64 };
+
+		Genode::uint32_t dwords[SIZE/4];
+
+		/**
+		 * Return value of register within the block
+		 *
+		 * \param address  config-space address of the register, only the
+		 *                 offset within the block is significant
+		 */
+		unsigned value(unsigned char address, Access_size size) const
+		{
+			unsigned const dword = dwords[(address % SIZE) / 4];
+			unsigned const shift = (address & 3) * 8;
+
+			switch (size) {
+			case ACCESS_8BIT:  return (dword >> shift) & 0xff;
+			case ACCESS_16BIT: return (dword >> (shift & 16)) & 0xffff;
+			default:           return dword;
+			}
+		}
+	};
+
+	/**
+	 * Read block of the configuration space at once
+	 *
+	 * \param address  address within the block
+	 *
+	 * This method is meant for drivers that inspect many registers, e.g.,
+	 * when walking the capability list, to avoid an RPC per register.
+	 */
+	virtual Config_block config_read_block(unsigned char address) = 0;
+
 	/**
 	 * Query Io_port of specified bar
 	 *
@@ -237,6 +275,8 @@ struct Platform::Device : Platform::Abstract_device
 	GENODE_RPC_THROW(Rpc_config_write, void, config_write,
 	                 GENODE_TYPE_LIST(Quota_exceeded),
 	                 unsigned char, unsigned, Access_size);
+	GENODE_RPC(Rpc_config_read_block, Config_block, config_read_block,
+	           unsigned char);
 	GENODE_RPC(Rpc_irq, Genode::Irq_session_capability, irq, Genode::uint8_t);
 	GENODE_RPC_THROW(Rpc_io_port, Genode::Io_port_session_capability, io_port,
 	                 GENODE_TYPE_LIST(Quota_exceeded),
@@ -253,9 +293,10 @@ struct Platform::Device : Platform::Abstract_device
 	        Genode::Meta::Type_tuple<Rpc_resource,
 	        Genode::Meta::Type_tuple<Rpc_config_read,
 	        Genode::Meta::Type_tuple<Rpc_config_write,
+	        Genode::Meta::Type_tuple<Rpc_config_read_block,
 	        Genode::Meta::Type_tuple<Rpc_irq,
 	        Genode::Meta::Type_tuple<Rpc_io_port,
 	        Genode::Meta::Type_tuple<Rpc_io_mem,
 	                                 Genode::Meta::Empty>
-	        > > > > > > > > > Rpc_functions;
+	        > > > > > > > > > > Rpc_functions;
 };
@@ -28,6 +28,22 @@
 template <typename CELL>
 class Cell_array
 {
+	public:
+
+		/**
+		 * Scrolling of a region not yet applied to the displayed content
+		 *
+		 * Consecutive scroll operations of the same region accumulate to a
+		 * shift of the region by 'lines', which is positive for upward
+		 * shifts.
+		 */
+		struct Scroll
+		{
+			int start = 0, end = -1, lines = 0;
+
+			bool pending() const { return lines != 0; }
+		};
+
 	private:
 
 		unsigned           _num_cols;
@@ -35,6 +51,8 @@ class Cell_array
 		Genode::Allocator *_alloc;
 		CELL             **_array;
 		bool              *_line_dirty;
+		bool               _track_scroll = false;
+		Scroll             _scroll;
 
 		typedef CELL *Char_cell_line;
 
@@ -67,7 +85,34 @@ class Cell_array
 
 			_array[up ? end: start] = yanked_line;
 
-			_mark_lines_as_dirty(start, end);
+			if (!_track_scroll) {
+				_mark_lines_as_dirty(start, end);
+				return;
+			}
+
+			/*
+			 * A pending shift of another region cannot be combined with
+			 * the new one, leave it to a redraw of the region.
+			 */
+			if (_scroll.pending() && (_scroll.start != start || _scroll.end != end)) {
+				_mark_lines_as_dirty(_scroll.start, _scroll.end);
+				_scroll = Scroll();
+			}
+
+			_scroll.start  = start;
+			_scroll.end    = end;
+			_scroll.lines += up ? 1 : -1;
+
+			/* the dirty state moves along with the lines */
+			if (up) {
+				for (int line = start; line <= end - 1; line++)
+					_line_dirty[line] = _line_dirty[line + 1];
+			} else {
+				for (int line = end; line >= start + 1; line--)
+					_line_dirty[line] = _line_dirty[line - 1];
+			}
+
+			_line_dirty[up ? end : start] = true;
 		}
 
 	public:
@@ -124,6 +169,21 @@ class Cell_array
 			_scroll_vertically(region_start, region_end, false);
 		}
 
+		/**
+		 * Enable the tracking of scroll operations
+		 *
+		 * By default, scrolling marks all lines of the scroll region as
+		 * dirty. With tracking enabled, only the lines revealed by the
+		 * scrolling become dirty. The user of the cell array must then
+		 * apply the 'pending_scroll' to the displayed content before
+		 * updating the dirty lines.
+		 */
+		void track_scroll(bool enabled) { _track_scroll = enabled; }
+
+		Scroll pending_scroll() const { return _scroll; }
+
+		void mark_scroll_as_applied() { _scroll = Scroll(); }
+
 		void clear(int region_start, int region_end)
 		{
 			for (int line = region_start; line <= region_end; line++)
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -19,9 +19,12 @@
 #include <util/string.h>
 #include <base/lock.h>
 #include <base/rpc_client.h>
+#include <base/signal.h>
+#include <util/volatile_object.h>
 #include <os/attached_dataspace.h>
 
 #include <terminal_session/terminal_session.h>
+#include <terminal_session/ring.h>
 
 namespace Terminal { class Session_client; }
 
@@ -38,13 +41,59 @@ class Terminal::Session_client : public Genode::Rpc_client<Session>
 		 */
 		Genode::Attached_dataspace _io_buffer;
 
+		/**
+		 * Ring for the write direction, used if supported by the server
+		 */
+		struct Write_ring
+		{
+			Genode::Attached_dataspace        ds;
+			Ring                              ring { ds.local_addr<void>(), ds.size() };
+			Genode::Signal_receiver           sig_rec;
+			Genode::Signal_context            space_avail;
+			Genode::Signal_context_capability data_avail;
+
+			Write_ring(Genode::Dataspace_capability ds_cap) : ds(ds_cap) { }
+
+			~Write_ring() { sig_rec.dissolve(&space_avail); }
+
+			Genode::size_t write(char const *src, Genode::size_t num_bytes)
+			{
+				for (Genode::size_t written_bytes = 0; written_bytes < num_bytes; ) {
+
+					bool was_empty = false;
+					Genode::size_t const n = ring.write(src + written_bytes,
+					                                    num_bytes - written_bytes,
+					                                    was_empty);
+					if (was_empty)
+						Genode::Signal_transmitter(data_avail).submit();
+
+					written_bytes += n;
+
+					/* block until the server frees space in the full ring */
+					if (!n && ring.wait_for_space())
+						sig_rec.wait_for_signal();
+				}
+				return num_bytes;
+			}
+		};
+
+		Genode::Lazy_volatile_object<Write_ring> _write_ring;
+
 	public:
 
 		Session_client(Genode::Capability<Session> cap)
 		:
 			Genode::Rpc_client<Session>(cap),
 			_io_buffer(call<Rpc_dataspace>())
-		{ }
+		{
+			Genode::Dataspace_capability const ring_ds = call<Rpc_write_ring>();
+			if (!ring_ds.valid())
+				return;
+
+			_write_ring.construct(ring_ds);
+			_write_ring->data_avail = call<Rpc_write_ring_sigh>(
+				_write_ring->sig_rec.manage(&_write_ring->space_avail));
+		}
 
 		Size size() { return call<Rpc_size>(); }
 
@@ -68,6 +117,9 @@ class Terminal::Session_client : public Genode::Rpc_client<Session>
 		{
 			Genode::Lock::Guard _guard(_lock);
 
+			if (_write_ring.is_constructed())
+				return _write_ring->write((char const *)buf, num_bytes);
+
 			Genode::size_t     written_bytes = 0;
 			char const * const src           = (char const *)buf;
 
@@ -0,0 +1,176 @@
+/*
+ * \brief  Ring buffer for the write direction of a terminal session
+ * \author Norman Feske
+ * \date   2015-12-30
+ *
+ * The ring is located in a dataspace shared between the terminal client
+ * (producer) and the terminal server (consumer). Both sides notify each
+ * other only if the ring was empty before the producer added characters or
+ * if the producer waits for the ring to become non-full.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__TERMINAL_SESSION__RING_H_
+#define _INCLUDE__TERMINAL_SESSION__RING_H_
+
+/* Genode includes */
+#include <util/misc_math.h>
+#include <util/string.h>
+
+namespace Terminal { class Ring; }
+
+
+/**
+ * Single-producer single-consumer character ring
+ *
+ * In contrast to 'Genode::Ring_buffer', which is meant for the use within
+ * one component, the ring keeps its state in the shared memory only. The
+ * head and tail are free-running counters, the difference of which is the
+ * number of characters within the ring. Because the counters are
+ * controlled by the respective other party, they are sanitized on each use.
+ */
+class Terminal::Ring
+{
+	private:
+
+		typedef Genode::size_t size_t;
+
+		struct Header
+		{
+			unsigned long volatile head;            /* written by producer */
+			unsigned long volatile tail;            /* written by consumer */
+			unsigned      volatile writer_waiting;  /* set by producer,
+			                                           cleared by consumer */
+		};
+
+		Header * const _header;
+		char   * const _data;
+		size_t   const _size;
+
+		/*
+		 * The notification protocol relies on each side observing the
+		 * update of the other side after publishing its own update. This
+		 * requires a full barrier that also orders stores before loads.
+		 */
+		static void _full_barrier() { __sync_synchronize(); }
+
+		size_t _used(unsigned long head, unsigned long tail) const {
+			return Genode::min((size_t)(head - tail), _size); }
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param base     local address of the shared dataspace
+		 * \param ds_size  size of the dataspace
+		 *
+		 * The dataspace is expected to be zero-initialized.
+		 */
+		Ring(void *base, size_t ds_size)
+		:
+			_header((Header *)base),
+			_data((char *)base + sizeof(Header)),
+			_size(ds_size - sizeof(Header))
+		{ }
+
+		/**
+		 * Add characters to the ring (producer)
+		 *
+		 * \param was_empty  set to true if the ring was empty before, which
+		 *                   calls for notifying the consumer
+		 * \return           number of added characters, 0 if the ring is
+		 *                   full
+		 */
+		size_t write(char const *src, size_t num_bytes, bool &was_empty)
+		{
+			unsigned long const head = _header->head;
+			size_t        const n    = Genode::min(num_bytes,
+			                                       _size - _used(head, _header->tail));
+
+			for (size_t copied = 0; copied < n; ) {
+				size_t const pos   = (head + copied) % _size;
+				size_t const chunk = Genode::min(n - copied, _size - pos);
+
+				Genode::memcpy(_data + pos, src + copied, chunk);
+				copied += chunk;
+			}
+
+			_full_barrier();
+			_header->head = head + n;
+			_full_barrier();
+
+			was_empty = n && _header->tail == head;
+			return n;
+		}
+
+		/**
+		 * Announce that the producer waits for free space (producer)
+		 *
+		 * \return  true if the ring is still full, i.e., the producer has
+		 *          to wait for the notification by the consumer
+		 */
+		bool wait_for_space()
+		{
+			_header->writer_waiting = 1;
+			_full_barrier();
+
+			if (_used(_header->head, _header->tail) < _size) {
+				_header->writer_waiting = 0;
+				return false;
+			}
+			return true;
+		}
+
+		/**
+		 * Remove characters from the ring (consumer)
+		 *
+		 * \param fn  functor called with a pointer to and the number of
+		 *            available characters, returns the number of consumed
+		 *            characters
+		 *
+		 * The functor may be called multiple times. Its return value of 0
+		 * stops the operation.
+		 *
+		 * \return  true if the producer waits for free space, which calls
+		 *          for notifying the producer
+		 */
+		template <typename FN>
+		bool consume(FN const &fn)
+		{
+			for (;;) {
+				unsigned long const tail = _header->tail;
+				size_t        const used = _used(_header->head, tail);
+
+				if (!used)
+					break;
+
+				_full_barrier();
+
+				size_t const pos      = tail % _size;
+				size_t const chunk    = Genode::min(used, _size - pos);
+				size_t const consumed = Genode::min(fn(_data + pos, chunk), chunk);
+
+				if (!consumed)
+					break;
+
+				_full_barrier();
+				_header->tail = tail + consumed;
+				_full_barrier();
+			}
+
+			if (!_header->writer_waiting)
+				return false;
+
+			_header->writer_waiting = 0;
+			return true;
+		}
+};
+
+#endif /* _INCLUDE__TERMINAL_SESSION__RING_H_ */
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -83,6 +83,26 @@ struct Terminal::Session : Genode::Session
 	 */
 	virtual void read_avail_sigh(Genode::Signal_context_capability cap) = 0;
 
+	/**
+	 * Return dataspace of the ring used for the write direction
+	 *
+	 * The dataspace is laid out as 'Terminal::Ring'. Servers that do not
+	 * support the ring return an invalid capability. In this case, the
+	 * client transfers the characters via the I/O buffer and 'write' RPCs.
+	 */
+	virtual Genode::Dataspace_capability _write_ring() {
+		return Genode::Dataspace_capability(); }
+
+	/**
+	 * Register signal handler to be informed about free space in the ring
+	 *
+	 * \return  signal context to be notified by the client whenever it
+	 *          adds characters to the empty ring
+	 */
+	virtual Genode::Signal_context_capability
+	_write_ring_sigh(Genode::Signal_context_capability) {
+		return Genode::Signal_context_capability(); }
+
 
 	/*******************
 	 ** RPC interface **
@@ -95,10 +115,13 @@ struct Terminal::Session : Genode::Session
 	GENODE_RPC(Rpc_connected_sigh, void, connected_sigh, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_read_avail_sigh, void, read_avail_sigh, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_dataspace, Genode::Dataspace_capability, _dataspace);
+	GENODE_RPC(Rpc_write_ring, Genode::Dataspace_capability, _write_ring);
+	GENODE_RPC(Rpc_write_ring_sigh, Genode::Signal_context_capability,
+	           _write_ring_sigh, Genode::Signal_context_capability);
 
 	GENODE_RPC_INTERFACE(Rpc_size, Rpc_avail, Rpc_read, Rpc_write,
 	                     Rpc_connected_sigh, Rpc_read_avail_sigh,
-	                     Rpc_dataspace);
+	                     Rpc_dataspace, Rpc_write_ring, Rpc_write_ring_sigh);
 };
 
 #endif /* _INCLUDE__TERMINAL_SESSION__TERMINAL_SESSION_H_ */
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2006-2013 Genode Labs GmbH
+ * Copyright (C) 2006-2015 Genode Labs GmbH
  * Copyright (C) 2012 Intel Corporation
  *
  * This file is part of the Genode OS framework, which is distributed
@@ -34,6 +34,8 @@ struct Timer::Session_client : Genode::Rpc_client<Session>
 	void sigh(Signal_context_capability sigh) override { call<Rpc_sigh>(sigh); }
 
 	unsigned long elapsed_ms() const override { return call<Rpc_elapsed_ms>(); }
+
+	unsigned long elapsed_us() const override { return call<Rpc_elapsed_us>(); }
 };
 
 #endif /* _INCLUDE__TIMER_SESSION__CLIENT_H_ */
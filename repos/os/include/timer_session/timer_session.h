@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2006-2013 Genode Labs GmbH
+ * Copyright (C) 2006-2015 Genode Labs GmbH
  * Copyright (C) 2012 Intel Corporation
  *
  * This file is part of the Genode OS framework, which is distributed
@@ -53,6 +53,15 @@ struct Timer::Session : Genode::Session
 	 */
 	virtual unsigned long elapsed_ms() const = 0;
 
+	/**
+	 * Return number of elapsed microseconds since session creation
+	 *
+	 * The resolution is the one of the platform timer, which is below
+	 * one millisecond on most platforms. The value wraps after 71 minutes
+	 * on 32-bit machines.
+	 */
+	virtual unsigned long elapsed_us() const = 0;
+
 	/**
 	 * Client-side convenience method for sleeping the specified number
 	 * of milliseconds
@@ -74,9 +83,10 @@ struct Timer::Session : Genode::Session
 	GENODE_RPC(Rpc_trigger_periodic, void, trigger_periodic, unsigned);
 	GENODE_RPC(Rpc_sigh, void, sigh, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_elapsed_ms, unsigned long, elapsed_ms);
+	GENODE_RPC(Rpc_elapsed_us, unsigned long, elapsed_us);
 
 	GENODE_RPC_INTERFACE(Rpc_trigger_once, Rpc_trigger_periodic,
-	                     Rpc_sigh, Rpc_elapsed_ms);
+	                     Rpc_sigh, Rpc_elapsed_ms, Rpc_elapsed_us);
 };
 
 #endif /* _INCLUDE__TIMER_SESSION__TIMER_SESSION_H_ */
@@ -0,0 +1,72 @@
+/*
+ * \brief  Binary layout of trace events
+ * \author Norman Feske
+ * \date   2015-12-18
+ *
+ * This layout is produced by the 'binary' trace policy. Each trace-buffer
+ * entry holds exactly one event, which consists of a fixed-size header
+ * followed by an optional RPC name. In contrast to textual policies,
+ * events can be written without formatting and carry a timestamp that
+ * allows for correlating events of different threads and components.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__TRACE__BINARY_EVENT_H_
+#define _INCLUDE__TRACE__BINARY_EVENT_H_
+
+#include <base/fixed_stdint.h>
+
+namespace Genode { namespace Trace { struct Binary_event; } }
+
+
+struct Genode::Trace::Binary_event
+{
+	enum Type {
+		INVALID, RPC_CALL, RPC_RETURNED, RPC_DISPATCH, RPC_REPLY,
+		SIGNAL_SUBMIT, SIGNAL_RECEIVED
+	};
+
+	enum { MAX_NAME_LEN = 48 };
+
+	/**
+	 * Value of the CPU-local cycle counter when the event occurred
+	 *
+	 * The counter is read via 'Trace::timestamp', i.e., from the TSC on
+	 * x86 and from the cycle counter of the performance-monitoring unit
+	 * on ARM. On ARM, only the lower 32 bits are valid.
+	 */
+	uint64_t timestamp;
+
+	uint8_t  type;      /* one of 'Type' */
+	uint8_t  name_len;  /* number of characters following the header */
+	uint16_t reserved;
+
+	/**
+	 * Number of signals for signal events, zero otherwise
+	 */
+	uint32_t value;
+
+	char name[0];
+
+	/**
+	 * Return size of an event with a name of 'name_len' characters
+	 */
+	static unsigned long size(unsigned name_len) {
+		return sizeof(Binary_event) + name_len; }
+
+	/**
+	 * Return true if an entry of 'len' bytes holds a complete event
+	 */
+	bool valid(unsigned long len) const {
+		return len >= sizeof(Binary_event) && len >= size(name_len)
+		    && type != INVALID; }
+
+} __attribute__((packed));
+
+#endif /* _INCLUDE__TRACE__BINARY_EVENT_H_ */
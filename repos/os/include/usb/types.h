@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -28,6 +28,7 @@ namespace Usb {
 namespace Usb {
 
 	enum Endpoint_type {
+		ENDPOINT_ISOC      = 0x1,
 		ENDPOINT_BULK      = 0x2,
 		ENDPOINT_INTERRUPT = 0x3,
 	};
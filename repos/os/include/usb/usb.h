@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -94,6 +94,7 @@ class Usb::Endpoint : public Endpoint_descriptor
 
 		bool is_bulk()      const { return (attributes & 0x3) == ENDPOINT_BULK;      }
 		bool is_interrupt() const { return (attributes & 0x3) == ENDPOINT_INTERRUPT; }
+		bool is_isoc()      const { return (attributes & 0x3) == ENDPOINT_ISOC;      }
 
 		void dump()
 		{
@@ -340,6 +341,32 @@ class Usb::Interface : public Meta_data
 			if(block) Sync_completion sync(_handler, p);
 			else _handler.submit(p);
 		}
+
+		/**
+		 * Isochronous transfer
+		 *
+		 * The packet content must be laid out as described at
+		 * 'Isoc_frame', with the 'length' of each frame set.
+		 */
+		void isoc_transfer(Packet_descriptor &p, Endpoint &ep,
+		                   unsigned number_of_packets,
+		                   bool block = true, Completion *c = nullptr)
+		{
+			_check();
+
+			if (!ep.is_isoc())
+				throw Session::Invalid_endpoint();
+
+			p.type                       = Usb::Packet_descriptor::ISOC;
+			p.succeded                   = false;
+			p.transfer.ep                = ep.address;
+			p.transfer.timeout           = 0;
+			p.transfer.number_of_packets = number_of_packets;
+			p.completion                 = c;
+
+			if(block) Sync_completion sync(_handler, p);
+			else _handler.submit(p);
+		}
 };
 
 
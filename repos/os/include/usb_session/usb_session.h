@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -24,6 +24,7 @@ namespace Usb {
 	using namespace Genode;
 	class Session;
 	struct Packet_descriptor;
+	struct Isoc_frame;
 	struct Completion;
 }
 
@@ -33,7 +34,7 @@ namespace Usb {
  */
 struct Usb::Packet_descriptor : Genode::Packet_descriptor
 {
-	enum Type { STRING, CTRL, BULK, IRQ, ALT_SETTING, CONFIG, RELEASE_IF };
+	enum Type { STRING, CTRL, BULK, IRQ, ALT_SETTING, CONFIG, RELEASE_IF, ISOC };
 
 	Type        type;
 	bool        succeded   = false;
@@ -62,6 +63,9 @@ struct Usb::Packet_descriptor : Genode::Packet_descriptor
 			uint8_t ep;
 			int     actual_size; /* returned */
 			int     timeout;
+
+			/* number of frames of an 'ISOC' transfer */
+			unsigned number_of_packets;
 		} transfer;
 
 		struct
@@ -86,6 +90,25 @@ struct Usb::Packet_descriptor : Genode::Packet_descriptor
 };
 
 
+/**
+ * Frame of an isochronous transfer
+ *
+ * The content of an 'ISOC' packet starts with an array of
+ * 'transfer.number_of_packets' frames, followed by the data of all frames
+ * in a row. Hence, a whole stream of frames is transferred with a single
+ * packet and a single URB.
+ */
+struct Usb::Isoc_frame
+{
+	uint32_t length;         /* requested length */
+	uint32_t actual_length;  /* returned */
+	int32_t  status;         /* returned */
+
+	static size_t header_size(unsigned number_of_packets) {
+		return number_of_packets * sizeof(Isoc_frame); }
+};
+
+
 /**
  * Completion for asynchronous communication
  */
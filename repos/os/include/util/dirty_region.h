@@ -0,0 +1,168 @@
+/*
+ * \brief  Utility for tracking dirty areas as set of disjoint rectangles
+ * \author Norman Feske
+ * \date   2015-12-16
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__UTIL__DIRTY_REGION_H_
+#define _INCLUDE__UTIL__DIRTY_REGION_H_
+
+#include <base/stdint.h>
+
+namespace Genode { template <typename, unsigned> class Dirty_region; }
+
+
+/**
+ * Dirty-area tracker that represents the dirty area precisely
+ *
+ * \param RECT       rectangle type (as defined in 'util/geometry.h')
+ * \param MAX_RECTS  maximum number of rectangles used to represent the
+ *                   dirty area
+ *
+ * In contrast to 'Dirty_rect', which merges all dirty areas into a few
+ * rectangles, the dirty region keeps the dirty area as set of disjoint
+ * rectangles. Only the parts of an added rectangle not yet covered are
+ * stored, and adjacent rectangles with the same extent are joined. Several
+ * small but distant dirty areas thereby do not inflate to a large area as
+ * long as the number of rectangles suffices. Otherwise, a rectangle is
+ * merged with the existing rectangle that grows the least.
+ *
+ * The interface corresponds to the one of 'Dirty_rect'.
+ */
+template <typename RECT, unsigned MAX_RECTS>
+class Genode::Dirty_region
+{
+	private:
+
+		typedef RECT Rect;
+		typedef Genode::size_t size_t;
+
+		Rect _rects[MAX_RECTS];
+
+		static bool _contains(Rect const &r1, Rect const &r2) {
+			return r1.contains(r2.p1()) && r1.contains(r2.p2()); }
+
+		/**
+		 * Return true if 'r1' and 'r2' form a rectangle together
+		 */
+		static bool _adjacent(Rect const &r1, Rect const &r2)
+		{
+			bool const same_columns = r1.x1() == r2.x1() && r1.x2() == r2.x2();
+			bool const same_rows    = r1.y1() == r2.y1() && r1.y2() == r2.y2();
+
+			return (same_columns && (r1.y2() + 1 == r2.y1() || r2.y2() + 1 == r1.y1()))
+			    || (same_rows    && (r1.x2() + 1 == r2.x1() || r2.x2() + 1 == r1.x1()));
+		}
+
+		/**
+		 * Store rectangle that does not overlap any stored rectangle
+		 */
+		void _store(Rect const &added)
+		{
+			for (unsigned i = 0; i < MAX_RECTS; i++) {
+				if (_rects[i].valid() && _adjacent(_rects[i], added)) {
+					_rects[i] = Rect::compound(_rects[i], added);
+					return;
+				}
+			}
+
+			for (unsigned i = 0; i < MAX_RECTS; i++) {
+				if (!_rects[i].valid()) {
+					_rects[i] = added;
+					return;
+				}
+			}
+
+			/* no rectangle left, expand the one with the lowest costs */
+			unsigned best          = 0;
+			size_t   lowest_costs  = ~0;
+
+			for (unsigned i = 0; i < MAX_RECTS; i++) {
+
+				size_t const costs = Rect::compound(_rects[i], added).area().count()
+				                   - _rects[i].area().count();
+
+				if (costs < lowest_costs) {
+					best         = i;
+					lowest_costs = costs;
+				}
+			}
+			_rects[best] = Rect::compound(_rects[best], added);
+		}
+
+		/**
+		 * Add the parts of 'added' not covered by the rectangles from 'i' on
+		 */
+		void _add(Rect const &added, unsigned i)
+		{
+			for (; i < MAX_RECTS; i++) {
+
+				if (!_rects[i].valid())
+					continue;
+
+				Rect const overlap = Rect::intersect(_rects[i], added);
+				if (!overlap.valid())
+					continue;
+
+				Rect top, left, right, bottom;
+				added.cut(overlap, &top, &left, &right, &bottom);
+
+				if (top.valid())    _add(top,    i + 1);
+				if (left.valid())   _add(left,   i + 1);
+				if (right.valid())  _add(right,  i + 1);
+				if (bottom.valid()) _add(bottom, i + 1);
+				return;
+			}
+
+			_store(added);
+		}
+
+	public:
+
+		/**
+		 * Call functor for each dirty area
+		 *
+		 * The functor 'fn' takes a 'Rect const &' as argument.
+		 * This method resets the dirty region.
+		 */
+		template <typename FN>
+		void flush(FN const &fn)
+		{
+			for (unsigned i = 0; i < MAX_RECTS; i++) {
+				if (_rects[i].valid()) {
+					fn(_rects[i]);
+					_rects[i] = Rect();
+				}
+			}
+		}
+
+		void mark_as_dirty(Rect added)
+		{
+			if (!added.valid())
+				return;
+
+			/* drop rectangles covered by the added one */
+			for (unsigned i = 0; i < MAX_RECTS; i++) {
+
+				if (!_rects[i].valid())
+					continue;
+
+				if (_contains(_rects[i], added))
+					return;
+
+				if (_contains(added, _rects[i]))
+					_rects[i] = Rect();
+			}
+
+			_add(added, 0);
+		}
+};
+
+#endif /* _INCLUDE__UTIL__DIRTY_REGION_H_ */
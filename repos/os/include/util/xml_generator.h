@@ -73,14 +73,22 @@ class Genode::Xml_generator
 				/**
 				 * Append character 'n' times
 				 */
-				void append(char const c, size_t n) {
-					for (; n--; append(c)); }
+				void append(char const c, size_t n)
+				{
+					_check_advance(n);
+					memset(_dst + _used, c, n);
+					advance(n);
+				}
 
 				/**
 				 * Append character buffer
 				 */
-				void append(char const *src, size_t len) {
-					for (; len--; append(*src++)); }
+				void append(char const *src, size_t len)
+				{
+					_check_advance(len);
+					memcpy(_dst + _used, src, len);
+					advance(len);
+				}
 
 				/**
 				 * Append null-terminated string
@@ -285,6 +293,29 @@ class Genode::Xml_generator
 		Node      *_curr_node   = 0;
 		unsigned   _curr_indent = 0;
 
+	protected:
+
+		/**
+		 * Generate XML into the specified buffer
+		 *
+		 * This method allows a derived class to re-generate the XML
+		 * output into a larger buffer after the generation into the
+		 * buffer passed to the constructor failed.
+		 *
+		 * \throw Buffer_exceeded
+		 */
+		template <typename FUNC>
+		void _generate(char *dst, size_t dst_len,
+		               char const *name, FUNC const &func)
+		{
+			_out_buffer  = Out_buffer(dst, dst_len);
+			_curr_node   = 0;
+			_curr_indent = 0;
+
+			node(name, func);
+			_out_buffer.append('\n');
+		}
+
 	public:
 
 		template <typename FUNC>
@@ -293,10 +324,8 @@ class Genode::Xml_generator
 		:
 			_out_buffer(dst, dst_len)
 		{
-			if (dst) {
-				node(name, func);
-				_out_buffer.append('\n');
-			}
+			if (dst)
+				_generate(dst, dst_len, name, func);
 		}
 
 		template <typename FUNC>
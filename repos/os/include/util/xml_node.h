@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2007-2013 Genode Labs GmbH
+ * Copyright (C) 2007-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -21,6 +21,7 @@ namespace Genode {
 
 	class Xml_attribute;
 	class Xml_node;
+	class Xml_node_index;
 }
 
 
@@ -59,6 +60,8 @@ class Genode::Xml_attribute
 		 */
 		friend class Tag;
 
+		friend class Xml_node_index;
+
 		/**
 		 * Constructor
 		 *
@@ -107,7 +110,7 @@ class Genode::Xml_attribute
 		/**
 		 * Return true if attribute has specified type
 		 */
-		bool has_type(const char *type) {
+		bool has_type(const char *type) const {
 			return strlen(type) == _name.len() &&
 			       strcmp(type, _name.start(), _name.len()) == 0; }
 
@@ -192,6 +195,8 @@ class Genode::Xml_node
 		 */
 		class Tag;
 
+		friend class Xml_node_index;
+
 	public:
 
 		/*********************
@@ -260,10 +265,8 @@ class Genode::Xml_node
 					/* skip attributes to find tag delimiter */
 					Token delimiter = _name.next();
 					if (supposed_type != END)
-						try {
-							for (Xml_attribute a = _name.next(); ; a = a._next())
-								delimiter = a._next();
-						} catch (Nonexistent_attribute) { }
+						while (delimiter.eat_whitespace().type() == Token::IDENT)
+							delimiter = Xml_attribute(delimiter)._next();
 
 					delimiter = delimiter.eat_whitespace();
 
@@ -499,7 +502,7 @@ class Genode::Xml_node
 				/* skip all tokens that are no tags */
 				Tag curr_tag(curr_token);
 				if (curr_tag.type() == Tag::INVALID) {
-					curr_token = curr_token.next();
+					curr_token = _skip_text(curr_token.next());
 					continue;
 				}
 
@@ -536,6 +539,27 @@ class Genode::Xml_node
 			return Tag();
 		}
 
+		/**
+		 * Return first token at or after 't' that may start a tag
+		 *
+		 * The content between tags is skipped character-wise instead of
+		 * token by token. Because a tag can only start at a '<' character,
+		 * the tokenization resumes at the next '<'. It also resumes at a
+		 * '"' character because a quoted string is a single token, which
+		 * may contain '<' characters.
+		 */
+		Token _skip_text(Token t) const
+		{
+			char const *s = t.start();
+			if (!s)
+				return t;
+
+			size_t remaining = _max_len - (s - _addr);
+			for (; remaining && *s && *s != '<' && *s != '"'; s++, remaining--);
+
+			return Token(s, remaining);
+		}
+
 		/**
 		 * Find next non-whitespace and non-comment token
 		 */
@@ -557,6 +581,31 @@ class Genode::Xml_node
 			return t;
 		}
 
+		/**
+		 * Call 'fn' with the attribute of the specified type
+		 *
+		 * In contrast to 'attribute', this method does not throw an
+		 * exception if the attribute does not exist, which is the common
+		 * case for optional attributes.
+		 *
+		 * \throw Invalid_syntax
+		 * \return true if the attribute exists
+		 */
+		template <typename FN>
+		bool _with_attribute(char const *type, FN const &fn) const
+		{
+			Token t = _start_tag.name().next();
+			while (t.eat_whitespace().type() == Token::IDENT) {
+				Xml_attribute const a(t);
+				if (a.has_type(type)) {
+					fn(a);
+					return true;
+				}
+				t = a._next();
+			}
+			return false;
+		}
+
 		/**
 		 * Create sub node from XML node
 		 *
@@ -781,9 +830,14 @@ class Genode::Xml_node
 				/* search for sub node of specified type */
 				try {
 					Xml_node curr_node = _sub_node(content_addr());
-					for ( ; true; curr_node = curr_node.next())
+					for (int i = 0; ; curr_node = curr_node.next()) {
 						if (curr_node.has_type(type))
 							return curr_node;
+
+						/* avoid the exception of 'next' at the last sub node */
+						if (++i == _num_sub_nodes)
+							break;
+					}
 				} catch (...) { }
 			}
 
@@ -875,7 +929,10 @@ class Genode::Xml_node
 		inline T attribute_value(char const *type, T default_value) const
 		{
 			T result = default_value;
-			try { attribute(type).value(&result); } catch (...) { }
+			try {
+				_with_attribute(type, [&] (Xml_attribute const &a) {
+					a.value(&result); });
+			} catch (...) { }
 			return result;
 		}
 
@@ -884,7 +941,8 @@ class Genode::Xml_node
 		 */
 		inline bool has_attribute(char const *type) const
 		{
-			try { attribute(type); return true; } catch (...) { }
+			try { return _with_attribute(type, [] (Xml_attribute const &) { }); }
+			catch (...) { }
 			return false;
 		}
 
@@ -893,7 +951,19 @@ class Genode::Xml_node
 		 */
 		inline bool has_sub_node(char const *type) const
 		{
-			try { sub_node(type); return true; } catch (...) { }
+			if (_num_sub_nodes == 0)
+				return false;
+
+			try {
+				Xml_node curr_node = _sub_node(content_addr());
+				for (int i = 0; ; curr_node = curr_node.next()) {
+					if (curr_node.has_type(type))
+						return true;
+
+					if (++i == _num_sub_nodes)
+						break;
+				}
+			} catch (...) { }
 			return false;
 		}
 };
@@ -0,0 +1,231 @@
+/*
+ * \brief  Index of the sub nodes and attributes of an XML node
+ * \author Norman Feske
+ * \date   2015-12-29
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__UTIL__XML_NODE_INDEX_H_
+#define _INCLUDE__UTIL__XML_NODE_INDEX_H_
+
+#include <util/xml_node.h>
+#include <util/construct_at.h>
+#include <base/allocator.h>
+
+
+/**
+ * Pre-parsed view of an XML node
+ *
+ * An 'Xml_node' does not keep any state besides the location of the node.
+ * Each lookup of a sub node or an attribute re-scans the XML data. For
+ * nodes with many sub nodes that are queried repeatedly, e.g., the config
+ * of init with dozens of '<start>' nodes, the index records the location
+ * and type of each immediate sub node and each attribute once. Lookups
+ * then no longer touch the XML data of unrelated sub nodes.
+ *
+ * The index refers to the XML data of the node, which must remain
+ * unchanged during the lifetime of the index.
+ */
+class Genode::Xml_node_index
+{
+	private:
+
+		typedef Xml_attribute::Token Token;
+
+		struct Sub_node
+		{
+			char const *addr;
+			size_t      size;
+			Token       type;
+		};
+
+		Allocator &_alloc;
+
+		Xml_node const _node;
+
+		unsigned const _num_sub_nodes   = _node._num_sub_nodes;
+		unsigned const _num_attributes  = _count_attributes(_node);
+
+		Sub_node      * const _sub_nodes  = _alloc_array<Sub_node>(_num_sub_nodes);
+		Xml_attribute * const _attributes = _alloc_array<Xml_attribute>(_num_attributes);
+
+		template <typename T>
+		T *_alloc_array(unsigned n)
+		{
+			return n ? (T *)_alloc.alloc(n*sizeof(T)) : nullptr;
+		}
+
+		static unsigned _count_attributes(Xml_node const &node)
+		{
+			unsigned cnt = 0;
+			for (Token t = node._start_tag.name().next();
+			     t.eat_whitespace().type() == Token::IDENT;
+			     t = Xml_attribute(t)._next())
+				cnt++;
+
+			return cnt;
+		}
+
+		static bool _has_type(Token type, char const *name)
+		{
+			return strlen(name) == type.len()
+			    && !strcmp(name, type.start(), type.len());
+		}
+
+		Xml_node _xml_node(Sub_node const &sub_node) const
+		{
+			return Xml_node(sub_node.addr, sub_node.size);
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Xml_node_index(Xml_node_index const &);
+		Xml_node_index &operator = (Xml_node_index const &);
+
+	public:
+
+		typedef Xml_node::Nonexistent_sub_node  Nonexistent_sub_node;
+		typedef Xml_node::Nonexistent_attribute Nonexistent_attribute;
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator used for the index
+		 * \param node   XML node to index
+		 *
+		 * \throw Xml_node::Invalid_syntax
+		 */
+		Xml_node_index(Allocator &alloc, Xml_node node)
+		:
+			_alloc(alloc), _node(node)
+		{
+			unsigned i = 0;
+			_node.for_each_sub_node([&] (Xml_node const &sub_node) {
+				_sub_nodes[i++] = { sub_node.addr(), sub_node.size(),
+				                    sub_node._start_tag.name() }; });
+
+			Token t = _node._start_tag.name().next();
+			for (unsigned j = 0; j < _num_attributes; j++) {
+				construct_at<Xml_attribute>(&_attributes[j], Xml_attribute(t));
+				t = _attributes[j]._next();
+			}
+		}
+
+		~Xml_node_index()
+		{
+			if (_sub_nodes)
+				_alloc.free(_sub_nodes, _num_sub_nodes*sizeof(Sub_node));
+
+			if (_attributes)
+				_alloc.free(_attributes, _num_attributes*sizeof(Xml_attribute));
+		}
+
+		/**
+		 * Return indexed XML node
+		 */
+		Xml_node xml_node() const { return _node; }
+
+		unsigned num_sub_nodes() const { return _num_sub_nodes; }
+
+		/**
+		 * Return sub node with specified index
+		 *
+		 * \throw Nonexistent_sub_node
+		 */
+		Xml_node sub_node(unsigned idx = 0U) const
+		{
+			if (idx >= _num_sub_nodes)
+				throw Nonexistent_sub_node();
+
+			return _xml_node(_sub_nodes[idx]);
+		}
+
+		/**
+		 * Return first sub node of specified type
+		 *
+		 * \throw Nonexistent_sub_node
+		 */
+		Xml_node sub_node(char const *type) const
+		{
+			for (unsigned i = 0; i < _num_sub_nodes; i++)
+				if (_has_type(_sub_nodes[i].type, type))
+					return _xml_node(_sub_nodes[i]);
+
+			throw Nonexistent_sub_node();
+		}
+
+		bool has_sub_node(char const *type) const
+		{
+			for (unsigned i = 0; i < _num_sub_nodes; i++)
+				if (_has_type(_sub_nodes[i].type, type))
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Execute functor 'fn' for each sub node of specified type
+		 *
+		 * \param type  type of sub nodes, or nullptr for all sub nodes
+		 */
+		template <typename FN>
+		void for_each_sub_node(char const *type, FN const &fn) const
+		{
+			for (unsigned i = 0; i < _num_sub_nodes; i++)
+				if (!type || _has_type(_sub_nodes[i].type, type))
+					fn(_xml_node(_sub_nodes[i]));
+		}
+
+		template <typename FN>
+		void for_each_sub_node(FN const &fn) const
+		{
+			for_each_sub_node(nullptr, fn);
+		}
+
+		/**
+		 * Return attribute of specified type
+		 *
+		 * \throw Nonexistent_attribute
+		 */
+		Xml_attribute attribute(char const *type) const
+		{
+			for (unsigned i = 0; i < _num_attributes; i++)
+				if (_attributes[i].has_type(type))
+					return _attributes[i];
+
+			throw Nonexistent_attribute();
+		}
+
+		bool has_attribute(char const *type) const
+		{
+			for (unsigned i = 0; i < _num_attributes; i++)
+				if (_attributes[i].has_type(type))
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Read attribute value, see 'Xml_node::attribute_value'
+		 */
+		template <typename T>
+		T attribute_value(char const *type, T default_value) const
+		{
+			T result = default_value;
+			for (unsigned i = 0; i < _num_attributes; i++)
+				if (_attributes[i].has_type(type)) {
+					_attributes[i].value(&result);
+					break;
+				}
+			return result;
+		}
+};
+
+#endif /* _INCLUDE__UTIL__XML_NODE_INDEX_H_ */
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2013-2014 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -44,8 +44,10 @@ class Vfs::Block_file_system : public Single_file_system
 		 */
 		Lock _lock;
 
-		char                       *_block_buffer;
-		unsigned                    _block_buffer_count;
+		enum {
+			TX_BUF_SIZE           = 128*1024,
+			MAX_PACKETS_IN_FLIGHT = 8,
+		};
 
 		Genode::Allocator_avl       _tx_block_alloc;
 		Block::Connection           _block;
@@ -57,43 +59,148 @@ class Vfs::Block_file_system : public Single_file_system
 		bool                        _readable;
 		bool                        _writeable;
 
-		file_size _block_io(file_size nr, void *buf, file_size sz,
-		                    bool write, bool bulk = false)
+		/*
+		 * Maximum number of blocks per packet
+		 *
+		 * The packets are limited to a fraction of the packet-stream buffer
+		 * such that multiple packets can be in flight at a time.
+		 */
+		unsigned                    _block_buffer_count;
+
+		/*
+		 * Buffer for the read-modify-write of partially accessed blocks
+		 */
+		char                       *_block_buffer;
+
+		/**
+		 * Transfer consecutive blocks from or to 'buf'
+		 *
+		 * Large transfers are split into packets of at most
+		 * '_block_buffer_count' blocks, of which up to
+		 * 'MAX_PACKETS_IN_FLIGHT' are submitted before waiting for the
+		 * first acknowledgement.
+		 *
+		 * \return  true if all blocks were transferred successfully
+		 */
+		bool _block_io(Block::sector_t nr, char *buf, Block::sector_t count,
+		               bool write)
 		{
 			Lock::Guard guard(_lock);
 
 			Block::Packet_descriptor::Opcode op;
 			op = write ? Block::Packet_descriptor::WRITE : Block::Packet_descriptor::READ;
 
-			file_size packet_size  = bulk ? sz : _block_size;
-			file_size packet_count = bulk ? (sz / _block_size) : 1;
+			Block::sector_t submitted = 0;
+			unsigned        in_flight = 0;
+			bool            ok        = true;
 
-			/* sanity check */
-			if (packet_count > _block_buffer_count) {
-				packet_size  = _block_buffer_count * _block_size;
-				packet_count = _block_buffer_count;
-			}
+			while (in_flight || (ok && submitted < count)) {
+
+				while (ok && submitted < count && in_flight < MAX_PACKETS_IN_FLIGHT
+				    && _tx_source->ready_to_submit()) {
+
+					Block::sector_t const n =
+						Genode::min(count - submitted, (Block::sector_t)_block_buffer_count);
+					Genode::size_t const size = n*_block_size;
+
+					Block::Packet_descriptor p;
+					try {
+						p = Block::Packet_descriptor(_tx_source->alloc_packet(size),
+						                             op, nr + submitted, n);
+					} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+
+						/* wait for the release of an in-flight packet */
+						if (in_flight)
+							break;
+
+						PERR("could not allocate packet of %zd bytes", size);
+						ok = false;
+						break;
+					}
+
+					if (write)
+						Genode::memcpy(_tx_source->packet_content(p),
+						               buf + submitted*_block_size, size);
 
-			Block::Packet_descriptor p(_tx_source->alloc_packet(packet_size), op,
-			                           nr, packet_count);
+					_tx_source->submit_packet(p);
+					submitted += n;
+					in_flight++;
+				}
+
+				if (!in_flight)
+					break;
 
-			if (write)
-				Genode::memcpy(_tx_source->packet_content(p), buf, packet_size);
+				/* the server may acknowledge the packets in any order */
+				Block::Packet_descriptor p = _tx_source->get_acked_packet();
+				in_flight--;
 
-			_tx_source->submit_packet(p);
-			p = _tx_source->get_acked_packet();
+				if (!p.succeeded()) {
+					PERR("could not %s block(s) %llu-%llu",
+					     write ? "write" : "read", p.block_number(),
+					     p.block_number() + p.block_count() - 1);
+					ok = false;
+				}
+
+				if (ok && !write)
+					Genode::memcpy(buf + (p.block_number() - nr)*_block_size,
+					               _tx_source->packet_content(p),
+					               p.block_count()*_block_size);
 
-			if (!p.succeeded()) {
-				PERR("Could not read block(s)");
 				_tx_source->release_packet(p);
-				return 0;
 			}
 
-			if (!write)
-				Genode::memcpy(buf, _tx_source->packet_content(p), packet_size);
+			return ok;
+		}
+
+		/**
+		 * Transfer 'count' bytes at byte offset 'offset' from or to 'buf'
+		 *
+		 * Only the partially accessed blocks at the start and the end of
+		 * the range go through the block buffer. On write, these blocks
+		 * are read first.
+		 */
+		bool _io(file_size offset, char *buf, file_size count, bool write)
+		{
+			while (count > 0) {
+
+				Block::sector_t const blk_nr = offset / _block_size;
+				file_size       const displ  = offset % _block_size;
+
+				/* aligned blocks in the middle of the range */
+				if (displ == 0 && count >= _block_size) {
+
+					Block::sector_t const n = count / _block_size;
+
+					if (!_block_io(blk_nr, buf, n, write))
+						return false;
+
+					file_size const length = n*_block_size;
+
+					buf    += length;
+					offset += length;
+					count  -= length;
+					continue;
+				}
+
+				/* partial block at the start or the end of the range */
+				file_size const length = Genode::min(count, _block_size - displ);
+
+				if (!_block_io(blk_nr, _block_buffer, 1, false))
+					return false;
 
-			_tx_source->release_packet(p);
-			return packet_size;
+				if (write) {
+					Genode::memcpy(_block_buffer + displ, buf, length);
+
+					if (!_block_io(blk_nr, _block_buffer, 1, true))
+						return false;
+				} else
+					Genode::memcpy(buf, _block_buffer + displ, length);
+
+				buf    += length;
+				offset += length;
+				count  -= length;
+			}
+			return true;
 		}
 
 	public:
@@ -102,23 +209,30 @@ class Vfs::Block_file_system : public Single_file_system
 		:
 			Single_file_system(NODE_TYPE_BLOCK_DEVICE, name(), config),
 			_label(config),
-			_block_buffer(0),
-			_block_buffer_count(1),
 			_tx_block_alloc(env()->heap()),
-			_block(&_tx_block_alloc, 128*1024, _label.string),
+			_block(&_tx_block_alloc, TX_BUF_SIZE, _label.string),
 			_tx_source(_block.tx()),
 			_readable(false),
-			_writeable(false)
+			_writeable(false),
+			_block_buffer_count(0),
+			_block_buffer(0)
 		{
-			try { config.attribute("block_buffer_count").value(&_block_buffer_count); }
-			catch (...) { }
-
 			_block.info(&_block_count, &_block_size, &_block_ops);
 
 			_readable  = _block_ops.supported(Block::Packet_descriptor::READ);
 			_writeable = _block_ops.supported(Block::Packet_descriptor::WRITE);
 
-			_block_buffer = new (env()->heap()) char[_block_buffer_count * _block_size];
+			/* leave room in the packet-stream buffer for multiple packets */
+			unsigned const max_count =
+				Genode::max((Genode::size_t)1, (TX_BUF_SIZE/4) / _block_size);
+
+			try { config.attribute("block_buffer_count").value(&_block_buffer_count); }
+			catch (...) { }
+
+			if (!_block_buffer_count || _block_buffer_count > max_count)
+				_block_buffer_count = max_count;
+
+			_block_buffer = new (env()->heap()) char[_block_size];
 		}
 
 		~Block_file_system()
@@ -153,80 +267,10 @@ class Vfs::Block_file_system : public Single_file_system
 				return WRITE_ERR_INVALID;
 			}
 
-			file_size seek_offset = vfs_handle->seek();
-
-			file_size written = 0;
-			while (count > 0) {
-				file_size displ   = 0;
-				file_size length  = 0;
-				file_size nbytes  = 0;
-				file_size blk_nr  = seek_offset / _block_size;
-
-				displ = seek_offset % _block_size;
-
-				if ((displ + count) > _block_size)
-					length = (_block_size - displ);
-				else
-					length = count;
-
-				/*
-				 * We take a shortcut and write as much as possible without
-				 * using the block buffer if the offset is aligned on a block
-				 * boundary and the count is a multiple of the block size,
-				 * e.g. 4K writes will be written at once.
-				 *
-				 * XXX this is quite hackish because we have to omit partial
-				 * blocks at the end.
-				 */
-				if (displ == 0 && (count % _block_size) >= 0 && !(count < _block_size)) {
-					file_size bytes_left = count - (count % _block_size);
-
-					nbytes = _block_io(blk_nr, (void*)(buf + written),
-					                   bytes_left, true, true);
-					if (nbytes == 0) {
-						PERR("error while write block:%llu from block device",
-						     blk_nr);
-						return WRITE_ERR_INVALID;
-					}
-
-					written += nbytes;
-					count   -= nbytes;
-					seek_offset += nbytes;
-
-					continue;
-				}
-
-				/*
-				 * The offset is not aligned on a block boundary. Therefore
-				 * we need to read the block to the block buffer first and
-				 * put the buffer content at the right offset before we can
-				 * write the whole block back. In addition if length is less
-				 * than block size, we also have to read the block first.
-				 */
-				if (displ > 0 || length < _block_size) {
-					PWRN("offset:%llu block_size:%zd displacement:%llu length:%llu",
-							seek_offset, _block_size, displ, length);
-
-					_block_io(blk_nr, _block_buffer, _block_size, false);
-					/* rewind seek offset to account for the block read */
-					seek_offset -= _block_size;
-				}
-
-				Genode::memcpy(_block_buffer + displ, buf + written, length);
-
-				nbytes = _block_io(blk_nr, _block_buffer, _block_size, true);
-				if ((unsigned)nbytes != _block_size) {
-					PERR("error while writing block:%llu from Block_device",
-					     blk_nr);
-					return WRITE_ERR_INVALID;
-				}
-
-				written += length;
-				count -= length;
-				seek_offset += length;
-			}
+			if (!_io(vfs_handle->seek(), const_cast<char *>(buf), count, true))
+				return WRITE_ERR_INVALID;
 
-			out_count = written;
+			out_count = count;
 
 			return WRITE_OK;
 		}
@@ -239,68 +283,16 @@ class Vfs::Block_file_system : public Single_file_system
 				return READ_ERR_INVALID;
 			}
 
-			file_size seek_offset = vfs_handle->seek();
-
-			file_size read = 0;
-			while (count > 0) {
-				file_size displ   = 0;
-				file_size length  = 0;
-				file_size nbytes  = 0;
-				file_size blk_nr  = seek_offset / _block_size;
-
-				displ = seek_offset % _block_size;
-
-				if ((displ + count) > _block_size)
-					length = (_block_size - displ);
-				else
-					length = count;
-
-				/*
-				 * We take a shortcut and read the blocks all at once if t he
-				 * offset is aligned on a block boundary and we the count is a
-				 * multiple of the block size, e.g. 4K reads will be read at
-				 * once.
-				 *
-				 * XXX this is quite hackish because we have to omit partial
-				 * blocks at the end.
-				 */
-				if (displ == 0 && (count % _block_size) >= 0 && !(count < _block_size)) {
-					file_size bytes_left = count - (count % _block_size);
-
-					nbytes = _block_io(blk_nr, dst + read, bytes_left, false, true);
-					if (nbytes == 0) {
-						PERR("error while reading block:%llu from block device",
-						     blk_nr);
-						return READ_ERR_INVALID;
-					}
+			/* do not read beyond the end of the device */
+			file_size const size        = _block_count * _block_size;
+			file_size const seek_offset = vfs_handle->seek();
 
-					read  += nbytes;
-					count -= nbytes;
-					seek_offset += nbytes;
+			count = seek_offset < size ? Genode::min(count, size - seek_offset) : 0;
 
-					continue;
-				}
-
-				if (displ > 0)
-					PWRN("offset:%llu is not aligned to block_size:%zu"
-					     " displacement:%llu", seek_offset, _block_size,
-					     displ);
-
-				nbytes = _block_io(blk_nr, _block_buffer, _block_size, false);
-				if ((unsigned)nbytes != _block_size) {
-					PERR("error while reading block:%llu from block device",
-					     blk_nr);
-					return READ_ERR_INVALID;
-				}
-
-				Genode::memcpy(dst + read, _block_buffer + displ, length);
-
-				read  += length;
-				count -= length;
-				seek_offset += length;
-			}
+			if (!_io(seek_offset, dst, count, false))
+				return READ_ERR_INVALID;
 
-			out_count = read;
+			out_count = count;
 
 			return READ_OK;
 		}
@@ -17,6 +17,7 @@
 /* Genode includes */
 #include <base/allocator_avl.h>
 #include <file_system_session/connection.h>
+#include <file_system/util.h>
 
 namespace Vfs { class Fs_file_system; }
 
@@ -46,7 +47,40 @@ class Vfs::Fs_file_system : public File_system
 
 		::File_system::Connection _fs;
 
-		class Fs_vfs_handle : public Vfs_handle
+		/*
+		 * Optional buffering of file content per handle
+		 *
+		 * With 'read_ahead' enabled, small sequential reads are served from
+		 * a buffer filled by reading ahead of the requested range. With
+		 * 'write_behind' enabled, small sequential writes are collected
+		 * and submitted to the server at once. Pending writes are submitted
+		 * before any other operation of this file system that may observe
+		 * them. Prefetched content is dropped on writes of this file
+		 * system. Changes made by other clients of the file-system server
+		 * may remain unnoticed by a filled read-ahead buffer, and errors of
+		 * deferred writes are reported in the log only. Hence, both
+		 * features are disabled by default.
+		 */
+		enum { BUFFER_SIZE = 64*1024 };
+
+		bool const _read_ahead;
+		bool const _write_behind;
+
+		struct Buffer
+		{
+			char      *data   = 0;     /* allocated on first use */
+			file_size  offset = 0;     /* file offset of buffered content */
+			file_size  length = 0;
+			bool       dirty  = false; /* content not yet written to server */
+
+			bool covers(file_size seek, file_size count) const
+			{
+				return length && seek >= offset && seek + count <= offset + length;
+			}
+		};
+
+		class Fs_vfs_handle : public Vfs_handle,
+		                      public Genode::List<Fs_vfs_handle>::Element
 		{
 			private:
 
@@ -54,6 +88,9 @@ class Vfs::Fs_file_system : public File_system
 
 			public:
 
+				Buffer    buffer;
+				file_size next_read = 0; /* offset following the last read */
+
 				Fs_vfs_handle(File_system &fs, int status_flags,
 				              ::File_system::File_handle handle)
 				: Vfs_handle(fs, fs, status_flags), _handle(handle)
@@ -62,12 +99,15 @@ class Vfs::Fs_file_system : public File_system
 				~Fs_vfs_handle()
 				{
 					Fs_file_system &fs = static_cast<Fs_file_system &>(ds());
+					fs._release(*this);
 					fs._fs.close(_handle);
 				}
 
 				::File_system::File_handle file_handle() const { return _handle; }
 		};
 
+		Genode::List<Fs_vfs_handle> _handles;
+
 		/**
 		 * Helper for managing the lifetime of temporary open node handles
 		 */
@@ -86,68 +126,75 @@ class Vfs::Fs_file_system : public File_system
 		file_size _read(::File_system::Node_handle node_handle, void *buf,
 		                file_size const count, file_size const seek_offset)
 		{
-			::File_system::Session::Tx::Source &source = *_fs.tx();
-
-			file_size const max_packet_size = source.bulk_buffer_size() / 2;
-			file_size const clipped_count = min(max_packet_size, count);
-
-			::File_system::Packet_descriptor const
-				packet_in(source.alloc_packet(clipped_count),
-				          node_handle,
-				          ::File_system::Packet_descriptor::READ,
-				          clipped_count,
-				          seek_offset);
-
-			/* pass packet to server side */
-			source.submit_packet(packet_in);
-
-			/* obtain result packet descriptor with updated status info */
-			::File_system::Packet_descriptor const
-				packet_out = source.get_acked_packet();
-
-			file_size const read_num_bytes = min(packet_out.length(), count);
-
-			memcpy(buf, source.packet_content(packet_out), read_num_bytes);
-
-			/*
-			 * XXX check if acked packet belongs to request,
-			 *     needed for thread safety
-			 */
-
-			source.release_packet(packet_out);
-
-			return read_num_bytes;
+			return ::File_system::read(_fs, node_handle, buf, count, seek_offset);
 		}
 
 		file_size _write(::File_system::Node_handle node_handle,
 		                 const char *buf, file_size count, file_size seek_offset)
 		{
-			::File_system::Session::Tx::Source &source = *_fs.tx();
+			return ::File_system::write(_fs, node_handle, buf, count, seek_offset);
+		}
 
-			file_size const max_packet_size = source.bulk_buffer_size() / 2;
-			count = min(max_packet_size, count);
+		/**
+		 * Return true if the buffer of 'handle' is available
+		 */
+		bool _alloc_buffer(Fs_vfs_handle &handle)
+		{
+			return handle.buffer.data
+			    || env()->heap()->alloc(BUFFER_SIZE, &handle.buffer.data);
+		}
 
-			::File_system::Packet_descriptor
-				packet(source.alloc_packet(count),
-				       node_handle,
-				       ::File_system::Packet_descriptor::WRITE,
-				       count,
-				       seek_offset);
+		/**
+		 * Submit pending writes of 'handle' to the server
+		 *
+		 * Must be called with '_lock' held.
+		 */
+		void _flush(Fs_vfs_handle &handle)
+		{
+			Buffer &b = handle.buffer;
+			if (!b.dirty)
+				return;
 
-			memcpy(source.packet_content(packet), buf, count);
+			b.dirty = false;
+			try {
+				if (_write(handle.file_handle(), b.data, b.length, b.offset) != b.length)
+					PERR("deferred write of %llu bytes failed", b.length);
+			} catch (...) { PERR("deferred write of %llu bytes failed", b.length); }
 
-			/* pass packet to server side */
-			source.submit_packet(packet);
-			source.get_acked_packet();
+			b.length = 0;
+		}
 
-			/*
-			 * XXX check if acked packet belongs to request,
-			 *     needed for thread safety
-			 */
+		/**
+		 * Submit pending writes of all handles to the server
+		 */
+		void _flush_all()
+		{
+			for (Fs_vfs_handle *h = _handles.first(); h; h = h->next())
+				_flush(*h);
+		}
 
-			source.release_packet(packet);
+		/**
+		 * Drop prefetched content of all handles
+		 */
+		void _invalidate_all()
+		{
+			for (Fs_vfs_handle *h = _handles.first(); h; h = h->next())
+				if (!h->buffer.dirty)
+					h->buffer.length = 0;
+		}
+
+		/**
+		 * Called on the destruction of 'handle'
+		 */
+		void _release(Fs_vfs_handle &handle)
+		{
+			Lock::Guard guard(_lock);
+
+			_flush(handle);
+			_handles.remove(&handle);
 
-			return count;
+			if (handle.buffer.data)
+				env()->heap()->free(handle.buffer.data, BUFFER_SIZE);
 		}
 
 	public:
@@ -160,7 +207,9 @@ class Vfs::Fs_file_system : public File_system
 			_fs(_fs_packet_alloc,
 			    ::File_system::DEFAULT_TX_BUF_SIZE,
 			    _label.string(), _root.string(),
-			    config.attribute_value("writeable", true))
+			    config.attribute_value("writeable", true)),
+			_read_ahead(  config.attribute_value("read_ahead",   false)),
+			_write_behind(config.attribute_value("write_behind", false))
 		{ }
 
 
@@ -172,6 +221,8 @@ class Vfs::Fs_file_system : public File_system
 		{
 			Lock::Guard guard(_lock);
 
+			_flush_all();
+
 			Absolute_path dir_path(path);
 			dir_path.strip_last_element();
 			dir_path.remove_trailing('/');
@@ -192,6 +243,11 @@ class Vfs::Fs_file_system : public File_system
 				             ::File_system::READ_ONLY, false);
 				Fs_handle_guard file_guard(_fs, file);
 
+				/* map the server-side file content if supported */
+				Dataspace_capability shared_ds = _fs.dataspace(file);
+				if (shared_ds.valid())
+					return shared_ds;
+
 				::File_system::Status status = _fs.status(file);
 
 				Ram_dataspace_capability ds_cap =
@@ -199,35 +255,7 @@ class Vfs::Fs_file_system : public File_system
 
 				local_addr = env()->rm_session()->attach(ds_cap);
 
-				::File_system::Session::Tx::Source &source = *_fs.tx();
-				file_size const max_packet_size = source.bulk_buffer_size() / 2;
-
-				for (file_size seek_offset = 0; seek_offset < status.size;
-				     seek_offset += max_packet_size) {
-
-					file_size const count = min(max_packet_size, status.size -
-					                                             seek_offset);
-
-					::File_system::Packet_descriptor
-						packet(source.alloc_packet(count),
-							   file,
-							   ::File_system::Packet_descriptor::READ,
-							   count,
-							   seek_offset);
-
-					/* pass packet to server side */
-					source.submit_packet(packet);
-					source.get_acked_packet();
-
-					memcpy(local_addr + seek_offset, source.packet_content(packet), count);
-
-					/*
-					 * XXX check if acked packet belongs to request,
-					 *     needed for thread safety
-					 */
-
-					source.release_packet(packet);
-				}
+				_read(file, local_addr, status.size, 0);
 
 				env()->rm_session()->detach(local_addr);
 
@@ -241,12 +269,21 @@ class Vfs::Fs_file_system : public File_system
 
 		void release(char const *path, Dataspace_capability ds_cap) override
 		{
+			/*
+			 * A dataspace obtained from the server is not owned by our RAM
+			 * session, core ignores the attempt to free it.
+			 */
 			if (ds_cap.valid())
 				env()->ram_session()->free(static_cap_cast<Genode::Ram_dataspace>(ds_cap));
 		}
 
 		Stat_result stat(char const *path, Stat &out) override
 		{
+			{
+				Lock::Guard guard(_lock);
+				_flush_all();
+			}
+
 			::File_system::Status status;
 
 			try {
@@ -336,6 +373,11 @@ class Vfs::Fs_file_system : public File_system
 
 		Unlink_result unlink(char const *path) override
 		{
+			{
+				Lock::Guard guard(_lock);
+				_flush_all();
+			}
+
 			Absolute_path dir_path(path);
 			dir_path.strip_last_element();
 			dir_path.remove_trailing('/');
@@ -387,6 +429,11 @@ class Vfs::Fs_file_system : public File_system
 
 		Rename_result rename(char const *from_path, char const *to_path) override
 		{
+			{
+				Lock::Guard guard(_lock);
+				_flush_all();
+			}
+
 			Absolute_path from_dir_path(from_path);
 			from_dir_path.strip_last_element();
 			from_dir_path.remove_trailing('/');
@@ -551,7 +598,10 @@ class Vfs::Fs_file_system : public File_system
 				::File_system::File_handle file = _fs.file(dir, file_name.base() + 1,
 				                                           mode, create);
 
-				*out_handle = new (env()->heap()) Fs_vfs_handle(*this, vfs_mode, file);
+				Fs_vfs_handle *handle = new (env()->heap())
+				                        Fs_vfs_handle(*this, vfs_mode, file);
+				_handles.insert(handle);
+				*out_handle = handle;
 			}
 			catch (::File_system::Permission_denied)   { return OPEN_ERR_NO_PERM; }
 			catch (::File_system::Invalid_handle)      { return OPEN_ERR_NO_PERM; }
@@ -573,6 +623,11 @@ class Vfs::Fs_file_system : public File_system
 
 		void sync(char const *path) override
 		{
+			{
+				Lock::Guard guard(_lock);
+				_flush_all();
+			}
+
 			try {
 				::File_system::Node_handle node = _fs.node(path);
 				Fs_handle_guard node_guard(_fs, node);
@@ -590,9 +645,35 @@ class Vfs::Fs_file_system : public File_system
 		{
 			Lock::Guard guard(_lock);
 
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			_invalidate_all();
+
+			file_size const seek = handle->seek();
+			Buffer         &b    = handle->buffer;
+
+			if (_write_behind && buf_size < BUFFER_SIZE && _alloc_buffer(*handle)) {
 
-			out_count = _write(handle->file_handle(), buf, buf_size, handle->seek());
+				/* append to pending writes if contiguous */
+				if (b.dirty && (seek != b.offset + b.length
+				             || b.length + buf_size > BUFFER_SIZE))
+					_flush(*handle);
+
+				if (!b.dirty) {
+					b.offset = seek;
+					b.length = 0;
+					b.dirty  = true;
+				}
+
+				memcpy(b.data + b.length, buf, buf_size);
+				b.length += buf_size;
+				out_count = buf_size;
+				return WRITE_OK;
+			}
+
+			_flush(*handle);
+
+			out_count = _write(handle->file_handle(), buf, buf_size, seek);
 
 			return WRITE_OK;
 		}
@@ -602,17 +683,56 @@ class Vfs::Fs_file_system : public File_system
 		{
 			Lock::Guard guard(_lock);
 
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			_flush_all();
+
+			file_size const seek = handle->seek();
+			Buffer         &b    = handle->buffer;
+
+			bool const sequential = (seek == handle->next_read);
+
+			/* read ahead on sequential access */
+			if (!b.covers(seek, count) && _read_ahead && sequential
+			 && count < BUFFER_SIZE && _alloc_buffer(*handle)) {
+
+				::File_system::Status status = _fs.status(handle->file_handle());
+				file_size const bytes_left = status.size > seek ? status.size - seek : 0;
+
+				b.offset = seek;
+				b.length = 0;
+				b.length = _read(handle->file_handle(), b.data,
+				                 min((file_size)BUFFER_SIZE, bytes_left), seek);
+
+				/* the end of the file lies within the buffer */
+				if (b.length < count)
+					count = b.length;
+
+				if (!count) {
+					out_count = 0;
+					handle->next_read = seek;
+					return READ_OK;
+				}
+			}
+
+			if (b.covers(seek, count)) {
+				memcpy(dst, b.data + (seek - b.offset), count);
+				out_count = count;
+				handle->next_read = seek + out_count;
+				return READ_OK;
+			}
 
 			::File_system::Status status = _fs.status(handle->file_handle());
 			file_size const size_of_file = status.size;
 
-			file_size const file_bytes_left = size_of_file >= handle->seek()
-			                                ? size_of_file  - handle->seek() : 0;
+			file_size const file_bytes_left = size_of_file >= seek
+			                                ? size_of_file  - seek : 0;
 
 			count = min(count, file_bytes_left);
 
-			out_count = _read(handle->file_handle(), dst, count, handle->seek());
+			out_count = _read(handle->file_handle(), dst, count, seek);
+
+			handle->next_read = seek + out_count;
 
 			return READ_OK;
 		}
@@ -621,6 +741,12 @@ class Vfs::Fs_file_system : public File_system
 		{
 			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
 
+			{
+				Lock::Guard guard(_lock);
+				_flush_all();
+				_invalidate_all();
+			}
+
 			try {
 				_fs.truncate(handle->file_handle(), len);
 			}
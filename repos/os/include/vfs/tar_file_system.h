@@ -15,6 +15,7 @@
 #define _INCLUDE__VFS__TAR_FILE_SYSTEM_H_
 
 #include <rom_session/connection.h>
+#include <os/sub_dataspace.h>
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
 
@@ -320,16 +321,179 @@ class Vfs::Tar_file_system : public File_system
 	}
 
 
+	/**
+	 * Hash table that maps absolute paths to nodes
+	 *
+	 * The table is populated once after scanning the archive. Thereby,
+	 * looking up a path does not depend on the number of archived files.
+	 */
+	class Node_index
+	{
+		private:
+
+			struct Slot
+			{
+				char *path;
+				Node *node;
+			};
+
+			Slot     *_slots;
+			unsigned  _num_slots; /* power of two */
+
+			static unsigned _hash(char const *path)
+			{
+				unsigned h = 5381;
+				for (; *path; path++)
+					h = h*33 + *path;
+				return h;
+			}
+
+			Slot &_slot(char const *path) const
+			{
+				unsigned i = _hash(path) & (_num_slots - 1);
+				for (; _slots[i].path; i = (i + 1) & (_num_slots - 1))
+					if (strcmp(_slots[i].path, path) == 0)
+						break;
+				return _slots[i];
+			}
+
+			static unsigned _count(Node const &node)
+			{
+				unsigned count = 1;
+				for (Node const *c = node.first(); c; c = c->next())
+					count += _count(*c);
+				return count;
+			}
+
+			/**
+			 * Insert 'node' and its children
+			 *
+			 * \param path  buffer holding the path of 'node'
+			 * \param len   length of the path
+			 */
+			void _insert(Node &node, char *path, Genode::size_t len)
+			{
+				Slot &slot = _slot(path);
+				if (!slot.path) {
+					slot.path = (char *)env()->heap()->alloc(len + 1);
+					strncpy(slot.path, path, len + 1);
+					slot.node = &node;
+				}
+
+				for (Node *c = node.first(); c; c = c->next()) {
+					Genode::size_t const name_len = strlen(c->name);
+					if (len + 1 + name_len >= MAX_PATH_LEN)
+						continue;
+
+					path[len] = '/';
+					strncpy(path + len + 1, c->name, name_len + 1);
+					_insert(*c, path, len + 1 + name_len);
+					path[len] = 0;
+				}
+			}
+
+		public:
+
+			Node_index() : _slots(0), _num_slots(0) { }
+
+			/**
+			 * Populate index with the tree of nodes starting at 'root'
+			 */
+			void build(Node &root)
+			{
+				/* keep the table at most half full */
+				unsigned const num_nodes = _count(root);
+				for (_num_slots = 16; _num_slots < 2*num_nodes; _num_slots *= 2);
+
+				_slots = new (env()->heap()) Slot[_num_slots];
+				memset(_slots, 0, _num_slots*sizeof(Slot));
+
+				/* the root directory is denoted by the empty path */
+				char path[MAX_PATH_LEN];
+				path[0] = 0;
+				_insert(root, path, 0);
+			}
+
+			Node *lookup(char const *path) const
+			{
+				if (!_slots)
+					return 0;
+
+				Absolute_path lookup_path(path);
+				lookup_path.remove_trailing('/');
+
+				char const *key = lookup_path.base();
+				if (strcmp(key, "/") == 0)
+					key = "";
+
+				return _slot(key).node;
+			}
+	} _node_index;
+
+
+	/**
+	 * Record served as sub-dataspace of the archive
+	 */
+	struct Mapped_record : List<Mapped_record>::Element
+	{
+		Record const          *record;
+		unsigned               users;
+		Genode::Sub_dataspace  sub_ds;
+
+		Mapped_record(Dataspace_capability tar_ds, Genode::addr_t offset,
+		              Record const *record)
+		: record(record), users(0), sub_ds(tar_ds, offset, record->size()) { }
+	};
+
+	Lock                _mapped_lock;
+	List<Mapped_record> _mapped_records;
+
+	/**
+	 * Return true if the record content can be handed out without copying
+	 *
+	 * This is the case if the content starts at a page boundary within the
+	 * archive and if the remainder of its last page is zero.
+	 */
+	bool _mappable(Record const *record) const
+	{
+		Genode::addr_t const offset = (char *)record->data() - _tar_base;
+		file_size      const size   = record->size();
+
+		if (!size || !Genode::Sub_dataspace::aligned(offset))
+			return false;
+
+		file_size const end = offset + size;
+		file_size const page_end =
+			align_addr(end, Genode::Sub_dataspace::PAGE_SIZE_LOG2);
+
+		if (page_end > _tar_size)
+			return false;
+
+		for (file_size i = end; i < page_end; i++)
+			if (_tar_base[i])
+				return false;
+
+		return true;
+	}
+
+	Mapped_record *_lookup_mapped(Record const *record)
+	{
+		for (Mapped_record *m = _mapped_records.first(); m; m = m->next())
+			if (m->record == record)
+				return m;
+		return 0;
+	}
+
 	struct Num_dirent_cache
 	{
 		Lock             lock;
-		Node            &root_node;
+		Node_index const &index;
 		bool             valid;              /* true after first lookup */
 		char             key[256];           /* key used for lookup */
 		file_size        cached_num_dirent;  /* cached value */
 
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
+		Num_dirent_cache(Node_index const &index)
+		: index(index), valid(false), cached_num_dirent(0) { }
 
 		file_size num_dirent(char const *path)
 		{
@@ -337,7 +501,7 @@ class Vfs::Tar_file_system : public File_system
 
 			/* check for cache miss */
 			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
+				Node *node = index.lookup(path);
 				if (!node)
 					return 0;
 				strncpy(key, path, sizeof(key));
@@ -355,7 +519,7 @@ class Vfs::Tar_file_system : public File_system
 	 */
 	Node const *dereference(char const *path)
 	{
-		Node const *node = _root_node.lookup(path);
+		Node const *node = _node_index.lookup(path);
 		if (!node) return 0;
 
 		Record const *record = node->record;
@@ -374,12 +538,14 @@ class Vfs::Tar_file_system : public File_system
 			_tar_base(env()->rm_session()->attach(_tar_ds)),
 			_tar_size(Dataspace_client(_tar_ds).size()),
 			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_cached_num_dirent(_node_index)
 		{
 			PINF("tar archive '%s' local at %p, size is %llu",
 			     _rom_name.name, _tar_base, _tar_size);
 
 			_for_each_tar_record_do(Add_node_action(_root_node));
+
+			_node_index.build(_root_node);
 		}
 
 
@@ -400,6 +566,26 @@ class Vfs::Tar_file_system : public File_system
 				return Dataspace_capability();
 			}
 
+			if (_mappable(record)) {
+				Lock::Guard guard(_mapped_lock);
+
+				Mapped_record *mapped = _lookup_mapped(record);
+				if (!mapped) {
+					try {
+						mapped = new (env()->heap())
+							Mapped_record(_tar_ds, (char *)record->data() - _tar_base, record);
+						_mapped_records.insert(mapped);
+					} catch (...) {
+						PWRN("could not map \"%s\", falling back to copy", path);
+					}
+				}
+
+				if (mapped) {
+					mapped->users++;
+					return mapped->sub_ds.dataspace();
+				}
+			}
+
 			try {
 				Ram_dataspace_capability ds_cap =
 					env()->ram_session()->alloc(record->size());
@@ -415,8 +601,22 @@ class Vfs::Tar_file_system : public File_system
 			return Dataspace_capability();
 		}
 
-		void release(char const *, Dataspace_capability ds_cap) override
+		void release(char const *path, Dataspace_capability ds_cap) override
 		{
+			Node const *node = dereference(path);
+			if (node && node->record) {
+				Lock::Guard guard(_mapped_lock);
+
+				Mapped_record *mapped = _lookup_mapped(node->record);
+				if (mapped) {
+					if (--mapped->users == 0) {
+						_mapped_records.remove(mapped);
+						destroy(env()->heap(), mapped);
+					}
+					return;
+				}
+			}
+
 			env()->ram_session()->free(static_cap_cast<Genode::Ram_dataspace>(ds_cap));
 		}
 
@@ -567,7 +767,7 @@ class Vfs::Tar_file_system : public File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
+			Node *node = _node_index.lookup(path);
 			return node ? path : 0;
 		}
 
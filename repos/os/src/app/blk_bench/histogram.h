@@ -0,0 +1,99 @@
+/*
+ * \brief  Histogram of request latencies
+ * \author Norman Feske
+ * \date   2015-12-21
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _HISTOGRAM_H_
+#define _HISTOGRAM_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+#include <util/misc_math.h>
+
+namespace Blk_bench { struct Histogram; }
+
+
+/**
+ * Histogram with logarithmically sized groups of linear buckets
+ *
+ * Values below 8 have a bucket each. Above, each power of two is split
+ * into 8 buckets. So the bucket bounds deviate from the actual values by
+ * less than 12.5%, which is precise enough for percentiles while the
+ * histogram covers the whole 64-bit range with a fixed number of buckets.
+ */
+struct Blk_bench::Histogram
+{
+	enum { SUB_BUCKETS_LOG2 = 3, SUB_BUCKETS = 1 << SUB_BUCKETS_LOG2,
+	       NUM_BUCKETS = (64 - SUB_BUCKETS_LOG2 + 1)*SUB_BUCKETS };
+
+	Genode::uint64_t buckets[NUM_BUCKETS] { };
+	Genode::uint64_t count = 0;
+	Genode::uint64_t sum   = 0;
+	Genode::uint64_t max   = 0;
+
+	static unsigned _index(Genode::uint64_t value)
+	{
+		if (value < SUB_BUCKETS)
+			return value;
+
+		unsigned const e   = Genode::log2(value);
+		unsigned const sub = (value >> (e - SUB_BUCKETS_LOG2)) & (SUB_BUCKETS - 1);
+
+		return (e - SUB_BUCKETS_LOG2 + 1)*SUB_BUCKETS + sub;
+	}
+
+	/**
+	 * Return largest value accounted in bucket 'index'
+	 */
+	static Genode::uint64_t _upper_bound(unsigned index)
+	{
+		if (index < SUB_BUCKETS)
+			return index;
+
+		unsigned const e   = index/SUB_BUCKETS + SUB_BUCKETS_LOG2 - 1;
+		unsigned const sub = index % SUB_BUCKETS;
+
+		Genode::uint64_t const lower = (Genode::uint64_t)(SUB_BUCKETS + sub)
+		                               << (e - SUB_BUCKETS_LOG2);
+
+		return lower + ((Genode::uint64_t)1 << (e - SUB_BUCKETS_LOG2)) - 1;
+	}
+
+	void add(Genode::uint64_t value)
+	{
+		buckets[_index(value)]++;
+		count++;
+		sum += value;
+		max  = Genode::max(max, value);
+	}
+
+	Genode::uint64_t mean() const { return count ? sum/count : 0; }
+
+	/**
+	 * Return upper bound of the bucket that contains the given percentile
+	 *
+	 * \param permille  percentile in tenths of a percent
+	 */
+	Genode::uint64_t percentile(unsigned permille) const
+	{
+		Genode::uint64_t const threshold = (count*permille + 999)/1000;
+
+		Genode::uint64_t sum = 0;
+		for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+			sum += buckets[i];
+			if (sum >= threshold && sum)
+				return Genode::min(_upper_bound(i), max);
+		}
+		return max;
+	}
+};
+
+#endif /* _HISTOGRAM_H_ */
@@ -0,0 +1,421 @@
+/*
+ * \brief  Benchmark for block-session servers
+ * \author Norman Feske
+ * \date   2015-12-21
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <base/allocator_avl.h>
+#include <block_session/connection.h>
+#include <timer_session/connection.h>
+#include <os/server.h>
+#include <os/config.h>
+#include <os/reporter.h>
+#include <trace/timestamp.h>
+
+/* local includes */
+#include "histogram.h"
+
+namespace Blk_bench {
+
+	using namespace Genode;
+
+	struct Config;
+	struct Stats;
+	struct Main;
+
+	typedef Block::Packet_descriptor Packet_descriptor;
+}
+
+
+/**
+ * Access pattern, obtained from the component's configuration
+ */
+struct Blk_bench::Config
+{
+	Xml_node const node = Genode::config()->xml_node();
+
+	bool const random = _random(node);
+
+	unsigned const read_percent =
+		Genode::min(node.attribute_value("read_percent", 100U), 100U);
+
+	size_t const block_size =
+		node.attribute_value("block_size", (size_t)4096);
+
+	unsigned const queue_depth =
+		Genode::max(node.attribute_value("queue_depth", 1U), 1U);
+
+	unsigned long const duration_ms =
+		node.attribute_value("duration_ms", 10000UL);
+
+	unsigned long const report_interval_ms =
+		Genode::max(node.attribute_value("report_interval_ms", 1000UL), 1UL);
+
+	unsigned const seed = node.attribute_value("seed", 1U);
+
+	static bool _random(Xml_node node)
+	{
+		try { return node.attribute("pattern").has_value("random"); }
+		catch (...) { return false; }
+	}
+
+	bool report() const
+	{
+		try {
+			return node.sub_node("report").attribute("results").has_value("yes");
+		} catch (...) { return false; }
+	}
+};
+
+
+/**
+ * Counters of one kind of operation
+ */
+struct Blk_bench::Stats
+{
+	uint64_t  ops    = 0;
+	uint64_t  bytes  = 0;
+	uint64_t  errors = 0;
+	Histogram latency;  /* in cycles */
+
+	void account(Packet_descriptor const &p, uint64_t cycles)
+	{
+		if (!p.succeeded()) {
+			errors++;
+			return;
+		}
+		ops++;
+		bytes += p.size();
+		latency.add(cycles);
+	}
+};
+
+
+struct Blk_bench::Main
+{
+	Server::Entrypoint &ep;
+
+	Config const config;
+
+	Allocator_avl     tx_alloc { env()->heap() };
+	Block::Connection block    { &tx_alloc, _tx_buf_size() };
+	Timer::Connection timer;
+
+	Reporter reporter { "blk_bench" };
+
+	Block::sector_t            blk_count = 0;
+	size_t                     blk_size  = 0;
+	Block::Session::Operations blk_ops;
+
+	/* number of device blocks per request */
+	size_t count = 0;
+
+	unsigned depth = 0;
+
+	/*
+	 * Each request slot owns one packet of the transmission buffer, which
+	 * is re-submitted as soon as it gets acknowledged. So no allocations
+	 * happen while measuring.
+	 */
+	struct Slot
+	{
+		Packet_descriptor packet;
+		Trace::Timestamp  submitted = 0;
+	};
+
+	enum { MAX_DEPTH = Block::Session::TX_QUEUE_SIZE - 1 };
+
+	Slot slots[MAX_DEPTH];
+
+	unsigned in_flight = 0;
+	bool     running   = false;
+	bool     finished  = false;
+
+	Block::sector_t next_block = 0;
+	unsigned        rand_state;
+
+	Stats read_stats, write_stats;
+
+	unsigned long    start_ms = 0;
+	unsigned long    now_ms   = 0;
+	Trace::Timestamp last_ts  = 0;
+
+	/*
+	 * The cycle counter is accumulated at each timer tick, which keeps
+	 * the total correct for counters narrower than 64 bit as long as the
+	 * report interval is shorter than the wrap-around of the counter.
+	 */
+	uint64_t cycles = 0;
+
+	size_t _tx_buf_size() const
+	{
+		enum { ALIGN = 1 << Packet_descriptor::PACKET_ALIGNMENT };
+
+		size_t const slot_size = align_addr(config.block_size,
+		                                    Packet_descriptor::PACKET_ALIGNMENT);
+
+		return Genode::min(config.queue_depth, (unsigned)MAX_DEPTH)*slot_size
+		       + ALIGN;
+	}
+
+	/**
+	 * Xorshift pseudo-random number generator
+	 */
+	unsigned _random()
+	{
+		rand_state ^= rand_state << 13;
+		rand_state ^= rand_state >> 17;
+		rand_state ^= rand_state << 5;
+		return rand_state;
+	}
+
+	Block::sector_t _block_number()
+	{
+		Block::sector_t const num_requests = blk_count/count;
+
+		if (config.random) {
+			Block::sector_t const r = ((Block::sector_t)_random() << 32) | _random();
+			return (r % num_requests)*count;
+		}
+
+		Block::sector_t const block = next_block;
+		next_block = (next_block + count <= blk_count - count)
+		             ? next_block + count : 0;
+		return block;
+	}
+
+	Packet_descriptor::Opcode _operation()
+	{
+		if (config.read_percent == 100) return Packet_descriptor::READ;
+		if (config.read_percent == 0)   return Packet_descriptor::WRITE;
+
+		return (_random() % 100 < config.read_percent)
+		       ? Packet_descriptor::READ : Packet_descriptor::WRITE;
+	}
+
+	void _submit(Slot &slot)
+	{
+		slot.packet    = Packet_descriptor(slot.packet, _operation(),
+		                                   _block_number(), count);
+		slot.submitted = Trace::timestamp();
+
+		block.tx()->submit_packet(slot.packet);
+	}
+
+	Slot *_slot(Packet_descriptor const &p)
+	{
+		for (unsigned i = 0; i < depth; i++)
+			if (slots[i].packet.offset() == p.offset())
+				return &slots[i];
+
+		return nullptr;
+	}
+
+	void _update_cycles()
+	{
+		Trace::Timestamp const ts = Trace::timestamp();
+
+		cycles += (Trace::Timestamp)(ts - last_ts);
+		last_ts = ts;
+		now_ms  = timer.elapsed_ms();
+	}
+
+	unsigned long _elapsed_ms() const { return now_ms - start_ms; }
+
+	/**
+	 * Convert cycles to microseconds, based on the cycles measured so far
+	 */
+	unsigned long long _us(uint64_t value) const
+	{
+		uint64_t const cycles_per_ms = _elapsed_ms() ? cycles/_elapsed_ms() : 0;
+		return cycles_per_ms ? (value*1000)/cycles_per_ms : 0;
+	}
+
+	void _generate(Xml_generator &xml, char const *name, Stats const &stats)
+	{
+		unsigned long const ms = Genode::max(_elapsed_ms(), 1UL);
+
+		xml.node(name, [&] () {
+			xml.attribute("ops",       (unsigned long long)stats.ops);
+			xml.attribute("bytes",     (unsigned long long)stats.bytes);
+			xml.attribute("errors",    (unsigned long long)stats.errors);
+			xml.attribute("iops",      (unsigned long long)(stats.ops*1000/ms));
+			xml.attribute("kib_per_s", (unsigned long long)(stats.bytes*1000/1024/ms));
+
+			Histogram const &h = stats.latency;
+			xml.node("latency", [&] () {
+				xml.attribute("unit", "us");
+				xml.attribute("mean", _us(h.mean()));
+				xml.attribute("p50",  _us(h.percentile(500)));
+				xml.attribute("p90",  _us(h.percentile(900)));
+				xml.attribute("p99",  _us(h.percentile(990)));
+				xml.attribute("p999", _us(h.percentile(999)));
+				xml.attribute("max",  _us(h.max));
+			});
+		});
+	}
+
+	void _report()
+	{
+		if (!reporter.is_enabled())
+			return;
+
+		Reporter::Xml_generator xml(reporter, [&] () {
+			xml.attribute("state",       finished ? "finished" : "running");
+			xml.attribute("elapsed_ms",  _elapsed_ms());
+			xml.attribute("pattern",     config.random ? "random" : "sequential");
+			xml.attribute("block_size",  config.block_size);
+			xml.attribute("queue_depth", depth);
+
+			if (config.read_percent > 0)   _generate(xml, "read",  read_stats);
+			if (config.read_percent < 100) _generate(xml, "write", write_stats);
+		});
+	}
+
+	void _log(char const *name, Stats const &stats)
+	{
+		unsigned long const ms = Genode::max(_elapsed_ms(), 1UL);
+		Histogram const &h = stats.latency;
+
+		printf("%s: %llu ops, %llu IOPS, %llu KiB/s, %llu errors,"
+		       " latency us mean=%llu p50=%llu p99=%llu max=%llu\n", name,
+		       (unsigned long long)stats.ops,
+		       (unsigned long long)(stats.ops*1000/ms),
+		       (unsigned long long)(stats.bytes*1000/1024/ms),
+		       (unsigned long long)stats.errors,
+		       _us(h.mean()), _us(h.percentile(500)), _us(h.percentile(990)),
+		       _us(h.max));
+	}
+
+	void _finish()
+	{
+		_update_cycles();
+		finished = true;
+
+		for (unsigned i = 0; i < depth; i++)
+			block.tx()->release_packet(slots[i].packet);
+
+		_report();
+
+		if (config.read_percent > 0)   _log("read",  read_stats);
+		if (config.read_percent < 100) _log("write", write_stats);
+
+		printf("--- blk_bench finished ---\n");
+	}
+
+	void handle_ack(unsigned)
+	{
+		while (block.tx()->ack_avail()) {
+
+			Packet_descriptor const p = block.tx()->get_acked_packet();
+			Trace::Timestamp  const ts = Trace::timestamp();
+
+			Slot *slot = _slot(p);
+			if (!slot) {
+				PERR("acknowledged packet of unknown request");
+				continue;
+			}
+
+			Stats &stats = p.operation() == Packet_descriptor::WRITE
+			             ? write_stats : read_stats;
+			stats.account(p, (Trace::Timestamp)(ts - slot->submitted));
+
+			if (running)
+				_submit(*slot);
+			else if (--in_flight == 0)
+				_finish();
+		}
+	}
+
+	void handle_timer(unsigned)
+	{
+		if (finished)
+			return;
+
+		_update_cycles();
+
+		if (running && _elapsed_ms() >= config.duration_ms)
+			running = false;
+
+		_report();
+	}
+
+	Signal_rpc_member<Main> ack_dispatcher   { ep, *this, &Main::handle_ack };
+	Signal_rpc_member<Main> timer_dispatcher { ep, *this, &Main::handle_timer };
+
+	bool _start()
+	{
+		block.info(&blk_count, &blk_size, &blk_ops);
+
+		if (!blk_size || config.block_size % blk_size) {
+			PERR("block size %zu is not a multiple of the device's %zu",
+			     config.block_size, blk_size);
+			return false;
+		}
+
+		count = config.block_size/blk_size;
+
+		if (count > blk_count) {
+			PERR("block size exceeds device of %llu blocks", blk_count);
+			return false;
+		}
+
+		if (config.read_percent < 100 && !blk_ops.supported(Packet_descriptor::WRITE)) {
+			PERR("device is read-only");
+			return false;
+		}
+
+		depth = Genode::min(config.queue_depth, (unsigned)MAX_DEPTH);
+
+		for (unsigned i = 0; i < depth; i++)
+			slots[i].packet = block.tx()->alloc_packet(config.block_size);
+
+		printf("--- blk_bench: %s %u%% read, block size %zu, queue depth %u,"
+		       " %lu ms ---\n", config.random ? "random" : "sequential",
+		       config.read_percent, config.block_size, depth,
+		       config.duration_ms);
+
+		block.tx_channel()->sigh_ack_avail(ack_dispatcher);
+		timer.sigh(timer_dispatcher);
+		timer.trigger_periodic(1000*config.report_interval_ms);
+
+		running  = true;
+		start_ms = now_ms = timer.elapsed_ms();
+		last_ts  = Trace::timestamp();
+
+		for (unsigned i = 0; i < depth; i++, in_flight++)
+			_submit(slots[i]);
+
+		return true;
+	}
+
+	Main(Server::Entrypoint &ep) : ep(ep), rand_state(config.seed ? config.seed : 1)
+	{
+		reporter.enabled(config.report());
+
+		if (!_start())
+			PERR("benchmark not started");
+	}
+};
+
+
+namespace Server {
+
+	char const *name() { return "blk_bench_ep"; }
+
+	size_t stack_size() { return 2*1024*sizeof(long); }
+
+	void construct(Entrypoint &ep)
+	{
+		static Blk_bench::Main main(ep);
+	}
+}
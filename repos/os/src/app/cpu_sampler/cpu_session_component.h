@@ -0,0 +1,242 @@
+/*
+ * \brief  CPU session handed out to the profiled child
+ * \author Norman Feske
+ * \date   2015-12-28
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _CPU_SESSION_COMPONENT_H_
+#define _CPU_SESSION_COMPONENT_H_
+
+/* Genode includes */
+#include <base/rpc_server.h>
+#include <base/lock.h>
+#include <cpu_session/connection.h>
+#include <util/list.h>
+#include <util/string.h>
+
+/* local includes */
+#include "thread_profile.h"
+
+namespace Cpu_sampler {
+
+	using namespace Genode;
+
+	struct Thread_info;
+	class  Cpu_session_component;
+}
+
+
+/**
+ * Meta data of a thread created by the child
+ *
+ * The information is kept after the thread got killed so that its samples
+ * remain part of the profile.
+ */
+struct Cpu_sampler::Thread_info : List<Thread_info>::Element
+{
+	typedef String<Cpu_session::THREAD_NAME_LEN> Name;
+
+	Thread_capability const cap;
+	Name              const name;
+
+	bool started = false;
+	bool paused  = false;  /* paused by the child itself */
+	bool alive   = true;
+
+	Thread_profile profile;
+
+	Thread_info(Thread_capability cap, char const *name) : cap(cap), name(name) { }
+};
+
+
+/**
+ * CPU session that forwards all operations to a real CPU session
+ *
+ * Besides forwarding, the session component records the threads of the
+ * child so that they can be sampled.
+ */
+class Cpu_sampler::Cpu_session_component : public Rpc_object<Cpu_session>
+{
+	private:
+
+		Cpu_connection _parent;
+
+		Allocator &_md_alloc;
+
+		/*
+		 * The lock serializes the sampling with the operations of the
+		 * child, in particular with the child's own 'pause' and 'resume'
+		 * calls.
+		 */
+		Lock _lock;
+
+		List<Thread_info> _threads;
+
+		Thread_info *_lookup(Thread_capability cap)
+		{
+			for (Thread_info *t = _threads.first(); t; t = t->next())
+				if (t->alive && t->cap.local_name() == cap.local_name())
+					return t;
+
+			return nullptr;
+		}
+
+	public:
+
+		Cpu_session_component(char const *label, Allocator &md_alloc)
+		: _parent(label), _md_alloc(md_alloc) { }
+
+		~Cpu_session_component()
+		{
+			while (Thread_info *t = _threads.first()) {
+				_threads.remove(t);
+				destroy(&_md_alloc, t);
+			}
+		}
+
+		/**
+		 * Sample the instruction pointers of all running threads
+		 */
+		void sample()
+		{
+			Lock::Guard guard(_lock);
+
+			for (Thread_info *t = _threads.first(); t; t = t->next()) {
+
+				if (!t->alive || !t->started || t->paused)
+					continue;
+
+				_parent.pause(t->cap);
+
+				try {
+					t->profile.add(_parent.state(t->cap).ip);
+				} catch (Cpu_session::State_access_failed) {
+					t->profile.failed++;
+				}
+
+				_parent.resume(t->cap);
+			}
+		}
+
+		/**
+		 * Call 'fn' for each thread ever created by the child
+		 */
+		template <typename FN>
+		void for_each_thread(FN const &fn)
+		{
+			Lock::Guard guard(_lock);
+
+			for (Thread_info const *t = _threads.first(); t; t = t->next())
+				fn(*t);
+		}
+
+
+		/***************************
+		 ** CPU session interface **
+		 ***************************/
+
+		Thread_capability create_thread(size_t quota, Name const &name,
+		                                addr_t utcb) override
+		{
+			Thread_capability const cap = _parent.create_thread(quota, name, utcb);
+
+			Lock::Guard guard(_lock);
+			_threads.insert(new (&_md_alloc) Thread_info(cap, name.string()));
+			return cap;
+		}
+
+		Ram_dataspace_capability utcb(Thread_capability thread) override {
+			return _parent.utcb(thread); }
+
+		void kill_thread(Thread_capability thread) override
+		{
+			{
+				Lock::Guard guard(_lock);
+				if (Thread_info *t = _lookup(thread))
+					t->alive = false;
+			}
+			_parent.kill_thread(thread);
+		}
+
+		int set_pager(Thread_capability thread, Pager_capability pager) override {
+			return _parent.set_pager(thread, pager); }
+
+		int start(Thread_capability thread, addr_t ip, addr_t sp) override
+		{
+			int const result = _parent.start(thread, ip, sp);
+
+			Lock::Guard guard(_lock);
+			if (Thread_info *t = _lookup(thread))
+				t->started = (result == 0);
+			return result;
+		}
+
+		void pause(Thread_capability thread) override
+		{
+			Lock::Guard guard(_lock);
+
+			if (Thread_info *t = _lookup(thread))
+				t->paused = true;
+			_parent.pause(thread);
+		}
+
+		void resume(Thread_capability thread) override
+		{
+			Lock::Guard guard(_lock);
+
+			if (Thread_info *t = _lookup(thread))
+				t->paused = false;
+			_parent.resume(thread);
+		}
+
+		void cancel_blocking(Thread_capability thread) override {
+			_parent.cancel_blocking(thread); }
+
+		Thread_state state(Thread_capability thread) override {
+			return _parent.state(thread); }
+
+		void state(Thread_capability thread, Thread_state const &state) override {
+			_parent.state(thread, state); }
+
+		void exception_handler(Thread_capability thread,
+		                       Signal_context_capability handler) override {
+			_parent.exception_handler(thread, handler); }
+
+		void single_step(Thread_capability thread, bool enable) override {
+			_parent.single_step(thread, enable); }
+
+		Affinity::Space affinity_space() const override {
+			return _parent.affinity_space(); }
+
+		void affinity(Thread_capability thread, Affinity::Location location) override {
+			_parent.affinity(thread, location); }
+
+		Dataspace_capability trace_control() override {
+			return _parent.trace_control(); }
+
+		unsigned trace_control_index(Thread_capability thread) override {
+			return _parent.trace_control_index(thread); }
+
+		Dataspace_capability trace_buffer(Thread_capability thread) override {
+			return _parent.trace_buffer(thread); }
+
+		Dataspace_capability trace_policy(Thread_capability thread) override {
+			return _parent.trace_policy(thread); }
+
+		int ref_account(Cpu_session_capability cpu_session) override {
+			return _parent.ref_account(cpu_session); }
+
+		int transfer_quota(Cpu_session_capability cpu_session, size_t quota) override {
+			return _parent.transfer_quota(cpu_session, quota); }
+
+		Quota quota() override { return _parent.quota(); }
+};
+
+#endif /* _CPU_SESSION_COMPONENT_H_ */
@@ -0,0 +1,358 @@
+/*
+ * \brief  Sampling CPU profiler
+ * \author Norman Feske
+ * \date   2015-12-28
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/child.h>
+#include <base/service.h>
+#include <base/snprintf.h>
+#include <cap_session/connection.h>
+#include <pd_session/connection.h>
+#include <ram_session/connection.h>
+#include <rm_session/connection.h>
+#include <rom_session/connection.h>
+#include <timer_session/connection.h>
+#include <init/child_config.h>
+#include <init/child_policy.h>
+#include <os/config.h>
+#include <os/reporter.h>
+#include <util/volatile_object.h>
+
+/* local includes */
+#include "cpu_session_component.h"
+#include "symbol_table.h"
+
+namespace Cpu_sampler {
+
+	class Target_child;
+	struct Main;
+}
+
+
+/**
+ * Child executing the profiled program
+ *
+ * The child is created with a CPU session provided by the sampler. All
+ * other session requests are forwarded to the parent of the sampler.
+ */
+class Cpu_sampler::Target_child : public Child_policy
+{
+	public:
+
+		typedef String<64> Name;
+
+	private:
+
+		enum { STACK_SIZE = 8*1024*sizeof(long) };
+
+		Name const _name;
+
+		Init::Child_policy_enforce_labeling _labeling_policy { _name.string() };
+
+		Cap_connection _cap;
+		Rpc_entrypoint _entrypoint { &_cap, STACK_SIZE, "target_ep" };
+
+		Service_registry _parent_services;
+
+		Rom_connection _binary_rom;
+
+		Ram_connection _ram { _name.string() };
+		Rm_connection  _rm;
+		Pd_connection  _pd  { _name.string() };
+
+		Cpu_session_component _cpu { _name.string(), *env()->heap() };
+
+		Cpu_session_capability const _cpu_cap { _entrypoint.manage(&_cpu) };
+
+		size_t const _ram_quota;
+
+		bool _transfer_ram_quota()
+		{
+			_ram.ref_account(env()->ram_session_cap());
+			return env()->ram_session()->transfer_quota(_ram.cap(), _ram_quota) == 0;
+		}
+
+		bool const _ram_quota_transferred = _transfer_ram_quota();
+
+		Init::Child_config _config;
+
+		Init::Child_policy_provide_rom_file _binary_policy {
+			"binary", _binary_rom.dataspace(), &_entrypoint };
+
+		Init::Child_policy_provide_rom_file _config_policy {
+			"config", _config.dataspace(), &_entrypoint };
+
+		Init::Child_policy_redirect_rom_file _configfile_policy {
+			"config", _config.filename() };
+
+		volatile bool _exited     = false;
+		int           _exit_value = 0;
+
+		Child _child { _binary_rom.dataspace(), _pd.cap(), _ram.cap(), _cpu_cap,
+		               _rm.cap(), &_entrypoint, this };
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Rom_connection::Rom_connection_failed  binary is missing
+		 */
+		Target_child(Xml_node target)
+		:
+			_name(target.attribute_value("name", Name("target"))),
+			_binary_rom(target.attribute_value("binary", _name).string()),
+			_ram_quota(target.attribute_value("ram", (Number_of_bytes)0)),
+			_config(_ram.cap(), target)
+		{
+			if (!_ram_quota_transferred)
+				PWRN("could not transfer %zu bytes of RAM quota to \"%s\"",
+				     _ram_quota, _name.string());
+		}
+
+		~Target_child() { _entrypoint.dissolve(&_cpu); }
+
+		Cpu_session_component &cpu() { return _cpu; }
+
+		bool exited()     const { return _exited; }
+		int  exit_value() const { return _exit_value; }
+
+
+		/****************************
+		 ** Child-policy interface **
+		 ****************************/
+
+		char const *name() const override { return _name.string(); }
+
+		Service *resolve_session_request(char const *service_name,
+		                                 char const *args) override
+		{
+			Service *service = nullptr;
+
+			if ((service = _binary_policy.resolve_session_request(service_name, args)))
+				return service;
+
+			if ((service = _config_policy.resolve_session_request(service_name, args)))
+				return service;
+
+			service = _parent_services.find(service_name);
+			if (!service) {
+				service = new (env()->heap()) Parent_service(service_name);
+				_parent_services.insert(service);
+			}
+			return service;
+		}
+
+		void filter_session_args(char const *service, char *args,
+		                         size_t args_len) override
+		{
+			_labeling_policy.filter_session_args(service, args, args_len);
+			_configfile_policy.filter_session_args(service, args, args_len);
+		}
+
+		void exit(int exit_value) override
+		{
+			_exit_value = exit_value;
+			_exited     = true;
+		}
+};
+
+
+struct Cpu_sampler::Main
+{
+	Xml_node const config = Genode::config()->xml_node();
+
+	unsigned long const sample_interval_ms =
+		max(config.attribute_value("sample_interval_ms", 10UL), 1UL);
+
+	unsigned long const report_interval_ms =
+		max(config.attribute_value("report_interval_ms", 1000UL), 1UL);
+
+	/* number of most frequent entries reported per thread */
+	unsigned const top = config.attribute_value("top", 16U);
+
+	Timer::Connection timer;
+
+	Reporter reporter { "cpu_profile", 64*1024, 1024*1024 };
+
+	Lazy_volatile_object<Symbol_table> symbols;
+
+	Target_child target { config.sub_node("target") };
+
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	bool _report_enabled() const
+	{
+		try {
+			return config.sub_node("report").attribute("profile").has_value("yes");
+		} catch (...) { return false; }
+	}
+
+	void _import_symbols()
+	{
+		typedef String<64> Rom_name;
+
+		Rom_name const rom_name =
+			config.sub_node("target").attribute_value("symbols", Rom_name());
+
+		if (!rom_name.valid())
+			return;
+
+		try { symbols.construct(rom_name.string()); }
+		catch (...) { PERR("could not obtain symbols from \"%s\"", rom_name.string()); }
+	}
+
+	/**
+	 * Aggregate samples of a thread by function
+	 *
+	 * Samples outside of any known function are kept at their instruction
+	 * pointer.
+	 */
+	void _resolve(Thread_profile const &raw, Thread_profile &resolved)
+	{
+		resolved.failed = raw.failed;
+
+		for (unsigned i = 0; i < Thread_profile::MAX_ENTRIES; i++) {
+			Thread_profile::Entry const &e = raw.entries[i];
+			if (!e.count)
+				continue;
+
+			Symbol_table::Symbol const *s = symbols.is_constructed()
+			                              ? symbols->lookup(e.ip) : nullptr;
+
+			resolved.add(s ? s->addr : e.ip, e.count);
+		}
+		resolved.dropped += raw.dropped;
+		resolved.samples += raw.dropped;
+	}
+
+	/* scratch profile used for generating reports */
+	Thread_profile resolved;
+
+	void _generate(Xml_generator &xml, Thread_info const &thread)
+	{
+		resolved.reset();
+		_resolve(thread.profile, resolved);
+
+		xml.attribute("name",    thread.name.string());
+		xml.attribute("state",   thread.alive ? "alive" : "killed");
+		xml.attribute("samples", resolved.samples);
+		xml.attribute("failed",  resolved.failed);
+		xml.attribute("dropped", resolved.dropped);
+
+		resolved.for_each_top(top, [&] (Thread_profile::Entry const &e) {
+			xml.node("entry", [&] () {
+
+				char addr[24];
+				snprintf(addr, sizeof(addr), "0x%lx", e.ip);
+				xml.attribute("addr", addr);
+
+				xml.attribute("count", e.count);
+				xml.attribute("permille", resolved.samples
+				                          ? e.count*1000/resolved.samples : 0);
+
+				Symbol_table::Symbol const *s = symbols.is_constructed()
+				                              ? symbols->lookup(e.ip) : nullptr;
+				if (s && s->addr == e.ip)
+					xml.attribute("function", s->name);
+			});
+		});
+	}
+
+	void _report()
+	{
+		if (!reporter.is_enabled())
+			return;
+
+		Reporter::Xml_generator xml(reporter, [&] () {
+			xml.attribute("target",      target.name());
+			xml.attribute("state",       target.exited() ? "exited" : "running");
+			xml.attribute("elapsed_ms",  timer.elapsed_ms() - start_ms);
+			xml.attribute("interval_ms", sample_interval_ms);
+
+			target.cpu().for_each_thread([&] (Thread_info const &thread) {
+				xml.node("thread", [&] () { _generate(xml, thread); }); });
+		});
+	}
+
+	void _log()
+	{
+		target.cpu().for_each_thread([&] (Thread_info const &thread) {
+
+			resolved.reset();
+			_resolve(thread.profile, resolved);
+
+			printf("thread \"%s\": %lu samples, %lu failed, %lu dropped\n",
+			       thread.name.string(), resolved.samples, resolved.failed,
+			       resolved.dropped);
+
+			resolved.for_each_top(top, [&] (Thread_profile::Entry const &e) {
+
+				Symbol_table::Symbol const *s = symbols.is_constructed()
+				                              ? symbols->lookup(e.ip) : nullptr;
+
+				printf("  %5lu.%lu%% 0x%08lx %s\n",
+				       e.count*100/max(resolved.samples, 1UL),
+				       (e.count*1000/max(resolved.samples, 1UL)) % 10, e.ip,
+				       (s && s->addr == e.ip) ? s->name : "");
+			});
+		});
+	}
+
+	Main()
+	{
+		reporter.enabled(_report_enabled());
+		_import_symbols();
+
+		printf("--- cpu_sampler: sampling \"%s\" every %lu ms ---\n",
+		       target.name(), sample_interval_ms);
+	}
+
+	/**
+	 * Sample the target until it exits
+	 *
+	 * \return  exit value of the target
+	 */
+	int run()
+	{
+		unsigned long next_report_ms = start_ms + report_interval_ms;
+
+		while (!target.exited()) {
+
+			timer.msleep(sample_interval_ms);
+			target.cpu().sample();
+
+			if (timer.elapsed_ms() >= next_report_ms) {
+				_report();
+				next_report_ms += report_interval_ms;
+			}
+		}
+
+		_report();
+		_log();
+
+		printf("--- cpu_sampler: \"%s\" exited with value %d ---\n",
+		       target.name(), target.exit_value());
+
+		return target.exit_value();
+	}
+};
+
+
+int main(int, char **)
+{
+	using namespace Genode;
+
+	static Cpu_sampler::Main main;
+
+	return main.run();
+}
@@ -0,0 +1,225 @@
+/*
+ * \brief  Function symbols of an ELF binary
+ * \author Norman Feske
+ * \date   2015-12-28
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _SYMBOL_TABLE_H_
+#define _SYMBOL_TABLE_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <util/string.h>
+#include <os/attached_rom_dataspace.h>
+
+namespace Cpu_sampler { class Symbol_table; }
+
+
+/**
+ * Lookup of function symbols
+ *
+ * The symbols are taken from the '.symtab' section of an ELF binary of the
+ * native word width that is provided as ROM module. Because binaries are
+ * usually stripped when installed into the boot image, the ROM module is
+ * typically the unstripped variant of the profiled binary.
+ */
+class Cpu_sampler::Symbol_table
+{
+	public:
+
+		typedef Genode::addr_t addr_t;
+		typedef Genode::size_t size_t;
+
+		struct Symbol
+		{
+			addr_t      addr;
+			size_t      size;
+			char const *name;
+		};
+
+	private:
+
+		/*
+		 * ELF structures, only the parts needed for finding the symbols
+		 */
+
+		struct Ehdr
+		{
+			unsigned char  ident[16];
+			Genode::uint16_t type, machine;
+			Genode::uint32_t version;
+			addr_t         entry, phoff, shoff;
+			Genode::uint32_t flags;
+			Genode::uint16_t ehsize, phentsize, phnum, shentsize, shnum, shstrndx;
+		};
+
+		struct Shdr
+		{
+			Genode::uint32_t name, type;
+			addr_t           flags, addr, offset, size;
+			Genode::uint32_t link, info;
+			addr_t           addralign, entsize;
+		};
+
+#ifdef _LP64
+		struct Sym
+		{
+			Genode::uint32_t name;
+			unsigned char    info, other;
+			Genode::uint16_t shndx;
+			addr_t           value, size;
+		};
+#else
+		struct Sym
+		{
+			Genode::uint32_t name;
+			addr_t           value, size;
+			unsigned char    info, other;
+			Genode::uint16_t shndx;
+		};
+#endif
+
+		enum { SHT_SYMTAB = 2, STT_FUNC = 2 };
+
+		Genode::Attached_rom_dataspace _rom;
+
+		Symbol   *_symbols = nullptr;
+		unsigned  _count   = 0;
+
+		/**
+		 * Return pointer to 'size' bytes at 'offset' of the ROM module
+		 *
+		 * \return nullptr if the range exceeds the ROM module
+		 */
+		template <typename T>
+		T const *_at(addr_t offset, size_t size = sizeof(T))
+		{
+			if (offset > _rom.size() || size > _rom.size() - offset)
+				return nullptr;
+
+			return (T const *)(_rom.local_addr<char>() + offset);
+		}
+
+		void _sort()
+		{
+			/* shell sort, using the gap sequence of Knuth */
+			unsigned gap = 1;
+			while (gap < _count/3)
+				gap = 3*gap + 1;
+
+			for (; gap > 0; gap /= 3)
+				for (unsigned i = gap; i < _count; i++) {
+					Symbol const s = _symbols[i];
+					unsigned j = i;
+					for (; j >= gap && _symbols[j - gap].addr > s.addr; j -= gap)
+						_symbols[j] = _symbols[j - gap];
+					_symbols[j] = s;
+				}
+		}
+
+		void _import()
+		{
+			Ehdr const *ehdr = _at<Ehdr>(0);
+
+			if (!ehdr || Genode::strcmp((char const *)ehdr->ident, "\177ELF", 4)
+			 || ehdr->ident[4] != (sizeof(addr_t) == 8 ? 2 : 1)) {
+				PERR("ROM module is no ELF binary of the native word width");
+				return;
+			}
+
+			Shdr const *shdrs = _at<Shdr>(ehdr->shoff, ehdr->shnum*sizeof(Shdr));
+			if (!shdrs || ehdr->shentsize != sizeof(Shdr)) {
+				PERR("invalid ELF section headers");
+				return;
+			}
+
+			for (unsigned i = 0; i < ehdr->shnum; i++) {
+
+				Shdr const &symtab = shdrs[i];
+				if (symtab.type != SHT_SYMTAB || symtab.link >= ehdr->shnum)
+					continue;
+
+				Shdr const &strtab = shdrs[symtab.link];
+
+				unsigned const num = symtab.size/sizeof(Sym);
+
+				Sym  const *syms = _at<Sym> (symtab.offset, num*sizeof(Sym));
+				char const *strs = _at<char>(strtab.offset, strtab.size);
+				if (!syms || !strs || !strtab.size || strs[strtab.size - 1])
+					continue;
+
+				_symbols = (Symbol *)Genode::env()->heap()->alloc(num*sizeof(Symbol));
+
+				for (unsigned j = 0; j < num; j++) {
+					Sym const &sym = syms[j];
+					if ((sym.info & 0xf) != STT_FUNC || !sym.value
+					 || sym.name >= strtab.size)
+						continue;
+
+					_symbols[_count++] = { sym.value, sym.size, strs + sym.name };
+				}
+				break;
+			}
+
+			if (!_count)
+				PWRN("ELF binary lacks function symbols");
+
+			_sort();
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Rom_connection::Rom_connection_failed
+		 */
+		Symbol_table(char const *rom_name) : _rom(rom_name) { _import(); }
+
+		~Symbol_table()
+		{
+			if (_symbols)
+				Genode::env()->heap()->free(_symbols, 0);
+		}
+
+		unsigned count() const { return _count; }
+
+		/**
+		 * Return function containing address 'ip'
+		 *
+		 * \return nullptr if the address is not covered by any function
+		 */
+		Symbol const *lookup(addr_t ip) const
+		{
+			/* find last symbol starting at or below 'ip' */
+			unsigned lo = 0, hi = _count;
+			while (lo < hi) {
+				unsigned const mid = (lo + hi)/2;
+				if (_symbols[mid].addr <= ip)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+
+			if (lo == 0)
+				return nullptr;
+
+			Symbol const &s = _symbols[lo - 1];
+
+			/* symbols of unknown size extend up to the next symbol */
+			if (s.size && ip - s.addr >= s.size)
+				return nullptr;
+
+			return &s;
+		}
+};
+
+#endif /* _SYMBOL_TABLE_H_ */
@@ -0,0 +1,3 @@
+TARGET = cpu_sampler
+SRC_CC = main.cc
+LIBS  += base config
@@ -0,0 +1,136 @@
+/*
+ * \brief  Histogram of the instruction pointers sampled from one thread
+ * \author Norman Feske
+ * \date   2015-12-28
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _THREAD_PROFILE_H_
+#define _THREAD_PROFILE_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+
+namespace Cpu_sampler { struct Thread_profile; }
+
+
+/**
+ * Bounded table of sample counts, indexed by instruction pointer
+ *
+ * The table uses open addressing. Once it is full, samples of new
+ * instruction pointers are only accounted as dropped.
+ */
+struct Cpu_sampler::Thread_profile
+{
+	typedef Genode::addr_t addr_t;
+
+	enum { MAX_ENTRIES = 1024 };
+
+	struct Entry
+	{
+		addr_t        ip    = 0;
+		unsigned long count = 0;  /* zero marks an unused entry */
+	};
+
+	Entry entries[MAX_ENTRIES];
+
+	unsigned used = 0;
+
+	unsigned long samples = 0;  /* successfully obtained samples */
+	unsigned long dropped = 0;  /* samples not fitting into the table */
+	unsigned long failed  = 0;  /* failed attempts to obtain the state */
+
+	static unsigned _hash(addr_t ip)
+	{
+		/* instructions are at least two bytes apart on most CPUs */
+		return (unsigned)((ip >> 1) ^ (ip >> 13)) % MAX_ENTRIES;
+	}
+
+	/**
+	 * Discard all samples
+	 */
+	void reset()
+	{
+		for (unsigned i = 0; i < MAX_ENTRIES; i++)
+			entries[i] = Entry();
+
+		used = 0;
+		samples = dropped = failed = 0;
+	}
+
+	/**
+	 * Account sample at instruction pointer 'ip' with weight 'count'
+	 */
+	void add(addr_t ip, unsigned long count = 1)
+	{
+		samples += count;
+
+		for (unsigned i = _hash(ip), n = 0; n < MAX_ENTRIES;
+		     i = (i + 1) % MAX_ENTRIES, n++) {
+
+			Entry &e = entries[i];
+
+			if (e.count && e.ip != ip)
+				continue;
+
+			if (!e.count) {
+				e.ip = ip;
+				used++;
+			}
+			e.count += count;
+			return;
+		}
+		dropped += count;
+	}
+
+	/**
+	 * Call 'fn' for the at most 'n' most frequent entries
+	 *
+	 * The entries are visited in the order of decreasing sample counts.
+	 */
+	template <typename FN>
+	void for_each_top(unsigned n, FN const &fn) const
+	{
+		/* sort key of the entry visited last */
+		unsigned long limit = 0;
+		addr_t        last  = 0;
+
+		for (unsigned visited = 0; visited < n; visited++) {
+
+			/*
+			 * Select the largest entry that sorts after the one visited
+			 * last, with ties broken by the instruction pointer.
+			 */
+			Entry const *best = nullptr;
+			for (unsigned i = 0; i < MAX_ENTRIES; i++) {
+				Entry const &e = entries[i];
+
+				if (!e.count)
+					continue;
+
+				if (visited && (e.count > limit
+				             || (e.count == limit && e.ip >= last)))
+					continue;
+
+				if (!best || e.count > best->count
+				 || (e.count == best->count && e.ip > best->ip))
+					best = &e;
+			}
+
+			if (!best)
+				return;
+
+			fn(*best);
+			limit = best->count;
+			last  = best->ip;
+		}
+	}
+};
+
+#endif /* _THREAD_PROFILE_H_ */
@@ -0,0 +1,238 @@
+/*
+ * \brief  Latency histograms of the RPCs issued and served by a thread
+ * \author Norman Feske
+ * \date   2015-12-19
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LATENCY_H_
+#define _LATENCY_H_
+
+/* Genode includes */
+#include <util/list.h>
+#include <util/string.h>
+#include <util/misc_math.h>
+#include <util/xml_generator.h>
+#include <base/allocator.h>
+#include <trace/binary_event.h>
+
+namespace Trace_recorder {
+
+	struct Histogram;
+	class  Rpc_latency;
+}
+
+
+/**
+ * Histogram with logarithmically sized buckets
+ *
+ * Bucket n counts the samples of at least 2^n and less than 2^(n+1)
+ * cycles. The first bucket also counts samples of zero cycles.
+ */
+struct Trace_recorder::Histogram
+{
+	enum { NUM_BUCKETS = 48 };
+
+	Genode::uint64_t buckets[NUM_BUCKETS] { };
+	Genode::uint64_t count = 0;
+	Genode::uint64_t max   = 0;
+
+	void add(Genode::uint64_t cycles)
+	{
+		unsigned const n = cycles ? Genode::log2(cycles) : 0;
+
+		buckets[Genode::min(n, (unsigned)NUM_BUCKETS - 1)]++;
+		count++;
+		max = Genode::max(max, cycles);
+	}
+
+	/**
+	 * Return upper bound of the bucket that contains the given percentile
+	 */
+	Genode::uint64_t percentile(unsigned percent) const
+	{
+		Genode::uint64_t const threshold = (count*percent + 99)/100;
+
+		Genode::uint64_t sum = 0;
+		for (unsigned n = 0; n < NUM_BUCKETS; n++) {
+			sum += buckets[n];
+			if (sum >= threshold)
+				return ((Genode::uint64_t)2 << n) - 1;
+		}
+		return max;
+	}
+};
+
+
+/**
+ * Latencies of RPCs, obtained from the binary trace events of one thread
+ *
+ * The client-side latency is the time between the 'RPC_CALL' and the
+ * 'RPC_RETURNED' event, which includes the transfer to the server and the
+ * time the request waits for being dispatched. The server-side latency is
+ * the time between the 'RPC_DISPATCH' and 'RPC_REPLY' event. Both are
+ * accounted per RPC function. A thread issues at most one RPC at a time
+ * and an entrypoint dispatches one request at a time, so the events of
+ * each kind are paired with the most recent event of the counterpart.
+ */
+class Trace_recorder::Rpc_latency
+{
+	public:
+
+		typedef Genode::String<Genode::Trace::Binary_event::MAX_NAME_LEN + 1> Name;
+
+		enum Side { CLIENT, SERVER };
+
+	private:
+
+		typedef Genode::Trace::Binary_event Binary_event;
+		typedef Genode::uint64_t            uint64_t;
+
+		/* upper bound for the histograms of one thread */
+		enum { MAX_ENTRIES = 64 };
+
+		struct Entry : Genode::List<Entry>::Element
+		{
+			Name const name;
+			Side const side;
+			Histogram  histogram;
+
+			Entry(Name const &name, Side side) : name(name), side(side) { }
+		};
+
+		struct Pending
+		{
+			bool     valid = false;
+			uint64_t timestamp = 0;
+			Name     name;
+		};
+
+		Genode::Allocator   &_alloc;
+		Genode::List<Entry>  _entries;
+		unsigned             _num_entries = 0;
+		Pending              _call, _dispatch;
+
+		static Name _name(Binary_event const &event)
+		{
+			char buf[Name::capacity()];
+			Genode::size_t const len = Genode::min((Genode::size_t)event.name_len,
+			                                       sizeof(buf) - 1);
+			Genode::memcpy(buf, event.name, len);
+			buf[len] = 0;
+
+			return Name(buf);
+		}
+
+		/**
+		 * Return cycles between the timestamps 'start' and 'end'
+		 *
+		 * Timestamp counters narrower than 64 bit, as used on ARM, wrap
+		 * within seconds.
+		 */
+		static uint64_t _cycles(uint64_t start, uint64_t end)
+		{
+			return end >= start ? end - start : (Genode::uint32_t)(end - start);
+		}
+
+		Entry *_entry(Name const &name, Side side)
+		{
+			for (Entry *e = _entries.first(); e; e = e->next())
+				if (e->side == side && e->name == name)
+					return e;
+
+			if (_num_entries == MAX_ENTRIES)
+				return nullptr;
+
+			Entry *e = new (&_alloc) Entry(name, side);
+			_entries.insert(e);
+			_num_entries++;
+			return e;
+		}
+
+		void _start(Pending &pending, Binary_event const &event)
+		{
+			pending.valid     = true;
+			pending.timestamp = event.timestamp;
+			pending.name      = _name(event);
+		}
+
+		void _finish(Pending &pending, Binary_event const &event, Side side)
+		{
+			if (!pending.valid)
+				return;
+
+			pending.valid = false;
+
+			Name const name = _name(event);
+			if (!(name == pending.name))
+				return;
+
+			if (Entry *e = _entry(name, side))
+				e->histogram.add(_cycles(pending.timestamp, event.timestamp));
+		}
+
+	public:
+
+		Rpc_latency(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Rpc_latency()
+		{
+			while (Entry *e = _entries.first()) {
+				_entries.remove(e);
+				Genode::destroy(&_alloc, e);
+			}
+		}
+
+		void account(Binary_event const &event)
+		{
+			switch (event.type) {
+			case Binary_event::RPC_CALL:     _start(_call, event);             break;
+			case Binary_event::RPC_RETURNED: _finish(_call, event, CLIENT);    break;
+			case Binary_event::RPC_DISPATCH: _start(_dispatch, event);         break;
+			case Binary_event::RPC_REPLY:    _finish(_dispatch, event, SERVER); break;
+			default: break;
+			}
+		}
+
+		/**
+		 * Forget pending RPCs, called whenever events got lost
+		 */
+		void discard_pending() { _call.valid = _dispatch.valid = false; }
+
+		bool empty() const { return !_entries.first(); }
+
+		void report(Genode::Xml_generator &xml) const
+		{
+			for (Entry const *e = _entries.first(); e; e = e->next()) {
+				xml.node("rpc", [&] () {
+
+					Histogram const &h = e->histogram;
+
+					xml.attribute("name",  e->name);
+					xml.attribute("side",  e->side == CLIENT ? "client" : "server");
+					xml.attribute("count", (unsigned long long)h.count);
+					xml.attribute("p50",   (unsigned long long)h.percentile(50));
+					xml.attribute("p99",   (unsigned long long)h.percentile(99));
+					xml.attribute("max",   (unsigned long long)h.max);
+
+					for (unsigned n = 0; n < Histogram::NUM_BUCKETS; n++) {
+						if (!h.buckets[n])
+							continue;
+
+						xml.node("bucket", [&] () {
+							xml.attribute("below", (unsigned long long)2 << n);
+							xml.attribute("count", (unsigned long long)h.buckets[n]);
+						});
+					}
+				});
+			}
+		}
+};
+
+#endif /* _LATENCY_H_ */
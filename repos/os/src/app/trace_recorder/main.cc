@@ -0,0 +1,604 @@
+/*
+ * \brief  Component that records trace buffers to a file system
+ * \author Norman Feske
+ * \date   2015-12-18
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <trace_session/connection.h>
+#include <timer_session/connection.h>
+#include <rom_session/connection.h>
+#include <file_system_session/connection.h>
+#include <file_system/util.h>
+#include <dataspace/client.h>
+#include <base/allocator_avl.h>
+#include <base/snprintf.h>
+#include <os/server.h>
+#include <os/config.h>
+#include <os/reporter.h>
+#include <trace/binary_event.h>
+
+/* local includes */
+#include "latency.h"
+
+
+namespace Server { struct Main; }
+
+namespace Trace_recorder {
+
+	using namespace Genode;
+
+	typedef Trace::Binary_event Binary_event;
+
+	struct Packet;
+	class  Subject;
+
+	File_system::File_handle create_file(File_system::Session &,
+	                                     File_system::Dir_handle,
+	                                     char const *name);
+
+	void write_metadata(File_system::Session &, File_system::Dir_handle,
+	                    unsigned long clock_freq);
+}
+
+
+/**
+ * Create empty file, replacing the content of an existing one
+ */
+File_system::File_handle
+Trace_recorder::create_file(File_system::Session &fs, File_system::Dir_handle dir,
+                            char const *name)
+{
+	try {
+		return fs.file(dir, name, File_system::WRITE_ONLY, true);
+	} catch (File_system::Node_already_exists) {
+		File_system::File_handle const file =
+			fs.file(dir, name, File_system::WRITE_ONLY, false);
+		fs.truncate(file, 0);
+		return file;
+	}
+}
+
+
+/**
+ * CTF packet, which holds the events drained from one trace buffer at once
+ *
+ * The events are stored in the layout of the 'binary' trace policy, which
+ * is described by the CTF metadata written by 'write_metadata'.
+ */
+struct Trace_recorder::Packet
+{
+	enum { SIZE = 16*1024, MAGIC = 0xc1fc1fc1 };
+
+	struct Header
+	{
+		uint32_t magic;
+		uint32_t stream_id;
+		uint64_t timestamp_begin;
+		uint64_t timestamp_end;
+		uint64_t content_size;      /* in bits */
+		uint64_t packet_size;       /* in bits */
+		uint64_t events_discarded;
+		uint32_t cpu_id;
+		uint32_t subject_id;
+
+	} __attribute__((packed));
+
+	char   buf[SIZE];
+	size_t used = sizeof(Header);
+
+	Header &header() { return *(Header *)buf; }
+
+	void reset()
+	{
+		header() = Header();
+		used = sizeof(Header);
+	}
+
+	bool empty() const { return used == sizeof(Header); }
+
+	bool fits(size_t len) const { return used + len <= SIZE; }
+
+	/**
+	 * Return space for an event of 'len' bytes
+	 */
+	char *tail() { return buf + used; }
+
+	/**
+	 * Add event that was copied to 'tail'
+	 */
+	void commit(size_t len)
+	{
+		Binary_event const &event = *(Binary_event const *)tail();
+
+		if (empty())
+			header().timestamp_begin = event.timestamp;
+
+		header().timestamp_end = event.timestamp;
+		used += len;
+	}
+};
+
+
+/**
+ * Trace subject whose trace buffer is recorded to a file
+ */
+class Trace_recorder::Subject : public List<Subject>::Element
+{
+	private:
+
+		/*
+		 * Maximum number of bytes written by the traced thread ahead of
+		 * the head offset, i.e., the maximum size of an event in progress
+		 */
+		enum { MARGIN = 256 };
+
+		Trace::Subject_id  const  _id;
+		Trace::Session_label      _label;
+		Trace::Thread_name        _thread;
+		unsigned           const  _cpu;
+		Trace::Buffer      const &_buffer;
+		File_system::Session     &_fs;
+		File_system::File_handle  _file;
+		File_system::seek_off_t   _seek = 0;
+
+		/* read position */
+		unsigned _round  = 0;
+		unsigned _offset = 0;
+
+		/* number of times the writer overtook the read position */
+		uint64_t _gaps = 0;
+
+		Rpc_latency _latency { *env()->heap() };
+
+		/**
+		 * Return true if the entry at 'offset' of 'round' was not overwritten
+		 */
+		bool _intact(unsigned round, unsigned offset) const
+		{
+			unsigned const wrapped = _buffer.wrapped();
+
+			return wrapped == round
+			    || (wrapped == round + 1
+			     && _buffer.head_offset() + MARGIN <= offset);
+		}
+
+		/**
+		 * Continue reading at the oldest entry that is known to be intact
+		 */
+		void _skip_lost_events()
+		{
+			_round  = _buffer.wrapped();
+			_offset = 0;
+			_gaps++;
+
+			_latency.discard_pending();
+		}
+
+		void _flush(Packet &packet)
+		{
+			Packet::Header &header = packet.header();
+
+			header.magic            = Packet::MAGIC;
+			header.content_size     = packet.used*8;
+			header.packet_size      = packet.used*8;
+			header.events_discarded = _gaps;
+			header.cpu_id           = _cpu;
+			header.subject_id       = _id.id;
+
+			_seek += File_system::write(_fs, _file, packet.buf, packet.used, _seek);
+
+			packet.reset();
+		}
+
+		static File_system::File_handle _create_file(File_system::Session &fs,
+		                                             File_system::Dir_handle dir,
+		                                             Trace::Subject_id id,
+		                                             Trace::Subject_info const &info)
+		{
+			char name[File_system::MAX_NAME_LEN];
+			snprintf(name, sizeof(name), "%u.%s", id.id, info.thread_name().string());
+
+			for (char *p = name; *p; p++)
+				if (*p == '/') *p = '_';
+
+			return create_file(fs, dir, name);
+		}
+
+	public:
+
+		Subject(Trace::Subject_id id, Trace::Subject_info const &info,
+		        Dataspace_capability buffer_ds, File_system::Session &fs,
+		        File_system::Dir_handle dir)
+		:
+			_id(id), _label(info.session_label()), _thread(info.thread_name()),
+			_cpu(info.affinity().xpos()),
+			_buffer(*(Trace::Buffer *)env()->rm_session()->attach(buffer_ds)),
+			_fs(fs), _file(_create_file(fs, dir, id, info))
+		{ }
+
+		~Subject()
+		{
+			_fs.close(_file);
+			env()->rm_session()->detach(&_buffer);
+		}
+
+		Trace::Subject_id id() const { return _id; }
+
+		/**
+		 * Write events produced since the last call to the file
+		 *
+		 * \param packet  buffer used for assembling the packets
+		 */
+		void drain(Packet &packet)
+		{
+			packet.reset();
+
+			unsigned const wrapped = _buffer.wrapped();
+			unsigned const head    = _buffer.head_offset();
+
+			if (!_intact(_round, _offset))
+				_skip_lost_events();
+
+			while (_round < wrapped || _offset < head) {
+
+				Trace::Buffer::Entry const entry = _buffer.entry(_offset);
+
+				/* reached the end of the previous round */
+				if (entry.is_last()) {
+					if (_round >= wrapped)
+						break;
+
+					_round++;
+					_offset = 0;
+					continue;
+				}
+
+				unsigned const offset = _offset;
+				size_t   const len    = entry.length();
+
+				_offset = _buffer.offset_after(entry);
+
+				/* skip events not produced by the binary policy */
+				if (len > Packet::SIZE - sizeof(Packet::Header))
+					continue;
+
+				if (!packet.fits(len))
+					_flush(packet);
+
+				memcpy(packet.tail(), entry.data(), len);
+
+				if (!_intact(_round, offset)) {
+					_skip_lost_events();
+					continue;
+				}
+
+				Binary_event const &event = *(Binary_event const *)packet.tail();
+
+				if (!event.valid(len))
+					continue;
+
+				_latency.account(event);
+				packet.commit(len);
+			}
+
+			if (!packet.empty())
+				_flush(packet);
+		}
+
+		/**
+		 * Report RPC latencies observed since the start of the recording
+		 */
+		void report_latency(Xml_generator &xml) const
+		{
+			if (_latency.empty())
+				return;
+
+			xml.node("subject", [&] () {
+				xml.attribute("label",  _label.string());
+				xml.attribute("thread", _thread.string());
+				xml.attribute("id",     _id.id);
+				_latency.report(xml);
+			});
+		}
+};
+
+
+/**
+ * Write CTF metadata that describes the recorded trace streams
+ *
+ * \param clock_freq  frequency of 'Trace::timestamp' in Hz
+ */
+void Trace_recorder::write_metadata(File_system::Session &fs,
+                                    File_system::Dir_handle dir,
+                                    unsigned long clock_freq)
+{
+	static char buf[4096];
+	size_t used = 0;
+
+	auto append = [&] (char const *format, char const *name, unsigned long value) {
+		used += snprintf(buf + used, sizeof(buf) - used, format, name, value); };
+
+	append("/* CTF 1.8 */\n"
+	       "\n"
+	       "typealias integer { size = 8;  align = 8; signed = false; } := uint8_t;\n"
+	       "typealias integer { size = 16; align = 8; signed = false; } := uint16_t;\n"
+	       "typealias integer { size = 32; align = 8; signed = false; } := uint32_t;\n"
+	       "typealias integer { size = 64; align = 8; signed = false; } := uint64_t;\n"
+	       "\n"
+	       "trace {\n"
+	       "\tmajor = 1;\n"
+	       "\tminor = 8;\n"
+	       "\tbyte_order = le;\n"
+	       "\tpacket.header := struct {\n"
+	       "\t\tuint32_t magic;\n"
+	       "\t\tuint32_t stream_id;\n"
+	       "\t};\n"
+	       "};\n"
+	       "\n"
+	       "clock {\n"
+	       "\tname = %s;\n"
+	       "\tfreq = %lu;\n"
+	       "};\n"
+	       "\n"
+	       "typealias integer {\n"
+	       "\tsize = 64; align = 8; signed = false;\n"
+	       "\tmap = clock.cycles.value;\n"
+	       "} := cycles_t;\n"
+	       "\n"
+	       "stream {\n"
+	       "\tid = 0;\n"
+	       "\tpacket.context := struct {\n"
+	       "\t\tcycles_t timestamp_begin;\n"
+	       "\t\tcycles_t timestamp_end;\n"
+	       "\t\tuint64_t content_size;\n"
+	       "\t\tuint64_t packet_size;\n"
+	       "\t\tuint64_t events_discarded;\n"
+	       "\t\tuint32_t cpu_id;\n"
+	       "\t\tuint32_t subject_id;\n"
+	       "\t};\n"
+	       "\tevent.header := struct {\n"
+	       "\t\tcycles_t timestamp;\n"
+	       "\t\tuint8_t  id;\n"
+	       "\t};\n"
+	       "};\n", "cycles", clock_freq);
+
+	static char const *event_names[] = {
+		"rpc_call", "rpc_returned", "rpc_dispatch", "rpc_reply",
+		"signal_submit", "signal_received" };
+
+	for (unsigned i = 0; i < sizeof(event_names)/sizeof(event_names[0]); i++)
+		append("\n"
+		       "event {\n"
+		       "\tname = %s;\n"
+		       "\tid = %lu;\n"
+		       "\tstream_id = 0;\n"
+		       "\tfields := struct {\n"
+		       "\t\tuint8_t  name_len;\n"
+		       "\t\tuint16_t reserved;\n"
+		       "\t\tuint32_t value;\n"
+		       "\t\tinteger { size = 8; align = 8; signed = false; encoding = UTF8; }"
+		       " name[name_len];\n"
+		       "\t};\n"
+		       "};\n", event_names[i], Binary_event::RPC_CALL + i);
+
+	File_system::File_handle const file = create_file(fs, dir, "metadata");
+	File_system::Handle_guard guard(fs, file);
+
+	File_system::write(fs, file, buf, used);
+}
+
+
+struct Server::Main
+{
+	typedef Trace_recorder::Subject Subject;
+	typedef Trace_recorder::Packet  Packet;
+
+	Entrypoint &ep;
+
+	/*
+	 * The trace buffers are allocated from the quota of the TRACE
+	 * session, which suffices for 48 buffers of 64 KiB.
+	 */
+	enum { TRACE_RAM_QUOTA = 4*1024*1024, ARG_BUFFER_SIZE = 32*1024 };
+
+	enum { MAX_SUBJECTS = 512 };
+
+	Genode::Trace::Connection trace { TRACE_RAM_QUOTA, ARG_BUFFER_SIZE, 0 };
+
+	Timer::Connection timer;
+
+	Genode::Allocator_avl   fs_tx_alloc { Genode::env()->heap() };
+	File_system::Connection fs          { fs_tx_alloc };
+
+	Genode::Xml_node config = Genode::config()->xml_node();
+
+	unsigned long period_ms = config.attribute_value("period_ms", 100UL);
+
+	Genode::size_t buffer_size =
+		config.attribute_value("buffer_size", (Genode::size_t)64*1024);
+
+	unsigned long clock_freq = config.attribute_value("clock_freq", 1000000000UL);
+
+	File_system::Dir_handle dir = _open_dir();
+
+	Genode::Trace::Policy_id policy_id = _load_policy();
+
+	Genode::List<Subject> subjects;
+
+	Genode::Trace::Subject_id subject_ids[MAX_SUBJECTS];
+
+	Packet packet;
+
+	/*
+	 * Report of the RPC latencies, enabled via '<report latency="yes"/>'
+	 */
+	Genode::Reporter latency_reporter { "rpc_latency", 64*1024 };
+
+	bool _latency_report_enabled() const
+	{
+		try {
+			return config.sub_node("report").attribute("latency").has_value("yes");
+		} catch (...) { return false; }
+	}
+
+	File_system::Dir_handle _open_dir()
+	{
+		char path[File_system::MAX_PATH_LEN] = "/";
+		try { config.attribute("path").value(path, sizeof(path)); }
+		catch (...) { }
+
+		return File_system::ensure_dir(fs, path);
+	}
+
+	Genode::Trace::Policy_id _load_policy()
+	{
+		char name[64] = "binary";
+		try { config.attribute("policy").value(name, sizeof(name)); }
+		catch (...) { }
+
+		Genode::Rom_connection rom(name);
+		Genode::size_t const size = Genode::Dataspace_client(rom.dataspace()).size();
+
+		Genode::Trace::Policy_id const id = trace.alloc_policy(size);
+
+		Genode::Rm_session &rm = *Genode::env()->rm_session();
+		void * const dst = rm.attach(trace.policy(id));
+		void * const src = rm.attach(rom.dataspace());
+		Genode::memcpy(dst, src, size);
+		rm.detach(src);
+		rm.detach(dst);
+
+		return id;
+	}
+
+	/**
+	 * Return true if the config contains a '<trace>' node for the subject
+	 *
+	 * The 'label' attribute of the node is matched against the beginning
+	 * of the session label. The optional 'thread' attribute must match
+	 * the thread name.
+	 */
+	bool _selected(Genode::Trace::Subject_info const &info) const
+	{
+		using Genode::strcmp;
+		using Genode::strlen;
+
+		bool result = false;
+
+		config.for_each_sub_node("trace", [&] (Genode::Xml_node node) {
+
+			char label[Genode::Trace::Session_label::capacity()] = "";
+			char thread[Genode::Trace::Thread_name::capacity()]  = "";
+			try { node.attribute("label").value(label, sizeof(label)); }
+			catch (...) { }
+			try { node.attribute("thread").value(thread, sizeof(thread)); }
+			catch (...) { }
+
+			if (strcmp(info.session_label().string(), label, strlen(label)) == 0
+			 && (!thread[0] || strcmp(info.thread_name().string(), thread) == 0))
+				result = true;
+		});
+		return result;
+	}
+
+	Subject *_lookup(Genode::Trace::Subject_id id)
+	{
+		for (Subject *s = subjects.first(); s; s = s->next())
+			if (s->id() == id)
+				return s;
+
+		return nullptr;
+	}
+
+	void _start_tracing(Genode::Trace::Subject_id id,
+	                    Genode::Trace::Subject_info const &info)
+	{
+		try {
+			trace.trace(id, policy_id, buffer_size);
+
+			subjects.insert(new (Genode::env()->heap())
+			                Subject(id, info, trace.buffer(id), fs, dir));
+
+		} catch (...) {
+			PERR("could not trace thread '%s' of '%s'",
+			     info.thread_name().string(), info.session_label().string());
+		}
+	}
+
+	void handle_period(unsigned);
+
+	Signal_rpc_member<Main> periodic_dispatcher = {
+		ep, *this, &Main::handle_period};
+
+	Main(Entrypoint &ep) : ep(ep)
+	{
+		Trace_recorder::write_metadata(fs, dir, clock_freq);
+
+		latency_reporter.enabled(_latency_report_enabled());
+
+		timer.sigh(periodic_dispatcher);
+		timer.trigger_periodic(1000*period_ms);
+	}
+};
+
+
+void Server::Main::handle_period(unsigned)
+{
+	using Genode::Trace::Subject_info;
+
+	unsigned const num_subjects = trace.subjects(subject_ids, MAX_SUBJECTS);
+
+	for (unsigned i = 0; i < num_subjects; i++) {
+
+		Genode::Trace::Subject_id const id = subject_ids[i];
+		Subject_info const info = trace.subject_info(id);
+
+		Subject *subject = _lookup(id);
+
+		if (!subject) {
+			if (info.state() == Subject_info::UNTRACED && _selected(info))
+				_start_tracing(id, info);
+			continue;
+		}
+
+		subject->drain(packet);
+
+		/* release the subject after recording its last events */
+		if (info.state() == Subject_info::DEAD) {
+			subjects.remove(subject);
+			Genode::destroy(Genode::env()->heap(), subject);
+			trace.free(id);
+		}
+	}
+
+	if (!latency_reporter.is_enabled())
+		return;
+
+	Genode::Reporter::Xml_generator xml(latency_reporter, [&] () {
+		xml.attribute("clock_freq", clock_freq);
+
+		for (Subject const *s = subjects.first(); s; s = s->next())
+			s->report_latency(xml);
+	});
+}
+
+
+namespace Server {
+
+	char const *name() { return "trace_recorder"; }
+
+	size_t stack_size() { return 4*1024*sizeof(long); }
+
+	void construct(Entrypoint &ep)
+	{
+		static Main main(ep);
+	}
+}
@@ -0,0 +1,3 @@
+TARGET = trace_recorder
+SRC_CC = main.cc
+LIBS  += base server config
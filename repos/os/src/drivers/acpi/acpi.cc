@@ -72,6 +72,61 @@ struct Apic_override : Apic_struct
 	uint16_t flags;
 } __attribute__((packed));
 
+/* ACPI spec 5.2.16 */
+struct Srat_struct
+{
+	enum Types { CPU = 0, MEMORY = 1, X2APIC = 2 };
+
+	uint8_t type;
+	uint8_t length;
+
+	Srat_struct *next() { return reinterpret_cast<Srat_struct *>((uint8_t *)this + length); }
+} __attribute__((packed));
+
+
+/* ACPI spec 5.2.16.1 */
+struct Srat_cpu : Srat_struct
+{
+	uint8_t  domain_lo;
+	uint8_t  apic_id;
+	uint32_t flags;
+	uint8_t  sapic_eid;
+	uint8_t  domain_hi[3];
+	uint32_t clock_domain;
+
+	uint32_t domain() const {
+		return domain_lo | (domain_hi[0] << 8) | (domain_hi[1] << 16)
+		     | (domain_hi[2] << 24); }
+} __attribute__((packed));
+
+
+/* ACPI spec 5.2.16.2 */
+struct Srat_memory : Srat_struct
+{
+	enum { ENABLED = 0x1U, HOT_PLUGGABLE = 0x2U };
+
+	uint32_t domain;
+	uint16_t reserved1;
+	uint64_t base;
+	uint64_t size;
+	uint32_t reserved2;
+	uint32_t flags;
+	uint64_t reserved3;
+} __attribute__((packed));
+
+
+/* ACPI spec 5.2.16.3 */
+struct Srat_x2apic : Srat_struct
+{
+	uint16_t reserved1;
+	uint32_t domain;
+	uint32_t apic_id;
+	uint32_t flags;
+	uint32_t clock_domain;
+	uint32_t reserved2;
+} __attribute__((packed));
+
+
 struct Dmar_struct_header;
 
 /* ACPI spec 5.2.6 */
@@ -98,6 +153,14 @@ struct Generic
 	Mcfg_struct *mcfg_end()    { return reinterpret_cast<Mcfg_struct *>(signature + size); }
 
 	Dmar_struct_header *dmar_header() { return reinterpret_cast<Dmar_struct_header *>(this); }
+
+	/* SRAT ACPI structure */
+	Srat_struct *srat_struct() { return reinterpret_cast<Srat_struct *>(&creator_rev + 4); }
+	Srat_struct *srat_end()    { return reinterpret_cast<Srat_struct *>(signature + size); }
+
+	/* SLIT ACPI structure, number of localities followed by the matrix */
+	uint64_t      slit_localities() { return *reinterpret_cast<uint64_t *>(&creator_rev + 1); }
+	uint8_t const *slit_matrix()    { return reinterpret_cast<uint8_t *>(&creator_rev + 3); }
 } __attribute__((packed));
 
 
@@ -238,6 +301,102 @@ class Irq_override : public List<Irq_override>::Element
 };
 
 
+/**
+ * List that holds the proximity domains of CPUs as found in the SRAT
+ */
+class Cpu_affinity : public List<Cpu_affinity>::Element
+{
+	private:
+
+		uint32_t _apic_id;
+		uint32_t _domain;
+
+	public:
+
+		Cpu_affinity(uint32_t apic_id, uint32_t domain)
+		: _apic_id(apic_id), _domain(domain) { }
+
+		static List<Cpu_affinity> *list()
+		{
+			static List<Cpu_affinity> _list;
+			return &_list;
+		}
+
+		uint32_t apic_id() const { return _apic_id; }
+		uint32_t domain()  const { return _domain; }
+};
+
+
+/**
+ * List that holds the proximity domains of memory ranges as found in the SRAT
+ */
+class Memory_affinity : public List<Memory_affinity>::Element
+{
+	private:
+
+		uint64_t _base;
+		uint64_t _size;
+		uint32_t _domain;
+		bool     _hot_pluggable;
+
+	public:
+
+		Memory_affinity(uint64_t base, uint64_t size, uint32_t domain,
+		                bool hot_pluggable)
+		:
+			_base(base), _size(size), _domain(domain),
+			_hot_pluggable(hot_pluggable)
+		{ }
+
+		static List<Memory_affinity> *list()
+		{
+			static List<Memory_affinity> _list;
+			return &_list;
+		}
+
+		uint64_t base()          const { return _base; }
+		uint64_t size()          const { return _size; }
+		uint32_t domain()        const { return _domain; }
+		bool     hot_pluggable() const { return _hot_pluggable; }
+};
+
+
+/**
+ * Relative distances between proximity domains as found in the SLIT
+ */
+class Locality_distances
+{
+	public:
+
+		/* bound the number of report entries, which grows quadratically */
+		enum { MAX_LOCALITIES = 8 };
+
+	private:
+
+		unsigned _count = 0;
+		uint8_t  _matrix[MAX_LOCALITIES*MAX_LOCALITIES];
+
+	public:
+
+		void set(unsigned count, uint8_t const *matrix)
+		{
+			_count = count;
+			memcpy(_matrix, matrix, count*count);
+		}
+
+		unsigned count() const { return _count; }
+
+		uint8_t distance(unsigned from, unsigned to) const {
+			return _matrix[from*_count + to]; }
+
+		static Locality_distances &distances()
+		{
+			static Locality_distances _distances;
+			return _distances;
+		}
+};
+
+
 /**
  * List that holds the result of the mcfg table parsing which are pointers
  * to the extended pci config space - 4k for each device.
@@ -340,6 +499,16 @@ class Table_wrapper
 		 */
 		bool is_dmar() { return _cmp("DMAR"); }
 
+		/**
+		 * Is this a SRAT table
+		 */
+		bool is_srat() { return _cmp("SRAT"); }
+
+		/**
+		 * Is this a SLIT table
+		 */
+		bool is_slit() { return _cmp("SLIT"); }
+
 		/**
 		 * Parse override structures
 		 */
@@ -390,6 +559,75 @@ class Table_wrapper
 			Dmar_entry::list()->insert(new (env()->heap()) Dmar_entry(head->clone()));
 		}
 
+		/**
+		 * Parse affinity structures of CPUs and memory ranges
+		 */
+		void parse_srat()
+		{
+			Srat_struct *srat = _table->srat_struct();
+			for (; srat < _table->srat_end() && srat->length;
+			     srat = srat->next()) {
+
+				switch (srat->type) {
+				case Srat_struct::CPU:
+				{
+					Srat_cpu *c = static_cast<Srat_cpu *>(srat);
+					if (!(c->flags & 1))
+						break;
+
+					PINF("SRAT CPU APIC %u -> domain %u", c->apic_id, c->domain());
+
+					Cpu_affinity::list()->insert(new (env()->heap())
+						Cpu_affinity(c->apic_id, c->domain()));
+					break;
+				}
+				case Srat_struct::X2APIC:
+				{
+					Srat_x2apic *c = static_cast<Srat_x2apic *>(srat);
+					if (!(c->flags & 1))
+						break;
+
+					PINF("SRAT CPU x2APIC %u -> domain %u", c->apic_id, c->domain);
+
+					Cpu_affinity::list()->insert(new (env()->heap())
+						Cpu_affinity(c->apic_id, c->domain));
+					break;
+				}
+				case Srat_struct::MEMORY:
+				{
+					Srat_memory *m = static_cast<Srat_memory *>(srat);
+					if (!(m->flags & Srat_memory::ENABLED) || !m->size)
+						break;
+
+					PINF("SRAT memory [0x%llx,0x%llx) -> domain %u", m->base,
+					     m->base + m->size, m->domain);
+
+					Memory_affinity::list()->insert(new (env()->heap())
+						Memory_affinity(m->base, m->size, m->domain,
+						                m->flags & Srat_memory::HOT_PLUGGABLE));
+					break;
+				}
+				default: break;
+				}
+			}
+		}
+
+		/**
+		 * Parse distance matrix of proximity domains
+		 */
+		void parse_slit()
+		{
+			uint64_t const count = _table->slit_localities();
+
+			if (count > Locality_distances::MAX_LOCALITIES
+			 || sizeof(Generic) + 8 + count*count > _table->size) {
+				PWRN("SLIT with %llu localities not supported", count);
+				return;
+			}
+
+			Locality_distances::distances().set(count, _table->slit_matrix());
+		}
+
 		Table_wrapper(addr_t base) : _base(base), _table(0)
 		{
 			/* if table is on page boundary, map two pages, otherwise one page */
@@ -1169,6 +1407,16 @@ class Acpi_table
 
 						table.parse_dmar();
 					}
+					if (table.is_srat()) {
+						PDBG("Found SRAT");
+
+						table.parse_srat();
+					}
+					if (table.is_slit()) {
+						PDBG("Found SLIT");
+
+						table.parse_slit();
+					}
 				}
 
 				if (dsdt) {
@@ -1292,6 +1540,50 @@ void Acpi::generate_report()
 			});
 		}
 
+		for (Cpu_affinity *c = Cpu_affinity::list()->first(); c; c = c->next())
+		{
+			xml.node("cpu_affinity", [&] () {
+				char number[12];
+				Genode::snprintf(number, sizeof(number), "%u", c->apic_id());
+				xml.attribute("apic_id", number);
+				Genode::snprintf(number, sizeof(number), "%u", c->domain());
+				xml.attribute("domain", number);
+			});
+		}
+
+		for (Memory_affinity *m = Memory_affinity::list()->first(); m;
+		     m = m->next())
+		{
+			xml.node("memory_affinity", [&] () {
+				char number[20];
+				Genode::snprintf(number, sizeof(number), "0x%llx", m->base());
+				xml.attribute("base", number);
+				Genode::snprintf(number, sizeof(number), "0x%llx", m->size());
+				xml.attribute("size", number);
+				Genode::snprintf(number, sizeof(number), "%u", m->domain());
+				xml.attribute("domain", number);
+				if (m->hot_pluggable())
+					xml.attribute("hot_pluggable", "yes");
+			});
+		}
+
+		{
+			Locality_distances const &d = Locality_distances::distances();
+
+			for (unsigned from = 0; from < d.count(); from++)
+				for (unsigned to = 0; to < d.count(); to++)
+					xml.node("locality", [&] () {
+						char number[8];
+						Genode::snprintf(number, sizeof(number), "%u", from);
+						xml.attribute("from", number);
+						Genode::snprintf(number, sizeof(number), "%u", to);
+						xml.attribute("to", number);
+						Genode::snprintf(number, sizeof(number), "%u",
+						                 d.distance(from, to));
+						xml.attribute("distance", number);
+					});
+		}
+
 		/* lambda definition for scope evaluation in rmrr */
 		auto func_scope = [&] (Device_scope const &scope)
 		{
@@ -12,6 +12,7 @@
  */
 
 #include <timer_session/connection.h>
+#include <os/config.h>
 #include "ata_driver.h"
 #include "atapi_driver.h"
 
@@ -50,6 +51,18 @@ struct Ahci
 	Signal_rpc_member<Ahci> device_ready;
 	unsigned                ready_count = 0;
 
+	/* command completion coalescing */
+	unsigned                ccc_ports = 0;
+	unsigned                ccc_irq   = MAX_PORTS;
+
+	static unsigned _config(char const *attr, unsigned def)
+	{
+		unsigned long value = def;
+		try { Genode::config()->xml_node().attribute(attr).value(&value); }
+		catch (...) { }
+		return value;
+	}
+
 	Ahci(Ahci_root &root)
 	: root(root), irq(root.entrypoint(), *this, &Ahci::handle_irq),
 	  device_ready(root.entrypoint(), *this, &Ahci::ready)
@@ -64,6 +77,14 @@ struct Ahci
 
 		/* search for devices */
 		scan_ports();
+
+		/* reduce interrupt load for ATA ports */
+		unsigned const completions = _config("ccc_completions", 0);
+		if (completions && ccc_ports && hba.ccc()) {
+			ccc_irq = hba.coalesce(ccc_ports, completions,
+			                       _config("ccc_timeout_ms", 1));
+			PINF("\tcommand completion coalescing: %u completions", completions);
+		}
 	}
 
 	bool is_atapi(unsigned sig)
@@ -78,19 +99,33 @@ struct Ahci
 
 	/**
 	 * Forward IRQs to ports
+	 *
+	 * Ports that raise an interrupt while others are handled get served
+	 * right away, instead of waiting for the next interrupt.
 	 */
 	void handle_irq(unsigned)
 	{
+		enum { MAX_ROUNDS = 4 };
+
 		unsigned port_list = hba.read<Hba::Is>();
-		while (port_list) {
-			unsigned port = log2(port_list);
-			port_list    &= ~(1U << port);
+		for (unsigned round = 0; port_list && round < MAX_ROUNDS; round++) {
 
-			ports[port]->handle_irq();
-		}
+			/* coalesced interrupt, check all participating ports */
+			if (ccc_irq < MAX_PORTS && (port_list & (1U << ccc_irq)))
+				port_list = (port_list & ~(1U << ccc_irq)) | ccc_ports;
+
+			while (port_list) {
+				unsigned port = log2(port_list);
+				port_list    &= ~(1U << port);
 
-		/* clear status register */
-		hba.ack_irq();
+				if (ports[port])
+					ports[port]->handle_irq();
+			}
+
+			/* clear status register */
+			hba.ack_irq();
+			port_list = hba.read<Hba::Is>();
+		}
 
 		/* ack at interrupt controller */
 		platform_hba.ack_irq();
@@ -150,9 +185,16 @@ struct Ahci
 			switch (sig) {
 
 				case ATA_SIG:
-					ports[i] = new (Genode::env()->heap()) Ata_driver(port, device_ready);
+				{
+					Ata_driver *ata = new (Genode::env()->heap())
+						Ata_driver(port, device_ready);
+					ata->poll_depth = _config("poll_depth", 0);
+					ata->poll_spins = _config("poll_spins", 64);
+					ports[i]   = ata;
+					ccc_ports |= 1U << i;
 					ready_count++;
 					break;
+				}
 
 				case ATAPI_SIG:
 				case ATAPI_SIG_QEMU:
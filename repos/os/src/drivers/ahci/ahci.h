@@ -83,6 +83,7 @@ struct Hba : Genode::Attached_mmio
 	{
 		struct Np   : Bitfield<0, 4> { };  /* number of ports */
 		struct Ncs  : Bitfield<8, 5> { };  /* number of command slots */
+		struct Cccs : Bitfield<7, 1> { };  /* command completion coalescing */
 		struct Iss  : Bitfield<20, 4> { }; /* interface speed support */
 		struct Sncq : Bitfield<30, 1> { }; /* supports native command queuing */
 		struct Sa64 : Bitfield<31, 1> { }; /* supports 64 bit addressing */
@@ -92,6 +93,7 @@ struct Hba : Genode::Attached_mmio
 	unsigned command_slots() { return read<Cap::Ncs>() + 1; }
 	bool     ncq()           { return !!read<Cap::Sncq>(); }
 	bool     supports_64bit(){ return !!read<Cap::Sa64>(); }
+	bool     ccc()           { return !!read<Cap::Cccs>(); }
 
 	/**
 	 * Generic host control
@@ -124,6 +126,46 @@ struct Hba : Genode::Attached_mmio
 		struct Major : Bitfield<16, 16> { };
 	};
 
+	/**
+	 * Command completion coalescing control
+	 */
+	struct Ccc_ctl : Register<0x14, 32>
+	{
+		struct En  : Bitfield<0, 1> { };   /* enable */
+		struct Int : Bitfield<3, 5> { };   /* interrupt used for coalescing */
+		struct Cc  : Bitfield<8, 8> { };   /* command completions */
+		struct Tv  : Bitfield<16, 16> { }; /* timeout value in ms */
+	};
+
+	/**
+	 * Ports that take part in command completion coalescing
+	 */
+	struct Ccc_ports : Register<0x18, 32> { };
+
+	/**
+	 * Enable command completion coalescing
+	 *
+	 * \param ports        bit mask of ports to coalesce
+	 * \param completions  number of completions raising an interrupt
+	 * \param timeout_ms   time after the first completion raising an
+	 *                     interrupt regardless of the number of completions
+	 *
+	 * \return interrupt bit in the 'Is' register used for coalescing
+	 */
+	unsigned coalesce(unsigned ports, unsigned completions, unsigned timeout_ms)
+	{
+		write<Ccc_ctl::En>(0);
+		write<Ccc_ports>(ports);
+
+		Ccc_ctl::access_t ctl = read<Ccc_ctl>();
+		Ccc_ctl::Cc::set(ctl, completions);
+		Ccc_ctl::Tv::set(ctl, timeout_ms);
+		Ccc_ctl::En::set(ctl, 1);
+		write<Ccc_ctl>(ctl);
+
+		return read<Ccc_ctl::Int>();
+	}
+
 	struct Cap2 : Register<0x24, 32> { };
 
 	void init()
@@ -242,6 +284,27 @@ struct Command_fis : Genode::Mmio
 		/* packet command */
 		write<Command>(0xa0);
 	}
+
+	void flush_cache_ext()
+	{
+		write<Bits::C>(1);
+		write<Device::Lba>(0);
+		write<Command>(0xea);
+	}
+
+	/**
+	 * Data-set management with TRIM bit set
+	 *
+	 * \param blocks  number of 512-byte blocks of LBA range entries
+	 */
+	void trim(Genode::size_t blocks)
+	{
+		write<Bits::C>(1);
+		write<Device::Lba>(1);
+		write<Command>(0x06);
+		write<Features>(1);
+		write<Sector>(blocks);
+	}
 };
 
 
@@ -354,6 +417,8 @@ struct Prdt : Genode::Mmio
 		struct Irq : Bitfield<31,1>  { }; /* interrupt completion */
 	};
 
+	enum { MAX_BYTES = 4 * 1024 * 1024 }; /* per descriptor */
+
 	Prdt(Genode::addr_t base, Genode::addr_t phys, Genode::size_t bytes)
 	: Mmio(base)
 	{
@@ -369,20 +434,37 @@ struct Prdt : Genode::Mmio
 
 struct Command_table
 {
+	enum { PRDT_OFFSET = 0x80 };
+
 	Command_fis   fis;
 	Atapi_command atapi_cmd;
+	unsigned      prd_count = 0;
 
-	/* in Genode we only need one PRD (for one packet) */
-	Prdt            prdt;
-
+	/**
+	 * Constructor
+	 *
+	 * The buffer is described by as many PRDs as needed, each covers at
+	 * most 'Prdt::MAX_BYTES'
+	 */
 	Command_table(Genode::addr_t base,
 	              Genode::addr_t phys,
 	              Genode::size_t bytes = 0)
-	: fis(base), atapi_cmd(base + 0x40),
-	  prdt(base + 0x80, phys, bytes)
-	{ }
+	: fis(base), atapi_cmd(base + 0x40)
+	{
+		do {
+			Genode::size_t len = Genode::min(bytes, (Genode::size_t)Prdt::MAX_BYTES);
+			Prdt(base + PRDT_OFFSET + prd_count * Prdt::size(), phys, len);
+
+			phys  += len;
+			bytes -= len;
+			prd_count++;
+		} while (bytes && prd_count < max_prds());
+	}
 
 	static constexpr Genode::size_t size() { return 0x100; }
+
+	static constexpr unsigned max_prds() {
+		return (size() - PRDT_OFFSET) / Prdt::size(); }
 };
 
 
@@ -777,6 +859,19 @@ struct Port : Genode::Mmio
 		return cmd_list + (slot * Command_header::size());
 	}
 
+	/**
+	 * Setup command table of slot for the given physical buffer
+	 */
+	Command_table command_table(unsigned slot, Genode::addr_t phys,
+	                            Genode::size_t bytes)
+	{
+		Command_table table(command_table_addr(slot), phys, bytes);
+
+		Command_header header(command_header_addr(slot));
+		header.write<Command_header::Prdtl>(table.prd_count);
+		return table;
+	}
+
 	void execute(unsigned slot)
 	{
 		start();
@@ -801,9 +896,11 @@ struct Port_driver : Port, Block::Driver
 
 	void sanity_check(Block::sector_t block_number, Genode::size_t count)
 	{
-		/* max. PRDT size is 4MB */
-		if (count * block_size() > 4 * 1024 * 1024) {
-			PERR("error: maximum supported packet size is 4MB");
+		/* limited by the PRD table and the 16-bit sector count */
+		enum { MAX_BYTES = Command_table::max_prds() * Prdt::MAX_BYTES };
+		if (count * block_size() > MAX_BYTES || count > 0xffff) {
+			PERR("error: maximum supported packet size is %uMB",
+			     MAX_BYTES / (1024 * 1024));
 			throw Io_error();
 		}
 
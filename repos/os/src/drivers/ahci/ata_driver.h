@@ -41,6 +41,11 @@ struct Identity : Genode::Mmio
 
 	struct Sector_count : Register<0xc8, 64> { };
 
+	struct Data_set_mgmt : Register<0x152, 16>
+	{
+		struct Trim : Bitfield<0, 1> { };
+	};
+
 	struct Logical_block  : Register<0xd4, 16>
 	{
 		struct Per_physical : Bitfield<0,  3> { }; /* 2^X logical per physical */
@@ -168,17 +173,43 @@ struct Ata_driver : Port_driver
 	Io_command                              *io_cmd = nullptr;
 	Block::Packet_descriptor                 pending[32];
 
+	/*
+	 * Completion polling: while at least 'poll_depth' commands are
+	 * outstanding, the interrupt handler keeps looking for completions
+	 * until it spun 'poll_spins' times without finding one, and falls back
+	 * to interrupts afterwards. A 'poll_depth' of zero disables polling.
+	 */
+	unsigned poll_depth = 0;
+	unsigned poll_spins = 0;
+
+	/*
+	 * Non-queued commands (flush, trim) occupy slot 0 exclusively, no
+	 * other command may be issued until they are finished
+	 */
+	bool exclusive = false;
+
+	/* buffer for LBA range entries of trim commands */
+	enum { TRIM_BUF_SIZE = 512, TRIM_RANGE_MAX = 0xffff };
+	Genode::Ram_dataspace_capability trim_ds;
+	Genode::addr_t                   trim_buf = 0;
+
 	Ata_driver(Port &port, Signal_context_capability state_change)
 	: Port_driver(port, state_change)
 	{
 		Port::init();
 		identify_device();
+
+		trim_ds  = platform_hba.alloc_dma_buffer(0x1000);
+		trim_buf = Genode::env()->rm_session()->attach(trim_ds);
 	}
 
 	~Ata_driver()
 	{
 		if (io_cmd)
 			destroy (Genode::env()->heap(), io_cmd);
+
+		Genode::env()->rm_session()->detach((void *)trim_buf);
+		platform_hba.free_dma_buffer(trim_ds);
 	}
 
 	unsigned find_free_cmd_slot()
@@ -190,17 +221,58 @@ struct Ata_driver : Port_driver
 		throw Block::Driver::Request_congestion();
 	}
 
-	void ack_packets()
+	unsigned outstanding()
+	{
+		unsigned cnt = 0;
+		for (unsigned slot = 0; slot < cmd_slots; slot++)
+			if (pending[slot].valid())
+				cnt++;
+		return cnt;
+	}
+
+	/**
+	 * Acknowledge all completed packets
+	 *
+	 * \return number of acknowledged packets
+	 */
+	unsigned ack_packets()
 	{
 		unsigned slots =  Port::read<Ci>() | Port::read<Sact>();
 
+		/*
+		 * Collect completions before acknowledging them as a burst, because
+		 * acknowledging may lead to new requests, which occupy free slots
+		 */
+		Block::Packet_descriptor done[32];
+		unsigned cnt = 0;
+
 		for (unsigned slot = 0; slot < cmd_slots; slot++) {
 			if ((slots & (1U << slot)) || !pending[slot].valid())
 				continue;
 
-			Block::Packet_descriptor p = pending[slot];
+			done[cnt++]   = pending[slot];
 			pending[slot] = Block::Packet_descriptor();
-			ack_packet(p, true);
+
+			if (slot == 0)
+				exclusive = false;
+		}
+
+		for (unsigned i = 0; i < cnt; i++)
+			ack_packet(done[i], true);
+
+		return cnt;
+	}
+
+	/**
+	 * Poll for completions as long as the queue is deep enough
+	 */
+	void poll_completions()
+	{
+		for (unsigned idle = 0; idle < poll_spins
+		     && poll_depth && outstanding() >= poll_depth; ) {
+
+			io_cmd->handle_irq(*this, Port::read<Is>());
+			idle = ack_packets() ? 0 : idle + 1;
 		}
 	}
 
@@ -227,12 +299,38 @@ struct Ata_driver : Port_driver
 		}
 	}
 
+	/**
+	 * Issue command that must not overlap with queued commands
+	 */
+	template <typename FUNC>
+	void non_queued(Block::Packet_descriptor &packet, addr_t phys,
+	                size_t bytes, bool write, FUNC const &setup_fis)
+	{
+		if (exclusive || outstanding())
+			throw Block::Driver::Request_congestion();
+
+		exclusive = true;
+		pending[0] = packet;
+
+		Command_table table = command_table(0, phys, bytes);
+		setup_fis(table.fis);
+
+		Command_header header(command_header_addr(0));
+		header.write<Command_header::Bits::W>(write ? 1 : 0);
+		header.clear_byte_count();
+
+		execute(0);
+	}
+
 	void io(bool                      read,
 	        Block::sector_t           block_number,
 	        size_t                    count,
 	        addr_t                    phys,
 	        Block::Packet_descriptor &packet)
 	{
+		if (exclusive)
+			throw Block::Driver::Request_congestion();
+
 		sanity_check(block_number, count);
 		overlap_check(block_number, count);
 
@@ -240,7 +338,7 @@ struct Ata_driver : Port_driver
 		pending[slot] = packet;
 
 		/* setup fis */
-		Command_table table(command_table_addr(slot), phys, count * block_size());
+		Command_table table = command_table(slot, phys, count * block_size());
 
 		/* set ATA command */
 		io_cmd->command(*this, table, read, block_number, count, slot);
@@ -287,7 +385,13 @@ struct Ata_driver : Port_driver
 		case READY:
 
 			io_cmd->handle_irq(*this, status);
+
+			/* completion of a non-queued command */
+			if (Port::Is::Dhrs::get(status))
+				ack_irq();
+
 			ack_packets();
+			poll_completions();
 
 		default:
 			break;
@@ -296,6 +400,11 @@ struct Ata_driver : Port_driver
 		stop();
 	}
 
+	bool trim_support()
+	{
+		return info->read<Identity::Data_set_mgmt::Trim>();
+	}
+
 	bool ncq_support()
 	{
 		return info->read<Identity::Sata_caps::Ncq_support>() && hba.ncq();
@@ -319,7 +428,7 @@ struct Ata_driver : Port_driver
 		state       = IDENTIFY;
 		addr_t phys = (addr_t)Dataspace_client(device_info_ds).phys_addr();
 
-		Command_table table(command_table_addr(0), phys, 0x1000);
+		Command_table table = command_table(0, phys, 0x1000);
 		table.fis.identify_device();
 		execute(0);
 	}
@@ -336,9 +445,59 @@ struct Ata_driver : Port_driver
 		Block::Session::Operations o;
 		o.set_operation(Block::Packet_descriptor::READ);
 		o.set_operation(Block::Packet_descriptor::WRITE);
+		o.set_operation(Block::Packet_descriptor::FLUSH);
+		if (trim_support())
+			o.set_operation(Block::Packet_descriptor::TRIM);
 		return o;
 	}
 
+	Block::Session::Transfer_info transfer_info() override
+	{
+		/* limited by the PRD table and the 16-bit sector count */
+		enum { MAX_BYTES = Command_table::max_prds() * Prdt::MAX_BYTES };
+		size_t const max = min((size_t)MAX_BYTES, 0xffff * block_size());
+
+		/* prefer requests aligned to physical sectors */
+		unsigned const align = log2(block_size()) +
+		                       info->read<Identity::Logical_block::Per_physical>();
+
+		return Block::Session::Transfer_info(max, cmd_slots, align);
+	}
+
+	void flush(Block::Packet_descriptor &packet) override
+	{
+		non_queued(packet, 0, 0, false,
+		           [] (Command_fis &fis) { fis.flush_cache_ext(); });
+	}
+
+	void trim(Block::sector_t           block_number,
+	          size_t                    block_count,
+	          Block::Packet_descriptor &packet) override
+	{
+		enum { MAX_RANGES = TRIM_BUF_SIZE / sizeof(Genode::uint64_t) };
+
+		if (!trim_support() || block_count > MAX_RANGES * TRIM_RANGE_MAX ||
+		    block_number + block_count > Ata_driver::block_count())
+			throw Io_error();
+
+		if (exclusive || outstanding())
+			throw Block::Driver::Request_congestion();
+
+		/* each entry holds a 48-bit LBA and a 16-bit count */
+		Genode::uint64_t *range = (Genode::uint64_t *)trim_buf;
+		Genode::memset(range, 0, TRIM_BUF_SIZE);
+		for (unsigned i = 0; block_count; i++) {
+			size_t n = min(block_count, (size_t)TRIM_RANGE_MAX);
+			range[i] = block_number | ((Genode::uint64_t)n << 48);
+			block_number += n;
+			block_count  -= n;
+		}
+
+		addr_t phys = (addr_t)Dataspace_client(trim_ds).phys_addr();
+		non_queued(packet, phys, TRIM_BUF_SIZE, true,
+		           [] (Command_fis &fis) { fis.trim(1); });
+	}
+
 	void read_dma(Block::sector_t           block_number,
 	              size_t                    block_count,
 	              addr_t                    phys,
@@ -44,7 +44,7 @@ struct Atapi_driver : Port_driver
 	{
 		state = TEST_READY;
 
-		Command_table table(command_table_addr(0), 0, 0);
+		Command_table table = command_table(0, 0, 0);
 		table.fis.atapi();
 		table.atapi_cmd.test_unit_ready();
 
@@ -63,7 +63,7 @@ struct Atapi_driver : Port_driver
 
 		addr_t phys   = (addr_t)Dataspace_client(device_info_ds).phys_addr();
 
-		Command_table table(command_table_addr(0), phys, 0x1000);
+		Command_table table = command_table(0, phys, 0x1000);
 		table.fis.atapi();
 		table.atapi_cmd.read_sense();
 
@@ -75,7 +75,7 @@ struct Atapi_driver : Port_driver
 		state       = IDENTIFY;
 		addr_t phys = (addr_t)Dataspace_client(device_info_ds).phys_addr();
 
-		Command_table table(command_table_addr(0), phys, 0x1000);
+		Command_table table = command_table(0, phys, 0x1000);
 		table.fis.atapi();
 		table.atapi_cmd.read_capacity();
 
@@ -187,7 +187,7 @@ struct Atapi_driver : Port_driver
 			PDBG("Add packet read %llu count %zu -> %u", block_number, count, 0);
 
 		/* setup fis */
-		Command_table table(command_table_addr(0), phys, count * block_size());
+		Command_table table = command_table(0, phys, count * block_size());
 		table.fis.atapi();
 
 		/* setup atapi command */
@@ -50,6 +50,18 @@ namespace Framebuffer
 
 		BYTES_PER_PIXEL  = 2,
 		FRAMEBUFFER_SIZE = SCR_WIDTH*SCR_HEIGHT*BYTES_PER_PIXEL,
+
+		/* the video memory hosts up to three buffers */
+		MAX_BUFFERS = 3,
+
+		/* the timing above corresponds to VGA at a pixel clock of 25.175 MHz */
+		PIXEL_CLOCK_KHZ = 25175,
+		FRAME_PERIOD_US = (SCR_WIDTH + LEFT_MARGIN + RIGHT_MARGIN + HSYNC_LEN)
+		                * (SCR_HEIGHT + UPPER_MARGIN + LOWER_MARGIN + VSYNC_LEN)
+		                * 1000 / PIXEL_CLOCK_KHZ,
+
+		/* period of sync signals in single-buffer mode */
+		SYNC_PERIOD_US = 10*1000,
 	};
 
 	class Session_component : public Genode::Rpc_object<Session>
@@ -58,10 +70,33 @@ namespace Framebuffer
 
 			Genode::Dataspace_capability _fb_ds_cap;
 			Genode::Dataspace_client     _fb_ds;
+			Genode::addr_t const         _fb_phys;
 			Genode::addr_t               _regs_base;
 			Genode::addr_t               _sys_regs_base;
 			Timer::Connection            _timer;
 
+			/*
+			 * State of the multi-buffer mode
+			 *
+			 * The controller latches a new base address at the next
+			 * vertical sync. Because the driver does not respond to the
+			 * controller's interrupts, vertical blanks are derived from
+			 * the frame period since the start of the session.
+			 */
+			unsigned      _buffers    = 1;
+			unsigned      _displayed  = 0;
+			unsigned      _pending    = 0;
+			unsigned long _flip_vsync = 0;
+
+			Genode::addr_t _buffer_phys(unsigned i) const {
+				return _fb_phys + i*FRAMEBUFFER_SIZE; }
+
+			unsigned long _vsync_count() const {
+				return (Genode::uint64_t)_timer.elapsed_ms()*1000 / FRAME_PERIOD_US; }
+
+			unsigned _sync_period_us() const {
+				return _buffers > 1 ? FRAME_PERIOD_US : SYNC_PERIOD_US; }
+
 			enum {
 				/**
 				 * Bit definitions of the lcd control register
@@ -101,7 +136,7 @@ namespace Framebuffer
 			 */
 			Session_component(void *regs_base, void *sys_regs_base,
 			                  Genode::Dataspace_capability fb_ds_cap)
-			: _fb_ds_cap(fb_ds_cap), _fb_ds(_fb_ds_cap),
+			: _fb_ds_cap(fb_ds_cap), _fb_ds(_fb_ds_cap), _fb_phys(_fb_ds.phys_addr()),
 			  _regs_base((Genode::addr_t)regs_base),
 			  _sys_regs_base((Genode::addr_t)sys_regs_base)
 			{
@@ -146,7 +181,7 @@ namespace Framebuffer
 				reg_write(PL11X_REG_TIMING3, tim3);
 
 				/* set framebuffer address and ctrl register */
-				reg_write(PL11X_REG_UPBASE, _fb_ds.phys_addr());
+				reg_write(PL11X_REG_UPBASE, _buffer_phys(0));
 				reg_write(PL11X_REG_LPBASE, 0);
 				reg_write(PL11X_REG_IMSC,   0);
 				reg_write(PL11X_REG_CTRL,   ctrl);
@@ -165,10 +200,68 @@ namespace Framebuffer
 			void sync_sigh(Genode::Signal_context_capability sigh) override
 			{
 				_timer.sigh(sigh);
-				_timer.trigger_periodic(10*1000);
+				_timer.trigger_periodic(_sync_period_us());
 			}
 
 			void refresh(int x, int y, int w, int h) override { }
+
+			bool scanout(Genode::Dataspace_capability ds_cap) override
+			{
+				/* revert to the framebuffer dataspace */
+				if (!ds_cap.valid()) {
+					reg_write(PL11X_REG_UPBASE, _buffer_phys(_pending));
+					return true;
+				}
+
+				/*
+				 * The controller fetches the pixels from physical memory.
+				 * RAM dataspaces are physically contiguous. The new base
+				 * address takes effect at the next vertical sync.
+				 */
+				Genode::Dataspace_client ds(ds_cap);
+				if (ds.size() < FRAMEBUFFER_SIZE || !ds.phys_addr())
+					return false;
+
+				reg_write(PL11X_REG_UPBASE, ds.phys_addr());
+				return true;
+			}
+
+			unsigned buffers(unsigned count) override
+			{
+				_buffers   = Genode::max(1U, Genode::min(count, (unsigned)MAX_BUFFERS));
+				_displayed = _pending = 0;
+
+				reg_write(PL11X_REG_UPBASE, _buffer_phys(0));
+
+				/* deliver sync signals at the display's refresh rate */
+				_timer.trigger_periodic(_sync_period_us());
+				return _buffers;
+			}
+
+			void flip(unsigned buffer) override
+			{
+				if (buffer >= _buffers)
+					return;
+
+				reg_write(PL11X_REG_UPBASE, _buffer_phys(buffer));
+
+				_pending    = buffer;
+				_flip_vsync = _vsync_count() + 1;
+			}
+
+			Vsync vsync() override
+			{
+				unsigned long const count = _vsync_count();
+
+				if (count >= _flip_vsync)
+					_displayed = _pending;
+
+				Vsync vsync;
+				vsync.count        = count;
+				vsync.timestamp_us = (Genode::uint64_t)count*FRAME_PERIOD_US;
+				vsync.buffer       = _displayed;
+				return vsync;
+			}
 	};
 
 
@@ -218,7 +311,8 @@ int main(int, char **)
 	static Rpc_entrypoint ep(&cap, STACK_SIZE, "fb_ep");
 
 	Dataspace_capability fb_ds_cap =
-		Framebuffer::alloc_video_memory(Framebuffer::FRAMEBUFFER_SIZE);
+		Framebuffer::alloc_video_memory(Framebuffer::MAX_BUFFERS
+		                                * Framebuffer::FRAMEBUFFER_SIZE);
 
 	/*
 	 * Let the entry point serve the framebuffer and input root interfaces
@@ -77,6 +77,7 @@ namespace Genode
 				struct Multi_hash_en  : Bitfield<6, 1> {};
 				struct Gige_en  : Bitfield<10, 1> {};
 				struct Fcs_remove  : Bitfield<17, 1> {};
+				struct Rx_chksum_offld_en  : Bitfield<24, 1> {};
 				struct Mdc_clk_div  : Bitfield<18, 3> {
 					enum {
 						DIV_32 = 0b010,
@@ -277,7 +278,7 @@ namespace Genode
 
 			void _init()
 			{
-				// TODO checksum offloading and pause frames
+				// TODO transmit checksum offloading and pause frames
 				/* see 16.3.2 Configure the Controller */
 
 				/* 1. Program the Network Configuration register (gem.net_cfg) */
@@ -286,7 +287,8 @@ namespace Genode
 					Config::Full_duplex::bits(1) |
 					Config::Multi_hash_en::bits(1) |
 					Config::Mdc_clk_div::bits(Config::Mdc_clk_div::DIV_32) |
-					Config::Fcs_remove::bits(1)
+					Config::Fcs_remove::bits(1) |
+					Config::Rx_chksum_offld_en::bits(1)
 				);
 
 
@@ -460,7 +462,7 @@ namespace Genode
 				if (!_tx.sink()->packet_avail())
 					return false;
 
-				Genode::Packet_descriptor packet = _tx.sink()->get_packet();
+				Nic::Packet_descriptor packet = _tx.sink()->get_packet();
 				if (!packet.valid()) {
 					PWRN("Invalid tx packet");
 					return true;
@@ -498,6 +500,18 @@ namespace Genode
 				return true;
 			}
 
+			Nic::Offload offload() override
+			{
+				/*
+				 * Frames with bad checksums are discarded by the
+				 * controller, verified checksums are reported per frame.
+				 */
+				Nic::Offload offload;
+				offload.rx_checksum = Nic::Packet_descriptor::CSUM_IP
+				                    | Nic::Packet_descriptor::CSUM_L4;
+				return offload;
+			}
+
 			void _handle_packet_stream() override
 			{
 				while (_rx.source()->ack_avail())
@@ -524,6 +538,7 @@ namespace Genode
 						// TODO use this buffer directly as the destination for the DMA controller
 						// to minimize the overrun errors
 						const size_t buffer_size = _rx_buffer.package_length();
+						const unsigned checksum  = _rx_buffer.package_checksum();
 
 						/* allocate rx packet buffer */
 						Nic::Packet_descriptor p;
@@ -548,6 +563,7 @@ namespace Genode
 						write<Rx_status::Buffer_not_available>(1);
 
 						/* comit buffer to system services */
+						p.checksum(checksum);
 						_rx.source()->submit_packet(p);
 					}
 
@@ -14,6 +14,8 @@
 #ifndef _INCLUDE__DRIVERS__NIC__GEM__RX_BUFFER_DESCRIPTOR_H_
 #define _INCLUDE__DRIVERS__NIC__GEM__RX_BUFFER_DESCRIPTOR_H_
 
+#include <nic_session/nic_session.h>
+
 #include "buffer_descriptor.h"
 
 using namespace Genode;
@@ -31,6 +33,14 @@ class Rx_buffer_descriptor : public Buffer_descriptor
 			struct Length : Bitfield<0, 13> {};
 			struct Start_of_frame : Bitfield<14, 1> {};
 			struct End_of_frame : Bitfield<15, 1> {};
+			struct Checksum_match : Bitfield<22, 2> {
+				enum {
+					NONE   = 0b00,
+					IP     = 0b01,
+					IP_TCP = 0b10,
+					IP_UDP = 0b11,
+				};
+			};
 		};
 
 		enum { BUFFER_COUNT = 16 };
@@ -86,6 +96,30 @@ class Rx_buffer_descriptor : public Buffer_descriptor
 		}
 
 
+		/**
+		 * Return checksums of the current package verified by the controller
+		 *
+		 * \return bit mask of 'Nic::Packet_descriptor::Checksum' flags
+		 */
+		unsigned package_checksum()
+		{
+			typedef Nic::Packet_descriptor Nic_packet;
+
+			if (!package_available())
+				return 0;
+
+			switch (Status::Checksum_match::get(_current_descriptor().status)) {
+			case Status::Checksum_match::IP:
+				return Nic_packet::CSUM_IP;
+			case Status::Checksum_match::IP_TCP:
+			case Status::Checksum_match::IP_UDP:
+				return Nic_packet::CSUM_IP | Nic_packet::CSUM_L4;
+			default:
+				return 0;
+			}
+		}
+
+
 		size_t get_package(char* const package, const size_t max_length)
 		{
 			if (!package_available())
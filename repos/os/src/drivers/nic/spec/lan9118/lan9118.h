@@ -198,7 +198,7 @@ class Lan9118 : public Nic::Session_component,
 			if (!_tx.sink()->packet_avail())
 				return false;
 
-			Genode::Packet_descriptor packet = _tx.sink()->get_packet();
+			Nic::Packet_descriptor packet = _tx.sink()->get_packet();
 			if (!packet.valid()) {
 				PWRN("Invalid tx packet");
 				return true;
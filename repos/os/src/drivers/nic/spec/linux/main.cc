@@ -127,7 +127,7 @@ class Linux_session_component : public Nic::Session_component
 			if (!_tx.sink()->packet_avail())
 				return false;
 
-			Packet_descriptor packet = _tx.sink()->get_packet();
+			Nic::Packet_descriptor packet = _tx.sink()->get_packet();
 			if (!packet.valid()) {
 				PWRN("Invalid tx packet");
 				return true;
@@ -125,6 +125,11 @@ void Platform::Device_component::config_write(unsigned char address,
 		}
 	}
 
+	if (char volatile *ecam = _ecam()) {
+		_ecam_write(ecam, address, value, size);
+		return;
+	}
+
 	_device_config.write(&_config_access, address, value, size,
 	                     _device_config.DONT_TRACK_ACCESS);
 }
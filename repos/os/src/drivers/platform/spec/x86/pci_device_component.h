@@ -37,6 +37,7 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 		Device_config                      _device_config;
 		Genode::addr_t                     _config_space;
 		Genode::Io_mem_session_capability  _io_mem_config_extended;
+		char volatile                     *_config_mmio = nullptr;
 		Config_access                      _config_access;
 		Genode::Rpc_entrypoint            *_ep;
 		Platform::Session_component       *_session;
@@ -181,6 +182,65 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 		}
 
 
+		/**
+		 * Return locally mapped config space of the device
+		 *
+		 * Accessing the config space via the memory-mapped configuration
+		 * mechanism (ECAM) of PCI Express saves the two RPCs to core per
+		 * access that are needed for the access via I/O ports.
+		 *
+		 * \return  pointer to config space, or nullptr if the device has
+		 *          no memory-mapped config space
+		 */
+		char volatile *_ecam()
+		{
+			if (_config_mmio || _config_space == ~0UL)
+				return _config_mmio;
+
+			Genode::Io_mem_dataspace_capability ds = get_config_space();
+			if (!ds.valid())
+				return nullptr;
+
+			try {
+				_config_mmio = Genode::env()->rm_session()->attach(ds);
+			} catch (...) { }
+
+			return _config_mmio;
+		}
+
+		unsigned _ecam_read(char volatile *ecam, unsigned char address,
+		                    Access_size size)
+		{
+			using namespace Genode;
+
+			switch (size) {
+			case Access_size::ACCESS_8BIT:
+				return *(uint8_t  volatile *)(ecam + address);
+			case Access_size::ACCESS_16BIT:
+				return *(uint16_t volatile *)(ecam + (address & ~1));
+			default:
+				return *(uint32_t volatile *)(ecam + (address & ~3));
+			}
+		}
+
+		void _ecam_write(char volatile *ecam, unsigned char address,
+		                 unsigned value, Access_size size)
+		{
+			using namespace Genode;
+
+			switch (size) {
+			case Access_size::ACCESS_8BIT:
+				*(uint8_t  volatile *)(ecam + address) = value;
+				break;
+			case Access_size::ACCESS_16BIT:
+				*(uint16_t volatile *)(ecam + (address & ~1)) = value;
+				break;
+			default:
+				*(uint32_t volatile *)(ecam + (address & ~3)) = value;
+				break;
+			}
+		}
+
 	protected:
 
 		Genode::Rpc_entrypoint * ep() { return _ep; }
@@ -253,6 +313,9 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 				}
 			}
 
+			if (_config_mmio)
+				Genode::env()->rm_session()->detach((void *)_config_mmio);
+
 			if (_io_mem_config_extended.valid())
 				Genode::env()->parent()->close(_io_mem_config_extended);
 
@@ -317,6 +380,9 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 
 		unsigned config_read(unsigned char address, Access_size size) override
 		{
+			if (char volatile *ecam = _ecam())
+				return _ecam_read(ecam, address, size);
+
 			return _device_config.read(&_config_access, address, size,
 			                           _device_config.DONT_TRACK_ACCESS);
 		}
@@ -324,6 +390,17 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 		void config_write(unsigned char address, unsigned value,
 		                  Access_size size) override;
 
+		Config_block config_read_block(unsigned char address) override
+		{
+			unsigned char const base = address & ~(Config_block::SIZE - 1);
+
+			Config_block block;
+			for (unsigned i = 0; i < Config_block::SIZE/4; i++)
+				block.dwords[i] = config_read(base + 4*i, Access_size::ACCESS_32BIT);
+
+			return block;
+		}
+
 		Genode::Irq_session_capability irq(Genode::uint8_t) override;
 
 		Genode::Io_port_session_capability io_port(Genode::uint8_t) override;
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2008-2013 Genode Labs GmbH
+ * Copyright (C) 2008-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -18,6 +18,7 @@
 #include <base/rpc_server.h>
 #include <base/tslab.h>
 #include <cap_session/connection.h>
+#include <dataspace/client.h>
 
 #include <ram_session/connection.h>
 #include <root/component.h>
@@ -136,6 +137,83 @@ namespace Platform {
 				Genode::Ram_connection &ram() { return _ram; }
 			} _resources;
 
+			/**
+			 * DMA buffers released by the client, kept for re-use
+			 *
+			 * Drivers tend to allocate and free DMA buffers of the same
+			 * sizes over and over. Handing out a cached buffer spares the
+			 * allocation at the RAM session, the transfer of quota, and
+			 * the mapping into the device PD, i.e., the IOMMU. The buffers
+			 * are cleared before re-use because freshly allocated RAM is
+			 * expected to be zeroed.
+			 */
+			struct Dma_cache
+			{
+				typedef Genode::Ram_dataspace_capability Ram_capability;
+
+				enum { SLOTS = 16, MAX_CACHED = 4*1024*1024 };
+
+				struct Slot
+				{
+					Ram_capability cap;
+					Genode::size_t size = 0;
+				} slots[SLOTS];
+
+				Genode::size_t cached = 0;
+
+				/**
+				 * Take cached buffer of the given size
+				 *
+				 * \return  invalid capability if no buffer of the size is
+				 *          cached
+				 */
+				Ram_capability take(Genode::size_t size)
+				{
+					size = Genode::align_addr(size, 12);
+
+					for (unsigned i = 0; i < SLOTS; i++) {
+						if (!slots[i].cap.valid() || slots[i].size != size)
+							continue;
+
+						Ram_capability cap = slots[i].cap;
+						slots[i] = Slot();
+						cached -= size;
+						return cap;
+					}
+					return Ram_capability();
+				}
+
+				/**
+				 * Put buffer into cache
+				 *
+				 * \return  false if the cache is exhausted
+				 */
+				bool put(Ram_capability cap, Genode::size_t size)
+				{
+					if (cached + size > MAX_CACHED)
+						return false;
+
+					for (unsigned i = 0; i < SLOTS; i++) {
+						if (slots[i].cap.valid())
+							continue;
+
+						void *local = nullptr;
+						try {
+							local = Genode::env()->rm_session()->attach(cap);
+						} catch (...) { return false; }
+
+						Genode::memset(local, 0, size);
+						Genode::env()->rm_session()->detach(local);
+
+						slots[i].cap  = cap;
+						slots[i].size = size;
+						cached       += size;
+						return true;
+					}
+					return false;
+				}
+			} _dma_cache;
+
 			struct Devicepd {
 				Device_pd_policy        *policy;
 				Device_pd_client         child;
@@ -772,6 +850,10 @@ namespace Platform {
 
 			Ram_capability alloc_dma_buffer(Genode::size_t const size)
 			{
+				Ram_capability const cached = _dma_cache.take(size);
+				if (cached.valid())
+					return cached;
+
 				if (!_device_pd.is_constructed())
 					_device_pd.construct(_device_pd_ep, _md_alloc,
 					                     _resources.ram().cap(),
@@ -834,8 +916,19 @@ namespace Platform {
 
 			void free_dma_buffer(Ram_capability ram)
 			{
-				if (ram.valid())
-					_resources.ram().free(ram);
+				if (!ram.valid())
+					return;
+
+				Genode::size_t const size = Genode::Dataspace_client(ram).size();
+
+				if (_dma_cache.put(ram, size))
+					return;
+
+				_resources.ram().free(ram);
+
+				/* return quota of the buffer to the client */
+				if (!_resources.ram().transfer_quota(Genode::env()->ram_session_cap(), size))
+					_md_alloc.upgrade(size);
 			}
 
 			Device_capability device(String const &name) override;
@@ -23,6 +23,7 @@ namespace Adma2
 	using namespace Genode;
 
 	class Desc;
+	struct Segment;
 	class Table;
 }
 
@@ -52,6 +53,15 @@ struct Adma2::Desc : Register<64>
 	struct Address : Bitfield<32, 32> { };
 };
 
+/**
+ * Physically contiguous part of a scattered transfer buffer
+ */
+struct Adma2::Segment
+{
+	addr_t phys;
+	size_t size;
+};
+
 /**
  * Descriptor table
  */
@@ -77,7 +87,22 @@ class Adma2::Table
 		 * \retval  0  success
 		 * \retval -1  error
 		 */
-		int setup_request(size_t const size, addr_t const buffer_phys);
+		int setup_request(size_t const size, addr_t const buffer_phys)
+		{
+			Segment const segment { buffer_phys, size };
+			return setup_request(&segment, 1);
+		}
+
+		/**
+		 * Marshal descriptors according to scattered block request
+		 *
+		 * \param segments  buffer segments in transfer order
+		 * \param count     number of segments
+		 *
+		 * \retval  0  success
+		 * \retval -1  error
+		 */
+		int setup_request(Segment const * const segments, unsigned const count);
 
 		/*
 		 * Accessors
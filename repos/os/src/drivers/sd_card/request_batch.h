@@ -0,0 +1,133 @@
+/*
+ * \brief  Combination of adjacent block requests
+ * \author Martin Stein
+ * \date   2015-11-20
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _REQUEST_BATCH_H_
+#define _REQUEST_BATCH_H_
+
+/* Genode includes */
+#include <block/driver.h>
+
+/* local includes */
+#include <adma2.h>
+
+namespace Sd_card { class Request_batch; }
+
+
+/**
+ * Batch of block requests that address adjacent blocks
+ *
+ * A DMA-capable driver records requests instead of processing them one by
+ * one. The requests of a batch are transferred by a single multi-block
+ * command with one scatter-gather segment per request, which saves the
+ * command overhead of the card for each but the first request.
+ */
+class Sd_card::Request_batch
+{
+	public:
+
+		enum { MAX_REQUESTS = 32 };
+
+	private:
+
+		Block::Packet_descriptor _packets[MAX_REQUESTS];
+		Adma2::Segment           _segments[MAX_REQUESTS];
+		unsigned                 _count;
+		bool                     _write;
+		Block::sector_t          _first;
+		Genode::size_t           _blocks;
+		Genode::size_t const     _block_size;
+		Genode::size_t const     _max_blocks;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param block_size  size of one block in bytes
+		 * \param max_blocks  maximum number of blocks per command
+		 */
+		Request_batch(Genode::size_t block_size, Genode::size_t max_blocks)
+		:
+			_count(0), _write(false), _first(0), _blocks(0),
+			_block_size(block_size), _max_blocks(max_blocks)
+		{ }
+
+		bool empty() const { return !_count; }
+
+		/**
+		 * Return whether a request can be added to the batch
+		 */
+		bool fits(bool write, Block::sector_t block_number,
+		          Genode::size_t block_count) const
+		{
+			if (!_count)
+				return true;
+
+			return _count < MAX_REQUESTS && write == _write &&
+			       block_number == _first + _blocks &&
+			       _blocks + block_count <= _max_blocks;
+		}
+
+		/**
+		 * Add request to the batch
+		 *
+		 * The caller must have checked the request via 'fits'.
+		 */
+		void add(bool write, Block::sector_t block_number,
+		         Genode::size_t block_count, Genode::addr_t phys,
+		         Block::Packet_descriptor &packet)
+		{
+			if (!_count) {
+				_write  = write;
+				_first  = block_number;
+				_blocks = 0;
+			}
+			_packets[_count]  = packet;
+			_segments[_count] = { phys, block_count * _block_size };
+			_blocks += block_count;
+			_count++;
+		}
+
+		/**
+		 * Transfer the batch and acknowledge its requests
+		 *
+		 * \param transfer  functor called with the direction, the first
+		 *                  block, the number of blocks, the segments, and
+		 *                  the number of segments, returning the success
+		 * \param ack       functor called with each packet and the success
+		 *
+		 * The batch is empty when acknowledging the requests, which permits
+		 * the 'ack' functor to add new requests.
+		 */
+		template <typename TRANSFER, typename ACK>
+		void submit(TRANSFER const &transfer, ACK const &ack)
+		{
+			if (!_count)
+				return;
+
+			unsigned const count = _count;
+			_count = 0;
+
+			bool const success = transfer(_write, _first, _blocks,
+			                              _segments, count);
+
+			Block::Packet_descriptor packets[MAX_REQUESTS];
+			for (unsigned i = 0; i < count; i++)
+				packets[i] = _packets[i];
+
+			for (unsigned i = 0; i < count; i++)
+				ack(packets[i], success);
+		}
+};
+
+#endif /* _REQUEST_BATCH_H_ */
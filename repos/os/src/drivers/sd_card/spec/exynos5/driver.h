@@ -98,6 +98,7 @@ class Block::Exynos5_driver : public Block::Driver
 			Block::Session::Operations o;
 			o.set_operation(Block::Packet_descriptor::READ);
 			o.set_operation(Block::Packet_descriptor::WRITE);
+			o.set_operation(Block::Packet_descriptor::FLUSH);
 			return o;
 		}
 
@@ -128,6 +128,9 @@ struct Main
 					driver.read_dma(number, count, phys, p);
 				else
 					driver.read(number, count, virt, p);
+
+				/* issue the request if the driver deferred it */
+				driver.submit_deferred();
 			}
 		} read_operation;
 
@@ -156,6 +159,9 @@ struct Main
 					driver.write_dma(number, count, phys, p);
 				else
 					driver.write(number, count, virt, p);
+
+				/* issue the request if the driver deferred it */
+				driver.submit_deferred();
 			}
 		} write_operation;
 
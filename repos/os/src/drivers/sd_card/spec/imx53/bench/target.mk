@@ -1,9 +1,11 @@
 TARGET    = sd_card_bench
 REQUIRES += imx53
 SRC_CC   += main.cc
-SRC_CC   += ../adma2.cc
+SRC_CC   += adma2.cc
 SRC_CC   += ../esdhcv2.cc
 LIBS     += base
 LIBS     += server
 INC_DIR  += $(PRG_DIR)/..
 INC_DIR  += $(PRG_DIR)/../../..
+
+vpath adma2.cc $(PRG_DIR)/../../..
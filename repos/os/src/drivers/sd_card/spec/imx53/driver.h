@@ -24,6 +24,7 @@
 
 /* local includes */
 #include <esdhcv2.h>
+#include <request_batch.h>
 
 namespace Block {
 	using namespace Genode;
@@ -48,6 +49,33 @@ class Block::Imx53_driver : public Block::Driver
 
 		bool const _use_dma;
 
+		Sd_card::Request_batch _batch;
+
+		/**
+		 * Record DMA request, transferring the batch if it does not fit in
+		 */
+		void _queue(bool write, Block::sector_t block_number,
+		            Genode::size_t block_count, Genode::addr_t phys,
+		            Packet_descriptor &packet)
+		{
+			if (!_batch.fits(write, block_number, block_count))
+				_submit_batch();
+
+			_batch.add(write, block_number, block_count, phys, packet);
+		}
+
+		void _submit_batch()
+		{
+			_batch.submit(
+				[&] (bool write, Block::sector_t nr, Genode::size_t cnt,
+				     Adma2::Segment const *segments, unsigned seg_cnt) {
+					return write
+					       ? _controller.write_blocks_dma(nr, cnt, segments, seg_cnt)
+					       : _controller.read_blocks_dma(nr, cnt, segments, seg_cnt); },
+				[&] (Packet_descriptor &packet, bool success) {
+					ack_packet(packet, success); });
+		}
+
 	public:
 
 		Imx53_driver(bool use_dma)
@@ -56,7 +84,8 @@ class Block::Imx53_driver : public Block::Driver
 			                Genode::Board_base::ESDHCV2_1_MMIO_SIZE),
 			_controller((addr_t)_esdhcv2_1_mmio.local_addr<void>(),
 			            Genode::Board_base::ESDHCV2_1_IRQ, _delayer, use_dma),
-			_use_dma(use_dma)
+			_use_dma(use_dma),
+			_batch(block_size(), Esdhcv2_controller::max_dma_blocks())
 		{
 			Sd_card::Card_info const card_info = _controller.card_info();
 
@@ -81,6 +110,7 @@ class Block::Imx53_driver : public Block::Driver
 			Block::Session::Operations o;
 			o.set_operation(Block::Packet_descriptor::READ);
 			o.set_operation(Block::Packet_descriptor::WRITE);
+			o.set_operation(Block::Packet_descriptor::FLUSH);
 			return o;
 		}
 
@@ -109,9 +139,7 @@ class Block::Imx53_driver : public Block::Driver
 		              Genode::addr_t     phys,
 		              Packet_descriptor &packet)
 		{
-			if (!_controller.read_blocks_dma(block_number, block_count, phys))
-				throw Io_error();
-			ack_packet(packet);
+			_queue(false, block_number, block_count, phys, packet);
 		}
 
 		void write_dma(Block::sector_t    block_number,
@@ -119,11 +147,13 @@ class Block::Imx53_driver : public Block::Driver
 		               Genode::addr_t     phys,
 		               Packet_descriptor &packet)
 		{
-			if (!_controller.write_blocks_dma(block_number, block_count, phys))
-				throw Io_error();
-			ack_packet(packet);
+			_queue(true, block_number, block_count, phys, packet);
 		}
 
+		void submit_deferred() override { _submit_batch(); }
+
+		void sync() override { _submit_batch(); }
+
 		bool dma_enabled() { return _use_dma; }
 
 		Genode::Ram_dataspace_capability alloc_dma_buffer(Genode::size_t size) {
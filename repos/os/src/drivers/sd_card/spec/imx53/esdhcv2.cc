@@ -248,15 +248,33 @@ bool Esdhcv2_controller::write_blocks(size_t, size_t, char const *)
 bool Esdhcv2_controller::read_blocks_dma(size_t blk_nr, size_t blk_cnt,
                                          addr_t buf_phys)
 {
-	if (_prepare_dma_mb(blk_cnt, buf_phys)) { return false; }
-	return issue_command(Read_multiple_block(blk_nr));
+	Adma2::Segment const segment { buf_phys, blk_cnt * BLOCK_SIZE };
+	return read_blocks_dma(blk_nr, blk_cnt, &segment, 1);
 }
 
 
 bool Esdhcv2_controller::write_blocks_dma(size_t blk_nr, size_t blk_cnt,
                                           addr_t buf_phys)
 {
-	if (_prepare_dma_mb(blk_cnt, buf_phys)) { return false; }
+	Adma2::Segment const segment { buf_phys, blk_cnt * BLOCK_SIZE };
+	return write_blocks_dma(blk_nr, blk_cnt, &segment, 1);
+}
+
+
+bool Esdhcv2_controller::read_blocks_dma(size_t blk_nr, size_t blk_cnt,
+                                         Adma2::Segment const *segments,
+                                         unsigned seg_cnt)
+{
+	if (_prepare_dma_mb(blk_cnt, segments, seg_cnt)) { return false; }
+	return issue_command(Read_multiple_block(blk_nr));
+}
+
+
+bool Esdhcv2_controller::write_blocks_dma(size_t blk_nr, size_t blk_cnt,
+                                          Adma2::Segment const *segments,
+                                          unsigned seg_cnt)
+{
+	if (_prepare_dma_mb(blk_cnt, segments, seg_cnt)) { return false; }
 	return issue_command(Write_multiple_block(blk_nr));
 }
 
@@ -269,11 +287,12 @@ Esdhcv2_controller::Esdhcv2_controller(addr_t const base, unsigned const irq,
 { }
 
 
-int Esdhcv2_controller::_prepare_dma_mb(size_t blk_cnt, addr_t buf_phys)
+int Esdhcv2_controller::_prepare_dma_mb(size_t blk_cnt,
+                                        Adma2::Segment const *segments,
+                                        unsigned seg_cnt)
 {
 	/* write ADMA2 table to DMA */
-	size_t const req_size = blk_cnt * BLOCK_SIZE;
-	if (_adma2_table.setup_request(req_size, buf_phys)) { return -1; }
+	if (_adma2_table.setup_request(segments, seg_cnt)) { return -1; }
 
 	/* configure DMA at host */
 	write<Adsaddr>(_adma2_table.base_phys());
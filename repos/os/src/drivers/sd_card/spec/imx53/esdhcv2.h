@@ -198,7 +198,8 @@ struct Genode::Esdhcv2_controller
 		int  _wait_for_card_ready_mbw();
 		int  _stop_transmission_mbw();
 		int  _wait_for_cmd_complete_mb(bool const r);
-		int  _prepare_dma_mb(size_t blk_cnt, addr_t buf_phys);
+		int  _prepare_dma_mb(size_t blk_cnt, Adma2::Segment const *segments,
+		                     unsigned seg_cnt);
 
 		Sd_card::Card_info _init();
 
@@ -237,6 +238,22 @@ struct Genode::Esdhcv2_controller
 		bool read_blocks_dma(size_t blk_nr, size_t blk_cnt, addr_t buf_phys);
 		bool write_blocks_dma(size_t blk_nr, size_t blk_cnt, addr_t buf_phys);
 
+		/**
+		 * Transfer blocks from or to a scattered buffer via DMA
+		 *
+		 * \param segments  buffer segments, covering 'blk_cnt' blocks
+		 * \param seg_cnt   number of segments
+		 */
+		bool read_blocks_dma(size_t blk_nr, size_t blk_cnt,
+		                     Adma2::Segment const *segments, unsigned seg_cnt);
+		bool write_blocks_dma(size_t blk_nr, size_t blk_cnt,
+		                      Adma2::Segment const *segments, unsigned seg_cnt);
+
+		/**
+		 * Maximum number of blocks per DMA transfer
+		 */
+		static size_t max_dma_blocks() { return Blkattr::Blkcnt::mask(); }
+
 		Sd_card::Card_info card_info() const { return _card_info; }
 };
 
@@ -7,3 +7,5 @@ LIBS     += base
 LIBS     += server
 INC_DIR  += $(PRG_DIR)
 INC_DIR  += $(PRG_DIR)/../../
+
+vpath adma2.cc $(PRG_DIR)/../..
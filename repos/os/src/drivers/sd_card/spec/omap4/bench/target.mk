@@ -1,6 +1,8 @@
 TARGET   = sd_card_bench
 REQUIRES = omap4
-SRC_CC   = main.cc
+SRC_CC   = main.cc adma2.cc
 LIBS     = base server
 INC_DIR += $(REP_DIR)/src/drivers/sd_card/spec/omap4
 INC_DIR += $(REP_DIR)/src/drivers/sd_card
+
+vpath adma2.cc $(REP_DIR)/src/drivers/sd_card
@@ -22,6 +22,7 @@
 
 /* local includes */
 #include <sd_card.h>
+#include <adma2.h>
 
 struct Mmchs : Genode::Mmio
 {
@@ -323,20 +324,6 @@ struct Mmchs : Genode::Mmio
 	 */
 	struct Admasal : Register<0x258, 32> { };
 
-	/**
-	 * ADMA descriptor layout
-	 */
-	struct Adma_desc : Genode::Register<64>
-	{
-		struct Valid   : Bitfield<0, 1> { };
-		struct Ent     : Bitfield<1, 1> { };
-		struct Int     : Bitfield<2, 1> { };
-		struct Act1    : Bitfield<4, 1> { };
-		struct Act2    : Bitfield<5, 1> { };
-		struct Length  : Bitfield<16, 16> { };
-		struct Address : Bitfield<32, 32> { };
-	};
-
 	bool reset_cmd_line(Delayer &delayer)
 	{
 		write<Sysctl::Src>(1);
@@ -492,13 +479,7 @@ struct Omap4_hsmmc_controller : private Mmchs, public Sd_card::Host_controller
 		Sd_card::Card_info _card_info;
 		bool const         _use_dma;
 
-		/*
-		 * DMA memory for holding the ADMA descriptor table
-		 */
-		enum { ADMA_DESC_MAX_ENTRIES = 1024 };
-		Genode::Attached_ram_dataspace _adma_desc_ds;
-		Adma_desc::access_t *    const _adma_desc;
-		Genode::addr_t           const _adma_desc_phys;
+		Adma2::Table       _adma2_table;
 
 		Genode::Irq_connection  _irq;
 		Genode::Signal_receiver _irq_rec;
@@ -619,75 +600,13 @@ struct Omap4_hsmmc_controller : private Mmchs, public Sd_card::Host_controller
 		 *
 		 * \return false if block request is too large
 		 */
-		bool _setup_adma_descriptor_table(size_t block_count,
-		                                  Genode::addr_t out_buffer_phys)
+		bool _setup_adma_descriptor_table(Adma2::Segment const *segments,
+		                                  unsigned count)
 		{
-			using namespace Sd_card;
-
 			/* reset ADMA offset to first descriptor */
-			write<Admasal>(_adma_desc_phys);
-
-			enum { BLOCK_SIZE = 512  /* bytes */ };
-
-			size_t const max_adma_request_size = 64*1024 - 4; /* bytes */
-
-			/*
-			 * sanity check
-			 *
-			 * XXX An alternative to this sanity check would be to expose
-			 *     the maximum DMA transfer size to the driver and let the
-			 *     driver partition large requests into ones that are
-			 *     supported by the controller.
-			 */
-			if (block_count*BLOCK_SIZE > max_adma_request_size*ADMA_DESC_MAX_ENTRIES) {
-				PERR("Block request too large");
-				return false;
-			}
-
-			/*
-			 * Each ADMA descriptor can transfer up to MAX_ADMA_REQUEST_SIZE
-			 * bytes. If the request is larger, we generate a list of ADMA
-			 * descriptors.
-			 */
-
-			size_t const total_bytes = block_count*BLOCK_SIZE;
-
-			/* number of bytes for which descriptors have been created */
-			addr_t consumed_bytes = 0;
-
-			for (int index = 0; consumed_bytes < total_bytes; index++) {
-
-				size_t const remaining_bytes = total_bytes - consumed_bytes;
-
-				/* clamp current request to maximum ADMA request size */
-				size_t const curr_bytes = Genode::min(max_adma_request_size,
-				                                      remaining_bytes);
-				/*
-				 * Assemble new ADMA descriptor
-				 */
-				Adma_desc::access_t desc = 0;
-				Adma_desc::Address::set(desc, out_buffer_phys + consumed_bytes);
-				Adma_desc::Length::set(desc, curr_bytes);
-
-				/* set action to transfer */
-				Adma_desc::Act1::set(desc, 0);
-				Adma_desc::Act2::set(desc, 1);
-
-				Adma_desc::Valid::set(desc, 1);
-
-				/*
-				 * Let the last descriptor generate transfer-complete interrupt
-				 */
-				if (consumed_bytes + curr_bytes == total_bytes)
-					Adma_desc::Ent::set(desc, 1);
+			write<Admasal>(_adma2_table.base_phys());
 
-				/* install descriptor into ADMA descriptor table */
-				_adma_desc[index] = desc;
-
-				consumed_bytes += curr_bytes;
-			}
-
-			return true;
+			return !_adma2_table.setup_request(segments, count);
 		}
 
 		bool _wait_for_transfer_complete()
@@ -770,11 +689,6 @@ struct Omap4_hsmmc_controller : private Mmchs, public Sd_card::Host_controller
 		:
 			Mmchs(mmio_base), _delayer(delayer), _card_info(_init()),
 			_use_dma(use_dma),
-			_adma_desc_ds(Genode::env()->ram_session(),
-			              ADMA_DESC_MAX_ENTRIES*sizeof(Adma_desc::access_t),
-			              Genode::UNCACHED),
-			_adma_desc(_adma_desc_ds.local_addr<Adma_desc::access_t>()),
-			_adma_desc_phys(Genode::Dataspace_client(_adma_desc_ds.cap()).phys_addr()),
 			_irq(IRQ_NUMBER)
 		{
 			_irq.sigh(_irq_rec.manage(&_irq_ctx));
@@ -964,13 +878,41 @@ struct Omap4_hsmmc_controller : private Mmchs, public Sd_card::Host_controller
 		 */
 		bool read_blocks_dma(size_t block_number, size_t block_count,
 		                     Genode::addr_t out_buffer_phys)
+		{
+			Adma2::Segment const segment { out_buffer_phys, block_count*512 };
+			return read_blocks_dma(block_number, block_count, &segment, 1);
+		}
+
+		/**
+		 * Write data blocks to SD card via master DMA
+		 *
+		 * \return true on success
+		 */
+		bool write_blocks_dma(size_t block_number, size_t block_count,
+		                      Genode::addr_t buffer_phys)
+		{
+			Adma2::Segment const segment { buffer_phys, block_count*512 };
+			return write_blocks_dma(block_number, block_count, &segment, 1);
+		}
+
+		/**
+		 * Read data blocks from SD card into a scattered buffer via master DMA
+		 *
+		 * \param segments  buffer segments, covering 'block_count' blocks
+		 * \param seg_count number of segments
+		 *
+		 * \return true on success
+		 */
+		bool read_blocks_dma(size_t block_number, size_t block_count,
+		                     Adma2::Segment const *segments, unsigned seg_count)
 		{
 			using namespace Sd_card;
 
 			write<Blk::Blen>(0x200);
 			write<Blk::Nblk>(block_count);
 
-			_setup_adma_descriptor_table(block_count, out_buffer_phys);
+			if (!_setup_adma_descriptor_table(segments, seg_count))
+				return false;
 
 			if (!issue_command(Read_multiple_block(block_number))) {
 				PERR("Read_multiple_block failed, Stat: 0x%08x", read<Stat>());
@@ -981,19 +923,23 @@ struct Omap4_hsmmc_controller : private Mmchs, public Sd_card::Host_controller
 		}
 
 		/**
-		 * Write data blocks to SD card via master DMA
+		 * Write data blocks from a scattered buffer to SD card via master DMA
+		 *
+		 * \param segments  buffer segments, covering 'block_count' blocks
+		 * \param seg_count number of segments
 		 *
 		 * \return true on success
 		 */
 		bool write_blocks_dma(size_t block_number, size_t block_count,
-		                      Genode::addr_t buffer_phys)
+		                      Adma2::Segment const *segments, unsigned seg_count)
 		{
 			using namespace Sd_card;
 
 			write<Blk::Blen>(0x200);
 			write<Blk::Nblk>(block_count);
 
-			_setup_adma_descriptor_table(block_count, buffer_phys);
+			if (!_setup_adma_descriptor_table(segments, seg_count))
+				return false;
 
 			if (!issue_command(Write_multiple_block(block_number))) {
 				PERR("Write_multiple_block failed");
@@ -1002,6 +948,11 @@ struct Omap4_hsmmc_controller : private Mmchs, public Sd_card::Host_controller
 
 			return _wait_for_transfer_complete_irq();
 		}
+
+		/**
+		 * Maximum number of blocks per DMA transfer
+		 */
+		static size_t max_dma_blocks() { return Blk::Nblk::mask(); }
 };
 
 #endif /* _DRIVERS__SD_CARD__SPEC__OMAP4__MMCHS_H_ */
@@ -1,5 +1,7 @@
 TARGET   = sd_card_drv
 REQUIRES = omap4
-SRC_CC   = main.cc
+SRC_CC   = main.cc adma2.cc
 LIBS     = base server
 INC_DIR += $(PRG_DIR) $(REP_DIR)/src/drivers/sd_card
+
+vpath adma2.cc $(REP_DIR)/src/drivers/sd_card
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2006-2013 Genode Labs GmbH
+ * Copyright (C) 2006-2015 Genode Labs GmbH
  * Copyright (C) 2012 Intel Corporation
  *
  * This file is part of the Genode OS framework, which is distributed
@@ -275,6 +275,11 @@ class Timer::Session_component : public Genode::Rpc_object<Session>,
 			return (now - _initial_time) / 1000;
 		}
 
+		unsigned long elapsed_us() const
+		{
+			return _timeout_scheduler.curr_time() - _initial_time;
+		}
+
 		void msleep(unsigned) { /* never called at the server side */ }
 		void usleep(unsigned) { /* never called at the server side */ }
 };
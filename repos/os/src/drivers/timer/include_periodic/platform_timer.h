@@ -16,6 +16,7 @@
 
 /* Genode inludes */
 #include <base/thread.h>
+#include <util/misc_math.h>
 #include <os/server.h>
 
 
@@ -68,9 +69,18 @@ class Platform_timer
 			unsigned long last_time = curr_time();
 			_lock.lock();
 			while (_next_timeout_usec) {
+
+				/*
+				 * Sleep for the remaining time if it is shorter than the
+				 * granularity so that sub-millisecond timeouts are not
+				 * rounded up to the next step.
+				 */
+				unsigned long const sleep_usec =
+					Genode::min(_next_timeout_usec, SLEEP_GRANULARITY_USEC);
+
 				_lock.unlock();
 
-				try { _usleep(SLEEP_GRANULARITY_USEC); }
+				try { _usleep(sleep_usec); }
 				catch (Genode::Blocking_canceled) { }
 
 				unsigned long now_time       = curr_time();
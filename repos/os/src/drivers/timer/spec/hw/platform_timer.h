@@ -29,7 +29,12 @@ class Platform_timer : public Platform_timer_base,
 {
 	private:
 
-		enum { MAX_TIMER_IRQS_PER_MS = 1 };
+		/*
+		 * Lower bound of timeouts, which limits the timer IRQ rate to
+		 * 20 per millisecond while still providing sub-millisecond
+		 * wakeups.
+		 */
+		enum { MIN_TIMEOUT_US = 50 };
 
 		unsigned long   const   _max_timeout_us;        /* maximum timeout in microsecs */
 		unsigned long mutable   _curr_time_us;          /* accumulate already measured timeouts */
@@ -101,8 +106,8 @@ class Platform_timer : public Platform_timer_base,
 			 * Constrain timout value with our maximum IRQ rate and the maximum
 			 * possible timeout.
 			 */
-			if (timeout_us < 1000/MAX_TIMER_IRQS_PER_MS)
-				timeout_us = 1000/MAX_TIMER_IRQS_PER_MS;
+			if (timeout_us < MIN_TIMEOUT_US)
+				timeout_us = MIN_TIMEOUT_US;
 			if (timeout_us > _max_timeout_us)
 				timeout_us = _max_timeout_us;
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -48,6 +48,22 @@ class I8250 : public Uart::Driver, public Genode::Irq_handler
 			DLHI = 1,
 		};
 
+		/**
+		 * Bits of the FIFO control register, which is the write-only
+		 * counterpart of 'EIR'
+		 */
+		enum Fcr {
+			FCR_ENABLE     = 0x01,
+			FCR_CLEAR_RX   = 0x02,
+			FCR_CLEAR_TX   = 0x04,
+			FCR_TRIGGER_1  = 0x00,  /* receive-FIFO trigger levels */
+			FCR_TRIGGER_4  = 0x40,
+			FCR_TRIGGER_8  = 0x80,
+			FCR_TRIGGER_14 = 0xc0,
+		};
+
+		char _fifo_trigger = FCR_TRIGGER_1;
+
 		/**
 		 * Read byte from i8250 register
 		 */
@@ -73,7 +89,7 @@ class I8250 : public Uart::Driver, public Genode::Irq_handler
 			_outb<DLHI>((115200/baud) >> 8);
 			_outb<LCR>(0x03);  /* set 8,N,1 */
 			_outb<IER>(0x00);  /* disable interrupts */
-			_outb<EIR>(0x07);  /* enable FIFOs */
+			_outb<EIR>(FCR_ENABLE | FCR_CLEAR_RX | FCR_CLEAR_TX | _fifo_trigger);
 			_outb<MCR>(0x0b);  /* force data terminal ready */
 			_outb<IER>(0x01);  /* enable RX interrupts */
 			_inb<IER>();
@@ -142,6 +158,20 @@ class I8250 : public Uart::Driver, public Genode::Irq_handler
 		{
 			_init_comport(bits_per_second);
 		}
+
+		/*
+		 * The RX interrupt enabled by '_init_comport' includes the
+		 * character-timeout interrupt for characters below the level.
+		 */
+		void rx_fifo_level(unsigned chars)
+		{
+			_fifo_trigger = chars >= 14 ? FCR_TRIGGER_14
+			              : chars >=  8 ? FCR_TRIGGER_8
+			              : chars >=  4 ? FCR_TRIGGER_4
+			              :               FCR_TRIGGER_1;
+
+			_outb<EIR>(FCR_ENABLE | _fifo_trigger);
+		}
 };
 
 #endif /* _DRIVERS__UART__SPEC__I8250__I8250_H_ */
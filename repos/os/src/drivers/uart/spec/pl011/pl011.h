@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -46,6 +46,7 @@ class Pl011 : public Uart::Driver, public Genode::Irq_handler
 			UARTFBRD  = 0x028,  /* fractional baud rate divisor */
 			UARTLCR_H = 0x02c,  /* line control */
 			UARTCR    = 0x030,  /* control */
+			UARTIFLS  = 0x034,  /* interrupt FIFO level select */
 			UARTIMSC  = 0x038,  /* interrupt mask register */
 			UARTICR   = 0x044,  /* interrupt clear register */
 		};
@@ -68,11 +69,17 @@ class Pl011 : public Uart::Driver, public Genode::Irq_handler
 			UARTCR_TXE       = 0x0100,  /* enable tx */
 			UARTCR_RXE       = 0x0200,  /* enable rx */
 
+			/* interrupt FIFO level select register */
+			UARTIFLS_RXIFLSEL_SHIFT = 3,
+			UARTIFLS_RXIFLSEL_MASK  = 0x38,
+
 			/* interrupt mask register */
 			UARTIMSC_RXIM    = 0x10,    /* rx interrupt mask */
+			UARTIMSC_RTIM    = 0x40,    /* rx timeout interrupt mask */
 
 			/* interrupt clear register */
 			UARTICR_RXIC     = 0x10,    /* rx interrupt clear */
+			UARTICR_RTIC     = 0x40,    /* rx timeout interrupt clear */
 		};
 
 		Genode::Attached_io_mem_dataspace  _io_mem;
@@ -125,8 +132,11 @@ class Pl011 : public Uart::Driver, public Genode::Irq_handler
 			/* enable uart */
 			_write_reg(UARTCR, _read_reg(UARTCR) | UARTCR_UARTEN);
 
-			/* enable rx interrupt */
-			_write_reg(UARTIMSC, UARTIMSC_RXIM);
+			/*
+			 * Enable rx interrupt and the rx timeout interrupt, which
+			 * reports characters that stay below the FIFO level
+			 */
+			_write_reg(UARTIMSC, UARTIMSC_RXIM | UARTIMSC_RTIM);
 		}
 
 		/***************************
@@ -139,7 +149,7 @@ class Pl011 : public Uart::Driver, public Genode::Irq_handler
 			_char_avail_callback();
 
 			/* acknowledge irq */
-			_write_reg(UARTICR, UARTICR_RXIC);
+			_write_reg(UARTICR, UARTICR_RXIC | UARTICR_RTIC);
 		}
 
 		/***************************
@@ -163,6 +173,19 @@ class Pl011 : public Uart::Driver, public Genode::Irq_handler
 		{
 			return _read_reg(UARTDR);
 		}
+
+		void rx_fifo_level(unsigned chars)
+		{
+			/* levels of 1/8, 1/4, 1/2, 3/4, and 7/8 of the 16-entry FIFO */
+			unsigned const sel = chars >= 14 ? 4
+			                   : chars >= 12 ? 3
+			                   : chars >=  8 ? 2
+			                   : chars >=  4 ? 1
+			                   :               0;
+
+			_write_reg(UARTIFLS, (_read_reg(UARTIFLS) & ~UARTIFLS_RXIFLSEL_MASK)
+			                     | (sel << UARTIFLS_RXIFLSEL_SHIFT));
+		}
 };
 
 #endif /* _DRIVERS__UART__SPEC__PL011__PL011_H_ */
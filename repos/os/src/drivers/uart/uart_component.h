@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -15,10 +15,12 @@
 #define _UART_COMPONENT_H_
 
 /* Genode includes */
+#include <base/lock.h>
 #include <base/rpc_server.h>
 #include <util/arg_string.h>
 #include <os/session_policy.h>
 #include <os/attached_ram_dataspace.h>
+#include <os/ring_buffer.h>
 #include <root/component.h>
 #include <uart_session/uart_session.h>
 
@@ -43,29 +45,117 @@ namespace Uart {
 			Genode::Attached_ram_dataspace _io_buffer;
 
 			/**
-			 * Functor informing the client about new data to read
+			 * Buffer of received characters
+			 *
+			 * The buffer is filled by the IRQ handler of the driver, which
+			 * empties the receive FIFO of the device on each interrupt. So
+			 * the FIFO does not overflow while the client is busy, and the
+			 * client can obtain all characters received meanwhile with one
+			 * 'read' RPC. The client is informed only when the buffer becomes
+			 * non-empty.
 			 */
-			struct Char_avail_callback : Uart::Char_avail_callback
+			struct Rx_buffer : Uart::Char_avail_callback
 			{
+				enum { SIZE = 16*IO_BUFFER_SIZE };
+
+				Genode::Lock lock;
+
+				typedef Genode::Ring_buffer<char, SIZE,
+				                            Genode::Ring_buffer_unsynchronized> Chars;
+
+				Chars chars;
+
+				Uart::Driver *driver = nullptr;
+
 				Genode::Signal_context_capability sigh;
 
+				unsigned long overruns = 0;
+
+				/**
+				 * Move characters from the device to the buffer
+				 *
+				 * \return  true if the buffer became non-empty
+				 */
+				bool fill()
+				{
+					Genode::Lock::Guard guard(lock);
+
+					if (!driver)
+						return false;
+
+					bool const was_empty = chars.empty();
+
+					while (driver->char_avail()) {
+						char const c = driver->get_char();
+						try { chars.add(c); }
+						catch (Chars::Overflow) {
+							if (!(overruns++ % IO_BUFFER_SIZE))
+								PWRN("receive buffer overrun, dropped %lu chars",
+								     overruns);
+						}
+					}
+					return was_empty && !chars.empty();
+				}
+
+				bool avail()
+				{
+					Genode::Lock::Guard guard(lock);
+					return !chars.empty();
+				}
+
+				Genode::size_t read(char *dst, Genode::size_t max_len)
+				{
+					Genode::Lock::Guard guard(lock);
+
+					Genode::size_t n = 0;
+					for (; n < max_len && !chars.empty(); n++)
+						dst[n] = chars.get();
+
+					return n;
+				}
+
+				void discard()
+				{
+					Genode::Lock::Guard guard(lock);
+					chars.reset();
+				}
+
+				/**
+				 * Called by the IRQ handler of the driver
+				 */
 				void operator ()()
 				{
-					if (sigh.valid())
+					if (fill() && sigh.valid())
 						Genode::Signal_transmitter(sigh).submit();
 				}
 
-			} _char_avail_callback;
+			} _rx_buffer;
 
 			Uart::Driver_factory &_driver_factory;
 			Uart::Driver         &_driver;
 
 			Size _size;
 
+			Uart::Driver &_create_driver(unsigned index, unsigned baudrate,
+			                             unsigned rx_fifo_level)
+			{
+				Uart::Driver &driver =
+					*_driver_factory.create(index, baudrate, _rx_buffer);
+
+				if (rx_fifo_level)
+					driver.rx_fifo_level(rx_fifo_level);
+
+				_rx_buffer.driver = &driver;
+				return driver;
+			}
+
 			unsigned char _poll_char()
 			{
-				while (!_driver.char_avail());
-				return _driver.get_char();
+				for (char c;;) {
+					_rx_buffer.fill();
+					if (_rx_buffer.read(&c, 1))
+						return c;
+				}
 			}
 
 			void _put_string(char const *s)
@@ -105,7 +195,8 @@ namespace Uart {
 				_put_string("\033[1;199r\033[199;255H");
 
 				/* flush incoming characters */
-				for (; _driver.char_avail(); _driver.get_char());
+				_rx_buffer.fill();
+				_rx_buffer.discard();
 
 				/* request cursor coordinates */
 				_put_string("\033[6n");
@@ -128,13 +219,17 @@ namespace Uart {
 
 			/**
 			 * Constructor
+			 *
+			 * \param rx_fifo_level  receive-FIFO level that triggers an
+			 *                       interrupt, 0 for the driver's default
 			 */
 			Session_component(Uart::Driver_factory &driver_factory,
-			                  unsigned index, unsigned baudrate, bool detect_size)
+			                  unsigned index, unsigned baudrate, bool detect_size,
+			                  unsigned rx_fifo_level)
 			:
 				_io_buffer(Genode::env()->ram_session(), IO_BUFFER_SIZE),
 				_driver_factory(driver_factory),
-				_driver(*_driver_factory.create(index, baudrate, _char_avail_callback)),
+				_driver(_create_driver(index, baudrate, rx_fifo_level)),
 				_size(detect_size ? _detect_size() : Size(0, 0))
 			{ }
 
@@ -155,18 +250,18 @@ namespace Uart {
 
 			Size size() { return _size; }
 
-			bool avail() { return _driver.char_avail(); }
+			bool avail()
+			{
+				_rx_buffer.fill();
+				return _rx_buffer.avail();
+			}
 
 			Genode::size_t _read(Genode::size_t dst_len)
 			{
-				char *io_buf      = _io_buffer.local_addr<char>();
-				Genode::size_t sz = Genode::min(dst_len, _io_buffer.size());
+				_rx_buffer.fill();
 
-				Genode::size_t n = 0;
-				while ((n < sz) && _driver.char_avail())
-					io_buf[n++] = _driver.get_char();
-
-				return n;
+				return _rx_buffer.read(_io_buffer.local_addr<char>(),
+				                       Genode::min(dst_len, _io_buffer.size()));
 			}
 
 			void _write(Genode::size_t num_bytes)
@@ -196,10 +291,11 @@ namespace Uart {
 
 			void read_avail_sigh(Genode::Signal_context_capability sigh)
 			{
-				_char_avail_callback.sigh = sigh;
+				_rx_buffer.sigh = sigh;
 
-				if (_driver.char_avail())
-					_char_avail_callback();
+				_rx_buffer.fill();
+				if (_rx_buffer.avail() && sigh.valid())
+					Genode::Signal_transmitter(sigh).submit();
 			}
 
 			Genode::size_t read(void *, Genode::size_t) { return 0; }
@@ -237,8 +333,14 @@ namespace Uart {
 						detect_size = policy.attribute("detect_size").has_value("yes");
 					} catch (Xml_node::Nonexistent_attribute) { }
 
+					unsigned rx_fifo_level = 0;
+					try {
+						policy.attribute("rx_fifo_level").value(&rx_fifo_level);
+					} catch (Xml_node::Nonexistent_attribute) { }
+
 					return new (md_alloc())
-						Session_component(_driver_factory, index, baudrate, detect_size);
+						Session_component(_driver_factory, index, baudrate,
+						                  detect_size, rx_fifo_level);
 
 				} catch (Xml_node::Nonexistent_attribute) {
 					PERR("Missing \"uart\" attribute in policy definition");
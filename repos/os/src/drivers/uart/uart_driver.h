@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -48,6 +48,19 @@ namespace Uart {
 		{
 			PINF("Setting baudrate is not supported yet. Use default 115200.");
 		}
+
+		/**
+		 * Set fill level of the receive FIFO that triggers an interrupt
+		 *
+		 * \param chars  number of characters, rounded to the nearest level
+		 *               supported by the device
+		 *
+		 * A high level reduces the number of interrupts at high baud rates.
+		 * Drivers that support this setting must also enable the
+		 * receive-timeout interrupt of the device so that characters below
+		 * the level are not held back.
+		 */
+		virtual void rx_fifo_level(unsigned /* chars */) { }
 	};
 
 	/**
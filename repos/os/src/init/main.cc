@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2010-2013 Genode Labs GmbH
+ * Copyright (C) 2010-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -156,12 +156,31 @@ namespace Init {
 }
 
 
-class Init::Child_registry : public Name_registry, Child_list
+class Init::Child_registry : public Name_registry, public Ram_broker, Child_list
 {
 	private:
 
 		List<Alias> _aliases;
 
+		/**
+		 * Return amount of RAM missing to satisfy all pending requests
+		 */
+		Genode::size_t _missing_ram_quota()
+		{
+			Genode::size_t requested = 0;
+			for_each_child([&] (Child &child) {
+				requested += child.requested_ram_quota(); });
+
+			Genode::size_t const avail = avail_slack_ram_quota();
+			return requested > avail ? requested - avail : 0;
+		}
+
+		void _respond_to_resource_requests()
+		{
+			for_each_child([&] (Child &child) {
+				child.try_response_to_resource_request(); });
+		}
+
 	public:
 
 		/**
@@ -174,6 +193,7 @@ class Init::Child_registry : public Name_registry, Child_list
 		 */
 		void insert(Child *child)
 		{
+			Genode::Lock::Guard guard(construction_lock());
 			Child_list::insert(&child->_list_element);
 		}
 
@@ -182,9 +202,20 @@ class Init::Child_registry : public Name_registry, Child_list
 		 */
 		void remove(Child *child)
 		{
+			Genode::Lock::Guard guard(construction_lock());
 			Child_list::remove(&child->_list_element);
 		}
 
+		/**
+		 * Respond to pending resource requests using the RAM freed up by
+		 * destroyed children
+		 */
+		void respond_to_resource_requests()
+		{
+			Genode::Lock::Guard guard(construction_lock());
+			_respond_to_resource_requests();
+		}
+
 		/**
 		 * Register alias
 		 */
@@ -231,6 +262,48 @@ class Init::Child_registry : public Name_registry, Child_list
 			return _aliases.first() ? _aliases.first() : 0;
 		}
 
+		/**
+		 * Return child with the specified name, or 0 if no such child exists
+		 */
+		Child *child(char const *name)
+		{
+			Genode::List_element<Child> *curr = first();
+			for (; curr; curr = curr->next())
+				if (curr->object()->has_name(name))
+					return curr->object();
+
+			return 0;
+		}
+
+		/**
+		 * Call 'fn' for each registered child
+		 *
+		 * The functor may remove the child it is called for.
+		 */
+		template <typename FN>
+		void for_each_child(FN const &fn)
+		{
+			Genode::List_element<Child> *curr = first(), *next = 0;
+			for (; curr; curr = next) {
+				next = curr->next();
+				fn(*curr->object());
+			}
+		}
+
+		/**
+		 * Return name of the child referred to by 'name'
+		 *
+		 * If 'name' is an alias, the name of the aliased child is returned.
+		 */
+		Alias::Child resolve_alias(char const *name) const
+		{
+			for (Alias const *a = _aliases.first(); a; a = a->next())
+				if (Alias::Name(name) == a->name)
+					return a->child;
+
+			return Alias::Child(name);
+		}
+
 
 		/*****************************
 		 ** Name-registry interface **
@@ -271,6 +344,377 @@ class Init::Child_registry : public Name_registry, Child_list
 
 			return 0;
 		}
+
+
+		/**************************
+		 ** Ram-broker interface **
+		 **************************/
+
+		void request_ram(Child &child, Genode::size_t amount) override
+		{
+			Genode::Lock::Guard guard(construction_lock());
+
+			child.requested_ram_quota(amount);
+			if (child.try_response_to_resource_request())
+				return;
+
+			Genode::size_t const missing = _missing_ram_quota();
+
+			bool reclaimable = false;
+			for_each_child([&] (Child &other) {
+				if (&other == &child || !other.ram_reclaimable())
+					return;
+
+				other.yield_ram(missing);
+				reclaimable = true;
+			});
+
+			if (!reclaimable)
+				PWRN("Cannot respond to resource request - out of memory");
+		}
+
+		void ram_yielded(Child &child) override
+		{
+			Genode::Lock::Guard guard(construction_lock());
+
+			/* withdraw no more than needed by the pending requests */
+			Genode::size_t const amount = child.withdraw_ram(_missing_ram_quota());
+
+			if (config_verbose)
+				Genode::printf("child \"%s\" yielded %zu bytes\n",
+				               child.name(), amount);
+
+			_respond_to_resource_requests();
+		}
+};
+
+
+/*****************************
+ ** Handling config updates **
+ *****************************/
+
+/**
+ * Return sub node of 'node', or an empty node if no such sub node exists
+ */
+inline Genode::Xml_node sub_node_or_empty(Genode::Xml_node node, char const *type)
+{
+	try { return node.sub_node(type); }
+	catch (...) { return Genode::Xml_node("<empty/>"); }
+}
+
+
+/**
+ * Look up start node of the child with the specified name
+ *
+ * \return true if a start node was found
+ */
+inline bool lookup_start_node(Genode::Xml_node config, char const *name,
+                              Genode::Xml_node &result)
+{
+	bool found = false;
+	config.for_each_sub_node("start", [&] (Genode::Xml_node start) {
+		if (start.attribute_value("name", Init::Alias::Name()) == Init::Alias::Name(name)) {
+			result = start;
+			found  = true;
+		}
+	});
+	return found;
+}
+
+
+/**
+ * Return name of the child referred to by 'name' according to the aliases
+ * declared in 'config'
+ */
+inline Init::Alias::Child resolve_alias(Genode::Xml_node config, char const *name)
+{
+	Init::Alias::Child result(name);
+	config.for_each_sub_node("alias", [&] (Genode::Xml_node alias) {
+		if (alias.attribute_value("name", Init::Alias::Name()) == Init::Alias::Name(name))
+			result = alias.attribute_value("child", Init::Alias::Child());
+	});
+	return result;
+}
+
+
+/**
+ * Return true if a route of the child refers to an alias changed by 'config'
+ */
+inline bool aliased_route_changed(Init::Child const &child,
+                                  Init::Child_registry const &children,
+                                  Genode::Xml_node config)
+{
+	using Init::Alias;
+
+	bool changed = false;
+	child.route().for_each_sub_node([&] (Genode::Xml_node service) {
+		service.for_each_sub_node("child", [&] (Genode::Xml_node target) {
+
+			Alias::Name const name = target.attribute_value("name", Alias::Name());
+
+			if (!(children.resolve_alias(name.string())
+			      == resolve_alias(config, name.string())))
+				changed = true;
+		});
+	});
+	return changed;
+}
+
+
+/**
+ * Destroy the children affected by a config update
+ *
+ * Children whose start node and route remain unchanged keep running.
+ * Children that vanished from the config or whose declaration changed are
+ * destroyed, as are all clients of destroyed children. The new and the
+ * changed children are created from the new config afterwards.
+ *
+ * \param config  new config
+ * \param all     destroy all children regardless of their declaration
+ */
+inline void destroy_outdated_children(Init::Child_registry &children,
+                                      Genode::Xml_node config, bool all)
+{
+	using namespace Genode;
+	using Init::Child;
+
+	Xml_node const default_route = sub_node_or_empty(config, "default-route");
+
+	List<List_element<Child> > outdated;
+
+	auto discard = [&] (Child &child) {
+		children.remove(&child);
+		outdated.insert(new (env()->heap()) List_element<Child>(&child));
+	};
+
+	children.for_each_child([&] (Child &child) {
+
+		Xml_node start_node = config;
+		if (all || !lookup_start_node(config, child.name(), start_node)
+		 || child.differs_from(start_node, default_route)
+		 || aliased_route_changed(child, children, config))
+			discard(child);
+	});
+
+	/* the clients of discarded servers must be restarted too */
+	for (bool clients_discarded = true; clients_discarded; ) {
+		clients_discarded = false;
+
+		children.for_each_child([&] (Child &child) {
+			for (List_element<Child> *e = outdated.first(); e; e = e->next())
+				if (child.uses_server(e->object()->server())) {
+					discard(child);
+					clients_discarded = true;
+					return;
+				}
+		});
+	}
+
+	while (List_element<Child> *e = outdated.first()) {
+		Child *child = e->object();
+		outdated.remove(e);
+		destroy(env()->heap(), e);
+
+		if (Init::config_verbose)
+			printf("destroy child \"%s\"\n", child->name());
+
+		/*
+		 * The sessions of the remaining outdated children to the server
+		 * vanish along with the server.
+		 */
+		for (e = outdated.first(); e; e = e->next())
+			e->object()->revoke_server(child->server());
+
+		destroy(env()->heap(), child);
+	}
+}
+
+
+/*******************************
+ ** Concurrent child creation **
+ *******************************/
+
+namespace Init { class Child_factory; }
+
+
+/**
+ * Utility for creating a batch of children concurrently
+ *
+ * The construction of a child consists of a chain of synchronous RPCs for
+ * creating its sessions, transferring quota, and loading its binary. Since
+ * children do not interact before they are started, they can be
+ * constructed independently from each other by a pool of worker threads.
+ * The children are registered and started in the order of their start
+ * nodes afterwards, which keeps the routing independent from the order
+ * of construction.
+ */
+class Init::Child_factory
+{
+	private:
+
+		struct Job
+		{
+			Genode::Xml_node const start_node;
+
+			Alias::Name const name = start_node.attribute_value("name", Alias::Name());
+
+			Child *child = 0;
+
+			Job(Genode::Xml_node start_node) : start_node(start_node) { }
+		};
+
+		enum { STACK_SIZE = 8*1024*sizeof(long) };
+
+		struct Worker : Genode::Thread<STACK_SIZE>
+		{
+			Child_factory &factory;
+
+			Worker(Child_factory &factory)
+			: Thread("child_factory"), factory(factory) { }
+
+			void entry() override { factory._work(); }
+		};
+
+		enum { MAX_JOBS = 256, MAX_THREADS = 16 };
+
+		Genode::Xml_node const    _default_route;
+		Child_registry           &_children;
+		long const                _prio_levels;
+		Genode::Affinity::Space const _affinity_space;
+		Genode::Service_registry &_parent_services;
+		Genode::Service_registry &_child_services;
+		Genode::Cap_session      &_cap;
+
+		Job      *_jobs[MAX_JOBS];
+		unsigned  _num_jobs = 0;
+
+		Genode::Lock _lock;
+		unsigned     _next_job = 0;
+
+		Job *_take()
+		{
+			Genode::Lock::Guard guard(_lock);
+			return _next_job < _num_jobs ? _jobs[_next_job++] : 0;
+		}
+
+		void _work()
+		{
+			while (Job *job = _take()) {
+				try {
+					job->child = new (Genode::env()->heap())
+						Child(job->start_node, _default_route, &_children,
+						      &_children, _prio_levels, _affinity_space, &_parent_services,
+						      &_child_services, &_cap);
+				}
+				catch (Genode::Rom_connection::Rom_connection_failed) {
+					/*
+					 * The binary does not exist. An error message is printed
+					 * by the Rom_connection constructor.
+					 */
+				}
+				catch (...) {
+					PERR("creation of child \"%s\" failed", job->name.string()); }
+			}
+		}
+
+		bool _scheduled(Alias::Name const &name) const
+		{
+			for (unsigned i = 0; i < _num_jobs; i++)
+				if (_jobs[i]->name == name)
+					return true;
+
+			return false;
+		}
+
+	public:
+
+		Child_factory(Genode::Xml_node               default_route,
+		              Child_registry                &children,
+		              long                           prio_levels,
+		              Genode::Affinity::Space const &affinity_space,
+		              Genode::Service_registry      &parent_services,
+		              Genode::Service_registry      &child_services,
+		              Genode::Cap_session           &cap)
+		:
+			_default_route(default_route), _children(children),
+			_prio_levels(prio_levels), _affinity_space(affinity_space),
+			_parent_services(parent_services), _child_services(child_services),
+			_cap(cap)
+		{ }
+
+		~Child_factory()
+		{
+			for (unsigned i = 0; i < _num_jobs; i++)
+				destroy(Genode::env()->heap(), _jobs[i]);
+		}
+
+		/**
+		 * Schedule the creation of a child
+		 */
+		void add(Genode::Xml_node start_node)
+		{
+			if (!start_node.has_attribute("name")) {
+				PWRN("Missing 'name' attribute in '<start>' entry.\n");
+				return;
+			}
+
+			if (_num_jobs == MAX_JOBS) {
+				PERR("too many children to create at once");
+				return;
+			}
+
+			Job *job = new (Genode::env()->heap()) Job(start_node);
+
+			/*
+			 * The uniqueness of the name is checked here because the
+			 * children of the batch are not yet registered while being
+			 * constructed.
+			 */
+			if (!_children.is_unique(job->name.string()) || _scheduled(job->name)) {
+				PERR("Child name \"%s\" is not unique", job->name.string());
+				destroy(Genode::env()->heap(), job);
+				return;
+			}
+
+			_jobs[_num_jobs++] = job;
+		}
+
+		/**
+		 * Construct the scheduled children using 'threads' worker threads
+		 */
+		void create(unsigned threads)
+		{
+			threads = Genode::min(Genode::min(threads, _num_jobs),
+			                      (unsigned)MAX_THREADS);
+
+			/* construct the children in the caller's context */
+			if (threads <= 1) {
+				_work();
+				return;
+			}
+
+			Worker *workers[MAX_THREADS];
+			for (unsigned i = 0; i < threads; i++) {
+				workers[i] = new (Genode::env()->heap()) Worker(*this);
+				workers[i]->start();
+			}
+
+			for (unsigned i = 0; i < threads; i++) {
+				workers[i]->join();
+				destroy(Genode::env()->heap(), workers[i]);
+			}
+		}
+
+		/**
+		 * Call 'fn' for each created child in the order of 'add' calls
+		 */
+		template <typename FN>
+		void for_each_child(FN const &fn)
+		{
+			for (unsigned i = 0; i < _num_jobs; i++)
+				if (_jobs[i]->child)
+					fn(*_jobs[i]->child);
+		}
 };
 
 
@@ -330,25 +774,31 @@ int main(int, char **)
 
 		});
 
-		/* create children */
+		/* create children, skipping those that survived a config update */
 		try {
+			Child_factory factory(default_route_node, children, read_prio_levels(),
+			                      read_affinity_space(), parent_services,
+			                      child_services, cap);
+
 			config()->xml_node().for_each_sub_node("start", [&] (Xml_node start_node) {
 
-				try {
-					children.insert(new (env()->heap())
-					                Init::Child(start_node, default_route_node,
-					                            &children, read_prio_levels(),
-					                            read_affinity_space(),
-					                            &parent_services, &child_services, &cap));
-				}
-				catch (Rom_connection::Rom_connection_failed) {
-					/*
-					 * The binary does not exist. An error message is printed
-					 * by the Rom_connection constructor.
-					 */
-				}
+				Alias::Name const name = start_node.attribute_value("name", Alias::Name());
+				if (!children.child(name.string()))
+					factory.add(start_node);
 			});
 
+			/*
+			 * The messages printed by children in verbose mode would be
+			 * interleaved if the children were created concurrently.
+			 */
+			unsigned const startup_threads = config_verbose ? 1 :
+				config()->xml_node().attribute_value("startup_threads", 4U);
+
+			factory.create(startup_threads);
+
+			factory.for_each_child([&] (Init::Child &child) {
+				children.insert(&child); });
+
 			/* start children */
 			children.start();
 		}
@@ -362,8 +812,9 @@ int main(int, char **)
 		/*
 		 * Respond to config changes at runtime
 		 *
-		 * If the config gets updated to a new version, we kill the current
-		 * scenario and start again with the new config.
+		 * If the config gets updated to a new version, we keep the children
+		 * whose declaration remained the same and restart all others. A
+		 * change of the global declarations restarts the whole scenario.
 		 */
 
 		/* wait for config change */
@@ -375,12 +826,28 @@ int main(int, char **)
 			PWRN("unexpected signal received - drop it");
 		}
 
-		/* kill all currently running children */
-		while (children.any()) {
-			Init::Child *child = children.any();
-			children.remove(child);
-			destroy(env()->heap(), child);
-		}
+		/* remember global declarations of the current config */
+		long            const prio_levels    = read_prio_levels();
+		Affinity::Space const affinity_space = read_affinity_space();
+		Xml_node_copy   const parent_provides(sub_node_or_empty(config()->xml_node(),
+		                                                        "parent-provides"));
+
+		/* reload config */
+		try { config()->reload(); } catch (...) { }
+
+		Xml_node const config_node = config()->xml_node();
+
+		bool const global_change =
+			prio_levels                   != read_prio_levels()
+		 || affinity_space.width()        != read_affinity_space().width()
+		 || affinity_space.height()       != read_affinity_space().height()
+		 || parent_provides.differs_from(sub_node_or_empty(config_node,
+		                                                   "parent-provides"));
+
+		destroy_outdated_children(children, config_node, global_change);
+
+		/* the quota of the destroyed children may satisfy pending requests */
+		children.respond_to_resource_requests();
 
 		/* remove all known aliases */
 		while (children.any_alias()) {
@@ -391,9 +858,6 @@ int main(int, char **)
 
 		/* reset knowledge about parent services */
 		parent_services.remove_all();
-
-		/* reload config */
-		try { config()->reload(); } catch (...) { }
 	}
 
 	return 0;
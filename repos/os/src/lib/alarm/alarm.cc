@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2005-2013 Genode Labs GmbH
+ * Copyright (C) 2005-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -17,67 +17,96 @@
 using namespace Genode;
 
 
-void Alarm_scheduler::_unsynchronized_enqueue(Alarm *alarm)
+Alarm *Alarm_scheduler::_meld(Alarm *a, Alarm *b)
 {
-	if (alarm->_active) {
-		PERR("trying to insert the same alarm twice!");
-		return;
+	if (!a) return b;
+	if (!b) return a;
+
+	if (_earlier(b, a)) {
+		Alarm *tmp = a; a = b; b = tmp;
 	}
 
-	alarm->_active++;
+	/* make 'b' the leftmost child of 'a' */
+	b->_prev    = a;
+	b->_sibling = a->_child;
 
-	/* if alarmlist is empty add first element */
-	if (!_head) {
-		alarm->_next = 0;
-		_head = alarm;
-		return;
+	if (a->_child)
+		a->_child->_prev = b;
+
+	a->_child = b;
+	return a;
+}
+
+
+Alarm *Alarm_scheduler::_meld_siblings(Alarm *first)
+{
+	/* meld pairs of siblings from left to right, collect them reversed */
+	Alarm *pairs = 0;
+	while (first) {
+		Alarm *a = first;
+		Alarm *b = a->_sibling;
+		first = b ? b->_sibling : 0;
+
+		a->_sibling = a->_prev = 0;
+		if (b)
+			b->_sibling = b->_prev = 0;
+
+		Alarm *pair = _meld(a, b);
+		pair->_sibling = pairs;
+		pairs = pair;
 	}
 
-	/* if deadline is smaller than any other deadline, put it on the head */
-	if ((int)alarm->_deadline - (int)_now < (int)_head->_deadline - (int)_now) {
-		alarm->_next = _head;
-		_head = alarm;
-		return;
+	/* meld the pairs from right to left */
+	Alarm *result = 0;
+	while (pairs) {
+		Alarm *next = pairs->_sibling;
+		pairs->_sibling = 0;
+		result = _meld(result, pairs);
+		pairs = next;
 	}
+	return result;
+}
 
-	/* find list element with a higher deadline */
-	Alarm *curr = _head;
-	while (curr->_next &&
-	       (int)curr->_next->_deadline - (int)_now < (int)alarm->_deadline - (int)_now)
-		curr = curr->_next;
 
-	/* if end of list is reached, append new element */
-	if (curr->_next == 0) {
-		curr->_next = alarm;
+void Alarm_scheduler::_unsynchronized_enqueue(Alarm *alarm)
+{
+	if (alarm->_active) {
+		PERR("trying to insert the same alarm twice!");
 		return;
 	}
 
-	/* insert element in middle of list */
-	alarm->_next = curr->_next;
-	curr->_next  = alarm;
+	alarm->_active++;
+	alarm->_unlink();
+
+	_head = _meld(_head, alarm);
 }
 
 
 void Alarm_scheduler::_unsynchronized_dequeue(Alarm *alarm)
 {
-	if (!_head) return;
+	/* alarm is not enqueued */
+	if (!alarm->_active) return;
+
+	Alarm *children = _meld_siblings(alarm->_child);
 
 	if (_head == alarm) {
-		_head = alarm->_next;
+		_head = children;
 		alarm->_reset();
 		return;
 	}
 
-	/* find predecessor in alarm queue */
-	Alarm *curr;
-	for (curr = _head; curr && (curr->_next != alarm); curr = curr->_next);
+	/* unlink alarm from its parent or left sibling */
+	if (alarm->_prev->_child == alarm)
+		alarm->_prev->_child = alarm->_sibling;
+	else
+		alarm->_prev->_sibling = alarm->_sibling;
 
-	/* alarm is not enqueued */
-	if (!curr) return;
+	if (alarm->_sibling)
+		alarm->_sibling->_prev = alarm->_prev;
 
-	/* remove alarm from alarm queue */
-	curr->_next = alarm->_next;
 	alarm->_reset();
+
+	_head = _meld(_head, children);
 }
 
 
@@ -88,9 +117,9 @@ Alarm *Alarm_scheduler::_get_pending_alarm()
 	if (!_head || ((int)_head->_deadline - (int)_now >= 0))
 		return 0;
 
-	/* remove alarm from head of the list */
+	/* remove alarm from the root of the heap */
 	Alarm *pending_alarm = _head;
-	_head = _head->_next;
+	_head = _meld_siblings(_head->_child);
 
 	/*
 	 * Acquire dispatch lock to defer destruction until the call of 'on_alarm'
@@ -99,7 +128,7 @@ Alarm *Alarm_scheduler::_get_pending_alarm()
 	pending_alarm->_dispatch_lock.lock();
 
 	/* reset alarm object */
-	pending_alarm->_next = 0;
+	pending_alarm->_unlink();
 	pending_alarm->_active--;
 
 	return pending_alarm;
@@ -230,13 +259,13 @@ Alarm_scheduler::~Alarm_scheduler()
 
 	while (_head) {
 
-		Alarm *next = _head->_next;
+		Alarm *alarm = _head;
 
-		/* reset alarm object */
-		_head->_reset();
+		/* remove from heap */
+		_head = _meld_siblings(alarm->_child);
 
-		/* remove from list */
-		_head = next;
+		/* reset alarm object */
+		alarm->_reset();
 	}
 }
 
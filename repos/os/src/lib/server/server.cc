@@ -13,6 +13,7 @@
 
 #include <os/server.h>
 #include <cap_session/connection.h>
+#include <util/construct_at.h>
 
 using namespace Server;
 
@@ -59,6 +60,121 @@ static void dispatch(Signal &sig)
 }
 
 
+namespace {
+
+	/**
+	 * Set of pending signals, dispatched by priority
+	 */
+	struct Signal_batch
+	{
+		enum { MAX_SIGNALS = 32 };
+
+		char     _space[MAX_SIGNALS][sizeof(Signal)]
+			__attribute__((aligned(sizeof(addr_t))));
+		bool     _done[MAX_SIGNALS];
+		unsigned _count = 0;
+
+		Thread_base * const _thread = Thread_base::myself();
+
+		/*
+		 * Batch currently dispatched by the entrypoint
+		 *
+		 * A held signal blocks the dissolving of its context. A signal handler
+		 * that dissolves another signal dispatcher of the batch would thereby
+		 * deadlock. So the entrypoint releases the signal of a context that is
+		 * dissolved during the dispatching.
+		 */
+		static Signal_batch *&active()
+		{
+			static Signal_batch *batch;
+			return batch;
+		}
+
+		Signal_batch() { active() = this; }
+
+		Signal &_signal(unsigned i) { return *(Signal *)_space[i]; }
+
+		static unsigned _priority(Signal &sig)
+		{
+			Signal_dispatcher_base *dispatcher =
+				dynamic_cast<Signal_dispatcher_base *>(sig.context());
+
+			return dispatcher ? dispatcher->priority() : 0;
+		}
+
+		/**
+		 * Fetch pending signals
+		 *
+		 * \return  true if the batch is full, i.e., further signals may be
+		 *          pending
+		 */
+		bool fill()
+		{
+			try {
+				for (; _count < MAX_SIGNALS; _count++) {
+					construct_at<Signal>(_space[_count],
+					                     global_sig_rec().pending_signal());
+					_done[_count] = false;
+				}
+			} catch (Signal_receiver::Signal_not_pending) { return false; }
+
+			return true;
+		}
+
+		void _release(unsigned i)
+		{
+			_done[i] = true;
+			_signal(i).~Signal();
+		}
+
+		void dispatch()
+		{
+			/* dispatch in the order of priority, keep arrival order otherwise */
+			for (;;) {
+
+				unsigned next = 0, next_prio = 0;
+				bool     found = false;
+				for (unsigned i = 0; i < _count; i++) {
+					if (_done[i]) continue;
+
+					unsigned const prio = _priority(_signal(i));
+					if (!found || prio > next_prio) {
+						next = i; next_prio = prio; found = true; }
+				}
+				if (!found)
+					return;
+
+				Signal sig = _signal(next);
+				_release(next);
+				::dispatch(sig);
+			}
+		}
+
+		/**
+		 * Drop pending signal of 'context'
+		 */
+		void release(Signal_context *context)
+		{
+			if (Thread_base::myself() != _thread)
+				return;
+
+			for (unsigned i = 0; i < _count; i++)
+				if (!_done[i] && _signal(i).context() == context)
+					_release(i);
+		}
+
+		~Signal_batch()
+		{
+			for (unsigned i = 0; i < _count; i++)
+				if (!_done[i])
+					_release(i);
+
+			active() = nullptr;
+		}
+	};
+}
+
+
 /**
  * Dispatch a signal at entry point
  */
@@ -77,6 +193,9 @@ Signal_context_capability Entrypoint::manage(Signal_dispatcher_base &dispatcher)
 
 void Server::Entrypoint::dissolve(Signal_dispatcher_base &dispatcher)
 {
+	if (Signal_batch::active())
+		Signal_batch::active()->release(&dispatcher);
+
 	global_sig_rec().dissolve(&dispatcher);
 }
 
@@ -105,10 +224,17 @@ struct Server::Constructor_component : Rpc_object<Server::Constructor,
 
 	void signal()
 	{
-		try {
-			Signal sig = global_sig_rec().pending_signal();
-			::dispatch(sig);
-		} catch (Signal_receiver::Signal_not_pending) { }
+		/*
+		 * One wakeup of the receiver may stand for several contexts. Each
+		 * pending context is fetched once with the accumulated number of
+		 * its signals. We collect the pending signals in batches and
+		 * dispatch them in the order of their priority.
+		 */
+		for (bool more = true; more; ) {
+			Signal_batch batch;
+			more = batch.fill();
+			batch.dispatch();
+		}
 	}
 };
 
@@ -0,0 +1,81 @@
+/*
+ * \brief  Trace policy that records events in binary form
+ * \author Norman Feske
+ * \date   2015-12-18
+ *
+ * The layout of the events is defined by 'trace/binary_event.h'. The
+ * thread and its CPU are not part of the events because each trace buffer
+ * belongs to one thread, whose CPU affinity is reported by the 'Trace'
+ * session as part of the subject information.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <util/string.h>
+#include <trace/policy.h>
+#include <trace/timestamp.h>
+#include <trace/binary_event.h>
+
+using namespace Genode;
+
+typedef Trace::Binary_event Event;
+
+
+static size_t generate(char *dst, Event::Type type, char const *name,
+                       unsigned value)
+{
+	Event &event = *(Event *)dst;
+
+	size_t const name_len = name ? min(strlen(name), (size_t)Event::MAX_NAME_LEN) : 0;
+
+	event.timestamp = Trace::timestamp();
+	event.type      = type;
+	event.name_len  = name_len;
+	event.reserved  = 0;
+	event.value     = value;
+
+	memcpy(event.name, (void *)name, name_len);
+
+	return Event::size(name_len);
+}
+
+
+size_t max_event_size()
+{
+	return Event::size(Event::MAX_NAME_LEN);
+}
+
+size_t rpc_call(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return generate(dst, Event::RPC_CALL, rpc_name, 0);
+}
+
+size_t rpc_returned(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return generate(dst, Event::RPC_RETURNED, rpc_name, 0);
+}
+
+size_t rpc_dispatch(char *dst, char const *rpc_name)
+{
+	return generate(dst, Event::RPC_DISPATCH, rpc_name, 0);
+}
+
+size_t rpc_reply(char *dst, char const *rpc_name)
+{
+	return generate(dst, Event::RPC_REPLY, rpc_name, 0);
+}
+
+size_t signal_submit(char *dst, unsigned const num)
+{
+	return generate(dst, Event::SIGNAL_SUBMIT, 0, num);
+}
+
+size_t signal_receive(char *dst, Signal_context const &, unsigned num)
+{
+	return generate(dst, Event::SIGNAL_RECEIVED, 0, num);
+}
@@ -0,0 +1,5 @@
+TARGET = binary_policy
+
+TARGET_POLICY = binary
+
+include $(PRG_DIR)/../policy.inc
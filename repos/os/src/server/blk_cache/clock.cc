@@ -0,0 +1,79 @@
+/*
+ * \brief  CLOCK (second-chance) cache replacement strategy
+ * \author Stefan Kalkowski
+ * \date   2013-12-05
+ */
+
+/*
+ * Copyright (C) 2013 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+#include <base/printf.h>
+#include "clock.h"
+#include "driver.h"
+
+typedef Driver<Clock_policy>::Chunk_level_4 Chunk;
+
+/* elements in the order the clock hand visits them */
+static Cache::Dlist<Clock_policy::Element> clock_ring;
+static Clock_policy::Element              *hand = 0;
+
+
+static void clock_access(const Clock_policy::Element *e)
+{
+	e->referenced = true;
+
+	/* new elements are placed right behind the hand */
+	if (!e->list())
+		clock_ring.insert_before(e, hand);
+}
+
+
+/*
+ * Advance the hand by one element and wrap around at the end of the ring
+ */
+static Clock_policy::Element *clock_advance(Clock_policy::Element *e) {
+	return e->next() ? e->next() : clock_ring.first(); }
+
+
+void Clock_policy::read(const Clock_policy::Element  *e) {
+	clock_access(e); }
+
+
+void Clock_policy::write(const Clock_policy::Element *e) {
+	clock_access(e); }
+
+
+void Clock_policy::flush(Cache::size_t size)
+{
+	Cache::size_t s = 0;
+	if (!hand) hand = clock_ring.first();
+
+	while (hand && ((size == 0) || (s < size))) {
+		Clock_policy::Element *e = hand;
+
+		/* give referenced elements a second chance */
+		if (e->referenced && size) {
+			e->referenced = false;
+			hand = clock_advance(e);
+			continue;
+		}
+
+		/* the element is gone when its chunk gets freed */
+		Clock_policy::Element *n = e->next();
+		clock_ring.remove(e);
+		if (Driver<Clock_policy>::evict(e)) {
+			s += sizeof(Chunk);
+			hand = n ? n : clock_ring.first();
+			continue;
+		}
+
+		/* chunk was dirty and got synchronized, revisit it next */
+		clock_ring.insert_before(e, n);
+		e->referenced = false;
+	}
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
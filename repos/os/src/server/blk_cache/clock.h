@@ -0,0 +1,34 @@
+/*
+ * \brief  CLOCK (second-chance) cache replacement strategy
+ * \author Stefan Kalkowski
+ * \date   2013-12-05
+ */
+
+/*
+ * Copyright (C) 2013 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include "chunk.h"
+#include "dlist.h"
+
+/**
+ * Approximation of LRU, which only sets a reference bit on access
+ */
+struct Clock_policy
+{
+	class Element : public Cache::Dlist<Element>::Element
+	{
+		public:
+
+			mutable bool referenced;
+
+			Element() : referenced(false) { }
+	};
+
+	static void read(const Element  *e);
+	static void write(const Element *e);
+	static void flush(Cache::size_t size = 0);
+};
@@ -0,0 +1,133 @@
+/*
+ * \brief  Intrusive doubly-linked list used by the replacement policies
+ * \author Stefan Kalkowski
+ * \date   2013-12-05
+ */
+
+/*
+ * Copyright (C) 2013 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _DLIST_H_
+#define _DLIST_H_
+
+namespace Cache { template <typename> class Dlist; }
+
+
+/**
+ * Doubly-linked list, which allows for unlinking an element in O(1)
+ *
+ * The policy hooks get called with const elements, therefore the link
+ * members are mutable.
+ */
+template <typename T>
+class Cache::Dlist
+{
+	public:
+
+		class Element
+		{
+			private:
+
+				friend class Dlist;
+
+				mutable Element *_prev;
+				mutable Element *_next;
+				mutable Dlist   *_list;
+
+			public:
+
+				Element() : _prev(nullptr), _next(nullptr), _list(nullptr) { }
+
+				/**
+				 * Return list the element is linked into, or 0
+				 */
+				Dlist *list() const { return _list; }
+
+				T *next() const { return static_cast<T*>(_next); }
+				T *prev() const { return static_cast<T*>(_prev); }
+		};
+
+	private:
+
+		Element       *_head;
+		Element       *_tail;
+		unsigned long  _count;
+
+	public:
+
+		Dlist() : _head(nullptr), _tail(nullptr), _count(0) { }
+
+		T *first() const { return static_cast<T*>(_head); }
+		T *last()  const { return static_cast<T*>(_tail); }
+
+		unsigned long count() const { return _count; }
+
+		/**
+		 * Insert element at the head of the list
+		 */
+		void insert(T const *t)
+		{
+			Element const *e = t;
+			e->_prev = nullptr;
+			e->_next = _head;
+			e->_list = this;
+			if (_head) _head->_prev = const_cast<Element*>(e);
+			else       _tail        = const_cast<Element*>(e);
+			_head = const_cast<Element*>(e);
+			_count++;
+		}
+
+		/**
+		 * Insert element at the tail of the list
+		 */
+		void append(T const *t)
+		{
+			Element const *e = t;
+			e->_prev = _tail;
+			e->_next = nullptr;
+			e->_list = this;
+			if (_tail) _tail->_next = const_cast<Element*>(e);
+			else       _head        = const_cast<Element*>(e);
+			_tail = const_cast<Element*>(e);
+			_count++;
+		}
+
+		/**
+		 * Insert element in front of 'at', or at the tail if 'at' is 0
+		 */
+		void insert_before(T const *t, T const *at)
+		{
+			Element const *a = at;
+			if (!a)         { append(t); return; }
+			if (a == _head) { insert(t); return; }
+
+			Element const *e = t;
+			e->_prev = a->_prev;
+			e->_next = const_cast<Element*>(a);
+			e->_list = this;
+			a->_prev->_next = const_cast<Element*>(e);
+			a->_prev        = const_cast<Element*>(e);
+			_count++;
+		}
+
+		/**
+		 * Unlink element, which must be part of this list
+		 */
+		void remove(T const *t)
+		{
+			Element const *e = t;
+			if (e->_prev) e->_prev->_next = e->_next;
+			else          _head           = e->_next;
+			if (e->_next) e->_next->_prev = e->_prev;
+			else          _tail           = e->_prev;
+			e->_prev = e->_next = nullptr;
+			e->_list = nullptr;
+			_count--;
+		}
+};
+
+#endif /* _DLIST_H_ */
@@ -50,6 +50,7 @@ class Driver : public Block::Driver
 			bool match(const Block::Packet_descriptor& reply) const
 			{
 				return reply.operation()    == srv.operation()  &&
+				       reply.offset()       == srv.offset()     &&
 				       reply.block_number() == srv.block_number() &&
 				       reply.block_count()  == srv.block_count();
 			}
@@ -99,7 +100,9 @@ class Driver : public Block::Driver
 
 		enum {
 			SLAB_SZ = Block::Session::TX_QUEUE_SIZE*sizeof(Request),
-			CACHE_BLK_SIZE = 4096
+			CACHE_BLK_SIZE = 4096,
+			READ_AHEAD     = 16, /* cache blocks read ahead when streaming */
+			WRITE_BACK_MAX = 32, /* cache blocks combined in one write    */
 		};
 
 		/**
@@ -127,6 +130,15 @@ class Driver : public Block::Driver
 		Genode::Signal_rpc_member<Driver> _source_ack;
 		Genode::Signal_rpc_member<Driver> _source_submit;
 		Genode::Signal_rpc_member<Driver> _yield;
+		Block::sector_t                   _seq_next;  /* sequential access  */
+
+		/*
+		 * Adjacent dirty chunks are collected by the synchronization
+		 * routine and written to the backend device as one request
+		 */
+		Cache::offset_t                   _wb_off;
+		unsigned                          _wb_cnt;
+		char const                       *_wb_data[WRITE_BACK_MAX];
 
 		Driver(Driver const&);            /* singleton pattern */
 		Driver& operator=(Driver const&); /* singleton pattern */
@@ -150,6 +162,60 @@ class Driver : public Block::Driver
 			       ? nr + _cache_blk_mod() - (nr % _cache_blk_mod())
 			       : nr; }
 
+		/*
+		 * Return number of device blocks, which can be read ahead
+		 *
+		 * \param nr   first block number after the requested range
+		 * \param max  maximum number of cache blocks to read ahead
+		 *
+		 * Read-ahead stops at the first cache block that is already
+		 * present, or pending, as well as at the end of the device.
+		 */
+		Genode::size_t _read_ahead(Block::sector_t nr, unsigned max)
+		{
+			unsigned i = 0;
+			for (; i < max; i++, nr += _cache_blk_mod()) {
+				if (nr + _cache_blk_mod() > _blk_cnt)
+					break;
+
+				bool pending = false;
+				for (Request *r = _r_list.first(); r && !pending; r = r->next())
+					pending = r->match(false, nr, _cache_blk_mod());
+				if (pending)
+					break;
+
+				try {
+					_cache.stat(CACHE_BLK_SIZE, nr * _blk_sz);
+					break;
+				} catch(Cache::Chunk_base::Range_incomplete &) { }
+			}
+			return i * _cache_blk_mod();
+		}
+
+		/*
+		 * Write data read from the backend device into the cache
+		 *
+		 * Only chunks that hold no data yet are filled, so that neither
+		 * data written by clients in the meantime gets overwritten, nor
+		 * chunks evicted in the meantime get allocated again.
+		 */
+		void _fill(char const *src, Cache::size_t len, Cache::offset_t off)
+		{
+			while (len > 0) {
+				Cache::size_t const sz = Genode::min(len,
+				                                     (Cache::size_t)CACHE_BLK_SIZE);
+				try {
+					_cache.stat(sz, off);
+				} catch(Cache::Chunk_base::Range_incomplete &) {
+					try { _cache.write(src, sz, off); }
+					catch(Cache::Chunk_base::Range_incomplete &) { }
+				}
+				src += sz;
+				off += sz;
+				len -= sz;
+			}
+		}
+
 		/*
 		 * Handle response to a single request
 		 *
@@ -160,11 +226,13 @@ class Driver : public Block::Driver
 		{
 			try {
 			if (r->cli.operation() == Block::Packet_descriptor::READ)
-				read(r->cli.block_number(), r->cli.block_count(),
-				     r->buffer, r->cli);
-			else
+				_read(r->cli.block_number(), r->cli.block_count(),
+				      r->buffer, r->cli);
+			else if (r->cli.operation() == Block::Packet_descriptor::WRITE)
 				write(r->cli.block_number(), r->cli.block_count(),
 				      r->buffer, r->cli);
+			else
+				ack_packet(r->cli, srv.succeeded());
 			} catch(Block::Driver::Request_congestion) {
 				PWRN("cli (%lld %zu) srv (%lld %zu)",
 					 r->cli.block_number(), r->cli.block_count(),
@@ -182,9 +250,9 @@ class Driver : public Block::Driver
 
 				/* when reading, write result into cache */
 				if (p.operation() == Block::Packet_descriptor::READ)
-					_cache.write(_blk.tx()->packet_content(p),
-					             p.block_count() * _blk_sz,
-					             p.block_number() * _blk_sz);
+					_fill(_blk.tx()->packet_content(p),
+					      p.block_count() * _blk_sz,
+					      p.block_number() * _blk_sz);
 
 				/* loop through the list of requests, and ack all related */
 				for (Request *r = _r_list.first(), *r_to_handle = r; r;
@@ -212,11 +280,13 @@ class Driver : public Block::Driver
 		 * \param block_number block number offset
 		 * \param block_count  number of blocks
 		 * \param packet       original packet request received from the client
+		 * \param read_ahead   maximum number of cache blocks to read ahead
 		 */
 		void _request(Block::sector_t           block_number,
 		              Genode::size_t            block_count,
 					  char * const              buffer,
-		              Block::Packet_descriptor &packet)
+		              Block::Packet_descriptor &packet,
+		              unsigned                  read_ahead = 0)
 		{
 			Block::Packet_descriptor p_to_dev;
 
@@ -241,14 +311,27 @@ class Driver : public Block::Driver
 				Genode::size_t cnt = _cache_blk_round_up(block_count +
 				                                         (block_number - nr));
 
+				/* extend the request when the client reads sequentially */
+				Genode::size_t ra = _read_ahead(nr + cnt, read_ahead);
+
+				Block::Packet_descriptor buf;
+				try {
+					buf = _blk.dma_alloc_packet(_blk_sz*(cnt + ra));
+				} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
+					if (!ra) throw;
+					ra  = 0;
+					buf = _blk.dma_alloc_packet(_blk_sz*cnt);
+				}
+				cnt += ra;
+
+				/* construct the packet */
+				p_to_dev = Block::Packet_descriptor(buf,
+				                                    Block::Packet_descriptor::READ,
+				                                    nr, cnt);
+
 				/* ensure all memory is available before sending the request */
 				_cache.alloc(cnt * _blk_sz, nr * _blk_sz);
 
-				/* construct and send the packet */
-				p_to_dev =
-					Block::Packet_descriptor(_blk.dma_alloc_packet(_blk_sz*cnt),
-					                         Block::Packet_descriptor::READ,
-					                         nr, cnt);
 				_r_list.insert(new (&_r_slab) Request(p_to_dev, packet, buffer));
 				_blk.tx()->submit_packet(p_to_dev);
 			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
@@ -260,6 +343,35 @@ class Driver : public Block::Driver
 			}
 		}
 
+		/*
+		 * Forward a request without payload to the backend device
+		 *
+		 * \param op      operation, e.g. trim or flush
+		 * \param nr      block number offset
+		 * \param cnt     number of blocks
+		 * \param packet  original packet request received from the client
+		 */
+		void _forward(Block::Packet_descriptor::Opcode op,
+		              Block::sector_t                  nr,
+		              Genode::size_t                   cnt,
+		              Block::Packet_descriptor        &packet)
+		{
+			if (!_ops.supported(op))
+				throw Io_error();
+
+			if (!_blk.tx()->ready_to_submit())
+				throw Request_congestion();
+
+			try {
+				Block::Packet_descriptor p(_blk.dma_alloc_packet(_blk_sz),
+				                           op, nr, cnt);
+				_r_list.insert(new (&_r_slab) Request(p, packet, 0));
+				_blk.tx()->submit_packet(p);
+			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
+				throw Request_congestion();
+			}
+		}
+
 		/*
 		 * Synchronize dirty chunks with backend device
 		 */
@@ -271,6 +383,7 @@ class Driver : public Block::Driver
 			while (len > 0) {
 				try {
 					_cache.sync(len, off);
+					write_back_flush();
 					len = 0;
 				} catch(Write_failed &e) {
 					/**
@@ -290,9 +403,11 @@ class Driver : public Block::Driver
 		 * \param nr   block number offset
 		 * \param cnt  number of blocks
 		 * \param p    client side packet, which triggered this operation
+		 * \param read_ahead  maximum number of cache blocks to read ahead
 		 */
 		bool _stat(Block::sector_t nr, Genode::size_t cnt,
-		           char * const buffer, Block::Packet_descriptor &p)
+		           char * const buffer, Block::Packet_descriptor &p,
+		           unsigned read_ahead = 0)
 		{
 			Cache::offset_t off   = nr  * _blk_sz;
 			Cache::size_t   size  = cnt * _blk_sz;
@@ -304,11 +419,27 @@ class Driver : public Block::Driver
 			} catch(Cache::Chunk_base::Range_incomplete &e) {
 				off  = Genode::max(off, e.off);
 				size = Genode::min(end - off, e.size);
-				_request(off / _blk_sz, size / _blk_sz, buffer, p);
+				_request(off / _blk_sz, size / _blk_sz, buffer, p, read_ahead);
 			}
 			return false;
 		}
 
+		/*
+		 * Read from cache, or request missing chunks from the backend device
+		 */
+		void _read(Block::sector_t           nr,
+		           Genode::size_t            cnt,
+		           char                     *buffer,
+		           Block::Packet_descriptor &p,
+		           unsigned                  read_ahead = 0)
+		{
+			if (!_stat(nr, cnt, buffer, p, read_ahead))
+				return;
+
+			_cache.read(buffer, cnt*_blk_sz, nr*_blk_sz);
+			ack_packet(p);
+		}
+
 		/*
 		 * Signal handler for yield requests of the parent
 		 */
@@ -339,7 +470,10 @@ class Driver : public Block::Driver
 		  _cache(*Genode::env()->heap(), 0),
 		  _source_ack(ep, *this, &Driver::_ack_avail),
 		  _source_submit(ep, *this, &Driver::_ready_to_submit),
-		  _yield(ep, *this, &Driver::_parent_yield)
+		  _yield(ep, *this, &Driver::_parent_yield),
+		  _seq_next(0),
+		  _wb_off(0),
+		  _wb_cnt(0)
 		{
 			_blk.info(&_blk_cnt, &_blk_sz, &_ops);
 			_blk.tx_channel()->sigh_ack_avail(_source_ack);
@@ -372,6 +506,28 @@ class Driver : public Block::Driver
 
 		static Driver* instance() { return _instance; }
 
+		/**
+		 * Free the chunk belonging to a policy element
+		 *
+		 * \return false if the chunk was dirty, then it got synchronized
+		 *         instead and can be freed on the next attempt
+		 */
+		static bool evict(typename POLICY::Element *e)
+		{
+			Chunk_level_4 *cb = static_cast<Chunk_level_4*>(e);
+
+			/* queued write-back data must not refer to freed chunks */
+			_instance->write_back_flush();
+
+			try {
+				cb->free(CACHE_BLK_SIZE, cb->base_offset());
+				return true;
+			} catch(typename Chunk_level_4::Dirty_chunk &d) {
+				cb->sync(d.size, d.off);
+			}
+			return false;
+		}
+
 		static void destroy()
 		{
 			Genode::destroy(Genode::env()->heap(), _instance);
@@ -381,6 +537,56 @@ class Driver : public Block::Driver
 		Block::Session_client* blk()    { return &_blk;   }
 		Genode::size_t         blk_sz() { return _blk_sz; }
 
+		/**
+		 * Queue the content of a dirty chunk for writing to the backend
+		 *
+		 * \param off   device offset of the chunk
+		 * \param data  chunk content, must stay valid until flushed
+		 *
+		 * \throw Write_failed  the pending batch couldn't be submitted
+		 */
+		void write_back(Cache::offset_t off, char const *data)
+		{
+			if (_wb_cnt && (_wb_cnt == WRITE_BACK_MAX ||
+			                off != _wb_off + _wb_cnt * CACHE_BLK_SIZE))
+				write_back_flush();
+
+			if (!_wb_cnt) _wb_off = off;
+			_wb_data[_wb_cnt++] = data;
+		}
+
+		/**
+		 * Submit all queued chunks as one request to the backend device
+		 *
+		 * \throw Write_failed  backend device isn't ready, the queued
+		 *                      chunks are kept for the next attempt
+		 */
+		void write_back_flush()
+		{
+			if (!_wb_cnt) return;
+
+			if (!_blk.tx()->ready_to_submit())
+				throw Write_failed(_wb_off);
+
+			Genode::size_t const size = _wb_cnt * CACHE_BLK_SIZE;
+			try {
+				Block::Packet_descriptor
+					p(_blk.dma_alloc_packet(size),
+					  Block::Packet_descriptor::WRITE,
+					  _wb_off / _blk_sz, size / _blk_sz);
+
+				char *dst = _blk.tx()->packet_content(p);
+				for (unsigned i = 0; i < _wb_cnt; i++)
+					Genode::memcpy(dst + i * CACHE_BLK_SIZE, _wb_data[i],
+					               CACHE_BLK_SIZE);
+
+				_blk.tx()->submit_packet(p);
+			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
+				throw Write_failed(_wb_off);
+			}
+			_wb_cnt = 0;
+		}
+
 
 		/****************************
 		 ** Block-driver interface **
@@ -390,6 +596,15 @@ class Driver : public Block::Driver
 		Block::sector_t block_count()    { return _blk_cnt; }
 		Block::Session::Operations ops() { return _ops;     }
 
+		Block::Session::Transfer_info transfer_info()
+		{
+			/* requests are served in units of cache blocks */
+			Block::Session::Transfer_info info = _blk.transfer_info();
+			info.align_log2 = Genode::max(info.align_log2,
+			                              Genode::log2((unsigned)CACHE_BLK_SIZE));
+			return info;
+		}
+
 		void read(Block::sector_t           block_number,
 		          Genode::size_t            block_count,
 		          char*                     buffer,
@@ -398,11 +613,12 @@ class Driver : public Block::Driver
 			if (!_ops.supported(Block::Packet_descriptor::READ))
 				throw Io_error();
 
-			if (!_stat(block_number, block_count, buffer, packet))
-				return;
+			/* detect streaming access, to issue read-ahead on misses */
+			bool const sequential = (block_number == _seq_next);
+			_seq_next = block_number + block_count;
 
-			_cache.read(buffer, block_count*_blk_sz, block_number*_blk_sz);
-			ack_packet(packet);
+			_read(block_number, block_count, buffer, packet,
+			      sequential ? READ_AHEAD : 0);
 		}
 
 		void write(Block::sector_t           block_number,
@@ -429,5 +645,24 @@ class Driver : public Block::Driver
 			ack_packet(packet);
 		}
 
+		/*
+		 * Cached content of trimmed blocks stays valid, because their
+		 * content is undefined after the trim anyway
+		 */
+		void trim(Block::sector_t           block_number,
+		          Genode::size_t            block_count,
+		          Block::Packet_descriptor &packet)
+		{
+			_forward(Block::Packet_descriptor::TRIM, block_number,
+			         block_count, packet);
+		}
+
+		void flush(Block::Packet_descriptor &packet)
+		{
+			/* write back all dirty chunks before the barrier */
+			_sync();
+			_forward(Block::Packet_descriptor::FLUSH, 0, 0, packet);
+		}
+
 		void sync() { _sync(); }
 };
@@ -16,18 +16,17 @@
 
 typedef Driver<Lru_policy>::Chunk_level_4 Chunk;
 
-static const Lru_policy::Element        *lru = 0;
-static Genode::List<Lru_policy::Element> lru_list;
+/* most recently used element first */
+static Cache::Dlist<Lru_policy::Element> lru_list;
 
 
 static void lru_access(const Lru_policy::Element *e)
 {
-	if (e == lru) return;
+	if (e == lru_list.first()) return;
 
-	if (e->next()) lru_list.remove(e);
+	if (e->list()) lru_list.remove(e);
 
-	lru_list.insert(e, lru);
-	lru = e;
+	lru_list.insert(e);
 }
 
 
@@ -42,21 +41,17 @@ void Lru_policy::write(const Lru_policy::Element *e) {
 void Lru_policy::flush(Cache::size_t size)
 {
 	Cache::size_t s = 0;
-	for (Lru_policy::Element *e = lru_list.first();
+	for (Lru_policy::Element *e = lru_list.last();
 		 e && ((size == 0) || (s < size));
-		 e = lru_list.first(), s += sizeof(Chunk)) {
-		Chunk *cb = static_cast<Chunk*>(e);
-		e = e->next();
-		try {
-			cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE,
-			         cb->base_offset());
-			lru_list.remove(cb);
-		} catch(Chunk::Dirty_chunk &e) {
-			cb->sync(e.size, e.off);
-		}
+		 e = lru_list.last()) {
+
+		/* the element is gone when its chunk gets freed */
+		lru_list.remove(e);
+		if (Driver<Lru_policy>::evict(e))
+			s += sizeof(Chunk);
+		else
+			lru_list.append(e);
 	}
 
-	if (!lru_list.first()) lru = 0;
-
 	if (s < size) throw Block::Driver::Request_congestion();
 }
@@ -11,13 +11,12 @@
  * under the terms of the GNU General Public License version 2.
  */
 
-#include <util/list.h>
-
 #include "chunk.h"
+#include "dlist.h"
 
 struct Lru_policy
 {
-	class Element : public Genode::List<Element>::Element {};
+	class Element : public Cache::Dlist<Element>::Element {};
 
 	static void read(const Element  *e);
 	static void write(const Element *e);
@@ -12,8 +12,11 @@
  */
 
 #include <os/server.h>
+#include <os/config.h>
 
 #include "lru.h"
+#include "clock.h"
+#include "two_queue.h"
 #include "driver.h"
 
 
@@ -22,6 +25,8 @@ template <typename POLICY> Driver<POLICY>* Driver<POLICY>::_instance = 0;
 
 /**
  * Synchronize a chunk with the backend device
+ *
+ * Adjacent chunks are combined, the pending batch is submitted by the driver
  */
 template <typename POLICY>
 void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
@@ -29,18 +34,7 @@ void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
 	Cache::offset_t off =
 		static_cast<const Driver<POLICY>::Chunk_level_4*>(e)->base_offset();
 
-	if (!Driver::instance()->blk()->tx()->ready_to_submit())
-		throw Write_failed(off);
-	try {
-		Block::Packet_descriptor
-			p(Driver::instance()->blk()->dma_alloc_packet(Driver::CACHE_BLK_SIZE),
-		      Block::Packet_descriptor::WRITE,
-		      off / Driver::instance()->blk_sz(),
-		      Driver::CACHE_BLK_SIZE / Driver::instance()->blk_sz());
-		Driver::instance()->blk()->tx()->submit_packet(p);
-	} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-		throw Write_failed(off);
-	}
+	Driver::instance()->write_back(off, dst);
 }
 
 
@@ -52,10 +46,39 @@ struct Main
 	{
 		Server::Entrypoint &ep;
 
-		Factory(Server::Entrypoint &ep) : ep(ep) {}
-
-		Block::Driver *create() { return Driver<Lru_policy>::instance(ep); }
-		void destroy(Block::Driver *driver) { Driver<Lru_policy>::destroy(); }
+		enum Policy { LRU, CLOCK, TWO_QUEUE } policy;
+
+		static Policy _policy_from_config()
+		{
+			try {
+				Genode::Xml_node::Attribute p =
+					Genode::config()->xml_node().attribute("policy");
+				if (p.has_value("clock")) return CLOCK;
+				if (p.has_value("2q"))    return TWO_QUEUE;
+			} catch (...) { }
+			return LRU;
+		}
+
+		Factory(Server::Entrypoint &ep)
+		: ep(ep), policy(_policy_from_config()) {}
+
+		Block::Driver *create()
+		{
+			switch (policy) {
+			case CLOCK:     return Driver<Clock_policy>::instance(ep);
+			case TWO_QUEUE: return Driver<Two_queue_policy>::instance(ep);
+			default:        return Driver<Lru_policy>::instance(ep);
+			}
+		}
+
+		void destroy(Block::Driver *driver)
+		{
+			switch (policy) {
+			case CLOCK:     Driver<Clock_policy>::destroy();     break;
+			case TWO_QUEUE: Driver<Two_queue_policy>::destroy(); break;
+			default:        Driver<Lru_policy>::destroy();       break;
+			}
+		}
 	} factory;
 
 	void resource_handler(unsigned) { }
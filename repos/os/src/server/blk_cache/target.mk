@@ -1,3 +1,3 @@
 TARGET = blk_cache
-LIBS   = base server
-SRC_CC = main.cc lru.cc
+LIBS   = base server config
+SRC_CC = main.cc lru.cc clock.cc two_queue.cc
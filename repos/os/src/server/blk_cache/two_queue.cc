@@ -0,0 +1,89 @@
+/*
+ * \brief  Scan-resistant 2Q cache replacement strategy
+ * \author Stefan Kalkowski
+ * \date   2013-12-05
+ */
+
+/*
+ * Copyright (C) 2013 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+#include <base/printf.h>
+#include "two_queue.h"
+#include "driver.h"
+
+typedef Driver<Two_queue_policy>::Chunk_level_4 Chunk;
+typedef Cache::Dlist<Two_queue_policy::Element> Queue;
+
+enum {
+	/*
+	 * Accesses to a chunk shortly after it entered the FIFO, like the read
+	 * that follows filling the chunk from the backend device, are regarded
+	 * as one reference. This is the number of FIFO insertions after which
+	 * another access promotes the chunk.
+	 */
+	CORRELATED_PERIOD = 256,
+};
+
+static Queue          fifo;   /* chunks referenced once, newest first */
+static Queue          lru;    /* hot chunks, most recently used first */
+static unsigned long  ticks;  /* number of FIFO insertions            */
+
+
+static void two_queue_access(const Two_queue_policy::Element *e)
+{
+	if (e->list() == &lru) {
+		if (e == lru.first()) return;
+		lru.remove(e);
+		lru.insert(e);
+		return;
+	}
+
+	if (e->list() == &fifo) {
+		if (ticks - e->stamp < CORRELATED_PERIOD) return;
+		fifo.remove(e);
+		lru.insert(e);
+		return;
+	}
+
+	e->stamp = ticks++;
+	fifo.insert(e);
+}
+
+
+void Two_queue_policy::read(const Two_queue_policy::Element  *e) {
+	two_queue_access(e); }
+
+
+void Two_queue_policy::write(const Two_queue_policy::Element *e) {
+	two_queue_access(e); }
+
+
+void Two_queue_policy::flush(Cache::size_t size)
+{
+	Cache::size_t s = 0;
+	while ((size == 0) || (s < size)) {
+
+		/*
+		 * Take from the FIFO as long as it holds at least a quarter of all
+		 * chunks, so that newly referenced chunks get a chance to be promoted
+		 */
+		Queue *q = (fifo.count() && (!lru.count() ||
+		            fifo.count() * 4 >= fifo.count() + lru.count()))
+		         ? &fifo : &lru;
+
+		Two_queue_policy::Element *e = q->last();
+		if (!e) break;
+
+		/* the element is gone when its chunk gets freed */
+		q->remove(e);
+		if (Driver<Two_queue_policy>::evict(e))
+			s += sizeof(Chunk);
+		else
+			q->append(e);
+	}
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
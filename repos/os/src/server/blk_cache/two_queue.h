@@ -0,0 +1,37 @@
+/*
+ * \brief  Scan-resistant 2Q cache replacement strategy
+ * \author Stefan Kalkowski
+ * \date   2013-12-05
+ */
+
+/*
+ * Copyright (C) 2013 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include "chunk.h"
+#include "dlist.h"
+
+/**
+ * Chunks enter a FIFO on first access, and are promoted to an LRU list
+ * only when they get accessed again later on. Thereby, a single scan over
+ * the device does not displace the working set held in the LRU list.
+ */
+struct Two_queue_policy
+{
+	class Element : public Cache::Dlist<Element>::Element
+	{
+		public:
+
+			/* value of the insertion counter when entering the FIFO */
+			mutable unsigned long stamp;
+
+			Element() : stamp(0) { }
+	};
+
+	static void read(const Element  *e);
+	static void write(const Element *e);
+	static void flush(Cache::size_t size = 0);
+};
@@ -75,14 +75,14 @@ struct Server::Main : Rom::Module::Read_policy, Rom::Module::Write_policy
 
 	Genode::Sliced_heap _sliced_heap = { Genode::env()->ram_session(),
 	                                     Genode::env()->rm_session() };
-	bool _verbose_config()
+	bool _bool_config(char const *attr)
 	{
-		char const *attr = "verbose";
 		return Genode::config()->xml_node().has_attribute(attr)
 		    && Genode::config()->xml_node().attribute(attr).has_value("yes");
 	}
 
-	bool verbose = _verbose_config();
+	bool verbose  = _bool_config("verbose");
+	bool handover = _bool_config("handover");
 
 	typedef Genode::String<100> Domain;
 
@@ -201,7 +201,7 @@ struct Server::Main : Rom::Module::Read_policy, Rom::Module::Write_policy
 	
 	Rom::Registry _rom_registry { *this, *this };
 
-	Report::Root report_root = { _ep, _sliced_heap, _rom_registry, verbose };
+	Report::Root report_root = { _ep, _sliced_heap, _rom_registry, verbose, handover };
 	Rom   ::Root    rom_root = { _ep, _sliced_heap, _rom_registry };
 
 	Main(Entrypoint &ep) : _ep(ep)
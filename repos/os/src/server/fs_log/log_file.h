@@ -23,10 +23,103 @@ namespace Fs_log {
 	using namespace Genode;
 	using namespace File_system;
 
+	class Packet_writer;
+	struct Flush_scheduler;
 	class Log_file;
 
+	enum {
+		/* size of per-file write buffer, flushed when exceeded */
+		WRITE_BUFFER_SIZE = 4096,
+	};
 }
 
+
+/**
+ * Submitter of write packets, shared by all log files
+ *
+ * The writing is fire-and-forget. Acknowledgements are only collected to
+ * free the space within the packet-stream buffer and the submit queue.
+ */
+class Fs_log::Packet_writer
+{
+	private:
+
+		File_system::Session &_fs;
+
+		unsigned _in_flight = 0;
+
+		File_system::Session::Tx::Source &_source() { return *_fs.tx(); }
+
+		void _release_acked_packet()
+		{
+			_source().release_packet(_source().get_acked_packet());
+			_in_flight--;
+		}
+
+	public:
+
+		Packet_writer(File_system::Session &fs) : _fs(fs) { }
+
+		/**
+		 * Append 'len' bytes at 'src' to the file
+		 */
+		void append(File_handle handle, char const *src, size_t len)
+		{
+			File_system::Session::Tx::Source &source = _source();
+
+			/* collect the acknowledgements arrived in the meanwhile */
+			while (source.ack_avail())
+				_release_acked_packet();
+
+			File_system::Packet_descriptor raw_packet;
+			for (;;) {
+				if (source.ready_to_submit()) {
+					try {
+						raw_packet = source.alloc_packet(len);
+						break;
+					}
+					catch (File_system::Session::Tx::Source::Packet_alloc_failed) { }
+				}
+
+				if (!_in_flight) {
+					PERR("could not allocate packet of %zd bytes", len);
+					return;
+				}
+
+				/* wait until the file system processed a packet */
+				_release_acked_packet();
+			}
+
+			/* the default position refers to the end of the file */
+			File_system::Packet_descriptor
+				packet(raw_packet, handle, File_system::Packet_descriptor::WRITE, len);
+
+			memcpy(source.packet_content(packet), src, len);
+
+			source.submit_packet(packet);
+			_in_flight++;
+		}
+
+		/**
+		 * Wait until all submitted packets are processed
+		 */
+		void drain()
+		{
+			while (_in_flight)
+				_release_acked_packet();
+		}
+};
+
+
+/**
+ * Interface for requesting the deferred flushing of the log files
+ */
+struct Fs_log::Flush_scheduler
+{
+	virtual void schedule_flush() = 0;
+};
+
+
 class Fs_log::Log_file : public List<Log_file>::Element
 {
 	private:
@@ -34,26 +127,44 @@ class Fs_log::Log_file : public List<Log_file>::Element
 		char                  _dir_path[ MAX_PATH_LEN];
 		char                  _file_name[MAX_NAME_LEN];
 		File_system::Session &_fs;
+		Packet_writer        &_writer;
+		Flush_scheduler      &_flush_scheduler;
 		File_handle           _handle;
-		seek_off_t            _offset;
 		int                   _clients;
 
+		/*
+		 * Messages are combined in the write buffer to write them in
+		 * large packets instead of one packet per message.
+		 */
+		char   _buf[WRITE_BUFFER_SIZE];
+		size_t _buf_len = 0;
+
 	public:
 
 		/**
 		 * Constructor
+		 *
+		 * \param handle  file handle, messages are appended to the file
 		 */
-		Log_file(File_system::Session &fs, File_handle handle,
-		         char const *dir_path, char const *file_name,
-		         seek_off_t offset)
+		Log_file(File_system::Session &fs, Packet_writer &writer,
+		         Flush_scheduler &flush_scheduler, File_handle handle,
+		         char const *dir_path, char const *file_name)
 		:
-			_fs(fs), _handle(handle), _offset(offset), _clients(0)
+			_fs(fs), _writer(writer), _flush_scheduler(flush_scheduler),
+			_handle(handle), _clients(0)
 		{
 			strncpy(_dir_path,   dir_path,  sizeof(_dir_path));
 			strncpy(_file_name, file_name, sizeof(_file_name));
 		}
 
-		~Log_file() { _fs.close(_handle); }
+		~Log_file()
+		{
+			/* the file handle must not be closed before the data is written */
+			flush();
+			_writer.drain();
+
+			_fs.close(_handle);
+		}
 
 		bool match(char const *dir, char const *filename) const
 		{
@@ -67,29 +178,36 @@ class Fs_log::Log_file : public List<Log_file>::Element
 		int client_count() const { return _clients; }
 
 		/**
-		 * Write a log message to the packet buffer.
+		 * Pass buffered messages to the file system
+		 */
+		void flush()
+		{
+			if (!_buf_len)
+				return;
+
+			_writer.append(_handle, _buf, _buf_len);
+			_buf_len = 0;
+		}
+
+		/**
+		 * Write a log message to the write buffer
 		 */
 		size_t write(char const *msg, size_t msg_len)
 		{
-			File_system::Session::Tx::Source &source = *_fs.tx();
+			msg_len = min(msg_len, sizeof(_buf));
 
-			File_system::Packet_descriptor raw_packet;
-			if (!source.ready_to_submit())
-				raw_packet = source.get_acked_packet();
-			else
-				raw_packet = source.alloc_packet(Log_session::String::MAX_SIZE);
+			if (_buf_len + msg_len > sizeof(_buf))
+				flush();
 
-			File_system::Packet_descriptor
-				packet(raw_packet,
-				       _handle, File_system::Packet_descriptor::WRITE,
-				       msg_len, _offset);
+			if (!_buf_len)
+				_flush_scheduler.schedule_flush();
 
-			_offset += msg_len;
+			memcpy(_buf + _buf_len, msg, msg_len);
+			_buf_len += msg_len;
 
-			char *buf = source.packet_content(packet);
-			memcpy(buf, msg, msg_len);
+			if (_buf_len == sizeof(_buf))
+				flush();
 
-			source.submit_packet(packet);
 			return msg_len;
 		}
 };
@@ -18,6 +18,8 @@
 #include <root/component.h>
 #include <os/server.h>
 #include <os/session_policy.h>
+#include <os/signal_rpc_dispatcher.h>
+#include <timer_session/connection.h>
 #include <base/printf.h>
 
 /* Local includes */
@@ -33,9 +35,10 @@ namespace Fs_log {
 	struct Main;
 
 	enum {
-		 BLOCK_SIZE = Log_session::String::MAX_SIZE,
-		 QUEUE_SIZE = File_system::Session::TX_QUEUE_SIZE,
-		TX_BUF_SIZE = BLOCK_SIZE * (QUEUE_SIZE*2 + 1)
+		TX_BUF_SIZE    = WRITE_BUFFER_SIZE*8,
+
+		/* maximum delay of buffered messages */
+		FLUSH_DELAY_MS = 250,
 	};
 
 	typedef Genode::Path<File_system::MAX_PATH_LEN> Path;
@@ -43,14 +46,29 @@ namespace Fs_log {
 }
 
 class Fs_log::Root_component :
-	public Genode::Root_component<Fs_log::Session_component>
+	public Genode::Root_component<Fs_log::Session_component>,
+	public Flush_scheduler
 {
 	private:
 
 		Allocator_avl            _write_alloc;
 		File_system::Connection  _fs;
+		Packet_writer            _writer { _fs };
 		List<Log_file>           _log_files;
 
+		Timer::Connection        _timer;
+		bool                     _flush_scheduled = false;
+
+		void _handle_flush_timeout(unsigned)
+		{
+			_flush_scheduled = false;
+
+			for (Log_file *file = _log_files.first(); file; file = file->next())
+				file->flush();
+		}
+
+		Signal_rpc_member<Root_component> _flush_timeout_dispatcher;
+
 		Log_file *lookup(char const *dir, char const *filename)
 		{
 			for (Log_file *file = _log_files.first(); file; file = file->next())
@@ -139,16 +157,14 @@ class Fs_log::Root_component :
 				Dir_handle   dir_handle = ensure_dir(_fs, dir_path);
 				Handle_guard dir_guard(_fs, dir_handle);
 				File_handle  handle;
-				seek_off_t   offset = 0;
 
 				try {
 					handle = _fs.file(dir_handle, file_name,
 					                  File_system::WRITE_ONLY, false);
 
+					/* messages are appended, no need to query the size */
 					if (truncate)
 						_fs.truncate(handle, 0);
-					else
-						offset = _fs.status(handle).size;
 
 				} catch (File_system::Lookup_failed) {
 					PDBG("create");
@@ -157,7 +173,7 @@ class Fs_log::Root_component :
 				}
 
 				file = new (env()->heap())
-					Log_file(_fs, handle, dir_path, file_name, offset);
+					Log_file(_fs, _writer, *this, handle, dir_path, file_name);
 
 				_log_files.insert(file);
 
@@ -208,8 +224,25 @@ class Fs_log::Root_component :
 		:
 			Genode::Root_component<Session_component>(&ep.rpc_ep(), &alloc),
 			_write_alloc(env()->heap()),
-			_fs(_write_alloc, TX_BUF_SIZE)
-		{ }
+			_fs(_write_alloc, TX_BUF_SIZE),
+			_flush_timeout_dispatcher(ep, *this, &Root_component::_handle_flush_timeout)
+		{
+			_timer.sigh(_flush_timeout_dispatcher);
+		}
+
+
+		/*******************************
+		 ** Flush_scheduler interface **
+		 *******************************/
+
+		void schedule_flush() override
+		{
+			if (_flush_scheduled)
+				return;
+
+			_timer.trigger_once(FLUSH_DELAY_MS*1000);
+			_flush_scheduled = true;
+		}
 
 };
 
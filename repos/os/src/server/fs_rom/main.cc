@@ -22,40 +22,79 @@
 #include <base/env.h>
 #include <base/printf.h>
 #include <os/path.h>
+#include <os/config.h>
+#include <timer_session/connection.h>
+#include <util/list.h>
+#include <util/volatile_object.h>
 
 
 using namespace Genode;
 
-/*****************
- ** ROM service **
- *****************/
+/**************************
+ ** Shared file contents **
+ **************************/
 
 /**
- * A 'Rom_session_component' exports a single file of the file system
+ * Snapshot of a file's content
+ *
+ * A version stays alive as long as it is used by any ROM session. Hence,
+ * reloading the file on behalf of one client does not revoke the dataspace
+ * that another client still has attached.
  */
-class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
+struct Rom_version
 {
-	private:
+	Genode::Ram_dataspace_capability const ds;
+
+	unsigned users = 0;
+
+	Rom_version(Genode::Ram_dataspace_capability ds) : ds(ds) { }
+
+	~Rom_version() { Genode::env()->ram_session()->free(ds); }
+};
+
+
+class Rom_file_registry;
 
-		File_system::Session &_fs;
+
+/**
+ * File of the file system shared by all ROM sessions that refer to it
+ */
+class Rom_file : public Genode::List<Rom_file>::Element
+{
+	public:
 
 		enum { PATH_MAX_LEN = 512 };
 		typedef Genode::Path<PATH_MAX_LEN> Path;
 
+		/**
+		 * ROM session to be notified about file changes
+		 */
+		struct Client : Genode::List<Client>::Element
+		{
+			Genode::Signal_context_capability sigh;
+		};
+
+	private:
+
+		friend class Rom_file_registry;
+
+		File_system::Session &_fs;
+		Rom_file_registry    &_registry;
+
 		/**
 		 * Name of requested file, interpreted at path into the file system
 		 */
 		Path const _file_path;
 
 		/**
-		 * Handle of associated file
+		 * Number of ROM sessions referring to the file
 		 */
-		File_system::File_handle _file_handle;
+		unsigned _ref_count = 0;
 
 		/**
-		 * Size of current version of the file
+		 * Handle of associated file
 		 */
-		File_system::file_size_t _file_size = 0;
+		File_system::File_handle _file_handle;
 
 		/**
 		 * Handle of currently watched compound directory
@@ -66,43 +105,34 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 		File_system::Node_handle _compound_dir_handle;
 
 		/**
-		 * Dataspace exposed as ROM module to the client
+		 * Most recent content of the file, referenced by the file itself
 		 */
-		Genode::Ram_dataspace_capability _file_ds;
+		Rom_version *_current = 0;
 
-		/**
-		 * Handler for ROM file changes
+		/*
+		 * The following members are accessed by the RPC entrypoint and by
+		 * the main thread, which handles change signals.
 		 */
-		Genode::Lock                      _sigh_lock;
-		Genode::Signal_context_capability _sigh;
+		Genode::Lock          _lock;
+		Genode::List<Client>  _clients;
+		bool                  _outdated = true;
 
-		/**
-		 * Dispatcher that is called each time when the requested file is not
-		 * yet available and the compound directory changes
-		 *
-		 * The change of the compound directory bears the chance that the
-		 * requested file re-appears. So we inform the client about a ROM
-		 * module change and thereby give it a chance to call 'dataspace()' in
-		 * response.
-		 */
-		Genode::Signal_dispatcher<Rom_session_component> _dir_change_dispatcher;
+		/* state of change debouncing, managed by the registry */
+		bool          _change_pending = false;
+		unsigned long _last_change_ms = 0;
 
 		/**
-		 * Signal-handling function called by the main thread the compound
-		 * directory changed.
+		 * Dispatcher that is called each time the file or, if the file is
+		 * not yet available, its compound directory changes
 		 *
-		 * Note that this function is not executed in the context of the RPC
-		 * entrypoint. Therefore, the access to '_sigh' is synchronized with
-		 * the 'sigh()' function using '_sigh_lock'.
+		 * The change of the compound directory bears the chance that the
+		 * requested file re-appears. So we inform the clients about a ROM
+		 * module change and thereby give them a chance to call
+		 * 'dataspace()' in response.
 		 */
-		void _dir_changed(unsigned)
-		{
-			Genode::Lock::Guard guard(_sigh_lock);
+		Genode::Signal_dispatcher<Rom_file> _change_dispatcher;
 
-			PINF("detected directory change");
-			if (_sigh.valid())
-				Genode::Signal_transmitter(_sigh).submit();
-		}
+		inline void _changed(unsigned);
 
 		/**
 		 * Open compound directory of specified file
@@ -180,40 +210,19 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 
 			/* register for changes in compound directory */
 			if (_compound_dir_handle.valid())
-				_fs.sigh(_compound_dir_handle, _dir_change_dispatcher);
+				_fs.sigh(_compound_dir_handle, _change_dispatcher);
 			else
 				PWRN("could not track compound dir, giving up");
 		}
 
 		/**
-		 * Initialize '_file_ds' dataspace with file content
+		 * Read current file content into a new dataspace
+		 *
+		 * \return new version, or 0 if the file is not available or empty
 		 */
-		void _update_dataspace()
+		Rom_version *_load()
 		{
-			using namespace File_system;
-
-			/*
-			 * On each repeated call of this function, the dataspace is
-			 * replaced with a new one that contains the most current file
-			 * content. The dataspace is re-allocated if the new version
-			 * of the file has become bigger.
-			 */
-			{
-				File_handle const file_handle = _open_file(_fs, _file_path);
-				if (file_handle.valid()) {
-					File_system::file_size_t const new_file_size =
-						_fs.status(file_handle).size;
-
-					if (_file_ds.valid() && (new_file_size > _file_size)) {
-						env()->ram_session()->free(_file_ds);
-
-						/* mark as invalid */
-						_file_ds = Ram_dataspace_capability();
-						_file_size = 0;
-					}
-				}
-				_fs.close(file_handle);
-			}
+			using namespace Genode;
 
 			/* close and then re-open the file */
 			if (_file_handle.valid())
@@ -221,47 +230,54 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 
 			_file_handle = _open_file(_fs, _file_path);
 
+			if (!_file_handle.valid()) {
+				_register_for_compound_dir_changes();
+				return 0;
+			}
+
 			/*
 			 * If we got the file, we can stop paying attention to the
 			 * compound directory.
 			 */
-			if (_file_handle.valid() && _compound_dir_handle.valid())
+			if (_compound_dir_handle.valid()) {
 				_fs.close(_compound_dir_handle);
+				_compound_dir_handle = File_system::Node_handle();
+			}
 
 			/* register for file changes */
-			if (_sigh.valid() && _file_handle.valid())
-				_fs.sigh(_file_handle, _sigh);
-
-			size_t const file_size = _file_handle.valid()
-			                       ? _fs.status(_file_handle).size : 0;
-
-			/* allocate new RAM dataspace according to file size */
-			if (file_size > 0) {
-				try {
-					if (!_file_ds.valid()) {
-						_file_ds = env()->ram_session()->alloc(file_size);
-						_file_size = file_size;
-					}
-				} catch (...) {
-					PERR("couldn't allocate memory for file, empty result\n");
-					_file_ds = Ram_dataspace_capability();
-					return;
-				}
-			}
+			_fs.sigh(_file_handle, _change_dispatcher);
 
-			if (!_file_ds.valid()) {
+			size_t const file_size = _fs.status(_file_handle).size;
+			if (file_size == 0) {
 				_register_for_compound_dir_changes();
-				return;
+				return 0;
 			}
 
-			/* map dataspace locally */
-			void * const dst_addr = env()->rm_session()->attach(_file_ds);
+			Ram_dataspace_capability ds;
+			try { ds = env()->ram_session()->alloc(file_size); }
+			catch (...) {
+				PERR("couldn't allocate memory for file, empty result\n");
+				return 0;
+			}
 
-			/* read content from file */
+			/* map dataspace locally and read content from file */
+			void * const dst_addr = env()->rm_session()->attach(ds);
 			read(_fs, _file_handle, dst_addr, file_size);
-
-			/* unmap dataspace */
 			env()->rm_session()->detach(dst_addr);
+
+			return new (env()->heap()) Rom_version(ds);
+		}
+
+		/**
+		 * Inform all clients about a change of the file
+		 */
+		void _notify_clients()
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			for (Client *c = _clients.first(); c; c = c->next())
+				if (c->sigh.valid())
+					Genode::Signal_transmitter(c->sigh).submit();
 		}
 
 	public:
@@ -270,36 +286,291 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 		 * Constructor
 		 *
 		 * \param fs        file-system session to read the file from
-		 * \param filename  requested file name
-		 * \param sig_rec   signal receiver used to get notified about changes
-		 *                  within the compound directory (in the case when
-		 *                  the requested file could not be found at session-
-		 *                  creation time)
+		 * \param registry  registry that debounces change notifications
+		 * \param path      requested file name
+		 * \param sig_rec   signal receiver used to get notified about
+		 *                  changes of the file or its compound directory
 		 */
-		Rom_session_component(File_system::Session &fs, const char *file_path,
-		                      Genode::Signal_receiver &sig_reg)
+		Rom_file(File_system::Session &fs, Rom_file_registry &registry,
+		         char const *path, Genode::Signal_receiver &sig_rec)
 		:
-			_fs(fs), _file_path(file_path), _file_handle(_open_file(_fs, _file_path)),
-			_dir_change_dispatcher(sig_reg, *this, &Rom_session_component::_dir_changed)
+			_fs(fs), _registry(registry), _file_path(path),
+			_file_handle(_open_file(_fs, _file_path)),
+			_change_dispatcher(sig_rec, *this, &Rom_file::_changed)
 		{
-			if (!_file_handle.valid())
+			if (_file_handle.valid())
+				_fs.sigh(_file_handle, _change_dispatcher);
+			else
 				_register_for_compound_dir_changes();
 		}
 
-		/**
-		 * Destructor
-		 */
-		~Rom_session_component()
+		~Rom_file()
 		{
-			/* close re-open the file */
+			release(_current);
+
 			if (_file_handle.valid())
 				_fs.close(_file_handle);
 
 			if (_compound_dir_handle.valid())
 				_fs.close(_compound_dir_handle);
+		}
+
+		bool has_path(char const *path) const { return _file_path.equals(path); }
+
+		void add(Client &client)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_clients.insert(&client);
+		}
+
+		void remove(Client &client)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_clients.remove(&client);
+		}
 
-			/* close file */
-			Genode::env()->ram_session()->free(_file_ds);
+		void sigh(Client &client, Genode::Signal_context_capability sigh)
+		{
+			Genode::Lock::Guard guard(_lock);
+			client.sigh = sigh;
+		}
+
+		/**
+		 * Return up-to-date content of the file
+		 *
+		 * The file is re-read only if it changed since the last call. The
+		 * returned version must be released by the caller.
+		 *
+		 * \return version, or 0 if the file has no content
+		 */
+		Rom_version *acquire()
+		{
+			bool outdated;
+			{
+				Genode::Lock::Guard guard(_lock);
+				outdated  = _outdated;
+				_outdated = false;
+			}
+
+			if (outdated || !_current) {
+				release(_current);
+				_current = _load();
+				if (_current)
+					_current->users++;
+			}
+
+			if (_current)
+				_current->users++;
+
+			return _current;
+		}
+
+		static void release(Rom_version *version)
+		{
+			if (version && --version->users == 0)
+				Genode::destroy(Genode::env()->heap(), version);
+		}
+};
+
+
+/**
+ * Registry of the files used by ROM sessions
+ *
+ * If configured via the 'debounce_ms' attribute, a file change is reported
+ * to the clients only after the file remained unchanged for the specified
+ * period. A file rewritten in many small steps is thereby reloaded only
+ * once.
+ */
+class Rom_file_registry
+{
+	private:
+
+		File_system::Session    &_fs;
+		Genode::Signal_receiver &_sig_rec;
+
+		Genode::Lock           _lock;
+		Genode::List<Rom_file> _files;
+
+		unsigned long const _debounce_ms;
+
+		Genode::Lazy_volatile_object<Timer::Connection> _timer;
+
+		bool _timer_armed = false;
+
+		Genode::Signal_dispatcher<Rom_file_registry> _timeout_dispatcher;
+
+		static unsigned long _config_debounce_ms()
+		{
+			unsigned long ms = 0;
+			try { Genode::config()->xml_node().attribute("debounce_ms").value(&ms); }
+			catch (...) { }
+			return ms;
+		}
+
+		void _arm_timer(unsigned long ms)
+		{
+			_timer->trigger_once(ms*1000);
+			_timer_armed = true;
+		}
+
+		/**
+		 * Called by the main thread when the debounce period elapsed
+		 */
+		void _timeout(unsigned)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			_timer_armed = false;
+
+			unsigned long const now  = _timer->elapsed_ms();
+			unsigned long       next = 0;
+
+			for (Rom_file *f = _files.first(); f; f = f->next()) {
+
+				bool notify = false;
+				{
+					Genode::Lock::Guard file_guard(f->_lock);
+
+					if (!f->_change_pending)
+						continue;
+
+					unsigned long const quiet = now - f->_last_change_ms;
+
+					if (quiet >= _debounce_ms) {
+						f->_change_pending = false;
+						notify = true;
+					} else if (!next || _debounce_ms - quiet < next) {
+						next = _debounce_ms - quiet;
+					}
+				}
+
+				if (notify)
+					f->_notify_clients();
+			}
+
+			if (next)
+				_arm_timer(next);
+		}
+
+	public:
+
+		Rom_file_registry(File_system::Session &fs, Genode::Signal_receiver &sig_rec)
+		:
+			_fs(fs), _sig_rec(sig_rec), _debounce_ms(_config_debounce_ms()),
+			_timeout_dispatcher(sig_rec, *this, &Rom_file_registry::_timeout)
+		{
+			if (_debounce_ms) {
+				_timer.construct();
+				_timer->sigh(_timeout_dispatcher);
+			}
+		}
+
+		/**
+		 * Return file for 'path', shared with other sessions
+		 */
+		Rom_file &acquire(char const *path)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			Rom_file *file = _files.first();
+			for (; file && !file->has_path(path); file = file->next());
+
+			if (!file) {
+				file = new (Genode::env()->heap())
+				       Rom_file(_fs, *this, path, _sig_rec);
+				_files.insert(file);
+			}
+
+			file->_ref_count++;
+			return *file;
+		}
+
+		void release(Rom_file &file)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			if (--file._ref_count)
+				return;
+
+			_files.remove(&file);
+			Genode::destroy(Genode::env()->heap(), &file);
+		}
+
+		/**
+		 * Called by the main thread when 'file' changed
+		 */
+		void changed(Rom_file &file)
+		{
+			if (!_debounce_ms) {
+				file._notify_clients();
+				return;
+			}
+
+			{
+				Genode::Lock::Guard guard(file._lock);
+				file._change_pending = true;
+				file._last_change_ms = _timer->elapsed_ms();
+			}
+
+			if (!_timer_armed)
+				_arm_timer(_debounce_ms);
+		}
+};
+
+
+void Rom_file::_changed(unsigned)
+{
+	{
+		Genode::Lock::Guard guard(_lock);
+		_outdated = true;
+	}
+	_registry.changed(*this);
+}
+
+
+/*****************
+ ** ROM service **
+ *****************/
+
+/**
+ * A 'Rom_session_component' exports a single file of the file system
+ */
+class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
+{
+	private:
+
+		Rom_file_registry &_registry;
+		Rom_file          &_file;
+		Rom_file::Client   _client;
+
+		/**
+		 * Content handed out to the client
+		 */
+		Rom_version *_version = 0;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param registry   registry of files shared among sessions
+		 * \param file_path  requested file name
+		 */
+		Rom_session_component(Rom_file_registry &registry, const char *file_path)
+		:
+			_registry(registry), _file(registry.acquire(file_path))
+		{
+			_file.add(_client);
+		}
+
+		/**
+		 * Destructor
+		 */
+		~Rom_session_component()
+		{
+			_file.remove(_client);
+			Rom_file::release(_version);
+			_registry.release(_file);
 		}
 
 		/**
@@ -307,17 +578,20 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 		 */
 		Genode::Rom_dataspace_capability dataspace()
 		{
-			_update_dataspace();
-			Genode::Dataspace_capability ds = _file_ds;
+			Rom_version * const version = _file.acquire();
+
+			Rom_file::release(_version);
+			_version = version;
+
+			Genode::Dataspace_capability ds = _version
+			                                ? Genode::Dataspace_capability(_version->ds)
+			                                : Genode::Dataspace_capability();
 			return Genode::static_cap_cast<Genode::Rom_dataspace>(ds);
 		}
 
 		void sigh(Genode::Signal_context_capability sigh)
 		{
-			Genode::Lock::Guard guard(_sigh_lock);
-			_sigh = sigh;
-			if (_file_handle.valid())
-				_fs.sigh(_file_handle, _sigh);
+			_file.sigh(_client, sigh);
 		}
 };
 
@@ -326,8 +600,7 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 {
 	private:
 
-		File_system::Session    &_fs;
-		Genode::Signal_receiver &_sig_rec;
+		Rom_file_registry &_registry;
 
 		Rom_session_component *_create_session(const char *args)
 		{
@@ -340,7 +613,7 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 
 			/* create new session for the requested file */
 			return new (md_alloc())
-				Rom_session_component(_fs, filename, _sig_rec);
+				Rom_session_component(_registry, filename);
 		}
 
 	public:
@@ -350,15 +623,14 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 		 *
 		 * \param  entrypoint  entrypoint to be used for ROM sessions
 		 * \param  md_alloc    meta-data allocator used for ROM sessions
-		 * \param  fs          file-system session
+		 * \param  registry    registry of files shared among sessions
 		 */
 		Rom_root(Genode::Rpc_entrypoint  &entrypoint,
 		         Genode::Allocator       &md_alloc,
-		         File_system::Session    &fs,
-		         Genode::Signal_receiver &sig_rec)
+		         Rom_file_registry       &registry)
 		:
 			Genode::Root_component<Rom_session_component>(&entrypoint, &md_alloc),
-			_fs(fs), _sig_rec(sig_rec)
+			_registry(registry)
 		{ }
 };
 
@@ -381,9 +653,12 @@ int main(void)
 	/* receiver of directory-change signals */
 	static Signal_receiver sig_rec;
 
+	/* files shared by the ROM sessions */
+	static Rom_file_registry registry(fs, sig_rec);
+
 	enum { STACK_SIZE = 8*1024 };
 	static Rpc_entrypoint ep(&cap, STACK_SIZE, "fs_rom_ep");
-	static Rom_root rom_root(ep, sliced_heap, fs, sig_rec);
+	static Rom_root rom_root(ep, sliced_heap, registry);
 
 	/* announce server*/
 	env()->parent()->announce(ep.manage(&rom_root));
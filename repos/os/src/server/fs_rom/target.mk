@@ -1,3 +1,3 @@
 TARGET = fs_rom
 SRC_CC = main.cc
-LIBS   = base
+LIBS   = base config
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -90,8 +90,12 @@ struct Input_merger::Main
 
 			unsigned const num = input_source->session_client.flush();
 			for (unsigned i = 0; i < num; i++)
-				input_session_component.submit(events[i]);
+				input_session_component.submit(events[i], false);
 		}
+
+		/* notify the client once per batch of events */
+		if (!input_session_component.event_queue().empty())
+			input_session_component.event_queue().submit_signal();
 	}
 
 	Signal_rpc_member<Main> input_dispatcher =
@@ -17,7 +17,11 @@
 #include <base/env.h>
 
 /**
- * Fifo-based physical backing-store allocator
+ * Physical backing-store allocator with CLOCK replacement
+ *
+ * Blocks are evicted in the order of their allocation, except for blocks
+ * that were marked as referenced via 'touch' since the last pass of the
+ * clock hand, which get a second chance.
  *
  * \param UMD  user-specific metadata attached to each backing-store block,
  *             for example the corresponding offset within a managed
@@ -67,16 +71,22 @@ class Backing_store
 				 */
 				UMD _user_meta_data;
 
+				/**
+				 * True if the block was accessed since the last pass of
+				 * the clock hand
+				 */
+				bool _referenced;
+
 				/**
 				 * Default constructor used for array allocation
 				 */
-				Block() : _user(0) { }
+				Block() : _user(0), _referenced(false) { }
 
 				/**
 				 * Used by 'Backing_store::assign'
 				 */
 				void assign_user(User *user, UMD user_meta_data) {
-					_user = user, _user_meta_data = user_meta_data; }
+					_user = user, _user_meta_data = user_meta_data, _referenced = false; }
 
 				/**
 				 * Used by 'Backing_store::alloc'
@@ -134,7 +144,7 @@ class Backing_store
 		Block *_blocks;
 
 		/**
-		 * Block index for next allocation (used for fifo)
+		 * Block index for next allocation (clock hand)
 		 */
 		unsigned long _curr_block_idx;
 
@@ -144,7 +154,7 @@ class Backing_store
 		Block *_curr_block() const { return &_blocks[_curr_block_idx]; }
 
 		/**
-		 * Advance fifo allocation index
+		 * Advance clock hand
 		 */
 		void _advance_curr_block()
 		{
@@ -185,9 +195,20 @@ class Backing_store
 		{
 			Genode::Lock::Guard guard(_alloc_lock);
 
-			/* skip blocks that are currently in the process of being assigned */
-			while (_curr_block()->user() == &_not_yet_assigned) {
-				PDBG("skipping not-yet assigned block");
+			/*
+			 * Skip blocks that are currently in the process of being
+			 * assigned and give referenced blocks a second chance
+			 */
+			for (;;) {
+				Block *b = _curr_block();
+
+				if (b->user() == &_not_yet_assigned) {
+					PDBG("skipping not-yet assigned block");
+				} else if (b->_referenced) {
+					b->_referenced = false;
+				} else
+					break;
+
 				_advance_curr_block();
 			}
 
@@ -242,6 +263,11 @@ class Backing_store
 			block->assign_user(user, user_meta_data);
 		}
 
+		/**
+		 * Mark block as recently used, protecting it from the next eviction
+		 */
+		void touch(Block *block) { block->_referenced = true; }
+
 		/**
 		 * Evict all blocks currently in use by the specified user
 		 */
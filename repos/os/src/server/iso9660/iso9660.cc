@@ -34,13 +34,16 @@ namespace Iso {
 		public:
 
 			enum {
-				MAX_SECTORS = 32, /* max. number sectors that can be read in one
-				                     transaction */
+				MAX_SECTORS = 32,         /* max. number sectors that can be read in one
+				                             transaction */
+				READ_AHEAD  = 6,          /* max. number of transactions in flight */
+				TX_BUF_SIZE = 512 * 1024, /* size of block-session buffer */
 			};
 
 			static Block::Connection          *_blk;
 			static Block::Session::Tx::Source *_source;
 			static size_t                      _blk_size;
+			static unsigned                    _depth;
 			static Lock                        _lock;
 
 		private:
@@ -359,6 +362,69 @@ namespace Iso {
 	}
 
 
+	/**
+	 * Read consecutive sectors, keeping several transactions in flight
+	 *
+	 * \param blk_nr  first sector
+	 * \param count   number of sectors
+	 * \param buf     destination buffer
+	 */
+	static void read_sectors(unsigned long blk_nr, unsigned long count, uint8_t *buf)
+	{
+		Lock::Guard lock_guard(Sector::_lock);
+
+		Block::Session::Tx::Source &source = *Sector::_source;
+		float const ratio = (float)Sector::blk_size() / Sector::_blk_size;
+
+		unsigned long next    = blk_nr;   /* next sector to request */
+		unsigned      pending = 0;        /* transactions in flight */
+		bool          success = true;
+
+		while (pending || (success && next < blk_nr + count)) {
+
+			/* read ahead */
+			while (success && next < blk_nr + count && pending < Sector::_depth
+			       && source.ready_to_submit()) {
+
+				unsigned long const n = min<unsigned long>(Sector::MAX_SECTORS,
+				                                           blk_nr + count - next);
+				try {
+					Block::Packet_descriptor p(
+						source.alloc_packet(Sector::blk_size() * n),
+						Block::Packet_descriptor::READ,
+						next * ratio, n * ratio);
+					source.submit_packet(p);
+				} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+					if (pending)
+						break;
+
+					PERR("Packet overrun!");
+					throw Io_error();
+				}
+				next += n;
+				pending++;
+			}
+
+			/* the server may acknowledge out of order */
+			Block::Packet_descriptor p = source.get_acked_packet();
+			pending--;
+
+			if (p.succeeded()) {
+				unsigned long const first = p.block_number() / ratio;
+				memcpy(buf + (first - blk_nr) * Sector::blk_size(),
+				       source.packet_content(p), p.size());
+			} else {
+				PERR("Could not read block %lu", (unsigned long)(p.block_number() / ratio));
+				success = false;
+			}
+			source.release_packet(p);
+		}
+
+		if (!success)
+			throw Io_error();
+	}
+
+
 	unsigned long read_file(File_info *info, off_t file_offset, uint32_t length, void *buf_ptr)
 	{
 		uint8_t *buf = (uint8_t *)buf_ptr;
@@ -367,31 +433,18 @@ namespace Iso {
 
 		unsigned long total_blk_count = ((length + (Sector::blk_size() - 1)) &
 		                                 ~((Sector::blk_size()) - 1)) / Sector::blk_size();
-		unsigned long ret = total_blk_count;
-		unsigned long blk_count;
 		unsigned long blk_nr = info->blk_nr() + (file_offset / Sector::blk_size());
 
 		if (verbose)
 			PDBG("Read blk %lu count %lu, file_offset: %08lx length %u", blk_nr, total_blk_count, file_offset, length);
 
-		while ((blk_count = min<unsigned long>(Sector::MAX_SECTORS, total_blk_count))) {
-			Sector sec(blk_nr, blk_count);
-
-			total_blk_count -= blk_count;
-			blk_nr          += blk_count;
+		read_sectors(blk_nr, total_blk_count, buf);
 
-			unsigned long copy_length = blk_count * Sector::blk_size();
-			memcpy(buf, sec.addr<void *>(), copy_length);
+		/* zero out rest of page */
+		if (total_blk_count % 2)
+			memset(buf + total_blk_count * Sector::blk_size(), 0, Sector::blk_size());
 
-			length -= copy_length;
-			buf    += copy_length;
-
-			/* zero out rest of page */
-			if (!total_blk_count && (blk_count % 2))
-				memset(buf, 0, Sector::blk_size());
-		}
-	
-		return ret * Sector::blk_size();
+		return total_blk_count * Sector::blk_size();
 	}
 
 
@@ -475,6 +528,7 @@ namespace Iso {
 	Block::Connection *Sector::_blk;
 	Block::Session::Tx::Source *Sector::_source;
 	size_t Sector::_blk_size;
+	unsigned Sector::_depth;
 	Lock Sector::_lock;
 
 
@@ -484,7 +538,7 @@ namespace Iso {
 	void __attribute__((constructor)) init()
 	{
 		static Allocator_avl block_alloc(env()->heap());
-		static Block::Connection _blk(&block_alloc);
+		static Block::Connection _blk(&block_alloc, Sector::TX_BUF_SIZE);
 
 		Sector::_blk    = &_blk;
 		Sector::_source  = _blk.tx();
@@ -492,5 +546,10 @@ namespace Iso {
 		Block::sector_t blk_cnt = 0;
 		Block::Session::Operations ops;
 		_blk.info(&blk_cnt, &Sector::_blk_size, &ops);
+
+		/* do not queue more requests than the server handles concurrently */
+		Block::Session::Transfer_info transfer = _blk.transfer_info();
+		Sector::_depth = min<unsigned>(Sector::READ_AHEAD,
+		                               max(2U, transfer.depth()));
 	}
 } /* end of namespace Iso */
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -65,6 +65,12 @@ class Report::Session_component : public Genode::Rpc_object<Session>
 			printf("\nend of report\n");
 		}
 
+		Dataspace_capability submit_handover(size_t const length) override
+		{
+			submit(length);
+			return _ds.cap();
+		}
+
 		void response_sigh(Genode::Signal_context_capability) override { }
 
 		size_t obtain_response() override { return 0; }
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -16,6 +16,7 @@
 #include <os/server.h>
 #include <os/attached_ram_dataspace.h>
 #include <terminal_session/terminal_session.h>
+#include <terminal_session/ring.h>
 #include <log_session/log_session.h>
 
 namespace Terminal {
@@ -95,11 +96,32 @@ class Terminal::Session_component : public Rpc_object<Session, Session_component
 
 		Buffered_output _output;
 
+		/*
+		 * Ring for the write direction
+		 */
+		Attached_ram_dataspace    _ring_ds;
+		Ring                      _ring { _ring_ds.local_addr<void>(), _ring_ds.size() };
+		Signal_context_capability _space_avail_sigh;
+
+		void _handle_write_ring(unsigned)
+		{
+			bool const writer_waiting = _ring.consume([&] (char const *src, size_t n) {
+				return _output.write(src, n); });
+
+			if (writer_waiting && _space_avail_sigh.valid())
+				Signal_transmitter(_space_avail_sigh).submit();
+		}
+
+		Signal_rpc_member<Session_component> _write_ring_dispatcher;
+
 	public:
 
-		Session_component(size_t io_buffer_size)
+		Session_component(Server::Entrypoint &ep, size_t io_buffer_size,
+		                  size_t write_ring_size)
 		:
-			_io_buffer(env()->ram_session(), io_buffer_size)
+			_io_buffer(env()->ram_session(), io_buffer_size),
+			_ring_ds(env()->ram_session(), write_ring_size),
+			_write_ring_dispatcher(ep, *this, &Session_component::_handle_write_ring)
 		{ }
 
 
@@ -127,6 +149,14 @@ class Terminal::Session_component : public Rpc_object<Session, Session_component
 
 		Dataspace_capability _dataspace() { return _io_buffer.cap(); }
 
+		Dataspace_capability _write_ring() { return _ring_ds.cap(); }
+
+		Signal_context_capability _write_ring_sigh(Signal_context_capability sigh)
+		{
+			_space_avail_sigh = sigh;
+			return _write_ring_dispatcher;
+		}
+
 		void read_avail_sigh(Signal_context_capability) { }
 
 		void connected_sigh(Signal_context_capability sigh)
@@ -146,19 +176,26 @@ class Terminal::Session_component : public Rpc_object<Session, Session_component
 
 class Terminal::Root_component : public Genode::Root_component<Session_component>
 {
+	private:
+
+		Server::Entrypoint &_ep;
+
 	protected:
 
 		Session_component *_create_session(const char *args)
 		{
-			size_t const io_buffer_size = 4096;
-			return new (md_alloc()) Session_component(io_buffer_size);
+			size_t const io_buffer_size  = 4096;
+			size_t const write_ring_size = 16*1024;
+			return new (md_alloc())
+				Session_component(_ep, io_buffer_size, write_ring_size);
 		}
 
 	public:
 
 		Root_component(Server::Entrypoint &ep, Genode::Allocator  &md_alloc)
 		:
-			Genode::Root_component<Session_component>(&ep.rpc_ep(), &md_alloc)
+			Genode::Root_component<Session_component>(&ep.rpc_ep(), &md_alloc),
+			_ep(ep)
 		{ }
 };
 
@@ -117,6 +117,30 @@ class File_system::File : public Node
 			return ret == -1 ? 0 : ret;
 		}
 
+		/**
+		 * Read adjacent file range into several buffers at once
+		 *
+		 * \return number of bytes read
+		 */
+		size_t read(struct iovec const *iov, int iovcnt, seek_off_t seek_offset)
+		{
+			ssize_t ret = preadv(_fd, iov, iovcnt, seek_offset);
+
+			return ret == -1 ? 0 : ret;
+		}
+
+		/**
+		 * Write several buffers to an adjacent file range at once
+		 *
+		 * \return number of bytes written
+		 */
+		size_t write(struct iovec const *iov, int iovcnt, seek_off_t seek_offset)
+		{
+			ssize_t ret = pwritev(_fd, iov, iovcnt, seek_offset);
+
+			return ret == -1 ? 0 : ret;
+		}
+
 		file_size_t length() const
 		{
 			struct stat s;
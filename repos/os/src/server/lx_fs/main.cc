@@ -19,6 +19,8 @@
 #include <os/config.h>
 #include <os/server.h>
 #include <os/session_policy.h>
+#include <base/signal.h>
+#include <base/thread.h>
 #include <util/xml_node.h>
 
 /* local includes */
@@ -34,15 +36,74 @@ namespace File_system {
 
 class File_system::Session_component : public Session_rpc_object
 {
+	public:
+
+		enum { PACKET_STACK_SIZE = 2048*sizeof(long) };
+
 	private:
 
-		Server::Entrypoint   &_ep;
+		/*
+		 * Maximum number of packets that are fetched from the submit queue
+		 * at once and merged into a single host system call
+		 */
+		enum { BATCH_SIZE = 16 };
+
+		/**
+		 * Thread that processes the packet stream of the session
+		 *
+		 * The RPC functions of all sessions are served by the entrypoint
+		 * of the server. Read and write operations, however, are executed
+		 * by a thread per session such that blocking host I/O of one
+		 * client does not stall the other clients.
+		 */
+		struct Packet_thread : Thread<PACKET_STACK_SIZE>
+		{
+			Session_component &session;
+
+			Signal_receiver sig_rec;
+			Signal_context  packet_ctx;
+			Signal_context  exit_ctx;
+
+			Signal_context_capability const packet_cap = sig_rec.manage(&packet_ctx);
+			Signal_context_capability const exit_cap   = sig_rec.manage(&exit_ctx);
+
+			Packet_thread(Session_component &session)
+			: Thread<PACKET_STACK_SIZE>("lx_fs_packet"), session(session) { }
+
+			~Packet_thread()
+			{
+				sig_rec.dissolve(&packet_ctx);
+				sig_rec.dissolve(&exit_ctx);
+			}
+
+			void entry()
+			{
+				for (;;) {
+					Signal signal = sig_rec.wait_for_signal();
+
+					if (signal.context() == &exit_ctx)
+						return;
+
+					session._process_packets(signal.num());
+				}
+			}
+
+			/**
+			 * Terminate thread after completing the current batch
+			 */
+			void stop()
+			{
+				Signal_transmitter(exit_cap).submit();
+				join();
+			}
+		};
+
 		Allocator            &_md_alloc;
 		Directory            &_root;
 		Node_handle_registry  _handle_registry;
 		bool                  _writable;
 
-		Signal_rpc_member<Session_component> _process_packet_dispatcher;
+		Packet_thread _packet_thread;
 
 
 		/******************************
@@ -83,53 +144,131 @@ class File_system::Session_component : public Session_rpc_object
 			packet.succeeded(res_length > 0);
 		}
 
-		void _process_packet()
+		bool _valid(Packet_descriptor const &packet)
+		{
+			return tx_sink()->packet_content(packet)
+			    && packet.length() <= packet.size();
+		}
+
+		/**
+		 * Return number of leading packets that access adjacent ranges of
+		 * the same node in the same direction
+		 */
+		unsigned _run_length(Packet_descriptor const *packets, unsigned num)
+		{
+			if (!_valid(packets[0]))
+				return 1;
+
+			unsigned run = 1;
+			for (; run < num; run++) {
+
+				Packet_descriptor const &prev = packets[run - 1];
+				Packet_descriptor const &curr = packets[run];
+
+				if (curr.handle().value != prev.handle().value
+				 || curr.operation()    != prev.operation()
+				 || prev.position()     == ~0ULL
+				 || curr.position()     != prev.position() + prev.length()
+				 || !_valid(curr))
+					break;
+			}
+			return run;
+		}
+
+		/**
+		 * Perform run of packets with a single host system call
+		 */
+		void _process_run_op(Packet_descriptor *packets, unsigned num, File &file)
 		{
-			Packet_descriptor packet = tx_sink()->get_packet();
+			struct iovec iov[BATCH_SIZE];
+			for (unsigned i = 0; i < num; i++) {
+				iov[i].iov_base = tx_sink()->packet_content(packets[i]);
+				iov[i].iov_len  = packets[i].length();
+			}
+
+			seek_off_t const offset = packets[0].position();
+
+			size_t res_length = 0;
+
+			switch (packets[0].operation()) {
+
+			case Packet_descriptor::READ:
+				res_length = file.read(iov, num, offset);
+				break;
+
+			case Packet_descriptor::WRITE:
+				res_length = file.write(iov, num, offset);
+				break;
+			}
+
+			/* distribute result among the packets */
+			for (unsigned i = 0; i < num; i++) {
+				size_t const length = min(res_length, packets[i].length());
+				res_length -= length;
 
+				packets[i].length(length);
+				packets[i].succeeded(length > 0);
+			}
+		}
+
+		void _process_run(Packet_descriptor *packets, unsigned num)
+		{
 			/* assume failure by default */
-			packet.succeeded(false);
+			for (unsigned i = 0; i < num; i++)
+				packets[i].succeeded(false);
 
 			try {
-				Node *node = _handle_registry.lookup_and_lock(packet.handle());
+				Node *node = _handle_registry.lookup_and_lock(packets[0].handle());
 				Node_lock_guard guard(node);
 
-				_process_packet_op(packet, *node);
+				File *file = dynamic_cast<File *>(node);
+				if (file && num > 1) {
+					_process_run_op(packets, num, *file);
+					return;
+				}
+
+				for (unsigned i = 0; i < num; i++)
+					_process_packet_op(packets[i], *node);
 			}
 			catch (Invalid_handle)     { PERR("Invalid_handle");     }
 			catch (Size_limit_reached) { PERR("Size_limit_reached"); }
-
-			/*
-			 * The 'acknowledge_packet' function cannot block because we
-			 * checked for 'ready_to_ack' in '_process_packets'.
-			 */
-			tx_sink()->acknowledge_packet(packet);
 		}
 
 		/**
-		 * Called by signal dispatcher, executed in the context of the main
-		 * thread (not serialized with the RPC functions)
+		 * Called by the packet thread of the session (not serialized
+		 * with the RPC functions)
 		 */
 		void _process_packets(unsigned)
 		{
+			Packet_descriptor packets[BATCH_SIZE];
+
 			while (tx_sink()->packet_avail()) {
 
 				/*
-				 * Make sure that the '_process_packet' function does not
+				 * Make sure that the acknowledgement of the batch does not
 				 * block.
 				 *
 				 * If the acknowledgement queue is full, we defer packet
 				 * processing until the client processed pending
 				 * acknowledgements and thereby emitted a ready-to-ack
-				 * signal. Otherwise, the call of 'acknowledge_packet()'
-				 * in '_process_packet' would infinitely block the context
-				 * of the main thread. The main thread is however needed
-				 * for receiving any subsequent 'ready-to-ack' signals.
+				 * signal. Otherwise, the call of 'acknowledge_packets()'
+				 * would infinitely block the packet thread. The packet
+				 * thread is however needed for receiving any subsequent
+				 * 'ready-to-ack' signals.
 				 */
-				if (!tx_sink()->ready_to_ack())
+				unsigned const slots = min(tx_sink()->ack_slots_free(),
+				                           (unsigned)BATCH_SIZE);
+				if (!slots)
 					return;
 
-				_process_packet();
+				unsigned const num = tx_sink()->get_packets(packets, slots);
+
+				for (unsigned i = 0, run = 0; i < num; i += run) {
+					run = _run_length(packets + i, num - i);
+					_process_run(packets + i, run);
+				}
+
+				tx_sink()->acknowledge_packets(packets, num);
 			}
 		}
 
@@ -156,18 +295,19 @@ class File_system::Session_component : public Session_rpc_object
 		                  Allocator          &md_alloc)
 		:
 			Session_rpc_object(env()->ram_session()->alloc(tx_buf_size), ep.rpc_ep()),
-			_ep(ep),
 			_md_alloc(md_alloc),
 			_root(*new (&_md_alloc) Directory(_md_alloc, root_dir, false)),
 			_writable(writable),
-			_process_packet_dispatcher(ep, *this, &Session_component::_process_packets)
+			_packet_thread(*this)
 		{
 			/*
-			 * Register '_process_packets' dispatch function as signal
-			 * handler for packet-avail and ready-to-ack signals.
+			 * Let the packet thread respond to packet-avail and
+			 * ready-to-ack signals.
 			 */
-			_tx.sigh_packet_avail(_process_packet_dispatcher);
-			_tx.sigh_ready_to_ack(_process_packet_dispatcher);
+			_tx.sigh_packet_avail(_packet_thread.packet_cap);
+			_tx.sigh_ready_to_ack(_packet_thread.packet_cap);
+
+			_packet_thread.start();
 		}
 
 		/**
@@ -175,6 +315,8 @@ class File_system::Session_component : public Session_rpc_object
 		 */
 		~Session_component()
 		{
+			_packet_thread.stop();
+
 			Dataspace_capability ds = tx_sink()->dataspace();
 			env()->ram_session()->free(static_cap_cast<Ram_dataspace>(ds));
 			destroy(&_md_alloc, &_root);
@@ -394,7 +536,9 @@ class File_system::Root : public Root_component<Session_component>
 			 * Check if donated ram quota suffices for session data,
 			 * and communication buffer.
 			 */
-			size_t session_size = sizeof(Session_component) + tx_buf_size;
+			size_t session_size = sizeof(Session_component)
+			                    + Session_component::PACKET_STACK_SIZE
+			                    + tx_buf_size;
 			if (max((size_t)4096, session_size) > ram_quota) {
 				PERR("insufficient 'ram_quota', got %zd, need %zd",
 				     ram_quota, session_size);
@@ -91,6 +91,36 @@ static void for_each_index(int max_index, FUNC const &func) {
 	for (int i = 0; i < max_index; i++) func(i); }
 
 
+/**
+ * Vector of samples processed at once by the mixer
+ *
+ * The sample buffer of a packet is merely aligned to the sample size. Hence,
+ * the alignment of the vector type is reduced accordingly, which lets the
+ * compiler use unaligned loads and stores.
+ */
+typedef float Sample_vector __attribute__((vector_size(16), aligned(sizeof(float))));
+
+enum { SAMPLE_VECTOR_LEN = sizeof(Sample_vector) / sizeof(float) };
+
+static_assert(Audio_out::PERIOD % SAMPLE_VECTOR_LEN == 0,
+              "period must be a multiple of the sample-vector length");
+
+
+static inline Sample_vector splat(float const v) { return Sample_vector { v, v, v, v }; }
+
+
+/**
+ * Clip samples at [1.0,-1.0]
+ */
+static inline Sample_vector clip(Sample_vector v)
+{
+	Sample_vector const max = splat(1), min = splat(-1);
+
+	v = v > max ? max : v;
+	return v < min ? min : v;
+}
+
+
 namespace Audio_out
 {
 	class Session_elem;
@@ -290,29 +320,25 @@ class Audio_out::Mixer
 		/*
 		 * Mix input packet into output packet
 		 *
-		 * Packets are mixed in a linear way with min/max clipping.
+		 * Packets are mixed in a linear way with min/max clipping. The
+		 * samples are processed as vectors, which the compiler maps to SSE
+		 * or NEON instructions where available.
 		 */
 		void _mix_packet(Packet *out, Packet *in, bool clear,
 		                 float const out_vol, float const vol)
 		{
-			if (clear) {
-				for_each_index(Audio_out::PERIOD, [&] (int const i) {
-					out->content()[i]  = (in->content()[i] * vol);
+			Sample_vector       * const out_v = (Sample_vector *)out->content();
+			Sample_vector const * const in_v  = (Sample_vector const *)in->content();
 
-					if (out->content()[i] > 1) out->content()[i] = 1;
-					if (out->content()[i] < -1) out->content()[i] = -1;
+			Sample_vector const vol_v     = splat(vol);
+			Sample_vector const out_vol_v = splat(out_vol);
 
-					out->content()[i] *= out_vol;
-				});
+			if (clear) {
+				for_each_index(Audio_out::PERIOD / SAMPLE_VECTOR_LEN, [&] (int const i) {
+					out_v[i] = clip(in_v[i] * vol_v) * out_vol_v; });
 			} else {
-				for_each_index(Audio_out::PERIOD, [&] (int const i) {
-					out->content()[i] += (in->content()[i] * vol);
-
-					if (out->content()[i] > 1) out->content()[i] = 1;
-					if (out->content()[i] < -1) out->content()[i] = -1;
-
-					out->content()[i] *= out_vol;
-				});
+				for_each_index(Audio_out::PERIOD / SAMPLE_VECTOR_LEN, [&] (int const i) {
+					out_v[i] = clip(out_v[i] + in_v[i] * vol_v) * out_vol_v; });
 			}
 
 			/* mark the packet as processed by invalidating it */
@@ -15,7 +15,6 @@
 #define _ADDRESS_NODE_H_
 
 /* Genode */
-#include <util/avl_tree.h>
 #include <util/list.h>
 #include <nic_session/nic_session.h>
 #include <net/netaddress.h>
@@ -30,12 +29,11 @@ namespace Net {
 
 	/**
 	 * An Address_node encapsulates a session-component and can be hold in
-	 * a list and/or avl-tree, whereby the network-address (MAC or IP)
-	 * acts as a key.
+	 * a list and/or an address table, whereby the network-address (MAC or
+	 * IP) acts as a key.
 	 */
 	template <unsigned LEN>
-	class Address_node : public Genode::Avl_node<Address_node<LEN> >,
-	                     public Genode::List<Address_node<LEN> >::Element
+	class Address_node : public Genode::List<Address_node<LEN> >::Element
 	{
 		public:
 
@@ -51,7 +49,7 @@ namespace Net {
 			/**
 			 * Constructor
 			 *
-			 * \param addr  Network address acting as sorting criteria.
+			 * \param addr  Network address acting as lookup key.
 			 * \param component  pointer to client's session component.
 			 */
 			Address_node(Address addr, Session_component *component)
@@ -62,37 +60,11 @@ namespace Net {
 			 ** Accessors **
 			 ***************/
 
-			Address            addr()      { return _addr;      }
-			Session_component *component() { return _component; }
+			Address            addr() const { return _addr;      }
 
-
-			/************************
-			 ** Avl node interface **
-			 ************************/
-
-			bool higher(Address_node *c)
-			{
-				using namespace Genode;
-
-				return (memcmp(&c->_addr.addr, &_addr.addr,
-				               sizeof(_addr.addr)) > 0);
-			}
-
-			/**
-			 * Find by address
-			 */
-			Address_node *find_by_address(Address addr)
-			{
-				using namespace Genode;
-
-				if (addr == _addr)
-					return this;
-
-				bool side = memcmp(&addr.addr, _addr.addr,
-				                   sizeof(_addr.addr)) > 0;
-				Address_node *c = Avl_node<Address_node>::child(side);
-				return c ? c->find_by_address(addr) : 0;
-			}
+			/* key used by 'Address_table' */
+			Address            key()  const { return _addr;      }
+			Session_component *component()  { return _component; }
 	};
 
 
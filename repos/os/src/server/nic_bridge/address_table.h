@@ -0,0 +1,124 @@
+/*
+ * \brief  Hash table of address nodes
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _ADDRESS_TABLE_H_
+#define _ADDRESS_TABLE_H_
+
+/* Genode */
+#include <util/hash_table.h>
+
+namespace Net {
+
+	template <typename NODE> class Address_table;
+	template <typename NODE> class Flow_cache;
+}
+
+
+/**
+ * Hash table of address nodes, keyed by their address
+ *
+ * The table is solely accessed by the entrypoint of the NIC bridge. Hence,
+ * lookups and updates need no locking. Updates happen on session creation
+ * and destruction, and when learning IP addresses from DHCP replies.
+ */
+template <typename NODE>
+class Net::Address_table
+{
+	public:
+
+		typedef typename NODE::Address Address;
+
+	private:
+
+		struct Hash
+		{
+			static Genode::uint32_t value(Address const &addr) {
+				return Genode::hash_bytes(addr.addr, sizeof(addr.addr)); }
+		};
+
+		Genode::Hash_table<Address, NODE, Hash> _table;
+
+		unsigned _generation = 0;
+
+	public:
+
+		Address_table(Genode::Allocator &alloc) : _table(alloc) { }
+
+		/**
+		 * Look up node by address
+		 *
+		 * \return  node, or 0 if no node with the address exists
+		 */
+		NODE *find(Address addr) const { return _table.find(addr); }
+
+		void insert(NODE *node)
+		{
+			_table.insert(*node);
+			_generation++;
+		}
+
+		void remove(NODE *node)
+		{
+			if (_table.remove(*node))
+				_generation++;
+		}
+
+		/**
+		 * Return counter that is incremented on each update
+		 *
+		 * Used by 'Flow_cache' to detect stale entries.
+		 */
+		unsigned generation() const { return _generation; }
+};
+
+
+/**
+ * Cache of the most recent address lookup
+ *
+ * Consecutive frames of a session are mostly addressed to the same
+ * destination. The cache short-circuits the table lookup in this case.
+ */
+template <typename NODE>
+class Net::Flow_cache
+{
+	private:
+
+		typedef typename NODE::Address Address;
+
+		Address  _addr;
+		NODE    *_node  = 0;
+		bool     _valid = false;
+		unsigned _generation = 0;
+
+	public:
+
+		/**
+		 * Look up node by address, consulting the cache first
+		 *
+		 * Failed lookups are cached as well because frames addressed to
+		 * hosts outside of the bridge are the common case.
+		 */
+		NODE *find(Address_table<NODE> const &table, Address addr)
+		{
+			if (_valid && _generation == table.generation() && _addr == addr)
+				return _node;
+
+			_node       = table.find(addr);
+			_valid      = true;
+			_addr       = addr;
+			_generation = table.generation();
+			return _node;
+		}
+};
+
+#endif /* _ADDRESS_TABLE_H_ */
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2010-2013 Genode Labs GmbH
+ * Copyright (C) 2010-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -26,6 +26,7 @@
 #include <os/session_policy.h>
 
 #include <address_node.h>
+#include <address_table.h>
 #include <mac.h>
 #include <nic.h>
 #include <packet_handler.h>
@@ -105,6 +106,7 @@ namespace Net {
 
 			Mac_address_node                  _mac_node;
 			Ipv4_address_node                *_ipv4_node;
+			Flow_cache<Mac_address_node>      _dst_cache;
 			Net::Nic                         &_nic;
 			Genode::Signal_context_capability _link_state_sigh;
 
@@ -158,6 +160,13 @@ namespace Net {
 			void link_state_sigh(Genode::Signal_context_capability sigh) {
 				_link_state_sigh = sigh; }
 
+			/*
+			 * Packets are copied between the sessions of the bridge
+			 * without their checksum status. Hence, the checksums are
+			 * neither computed nor verified on behalf of the client.
+			 */
+			::Nic::Offload offload() { return ::Nic::Offload(); }
+
 			/******************************
 			 ** Packet_handler interface **
 			 ******************************/
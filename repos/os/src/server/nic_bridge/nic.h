@@ -17,6 +17,7 @@
 #include <nic_session/connection.h>
 #include <nic/packet_allocator.h>
 
+#include <address_table.h>
 #include <packet_handler.h>
 
 namespace Net { class Nic; }
@@ -31,9 +32,10 @@ class Net::Nic : public Net::Packet_handler
 			BUF_SIZE    = ::Nic::Session::QUEUE_SIZE * PACKET_SIZE,
 		};
 
-		::Nic::Packet_allocator     _tx_block_alloc;
-		::Nic::Connection           _nic;
-		Ethernet_frame::Mac_address _mac;
+		::Nic::Packet_allocator       _tx_block_alloc;
+		::Nic::Connection             _nic;
+		Ethernet_frame::Mac_address   _mac;
+		Flow_cache<Ipv4_address_node> _dst_cache;
 
 	public:
 
@@ -27,28 +27,46 @@ static const bool verbose = true;
 
 void Packet_handler::_ready_to_submit(unsigned)
 {
+	Packet_descriptor packets[BATCH_SIZE];
+
 	/* as long as packets are available, and we can ack them */
 	while (sink()->packet_avail()) {
-		_packet = sink()->get_packet();
-		if (!_packet.valid()) continue;
-		handle_ethernet(sink()->packet_content(_packet), _packet.size());
 
-		if (!sink()->ready_to_ack()) {
+		unsigned const slots = Genode::min(sink()->ack_slots_free(),
+		                                   (unsigned)BATCH_SIZE);
+		if (!slots) {
 			if (verbose)
 				PWRN("ack state FULL");
 			return;
 		}
 
-		sink()->acknowledge_packet(_packet);
+		unsigned const received = sink()->get_packets(packets, slots);
+
+		/* handle valid packets, acknowledge them at once */
+		unsigned cnt = 0;
+		for (unsigned i = 0; i < received; i++) {
+			if (!packets[i].valid()) continue;
+
+			handle_ethernet(sink()->packet_content(packets[i]),
+			                packets[i].size());
+			packets[cnt++] = packets[i];
+		}
+
+		sink()->acknowledge_packets(packets, cnt);
 	}
 }
 
 
 void Packet_handler::_ready_to_ack(unsigned)
 {
+	Packet_descriptor packets[BATCH_SIZE];
+
 	/* check for acknowledgements */
-	while (source()->ack_avail())
-		source()->release_packet(source()->get_acked_packet());
+	while (source()->ack_avail()) {
+		unsigned const cnt = source()->get_acked_packets(packets, BATCH_SIZE);
+		for (unsigned i = 0; i < cnt; i++)
+			source()->release_packet(packets[i]);
+	}
 }
 
 
@@ -127,9 +145,9 @@ void Packet_handler::send(Ethernet_frame *eth, Genode::size_t size)
 
 Packet_handler::Packet_handler(Server::Entrypoint &ep, Vlan &vlan)
 : _vlan(vlan),
-  _sink_ack(ep, *this, &Packet_handler::_ack_avail),
-  _sink_submit(ep, *this, &Packet_handler::_ready_to_submit),
-  _source_ack(ep, *this, &Packet_handler::_ready_to_ack),
-  _source_submit(ep, *this, &Packet_handler::_packet_avail),
+  _sink_ack(ep, *this, &Packet_handler::_ack_avail, DATA_PATH_PRIORITY),
+  _sink_submit(ep, *this, &Packet_handler::_ready_to_submit, DATA_PATH_PRIORITY),
+  _source_ack(ep, *this, &Packet_handler::_ready_to_ack, DATA_PATH_PRIORITY),
+  _source_submit(ep, *this, &Packet_handler::_packet_avail, DATA_PATH_PRIORITY),
   _client_link_state(ep, *this, &Packet_handler::_link_state)
 { }
@@ -40,8 +40,16 @@ class Net::Packet_handler
 {
 	private:
 
-		Packet_descriptor _packet;
-		Net::Vlan        &_vlan;
+		/*
+		 * Maximum number of packets taken from a packet-stream queue
+		 * at once
+		 *
+		 * Packets are received and acknowledged in batches to reduce the
+		 * number of queue-lock operations and signals per packet.
+		 */
+		enum { BATCH_SIZE = 32 };
+
+		Net::Vlan &_vlan;
 
 		/**
 		 * submit queue not empty anymore
@@ -76,6 +84,9 @@ class Net::Packet_handler
 
 	protected:
 
+		/* handle packets before link-state changes */
+		enum { DATA_PATH_PRIORITY = 1 };
+
 		Genode::Signal_rpc_member<Packet_handler> _sink_ack;
 		Genode::Signal_rpc_member<Packet_handler> _sink_submit;
 		Genode::Signal_rpc_member<Packet_handler> _source_ack;
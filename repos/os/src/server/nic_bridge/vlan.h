@@ -16,8 +16,10 @@
 #ifndef _VLAN_H_
 #define _VLAN_H_
 
+#include <base/env.h>
+
 #include <address_node.h>
-#include <avl_safe.h>
+#include <address_table.h>
 #include <list_safe.h>
 
 namespace Net {
@@ -30,23 +32,23 @@ namespace Net {
 	{
 		public:
 
-			typedef Avl_tree_safe<Mac_address_node>  Mac_address_tree;
-			typedef Avl_tree_safe<Ipv4_address_node> Ipv4_address_tree;
+			typedef Address_table<Mac_address_node>  Mac_address_table;
+			typedef Address_table<Ipv4_address_node> Ipv4_address_table;
 			typedef List_safe<Mac_address_node>      Mac_address_list;
 
 		private:
 
-			Mac_address_tree  _mac_tree;
-			Mac_address_list  _mac_list;
-			Ipv4_address_tree _ip_tree;
+			Mac_address_table  _mac_table { *Genode::env()->heap() };
+			Mac_address_list   _mac_list;
+			Ipv4_address_table _ip_table  { *Genode::env()->heap() };
 
 		public:
 
 			Vlan() {}
 
-			Mac_address_tree  *mac_tree() { return &_mac_tree; }
-			Mac_address_list  *mac_list() { return &_mac_list; }
-			Ipv4_address_tree *ip_tree()  { return &_ip_tree;  }
+			Mac_address_table  *mac_table() { return &_mac_table; }
+			Mac_address_list   *mac_list()  { return &_mac_list;  }
+			Ipv4_address_table *ip_table()  { return &_ip_table;  }
 	};
 }
 
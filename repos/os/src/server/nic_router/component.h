@@ -0,0 +1,312 @@
+/*
+ * \brief  NIC session of a client of the router
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _SRC__SERVER__NIC_ROUTER__COMPONENT_H_
+#define _SRC__SERVER__NIC_ROUTER__COMPONENT_H_
+
+/* Genode includes */
+#include <base/allocator_guard.h>
+#include <os/attached_ram_dataspace.h>
+#include <root/component.h>
+#include <util/arg_string.h>
+#include <nic/packet_allocator.h>
+#include <nic_session/rpc_object.h>
+#include <os/session_policy.h>
+
+/* local includes */
+#include <interface.h>
+#include <uplink.h>
+
+namespace Net {
+
+	class Mac_pool;
+	class Guarded_range_allocator;
+	class Communication_buffers;
+	class Session_component;
+	class Root;
+}
+
+
+/**
+ * Pool of the MAC addresses assigned to the clients
+ */
+class Net::Mac_pool
+{
+	public:
+
+		typedef Ethernet_frame::Mac_address Mac_address;
+
+		class Alloc_failed : Genode::Exception { };
+
+	private:
+
+		enum { MAX_MACS = 0xff };
+
+		bool _used[MAX_MACS];
+
+		/*
+		 * We take the range 02:02:02:02:03:XX, which does not overlap with
+		 * the addresses handed out by the NIC bridge.
+		 */
+		static Mac_address _base()
+		{
+			Mac_address mac(0x02);
+			mac.addr[4] = 0x03;
+			return mac;
+		}
+
+	public:
+
+		Mac_pool() { Genode::memset(_used, 0, sizeof(_used)); }
+
+		/**
+		 * \throw Alloc_failed
+		 */
+		Mac_address alloc()
+		{
+			for (unsigned i = 0; i < MAX_MACS; i++)
+				if (!_used[i]) {
+					_used[i] = true;
+					Mac_address mac = _base();
+					mac.addr[5] = i;
+					return mac;
+				}
+
+			throw Alloc_failed();
+		}
+
+		void free(Mac_address mac) { _used[mac.addr[5]] = false; }
+};
+
+
+class Net::Guarded_range_allocator
+{
+	protected:
+
+		Genode::Allocator_guard _guarded_alloc;
+		::Nic::Packet_allocator _range_alloc;
+
+		Guarded_range_allocator(Genode::Allocator &backing_store,
+		                        Genode::size_t     amount)
+		: _guarded_alloc(&backing_store, amount),
+		  _range_alloc(&_guarded_alloc) { }
+};
+
+
+class Net::Communication_buffers
+{
+	protected:
+
+		Genode::Attached_ram_dataspace _tx_ds, _rx_ds;
+
+		Communication_buffers(Genode::size_t tx_size, Genode::size_t rx_size)
+		:
+			_tx_ds(Genode::env()->ram_session(), tx_size),
+			_rx_ds(Genode::env()->ram_session(), rx_size)
+		{ }
+};
+
+
+/**
+ * NIC session of a client
+ *
+ * Each client is attached to a network of its own, which contains the
+ * router and the client with the address defined by the session policy.
+ * The base classes are used to construct the packet buffers before the
+ * 'Session_rpc_object'.
+ */
+class Net::Session_component : private Guarded_range_allocator,
+                               private Communication_buffers,
+                               public  ::Nic::Session_rpc_object,
+                               public  Interface
+{
+	private:
+
+		Mac_pool          &_mac_pool;
+		Mac_address const  _client_mac;
+		Ipv4_addr   const  _client_ip;
+		Uplink            &_uplink;
+
+		Genode::Signal_context_capability _link_state_sigh;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc      backing store of the packet allocator
+		 * \param amount     amount of memory available for the packet
+		 *                   allocator
+		 * \param address    address of the router within the network of
+		 *                   the client
+		 * \param client_ip  address of the client
+		 */
+		Session_component(Genode::Allocator  &alloc,
+		                  Genode::size_t      amount,
+		                  Genode::size_t      tx_buf_size,
+		                  Genode::size_t      rx_buf_size,
+		                  Server::Entrypoint &ep,
+		                  Router             &router,
+		                  Uplink             &uplink,
+		                  Mac_pool           &mac_pool,
+		                  Ipv4_prefix         address,
+		                  Ipv4_addr           client_ip)
+		:
+			Guarded_range_allocator(alloc, amount),
+			Communication_buffers(tx_buf_size, rx_buf_size),
+			Session_rpc_object(_tx_ds.cap(), _rx_ds.cap(), &_range_alloc,
+			                   ep.rpc_ep()),
+			Interface(ep, router, uplink.mac(), address),
+			_mac_pool(mac_pool), _client_mac(mac_pool.alloc()),
+			_client_ip(client_ip), _uplink(uplink)
+		{
+			_tx.sigh_ready_to_ack(_sink_ack);
+			_tx.sigh_packet_avail(_sink_submit);
+			_rx.sigh_ack_avail(_source_ack);
+			_rx.sigh_ready_to_submit(_source_submit);
+		}
+
+		~Session_component() { _mac_pool.free(_client_mac); }
+
+
+		/****************************
+		 ** Nic::Session interface **
+		 ****************************/
+
+		::Nic::Mac_address mac_address() override
+		{
+			::Nic::Mac_address m;
+			Genode::memcpy(&m, _client_mac.addr, sizeof(m.addr));
+			return m;
+		}
+
+		bool link_state() override { return _uplink.link_state(); }
+
+		void link_state_sigh(Genode::Signal_context_capability sigh) override {
+			_link_state_sigh = sigh; }
+
+		/*
+		 * Packets are copied between the sessions of the router without
+		 * their checksum status. Hence, the checksums are neither computed
+		 * nor verified on behalf of the client.
+		 */
+		::Nic::Offload offload() override { return ::Nic::Offload(); }
+
+
+		/*************************
+		 ** Interface interface **
+		 *************************/
+
+		Packet_stream_sink< ::Nic::Session::Policy> *sink() override {
+			return _tx.sink(); }
+
+		Packet_stream_source< ::Nic::Session::Policy> *source() override {
+			return _rx.source(); }
+
+		bool mac_of(Ipv4_addr ip, Mac_address &mac) override
+		{
+			if (ip != _client_ip)
+				return false;
+
+			mac = _client_mac;
+			return true;
+		}
+
+		void link_state_changed() override
+		{
+			if (_link_state_sigh.valid())
+				Genode::Signal_transmitter(_link_state_sigh).submit();
+		}
+};
+
+
+class Net::Root : public Genode::Root_component<Session_component>
+{
+	private:
+
+		Server::Entrypoint &_ep;
+		Router             &_router;
+		Uplink             &_uplink;
+		Mac_pool            _mac_pool;
+
+	protected:
+
+		Session_component *_create_session(const char *args)
+		{
+			using namespace Genode;
+
+			enum { MAX_ADDR_LEN = 20 };
+			char address[MAX_ADDR_LEN];
+			char client_ip[MAX_ADDR_LEN];
+
+			try {
+				Session_label  label(args);
+				Session_policy policy(label);
+				policy.attribute("interface").value(address, sizeof(address));
+				policy.attribute("ip_addr").value(client_ip, sizeof(client_ip));
+			} catch (Xml_node::Nonexistent_attribute) {
+				PERR("Missing \"interface\" or \"ip_addr\" attribute in policy");
+				throw Root::Unavailable();
+			} catch (Session_policy::No_policy_defined) {
+				PERR("Invalid session request, no matching policy");
+				throw Root::Unavailable();
+			}
+
+			size_t const ram_quota =
+				Arg_string::find_arg(args, "ram_quota"  ).ulong_value(0);
+			size_t const tx_buf_size =
+				Arg_string::find_arg(args, "tx_buf_size").ulong_value(0);
+			size_t const rx_buf_size =
+				Arg_string::find_arg(args, "rx_buf_size").ulong_value(0);
+
+			/* deplete ram quota by the memory needed for the session */
+			size_t const session_size = max((size_t)4096, sizeof(Session_component));
+			if (ram_quota < session_size)
+				throw Root::Quota_exceeded();
+
+			/*
+			 * Check if donated ram quota suffices for both communication
+			 * buffers. Also check both sizes separately to handle a
+			 * possible overflow of the sum of both sizes.
+			 */
+			if (tx_buf_size                 > ram_quota - session_size
+			 || rx_buf_size                 > ram_quota - session_size
+			 || tx_buf_size + rx_buf_size   > ram_quota - session_size) {
+				PERR("insufficient 'ram_quota', got %zd, need %zd",
+				     ram_quota, tx_buf_size + rx_buf_size + session_size);
+				throw Root::Quota_exceeded();
+			}
+
+			try {
+				return new (md_alloc())
+					Session_component(*env()->heap(), ram_quota - session_size,
+					                  tx_buf_size, rx_buf_size, _ep, _router,
+					                  _uplink, _mac_pool, Ipv4_prefix(address),
+					                  ipv4_addr(client_ip));
+			} catch (Mac_pool::Alloc_failed) {
+				PWRN("Mac address allocation failed!");
+				throw Root::Unavailable();
+			}
+		}
+
+	public:
+
+		Root(Server::Entrypoint &ep, Router &router, Uplink &uplink,
+		     Genode::Allocator &md_alloc)
+		:
+			Genode::Root_component<Session_component>(&ep.rpc_ep(), &md_alloc),
+			_ep(ep), _router(router), _uplink(uplink)
+		{ }
+};
+
+#endif /* _SRC__SERVER__NIC_ROUTER__COMPONENT_H_ */
@@ -0,0 +1,130 @@
+/*
+ * \brief  Network interface of the router
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* local includes */
+#include <interface.h>
+#include <router.h>
+
+using namespace Net;
+
+static const bool verbose = false;
+
+
+void Interface::_release_acked_packets()
+{
+	Packet_descriptor packets[BATCH_SIZE];
+
+	while (source()->ack_avail()) {
+		unsigned const cnt = source()->get_acked_packets(packets, BATCH_SIZE);
+		for (unsigned i = 0; i < cnt; i++)
+			source()->release_packet(packets[i]);
+	}
+}
+
+
+void Interface::_ready_to_submit(unsigned)
+{
+	Packet_descriptor packets[BATCH_SIZE];
+
+	while (sink()->packet_avail()) {
+
+		unsigned const slots = Genode::min(sink()->ack_slots_free(),
+		                                   (unsigned)BATCH_SIZE);
+		if (!slots) {
+			if (verbose)
+				PWRN("ack state FULL");
+			break;
+		}
+
+		unsigned const received = sink()->get_packets(packets, slots);
+
+		unsigned cnt = 0;
+		for (unsigned i = 0; i < received; i++) {
+			if (!packets[i].valid()) continue;
+
+			_router.handle(*this, sink()->packet_content(packets[i]),
+			               packets[i].size());
+			packets[cnt++] = packets[i];
+		}
+
+		sink()->acknowledge_packets(packets, cnt);
+
+		/* submit the packets forwarded to any interface */
+		_router.flush();
+	}
+}
+
+
+void Interface::_ready_to_ack(unsigned) { _release_acked_packets(); }
+
+
+void Interface::send(void const *frame, Genode::size_t size)
+{
+	typedef Packet_stream_source< ::Nic::Session::Policy> Source;
+
+	if (_tx_batch_len == BATCH_SIZE)
+		flush();
+
+	Packet_descriptor packet;
+	try { packet = source()->alloc_packet(size); }
+	catch (Source::Packet_alloc_failed) {
+
+		/* the buffer may be occupied by packets acknowledged meanwhile */
+		_release_acked_packets();
+
+		try { packet = source()->alloc_packet(size); }
+		catch (Source::Packet_alloc_failed) {
+			if (verbose)
+				PWRN("Packet dropped");
+			return;
+		}
+	}
+
+	Genode::memcpy(source()->packet_content(packet), frame, size);
+	_tx_batch[_tx_batch_len++] = packet;
+}
+
+
+void Interface::flush()
+{
+	if (!_tx_batch_len)
+		return;
+
+	unsigned const cnt = Genode::min(_tx_batch_len, source()->submit_slots_free());
+	source()->submit_packets(_tx_batch, cnt);
+
+	/* drop packets that do not fit into the submit queue */
+	for (unsigned i = cnt; i < _tx_batch_len; i++)
+		source()->release_packet(_tx_batch[i]);
+
+	if (verbose && cnt < _tx_batch_len)
+		PWRN("%u packets dropped", _tx_batch_len - cnt);
+
+	_tx_batch_len = 0;
+}
+
+
+Interface::Interface(Server::Entrypoint &ep, Router &router, Mac_address mac,
+                     Ipv4_prefix address)
+:
+	_router(router), _mac(mac), _address(address),
+	_sink_ack(ep, *this, &Interface::_ack_avail, DATA_PATH_PRIORITY),
+	_sink_submit(ep, *this, &Interface::_ready_to_submit, DATA_PATH_PRIORITY),
+	_source_ack(ep, *this, &Interface::_ready_to_ack, DATA_PATH_PRIORITY),
+	_source_submit(ep, *this, &Interface::_packet_avail, DATA_PATH_PRIORITY)
+{
+	_router.attach(*this);
+}
+
+
+Interface::~Interface() { _router.detach(*this); }
@@ -0,0 +1,155 @@
+/*
+ * \brief  Network interface of the router
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _SRC__SERVER__NIC_ROUTER__INTERFACE_H_
+#define _SRC__SERVER__NIC_ROUTER__INTERFACE_H_
+
+/* Genode includes */
+#include <util/list.h>
+#include <nic_session/nic_session.h>
+#include <os/server.h>
+#include <net/ethernet.h>
+
+/* local includes */
+#include <ipv4_prefix.h>
+
+namespace Net {
+
+	class Router;
+	class Interface;
+
+	using ::Nic::Packet_stream_sink;
+	using ::Nic::Packet_stream_source;
+	typedef ::Nic::Packet_descriptor Packet_descriptor;
+}
+
+
+/**
+ * Packet-stream endpoint of the router, either the uplink or the session
+ * of a client
+ *
+ * Received packets are processed in batches. Each packet is rewritten in
+ * place within the packet-stream buffer of the receiving interface and
+ * copied once into the buffer of the sending interface. The packets sent
+ * during the processing of a batch are submitted at once when the batch
+ * is complete.
+ */
+class Net::Interface : public Genode::List<Interface>::Element
+{
+	public:
+
+		typedef Ethernet_frame::Mac_address Mac_address;
+
+		/*
+		 * Maximum number of packets taken from or submitted to a
+		 * packet-stream queue at once
+		 */
+		enum { BATCH_SIZE = 32 };
+
+	private:
+
+		Router &_router;
+
+		Mac_address const _mac;
+
+		/* address of the router within the network of the interface */
+		Ipv4_prefix const _address;
+
+		Packet_descriptor _tx_batch[BATCH_SIZE];
+		unsigned          _tx_batch_len = 0;
+
+		void _release_acked_packets();
+
+		/**
+		 * submit queue not empty anymore
+		 */
+		void _ready_to_submit(unsigned);
+
+		/**
+		 * acknoledgement queue not empty anymore
+		 */
+		void _ready_to_ack(unsigned);
+
+		/*
+		 * Packets that cannot be transferred to the other side are
+		 * dropped. Hence, the signals about free queue slots are ignored.
+		 */
+		void _ack_avail(unsigned) { }
+		void _packet_avail(unsigned) { }
+
+	protected:
+
+		/* handle packets before link-state changes */
+		enum { DATA_PATH_PRIORITY = 1 };
+
+		Genode::Signal_rpc_member<Interface> _sink_ack;
+		Genode::Signal_rpc_member<Interface> _sink_submit;
+		Genode::Signal_rpc_member<Interface> _source_ack;
+		Genode::Signal_rpc_member<Interface> _source_submit;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param mac      MAC address of the router at the interface
+		 * \param address  IP address of the router at the interface and
+		 *                 prefix length of the attached network
+		 */
+		Interface(Server::Entrypoint &ep, Router &router, Mac_address mac,
+		          Ipv4_prefix address);
+
+		virtual ~Interface();
+
+		Router &router() { return _router; }
+
+		Mac_address mac() const { return _mac; }
+
+		Ipv4_addr ip() const { return _address.addr; }
+
+		Ipv4_prefix network() const {
+			return Ipv4_prefix(_address.addr & _address.mask(), _address.len); }
+
+		virtual Packet_stream_sink< ::Nic::Session::Policy>   *sink()   = 0;
+		virtual Packet_stream_source< ::Nic::Session::Policy> *source() = 0;
+
+		/**
+		 * Determine MAC address of a host within the attached network
+		 *
+		 * \return false if the MAC address is unknown, the packet for the
+		 *         host is dropped in this case
+		 */
+		virtual bool mac_of(Ipv4_addr ip, Mac_address &mac) = 0;
+
+		/**
+		 * Record MAC address of a host within the attached network
+		 */
+		virtual void learn(Ipv4_addr ip, Mac_address mac) { }
+
+		/**
+		 * Called when the link state of the uplink changed
+		 */
+		virtual void link_state_changed() { }
+
+		/**
+		 * Queue copy of an ethernet frame for sending
+		 */
+		void send(void const *frame, Genode::size_t size);
+
+		/**
+		 * Submit queued frames
+		 */
+		void flush();
+};
+
+#endif /* _SRC__SERVER__NIC_ROUTER__INTERFACE_H_ */
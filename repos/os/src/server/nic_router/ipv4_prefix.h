@@ -0,0 +1,95 @@
+/*
+ * \brief  IPv4 addresses and network prefixes in host byte order
+ * \author Norman Feske
+ * \date   2015-12-30
+ *
+ * On the forwarding path, addresses are compared and masked for each
+ * packet. Hence, the router keeps them as plain integers instead of the
+ * byte arrays used by the packet headers.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _SRC__SERVER__NIC_ROUTER__IPV4_PREFIX_H_
+#define _SRC__SERVER__NIC_ROUTER__IPV4_PREFIX_H_
+
+/* Genode includes */
+#include <util/string.h>
+#include <net/ipv4.h>
+
+namespace Net {
+
+	typedef Genode::uint32_t Ipv4_addr;
+
+	struct Ipv4_prefix;
+
+	inline Ipv4_addr ipv4_addr(Ipv4_packet::Ipv4_address const &ip)
+	{
+		return (ip.addr[0] << 24) | (ip.addr[1] << 16)
+		     | (ip.addr[2] <<  8) |  ip.addr[3];
+	}
+
+	inline Ipv4_packet::Ipv4_address ipv4_address(Ipv4_addr ip)
+	{
+		Ipv4_packet::Ipv4_address result;
+		result.addr[0] = ip >> 24;
+		result.addr[1] = ip >> 16;
+		result.addr[2] = ip >>  8;
+		result.addr[3] = ip;
+		return result;
+	}
+
+	/**
+	 * Convert address given in dotted-decimal notation
+	 */
+	inline Ipv4_addr ipv4_addr(char const *str) {
+		return ipv4_addr(Ipv4_packet::ip_from_string(str)); }
+}
+
+
+struct Net::Ipv4_prefix
+{
+	Ipv4_addr addr = 0;
+	unsigned  len  = 0;
+
+	Ipv4_prefix() { }
+
+	Ipv4_prefix(Ipv4_addr addr, unsigned len) : addr(addr), len(len) { }
+
+	/**
+	 * Constructor
+	 *
+	 * \param str  prefix in the form "a.b.c.d/len", a missing length
+	 *             denotes a host address
+	 */
+	Ipv4_prefix(char const *str) : len(32)
+	{
+		enum { MAX_LEN = 16 };
+		char ip[MAX_LEN];
+
+		Genode::size_t i = 0;
+		for (; str[i] && str[i] != '/' && i + 1 < MAX_LEN; i++)
+			ip[i] = str[i];
+		ip[i] = 0;
+
+		addr = ipv4_addr(ip);
+
+		if (str[i] == '/') {
+			unsigned long l = 0;
+			Genode::ascii_to(str + i + 1, l);
+			len = Genode::min(l, 32UL);
+		}
+	}
+
+	Ipv4_addr mask() const { return len ? ~0U << (32 - len) : 0; }
+
+	bool contains(Ipv4_addr ip) const {
+		return ((ip ^ addr) & mask()) == 0; }
+};
+
+#endif /* _SRC__SERVER__NIC_ROUTER__IPV4_PREFIX_H_ */
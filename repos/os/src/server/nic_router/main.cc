@@ -0,0 +1,100 @@
+/*
+ * \brief  IPv4 router with network address translation for NIC sessions
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <os/config.h>
+#include <os/server.h>
+
+/* local includes */
+#include <component.h>
+#include <router.h>
+#include <uplink.h>
+
+
+struct Main
+{
+	typedef Genode::String<32> Address;
+
+	Server::Entrypoint &ep;
+
+	Genode::Xml_node const config = Genode::config()->xml_node();
+
+	Genode::Xml_node _uplink_config() const
+	{
+		try { return config.sub_node("uplink"); }
+		catch (Genode::Xml_node::Nonexistent_sub_node) {
+			return Genode::Xml_node("<uplink/>"); }
+	}
+
+	Net::Ipv4_prefix _uplink_address() const
+	{
+		return Net::Ipv4_prefix(_uplink_config().attribute_value("interface",
+		                                                         Address()).string());
+	}
+
+	Net::Router router = { ep };
+	Net::Uplink uplink = { ep, router, _uplink_address() };
+	Net::Root   root   = { ep, router, uplink, *Genode::env()->heap() };
+
+	void _insert_route(Net::Ipv4_prefix dst, Net::Ipv4_addr gateway)
+	{
+		try { router.routes().insert(dst, gateway); }
+		catch (Net::Route_table::Table_full) { PERR("routing table full"); }
+	}
+
+	void _read_routes()
+	{
+		Genode::Xml_node const uplink_config = _uplink_config();
+
+		if (uplink_config.has_attribute("gateway"))
+			_insert_route(Net::Ipv4_prefix(0, 0), Net::ipv4_addr(
+				uplink_config.attribute_value("gateway", Address()).string()));
+
+		config.for_each_sub_node("route", [&] (Genode::Xml_node route) {
+			_insert_route(Net::Ipv4_prefix(route.attribute_value("dst", Address()).string()),
+			              Net::ipv4_addr(route.attribute_value("gateway", Address()).string()));
+		});
+	}
+
+	Main(Server::Entrypoint &ep) : ep(ep)
+	{
+		_read_routes();
+
+		if (_uplink_config().attribute_value("nat", false))
+			router.nat(uplink);
+
+		Net::Ethernet_frame::Mac_address mac(uplink.mac());
+		Genode::printf("--- NIC router started "
+		               "(mac=%02x:%02x:%02x:%02x:%02x:%02x) ---\n",
+		               mac.addr[0], mac.addr[1], mac.addr[2],
+		               mac.addr[3], mac.addr[4], mac.addr[5]);
+
+		Genode::env()->parent()->announce(ep.manage(root));
+	}
+};
+
+
+/************
+ ** Server **
+ ************/
+
+namespace Server {
+
+	char const *name() { return "nic_router_ep"; }
+
+	size_t stack_size() { return 2048*sizeof(Genode::addr_t); }
+
+	void construct(Entrypoint &ep) { static Main nic_router(ep); }
+}
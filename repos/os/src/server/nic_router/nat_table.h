@@ -0,0 +1,214 @@
+/*
+ * \brief  Connection tracking for network address and port translation
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _SRC__SERVER__NIC_ROUTER__NAT_TABLE_H_
+#define _SRC__SERVER__NIC_ROUTER__NAT_TABLE_H_
+
+/* local includes */
+#include <ipv4_prefix.h>
+
+namespace Net {
+
+	class Interface;
+	class Nat_table;
+}
+
+
+/**
+ * Table of translated TCP and UDP connections
+ *
+ * Each connection originating from an internal interface is assigned a
+ * port of the external address. The entries are preallocated and the port
+ * of an entry is derived from its index. Hence, packets of established
+ * connections are translated without allocating memory, outbound packets
+ * are looked up via a hash table, and inbound packets are looked up via
+ * their destination port.
+ *
+ * Entries expire after a protocol-specific idle time. Expired entries
+ * are reclaimed lazily once no free entry is left.
+ */
+class Net::Nat_table
+{
+	public:
+
+		enum {
+			MAX_ENTRIES = 1024,
+			PORT_BASE   = 49152,
+			TCP_TIMEOUT = 600,  /* seconds */
+			UDP_TIMEOUT = 60,   /* seconds */
+		};
+
+		/* IP protocols subject to translation */
+		enum Protocol { TCP = 6, UDP = 17 };
+
+		/**
+		 * Connection as seen on the internal interface
+		 */
+		struct Key
+		{
+			Ipv4_addr        src, dst;
+			Genode::uint16_t src_port, dst_port;
+			Genode::uint8_t  protocol;
+
+			bool operator == (Key const &other) const
+			{
+				return src      == other.src      && dst      == other.dst
+				    && src_port == other.src_port && dst_port == other.dst_port
+				    && protocol == other.protocol;
+			}
+		};
+
+		struct Entry
+		{
+			Key               key;
+			Interface        *interface = nullptr;  /* internal interface */
+			unsigned long     last_used = 0;        /* seconds */
+			Genode::uint16_t  port      = 0;        /* external port */
+			Entry            *next      = nullptr;  /* bucket or free list */
+		};
+
+	private:
+
+		enum { NUM_BUCKETS = 256 };
+
+		Entry  _entries[MAX_ENTRIES];
+		Entry *_buckets[NUM_BUCKETS];
+		Entry *_free = nullptr;
+
+		static unsigned _hash(Key const &key)
+		{
+			Genode::uint32_t h = key.src ^ key.dst ^ key.protocol
+			                   ^ ((Genode::uint32_t)key.src_port << 16)
+			                   ^ key.dst_port;
+			h ^= h >> 16;
+			h ^= h >> 8;
+			return h % NUM_BUCKETS;
+		}
+
+		static unsigned long _timeout(Entry const &e)
+		{
+			return e.key.protocol == TCP ? TCP_TIMEOUT : UDP_TIMEOUT;
+		}
+
+		bool _used(Entry const &e) const { return e.interface != nullptr; }
+
+		void _release(Entry &e)
+		{
+			for (Entry **p = &_buckets[_hash(e.key)]; *p; p = &(*p)->next)
+				if (*p == &e) {
+					*p = e.next;
+					break;
+				}
+
+			e.interface = nullptr;
+			e.next      = _free;
+			_free       = &e;
+		}
+
+		void _reclaim(unsigned long now)
+		{
+			for (unsigned i = 0; i < MAX_ENTRIES; i++) {
+				Entry &e = _entries[i];
+				if (_used(e) && now - e.last_used > _timeout(e))
+					_release(e);
+			}
+		}
+
+	public:
+
+		Nat_table()
+		{
+			for (unsigned i = 0; i < NUM_BUCKETS; i++)
+				_buckets[i] = nullptr;
+
+			for (unsigned i = MAX_ENTRIES; i > 0; i--) {
+				Entry &e = _entries[i - 1];
+				e.port = PORT_BASE + i - 1;
+				e.next = _free;
+				_free  = &e;
+			}
+		}
+
+		/**
+		 * Look up connection of an outbound packet, create it if needed
+		 *
+		 * \param interface  internal interface the packet came from
+		 * \param now        current time in seconds
+		 *
+		 * \return  entry of the connection, or nullptr if all entries
+		 *          are in use
+		 */
+		Entry *outbound(Key const &key, Interface &interface, unsigned long now)
+		{
+			Entry **bucket = &_buckets[_hash(key)];
+
+			for (Entry *e = *bucket; e; e = e->next)
+				if (e->key == key && e->interface == &interface) {
+					e->last_used = now;
+					return e;
+				}
+
+			if (!_free)
+				_reclaim(now);
+
+			Entry *e = _free;
+			if (!e)
+				return nullptr;
+
+			_free = e->next;
+
+			e->key       = key;
+			e->interface = &interface;
+			e->last_used = now;
+			e->next      = *bucket;
+			*bucket      = e;
+			return e;
+		}
+
+		/**
+		 * Look up connection of an inbound packet
+		 *
+		 * \param protocol  IP protocol of the packet
+		 * \param src       source address of the packet
+		 * \param src_port  source port of the packet
+		 * \param port      destination port of the packet
+		 */
+		Entry *inbound(Genode::uint8_t protocol, Ipv4_addr src,
+		               Genode::uint16_t src_port, Genode::uint16_t port,
+		               unsigned long now)
+		{
+			if (port < PORT_BASE || port >= PORT_BASE + MAX_ENTRIES)
+				return nullptr;
+
+			Entry &e = _entries[port - PORT_BASE];
+
+			if (!_used(e) || e.key.protocol != protocol || e.key.dst != src
+			 || e.key.dst_port != src_port)
+				return nullptr;
+
+			e.last_used = now;
+			return &e;
+		}
+
+		/**
+		 * Remove all connections of an internal interface
+		 */
+		void flush(Interface const &interface)
+		{
+			for (unsigned i = 0; i < MAX_ENTRIES; i++)
+				if (_entries[i].interface == &interface)
+					_release(_entries[i]);
+		}
+};
+
+#endif /* _SRC__SERVER__NIC_ROUTER__NAT_TABLE_H_ */
@@ -0,0 +1,148 @@
+/*
+ * \brief  Longest-prefix-match routing table
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _SRC__SERVER__NIC_ROUTER__ROUTE_TABLE_H_
+#define _SRC__SERVER__NIC_ROUTER__ROUTE_TABLE_H_
+
+/* Genode includes */
+#include <base/exception.h>
+
+/* local includes */
+#include <ipv4_prefix.h>
+
+namespace Net {
+
+	class Interface;
+	class Route_table;
+}
+
+
+/**
+ * Table of routes, sorted by decreasing prefix length
+ *
+ * Because the routes are sorted, the first route that matches a
+ * destination is the one with the longest prefix. The table is small and
+ * kept in a contiguous array so that a lookup touches only a few cache
+ * lines.
+ *
+ * A route either refers to the interface of a directly connected network
+ * or to a gateway. The interface of a gateway is determined by the
+ * connected network that contains the gateway. So static routes can be
+ * configured before the interface of their gateway exists.
+ */
+class Net::Route_table
+{
+	public:
+
+		enum { MAX_ROUTES = 64 };
+
+		class Table_full : Genode::Exception { };
+
+	private:
+
+		struct Route
+		{
+			Ipv4_prefix dst;
+			Ipv4_addr   gateway;
+			Interface  *interface;  /* nullptr for routes via a gateway */
+		};
+
+		Route    _routes[MAX_ROUTES];
+		unsigned _num_routes = 0;
+
+		void _insert(Route const &route)
+		{
+			if (_num_routes == MAX_ROUTES)
+				throw Table_full();
+
+			/* keep the insertion order among routes of the same length */
+			unsigned i = _num_routes;
+			for (; i > 0 && _routes[i - 1].dst.len < route.dst.len; i--)
+				_routes[i] = _routes[i - 1];
+
+			_routes[i] = route;
+			_num_routes++;
+		}
+
+		Route const *_lookup(Ipv4_addr ip, bool connected_only) const
+		{
+			for (unsigned i = 0; i < _num_routes; i++) {
+				Route const &r = _routes[i];
+				if ((!connected_only || r.interface) && r.dst.contains(ip))
+					return &r;
+			}
+			return nullptr;
+		}
+
+	public:
+
+		/**
+		 * Add route to directly connected network
+		 *
+		 * \throw Table_full
+		 */
+		void insert(Ipv4_prefix dst, Interface &interface) {
+			_insert(Route { dst, 0, &interface }); }
+
+		/**
+		 * Add route via gateway
+		 *
+		 * \throw Table_full
+		 */
+		void insert(Ipv4_prefix dst, Ipv4_addr gateway) {
+			_insert(Route { dst, gateway, nullptr }); }
+
+		/**
+		 * Remove all routes to directly connected networks of 'interface'
+		 */
+		void remove(Interface const &interface)
+		{
+			unsigned n = 0;
+			for (unsigned i = 0; i < _num_routes; i++)
+				if (_routes[i].interface != &interface)
+					_routes[n++] = _routes[i];
+
+			_num_routes = n;
+		}
+
+		/**
+		 * Look up next hop for destination address
+		 *
+		 * \param ip         destination address
+		 * \param next_hop   resulting address of the next hop
+		 *
+		 * \return  interface of the next hop, or nullptr if no route
+		 *          matches
+		 */
+		Interface *lookup(Ipv4_addr ip, Ipv4_addr &next_hop) const
+		{
+			Route const *r = _lookup(ip, false);
+			if (!r)
+				return nullptr;
+
+			if (r->interface) {
+				next_hop = ip;
+				return r->interface;
+			}
+
+			/* resolve interface of gateway */
+			Route const *gw = _lookup(r->gateway, true);
+			if (!gw)
+				return nullptr;
+
+			next_hop = r->gateway;
+			return gw->interface;
+		}
+};
+
+#endif /* _SRC__SERVER__NIC_ROUTER__ROUTE_TABLE_H_ */
@@ -0,0 +1,304 @@
+/*
+ * \brief  Forwarding of IPv4 packets between interfaces
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <net/arp.h>
+
+/* local includes */
+#include <router.h>
+
+using namespace Net;
+
+static const bool verbose = false;
+
+typedef Genode::uint8_t  uint8_t;
+typedef Genode::uint16_t uint16_t;
+typedef Genode::uint32_t uint32_t;
+
+
+/*
+ * The router accesses the transport headers of TCP and UDP only for
+ * rewriting ports and checksums. Both protocols start with the source and
+ * destination port.
+ */
+enum {
+	SRC_PORT     = 0,
+	DST_PORT     = 2,
+	UDP_CHECKSUM = 6,
+	TCP_CHECKSUM = 16,
+	UDP_MIN_SIZE = 8,
+	TCP_MIN_SIZE = 20,
+};
+
+
+static inline uint16_t read_be16(uint8_t const *p) {
+	return (p[0] << 8) | p[1]; }
+
+
+static inline void write_be16(uint8_t *p, uint16_t v) {
+	p[0] = v >> 8; p[1] = v; }
+
+
+/**
+ * Update one's complement checksum for changed 16-bit word (RFC 1624)
+ */
+static uint16_t checksum_adjust(uint16_t sum, uint16_t old_value,
+                                uint16_t new_value)
+{
+	uint32_t s = (uint16_t)~sum + (uint16_t)~old_value + new_value;
+	s = (s & 0xffff) + (s >> 16);
+	s = (s & 0xffff) + (s >> 16);
+	return ~s;
+}
+
+
+static uint16_t checksum_adjust(uint16_t sum, Ipv4_addr old_addr,
+                                Ipv4_addr new_addr)
+{
+	sum = checksum_adjust(sum, old_addr >> 16, new_addr >> 16);
+	return checksum_adjust(sum, old_addr & 0xffff, new_addr & 0xffff);
+}
+
+
+/**
+ * Rewrite source or destination of a TCP or UDP packet
+ *
+ * \param l4  transport header of the packet
+ */
+static void translate(Ipv4_packet &ip, uint8_t *l4, bool src,
+                      Ipv4_addr addr, uint16_t port)
+{
+	Ipv4_addr const old_addr = ipv4_addr(src ? ip.src() : ip.dst());
+
+	if (src) ip.src(ipv4_address(addr));
+	else     ip.dst(ipv4_address(addr));
+
+	ip.checksum(checksum_adjust(ip.checksum(), old_addr, addr));
+
+	uint8_t * const port_field = l4 + (src ? SRC_PORT : DST_PORT);
+	uint16_t  const old_port   = read_be16(port_field);
+	write_be16(port_field, port);
+
+	/* the transport checksum covers the addresses of the pseudo header */
+	bool const udp = (ip.protocol() == Nat_table::UDP);
+	uint8_t * const csum_field = l4 + (udp ? UDP_CHECKSUM : TCP_CHECKSUM);
+
+	uint16_t csum = read_be16(csum_field);
+
+	/* UDP packets may come without checksum */
+	if (udp && csum == 0)
+		return;
+
+	csum = checksum_adjust(checksum_adjust(csum, old_addr, addr),
+	                       old_port, port);
+
+	write_be16(csum_field, (udp && csum == 0) ? 0xffff : csum);
+}
+
+
+void Router::_handle_arp(Interface &from, Ethernet_frame &eth,
+                         Genode::size_t size)
+{
+	Arp_packet *arp = new (eth.data()) Arp_packet(size - sizeof(Ethernet_frame));
+
+	if (!arp->ethernet_ipv4())
+		return;
+
+	Ipv4_addr const src_ip = ipv4_addr(arp->src_ip());
+	if (from.network().contains(src_ip))
+		from.learn(src_ip, arp->src_mac());
+
+	if (arp->opcode() != Arp_packet::REQUEST
+	 || ipv4_addr(arp->dst_ip()) != from.ip())
+		return;
+
+	/* turn the request into the reply */
+	arp->opcode(Arp_packet::REPLY);
+	arp->dst_mac(arp->src_mac());
+	arp->dst_ip(arp->src_ip());
+	arp->src_mac(from.mac());
+	arp->src_ip(ipv4_address(from.ip()));
+
+	eth.dst(arp->dst_mac());
+	eth.src(from.mac());
+
+	from.send(&eth, size);
+}
+
+
+void Router::_handle_ip(Interface &from, Ethernet_frame &eth,
+                        Genode::size_t size)
+{
+	/* only frames addressed to the router are forwarded */
+	if (!(eth.dst() == from.mac()))
+		return;
+
+	Genode::size_t const ip_size = size - sizeof(Ethernet_frame);
+
+	Ipv4_packet &ip  = *new (eth.data()) Ipv4_packet(ip_size);
+	uint8_t     *raw = (uint8_t *)eth.data();
+
+	/*
+	 * The bitfields of 'Ipv4_packet' for the header length and the
+	 * fragment offset depend on the endianess of the host. So we read
+	 * these header fields directly.
+	 */
+	Genode::size_t const header_size = (raw[0] & 0xf)*4;
+	Genode::size_t const total_size  = ip.total_length();
+
+	if ((raw[0] >> 4) != 4 || header_size < sizeof(Ipv4_packet)
+	 || total_size < header_size || total_size > ip_size)
+		return;
+
+	if (ip.time_to_live() <= 1)
+		return;
+
+	/* transport header of unfragmented TCP and UDP packets */
+	uint8_t * const l4       = raw + header_size;
+	bool      const fragment = read_be16(raw + 6) & 0x3fff;
+	bool      const tcp      = ip.protocol() == Nat_table::TCP
+	                        && total_size >= header_size + TCP_MIN_SIZE;
+	bool      const udp      = ip.protocol() == Nat_table::UDP
+	                        && total_size >= header_size + UDP_MIN_SIZE;
+	bool      const ports    = !fragment && (tcp || udp);
+
+	Ipv4_addr const dst = ipv4_addr(ip.dst());
+
+	Interface *to       = nullptr;
+	Ipv4_addr  next_hop = 0;
+
+	if (dst == from.ip()) {
+
+		/* only replies of translated connections are addressed to us */
+		if (&from != _nat_interface || !ports)
+			return;
+
+		Nat_table::Entry *e = _nat.inbound(ip.protocol(), ipv4_addr(ip.src()),
+		                                   read_be16(l4 + SRC_PORT),
+		                                   read_be16(l4 + DST_PORT), _now);
+		if (!e)
+			return;
+
+		translate(ip, l4, false, e->key.src, e->key.src_port);
+
+		to       = e->interface;
+		next_hop = e->key.src;
+
+	} else {
+
+		to = _routes.lookup(dst, next_hop);
+
+		if (!to || to == &from || next_hop == to->ip())
+			return;
+
+		if (to == _nat_interface) {
+
+			if (!ports)
+				return;
+
+			Nat_table::Key const key { ipv4_addr(ip.src()), dst,
+			                           read_be16(l4 + SRC_PORT),
+			                           read_be16(l4 + DST_PORT),
+			                           ip.protocol() };
+
+			Nat_table::Entry *e = _nat.outbound(key, from, _now);
+			if (!e) {
+				if (verbose)
+					PWRN("no free connection for address translation");
+				return;
+			}
+
+			translate(ip, l4, true, to->ip(), e->port);
+		}
+	}
+
+	Interface::Mac_address mac;
+	if (!to->mac_of(next_hop, mac))
+		return;
+
+	/* the TTL shares a 16-bit word of the header with the protocol */
+	uint16_t const old_word = (ip.time_to_live() << 8) | ip.protocol();
+	ip.time_to_live(ip.time_to_live() - 1);
+	ip.checksum(checksum_adjust(ip.checksum(), old_word,
+	                            (uint16_t)(old_word - 0x100)));
+
+	eth.src(to->mac());
+	eth.dst(mac);
+
+	to->send(&eth, size);
+}
+
+
+void Router::handle(Interface &from, void *frame, Genode::size_t size)
+{
+	try {
+		Ethernet_frame &eth = *new (frame) Ethernet_frame(size);
+
+		switch (eth.type()) {
+		case Ethernet_frame::ARP:  _handle_arp(from, eth, size); break;
+		case Ethernet_frame::IPV4: _handle_ip(from, eth, size);  break;
+		default: ;
+		}
+	} catch (Ethernet_frame::No_ethernet_frame) {
+		if (verbose) PWRN("Invalid ethernet frame");
+	} catch (Arp_packet::No_arp_packet) {
+		if (verbose) PWRN("Invalid ARP packet!");
+	} catch (Ipv4_packet::No_ip_packet) {
+		if (verbose) PWRN("Invalid IPv4 packet!");
+	}
+}
+
+
+void Router::flush()
+{
+	for (Interface *i = _interfaces.first(); i; i = i->next())
+		i->flush();
+}
+
+
+void Router::link_state_changed()
+{
+	for (Interface *i = _interfaces.first(); i; i = i->next())
+		i->link_state_changed();
+}
+
+
+void Router::attach(Interface &interface)
+{
+	_interfaces.insert(&interface);
+
+	try { _routes.insert(interface.network(), interface); }
+	catch (Route_table::Table_full) {
+		PERR("routing table full, network of interface not reachable"); }
+}
+
+
+void Router::detach(Interface &interface)
+{
+	_routes.remove(interface);
+	_nat.flush(interface);
+	_interfaces.remove(&interface);
+
+	if (_nat_interface == &interface)
+		_nat_interface = nullptr;
+}
+
+
+Router::Router(Server::Entrypoint &ep)
+:
+	_tick_dispatcher(ep, *this, &Router::_handle_tick)
+{
+	_timer.sigh(_tick_dispatcher);
+	_timer.trigger_periodic(1000*1000);
+}
@@ -0,0 +1,108 @@
+/*
+ * \brief  Forwarding of IPv4 packets between interfaces
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _SRC__SERVER__NIC_ROUTER__ROUTER_H_
+#define _SRC__SERVER__NIC_ROUTER__ROUTER_H_
+
+/* Genode includes */
+#include <util/list.h>
+#include <timer_session/connection.h>
+#include <os/server.h>
+#include <net/ethernet.h>
+#include <net/ipv4.h>
+
+/* local includes */
+#include <interface.h>
+#include <route_table.h>
+#include <nat_table.h>
+
+namespace Net { class Router; }
+
+
+class Net::Router
+{
+	private:
+
+		Genode::List<Interface> _interfaces;
+
+		Route_table _routes;
+		Nat_table   _nat;
+
+		/* external interface of the address translation */
+		Interface *_nat_interface = nullptr;
+
+		/*
+		 * Coarse clock used for expiring translated connections
+		 *
+		 * The clock is advanced by a periodic timer signal so that the
+		 * forwarding path does not need to query the timer.
+		 */
+		Timer::Connection _timer;
+		unsigned long     _now = 0;  /* seconds */
+
+		void _handle_tick(unsigned) { _now++; }
+
+		Genode::Signal_rpc_member<Router> _tick_dispatcher;
+
+		void _handle_arp(Interface &from, Ethernet_frame &eth,
+		                 Genode::size_t size);
+
+		void _handle_ip(Interface &from, Ethernet_frame &eth,
+		                Genode::size_t size);
+
+	public:
+
+		Router(Server::Entrypoint &ep);
+
+		/**
+		 * Add interface and route to its attached network
+		 */
+		void attach(Interface &interface);
+
+		/**
+		 * Remove interface with its routes and translated connections
+		 */
+		void detach(Interface &interface);
+
+		Route_table &routes() { return _routes; }
+
+		/**
+		 * Translate connections that leave through 'interface'
+		 *
+		 * The source address and port of TCP and UDP packets forwarded
+		 * from any other interface to 'interface' are replaced by the
+		 * address of 'interface' and a port of the router.
+		 */
+		void nat(Interface &interface) { _nat_interface = &interface; }
+
+		unsigned long now() const { return _now; }
+
+		/**
+		 * Forward ethernet frame received at 'from'
+		 *
+		 * The frame is rewritten in place.
+		 */
+		void handle(Interface &from, void *frame, Genode::size_t size);
+
+		/**
+		 * Submit the frames queued at all interfaces
+		 */
+		void flush();
+
+		/**
+		 * Propagate change of the uplink link state to the clients
+		 */
+		void link_state_changed();
+};
+
+#endif /* _SRC__SERVER__NIC_ROUTER__ROUTER_H_ */
@@ -0,0 +1,4 @@
+TARGET   = nic_router
+LIBS     = base net config server
+SRC_CC   = main.cc router.cc interface.cc uplink.cc
+INC_DIR += $(PRG_DIR)
@@ -0,0 +1,91 @@
+/*
+ * \brief  Interface of the router towards the NIC it connects to
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <net/arp.h>
+
+/* local includes */
+#include <uplink.h>
+#include <router.h>
+
+using namespace Net;
+
+
+void Uplink::_arp_request(Ipv4_addr ip)
+{
+	/* limit the requests for the same address to one per second */
+	if (ip == _arp_requested_ip && router().now() == _arp_requested_time)
+		return;
+
+	_arp_requested_ip   = ip;
+	_arp_requested_time = router().now();
+
+	enum { FRAME_SIZE = sizeof(Ethernet_frame) + sizeof(Arp_packet) };
+	Genode::uint8_t buf[FRAME_SIZE];
+
+	Ethernet_frame *eth = new (buf) Ethernet_frame(FRAME_SIZE);
+	eth->dst(Ethernet_frame::BROADCAST);
+	eth->src(mac());
+	eth->type(Ethernet_frame::ARP);
+
+	Arp_packet *arp = new (eth->data()) Arp_packet(FRAME_SIZE - sizeof(Ethernet_frame));
+	arp->init_ethernet_ipv4();
+	arp->opcode(Arp_packet::REQUEST);
+	arp->src_mac(mac());
+	arp->src_ip(ipv4_address(this->ip()));
+	arp->dst_mac(Mac_address());
+	arp->dst_ip(ipv4_address(ip));
+
+	send(buf, FRAME_SIZE);
+}
+
+
+void Uplink::_link_state(unsigned) { router().link_state_changed(); }
+
+
+bool Uplink::mac_of(Ipv4_addr ip, Mac_address &mac)
+{
+	if (Arp_entry *e = _arp_lookup(ip)) {
+		mac = e->mac;
+		return true;
+	}
+
+	_arp_request(ip);
+	return false;
+}
+
+
+void Uplink::learn(Ipv4_addr ip, Mac_address mac)
+{
+	Arp_entry *e = _arp_lookup(ip);
+	if (!e) {
+		e = &_arp_cache[_arp_cache_next];
+		_arp_cache_next = (_arp_cache_next + 1) % ARP_CACHE_SIZE;
+	}
+
+	e->ip  = ip;
+	e->mac = mac;
+}
+
+
+Uplink::Uplink(Server::Entrypoint &ep, Router &router, Ipv4_prefix address)
+:
+	Interface(ep, router, _nic.mac_address().addr, address),
+	_link_state_dispatcher(ep, *this, &Uplink::_link_state)
+{
+	_nic.rx_channel()->sigh_ready_to_ack(_sink_ack);
+	_nic.rx_channel()->sigh_packet_avail(_sink_submit);
+	_nic.tx_channel()->sigh_ack_avail(_source_ack);
+	_nic.tx_channel()->sigh_ready_to_submit(_source_submit);
+	_nic.link_state_sigh(_link_state_dispatcher);
+}
@@ -0,0 +1,116 @@
+/*
+ * \brief  Interface of the router towards the NIC it connects to
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _SRC__SERVER__NIC_ROUTER__UPLINK_H_
+#define _SRC__SERVER__NIC_ROUTER__UPLINK_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <nic_session/connection.h>
+#include <nic/packet_allocator.h>
+
+/* local includes */
+#include <interface.h>
+
+namespace Net {
+
+	class Uplink_connection;
+	class Uplink;
+}
+
+
+/**
+ * Helper for constructing the NIC connection before the interface
+ */
+class Net::Uplink_connection
+{
+	protected:
+
+		enum {
+			PACKET_SIZE = ::Nic::Packet_allocator::DEFAULT_PACKET_SIZE,
+			BUF_SIZE    = ::Nic::Session::QUEUE_SIZE * PACKET_SIZE,
+		};
+
+		::Nic::Packet_allocator _tx_block_alloc;
+		::Nic::Connection       _nic;
+
+		Uplink_connection()
+		:
+			_tx_block_alloc(Genode::env()->heap()),
+			_nic(&_tx_block_alloc, BUF_SIZE, BUF_SIZE)
+		{ }
+};
+
+
+class Net::Uplink : private Uplink_connection, public Interface
+{
+	private:
+
+		enum { ARP_CACHE_SIZE = 16 };
+
+		struct Arp_entry
+		{
+			Ipv4_addr   ip = 0;
+			Mac_address mac;
+		};
+
+		Arp_entry _arp_cache[ARP_CACHE_SIZE];
+		unsigned  _arp_cache_next = 0;  /* entry replaced next */
+
+		/* last address requested via ARP */
+		Ipv4_addr     _arp_requested_ip   = 0;
+		unsigned long _arp_requested_time = 0;
+
+		Arp_entry *_arp_lookup(Ipv4_addr ip)
+		{
+			for (unsigned i = 0; i < ARP_CACHE_SIZE; i++)
+				if (_arp_cache[i].ip == ip)
+					return &_arp_cache[i];
+
+			return nullptr;
+		}
+
+		void _arp_request(Ipv4_addr ip);
+
+		void _link_state(unsigned);
+
+		Genode::Signal_rpc_member<Uplink> _link_state_dispatcher;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Parent::Service_denied  NIC session could not be created
+		 */
+		Uplink(Server::Entrypoint &ep, Router &router, Ipv4_prefix address);
+
+		bool link_state() { return _nic.link_state(); }
+
+
+		/*************************
+		 ** Interface interface **
+		 *************************/
+
+		Packet_stream_sink< ::Nic::Session::Policy> *sink() override {
+			return _nic.rx(); }
+
+		Packet_stream_source< ::Nic::Session::Policy> *source() override {
+			return _nic.tx(); }
+
+		bool mac_of(Ipv4_addr ip, Mac_address &mac) override;
+
+		void learn(Ipv4_addr ip, Mac_address mac) override;
+};
+
+#endif /* _SRC__SERVER__NIC_ROUTER__UPLINK_H_ */
@@ -0,0 +1,154 @@
+/*
+ * \brief  Threads that draw parts of the screen in parallel
+ * \author Norman Feske
+ * \date   2015-12-15
+ *
+ * A dirty rectangle is split into horizontal tiles, which are drawn
+ * concurrently by the worker threads and the caller. Drawing a tile merely
+ * reads the view stack and the client buffers. Only the clipping area of
+ * the canvas is modified, which is why each worker uses a canvas of its own
+ * that refers to the same pixel buffer.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _DRAW_POOL_H_
+#define _DRAW_POOL_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <util/construct_at.h>
+
+/* local includes */
+#include "view_stack.h"
+
+
+template <typename PT>
+class Draw_pool
+{
+	public:
+
+		enum {
+			MAX_WORKERS = 7,
+
+			/* rectangles with fewer lines are not split */
+			MIN_TILE_HEIGHT = 32,
+		};
+
+	private:
+
+		enum { STACK_SIZE = 4*1024*sizeof(long) };
+
+		struct Worker : Genode::Thread<STACK_SIZE>
+		{
+			Canvas<PT>         canvas;
+			Genode::Semaphore &done;
+			Genode::Semaphore  pending;
+			View_stack const  *view_stack = nullptr;
+			Rect               tile;
+
+			Worker(PT *base, Area size, Genode::Semaphore &done,
+			       Genode::Affinity::Location location)
+			:
+				Genode::Thread<STACK_SIZE>("draw"),
+				canvas(base, size), done(done)
+			{
+				Genode::env()->cpu_session()->affinity(this->cap(), location);
+				this->start();
+			}
+
+			void entry() override
+			{
+				for (;;) {
+					pending.down();
+					view_stack->draw_rect(canvas, tile);
+					done.up();
+				}
+			}
+		};
+
+		Genode::Semaphore _done;
+		unsigned const    _count;
+
+		char _workers[MAX_WORKERS][sizeof(Worker)]
+			__attribute__((aligned(sizeof(Genode::addr_t))));
+
+		Worker &_worker(unsigned i) { return *(Worker *)_workers[i]; }
+
+		/**
+		 * Return number of workers, one less than the available CPUs
+		 */
+		static unsigned _num_workers()
+		{
+			unsigned const cpus =
+				Genode::env()->cpu_session()->affinity_space().total();
+
+			return Genode::min(cpus ? cpus - 1 : 0, (unsigned)MAX_WORKERS);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param base  pixel buffer drawn by the workers
+		 * \param size  size of the pixel buffer
+		 */
+		Draw_pool(PT *base, Area size) : _count(_num_workers())
+		{
+			Genode::Affinity::Space space =
+				Genode::env()->cpu_session()->affinity_space();
+
+			/* leave the first CPU to the caller */
+			for (unsigned i = 0; i < _count; i++)
+				Genode::construct_at<Worker>(_workers[i], base, size, _done,
+				                             space.location_of_index(i + 1));
+		}
+
+		~Draw_pool()
+		{
+			for (unsigned i = 0; i < _count; i++)
+				_worker(i).~Worker();
+		}
+
+		/**
+		 * Draw 'rect' of the view stack, return when finished
+		 *
+		 * \param canvas  canvas of the caller, referring to the same pixel
+		 *                buffer as the workers
+		 */
+		void draw(View_stack const &view_stack, Canvas_base &canvas, Rect rect)
+		{
+			unsigned const tiles =
+				Genode::max(1U, Genode::min(_count + 1,
+				                            rect.h() / MIN_TILE_HEIGHT));
+
+			int const tile_h = rect.h() / tiles;
+
+			/* hand out all tiles but the last one to the workers */
+			for (unsigned i = 0; i + 1 < tiles; i++) {
+				Worker &worker = _worker(i);
+				worker.view_stack = &view_stack;
+				worker.tile = Rect(Point(rect.x1(), rect.y1() + i*tile_h),
+				                   Area(rect.w(), tile_h));
+				worker.pending.up();
+			}
+
+			/* draw the last tile, which covers the rounding remainder */
+			view_stack.draw_rect(canvas,
+			                     Rect(Point(rect.x1(), rect.y1() + (tiles - 1)*tile_h),
+			                          rect.p2()));
+
+			for (unsigned i = 0; i + 1 < tiles; i++)
+				_done.down();
+		}
+};
+
+#endif /* _DRAW_POOL_H_ */
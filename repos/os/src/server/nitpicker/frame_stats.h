@@ -0,0 +1,119 @@
+/*
+ * \brief  Timing of the frames composed by nitpicker
+ * \author Norman Feske
+ * \date   2015-12-23
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _FRAME_STATS_H_
+#define _FRAME_STATS_H_
+
+/* Genode includes */
+#include <util/misc_math.h>
+#include <util/xml_generator.h>
+#include <trace/timestamp.h>
+
+
+/**
+ * Statistics of the frames of one report period
+ *
+ * A frame corresponds to one invocation of the periodic input handler.
+ * The compose time spans the drawing of the dirty areas and the refresh of
+ * the framebuffer. The input-to-flush latency is accounted for frames that
+ * processed user input and spans from the import of the input events until
+ * the framebuffer got refreshed. It does not include the time the events
+ * waited for the input handler, which is up to one sync period of the
+ * framebuffer.
+ */
+struct Frame_stats
+{
+	typedef Genode::uint64_t uint64_t;
+
+	struct Cycles
+	{
+		unsigned count = 0;
+		uint64_t sum   = 0;
+		uint64_t max   = 0;
+
+		void add(uint64_t cycles)
+		{
+			count++;
+			sum += cycles;
+			max  = Genode::max(max, cycles);
+		}
+	};
+
+	unsigned frames = 0;
+	uint64_t pixels = 0;  /* flushed pixels */
+	unsigned rects  = 0;  /* flushed rectangles */
+
+	Cycles compose, input_to_flush;
+
+	/* cycles elapsed during the report period */
+	uint64_t cycles = 0;
+
+	Genode::Trace::Timestamp last_ts = Genode::Trace::timestamp();
+
+	/**
+	 * Account cycles elapsed since the last call
+	 *
+	 * The function must be called at least once per wrap-around of the
+	 * cycle counter, i.e., each frame.
+	 */
+	void update_cycles()
+	{
+		Genode::Trace::Timestamp const ts = Genode::Trace::timestamp();
+
+		cycles += (Genode::Trace::Timestamp)(ts - last_ts);
+		last_ts = ts;
+	}
+
+	void flushed(unsigned w, unsigned h)
+	{
+		pixels += (uint64_t)w*h;
+		rects++;
+	}
+
+	void reset()
+	{
+		Genode::Trace::Timestamp const ts = last_ts;
+
+		*this   = Frame_stats();
+		last_ts = ts;
+	}
+
+	/**
+	 * Generate report of the period that took 'ms' milliseconds
+	 */
+	void report(Genode::Xml_generator &xml, unsigned long ms) const
+	{
+		uint64_t const cycles_per_ms = ms ? cycles/ms : 0;
+
+		auto us = [&] (uint64_t cycles) -> unsigned long long {
+			return cycles_per_ms ? (cycles*1000)/cycles_per_ms : 0; };
+
+		auto generate = [&] (char const *node, Cycles const &c) {
+			xml.node(node, [&] () {
+				xml.attribute("count",   c.count);
+				xml.attribute("mean_us", us(c.count ? c.sum/c.count : 0));
+				xml.attribute("max_us",  us(c.max));
+			});
+		};
+
+		xml.attribute("elapsed_ms", ms);
+		xml.attribute("frames",     frames);
+		xml.attribute("pixels",     (unsigned long long)pixels);
+		xml.attribute("rects",      rects);
+
+		generate("compose",        compose);
+		generate("input_to_flush", input_to_flush);
+	}
+};
+
+#endif /* _FRAME_STATS_H_ */
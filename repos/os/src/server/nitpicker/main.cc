@@ -38,6 +38,8 @@
 #include "clip_guard.h"
 #include "pointer_origin.h"
 #include "domain_registry.h"
+#include "draw_pool.h"
+#include "frame_stats.h"
 
 namespace Input       { class Session_component; }
 namespace Framebuffer { class Session_component; }
@@ -450,11 +452,20 @@ class Nitpicker::Session_component : public Genode::Rpc_object<Session>,
 
 		Genode::Reporter &_focus_reporter;
 
+		/* true while the framebuffer driver scans out the client buffer */
+		bool _scanout = false;
+
+		/* true if the driver refused to scan out the current buffer */
+		bool _scanout_declined = false;
+
 		void _release_buffer()
 		{
 			if (!::Session::texture())
 				return;
 
+			/* the driver must not access the buffer after its release */
+			stop_scanout();
+
 			typedef Pixel_rgb565 PT;
 
 			/* retrieve pointer to texture from session */
@@ -712,6 +723,46 @@ class Nitpicker::Session_component : public Genode::Rpc_object<Session>,
 
 		void upgrade_ram_quota(size_t ram_quota) { _session_alloc.upgrade(ram_quota); }
 
+		/**
+		 * Let the framebuffer driver display the client buffer directly
+		 *
+		 * The caller must ensure that the buffer makes up the whole screen,
+		 * see 'View_stack::fullscreen_session'.
+		 *
+		 * \return  true if the driver scans out the buffer
+		 */
+		bool start_scanout()
+		{
+			if (_scanout || _scanout_declined || !_buffer_size)
+				return _scanout;
+
+			typedef Pixel_rgb565 PT;
+
+			Chunky_dataspace_texture<PT> const *cdt =
+				static_cast<Chunky_dataspace_texture<PT> const *>(::Session::texture());
+
+			_scanout          = _framebuffer.scanout(cdt->ds_cap());
+			_scanout_declined = !_scanout;
+			return _scanout;
+		}
+
+		/**
+		 * Revert the framebuffer driver to nitpicker's screen buffer
+		 */
+		void stop_scanout()
+		{
+			if (!_scanout)
+				return;
+
+			_framebuffer.scanout(Genode::Dataspace_capability());
+			_scanout = false;
+
+			/* the screen buffer is outdated */
+			_view_stack.update_all_views();
+		}
+
+		bool scanout() const { return _scanout; }
+
 
 		/**********************************
 		 ** Nitpicker-internal interface **
@@ -999,6 +1050,8 @@ class Nitpicker::Session_component : public Genode::Rpc_object<Session>,
 			::Session::texture(texture, use_alpha);
 			::Session::input_mask(texture->input_mask_buffer());
 
+			_scanout_declined = false;
+
 			return texture;
 		}
 };
@@ -1121,6 +1174,8 @@ struct Nitpicker::Main
 
 		Screen<PT> screen = { fb_ds.local_addr<PT>(), Area(mode.width(), mode.height()) };
 
+		Draw_pool<PT> draw_pool = { fb_ds.local_addr<PT>(), screen.size() };
+
 		/**
 		 * Constructor
 		 */
@@ -1165,6 +1220,22 @@ struct Nitpicker::Main
 	Genode::Reporter hover_reporter   = { "hover" };
 	Genode::Reporter focus_reporter   = { "focus" };
 
+	/*
+	 * Timing of the composed frames, enabled via '<report frame_time="yes"/>'
+	 */
+	Genode::Reporter frame_time_reporter = { "frame_time" };
+
+	Frame_stats frame_stats;
+
+	/**
+	 * Number of frames per frame-time report
+	 */
+	unsigned frame_time_period = 100;
+
+	unsigned long frame_time_start_ms = 0;
+
+	void report_frame_time();
+
 	Root<PT> np_root = { session_list, *domain_registry, global_keys,
 	                     ep.rpc_ep(), user_state, user_state, pointer_origin,
 	                     sliced_heap, framebuffer, focus_reporter };
@@ -1216,14 +1287,44 @@ struct Nitpicker::Main
 	 */
 	bool user_active = false;
 
+	/**
+	 * Scan out the buffer of a fullscreen client instead of copying it
+	 *
+	 * \return  true if the screen content is scanned out from a client
+	 *          buffer
+	 */
+	bool update_scanout()
+	{
+		::Session const * const fullscreen = user_state.fullscreen_session();
+
+		/* revoke the scanout of a former fullscreen client first */
+		Session_component *candidate = nullptr;
+		for (::Session *s = session_list.first(); s; s = s->next()) {
+			Session_component *sc = dynamic_cast<Session_component *>(s);
+			if (!sc)
+				continue;
+
+			if (s == fullscreen)
+				candidate = sc;
+			else
+				sc->stop_scanout();
+		}
+		return candidate && candidate->start_scanout();
+	}
+
 	/**
 	 * Perform redraw and flush pixels to the framebuffer
 	 */
 	void draw_and_flush()
 	{
-		user_state.draw(fb_screen->screen).flush([&] (Rect const &rect) {
-			framebuffer.refresh(rect.x1(), rect.y1(),
-			                    rect.w(),  rect.h()); });
+		auto refresh_fn = [&] (Rect const &rect) {
+			frame_stats.flushed(rect.w(), rect.h());
+			framebuffer.refresh(rect.x1(), rect.y1(), rect.w(), rect.h()); };
+
+		if (update_scanout())
+			user_state.skip_drawing().flush(refresh_fn);
+		else
+			user_state.draw(fb_screen->screen, fb_screen->draw_pool).flush(refresh_fn);
 	}
 
 	Main(Server::Entrypoint &ep) : ep(ep)
@@ -1247,13 +1348,18 @@ void Nitpicker::Main::handle_input(unsigned)
 {
 	period_cnt++;
 
+	bool const profile = frame_time_reporter.is_enabled();
+
+	Genode::Trace::Timestamp const input_ts = profile ? Genode::Trace::timestamp() : 0;
+
 	Point       const old_pointer_pos     = user_state.pointer_pos();
 	::Session * const old_pointed_session = user_state.pointed_session();
 	::Session * const old_focused_session = user_state.Mode::focused_session();
 	bool        const old_user_active     = user_active;
 
 	/* handle batch of pending events */
-	if (import_input_events(ev_buf, input.flush(), user_state)) {
+	bool const input_pending = import_input_events(ev_buf, input.flush(), user_state);
+	if (input_pending) {
 		last_active_period = period_cnt;
 		user_active        = true;
 	}
@@ -1297,9 +1403,28 @@ void Nitpicker::Main::handle_input(unsigned)
 		user_state.geometry(pointer_origin, Rect(new_pointer_pos, Area()));
 
 	/* perform redraw and flush pixels to the framebuffer */
-	user_state.draw(fb_screen->screen).flush([&] (Rect const &rect) {
-		framebuffer.refresh(rect.x1(), rect.y1(),
-		                    rect.w(),  rect.h()); });
+	if (profile) {
+		Genode::Trace::Timestamp const compose_ts = Genode::Trace::timestamp();
+		unsigned const rects = frame_stats.rects;
+
+		draw_and_flush();
+
+		Genode::Trace::Timestamp const flush_ts = Genode::Trace::timestamp();
+
+		if (frame_stats.rects != rects)
+			frame_stats.compose.add((Genode::Trace::Timestamp)(flush_ts - compose_ts));
+
+		if (input_pending)
+			frame_stats.input_to_flush.add((Genode::Trace::Timestamp)(flush_ts - input_ts));
+
+		frame_stats.frames++;
+		frame_stats.update_cycles();
+
+		if (frame_stats.frames >= frame_time_period)
+			report_frame_time();
+	} else {
+		draw_and_flush();
+	}
 
 	user_state.mark_all_views_as_clean();
 
@@ -1309,6 +1434,18 @@ void Nitpicker::Main::handle_input(unsigned)
 }
 
 
+void Nitpicker::Main::report_frame_time()
+{
+	unsigned long const now_ms = timer.elapsed_ms();
+
+	Genode::Reporter::Xml_generator xml(frame_time_reporter, [&] () {
+		frame_stats.report(xml, now_ms - frame_time_start_ms); });
+
+	frame_time_start_ms = now_ms;
+	frame_stats.reset();
+}
+
+
 /**
  * Helper function for 'handle_config'
  */
@@ -1349,6 +1486,21 @@ void Nitpicker::Main::handle_config(unsigned)
 	configure_reporter(hover_reporter);
 	configure_reporter(focus_reporter);
 
+	/* restart the frame-time accounting with the new configuration */
+	bool const frame_time_enabled = frame_time_reporter.is_enabled();
+	configure_reporter(frame_time_reporter);
+	if (frame_time_reporter.is_enabled() && !frame_time_enabled) {
+		frame_stats.update_cycles();
+		frame_stats.reset();
+		frame_time_start_ms = timer.elapsed_ms();
+	}
+
+	try {
+		config()->xml_node().sub_node("report")
+		.attribute("frame_time_period").value(&frame_time_period);
+	} catch (...) { }
+	frame_time_period = Genode::max(frame_time_period, 1U);
+
 	/* update domain registry and session policies */
 	for (::Session *s = session_list.first(); s; s = s->next())
 		s->reset_domain();
@@ -1375,6 +1527,13 @@ void Nitpicker::Main::handle_config(unsigned)
 
 void Nitpicker::Main::handle_fb_mode(unsigned)
 {
+	/* the driver reverts to its own buffer on mode changes */
+	for (::Session *s = session_list.first(); s; s = s->next()) {
+		Session_component *sc = dynamic_cast<Session_component *>(s);
+		if (sc)
+			sc->stop_scanout();
+	}
+
 	/* reconstruct framebuffer screen and menu bar */
 	fb_screen.construct(framebuffer);
 
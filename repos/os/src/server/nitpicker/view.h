@@ -18,6 +18,7 @@
 #include <util/string.h>
 #include <util/list.h>
 #include <util/dirty_rect.h>
+#include <util/dirty_region.h>
 #include <base/weak_ptr.h>
 #include <base/rpc_server.h>
 
@@ -32,6 +33,7 @@ extern Framebuffer::Session *tmp_fb;
 
 
 typedef Genode::Dirty_rect<Rect, 3> Dirty_rect;
+typedef Genode::Dirty_region<Rect, 16> Dirty_region;
 
 
 /*
@@ -213,6 +213,54 @@ void View_stack::draw_rec(Canvas_base &canvas, View const *view, Rect rect) cons
 }
 
 
+bool View_stack::_occluded(View const &view, Rect rect) const
+{
+	/* traverse the views in front of 'view' in the order they are drawn */
+	for (View const *v = _first_view_const(); v && v != &view; v = _next_view(*v)) {
+
+		if (v->uses_alpha())
+			continue;
+
+		Rect const outline = _outline(*v);
+		if (outline.contains(rect.p1()) && outline.contains(rect.p2()))
+			return true;
+	}
+	return false;
+}
+
+
+Session const *View_stack::fullscreen_session() const
+{
+	Rect const screen(Point(), _size);
+
+	/* find front-most view that appears on screen */
+	View const *view = _first_view_const();
+	while (view && !Rect::intersect(_outline(*view), screen).valid())
+		view = _next_view(*view);
+
+	if (!view || view->transparent())
+		return nullptr;
+
+	Session const &session = view->session();
+
+	Rect const outline = _outline(*view);
+	if (!outline.contains(screen.p1()) || !outline.contains(screen.p2()))
+		return nullptr;
+
+	/* buffer must match the screen pixel by pixel */
+	if (!session.texture() || session.texture()->size() != _size
+	 || view->abs_position() + view->buffer_off() != Point(0, 0))
+		return nullptr;
+
+	/* view must be drawn untinted and without label */
+	if (session.label_visible()
+	 || !(session.content_client() || session.has_same_domain(_mode.focused_session())))
+		return nullptr;
+
+	return &session;
+}
+
+
 void View_stack::refresh_view(View &view, Rect const rect)
 {
 	/* rectangle constrained to view geometry */
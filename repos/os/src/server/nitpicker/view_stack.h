@@ -28,7 +28,7 @@ class View_stack
 		Mode                          &_mode;
 		Genode::List<View_stack_elem>  _views;
 		View                          *_default_background = nullptr;
-		Dirty_rect mutable             _dirty_rect;
+		Dirty_region mutable           _dirty_region;
 
 		/**
 		 * Return outline geometry of a view
@@ -70,12 +70,18 @@ class View_stack
 		template <typename VIEW>
 		VIEW *_next_view(VIEW &view) const;
 
+		/**
+		 * Return true if 'rect' is hidden behind an opaque view in front of
+		 * 'view'
+		 */
+		bool _occluded(View const &view, Rect rect) const;
+
 		/**
 		 * Schedule 'rect' to be redrawn
 		 */
 		void _mark_view_as_dirty(View &view, Rect rect)
 		{
-			_dirty_rect.mark_as_dirty(rect);
+			_dirty_region.mark_as_dirty(rect);
 
 			view.mark_as_dirty(rect);
 		}
@@ -87,7 +93,7 @@ class View_stack
 		 */
 		View_stack(Area size, Mode &mode) : _size(size), _mode(mode)
 		{
-			_dirty_rect.mark_as_dirty(Rect(Point(0, 0), _size));
+			_dirty_region.mark_as_dirty(Rect(Point(0, 0), _size));
 		}
 
 		/**
@@ -112,16 +118,63 @@ class View_stack
 		/**
 		 * Draw dirty areas
 		 */
-		Dirty_rect draw(Canvas_base &canvas) const
+		Dirty_region draw(Canvas_base &canvas) const
 		{
-			Dirty_rect result = _dirty_rect;
+			Dirty_region result = _dirty_region;
 
-			_dirty_rect.flush([&] (Rect const &rect) {
+			_dirty_region.flush([&] (Rect const &rect) {
 				draw_rec(canvas, _first_view_const(), rect); });
 
 			return result;
 		}
 
+		/**
+		 * Draw dirty areas with the help of the threads of 'pool'
+		 */
+		template <typename POOL>
+		Dirty_region draw(Canvas_base &canvas, POOL &pool) const
+		{
+			Dirty_region result = _dirty_region;
+
+			_dirty_region.flush([&] (Rect const &rect) {
+				pool.draw(*this, canvas, rect); });
+
+			return result;
+		}
+
+		/**
+		 * Reset dirty areas without drawing them
+		 *
+		 * This is used while the screen content is scanned out from the
+		 * buffer of a client.
+		 */
+		Dirty_region skip_drawing() const
+		{
+			Dirty_region result = _dirty_region;
+
+			_dirty_region.flush([&] (Rect const &) { });
+
+			return result;
+		}
+
+		/**
+		 * Draw all views within 'rect'
+		 */
+		void draw_rect(Canvas_base &canvas, Rect rect) const {
+			draw_rec(canvas, _first_view_const(), rect); }
+
+		/**
+		 * Return session whose buffer makes up the whole screen
+		 *
+		 * The result is valid if the front-most view covers the screen,
+		 * displays its buffer one-to-one, and is drawn neither blended,
+		 * tinted, nor labeled. In this case, the screen content equals the
+		 * session's buffer, which can thereby be scanned out directly.
+		 *
+		 * \return  session, or a null pointer if no such session exists
+		 */
+		Session const *fullscreen_session() const;
+
 		/**
 		 * Trigger redraw of the whole view stack
 		 */
@@ -130,7 +183,7 @@ class View_stack
 			Rect const whole_screen(Point(), _size);
 
 			_place_labels(whole_screen);
-			_dirty_rect.mark_as_dirty(whole_screen);
+			_dirty_region.mark_as_dirty(whole_screen);
 
 			for (View *view = _first_view(); view; view = view->view_stack_next())
 				view->mark_as_dirty(_outline(*view));
@@ -168,6 +221,10 @@ class View_stack
 				                                    rect.p2() + offset),
 				                               view->abs_geometry());
 
+				/* changes of hidden view portions do not become visible */
+				if (!r.valid() || _occluded(*view, r))
+					continue;
+
 				refresh_view(*view, r);
 			}
 		}
@@ -18,6 +18,7 @@
 #include <base/exception.h>
 #include <root/component.h>
 #include <block_session/rpc_object.h>
+#include <block_session/connection.h>
 
 #include "gpt.h"
 
@@ -25,22 +26,44 @@ namespace Block {
 
 	using namespace Genode;
 
+	struct Backend_session;
 	class Session_component;
 	class Root;
 };
 
 
+/**
+ * Dedicated backend session of a client in zero-copy mode
+ *
+ * The transmission buffer of this session is handed out to the client as
+ * its own buffer. Thereby, the client places its payload directly into
+ * memory shared with the backend device. The packet allocator stays unused
+ * because the client manages the buffer layout.
+ */
+struct Block::Backend_session
+{
+	Allocator_avl     alloc;
+	Block::Connection connection;
+
+	Backend_session(size_t tx_buf_size, char const *label)
+	: alloc(env()->heap()), connection(&alloc, tx_buf_size, label) { }
+};
+
+
 class Block::Session_component : public Block::Session_rpc_object,
                                  public List<Block::Session_component>::Element,
                                  public Block_dispatcher
 {
 	private:
 
-		Ram_dataspace_capability             _rq_ds;
+		Dataspace_capability                 _rq_ds;
 		addr_t                               _rq_phys;
 		Partition                           *_partition;
+		Backend_session                     *_backend;
 		Signal_dispatcher<Session_component> _sink_ack;
 		Signal_dispatcher<Session_component> _sink_submit;
+		Signal_dispatcher<Session_component> _backend_ack;
+		Signal_dispatcher<Session_component> _backend_submit;
 		bool                                 _req_queue_full;
 		bool                                 _ack_queue_full;
 		Packet_descriptor                    _p_to_handle;
@@ -62,7 +85,8 @@ class Block::Session_component : public Block::Session_rpc_object,
 		 * Range check packet request
 		 */
 		inline bool _range_check(Packet_descriptor &p) {
-			return p.block_number() + p.block_count() <= _partition->sectors; }
+			return p.operation() == Packet_descriptor::FLUSH ||
+			       p.block_number() + p.block_count() <= _partition->sectors; }
 
 		/**
 		 * Handle a single request
@@ -78,12 +102,24 @@ class Block::Session_component : public Block::Session_rpc_object,
 				return;
 			}
 
-			bool write   = _p_to_handle.operation() == Packet_descriptor::WRITE;
+			Packet_descriptor::Opcode op = _p_to_handle.operation();
 			sector_t off = _p_to_handle.block_number() + _partition->lba;
 			size_t cnt   = _p_to_handle.block_count();
+
+			/* translate block number only, payload stays where it is */
+			if (_backend) {
+				Session::Tx::Source &src = *_backend->connection.tx();
+				if (!src.ready_to_submit()) {
+					_req_queue_full = true;
+					return;
+				}
+				src.submit_packet(Packet_descriptor(_p_to_handle, op, off, cnt));
+				return;
+			}
+
 			void* addr   = tx_sink()->packet_content(_p_to_handle);
 			try {
-				Driver::driver().io(write, off, cnt, addr, *this, _p_to_handle);
+				Driver::driver().io(op, off, cnt, addr, *this, _p_to_handle);
 			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
 				_req_queue_full = true;
 				Session_component::wait_queue().insert(this);
@@ -113,30 +149,79 @@ class Block::Session_component : public Block::Session_rpc_object,
 		 */
 		void _ready_to_ack(unsigned) { _packet_avail(0); }
 
+		/**
+		 * Forward acknowledgements of the dedicated backend session
+		 */
+		void _backend_ack_avail(unsigned)
+		{
+			Session::Tx::Source &src = *_backend->connection.tx();
+			while (src.ack_avail()) {
+				Packet_descriptor p = src.get_acked_packet();
+				Packet_descriptor reply(p, p.operation(),
+				                        p.block_number() - _partition->lba,
+				                        p.block_count());
+				reply.succeeded(p.succeeded());
+
+				/* the client owns the buffer, there is nothing to release */
+				_ack_packet(reply);
+			}
+
+			_backend_ready_to_submit(0);
+		}
+
+		/**
+		 * Resume handling of requests once the backend queue has space
+		 */
+		void _backend_ready_to_submit(unsigned)
+		{
+			if (_req_queue_full) {
+				_req_queue_full = false;
+				_handle_packet(_p_to_handle);
+				if (_req_queue_full)
+					return;
+			}
+			_packet_avail(0);
+		}
+
 	public:
 
 		/**
 		 * Constructor
+		 *
+		 * \param backend  dedicated backend session in zero-copy mode, its
+		 *                 transmission buffer replaces 'rq_ds'
 		 */
-		Session_component(Ram_dataspace_capability  rq_ds,
+		Session_component(Dataspace_capability      rq_ds,
 		                  Partition                *partition,
 		                  Rpc_entrypoint           &ep,
-		                  Signal_receiver          &receiver)
-		: Session_rpc_object(rq_ds, ep),
-		  _rq_ds(rq_ds),
+		                  Signal_receiver          &receiver,
+		                  Backend_session          *backend = 0)
+		: Session_rpc_object(backend ? backend->connection.tx()->dataspace()
+		                             : rq_ds, ep),
+		  _rq_ds(backend ? backend->connection.tx()->dataspace() : rq_ds),
 		  _rq_phys(Dataspace_client(_rq_ds).phys_addr()),
 		  _partition(partition),
+		  _backend(backend),
 		  _sink_ack(receiver, *this, &Session_component::_ready_to_ack),
 		  _sink_submit(receiver, *this, &Session_component::_packet_avail),
+		  _backend_ack(receiver, *this, &Session_component::_backend_ack_avail),
+		  _backend_submit(receiver, *this,
+		                  &Session_component::_backend_ready_to_submit),
 		  _req_queue_full(false),
 		  _ack_queue_full(false),
 		  _p_in_fly(0)
 		{
 			_tx.sigh_ready_to_ack(_sink_ack);
 			_tx.sigh_packet_avail(_sink_submit);
+
+			if (_backend) {
+				_backend->connection.tx_channel()->sigh_ack_avail(_backend_ack);
+				_backend->connection.tx_channel()->sigh_ready_to_submit(_backend_submit);
+			}
 		}
 
-		Partition *partition() { return _partition; }
+		Partition       *partition() { return _partition; }
+		Backend_session *backend()   { return _backend;   }
 
 		void dispatch(Packet_descriptor &request, Packet_descriptor &reply)
 		{
@@ -183,7 +268,24 @@ class Block::Session_component : public Block::Session_rpc_object,
 			*ops = Driver::driver().ops();
 		}
 
-		void sync() { Driver::driver().session().sync(); }
+		Transfer_info transfer_info()
+		{
+			Transfer_info info = Driver::driver().transfer_info();
+
+			/* the alignment is relative to the start of the partition */
+			Genode::uint64_t const offset = (Genode::uint64_t)_partition->lba *
+			                                Driver::driver().blk_size();
+			while (info.align_log2 && (offset & ((1ULL << info.align_log2) - 1)))
+				info.align_log2--;
+
+			return info;
+		}
+
+		void sync()
+		{
+			if (_backend) _backend->connection.sync();
+			else          Driver::driver().session().sync();
+		}
 };
 
 
@@ -198,6 +300,7 @@ class Block::Root :
 		Rpc_entrypoint         &_ep;
 		Signal_receiver        &_receiver;
 		Block::Partition_table &_table;
+		bool const              _zero_copy;
 
 	protected:
 
@@ -241,6 +344,10 @@ class Block::Root :
 			size_t session_size = max((size_t)4096,
 			                          sizeof(Session_component)
 			                          + sizeof(Allocator_avl));
+
+			/* the dedicated backend session demands quota on its own */
+			if (_zero_copy)
+				session_size += sizeof(Backend_session) + 3*4096;
 			if (ram_quota < session_size)
 				throw Root::Quota_exceeded();
 
@@ -255,6 +362,23 @@ class Block::Root :
 				throw Root::Quota_exceeded();
 			}
 
+			if (_zero_copy) {
+				Backend_session *backend = 0;
+				try {
+					backend = new (env()->heap())
+						Backend_session(tx_buf_size, label_str);
+				} catch (Parent::Service_denied) {
+					PERR("backend session for '%s' denied", label_str);
+					throw Root::Unavailable();
+				}
+				PLOG("zero-copy session opened at partition %ld for '%s'",
+				     num, label_str);
+				return new (md_alloc())
+					Session_component(Dataspace_capability(),
+					                  _table.partition(num),
+					                  _ep, _receiver, backend);
+			}
+
 			Ram_dataspace_capability ds_cap;
 			ds_cap = Genode::env()->ram_session()->alloc(tx_buf_size);
 			Session_component *session = new (md_alloc())
@@ -266,15 +390,32 @@ class Block::Root :
 			return session;
 		}
 
+		void _destroy_session(Session_component *session)
+		{
+			/* the client's buffer vanishes with the backend session */
+			Backend_session *backend = session->backend();
+			destroy(md_alloc(), session);
+			if (backend)
+				destroy(env()->heap(), backend);
+		}
+
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param zero_copy  open a dedicated backend session per client,
+		 *                   whose buffer is shared with the client
+		 */
 		Root(Rpc_entrypoint *session_ep, Allocator *md_alloc,
-		     Signal_receiver &receiver, Block::Partition_table& table)
+		     Signal_receiver &receiver, Block::Partition_table& table,
+		     bool zero_copy = false)
 		:
 			Root_component(session_ep, md_alloc),
 			_ep(*session_ep),
 			_receiver(receiver),
-			_table(table)
+			_table(table),
+			_zero_copy(zero_copy)
 		{ }
 };
 
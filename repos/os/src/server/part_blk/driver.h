@@ -73,7 +73,10 @@ class Block::Driver
 
 	private:
 
-		enum { BLK_SZ = Session::TX_QUEUE_SIZE*sizeof(Request) };
+		enum {
+			BLK_SZ      = Session::TX_QUEUE_SIZE*sizeof(Request),
+			TX_BUF_SIZE = 4 * 1024 * 1024
+		};
 
 		Genode::Tslab<Request, BLK_SZ>    _r_slab;
 		Genode::List<Request>             _r_list;
@@ -84,6 +87,7 @@ class Block::Driver
 		Genode::Signal_dispatcher<Driver> _source_ack;
 		Genode::Signal_dispatcher<Driver> _source_submit;
 		Block::Session::Operations        _ops;
+		Block::Session::Transfer_info     _transfer;
 
 		void _ready_to_submit(unsigned);
 
@@ -110,16 +114,22 @@ class Block::Driver
 		Driver(Genode::Signal_receiver &receiver)
 		: _r_slab(Genode::env()->heap()),
 		  _block_alloc(Genode::env()->heap()),
-		  _session(&_block_alloc, 4 * 1024 * 1024),
+		  _session(&_block_alloc, TX_BUF_SIZE),
 		  _source_ack(receiver, *this, &Driver::_ack_avail),
 		  _source_submit(receiver, *this, &Driver::_ready_to_submit)
 		{
 			_session.info(&_blk_cnt, &_blk_size, &_ops);
+			_transfer = _session.transfer_info();
+
+			/* requests are staged in our own transmission buffer */
+			if (!_transfer.max_transfer || _transfer.max_transfer > TX_BUF_SIZE)
+				_transfer.max_transfer = TX_BUF_SIZE;
 		}
 
 		Genode::size_t blk_size() { return _blk_size; }
 		Genode::size_t blk_cnt()  { return _blk_cnt;  }
 		Session::Operations ops() { return _ops; }
+		Session::Transfer_info transfer_info() { return _transfer; }
 		Session_client& session() { return _session;  }
 
 		void work_asynchronously()
@@ -130,22 +140,23 @@ class Block::Driver
 
 		static Driver& driver();
 
-		void io(bool write, sector_t nr, Genode::size_t cnt, void* addr,
+		void io(Packet_descriptor::Opcode op, sector_t nr,
+		        Genode::size_t cnt, void* addr,
 		        Block_dispatcher &dispatcher, Packet_descriptor& cli)
 		{
 			if (!_session.tx()->ready_to_submit())
 				throw Block::Session::Tx::Source::Packet_alloc_failed();
 
-			Block::Packet_descriptor::Opcode op = write
-			    ? Block::Packet_descriptor::WRITE
-			    : Block::Packet_descriptor::READ;
-			Genode::size_t size = _blk_size * cnt;
+			/* trim and flush carry no payload, but need a valid packet */
+			bool const data = op == Packet_descriptor::READ ||
+			                  op == Packet_descriptor::WRITE;
+			Genode::size_t size = data ? _blk_size * cnt : _blk_size;
 			Packet_descriptor p(_session.dma_alloc_packet(size),
 			                    op,  nr, cnt);
 			Request *r = new (&_r_slab) Request(dispatcher, cli, p);
 			_r_list.insert(r);
 
-			if (write)
+			if (op == Packet_descriptor::WRITE)
 				Genode::memcpy(_session.tx()->packet_content(p),
 				               addr, size);
 
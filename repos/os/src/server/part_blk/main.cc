@@ -45,6 +45,16 @@ static bool _use_gpt()
 }
 
 
+static bool _zero_copy()
+{
+	try {
+		return Genode::config()->xml_node().attribute("zero_copy").has_value("yes");
+	} catch(...) { }
+
+	return false;
+}
+
+
 int main()
 {
 	using namespace Genode;
@@ -81,7 +91,7 @@ int main()
 	static Cap_connection cap;
 	static Rpc_entrypoint ep(&cap, STACK_SIZE, "part_ep");
 	static Block::Root block_root(&ep, env()->heap(), receiver,
-	                              *partition_table);
+	                              *partition_table, _zero_copy());
 
 	env()->parent()->announce(ep.manage(&block_root));
 
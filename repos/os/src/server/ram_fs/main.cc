@@ -12,6 +12,8 @@
  */
 
 /* Genode includes */
+#include <base/signal.h>
+#include <base/thread.h>
 #include <file_system/node_handle_registry.h>
 #include <file_system_session/rpc_object.h>
 #include <root/component.h>
@@ -33,14 +35,68 @@ namespace File_system {
 
 	class Session_component : public Session_rpc_object
 	{
+		public:
+
+			enum { PACKET_STACK_SIZE = 2048*sizeof(long) };
+
 		private:
 
-			Server::Entrypoint   &_ep;
+			/**
+			 * Thread that processes the packet stream of the session
+			 *
+			 * The RPC functions of all sessions are served by the
+			 * entrypoint of the server. Read and write operations, however,
+			 * are executed by a thread per session such that independent
+			 * clients can access their files in parallel. Nodes are
+			 * protected by their individual locks.
+			 */
+			struct Packet_thread : Thread<PACKET_STACK_SIZE>
+			{
+				Session_component &session;
+
+				Signal_receiver sig_rec;
+				Signal_context  packet_ctx;
+				Signal_context  exit_ctx;
+
+				Signal_context_capability const packet_cap = sig_rec.manage(&packet_ctx);
+				Signal_context_capability const exit_cap   = sig_rec.manage(&exit_ctx);
+
+				Packet_thread(Session_component &session)
+				: Thread<PACKET_STACK_SIZE>("ram_fs_packet"), session(session) { }
+
+				~Packet_thread()
+				{
+					sig_rec.dissolve(&packet_ctx);
+					sig_rec.dissolve(&exit_ctx);
+				}
+
+				void entry()
+				{
+					for (;;) {
+						Signal signal = sig_rec.wait_for_signal();
+
+						if (signal.context() == &exit_ctx)
+							return;
+
+						session._process_packets(signal.num());
+					}
+				}
+
+				/**
+				 * Terminate thread after completing the current packet
+				 */
+				void stop()
+				{
+					Signal_transmitter(exit_cap).submit();
+					join();
+				}
+			};
+
 			Directory            &_root;
 			Node_handle_registry  _handle_registry;
 			bool                  _writable;
 
-			Signal_rpc_member<Session_component> _process_packet_dispatcher;
+			Packet_thread _packet_thread;
 
 
 			/******************************
@@ -105,8 +161,8 @@ namespace File_system {
 			}
 
 			/**
-			 * Called by signal dispatcher, executed in the context of the main
-			 * thread (not serialized with the RPC functions)
+			 * Called by the packet thread of the session (not serialized
+			 * with the RPC functions)
 			 */
 			void _process_packets(unsigned)
 			{
@@ -120,9 +176,9 @@ namespace File_system {
 					 * processing until the client processed pending
 					 * acknowledgements and thereby emitted a ready-to-ack
 					 * signal. Otherwise, the call of 'acknowledge_packet()'
-					 * in '_process_packet' would infinitely block the context
-					 * of the main thread. The main thread is however needed
-					 * for receiving any subsequent 'ready-to-ack' signals.
+					 * in '_process_packet' would infinitely block the packet
+					 * thread. The packet thread is however needed for
+					 * receiving any subsequent 'ready-to-ack' signals.
 					 */
 					if (!tx_sink()->ready_to_ack())
 						return;
@@ -151,17 +207,18 @@ namespace File_system {
 			                  Directory &root, bool writable)
 			:
 				Session_rpc_object(env()->ram_session()->alloc(tx_buf_size), ep.rpc_ep()),
-				_ep(ep),
 				_root(root),
 				_writable(writable),
-				_process_packet_dispatcher(ep, *this, &Session_component::_process_packets)
+				_packet_thread(*this)
 			{
 				/*
-				 * Register '_process_packets' dispatch function as signal
-				 * handler for packet-avail and ready-to-ack signals.
+				 * Let the packet thread respond to packet-avail and
+				 * ready-to-ack signals.
 				 */
-				_tx.sigh_packet_avail(_process_packet_dispatcher);
-				_tx.sigh_ready_to_ack(_process_packet_dispatcher);
+				_tx.sigh_packet_avail(_packet_thread.packet_cap);
+				_tx.sigh_ready_to_ack(_packet_thread.packet_cap);
+
+				_packet_thread.start();
 			}
 
 			/**
@@ -169,6 +226,8 @@ namespace File_system {
 			 */
 			~Session_component()
 			{
+				_packet_thread.stop();
+
 				Dataspace_capability ds = tx_sink()->dataspace();
 				env()->ram_session()->free(static_cap_cast<Ram_dataspace>(ds));
 			}
@@ -408,6 +467,21 @@ namespace File_system {
 			{
 				_handle_registry.sigh(node_handle, sigh);
 			}
+
+			Dataspace_capability dataspace(File_handle file_handle)
+			{
+				/*
+				 * The dataspace cannot be protected against writes by the
+				 * client. Hence, only sessions that may modify the file
+				 * anyway obtain the dataspace.
+				 */
+				if (!_writable)
+					return Dataspace_capability();
+
+				File *file = _handle_registry.lookup_and_lock(file_handle);
+				Node_lock_guard file_guard(file);
+				return file->dataspace();
+			}
 	};
 
 
@@ -493,7 +567,8 @@ namespace File_system {
 				 * Check if donated ram quota suffices for session data,
 				 * and communication buffer.
 				 */
-				size_t session_size = sizeof(Session_component) + tx_buf_size;
+				size_t session_size = sizeof(Session_component) + tx_buf_size
+				                    + Session_component::PACKET_STACK_SIZE;
 				if (max((size_t)4096, session_size) > ram_quota) {
 					PERR("insufficient 'ram_quota', got %zd, need %zd",
 					     ram_quota, session_size);
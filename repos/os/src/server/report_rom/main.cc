@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -38,9 +38,10 @@ struct Server::Main
 
 	Rom::Registry rom_registry = { sliced_heap };
 
-	bool verbose = Genode::config()->xml_node().attribute_value("verbose", false);
+	bool verbose  = Genode::config()->xml_node().attribute_value("verbose",  false);
+	bool handover = Genode::config()->xml_node().attribute_value("handover", false);
 
-	Report::Root report_root = { ep, sliced_heap, rom_registry, verbose };
+	Report::Root report_root = { ep, sliced_heap, rom_registry, verbose, handover };
 	Rom   ::Root    rom_root = { ep, sliced_heap, rom_registry };
 
 	Main(Entrypoint &ep) : ep(ep)
@@ -32,6 +32,7 @@ namespace Rom_filter {
 	using Genode::size_t;
 
 	class  Output_buffer;
+	class  Observed_inputs;
 	class  Session_component;
 	class  Root;
 	struct Main;
@@ -50,6 +51,86 @@ struct Rom_filter::Output_buffer
 };
 
 
+/**
+ * Input values the output depends on
+ *
+ * While evaluating the output, each queried input value is recorded. On the
+ * change of an input ROM, the output needs to be re-evaluated only if one of
+ * the recorded values changed.
+ */
+class Rom_filter::Observed_inputs
+{
+	private:
+
+		struct Observed_input : Genode::List<Observed_input>::Element
+		{
+			Input_name  const name;
+			bool        const defined;
+			Input_value const value;
+
+			Observed_input(Input_name const &name, bool defined,
+			               Input_value const &value)
+			: name(name), defined(defined), value(value) { }
+		};
+
+		Genode::Allocator &_alloc;
+
+		Genode::List<Observed_input> _inputs;
+
+		bool _observed(Input_name const &name) const
+		{
+			for (Observed_input const *i = _inputs.first(); i; i = i->next())
+				if (i->name == name)
+					return true;
+
+			return false;
+		}
+
+	public:
+
+		Observed_inputs(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Observed_inputs() { clear(); }
+
+		void clear()
+		{
+			while (Observed_input *i = _inputs.first()) {
+				_inputs.remove(i);
+				Genode::destroy(_alloc, i);
+			}
+		}
+
+		void record(Input_name const &name, bool defined, Input_value const &value)
+		{
+			if (!_observed(name))
+				_inputs.insert(new (_alloc) Observed_input(name, defined, value));
+		}
+
+		/**
+		 * Return true if any of the recorded input values changed
+		 *
+		 * \param query_fn  functor called with the input name, returns the
+		 *                  current value or throws
+		 *                  'Input_rom_registry::Nonexistent_input_value'
+		 */
+		template <typename FN>
+		bool changed(FN const &query_fn) const
+		{
+			for (Observed_input const *i = _inputs.first(); i; i = i->next()) {
+				try {
+					if (!i->defined || query_fn(i->name) != i->value)
+						return true;
+				}
+				catch (Input_rom_registry::Nonexistent_input_value) {
+					if (i->defined)
+						return true;
+				}
+			}
+			return false;
+		}
+};
+
+
 class Rom_filter::Session_component : public Rpc_object<Genode::Rom_session>,
                                       public Session_list::Element
 {
@@ -157,10 +238,18 @@ struct Rom_filter::Main : Input_rom_registry::Input_rom_changed_fn,
 
 	Input_rom_registry _input_rom_registry { *env()->heap(), _ep, *this };
 
-	Genode::Lazy_volatile_object<Genode::Attached_ram_dataspace> _xml_ds;
+	/*
+	 * The output is generated into the back buffer and published only if it
+	 * differs from the content of the front buffer.
+	 */
+	Genode::Lazy_volatile_object<Genode::Attached_ram_dataspace> _xml_ds[2];
+
+	unsigned _front = 0;
 
 	size_t _xml_output_len = 0;
 
+	Observed_inputs _observed_inputs { *env()->heap() };
+
 	void _evaluate_node(Xml_node node, Xml_generator &xml);
 	void _evaluate();
 
@@ -180,8 +269,13 @@ struct Rom_filter::Main : Input_rom_registry::Input_rom_changed_fn,
 
 		xml_ds_size = Genode::config()->xml_node().attribute_value("buffer", xml_ds_size);
 
-		if (!_xml_ds.is_constructed() || xml_ds_size != _xml_ds->size())
-			_xml_ds.construct(env()->ram_session(), xml_ds_size);
+		if (!_xml_ds[0].is_constructed() || xml_ds_size != _xml_ds[0]->size()) {
+
+			for (unsigned i = 0; i < 2; i++)
+				_xml_ds[i].construct(env()->ram_session(), xml_ds_size);
+
+			_xml_output_len = 0;
+		}
 
 		/*
 		 * Obtain inputs
@@ -199,11 +293,18 @@ struct Rom_filter::Main : Input_rom_registry::Input_rom_changed_fn,
 	/**
 	 * Input_rom_registry::Input_rom_changed_fn interface
 	 *
-	 * Called each time one of the input ROM modules changes.
+	 * Called each time one of the input ROM modules changes. Changes of
+	 * input values that did not influence the output are ignored.
 	 */
 	void input_rom_changed() override
 	{
-		_evaluate();
+		Xml_node const config = Genode::config()->xml_node();
+
+		auto query_fn = [&] (Input_name const &name) {
+			return _input_rom_registry.query_value(config, name); };
+
+		if (_observed_inputs.changed(query_fn))
+			_evaluate();
 	}
 
 	/**
@@ -220,7 +321,7 @@ struct Rom_filter::Main : Input_rom_registry::Input_rom_changed_fn,
 	size_t export_content(char *dst, size_t dst_len) const
 	{
 		size_t const len = Genode::min(dst_len, _xml_output_len);
-		Genode::memcpy(dst, _xml_ds->local_addr<char>(), len);
+		Genode::memcpy(dst, _xml_ds[_front]->local_addr<char>(), len);
 		return len;
 	}
 
@@ -262,10 +363,13 @@ void Rom_filter::Main::_evaluate_node(Xml_node node, Xml_generator &xml)
 					Input_value const input_value =
 						_input_rom_registry.query_value(config, input_name);
 
+					_observed_inputs.record(input_name, true, input_value);
+
 					if (input_value == expected_input_value)
 						condition_satisfied = true;
 				}
 				catch (Input_rom_registry::Nonexistent_input_value) {
+					_observed_inputs.record(input_name, false, Input_value());
 					PWRN("could not obtain input value for input %s", input_name.string());
 				}
 			}
@@ -309,6 +413,8 @@ void Rom_filter::Main::_evaluate_node(Xml_node node, Xml_generator &xml)
 
 void Rom_filter::Main::_evaluate()
 {
+	_observed_inputs.clear();
+
 	try {
 		Xml_node output = Genode::config()->xml_node().sub_node("output");
 
@@ -320,14 +426,24 @@ void Rom_filter::Main::_evaluate()
 		Node_type_name const node_type =
 			output.attribute_value("node", Node_type_name(""));
 
+		Genode::Attached_ram_dataspace &back = *_xml_ds[!_front];
+
 		/* generate output */
-		Xml_generator xml(_xml_ds->local_addr<char>(),
-		                  _xml_ds->size(), node_type.string(),
+		Xml_generator xml(back.local_addr<char>(),
+		                  back.size(), node_type.string(),
 		                  [&] () { _evaluate_node(output, xml); });
 
+		/* spare the clients the update if the output remains the same */
+		if (xml.used() == _xml_output_len
+		 && Genode::memcmp(back.local_addr<char>(),
+		                   _xml_ds[_front]->local_addr<char>(),
+		                   _xml_output_len) == 0)
+			return;
+
+		_front          = !_front;
 		_xml_output_len = xml.used();
 
-	} catch (Xml_node::Nonexistent_sub_node) { }
+	} catch (Xml_node::Nonexistent_sub_node) { return; }
 
 	_root.notify_clients();
 }
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -19,9 +19,13 @@
 #include <base/rpc_server.h>
 #include <base/printf.h>
 #include <base/env.h>
+#include <base/lock.h>
 #include <base/sleep.h>
+#include <base/thread.h>
 #include <os/config.h>
-#include <timer_session/connection.h>
+#include <os/reporter.h>
+#include <util/list.h>
+#include <util/string.h>
 
 volatile int dummy;
 
@@ -44,6 +48,192 @@ static void prefetch_dataspace(Genode::Dataspace_capability ds)
 }
 
 
+/**
+ * ROM modules to prefetch and ROM modules requested by clients
+ *
+ * The ROM modules listed in the config are prefetched in the order of
+ * their priority. The order in which clients request ROM modules is
+ * recorded so that it can be reported as boot-access profile.
+ */
+class Prefetch_queue
+{
+	public:
+
+		typedef Genode::String<64> Name;
+
+	private:
+
+		struct Entry : Genode::List<Entry>::Element
+		{
+			enum State { QUEUED, PREFETCHING, DONE };
+
+			Name const name;
+			int  const priority;
+			State      state = QUEUED;
+
+			/* position in the sequence of requests, zero if not requested */
+			unsigned requested = 0;
+
+			Entry(Name const &name, int priority)
+			: name(name), priority(priority) { }
+		};
+
+		Genode::Lock        _lock;
+		Genode::List<Entry> _entries;  /* sorted by decreasing priority */
+		unsigned            _num_requested = 0;
+
+		Genode::Reporter    _reporter { "rom_accesses", 4096, 64*1024 };
+
+		Entry *_lookup(Name const &name)
+		{
+			for (Entry *e = _entries.first(); e; e = e->next())
+				if (e->name == name)
+					return e;
+
+			return nullptr;
+		}
+
+		Entry *_insert(Name const &name, int priority)
+		{
+			/* keep the config order among entries of the same priority */
+			Entry *at = nullptr;
+			for (Entry *e = _entries.first(); e && e->priority >= priority; e = e->next())
+				at = e;
+
+			Entry *entry = new (Genode::env()->heap()) Entry(name, priority);
+			_entries.insert(entry, at);
+			return entry;
+		}
+
+		void _report()
+		{
+			if (!_reporter.is_enabled())
+				return;
+
+			Genode::Reporter::Xml_generator xml(_reporter, [&] () {
+				for (unsigned i = 1; i <= _num_requested; i++)
+					for (Entry const *e = _entries.first(); e; e = e->next())
+						if (e->requested == i)
+							xml.node("rom", [&] () {
+								xml.attribute("name", e->name.string()); });
+			});
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param config  config node containing the '<rom>' entries
+		 */
+		Prefetch_queue(Genode::Xml_node config)
+		{
+			try {
+				_reporter.enabled(config.sub_node("report")
+				                        .attribute("accesses").has_value("yes"));
+			} catch (...) { }
+
+			config.for_each_sub_node("rom", [&] (Genode::Xml_node rom) {
+				Name const name = rom.attribute_value("name", Name());
+				if (!name.valid() || _lookup(name))
+					return;
+
+				_insert(name, rom.attribute_value("priority", 0L));
+			});
+		}
+
+		/**
+		 * Take the next ROM module to be prefetched from the queue
+		 *
+		 * \return false if no ROM module is left
+		 */
+		bool next(Name &name)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			for (Entry *e = _entries.first(); e; e = e->next())
+				if (e->state == Entry::QUEUED) {
+					e->state = Entry::PREFETCHING;
+					name     = e->name;
+					return true;
+				}
+
+			return false;
+		}
+
+		void done(Name const &name)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			if (Entry *e = _lookup(name))
+				e->state = Entry::DONE;
+		}
+
+		/**
+		 * Record the request of a ROM module by a client
+		 *
+		 * \return true if the ROM module still needs to be prefetched by
+		 *         the caller
+		 */
+		bool requested(Name const &name)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			Entry *e = _lookup(name);
+			if (!e)
+				e = _insert(name, 0);
+
+			if (!e->requested) {
+				e->requested = ++_num_requested;
+				_report();
+			}
+
+			/*
+			 * A ROM module that is currently being prefetched by a
+			 * prefetch thread is touched by the caller too. This way,
+			 * the session is not handed out before the ROM module
+			 * is in memory.
+			 */
+			bool const prefetch = (e->state != Entry::DONE);
+			e->state = Entry::DONE;
+			return prefetch;
+		}
+};
+
+
+/**
+ * Thread that works on the prefetch queue
+ */
+class Prefetch_thread : public Genode::Thread<8*1024*sizeof(long)>
+{
+	private:
+
+		Prefetch_queue &_queue;
+
+	public:
+
+		Prefetch_thread(Prefetch_queue &queue)
+		: Genode::Thread<8*1024*sizeof(long)>("prefetch"), _queue(queue) { }
+
+		void entry() override
+		{
+			Prefetch_queue::Name name;
+			while (_queue.next(name)) {
+
+				try {
+					Genode::Rom_connection rom(name.string());
+					PINF("prefetching ROM file  %s", name.string());
+					prefetch_dataspace(rom.dataspace());
+				} catch (...) {
+					PERR("could not open ROM file %s", name.string());
+				}
+
+				_queue.done(name);
+			}
+		}
+};
+
+
 class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 {
 	private:
@@ -56,10 +246,13 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 		 * Constructor
 		 *
 		 * \param  filename  name of the requested file
+		 * \param  queue     prefetch queue
 		 */
-		Rom_session_component(const char *filename) : _rom(filename)
+		Rom_session_component(const char *filename, Prefetch_queue &queue)
+		: _rom(filename)
 		{
-			prefetch_dataspace(_rom.dataspace());
+			if (queue.requested(filename))
+				prefetch_dataspace(_rom.dataspace());
 		}
 
 		/***************************
@@ -76,6 +269,8 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 {
 	private:
 
+		Prefetch_queue &_queue;
+
 		Rom_session_component *_create_session(const char *args)
 		{
 			enum { FILENAME_MAX_LEN = 128 };
@@ -83,7 +278,7 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 			Genode::Arg_string::find_arg(args, "filename").string(filename, sizeof(filename), "");
 
 			/* create new session for the requested file */
-			return new (md_alloc()) Rom_session_component(filename);
+			return new (md_alloc()) Rom_session_component(filename, _queue);
 		}
 
 	public:
@@ -93,11 +288,14 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 		 *
 		 * \param  entrypoint  entrypoint to be used for ROM sessions
 		 * \param  md_alloc    meta-data allocator used for ROM sessions
+		 * \param  queue       prefetch queue
 		 */
 		Rom_root(Genode::Rpc_entrypoint *entrypoint,
-		         Genode::Allocator      *md_alloc)
+		         Genode::Allocator      *md_alloc,
+		         Prefetch_queue         &queue)
 		:
-			Genode::Root_component<Rom_session_component>(entrypoint, md_alloc)
+			Genode::Root_component<Rom_session_component>(entrypoint, md_alloc),
+			_queue(queue)
 		{ }
 };
 
@@ -109,34 +307,22 @@ int main(int argc, char **argv)
 	/* connection to capability service needed to create capabilities */
 	static Cap_connection cap;
 
+	static Prefetch_queue queue(config()->xml_node());
+
 	/*
 	 * Prefetch ROM files specified in the config
+	 *
+	 * The prefetching is performed by several threads in the background
+	 * so that the requests for different ROM modules can be served by the
+	 * backing store concurrently.
 	 */
-	try {
-		Timer::Connection timer;
-		Genode::Xml_node entry = config()->xml_node().sub_node("rom");
-		for (;;) {
-
-			enum { NAME_MAX_LEN = 64 };
-			char name[NAME_MAX_LEN];
-			name[0] = 0;
-			entry.attribute("name").value(name, sizeof(name));
+	enum { MAX_THREADS = 16 };
+	unsigned const num_threads =
+		max(1U, min((unsigned)MAX_THREADS,
+		            config()->xml_node().attribute_value("threads", 2U)));
 
-			try {
-				Rom_connection rom(name);
-				PINF("prefetching ROM file  %s", name);
-				prefetch_dataspace(rom.dataspace());
-			} catch (...) {
-				PERR("could not open ROM file %s", name);
-			}
-
-			/* proceed with next XML node */
-			entry = entry.next("rom");
-
-			/* yield */
-			timer.msleep(1);
-		}
-	} catch (...) { }
+	for (unsigned i = 0; i < num_threads; i++)
+		(new (env()->heap()) Prefetch_thread(queue))->start();
 
 	static Sliced_heap sliced_heap(env()->ram_session(),
 	                               env()->rm_session());
@@ -144,7 +330,7 @@ int main(int argc, char **argv)
 	/* creation of the entrypoint and the root interface */
 	enum { STACK_SIZE = 8*1024 };
 	static Rpc_entrypoint ep(&cap, STACK_SIZE, "rom_pf_ep");
-	static Rom_root rom_root(&ep, &sliced_heap);
+	static Rom_root rom_root(&ep, &sliced_heap, queue);
 
 	/* announce server */
 	env()->parent()->announce(ep.manage(&rom_root));
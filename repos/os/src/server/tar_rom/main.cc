@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2010-2013 Genode Labs GmbH
+ * Copyright (C) 2010-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -22,109 +22,212 @@
 #include <base/env.h>
 #include <base/printf.h>
 #include <os/config.h>
+#include <os/sub_dataspace.h>
+#include <util/volatile_object.h>
+#include <util/list.h>
 
 
 /**
- * A 'Rom_session_component' exports a single file of the tar archive
+ * Index of the files contained in the tar archive
+ *
+ * The archive is scanned only once at startup. Files are looked up via a
+ * hash table keyed by the file name.
  */
-class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
+class Tar_index
 {
-	private:
+	public:
 
-		const char *_tar_addr, *_filename, *_file_addr;
-		Genode::size_t _file_size, _tar_size;
-		Genode::Ram_dataspace_capability _file_ds;
+		struct Entry
+		{
+			char           const *name;
+			char           const *data;
+			Genode::size_t        size;
+		};
+
+	private:
 
 		enum {
 			/* length of on data block in tar */
-			_BLOCK_LEN = 512,
+			BLOCK_LEN = 512,
+
+			/* length of the header field "file-name" in tar */
+			NAME_LEN = 100,
 
 			/* length of the header field "file-size" in tar */
-			_FIELD_SIZE_LEN = 124
+			FIELD_SIZE_LEN = 124
 		};
 
-		/**
-		 * Copy file content into dataspace
-		 *
-		 * \param dst  destination dataspace
-		 */
-		void _copy_content_to_dataspace(Genode::Dataspace_capability dst)
-		{
-			using namespace Genode;
-
-			/* map dataspace locally */
-			char *dst_addr = env()->rm_session()->attach(dst);
-			Dataspace_client dst_client(dst);
+		Entry    *_slots     = 0;
+		unsigned  _num_slots = 0;  /* power of two */
 
-			/* copy content */
-			size_t dst_ds_size   = Dataspace_client(dst).size();
-			size_t bytes_to_copy = min(_file_size, dst_ds_size);
-			memcpy(dst_addr, _file_addr, bytes_to_copy);
-
-			/* unmap dataspace */
-			env()->rm_session()->detach(dst_addr);
+		static unsigned _hash(char const *name)
+		{
+			unsigned h = 5381;
+			for (unsigned i = 0; i < NAME_LEN && name[i]; i++)
+				h = h*33 + name[i];
+			return h;
 		}
 
 		/**
-		 * Initialize dataspace containing the content of the archived file
+		 * Call 'fn' for each record of the archive
 		 */
-		Genode::Ram_dataspace_capability _init_file_ds()
+		template <typename FN>
+		static void _for_each_record(char const *tar_addr, Genode::size_t tar_size,
+		                             FN const &fn)
 		{
-			bool file_found = false;
-
 			/* measure size of archive in blocks */
-			unsigned block_id = 0, block_cnt = _tar_size/_BLOCK_LEN;
+			unsigned block_id = 0, block_cnt = tar_size/BLOCK_LEN;
 
 			/* scan metablocks of archive */
 			while (block_id < block_cnt) {
 
 				unsigned long file_size = 0;
-				Genode::ascii_to_unsigned(_tar_addr + block_id*_BLOCK_LEN +
-				                          _FIELD_SIZE_LEN, file_size, 8);
+				Genode::ascii_to_unsigned(tar_addr + block_id*BLOCK_LEN +
+				                          FIELD_SIZE_LEN, file_size, 8);
 
 				/* get name of tar record */
-				char const *record_filename = _tar_addr + block_id*_BLOCK_LEN;
+				char const *record_filename = tar_addr + block_id*BLOCK_LEN;
 
 				/* skip leading dot of path if present */
 				if (record_filename[0] == '.' && record_filename[1] == '/')
 					record_filename++;
 
-				/* get infos about current file */
-				if (Genode::strcmp(_filename, record_filename) == 0) {
-					_file_size = file_size;
-					_file_addr = _tar_addr + (block_id+1) * _BLOCK_LEN;
-					file_found = true;
-					break;
-				}
+				fn(record_filename, tar_addr + (block_id+1) * BLOCK_LEN, file_size);
 
 				/* some datablocks */       /* one metablock */
-				block_id = block_id + (file_size / _BLOCK_LEN) + 1;
+				block_id = block_id + (file_size / BLOCK_LEN) + 1;
 
 				/* round up */
-				if (file_size % _BLOCK_LEN != 0) block_id++;
+				if (file_size % BLOCK_LEN != 0) block_id++;
 
 				/* check for end of tar archive */
-				if (block_id*_BLOCK_LEN >= _tar_size)
+				if (block_id*BLOCK_LEN >= tar_size)
 					break;
 
 				/* lookout for empty eof-blocks */
-				if (*(_tar_addr + (block_id*_BLOCK_LEN)) == 0x00)
-					if (*(_tar_addr + (block_id*_BLOCK_LEN + 1)) == 0x00)
+				if (*(tar_addr + (block_id*BLOCK_LEN)) == 0x00)
+					if (*(tar_addr + (block_id*BLOCK_LEN + 1)) == 0x00)
 						break;
 			}
+		}
 
-			if (!file_found) {
-				PERR("couldn't find file '%s', empty result", _filename);
-				return Genode::Ram_dataspace_capability();
-			}
+		Entry *_slot(char const *name) const
+		{
+			unsigned i = _hash(name) & (_num_slots - 1);
+			for (; _slots[i].name; i = (i + 1) & (_num_slots - 1))
+				if (Genode::strcmp(_slots[i].name, name, NAME_LEN) == 0)
+					break;
+			return &_slots[i];
+		}
+
+	public:
+
+		Tar_index(char const *tar_addr, Genode::size_t tar_size)
+		{
+			unsigned num_records = 0;
+			_for_each_record(tar_addr, tar_size,
+			                 [&] (char const *, char const *, Genode::size_t) {
+				num_records++; });
+
+			/* keep the table at most half full */
+			for (_num_slots = 16; _num_slots < 2*num_records; _num_slots *= 2);
+
+			_slots = new (Genode::env()->heap()) Entry[_num_slots];
+			Genode::memset(_slots, 0, _num_slots*sizeof(Entry));
+
+			_for_each_record(tar_addr, tar_size,
+			                 [&] (char const *name, char const *data,
+			                      Genode::size_t size) {
+
+				/* the first record of a name wins, as with a linear scan */
+				Entry *slot = _slot(name);
+				if (slot->name)
+					return;
+
+				slot->name = name;
+				slot->data = data;
+				slot->size = size;
+			});
+
+			PINF("indexed %u archive records", num_records);
+		}
+
+		/**
+		 * Return entry for 'name', or 0 if no such file exists
+		 */
+		Entry const *lookup(char const *name) const
+		{
+			Entry const *slot = _slot(name);
+			return slot->name ? slot : 0;
+		}
+};
+
+
+/**
+ * Export of a single file of the tar archive
+ *
+ * The export is shared by all sessions for the same file. So the content
+ * of a file that cannot be mapped directly from the archive is copied only
+ * once, regardless of the number of clients.
+ */
+class Rom_file : public Genode::List<Rom_file>::Element
+{
+	private:
+
+		Tar_index::Entry const &_entry;
+
+		unsigned _users = 0;
+
+		Genode::Ram_dataspace_capability _file_ds;
+
+		Genode::Lazy_volatile_object<Genode::Sub_dataspace> _sub_ds;
+
+		/**
+		 * Return true if the file can be exported without copying
+		 *
+		 * This is the case if the file content starts at a page boundary
+		 * within the archive and the remainder of the last page is zero,
+		 * as a copy would be.
+		 */
+		static bool _mappable(char const *tar_addr, Genode::size_t tar_size,
+		                      Tar_index::Entry const &entry)
+		{
+			using namespace Genode;
+
+			addr_t const offset = entry.data - tar_addr;
+
+			if (!Sub_dataspace::aligned(offset) || entry.size == 0)
+				return false;
+
+			addr_t const end      = offset + entry.size;
+			addr_t const page_end = align_addr(end, Sub_dataspace::PAGE_SIZE_LOG2);
+
+			if (page_end > tar_size)
+				return false;
+
+			for (addr_t i = end; i < page_end; i++)
+				if (tar_addr[i])
+					return false;
+
+			return true;
+		}
+
+		/**
+		 * Initialize dataspace containing the content of the archived file
+		 */
+		static Genode::Ram_dataspace_capability _init_file_ds(Tar_index::Entry const &entry)
+		{
+			using namespace Genode;
 
 			/* try to allocate memory for file */
 			Genode::Ram_dataspace_capability file_ds;
 			try {
-				file_ds = Genode::env()->ram_session()->alloc(_file_size);
+				file_ds = Genode::env()->ram_session()->alloc(entry.size);
 
 				/* get content of file copied into dataspace and return */
-				_copy_content_to_dataspace(file_ds);
+				char *dst_addr = env()->rm_session()->attach(file_ds);
+				memcpy(dst_addr, entry.data, entry.size);
+				env()->rm_session()->detach(dst_addr);
 			} catch (...) {
 				PERR("couldn't allocate memory for file, empty result\n");
 				return file_ds;
@@ -136,36 +239,87 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 	public:
 
 		/**
-		 * Constructor scans and seeks to file
+		 * Constructor
 		 *
+		 * \param  tar_ds    dataspace of tar archive
 		 * \param  tar_addr  local address to tar archive
 		 * \param  tar_size  size of tar archive in bytes
-		 * \param  filename  name of the requested file
+		 * \param  entry     index entry of the file
+		 *
+		 * \throw Root::Invalid_args  file content could not be exported
 		 */
-		Rom_session_component(const char *tar_addr, unsigned tar_size,
-		                      const char *filename)
-		:
-			_tar_addr(tar_addr), _filename(filename), _file_addr(0), _file_size(0),
-			_tar_size(tar_size),
-			_file_ds(_init_file_ds())
+		Rom_file(Genode::Dataspace_capability tar_ds,
+		         const char *tar_addr, Genode::size_t tar_size,
+		         Tar_index::Entry const &entry)
+		: _entry(entry)
 		{
+			if (_mappable(tar_addr, tar_size, entry)) {
+				try {
+					_sub_ds.construct(tar_ds, entry.data - tar_addr, entry.size);
+					return;
+				} catch (...) {
+					PWRN("could not map '%s', fall back to copying", entry.name); }
+			}
+
+			_file_ds = _init_file_ds(entry);
 			if (!_file_ds.valid())
 				throw Genode::Root::Invalid_args();
 		}
 
+		~Rom_file()
+		{
+			if (_file_ds.valid())
+				Genode::env()->ram_session()->free(_file_ds);
+		}
+
+		bool belongs_to(Tar_index::Entry const &entry) const {
+			return &_entry == &entry; }
+
+		void acquire() { _users++; }
+
 		/**
-		 * Destructor
+		 * Drop one user
+		 *
+		 * \return number of remaining users
 		 */
-		~Rom_session_component() { Genode::env()->ram_session()->free(_file_ds); }
+		unsigned release() { return --_users; }
 
 		/**
 		 * Return dataspace with content of file
 		 */
-		Genode::Rom_dataspace_capability dataspace()
+		Genode::Dataspace_capability dataspace()
 		{
-			Genode::Dataspace_capability ds = _file_ds;
-			return Genode::static_cap_cast<Genode::Rom_dataspace>(ds);
+			return _sub_ds.is_constructed() ? _sub_ds->dataspace()
+			                                : Genode::Dataspace_capability(_file_ds);
 		}
+};
+
+
+/**
+ * A 'Rom_session_component' exports a single file of the tar archive
+ */
+class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
+{
+	private:
+
+		Rom_file &_file;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param  file  export of the requested file, acquired by the caller
+		 */
+		Rom_session_component(Rom_file &file) : _file(file) { }
+
+		Rom_file &file() { return _file; }
+
+		/**
+		 * Return dataspace with content of file
+		 */
+		Genode::Rom_dataspace_capability dataspace() {
+			return Genode::static_cap_cast<Genode::Rom_dataspace>(_file.dataspace()); }
 
 		void sigh(Genode::Signal_context_capability) { }
 };
@@ -175,8 +329,48 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 {
 	private:
 
-		char    *_tar_addr;
-		unsigned _tar_size;
+		Genode::Dataspace_capability _tar_ds;
+		char                        *_tar_addr;
+		Genode::size_t               _tar_size;
+		Tar_index                    _index;
+
+		/* files currently exported to at least one session */
+		Genode::List<Rom_file>       _files;
+
+		/**
+		 * Return export of the file for a new session
+		 *
+		 * \throw Root::Invalid_args
+		 */
+		Rom_file &_acquire(char const *filename)
+		{
+			Tar_index::Entry const *entry = _index.lookup(filename);
+			if (!entry) {
+				PERR("couldn't find file '%s', empty result", filename);
+				throw Genode::Root::Invalid_args();
+			}
+
+			Rom_file *file = _files.first();
+			for (; file && !file->belongs_to(*entry); file = file->next());
+
+			if (!file) {
+				file = new (Genode::env()->heap())
+				       Rom_file(_tar_ds, _tar_addr, _tar_size, *entry);
+				_files.insert(file);
+			}
+
+			file->acquire();
+			return *file;
+		}
+
+		void _release(Rom_file &file)
+		{
+			if (file.release())
+				return;
+
+			_files.remove(&file);
+			Genode::destroy(Genode::env()->heap(), &file);
+		}
 
 		Rom_session_component *_create_session(const char *args)
 		{
@@ -186,8 +380,22 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 
 			PINF("connection for file '%s' requested\n", filename);
 
+			Rom_file &file = _acquire(filename);
+
 			/* create new session for the requested file */
-			return new (md_alloc()) Rom_session_component(_tar_addr, _tar_size, filename);
+			try {
+				return new (md_alloc()) Rom_session_component(file); }
+			catch (...) {
+				_release(file);
+				throw;
+			}
+		}
+
+		void _destroy_session(Rom_session_component *session)
+		{
+			Rom_file &file = session->file();
+			Genode::Root_component<Rom_session_component>::_destroy_session(session);
+			_release(file);
 		}
 
 	public:
@@ -197,15 +405,18 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 		 *
 		 * \param  entrypoint  entrypoint to be used for ROM sessions
 		 * \param  md_alloc    meta-data allocator used for ROM sessions
+		 * \param  tar_ds      dataspace of tar archive
 		 * \param  tar_base    local address of tar archive
 		 * \param  tar_size    size of tar archive in bytes
 		 */
-		Rom_root(Genode::Rpc_entrypoint *entrypoint,
-		         Genode::Allocator      *md_alloc,
+		Rom_root(Genode::Rpc_entrypoint      *entrypoint,
+		         Genode::Allocator           *md_alloc,
+		         Genode::Dataspace_capability tar_ds,
 		         char *tar_addr, Genode::size_t tar_size)
 		:
 			Genode::Root_component<Rom_session_component>(entrypoint, md_alloc),
-			_tar_addr(tar_addr), _tar_size(tar_size)
+			_tar_ds(tar_ds), _tar_addr(tar_addr), _tar_size(tar_size),
+			_index(tar_addr, tar_size)
 		{ }
 };
 
@@ -229,10 +440,12 @@ int main(void)
 	/* obtain dataspace of tar archive from ROM service */
 	static char  *tar_base = 0;
 	static size_t tar_size = 0;
+	static Dataspace_capability tar_ds;
 	try {
 		static Rom_connection tar_rom(tar_filename);
-		tar_base = env()->rm_session()->attach(tar_rom.dataspace());
-		tar_size = Dataspace_client(tar_rom.dataspace()).size();
+		tar_ds   = tar_rom.dataspace();
+		tar_base = env()->rm_session()->attach(tar_ds);
+		tar_size = Dataspace_client(tar_ds).size();
 	} catch (...) {
 		PERR("Could not obtain tar archive from ROM service");
 		return -2;
@@ -249,7 +462,7 @@ int main(void)
 
 	enum { STACK_SIZE = 8*1024 };
 	static Rpc_entrypoint ep(&cap, STACK_SIZE, "tar_rom_ep");
-	static Rom_root rom_root(&ep, &sliced_heap, tar_base, tar_size);
+	static Rom_root rom_root(&ep, &sliced_heap, tar_ds, tar_base, tar_size);
 
 	/* announce server*/
 	env()->parent()->announce(ep.manage(&rom_root));
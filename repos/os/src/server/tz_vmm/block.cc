@@ -310,7 +310,10 @@ class Callback : public Thread<8192>
 						 * If we want to support multiple VMs, this should
 						 * be read from the corresponding request.
 						 */
-						_vm->inject_irq(dev->irq());
+						try { _vm->inject_irq(dev->irq()); }
+						catch (Vm_base::Inject_irq_failed) {
+							PWRN("failed to inject IRQ %u of block device",
+							     dev->irq()); }
 						break;
 					}
 				}
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -91,8 +91,16 @@ class Vm_base {
 		void run()   { _vm_con.run();   }
 		void pause() { _vm_con.pause(); }
 
+		/**
+		 * Inject IRQ with the next entry into the VM
+		 *
+		 * An IRQ that is already pending is not injected twice.
+		 *
+		 * \throw Inject_irq_failed  another IRQ is still pending
+		 */
 		void inject_irq(unsigned const irq)
 		{
+			if (_state->irq_injection == irq) { return; }
 			if (_state->irq_injection) { throw Inject_irq_failed(); }
 			_state->irq_injection = irq;
 		}
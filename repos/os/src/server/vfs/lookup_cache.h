@@ -0,0 +1,130 @@
+/*
+ * \brief  Cache of path-lookup results
+ * \author Emery Hemingway
+ * \date   2015-11-24
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _VFS__LOOKUP_CACHE_H_
+#define _VFS__LOOKUP_CACHE_H_
+
+/* Genode includes */
+#include <vfs/file_system.h>
+#include <util/string.h>
+
+namespace File_system { class Lookup_cache; }
+
+
+/**
+ * Remembers the type of recently resolved paths, including paths that do
+ * not exist
+ *
+ * Resolving a path walks the plugin tree of the VFS. Compilers and build
+ * tools probe many paths repeatedly, most of them nonexistent. The cache
+ * answers such lookups without consulting the VFS. Entries are dropped
+ * whenever the server modifies the corresponding path, changes of the
+ * VFS made by others are not observed.
+ */
+class File_system::Lookup_cache
+{
+	public:
+
+		enum { NUM_ENTRIES = 128 };
+
+		enum Type { UNKNOWN, NONEXISTENT, FILE, DIRECTORY, SYMLINK };
+
+	private:
+
+		struct Entry
+		{
+			Type type;
+			char path[Vfs::MAX_PATH_LEN];
+
+			Entry() : type(UNKNOWN) { path[0] = 0; }
+		};
+
+		Entry _entries[NUM_ENTRIES];
+
+		static unsigned _hash(char const *path)
+		{
+			unsigned h = 5381;
+			for (; *path; path++)
+				h = h*33 + *path;
+			return h % NUM_ENTRIES;
+		}
+
+		/**
+		 * Return true if 'path' equals 'prefix' or lies underneath it
+		 */
+		static bool _within(char const *path, char const *prefix)
+		{
+			Genode::size_t const len = Genode::strlen(prefix);
+
+			if (Genode::strcmp(path, prefix, len) != 0)
+				return false;
+
+			return path[len] == 0 || path[len] == '/' || (len && prefix[len - 1] == '/');
+		}
+
+	public:
+
+		/**
+		 * Return cached type of 'path'
+		 */
+		Type type(char const *path) const
+		{
+			Entry const &e = _entries[_hash(path)];
+
+			if (e.type == UNKNOWN || Genode::strcmp(e.path, path) != 0)
+				return UNKNOWN;
+
+			return e.type;
+		}
+
+		/**
+		 * Record lookup result, replacing a colliding entry
+		 */
+		void insert(char const *path, Type type)
+		{
+			if (Genode::strlen(path) >= sizeof(Entry::path))
+				return;
+
+			Entry &e = _entries[_hash(path)];
+			Genode::strncpy(e.path, path, sizeof(e.path));
+			e.type = type;
+		}
+
+		/**
+		 * Record type of existing node according to its VFS status
+		 */
+		void insert(char const *path, Vfs::Directory_service::Stat const &stat)
+		{
+			switch (stat.mode & (Vfs::Directory_service::STAT_MODE_DIRECTORY |
+			                     Vfs::Directory_service::STAT_MODE_SYMLINK)) {
+			case Vfs::Directory_service::STAT_MODE_DIRECTORY:
+				insert(path, DIRECTORY); break;
+			case Vfs::Directory_service::STAT_MODE_SYMLINK:
+				insert(path, SYMLINK);   break;
+			default:
+				insert(path, FILE);      break;
+			}
+		}
+
+		/**
+		 * Forget 'path' and all paths underneath
+		 */
+		void invalidate(char const *path)
+		{
+			for (unsigned i = 0; i < NUM_ENTRIES; i++)
+				if (_entries[i].type != UNKNOWN && _within(_entries[i].path, path))
+					_entries[i].type = UNKNOWN;
+		}
+};
+
+#endif /* _VFS__LOOKUP_CACHE_H_ */
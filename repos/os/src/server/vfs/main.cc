@@ -345,6 +345,7 @@ class File_system::Session_component : public Session_rpc_object
 				throw Permission_denied();
 
 			assert_unlink(root()->unlink(str));
+			_handle_registry.remove(str);
 			dir->mark_as_updated();
 		}
 
@@ -359,6 +360,17 @@ class File_system::Session_component : public Session_rpc_object
 			file->mark_as_updated();
 		}
 
+		Dataspace_capability dataspace(File_handle file_handle)
+		{
+			/* the client could write to the dataspace */
+			if (!_writable)
+				return Dataspace_capability();
+
+			File *file = _handle_registry.lookup_and_lock(file_handle);
+			Node_lock_guard guard(file);
+			return file->dataspace();
+		}
+
 		/**
 		 * Move and rename directory entry
 		 */
@@ -20,6 +20,9 @@
 #include <util/avl_string.h>
 #include <util/noncopyable.h>
 
+/* local includes */
+#include "lookup_cache.h"
+
 namespace File_system {
 
 	struct Node;
@@ -88,12 +91,17 @@ class File_system::Node : public Node_base, public Genode::Avl_node<Node>, priva
 
 struct File_system::Directory : Node
 {
-	Directory(char const *path, bool create)
+	/**
+	 * Constructor
+	 *
+	 * \param known  path is known to refer to a directory
+	 */
+	Directory(char const *path, bool create, bool known = false)
 	: Node(path)
 	{
 		if (create)
 			assert_mkdir(root()->mkdir(path, 0777));
-		else if (strcmp("/", path, 2) == 0)
+		else if (known || strcmp("/", path, 2) == 0)
 			return;
 		else if (!root()->leaf_path(path))
 			throw Lookup_failed();
@@ -143,8 +151,16 @@ class File_system::File : public Node
 {
 	private:
 
-		Vfs_handle *_handle;
-		unsigned    _mode;
+		Vfs_handle           *_handle;
+		unsigned              _mode;
+		Dataspace_capability  _ds;   /* file content handed out to clients */
+
+		void _release_dataspace()
+		{
+			if (_ds.valid())
+				root()->release(path(), _ds);
+			_ds = Dataspace_capability();
+		}
 
 	public:
 
@@ -168,7 +184,21 @@ class File_system::File : public Node
 			assert_open(root()->open(path, mode, &_handle));
 		}
 
-		~File() { destroy(env()->heap(), _handle); }
+		~File()
+		{
+			_release_dataspace();
+			destroy(env()->heap(), _handle);
+		}
+
+		/**
+		 * Return dataspace containing the file content
+		 */
+		Dataspace_capability dataspace()
+		{
+			if (!_ds.valid())
+				_ds = root()->dataspace(path());
+			return _ds;
+		}
 
 		void open(Mode fs_mode)
 		{
@@ -191,8 +221,11 @@ class File_system::File : public Node
 			_mode   = mode;
 		}
 
-		void truncate(file_size_t size) {
-			assert_truncate(_handle->fs().ftruncate(_handle, size)); }
+		void truncate(file_size_t size)
+		{
+			_release_dataspace();
+			assert_truncate(_handle->fs().ftruncate(_handle, size));
+		}
 
 		size_t read(char *dst, size_t len, seek_off_t seek_offset)
 		{
@@ -205,8 +238,17 @@ class File_system::File : public Node
 		size_t write(char const *src, size_t len, seek_off_t seek_offset)
 		{
 			Vfs::file_size res = 0;
+
+			/* the seek offset ~0 refers to the end of the file (append) */
+			if (seek_offset == (seek_off_t)(~0)) {
+				Directory_service::Stat st;
+				root()->stat(path(), st);
+				seek_offset = st.size;
+			}
+
 			_handle->seek(seek_offset);
 			_handle->fs().write(_handle, src, len, res);
+			_release_dataspace();
 			mark_as_updated();
 			return res;
 		}
@@ -215,11 +257,18 @@ class File_system::File : public Node
 
 struct File_system::Symlink : Node
 {
-	Symlink(char const *path, bool create)
+	/**
+	 * Constructor
+	 *
+	 * \param known  path is known to refer to a symlink
+	 */
+	Symlink(char const *path, bool create, bool known = false)
 	: Node(path)
 	{
 		if (create)
 			assert_symlink(root()->symlink("", path));
+		else if (known)
+			return;
 		else if (!root()->leaf_path(path))
 			throw Lookup_failed();
 		else {
@@ -258,6 +307,55 @@ struct File_system::Symlink : Node
  */
 struct File_system::Node_cache : Genode::Avl_tree<Node>
 {
+	Lookup_cache lookup_cache;
+
+	/**
+	 * Return type of node at 'path', consulting the VFS if not cached
+	 *
+	 * \throw Lookup_failed
+	 */
+	Lookup_cache::Type lookup(char const *path)
+	{
+		Lookup_cache::Type type = lookup_cache.type(path);
+
+		if (type == Lookup_cache::UNKNOWN) {
+			Directory_service::Stat stat;
+			if (root()->stat(path, stat) == Directory_service::STAT_OK)
+				lookup_cache.insert(path, stat);
+			else
+				lookup_cache.insert(path, Lookup_cache::NONEXISTENT);
+
+			type = lookup_cache.type(path);
+		}
+
+		if (type == Lookup_cache::NONEXISTENT)
+			throw Lookup_failed();
+
+		return type;
+	}
+
+	/**
+	 * Throw 'Lookup_failed' if 'path' is known to not exist
+	 */
+	void assert_not_absent(char const *path)
+	{
+		if (lookup_cache.type(path) == Lookup_cache::NONEXISTENT)
+			throw Lookup_failed();
+	}
+
+	/**
+	 * Record that a lookup of 'path' failed
+	 *
+	 * The failure of opening a node may have other causes than the
+	 * absence of the path, so the VFS is asked whether the path exists.
+	 */
+	void lookup_failed(char const *path)
+	{
+		Directory_service::Stat stat;
+		if (root()->stat(path, stat) != Directory_service::STAT_OK)
+			lookup_cache.insert(path, Lookup_cache::NONEXISTENT);
+	}
+
 	Node *find(char const *path) {
 		return first() ? (Node *)first()->find_by_path(path) : nullptr; }
 
@@ -273,6 +371,8 @@ struct File_system::Node_cache : Genode::Avl_tree<Node>
 
 	void remove_path(char const *path)
 	{
+		lookup_cache.invalidate(path);
+
 		Node *node = find(path);
 		if (!node ) return;
 
@@ -282,6 +382,9 @@ struct File_system::Node_cache : Genode::Avl_tree<Node>
 
 	void rename(char const *from, char const *to)
 	{
+		lookup_cache.invalidate(from);
+		lookup_cache.invalidate(to);
+
 		Node *node = find(to);
 		if (node)
 			throw Permission_denied();
@@ -303,23 +406,17 @@ struct File_system::Node_cache : Genode::Avl_tree<Node>
 	{
 		Node *node = find(path);
 		if (!node) {
-			Directory_service::Stat stat;
-			assert_stat(root()->stat(path, stat));
-
-			switch (stat.mode & (
-				Directory_service::STAT_MODE_DIRECTORY |
-				Directory_service::STAT_MODE_SYMLINK |
-				File_system::Status::MODE_FILE)) {
+			switch (lookup(path)) {
 
-			case Directory_service::STAT_MODE_DIRECTORY:
-				node = new (env()->heap()) Directory(path, false);
+			case Lookup_cache::DIRECTORY:
+				node = new (env()->heap()) Directory(path, false, true);
 				break;
 
-			case Directory_service::STAT_MODE_SYMLINK:
-				node = new (env()->heap()) Symlink(path, false);
+			case Lookup_cache::SYMLINK:
+				node = new (env()->heap()) Symlink(path, false, true);
 				break;
 
-			default: /* Directory_service::STAT_MODE_FILE */
+			default: /* Lookup_cache::FILE */
 				node = new (env()->heap()) File(path, READ_ONLY, false);
 				break;
 			}
@@ -339,7 +436,20 @@ struct File_system::Node_cache : Genode::Avl_tree<Node>
 				throw Node_already_exists();
 
 		} else {
-			dir = new (env()->heap()) Directory(path, create);
+			if (create)
+				lookup_cache.invalidate(path);
+			else
+				assert_not_absent(path);
+
+			try {
+				dir = new (env()->heap())
+					Directory(path, create,
+					          lookup_cache.type(path) == Lookup_cache::DIRECTORY);
+			} catch (Lookup_failed) {
+				lookup_failed(path);
+				throw;
+			}
+			lookup_cache.insert(path, Lookup_cache::DIRECTORY);
 			insert(dir);
 		}
 		dir->incr();
@@ -358,7 +468,17 @@ struct File_system::Node_cache : Genode::Avl_tree<Node>
 			file->open(mode);
 
 		} else {
-			file = new (env()->heap()) File(path, mode, create);
+			if (create)
+				lookup_cache.invalidate(path);
+			else
+				assert_not_absent(path);
+
+			try {
+				file = new (env()->heap()) File(path, mode, create);
+			} catch (Lookup_failed) {
+				lookup_failed(path);
+				throw;
+			}
 			insert(file);
 		}
 		file->incr();
@@ -375,7 +495,20 @@ struct File_system::Node_cache : Genode::Avl_tree<Node>
 				throw Node_already_exists();
 
 		} else {
-			link = new (env()->heap()) Symlink(path, create);
+			if (create)
+				lookup_cache.invalidate(path);
+			else
+				assert_not_absent(path);
+
+			try {
+				link = new (env()->heap())
+					Symlink(path, create,
+					        lookup_cache.type(path) == Lookup_cache::SYMLINK);
+			} catch (Lookup_failed) {
+				lookup_failed(path);
+				throw;
+			}
+			lookup_cache.insert(path, Lookup_cache::SYMLINK);
 			insert(link);
 		}
 		link->incr();
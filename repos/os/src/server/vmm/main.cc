@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -479,6 +479,9 @@ class Vmm
 				Genode::uint64_t size() { return _size; }
 				const char *     name() { return _name; }
 
+				bool contains(Genode::uint64_t a) {
+					return (a >= addr()) && (a < (addr()+size())); }
+
 				virtual void read  (Genode::uint32_t * reg,
 				                    Genode::uint64_t   off) {
 					throw Error("Device %s: word-wise read of %llx not allowed",
@@ -558,7 +561,7 @@ class Vmm
 
 				Device *find_by_addr(Genode::uint64_t a)
 				{
-					if ((a >= addr()) && (a < (addr()+size())))
+					if (contains(a))
 						return this;
 
 					Device *d = Avl_node<Device>::child(a > addr());
@@ -599,11 +602,21 @@ class Vmm
 					Distr_state distr_state = DISABLED;
 					Device    * device      = nullptr;
 					bool        eoi         = false;
+					bool        queued      = false;
 				};
 
 				Irq  _irqs[MAX_IRQ+1];
 				bool _distr_enabled = false;
 
+				/*
+				 * IRQs waiting for a free list register
+				 *
+				 * Each IRQ is queued at most once, so the queue cannot
+				 * overflow.
+				 */
+				Genode::Ring_buffer<unsigned, MAX_IRQ + 2,
+				                    Genode::Ring_buffer_unsynchronized> _queue;
+
 				using Error = Vm::Exception;
 
 
@@ -639,21 +652,34 @@ class Vmm
 					}
 
 					_vm->state()->gic_misr = 0;
+
+					_fill_lrs_from_queue();
 				}
 
-				void _inject_irq(unsigned irq, bool eoi)
-				{
-					if (irq == TIMER)
-						_vm->state()->timer_irq = false;
+				enum { LR_EOI = 1 << 9 };  /* maintenance IRQ on EOI */
 
+				bool _in_lr(unsigned irq)
+				{
 					for (unsigned i = 0; i < State::NR_IRQ; i++) {
 						if (!(_vm->state()->gic_elrsr0 & (1 << i))) {
 							Gich_lr::access_t v = _vm->state()->gic_lr[i];
 							if (Gich_lr::Virt_id::get(v) == irq)
-								return;
+								return true;
 						}
 					}
+					return false;
+				}
+
+				bool _lr_free()
+				{
+					for (unsigned i = 0; i < State::NR_IRQ; i++)
+						if (_vm->state()->gic_elrsr0 & (1 << i))
+							return true;
+					return false;
+				}
 
+				void _fill_lr(unsigned irq, bool eoi)
+				{
 					for (unsigned i = 0; i < State::NR_IRQ; i++) {
 						if (!(_vm->state()->gic_elrsr0 & (1 << i)))
 							continue;
@@ -661,14 +687,70 @@ class Vmm
 						_vm->state()->gic_elrsr0 &= ~(1 << i);
 						Gich_lr::access_t v = 0;
 						Gich_lr::Virt_id::set(v, irq);
-						Gich_lr::Phys_id::set(v, eoi ? 1 << 9 : 0);
+						Gich_lr::Phys_id::set(v, eoi ? LR_EOI : 0);
 						Gich_lr::Prio::set(v, 0);
 						Gich_lr::State::set(v, 0b1);
 						_vm->state()->gic_lr[i] = v;
 						return;
 					}
+				}
+
+				/**
+				 * Let the EOI of each occupied list register raise a
+				 * maintenance IRQ, which refills the list registers
+				 */
+				void _request_maintenance()
+				{
+					for (unsigned i = 0; i < State::NR_IRQ; i++) {
+						if (_vm->state()->gic_elrsr0 & (1 << i))
+							continue;
 
-					throw Error("IRQ queue full, can't inject irq %u", irq);
+						Gich_lr::access_t &v = _vm->state()->gic_lr[i];
+						Gich_lr::Phys_id::set(v, Gich_lr::Phys_id::get(v) | LR_EOI);
+					}
+				}
+
+				void _fill_lrs_from_queue()
+				{
+					while (!_queue.empty() && _lr_free()) {
+						unsigned const irq = _queue.get();
+						_irqs[irq].queued = false;
+
+						/* the guest may have disabled the IRQ meanwhile */
+						if (_irqs[irq].distr_state == Irq::ENABLED)
+							_fill_lr(irq, _irqs[irq].eoi);
+					}
+
+					if (!_queue.empty())
+						_request_maintenance();
+				}
+
+				/**
+				 * Make IRQ pending at the virtual CPU interface
+				 *
+				 * All list registers are used to deliver several IRQs
+				 * with one entry into the guest. If all of them are
+				 * occupied, the IRQ is queued until the guest signals the
+				 * end of an IRQ. An IRQ that is already pending is not
+				 * injected twice.
+				 */
+				void _inject_irq(unsigned irq, bool eoi)
+				{
+					if (irq == TIMER)
+						_vm->state()->timer_irq = false;
+
+					if (_irqs[irq].queued || _in_lr(irq))
+						return;
+
+					/* preserve the order of the IRQs queued before */
+					if (_queue.empty() && _lr_free()) {
+						_fill_lr(irq, eoi);
+						return;
+					}
+
+					_irqs[irq].queued = true;
+					_queue.add(irq);
+					_request_maintenance();
 				}
 
 				void _enable_irq(unsigned irq)
@@ -807,8 +889,9 @@ class Vmm
 					if (!_irqs[irq].device)
 						throw Error("No device registered for IRQ %u", irq);
 
+					/* coalesce with the occurrence not yet handled by the guest */
 					if (_irqs[irq].cpu_state == Irq::PENDING)
-						throw Error("Pending IRQ should not trigger again");;
+						return;
 
 					if (_irqs[irq].eoi)
 						_irqs[irq].cpu_state = Irq::PENDING;
@@ -1206,6 +1289,7 @@ class Vmm
 		Vm                             _vm;
 		Cp15                           _cp15;
 		Genode::Avl_tree<Device>       _device_tree;
+		Device                        *_last_device = nullptr;
 		Gic                            _gic;
 		Generic_timer                  _timer;
 		System_register                _sys_regs;
@@ -1214,11 +1298,30 @@ class Vmm
 		void _handle_hyper_call() {
 			throw Vm::Exception("Unknown hyper call!"); }
 
-		void _handle_data_abort()
+		/**
+		 * Look up device at guest-physical address
+		 *
+		 * Guests tend to access one device many times in a row, e.g., when
+		 * polling the UART or handling an interrupt at the GIC. Hence, the
+		 * device of the last access is checked before the tree.
+		 */
+		Device * _device(Genode::uint64_t ipa)
 		{
-			Genode::uint64_t ipa = (Genode::uint64_t)_vm.state()->hpfar << 8;
+			if (_last_device && _last_device->contains(ipa))
+				return _last_device;
+
 			Device * device = _device_tree.first()
 				? _device_tree.first()->find_by_addr(ipa) : nullptr;
+			if (device)
+				_last_device = device;
+
+			return device;
+		}
+
+		void _handle_data_abort()
+		{
+			Genode::uint64_t ipa = (Genode::uint64_t)_vm.state()->hpfar << 8;
+			Device * device = _device(ipa);
 			if (!device)
 				throw Vm::Exception("No device at IPA=%llx", ipa);
 			device->handle_memory_access(_vm.state());
@@ -0,0 +1,310 @@
+/*
+ * \brief  Store of compressed and deduplicated device blocks
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _BLOCK_STORE_H_
+#define _BLOCK_STORE_H_
+
+/* Genode includes */
+#include <base/slab.h>
+#include <os/attached_ram_dataspace.h>
+#include <util/misc_math.h>
+#include <util/string.h>
+
+/* local includes */
+#include "lz4.h"
+
+namespace Zram_blk {
+
+	using namespace Genode;
+
+	class Block_store;
+}
+
+
+/**
+ * Block store
+ *
+ * Each block is represented by a pointer to a chunk that holds the
+ * compressed block content. Blocks that contain zeros only are not backed
+ * by a chunk at all. Blocks with identical content share one chunk, which
+ * is found by a hash over the compressed data. Because the compression is
+ * deterministic, identical blocks always yield identical compressed data.
+ *
+ * Chunks are allocated from slab allocators of 'NUM_CLASSES' size classes.
+ * A block that cannot be compressed to fit a smaller class than the block
+ * size is stored uncompressed.
+ *
+ * The tables are RAM dataspaces of their own because they scale with the
+ * device size. The chunks are allocated from the heap. Hence, the quota
+ * consumed by the store grows with the amount of non-zero content only.
+ */
+class Zram_blk::Block_store
+{
+	private:
+
+		enum { NUM_CLASSES = 16 };
+
+		struct Chunk
+		{
+			Chunk    *next;   /* next chunk within the same hash bucket */
+			uint32_t  hash;
+			unsigned  refs;   /* number of blocks referring to the chunk */
+			size_t    size;   /* size of data, equals block size if raw */
+
+			uint8_t *data() { return (uint8_t *)(this + 1); }
+		};
+
+		size_t const _block_size;
+		size_t const _block_count;
+		size_t const _class_granularity = _block_size/NUM_CLASSES;
+
+		Attached_ram_dataspace _blocks_ds {
+			env()->ram_session(), _block_count*sizeof(Chunk *) };
+
+		Chunk ** const _blocks = _blocks_ds.local_addr<Chunk *>();
+
+		static size_t _num_buckets(size_t block_count)
+		{
+			/* about four blocks per bucket, rounded to a power of two */
+			size_t n = 1;
+			while (n*4 < block_count)
+				n <<= 1;
+			return n;
+		}
+
+		size_t const _bucket_mask = _num_buckets(_block_count) - 1;
+
+		Attached_ram_dataspace _buckets_ds {
+			env()->ram_session(), (_bucket_mask + 1)*sizeof(Chunk *) };
+
+		Chunk ** const _buckets = _buckets_ds.local_addr<Chunk *>();
+
+		struct Size_class
+		{
+			Slab slab;
+
+			static size_t _slab_block_size(size_t entry_size)
+			{
+				/* hold at least eight chunks per slab block */
+				return align_addr(max(8*(entry_size + sizeof(addr_t)), (size_t)4096), 12);
+			}
+
+			Size_class(size_t data_size)
+			:
+				slab(sizeof(Chunk) + data_size,
+				     _slab_block_size(sizeof(Chunk) + data_size), 0, env()->heap())
+			{ }
+		};
+
+		Size_class *_classes[NUM_CLASSES];
+
+		Lz4::Compressor _compressor;
+
+		/* buffer for the compressed data of the block to write */
+		uint8_t * const _compressed =
+			(uint8_t *)env()->heap()->alloc(_block_size);
+
+		size_t _num_chunks = 0;
+		size_t _num_refs   = 0;
+		size_t _used_bytes = 0;
+
+		unsigned _class_index(size_t size) const {
+			return (size + _class_granularity - 1)/_class_granularity - 1; }
+
+		static uint32_t _hash(uint8_t const *data, size_t size)
+		{
+			/* FNV-1a */
+			uint32_t h = 2166136261U;
+			for (size_t i = 0; i < size; i++)
+				h = (h ^ data[i])*16777619U;
+			return h;
+		}
+
+		static bool _zero(char const *data, size_t size)
+		{
+			unsigned long const *p = (unsigned long const *)data;
+
+			for (size_t i = 0; i < size/sizeof(long); i++)
+				if (p[i])
+					return false;
+
+			return true;
+		}
+
+		Chunk *&_bucket(uint32_t hash) { return _buckets[hash & _bucket_mask]; }
+
+		/**
+		 * Obtain chunk holding the specified data
+		 *
+		 * \return  chunk with its reference counter incremented, or 0 if
+		 *          the chunk could not be allocated
+		 */
+		Chunk *_acquire(uint8_t const *data, size_t size)
+		{
+			uint32_t const hash = _hash(data, size);
+
+			for (Chunk *c = _bucket(hash); c; c = c->next)
+				if (c->hash == hash && c->size == size
+				 && memcmp(c->data(), data, size) == 0) {
+					c->refs++;
+					return c;
+				}
+
+			void *ptr = 0;
+			if (!_classes[_class_index(size)]->slab.alloc(0, &ptr))
+				return 0;
+
+			Chunk * const c = (Chunk *)ptr;
+			c->hash = hash;
+			c->refs = 1;
+			c->size = size;
+			memcpy(c->data(), data, size);
+
+			c->next       = _bucket(hash);
+			_bucket(hash) = c;
+
+			_num_chunks++;
+			_used_bytes += size;
+			return c;
+		}
+
+		void _release(Chunk *c)
+		{
+			if (--c->refs)
+				return;
+
+			for (Chunk **p = &_bucket(c->hash); *p; p = &(*p)->next)
+				if (*p == c) {
+					*p = c->next;
+					break;
+				}
+
+			_num_chunks--;
+			_used_bytes -= c->size;
+			_classes[_class_index(c->size)]->slab.free(c);
+		}
+
+		void _assign(size_t block, Chunk *c)
+		{
+			Chunk * const old = _blocks[block];
+
+			_blocks[block] = c;
+
+			if (c)   _num_refs++;
+			if (old) { _num_refs--; _release(old); }
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Block_store(Block_store const &);
+		Block_store &operator = (Block_store const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param block_size  block size, must be a multiple of 'NUM_CLASSES'
+		 *                    and at most 'Lz4::MAX_INPUT'
+		 */
+		Block_store(size_t block_size, size_t block_count)
+		:
+			_block_size(block_size), _block_count(block_count)
+		{
+			for (unsigned i = 0; i < NUM_CLASSES; i++)
+				_classes[i] = new (env()->heap())
+					Size_class((i + 1)*_class_granularity);
+		}
+
+		~Block_store()
+		{
+			for (size_t i = 0; i < _block_count; i++)
+				_assign(i, 0);
+
+			for (unsigned i = 0; i < NUM_CLASSES; i++)
+				destroy(env()->heap(), _classes[i]);
+
+			env()->heap()->free(_compressed, _block_size);
+		}
+
+		size_t block_size()  const { return _block_size;  }
+		size_t block_count() const { return _block_count; }
+
+		/**
+		 * Read block into 'dst'
+		 *
+		 * \return  false if the stored data is corrupt
+		 */
+		bool read(size_t block, char *dst)
+		{
+			Chunk * const c = _blocks[block];
+
+			if (!c) {
+				memset(dst, 0, _block_size);
+				return true;
+			}
+
+			if (c->size == _block_size) {
+				memcpy(dst, c->data(), _block_size);
+				return true;
+			}
+
+			return Lz4::decompress(c->data(), c->size, dst, _block_size);
+		}
+
+		/**
+		 * Write block from 'src'
+		 *
+		 * \return  false if the memory for storing the block is exhausted,
+		 *          in which case the former block content remains intact
+		 */
+		bool write(size_t block, char const *src)
+		{
+			if (_zero(src, _block_size)) {
+				_assign(block, 0);
+				return true;
+			}
+
+			/* compression must save at least one size class */
+			size_t const capacity = _block_size - _class_granularity;
+			size_t const size = _compressor.compress(src, _block_size,
+			                                         _compressed, capacity);
+
+			/*
+			 * Acquire the new chunk before releasing the old one to keep
+			 * a shared chunk with the same content alive.
+			 */
+			Chunk * const c = size ? _acquire(_compressed, size)
+			                       : _acquire((uint8_t const *)src, _block_size);
+			if (!c)
+				return false;
+
+			_assign(block, c);
+			return true;
+		}
+
+		/**
+		 * Drop content of block, which reads as zeros afterwards
+		 */
+		void discard(size_t block) { _assign(block, 0); }
+
+		/**
+		 * Statistics
+		 */
+		size_t num_nonzero_blocks() const { return _num_refs;   }
+		size_t num_chunks()         const { return _num_chunks; }
+		size_t used_bytes()         const { return _used_bytes; }
+};
+
+#endif /* _BLOCK_STORE_H_ */
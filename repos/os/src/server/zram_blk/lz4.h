@@ -0,0 +1,248 @@
+/*
+ * \brief  Compressor and decompressor for the LZ4 block format
+ * \author Norman Feske
+ * \date   2015-12-30
+ *
+ * The implementation covers the LZ4 block format only, which suffices for
+ * compressing individual device blocks. The compressor uses a greedy
+ * strategy with a single hash table of recent positions, which trades
+ * compression ratio for speed.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LZ4_H_
+#define _LZ4_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+#include <util/misc_math.h>
+#include <util/string.h>
+
+namespace Lz4 {
+
+	using Genode::size_t;
+	using Genode::uint8_t;
+	using Genode::uint16_t;
+	using Genode::uint32_t;
+
+	class Compressor;
+
+	bool decompress(void const *src, size_t src_len, void *dst, size_t dst_len);
+
+	enum {
+		MIN_MATCH     = 4,
+		LAST_LITERALS = 5,         /* number of literals at the end of input */
+		MF_LIMIT      = 12,        /* no match starts within the last bytes */
+		MAX_OFFSET    = 0xffff,
+		MAX_INPUT     = 64*1024,   /* positions are stored as 16-bit values */
+	};
+}
+
+
+class Lz4::Compressor
+{
+	private:
+
+		enum { HASH_BITS = 12 };
+
+		uint16_t _table[1 << HASH_BITS];
+
+		static uint32_t _read32(uint8_t const *p)
+		{
+			return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+		}
+
+		static unsigned _hash(uint32_t v) {
+			return (v*2654435761U) >> (32 - HASH_BITS); }
+
+		static void _put_length(uint8_t *dst, size_t &out, size_t len)
+		{
+			for (; len >= 255; len -= 255)
+				dst[out++] = 255;
+
+			dst[out++] = len;
+		}
+
+		/**
+		 * Append sequence of literals followed by an optional match
+		 *
+		 * \param match_len  length of match, or 0 for the last sequence
+		 *
+		 * \return  false if the output buffer is exhausted
+		 */
+		static bool _sequence(uint8_t *dst, size_t dst_cap, size_t &out,
+		                      uint8_t const *literals, size_t literal_len,
+		                      size_t offset, size_t match_len)
+		{
+			size_t const ml = match_len ? match_len - MIN_MATCH : 0;
+
+			/* upper bound of the sequence size */
+			size_t const needed = 1 + literal_len + literal_len/255 + 1
+			                    + (match_len ? 2 + ml/255 + 1 : 0);
+
+			if (out + needed > dst_cap)
+				return false;
+
+			uint8_t &token = dst[out++];
+			token = (Genode::min(literal_len, (size_t)15) << 4)
+			      |  Genode::min(ml,          (size_t)15);
+
+			if (literal_len >= 15)
+				_put_length(dst, out, literal_len - 15);
+
+			Genode::memcpy(dst + out, literals, literal_len);
+			out += literal_len;
+
+			if (!match_len)
+				return true;
+
+			dst[out++] = offset & 0xff;
+			dst[out++] = offset >> 8;
+
+			if (ml >= 15)
+				_put_length(dst, out, ml - 15);
+
+			return true;
+		}
+
+	public:
+
+		/**
+		 * Compress 'src_len' bytes at 'src' into 'dst'
+		 *
+		 * \return  size of compressed data, or 0 if the compressed data
+		 *          would exceed 'dst_cap' bytes
+		 */
+		size_t compress(void const *src_ptr, size_t src_len,
+		                void *dst_ptr, size_t dst_cap)
+		{
+			if (src_len > MAX_INPUT)
+				return 0;
+
+			uint8_t const * const src = (uint8_t const *)src_ptr;
+			uint8_t       * const dst = (uint8_t       *)dst_ptr;
+
+			/*
+			 * Stale table entries are harmless because each candidate is
+			 * verified by comparing the input.
+			 */
+			Genode::memset(_table, 0, sizeof(_table));
+
+			size_t const mf_limit    = src_len > MF_LIMIT ? src_len - MF_LIMIT : 0;
+			size_t const match_limit = src_len - Genode::min(src_len, (size_t)LAST_LITERALS);
+
+			size_t out = 0, anchor = 0, pos = 0;
+
+			while (pos < mf_limit) {
+
+				uint32_t const sequence = _read32(src + pos);
+				unsigned const h        = _hash(sequence);
+				size_t   const ref      = _table[h];
+
+				_table[h] = pos;
+
+				if (ref >= pos || pos - ref > MAX_OFFSET
+				 || _read32(src + ref) != sequence) {
+					pos++;
+					continue;
+				}
+
+				size_t len = MIN_MATCH;
+				while (pos + len < match_limit && src[ref + len] == src[pos + len])
+					len++;
+
+				if (!_sequence(dst, dst_cap, out, src + anchor, pos - anchor,
+				               pos - ref, len))
+					return 0;
+
+				pos   += len;
+				anchor = pos;
+			}
+
+			if (!_sequence(dst, dst_cap, out, src + anchor, src_len - anchor, 0, 0))
+				return 0;
+
+			return out;
+		}
+};
+
+
+/**
+ * Decompress LZ4 block
+ *
+ * \return  false if the compressed data is malformed or does not
+ *          decompress to exactly 'dst_len' bytes
+ */
+inline bool Lz4::decompress(void const *src_ptr, size_t src_len,
+                            void *dst_ptr, size_t dst_len)
+{
+	uint8_t const * const src = (uint8_t const *)src_ptr;
+	uint8_t       * const dst = (uint8_t       *)dst_ptr;
+
+	size_t in = 0, out = 0;
+
+	auto length = [&] (size_t &len) -> bool
+	{
+		for (;;) {
+			if (in >= src_len)
+				return false;
+
+			uint8_t const b = src[in++];
+			len += b;
+			if (b != 255)
+				return true;
+		}
+	};
+
+	for (;;) {
+
+		if (in >= src_len)
+			return false;
+
+		uint8_t const token = src[in++];
+
+		size_t literal_len = token >> 4;
+		if (literal_len == 15 && !length(literal_len))
+			return false;
+
+		if (literal_len > src_len - in || literal_len > dst_len - out)
+			return false;
+
+		Genode::memcpy(dst + out, src + in, literal_len);
+		in  += literal_len;
+		out += literal_len;
+
+		/* the last sequence consists of literals only */
+		if (in == src_len)
+			return out == dst_len;
+
+		if (src_len - in < 2)
+			return false;
+
+		size_t const offset = src[in] | (src[in + 1] << 8);
+		in += 2;
+
+		if (!offset || offset > out)
+			return false;
+
+		size_t match_len = token & 15;
+		if (match_len == 15 && !length(match_len))
+			return false;
+
+		match_len += MIN_MATCH;
+		if (match_len > dst_len - out)
+			return false;
+
+		/* copy byte-wise because source and destination may overlap */
+		for (size_t i = 0; i < match_len; i++, out++)
+			dst[out] = dst[out - offset];
+	}
+}
+
+#endif /* _LZ4_H_ */
@@ -0,0 +1,240 @@
+/*
+ * \brief  Compressed and deduplicating RAM block device
+ * \author Norman Feske
+ * \date   2015-12-30
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <os/attached_rom_dataspace.h>
+#include <os/config.h>
+#include <os/server.h>
+#include <rom_session/connection.h>
+#include <block/component.h>
+#include <block/driver.h>
+
+/* local includes */
+#include "block_store.h"
+
+namespace Zram_blk { class Driver; }
+
+using namespace Genode;
+
+
+class Zram_blk::Driver : public Block::Driver
+{
+	private:
+
+		Block_store _store;
+
+		bool _in_range(Block::sector_t block_number, size_t block_count)
+		{
+			if (block_number + block_count <= _store.block_count())
+				return true;
+
+			PWRN("requested blocks %lld-%lld out of range!",
+			     block_number, block_number + block_count);
+			return false;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param init  optional initial content
+		 */
+		Driver(size_t block_size, size_t block_count,
+		       Attached_rom_dataspace *init)
+		:
+			_store(block_size, block_count)
+		{
+			if (!init)
+				return;
+
+			char const * const src = init->local_addr<char const>();
+			for (size_t i = 0; i < block_count; i++)
+				if (!_store.write(i, src + i*block_size)) {
+					PERR("insufficient quota for initial content");
+					throw Root::Quota_exceeded();
+				}
+
+			PINF("initial content consumes %zd bytes for %zd non-zero blocks",
+			     _store.used_bytes(), _store.num_nonzero_blocks());
+		}
+
+
+		/****************************
+		 ** Block-driver interface **
+		 ****************************/
+
+		Genode::size_t  block_size()  { return _store.block_size();  }
+		Block::sector_t block_count() { return _store.block_count(); }
+
+		Block::Session::Operations ops()
+		{
+			Block::Session::Operations o;
+			o.set_operation(Block::Packet_descriptor::READ);
+			o.set_operation(Block::Packet_descriptor::WRITE);
+			o.set_operation(Block::Packet_descriptor::TRIM);
+			return o;
+		}
+
+		void read(Block::sector_t    block_number,
+		          size_t             block_count,
+		          char*              buffer,
+		          Block::Packet_descriptor &packet)
+		{
+			if (!_in_range(block_number, block_count)) {
+				ack_packet(packet, false);
+				return;
+			}
+
+			bool ok = true;
+			for (size_t i = 0; i < block_count && ok; i++)
+				ok = _store.read(block_number + i,
+				                 buffer + i*_store.block_size());
+
+			if (!ok)
+				PERR("stored content of blocks %lld-%lld is corrupt",
+				     block_number, block_number + block_count);
+
+			ack_packet(packet, ok);
+		}
+
+		void write(Block::sector_t  block_number,
+		           Genode::size_t   block_count,
+		           const char *     buffer,
+		           Block::Packet_descriptor &packet)
+		{
+			if (!_in_range(block_number, block_count)) {
+				ack_packet(packet, false);
+				return;
+			}
+
+			bool ok = true;
+			for (size_t i = 0; i < block_count && ok; i++)
+				ok = _store.write(block_number + i,
+				                  buffer + i*_store.block_size());
+
+			if (!ok)
+				PWRN("out of memory, write of blocks %lld-%lld failed",
+				     block_number, block_number + block_count);
+
+			ack_packet(packet, ok);
+		}
+
+		void trim(Block::sector_t    block_number,
+		          Genode::size_t     block_count,
+		          Block::Packet_descriptor &packet)
+		{
+			if (!_in_range(block_number, block_count)) {
+				ack_packet(packet, false);
+				return;
+			}
+
+			for (size_t i = 0; i < block_count; i++)
+				_store.discard(block_number + i);
+
+			ack_packet(packet);
+		}
+};
+
+
+struct Main
+{
+	Server::Entrypoint &ep;
+
+	struct Factory : Block::Driver_factory
+	{
+		Block::Driver *create()
+		{
+			Xml_node const config = Genode::config()->xml_node();
+
+			char file[64] = { 0 };
+			try { config.attribute("file").value(file, sizeof(file)); }
+			catch (...) { }
+
+			size_t const blk_sz = config.attribute_value("block_size", (size_t)4096);
+
+			Number_of_bytes size = config.attribute_value("size", Number_of_bytes(0));
+
+			if (blk_sz < 512 || blk_sz > Lz4::MAX_INPUT || (blk_sz & (blk_sz - 1))) {
+				PERR("invalid block size %zd", blk_sz);
+				throw Root::Unavailable();
+			}
+
+			Attached_rom_dataspace *init = 0;
+
+			if (file[0]) {
+				try {
+					init = new (env()->heap()) Attached_rom_dataspace(file);
+				} catch (Rom_connection::Rom_connection_failed) {
+					PERR("Cannot open file %s.", file);
+					throw Root::Unavailable();
+				}
+
+				if (!size)
+					size = init->size();
+
+				if (init->size() < (size_t)size) {
+					PERR("file %s is smaller than the device", file);
+					Genode::destroy(env()->heap(), init);
+					throw Root::Unavailable();
+				}
+			}
+
+			size_t const blk_cnt = size/blk_sz;
+
+			if (!blk_cnt) {
+				PERR("missing or invalid 'size' attribute");
+				throw Root::Unavailable();
+			}
+
+			PINF("Providing %zd blocks with block size %zd%s%s.", blk_cnt, blk_sz,
+			     file[0] ? ", initialized from " : "", file);
+
+			try {
+				Block::Driver *driver = new (env()->heap())
+					Zram_blk::Driver(blk_sz, blk_cnt, init);
+
+				/* the initial content is kept in the compressed store only */
+				if (init)
+					Genode::destroy(env()->heap(), init);
+
+				return driver;
+			} catch (...) {
+				if (init)
+					Genode::destroy(env()->heap(), init);
+				throw;
+			}
+		}
+
+		void destroy(Block::Driver *driver) {
+			Genode::destroy(env()->heap(), driver); }
+	} factory;
+
+	Block::Root root;
+
+	Main(Server::Entrypoint &ep)
+	: ep(ep), root(ep, Genode::env()->heap(), factory) {
+		Genode::env()->parent()->announce(ep.manage(root)); }
+};
+
+
+/************
+ ** Server **
+ ************/
+
+namespace Server {
+	char const *name()             { return "zram_blk_ep";       }
+	size_t stack_size()            { return 2*1024*sizeof(long); }
+	void construct(Entrypoint &ep) { static Main server(ep);     }
+}
@@ -0,0 +1,3 @@
+TARGET = zram_blk
+SRC_CC = main.cc
+LIBS   = base config server
@@ -24,7 +24,7 @@ static bool single_packet_roundtrip(Nic::Session  *nic,
                                     unsigned char  content_pattern,
                                     size_t         packet_size)
 {
-	Packet_descriptor tx_packet;
+	Nic::Packet_descriptor tx_packet;
 
 	printf("single_packet_roundtrip(content='%c', packet_size=%zd)\n",
 	       content_pattern, packet_size);
@@ -48,7 +48,7 @@ static bool single_packet_roundtrip(Nic::Session  *nic,
 	nic->tx()->submit_packet(tx_packet);
 
 	/* wait for acknowledgement */
-	Packet_descriptor ack_tx_packet = nic->tx()->get_acked_packet();
+	Nic::Packet_descriptor ack_tx_packet = nic->tx()->get_acked_packet();
 
 	if (ack_tx_packet.size()   != tx_packet.size()
 	 || ack_tx_packet.offset() != tx_packet.offset()) {
@@ -61,7 +61,7 @@ static bool single_packet_roundtrip(Nic::Session  *nic,
 	 * the same packet to be available at the rx channel of the NIC
 	 * session.
 	 */
-	Packet_descriptor rx_packet = nic->rx()->get_packet();
+	Nic::Packet_descriptor rx_packet = nic->rx()->get_packet();
 	printf("received rx packet (offset=%ld, size=%zd)\n",
 	       tx_packet.offset(), tx_packet.size());
 
@@ -117,7 +117,7 @@ static bool batch_packets(Nic::Session *nic, unsigned num_packets)
 		    && tx_cnt - rx_cnt < max_outstanding_requests) {
 
 			try {
-				Packet_descriptor tx_packet = nic->tx()->alloc_packet(PACKET_SIZE);
+				Nic::Packet_descriptor tx_packet = nic->tx()->alloc_packet(PACKET_SIZE);
 				nic->tx()->submit_packet(tx_packet);
 				tx_cnt++;
 			} catch (Nic::Session::Tx::Source::Packet_alloc_failed) {
@@ -129,7 +129,7 @@ static bool batch_packets(Nic::Session *nic, unsigned num_packets)
 
 		/* check for acknowledgements */
 		while (nic->tx()->ack_avail()) {
-			Packet_descriptor acked_packet = nic->tx()->get_acked_packet();
+			Nic::Packet_descriptor acked_packet = nic->tx()->get_acked_packet();
 			nic->tx()->release_packet(acked_packet);
 			acked_cnt++;
 			batch_acked_cnt++;
@@ -137,7 +137,7 @@ static bool batch_packets(Nic::Session *nic, unsigned num_packets)
 
 		/* check for available rx packets */
 		while (nic->rx()->packet_avail() && nic->rx()->ready_to_ack()) {
-			Packet_descriptor rx_packet = nic->rx()->get_packet();
+			Nic::Packet_descriptor rx_packet = nic->rx()->get_packet();
 
 			if (!nic->rx()->ready_to_ack())
 				PWRN("not ready for ack, going to blocK");
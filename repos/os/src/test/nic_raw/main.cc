@@ -79,7 +79,7 @@ class Nic_worker : public Genode::Thread<STACK_SIZE>
 
 			while(true)
 			{
-				Packet_descriptor rx_packet = _nic->rx()->get_packet();
+				Nic::Packet_descriptor rx_packet = _nic->rx()->get_packet();
 
 				Net::Ethernet_frame *eth =
 					new (_nic->rx()->packet_content(rx_packet)) Net::Ethernet_frame(rx_packet.size());
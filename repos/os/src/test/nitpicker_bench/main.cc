@@ -0,0 +1,228 @@
+/*
+ * \brief  Load generator for benchmarking nitpicker
+ * \author Norman Feske
+ * \date   2015-12-23
+ *
+ * The test opens a number of nitpicker sessions, each displaying one view.
+ * The views are cascaded with a configurable overlap and may use an alpha
+ * channel. Each period, every client changes its view according to the
+ * configured update pattern. The resulting compose times are measured by
+ * nitpicker itself and published via its 'frame_time' report.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/snprintf.h>
+#include <nitpicker_session/connection.h>
+#include <timer_session/connection.h>
+#include <os/pixel_rgb565.h>
+#include <os/config.h>
+
+using namespace Genode;
+
+namespace Test {
+
+	enum Pattern { FULL, PARTIAL, MOVE };
+
+	struct Parameters;
+	class  Client;
+}
+
+
+struct Test::Parameters
+{
+	unsigned clients;
+	unsigned width, height;
+	unsigned overlap;      /* percent of a view covered by the next one */
+	bool     alpha;
+	Pattern  pattern;
+	unsigned rect_size;    /* edge length of partial updates */
+	unsigned period_ms;
+	unsigned duration_ms;
+};
+
+
+class Test::Client
+{
+	private:
+
+		typedef Nitpicker::Session::View_handle View_handle;
+		typedef Nitpicker::Session::Command     Command;
+
+		Parameters const &_params;
+
+		Nitpicker::Connection _nitpicker;
+
+		Framebuffer::Mode const _mode { (int)_params.width, (int)_params.height,
+		                                Framebuffer::Mode::RGB565 };
+
+		Pixel_rgb565 *_pixels = nullptr;
+
+		View_handle _view;
+
+		Nitpicker::Point _pos;
+
+		unsigned _frame = 0;
+
+		static char const *_label(unsigned index)
+		{
+			static char label[16];
+			snprintf(label, sizeof(label), "client%u", index);
+			return label;
+		}
+
+		void _fill(unsigned x0, unsigned y0, unsigned w, unsigned h,
+		           Pixel_rgb565 color)
+		{
+			for (unsigned y = y0; y < y0 + h; y++)
+				for (unsigned x = x0; x < x0 + w; x++)
+					_pixels[y*_params.width + x] = color;
+		}
+
+		void _geometry()
+		{
+			Nitpicker::Rect const rect(_pos, Nitpicker::Area(_params.width,
+			                                                 _params.height));
+			_nitpicker.enqueue<Command::Geometry>(_view, rect);
+		}
+
+	public:
+
+		Client(Parameters const &params, unsigned index)
+		:
+			_params(params), _nitpicker(_label(index))
+		{
+			_nitpicker.buffer(_mode, _params.alpha);
+
+			_pixels = env()->rm_session()->attach(_nitpicker.framebuffer()->dataspace());
+
+			unsigned const num_pixels = _params.width*_params.height;
+
+			_fill(0, 0, _params.width, _params.height,
+			      Pixel_rgb565(index*40 % 256, 128, 255 - index*40 % 256));
+
+			/* the alpha channel and the input mask follow the pixels */
+			if (_params.alpha) {
+				unsigned char *alpha = (unsigned char *)&_pixels[num_pixels];
+				memset(alpha, 0x80, num_pixels);
+				memset(alpha + num_pixels, 1, num_pixels);
+			}
+
+			unsigned const step_x = _params.width *(100 - _params.overlap)/100;
+			unsigned const step_y = _params.height*(100 - _params.overlap)/100;
+
+			_pos = Nitpicker::Point(index*step_x, index*step_y);
+
+			_view = _nitpicker.create_view();
+			_geometry();
+			_nitpicker.enqueue<Command::To_front>(_view);
+			_nitpicker.execute();
+		}
+
+		/**
+		 * Apply the update pattern for the next frame
+		 */
+		void update()
+		{
+			_frame++;
+
+			Pixel_rgb565 const color(_frame*8 % 256, _frame*4 % 256, 128);
+
+			switch (_params.pattern) {
+
+			case FULL:
+				_fill(0, 0, _params.width, _params.height, color);
+				_nitpicker.framebuffer()->refresh(0, 0, _params.width, _params.height);
+				break;
+
+			case PARTIAL:
+				{
+					unsigned const size = min(_params.rect_size,
+					                          min(_params.width, _params.height));
+					/* visit the tiles of the buffer row by row */
+					unsigned const cols = _params.width/size;
+					unsigned const rows = _params.height/size;
+					unsigned const x = (_frame % cols)*size;
+					unsigned const y = ((_frame/cols) % rows)*size;
+
+					_fill(x, y, size, size, color);
+					_nitpicker.framebuffer()->refresh(x, y, size, size);
+				}
+				break;
+
+			case MOVE:
+				{
+					/* move the view back and forth by 16 pixels */
+					int const offset = (_frame & 16) ? -1 : 1;
+					_pos = Nitpicker::Point(_pos.x() + offset, _pos.y());
+					_geometry();
+					_nitpicker.execute();
+				}
+				break;
+			}
+		}
+};
+
+
+static Test::Pattern pattern(Xml_node config)
+{
+	try {
+		if (config.attribute("update").has_value("partial")) return Test::PARTIAL;
+		if (config.attribute("update").has_value("move"))    return Test::MOVE;
+	} catch (...) { }
+
+	return Test::FULL;
+}
+
+
+int main(int, char **)
+{
+	using namespace Test;
+
+	Xml_node const config = Genode::config()->xml_node();
+
+	Parameters const params = {
+		max(config.attribute_value("clients", 4U), 1U),
+		max(config.attribute_value("width",   400U), 1U),
+		max(config.attribute_value("height",  300U), 1U),
+		min(config.attribute_value("overlap", 50U), 100U),
+		config.attribute_value("alpha", false),
+		pattern(config),
+		max(config.attribute_value("rect_size", 64U), 1U),
+		max(config.attribute_value("period_ms", 10U), 1U),
+		config.attribute_value("duration_ms", 10000U)
+	};
+
+	printf("--- nitpicker_bench: %u clients of %ux%u, overlap %u%%, alpha %s ---\n",
+	       params.clients, params.width, params.height, params.overlap,
+	       params.alpha ? "yes" : "no");
+
+	Client **clients = new (env()->heap()) Client*[params.clients];
+	for (unsigned i = 0; i < params.clients; i++)
+		clients[i] = new (env()->heap()) Client(params, i);
+
+	Timer::Connection timer;
+
+	unsigned long const start_ms = timer.elapsed_ms();
+	unsigned long       frames   = 0;
+
+	while (timer.elapsed_ms() - start_ms < params.duration_ms) {
+
+		for (unsigned i = 0; i < params.clients; i++)
+			clients[i]->update();
+
+		frames++;
+		timer.msleep(params.period_ms);
+	}
+
+	printf("--- nitpicker_bench finished after %lu frames ---\n", frames);
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-nitpicker_bench
+SRC_CC = main.cc
+LIBS   = base config
@@ -0,0 +1,358 @@
+/*
+ * \brief  Micro benchmarks of kernel primitives
+ * \author Norman Feske
+ * \date   2015-12-20
+ *
+ * The benchmarks measure the costs of the primitives that are implemented
+ * differently by each kernel, namely the RPC round trip with and without
+ * capability transfer, the signal round trip, the resolution of page
+ * faults, and the creation of threads. Each sample is taken with the
+ * CPU-local cycle counter. The results are printed as one '<result>' line
+ * per benchmark, which can be compared across kernels and platforms.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <base/thread.h>
+#include <base/env.h>
+#include <base/signal.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <cap_session/connection.h>
+#include <timer_session/connection.h>
+#include <os/attached_ram_dataspace.h>
+#include <os/config.h>
+#include <trace/timestamp.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Session;
+	struct Client;
+	struct Component;
+	class  Samples;
+	struct Signal_echo;
+	struct Idle_thread;
+
+	typedef Genode::uint64_t uint64_t;
+
+	enum { STACK_SIZE = 4096*sizeof(long) };
+}
+
+
+struct Test::Session : Genode::Session
+{
+	static const char *service_name() { return "PERF_MICRO"; }
+
+	GENODE_RPC(Rpc_null, void, null);
+	GENODE_RPC(Rpc_cap, void, cap, Genode::Native_capability);
+	GENODE_RPC_INTERFACE(Rpc_null, Rpc_cap);
+};
+
+
+struct Test::Client : Genode::Rpc_client<Session>
+{
+	Client(Capability<Session> cap) : Rpc_client<Session>(cap) { }
+
+	void null()                     { call<Rpc_null>(); }
+	void cap(Native_capability cap) { call<Rpc_cap>(cap); }
+};
+
+
+struct Test::Component : Genode::Rpc_object<Session, Component>
+{
+	void null() { }
+	void cap(Native_capability) { }
+};
+
+
+/**
+ * Samples of one benchmark, measured in cycles
+ */
+class Test::Samples
+{
+	private:
+
+		uint64_t * const _samples;
+		unsigned   const _capacity;
+		unsigned         _count = 0;
+
+		uint64_t const _cycles_per_ms;
+
+		/*
+		 * Shell sort suffices for the few thousand samples of a benchmark
+		 * and does not need any memory besides the samples.
+		 */
+		void _sort()
+		{
+			for (unsigned gap = _count/2; gap > 0; gap /= 2)
+				for (unsigned i = gap; i < _count; i++) {
+					uint64_t const v = _samples[i];
+					unsigned j = i;
+					for (; j >= gap && _samples[j - gap] > v; j -= gap)
+						_samples[j] = _samples[j - gap];
+					_samples[j] = v;
+				}
+		}
+
+		uint64_t _percentile(unsigned percent) const {
+			return _samples[((_count - 1)*percent)/100]; }
+
+		unsigned long long _ns(uint64_t cycles) const {
+			return (cycles*1000*1000)/_cycles_per_ms; }
+
+	public:
+
+		Samples(uint64_t *samples, unsigned capacity, uint64_t cycles_per_ms)
+		:
+			_samples(samples), _capacity(capacity), _cycles_per_ms(cycles_per_ms)
+		{ }
+
+		/**
+		 * Add cycles elapsed between the timestamps 'start' and 'end'
+		 *
+		 * The difference is computed with the width of the counter, which
+		 * is only 32 bit on ARM.
+		 */
+		void add(Trace::Timestamp start, Trace::Timestamp end)
+		{
+			if (_count < _capacity)
+				_samples[_count++] = (Trace::Timestamp)(end - start);
+		}
+
+		/**
+		 * Print results in the form of a '<result>' line
+		 */
+		void print(char const *name)
+		{
+			if (!_count) {
+				PERR("no samples for %s", name);
+				return;
+			}
+
+			_sort();
+
+			uint64_t sum = 0;
+			for (unsigned i = 0; i < _count; i++)
+				sum += _samples[i];
+
+			uint64_t const mean = sum/_count;
+			uint64_t const p50  = _percentile(50);
+			uint64_t const p90  = _percentile(90);
+			uint64_t const p99  = _percentile(99);
+			uint64_t const max  = _samples[_count - 1];
+
+			printf("<result name=\"%s\" samples=\"%u\""
+			       " mean_cycles=\"%llu\" p50_cycles=\"%llu\" p90_cycles=\"%llu\""
+			       " p99_cycles=\"%llu\" max_cycles=\"%llu\""
+			       " mean_ns=\"%llu\" p50_ns=\"%llu\" p90_ns=\"%llu\""
+			       " p99_ns=\"%llu\" max_ns=\"%llu\"/>\n",
+			       name, _count,
+			       (unsigned long long)mean, (unsigned long long)p50,
+			       (unsigned long long)p90,  (unsigned long long)p99,
+			       (unsigned long long)max,
+			       _ns(mean), _ns(p50), _ns(p90), _ns(p99), _ns(max));
+		}
+};
+
+
+/**
+ * Thread that answers each signal with a signal of its own
+ */
+struct Test::Signal_echo : Genode::Thread<STACK_SIZE>
+{
+	Signal_receiver    receiver;
+	Signal_context     context;
+	Signal_transmitter reply;
+	unsigned const     rounds;
+
+	Signal_echo(Signal_context_capability reply, unsigned rounds)
+	:
+		Thread("signal_echo"), reply(reply), rounds(rounds)
+	{ }
+
+	Signal_context_capability cap() { return receiver.manage(&context); }
+
+	void entry()
+	{
+		for (unsigned i = 0; i < rounds; i++) {
+			receiver.wait_for_signal();
+			reply.submit();
+		}
+	}
+};
+
+
+struct Test::Idle_thread : Genode::Thread<STACK_SIZE>
+{
+	Idle_thread() : Thread("idle") { }
+
+	void entry() { }
+};
+
+
+/**
+ * Return number of cycles per millisecond
+ *
+ * The cycle counter is compared against the timer over the given period.
+ */
+static Test::uint64_t cycles_per_ms(Timer::Session &timer, unsigned period_ms)
+{
+	using namespace Genode;
+
+	unsigned long    const ms_start = timer.elapsed_ms();
+	Trace::Timestamp const ts_start = Trace::timestamp();
+
+	timer.msleep(period_ms);
+
+	Trace::Timestamp const ts_end = Trace::timestamp();
+	unsigned long    const ms_end = timer.elapsed_ms();
+
+	unsigned long const ms = ms_end > ms_start ? ms_end - ms_start : 1;
+
+	return Genode::max((Test::uint64_t)(Trace::Timestamp)(ts_end - ts_start)/ms,
+	                   (Test::uint64_t)1);
+}
+
+
+int main(int argc, char **argv)
+{
+	using namespace Test;
+
+	printf("--- perf_micro started ---\n");
+
+	unsigned iterations    = 10000;
+	unsigned thread_rounds = 100;
+	unsigned fault_pages   = 1024;
+	unsigned calibrate_ms  = 100;
+
+	try {
+		Xml_node config = Genode::config()->xml_node();
+		config.attribute("iterations").value(&iterations);
+		config.attribute("threads").value(&thread_rounds);
+		config.attribute("pages").value(&fault_pages);
+		config.attribute("calibrate_ms").value(&calibrate_ms);
+	} catch (...) { }
+
+	Timer::Connection timer;
+
+	/*
+	 * With a cycle counter of 32 bit, as on ARM, the calibration period
+	 * must not exceed the wrap-around of the counter.
+	 */
+	uint64_t const freq = cycles_per_ms(timer, calibrate_ms);
+	printf("<calibration cycles_per_ms=\"%llu\"/>\n", (unsigned long long)freq);
+
+	unsigned const capacity = Genode::max(iterations,
+	                                      Genode::max(thread_rounds, fault_pages));
+
+	uint64_t *samples = new (env()->heap()) uint64_t[capacity];
+
+	/*
+	 * The component serves the RPCs by a dedicated entrypoint. So each
+	 * RPC passes the kernel's IPC path just as an RPC between components.
+	 */
+	static Cap_connection cap;
+	static Rpc_entrypoint ep(&cap, STACK_SIZE, "perf_micro_ep");
+	static Component      component;
+
+	Capability<Test::Session> session_cap = ep.manage(&component);
+	Client client(session_cap);
+
+	/* RPC round trip without payload */
+	{
+		Samples s(samples, capacity, freq);
+		for (unsigned i = 0; i < iterations; i++) {
+			Trace::Timestamp const start = Trace::timestamp();
+			client.null();
+			s.add(start, Trace::timestamp());
+		}
+		s.print("rpc_roundtrip");
+	}
+
+	/* RPC round trip that delegates a capability to the server */
+	{
+		Samples s(samples, capacity, freq);
+		for (unsigned i = 0; i < iterations; i++) {
+			Trace::Timestamp const start = Trace::timestamp();
+			client.cap(session_cap);
+			s.add(start, Trace::timestamp());
+		}
+		s.print("rpc_cap_transfer");
+	}
+
+	/*
+	 * Signal round trip between two threads. Each sample covers the
+	 * submission of a signal, the wakeup of the echo thread, and the
+	 * submission and reception of the answer.
+	 */
+	{
+		Signal_receiver receiver;
+		Signal_context  context;
+
+		Signal_echo echo(receiver.manage(&context), iterations);
+		Signal_transmitter transmitter(echo.cap());
+		echo.start();
+
+		Samples s(samples, capacity, freq);
+		for (unsigned i = 0; i < iterations; i++) {
+			Trace::Timestamp const start = Trace::timestamp();
+			transmitter.submit();
+			receiver.wait_for_signal();
+			s.add(start, Trace::timestamp());
+		}
+		s.print("signal_roundtrip");
+
+		echo.join();
+		echo.receiver.dissolve(&echo.context);
+		receiver.dissolve(&context);
+	}
+
+	/*
+	 * Page fault on the first access of each page of a freshly attached
+	 * dataspace. The sample includes the fault resolution by the pager and
+	 * the kernel's mapping operation.
+	 */
+	{
+		enum { PAGE_SIZE = 4096 };
+
+		Attached_ram_dataspace ds(env()->ram_session(), fault_pages*PAGE_SIZE);
+		char volatile * const base = ds.local_addr<char volatile>();
+
+		Samples s(samples, capacity, freq);
+		for (unsigned i = 0; i < fault_pages; i++) {
+			Trace::Timestamp const start = Trace::timestamp();
+			base[i*PAGE_SIZE] = 1;
+			s.add(start, Trace::timestamp());
+		}
+		s.print("page_fault");
+	}
+
+	/* creation, start, join, and destruction of a thread */
+	{
+		Samples s(samples, capacity, freq);
+		for (unsigned i = 0; i < thread_rounds; i++) {
+			Trace::Timestamp const start = Trace::timestamp();
+			{
+				Idle_thread thread;
+				thread.start();
+				thread.join();
+			}
+			s.add(start, Trace::timestamp());
+		}
+		s.print("thread_create");
+	}
+
+	ep.dissolve(&component);
+
+	printf("--- perf_micro finished ---\n");
+	return 0;
+}
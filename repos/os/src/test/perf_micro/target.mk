@@ -0,0 +1,3 @@
+TARGET = test-perf_micro
+SRC_CC = main.cc
+LIBS   = base config
@@ -0,0 +1,134 @@
+/*
+ * \brief  Unit test for RAM fs extent data structure
+ * \author Norman Feske
+ * \date   2015-11-25
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <ram_fs/extents.h>
+
+namespace File_system {
+
+	/* inline size of 4 bytes, extents of 8 to 32 bytes */
+	typedef Extents<4, 3, 5> Content;
+}
+
+
+namespace Genode {
+
+	struct Allocator_tracer : Allocator
+	{
+		size_t     _sum;
+		Allocator &_wrapped;
+
+		Allocator_tracer(Allocator &wrapped) : _sum(0), _wrapped(wrapped) { }
+
+		size_t sum() const { return _sum; }
+
+		bool alloc(size_t size, void **out_addr)
+		{
+			_sum += size;
+			return _wrapped.alloc(size, out_addr);
+		}
+
+		void free(void *addr, size_t size)
+		{
+			_sum -= size;
+			_wrapped.free(addr, size);
+		}
+
+		size_t overhead(size_t size) const override { return _wrapped.overhead(size); }
+		bool    need_size_for_free() const override { return _wrapped.need_size_for_free(); }
+	};
+};
+
+
+static Genode::size_t length;
+
+
+static void dump(File_system::Content &content)
+{
+	using namespace Genode;
+
+	static char read_buf[256];
+
+	struct File_size_out_of_bounds { };
+	if (length > sizeof(read_buf))
+		throw File_size_out_of_bounds();
+
+	content.read(read_buf, length, 0);
+
+	printf("content (size=%zd, allocated=%zd): \"", length,
+	       (size_t)content.allocated());
+	for (unsigned i = 0; i < length; i++) {
+		char c = read_buf[i];
+		if (c)
+			printf("%c", c);
+		else
+			printf(".");
+	}
+	printf("\"\n");
+}
+
+
+static void write(File_system::Content &content,
+                  char const *str, Genode::off_t seek_offset)
+{
+	using namespace Genode;
+	printf("write \"%s\" at offset %ld -> ", str, seek_offset);
+	content.write(str, strlen(str), seek_offset);
+	length = max(length, (size_t)(seek_offset + strlen(str)));
+	dump(content);
+}
+
+
+static void truncate(File_system::Content &content, Genode::size_t size)
+{
+	using namespace Genode;
+	printf("trunc(%zd) -> ", size);
+	content.truncate(size);
+	length = size;
+	dump(content);
+}
+
+
+int main(int, char **)
+{
+	using namespace File_system;
+	using namespace Genode;
+
+	printf("--- ram_fs_extents test ---\n");
+
+	static Allocator_tracer alloc(*env()->heap());
+
+	{
+		Content content(alloc);
+
+		/* fits inline */
+		write(content, "five", 0);
+
+		/* grows first extent */
+		write(content, "-o-one", 4);
+
+		/* overwrite part of the file */
+		write(content, "five", 7);
+
+		/* write to positions beyond current file length */
+		write(content, "Nuance", 17);
+		write(content, "YM-2149", 35);
+
+		/* sparse write into a maximum-sized extent */
+		write(content, "AY-3-8910", 100);
+
+		truncate(content, 40);
+
+		for (unsigned i = 39; i > 0; i -= 3)
+			truncate(content, i);
+	}
+
+	printf("allocator: sum=%zd\n", alloc.sum());
+
+	return 0;
+}
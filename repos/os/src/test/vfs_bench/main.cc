@@ -0,0 +1,346 @@
+/*
+ * \brief  File-system benchmark
+ * \author Norman Feske
+ * \date   2015-12-22
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/*
+ * In contrast to 'vfs_stress', which checks the VFS for correctness, this
+ * test measures the throughput of a file system under a defined load. The
+ * load consists of timed phases, each executed by a number of threads in
+ * parallel. Each thread works within its own directory:
+ *
+ * create        - create empty files
+ * stat          - stat each file
+ * small_write   - open each file, write a small payload, close the file
+ * small_read    - open each file, read the payload, close the file
+ * unlink        - unlink each file
+ * stream_write  - write one large file in chunks
+ * stream_read   - read the large file in chunks
+ *
+ * At the end of each phase, one '<phase>' line with the number of
+ * operations, the transferred bytes, and the resulting rates is printed.
+ */
+
+/* Genode includes */
+#include <vfs/file_system_factory.h>
+#include <vfs/dir_file_system.h>
+#include <timer_session/connection.h>
+#include <base/process.h>
+#include <os/config.h>
+#include <base/printf.h>
+#include <base/snprintf.h>
+#include <base/exception.h>
+
+using namespace Genode;
+
+typedef Genode::Path<Vfs::MAX_PATH_LEN> Path;
+
+typedef Vfs::Directory_service Directory_service;
+
+
+enum Phase {
+	CREATE, STAT, SMALL_WRITE, SMALL_READ, UNLINK, STREAM_WRITE, STREAM_READ,
+	NUM_PHASES };
+
+static char const *phase_name(Phase phase)
+{
+	switch (phase) {
+	case CREATE:       return "create";
+	case STAT:         return "stat";
+	case SMALL_WRITE:  return "small_write";
+	case SMALL_READ:   return "small_read";
+	case UNLINK:       return "unlink";
+	case STREAM_WRITE: return "stream_write";
+	case STREAM_READ:  return "stream_read";
+	case NUM_PHASES:   break;
+	}
+	return "";
+}
+
+
+struct Parameters
+{
+	unsigned threads;
+	unsigned files;        /* number of small files per thread */
+	size_t   small_size;   /* payload of each small file */
+	size_t   stream_size;  /* size of the large file per thread */
+	size_t   chunk_size;   /* request size used for the large file */
+};
+
+
+struct Bench_thread : public Genode::Thread<4*1024*sizeof(Genode::addr_t)>
+{
+	Vfs::File_system &vfs;
+	Parameters const &params;
+	Phase     const   phase;
+	char      * const buf;
+
+	::Path dir;
+
+	Vfs::file_size ops    = 0;
+	Vfs::file_size bytes  = 0;
+	bool           failed = false;
+
+	Bench_thread(Vfs::File_system &vfs, Parameters const &params,
+	             Phase phase, char *buf, char const *dir,
+	             Affinity::Location affinity)
+	:
+		Thread(dir), vfs(vfs), params(params), phase(phase), buf(buf), dir(dir)
+	{
+		env()->cpu_session()->affinity(cap(), affinity);
+	}
+
+	void _file_path(::Path &path, unsigned i) const
+	{
+		char name[16];
+		snprintf(name, sizeof(name), "/%u", i);
+
+		path.import(dir.base());
+		path.append(name);
+	}
+
+	Vfs::Vfs_handle *_open(char const *path, unsigned mode)
+	{
+		Vfs::Vfs_handle *handle = nullptr;
+		if (vfs.open(path, mode, &handle) != Directory_service::OPEN_OK)
+			throw Exception();
+		return handle;
+	}
+
+	void _write(Vfs::Vfs_handle *handle, size_t len)
+	{
+		for (size_t written = 0; written < len; ) {
+			Vfs::file_size n = 0;
+			if (handle->fs().write(handle, buf, len - written, n)
+			    != Vfs::File_io_service::WRITE_OK || !n)
+				throw Exception();
+
+			handle->advance_seek(n);
+			written += n;
+			bytes   += n;
+		}
+	}
+
+	void _read(Vfs::Vfs_handle *handle, size_t len)
+	{
+		for (size_t read = 0; read < len; ) {
+			Vfs::file_size n = 0;
+			if (handle->fs().read(handle, buf, len - read, n)
+			    != Vfs::File_io_service::READ_OK || !n)
+				throw Exception();
+
+			handle->advance_seek(n);
+			read  += n;
+			bytes += n;
+		}
+	}
+
+	void _small_file(unsigned i)
+	{
+		::Path path;
+		_file_path(path, i);
+
+		switch (phase) {
+		case CREATE:
+			{
+				Vfs::Vfs_handle::Guard guard(_open(path.base(),
+					Directory_service::OPEN_MODE_CREATE | Directory_service::OPEN_MODE_WRONLY));
+			}
+			break;
+
+		case STAT:
+			{
+				Directory_service::Stat stat;
+				if (vfs.stat(path.base(), stat) != Directory_service::STAT_OK)
+					throw Exception();
+			}
+			break;
+
+		case SMALL_WRITE:
+			{
+				Vfs::Vfs_handle *handle = _open(path.base(),
+					Directory_service::OPEN_MODE_WRONLY);
+				Vfs::Vfs_handle::Guard guard(handle);
+				_write(handle, params.small_size);
+			}
+			break;
+
+		case SMALL_READ:
+			{
+				Vfs::Vfs_handle *handle = _open(path.base(),
+					Directory_service::OPEN_MODE_RDONLY);
+				Vfs::Vfs_handle::Guard guard(handle);
+				_read(handle, params.small_size);
+			}
+			break;
+
+		case UNLINK:
+			if (vfs.unlink(path.base()) != Directory_service::UNLINK_OK)
+				throw Exception();
+			break;
+
+		default: break;
+		}
+		ops++;
+	}
+
+	void _stream()
+	{
+		::Path path(dir.base());
+		path.append("/stream");
+
+		unsigned const mode = phase == STREAM_WRITE
+		                    ? Directory_service::OPEN_MODE_CREATE
+		                    | Directory_service::OPEN_MODE_WRONLY
+		                    : Directory_service::OPEN_MODE_RDONLY;
+
+		Vfs::Vfs_handle *handle = _open(path.base(), mode);
+		Vfs::Vfs_handle::Guard guard(handle);
+
+		for (size_t done = 0; done < params.stream_size; ops++) {
+			size_t const len = min(params.chunk_size, params.stream_size - done);
+
+			if (phase == STREAM_WRITE)
+				_write(handle, len);
+			else
+				_read(handle, len);
+
+			done += len;
+		}
+	}
+
+	void entry()
+	{
+		try {
+			if (phase == STREAM_WRITE || phase == STREAM_READ)
+				_stream();
+			else
+				for (unsigned i = 0; i < params.files; i++)
+					_small_file(i);
+
+		} catch (...) {
+			PERR("%s failed in %s after %llu operations",
+			     phase_name(phase), dir.base(), ops);
+			failed = true;
+		}
+	}
+};
+
+
+/**
+ * Execute phase by all threads in parallel
+ *
+ * \return false if the phase failed in any thread
+ */
+static bool run_phase(Vfs::File_system &vfs, Parameters const &params,
+                      Phase phase, char **bufs, Timer::Session &timer)
+{
+	Affinity::Space space = env()->cpu_session()->affinity_space();
+
+	Bench_thread *threads[params.threads];
+
+	for (unsigned i = 0; i < params.threads; i++) {
+		char dir[16];
+		snprintf(dir, sizeof(dir), "/%u", i);
+		threads[i] = new (env()->heap())
+			Bench_thread(vfs, params, phase, bufs[i], dir,
+			             space.location_of_index(i));
+	}
+
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	for (unsigned i = 0; i < params.threads; i++)
+		threads[i]->start();
+
+	Vfs::file_size ops = 0, bytes = 0;
+	bool failed = false;
+
+	for (unsigned i = 0; i < params.threads; i++) {
+		threads[i]->join();
+		ops    += threads[i]->ops;
+		bytes  += threads[i]->bytes;
+		failed |= threads[i]->failed;
+		destroy(env()->heap(), threads[i]);
+	}
+
+	/* writes are complete not before the file system got synced */
+	vfs.sync("/");
+
+	unsigned long const ms = max(timer.elapsed_ms() - start_ms, 1UL);
+
+	printf("<phase name=\"%s\" threads=\"%u\" ops=\"%llu\" bytes=\"%llu\""
+	       " ms=\"%lu\" ops_per_s=\"%llu\" kib_per_s=\"%llu\"/>\n",
+	       phase_name(phase), params.threads, ops, bytes, ms,
+	       (ops*1000)/ms, (bytes*1000/1024)/ms);
+
+	return !failed;
+}
+
+
+int main()
+{
+	/* look for dynamic linker */
+	try {
+		static Genode::Rom_connection rom("ld.lib.so");
+		Genode::Process::dynamic_linker(rom.dataspace());
+	} catch (...) { }
+
+	Xml_node const config = Genode::config()->xml_node();
+
+	static Vfs::Dir_file_system vfs_root(config.sub_node("vfs"),
+	                                     Vfs::global_file_system_factory());
+
+	Parameters const params = {
+		max(config.attribute_value("threads", 1U), 1U),
+		config.attribute_value("files", 1000U),
+		max(config.attribute_value("small_size", (size_t)4096), (size_t)1),
+		config.attribute_value("stream_size", (size_t)16*1024*1024),
+		max(config.attribute_value("chunk_size", (size_t)64*1024), (size_t)1)
+	};
+
+	Timer::Connection timer;
+
+	/* populate the directory file system at / */
+	vfs_root.num_dirent("/");
+
+	/* each thread uses its own buffer for reading and writing */
+	char *bufs[params.threads];
+	for (unsigned i = 0; i < params.threads; i++) {
+		char dir[16];
+		snprintf(dir, sizeof(dir), "/%u", i);
+		vfs_root.mkdir(dir, 0);
+
+		bufs[i] = (char *)env()->heap()->alloc(max(params.small_size,
+		                                           params.chunk_size));
+		memset(bufs[i], 0x55, max(params.small_size, params.chunk_size));
+	}
+
+	printf("--- vfs_bench: %u threads, %u files of %zu bytes, stream of %zu"
+	       " bytes in chunks of %zu bytes ---\n", params.threads, params.files,
+	       params.small_size, params.stream_size, params.chunk_size);
+
+	bool ok = true;
+	for (unsigned phase = 0; phase < NUM_PHASES && ok; phase++)
+		ok = run_phase(vfs_root, params, (Phase)phase, bufs, timer);
+
+	/* remove the large files and the directories */
+	for (unsigned i = 0; i < params.threads; i++) {
+		char path[32];
+		snprintf(path, sizeof(path), "/%u/stream", i);
+		vfs_root.unlink(path);
+		snprintf(path, sizeof(path), "/%u", i);
+		vfs_root.unlink(path);
+	}
+	vfs_root.sync("/");
+
+	printf("--- vfs_bench %s ---\n", ok ? "finished" : "failed");
+	return ok ? 0 : -1;
+}
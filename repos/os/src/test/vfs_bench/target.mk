@@ -0,0 +1,3 @@
+TARGET = vfs_bench
+SRC_CC = main.cc
+LIBS   = base vfs
@@ -9,7 +9,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -48,7 +48,12 @@ namespace Noux {
 		enum { MAX_PATH_LEN = 512 };
 		typedef char Path[MAX_PATH_LEN];
 
-		enum { CHUNK_SIZE = 7*1024 };
+		/*
+		 * The chunk size limits the amount of data transferred by a single
+		 * read or write syscall. With small chunks, the syscall overhead
+		 * dominates bulk transfers, e.g., through pipes.
+		 */
+		enum { CHUNK_SIZE = 32*1024 };
 		typedef char Chunk[CHUNK_SIZE];
 
 		enum { ARGS_MAX_LEN = 4*1024 };
@@ -109,7 +109,7 @@ class Openvpn_component : public Tuntap_device,
 			if (!_tx.sink()->packet_avail())
 				return false;
 
-			Packet_descriptor packet = _tx.sink()->get_packet();
+			Nic::Packet_descriptor packet = _tx.sink()->get_packet();
 			if (!packet.valid()) {
 				PWRN("Invalid tx packet");
 				return true;
@@ -192,7 +192,7 @@ class Openvpn_component : public Tuntap_device,
 				return 0;
 
 			try {
-				Genode::Packet_descriptor packet = _rx.source()->alloc_packet(len);
+				Nic::Packet_descriptor packet = _rx.source()->alloc_packet(len);
 				Genode::memcpy(_rx.source()->packet_content(packet), buf, len);
 				_rx.source()->submit_packet(packet);
 			} catch (...) { return 0; }
@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  * Copyright (C) 2012 Intel Corporation
  *
  * This file is distributed under the terms of the GNU General Public License
@@ -21,6 +21,7 @@
 
 /* Genode includes */
 #include <base/snprintf.h>
+#include <util/misc_math.h>
 #include <util/register.h>
 
 /* nitpicker graphics backend */
@@ -45,6 +46,84 @@ Font default_font(&_binary_mono_tff_start);
 bool fb_active = true;
 
 
+/**
+ * Detector of the framebuffer lines changed by the guest
+ *
+ * In graphics mode, the guest writes directly into the framebuffer
+ * dataspace, so we have no notion of its updates. Instead of refreshing
+ * the whole screen periodically, we compare a checksum per band of lines
+ * with the one of the previous period and refresh only changed bands.
+ * An idle screen thereby causes no refresh at all.
+ */
+class Framebuffer_bands
+{
+	private:
+
+		enum { LINES_PER_BAND = 16, MAX_BANDS = 512 };
+
+		Genode::uint64_t _checksums[MAX_BANDS];
+		bool             _valid = false;
+
+		static Genode::uint64_t _checksum(unsigned long const *words,
+		                                  Genode::size_t num_words)
+		{
+			Genode::uint64_t sum = 0;
+			for (Genode::size_t i = 0; i < num_words; i++)
+				sum = ((sum << 7) | (sum >> 57)) ^ words[i];
+			return sum;
+		}
+
+	public:
+
+		/**
+		 * Consider all lines as changed with the next call of 'for_each_changed'
+		 */
+		void invalidate() { _valid = false; }
+
+		/**
+		 * Call 'fn(y, h)' for each range of lines changed since the last call
+		 */
+		template <typename FN>
+		void for_each_changed(void const *pixels, Genode::size_t bytes_per_line,
+		                      unsigned lines, FN const &fn)
+		{
+			unsigned const num_bands =
+				Genode::min((lines + LINES_PER_BAND - 1) / LINES_PER_BAND,
+				            (unsigned)MAX_BANDS);
+
+			int first_changed = -1;
+
+			for (unsigned band = 0; band <= num_bands; band++) {
+
+				bool changed = false;
+
+				if (band < num_bands) {
+					unsigned const y = band*LINES_PER_BAND;
+					unsigned const h = Genode::min((unsigned)LINES_PER_BAND, lines - y);
+
+					Genode::uint64_t const sum = _checksum(
+						(unsigned long const *)((char const *)pixels + y*bytes_per_line),
+						h*bytes_per_line/sizeof(unsigned long));
+
+					changed = !_valid || sum != _checksums[band];
+					_checksums[band] = sum;
+				}
+
+				if (changed && first_changed < 0)
+					first_changed = band;
+
+				if (!changed && first_changed >= 0) {
+					unsigned const y = first_changed*LINES_PER_BAND;
+					fn(y, Genode::min(band*LINES_PER_BAND, lines) - y);
+					first_changed = -1;
+				}
+			}
+
+			_valid = true;
+		}
+};
+
+
 /**
  * Layout of PS/2 mouse packet
  */
@@ -253,6 +332,7 @@ void Vancouver_console::entry()
 	Genode::uint64_t checksum2 = 0;
 	unsigned unchanged = 0;
 	bool cmp_even = 1;
+	Framebuffer_bands fb_bands;
 
 	_startup_lock.unlock();
 
@@ -328,8 +408,13 @@ void Vancouver_console::entry()
 					}
 
 					revoked = true;
+					fb_bands.invalidate();
 				}
-				framebuffer->refresh(0, 0, _fb_mode.width(), _fb_mode.height());
+
+				fb_bands.for_each_changed(_pixels, _fb_mode.width()*2,
+				                          _fb_mode.height(),
+				                          [&] (unsigned y, unsigned h) {
+					framebuffer->refresh(0, y, _fb_mode.width(), h); });
 			}
 
 			timer.msleep(10);
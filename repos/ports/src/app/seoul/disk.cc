@@ -7,7 +7,7 @@
 
 /*
  * Copyright (C) 2012 Intel Corporation
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is distributed under the terms of the GNU General Public License
  * version 2.
@@ -106,76 +106,159 @@ void Vancouver_disk::_signal_dispatch_entry(unsigned disknr)
 {
 	Block::Session::Tx::Source *source = _diskcon[disknr].blk_con->tx();
 
-	while (source->ack_avail())
-	{
-		Block::Packet_descriptor packet = source->get_acked_packet();
-		char * source_addr              = source->packet_content(packet);
+	/*
+	 * Acknowledgements are processed in the order of their arrival, which
+	 * may differ from the order of the requests. The commit messages are
+	 * sent to the disk model without holding the 'tx_lock' because the
+	 * disk model may submit new requests while we wait for the
+	 * motherboard.
+	 */
+	for (;;) {
+		MessageDisk *msg = 0;
+		bool         ok  = false;
 
-		/* find the corresponding MessageDisk object */
-		Avl_entry * obj = 0;
 		{
-			Genode::Lock::Guard lock_guard(_lookup_msg_lock);
-			obj = _lookup_msg.first();
-			if (obj)
-				obj = obj->find(reinterpret_cast<Genode::addr_t>(source_addr));
+			Genode::Lock::Guard guard(_diskcon[disknr].tx_lock);
+
+			if (!source->ack_avail())
+				break;
+
+			Block::Packet_descriptor packet = source->get_acked_packet();
+			char * source_addr              = source->packet_content(packet);
+
+			/* find the corresponding MessageDisk object */
+			Avl_entry * obj = 0;
+			{
+				Genode::Lock::Guard lock_guard(_lookup_msg_lock);
+				obj = _lookup_msg.first();
+				if (obj)
+					obj = obj->find(reinterpret_cast<Genode::addr_t>(source_addr));
+
+				/* remove helper object */
+				if (obj)
+					_lookup_msg.remove(obj);
+			}
 
 			if (!obj) {
 				PWRN("Unknown MessageDisk object - drop ack of block session");
+				source->release_packet(packet);
 				continue;
 			}
 
-			/* remove helper object */
-			_lookup_msg.remove(obj);
-		}
-		/* got the MessageDisk object */
-		MessageDisk * msg = obj->msg();
-		/* delete helper object */
-		destroy(&_tslab_avl, obj);
-
-		/* go ahead and tell VMM about new block event */
-		if (!packet.succeeded() || 
-		    !(packet.operation() == Block::Packet_descriptor::Opcode::READ ||
-		      packet.operation() == Block::Packet_descriptor::Opcode::WRITE)) {
-
-			PDBG("Getting block failed !");
+			/* got the MessageDisk object */
+			msg = obj->msg();
+			/* delete helper object */
+			destroy(&_tslab_avl, obj);
 
-			MessageDiskCommit mdc(disknr, msg->usertag,
-			                      MessageDisk::DISK_STATUS_DEVICE);
-			_motherboard()->bus_diskcommit.send(mdc);
-	
-		} else {
+			ok = packet.succeeded() &&
+			     (packet.operation() == Block::Packet_descriptor::Opcode::READ ||
+			      packet.operation() == Block::Packet_descriptor::Opcode::WRITE);
 
-			if (packet.operation() == Block::Packet_descriptor::Opcode::READ) {
-						
-				unsigned long long sector = msg->sector;
-				sector = (sector-packet.block_number()) * _diskcon[disknr].blk_size;
+			/* copy read data directly from the packet to the guest memory */
+			if (ok && packet.operation() == Block::Packet_descriptor::Opcode::READ) {
 
 				for (unsigned i = 0; i < msg->dmacount; i++) {
 					char * dma_addr = _backing_store_base +
 					                  msg->dma[i].byteoffset + msg->physoffset;
 
-					// check for bounds
-					if (dma_addr >= _backing_store_base + _backing_store_size
-					 || dma_addr < _backing_store_base) {
-						PERR("dma bounds violation");
-					} else
-						memcpy(dma_addr, source_addr + sector,
-						       msg->dma[i].bytecount);
-
-					sector += msg->dma[i].bytecount;
+					memcpy(dma_addr, source_addr, msg->dma[i].bytecount);
+					source_addr += msg->dma[i].bytecount;
 				}
-
-				destroy(disk_heap(), msg->dma);
-				msg->dma = 0;
 			}
 
-			MessageDiskCommit mdc (disknr, msg->usertag, MessageDisk::DISK_OK);
-			_motherboard()->bus_diskcommit.send(mdc);
+			source->release_packet(packet);
 		}
- 
-		source->release_packet(packet);
+
+		/* go ahead and tell VMM about new block event */
+		if (!ok)
+			PDBG("Getting block failed !");
+
+		MessageDiskCommit mdc(disknr, msg->usertag,
+		                      ok ? MessageDisk::DISK_OK
+		                         : MessageDisk::DISK_STATUS_DEVICE);
+		_motherboard()->bus_diskcommit.send(mdc);
+
+		destroy(disk_heap(), msg->dma);
 		destroy(&_tslab_msg, msg);
 	}
+
+	/* use the space freed by the acknowledgements for deferred requests */
+	Genode::Lock::Guard guard(_diskcon[disknr].tx_lock);
+	_submit_pending(disknr);
+}
+
+
+bool Vancouver_disk::_dma_in_bounds(MessageDisk const &msg) const
+{
+	for (unsigned i = 0; i < msg.dmacount; i++) {
+		Genode::addr_t const offset = msg.dma[i].byteoffset + msg.physoffset;
+
+		if (offset >= _backing_store_size
+		 || msg.dma[i].bytecount > _backing_store_size - offset)
+			return false;
+	}
+	return true;
+}
+
+
+bool Vancouver_disk::_submit(unsigned disknr, MessageDisk *msg)
+{
+	Block::Session::Tx::Source *source = _diskcon[disknr].blk_con->tx();
+
+	/* do not block on a full submit queue, the disk thread needs the lock */
+	if (!source->ready_to_submit())
+		return false;
+
+	bool     const write    = (msg->type == MessageDisk::DISK_WRITE);
+	unsigned const blk_size = _diskcon[disknr].blk_size;
+
+	unsigned long const total  = DmaDescriptor::sum_length(msg->dmacount, msg->dma);
+	unsigned long const blocks = (total + blk_size - 1) / blk_size;
+
+	Block::Packet_descriptor packet;
+	try {
+		packet = Block::Packet_descriptor(
+			source->alloc_packet(blocks * blk_size),
+			(write) ? Block::Packet_descriptor::WRITE
+			        : Block::Packet_descriptor::READ,
+			msg->sector, blocks);
+	} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+		return false;
+	}
+
+	char * source_addr = source->packet_content(packet);
+	{
+		Genode::Lock::Guard lock_guard(_lookup_msg_lock);
+		_lookup_msg.insert(new (&_tslab_avl) Avl_entry(source_addr, msg));
+	}
+
+	/* copy write data directly from the guest memory to the packet */
+	if (write) {
+		for (unsigned i = 0; i < msg->dmacount; i++) {
+			char * dma_addr = _backing_store_base + msg->dma[i].byteoffset
+			                  + msg->physoffset;
+
+			memcpy(source_addr, dma_addr, msg->dma[i].bytecount);
+			source_addr += msg->dma[i].bytecount;
+		}
+	}
+
+	source->submit_packet(packet);
+	return true;
+}
+
+
+void Vancouver_disk::_submit_pending(unsigned disknr)
+{
+	Genode::Fifo<Pending> &pending = _diskcon[disknr].pending;
+
+	while (Pending *p = pending.head()) {
+		if (!_submit(disknr, p->msg))
+			return;
+
+		pending.dequeue();
+		destroy(disk_heap(), p);
+	}
 }
 
 
@@ -200,7 +283,7 @@ bool Vancouver_disk::receive(MessageDisk &msg)
 				new Genode::Allocator_avl(disk_heap());
 
 			_diskcon[msg.disknr].blk_con =
-				new Block::Connection(block_alloc, 4*512*1024, label);
+				new Block::Connection(block_alloc, TX_BUF_SIZE, label);
 			_diskcon[msg.disknr].dispatcher =
 				new Vancouver_disk_signal(*disk_receiver(), *this,
 				                          &Vancouver_disk::_signal_dispatch_entry,
@@ -250,74 +333,49 @@ bool Vancouver_disk::receive(MessageDisk &msg)
 				return true;
 			}
 
-			unsigned long long sector = msg.sector;
-			unsigned long total = DmaDescriptor::sum_length(msg.dmacount, msg.dma);
-			unsigned long blocks = total/_diskcon[msg.disknr].blk_size;
-			unsigned const blk_size = _diskcon[msg.disknr].blk_size;
-
-			if (blocks * blk_size < total) blocks++;
+			/* check bounds for read and write operations */
+			if (!_dma_in_bounds(msg))
+				return false;
 
-			Block::Session::Tx::Source *source = _diskcon[msg.disknr].blk_con->tx();
-			Block::Packet_descriptor packet;
+			/* requests that never fit into the packet buffer cannot be deferred */
+			if (DmaDescriptor::sum_length(msg.dmacount, msg.dma) > TX_BUF_SIZE) {
+				Logging::printf("disk request exceeds packet buffer\n");
+				return false;
+			}
 
-			/* save original msg, required when we get acknowledgements */
+			/*
+			 * Save original msg, required when we get acknowledgements.
+			 * The DMA descriptors may change after returning, so we keep
+			 * a copy of them.
+			 */
 			MessageDisk * msg_cpy = 0;
+			Pending     * pending = 0;
 			try {
 				msg_cpy = new (&_tslab_msg) MessageDisk(msg);
-
-				packet = Block::Packet_descriptor(
-					source->alloc_packet(blocks * blk_size),
-					(write) ? Block::Packet_descriptor::WRITE
-					        : Block::Packet_descriptor::READ,
-					sector, blocks);
+				msg_cpy->dma = 0;
+				msg_cpy->dma = new (disk_heap()) DmaDescriptor[msg.dmacount];
+				pending      = new (disk_heap()) Pending(msg_cpy);
 			} catch (...) {
+				if (msg_cpy && msg_cpy->dma)
+					destroy(disk_heap(), msg_cpy->dma);
 				if (msg_cpy)
 					destroy(&_tslab_msg, msg_cpy);
 				Logging::printf("could not allocate disk block elements\n");
 				return false;
 			}
 
-			char * source_addr = source->packet_content(packet);
-			{
-				Genode::Lock::Guard lock_guard(_lookup_msg_lock);
-				_lookup_msg.insert(new (&_tslab_avl) Avl_entry(source_addr,
-				                                               msg_cpy));
-			}
+			for (unsigned i = 0; i < msg.dmacount; i++)
+				memcpy(msg_cpy->dma + i, msg.dma + i, sizeof(DmaDescriptor));
 
-			/* copy DMA descriptors for read requests - they may change */
-			if (!write) {
-				msg_cpy->dma = new (disk_heap()) DmaDescriptor[msg_cpy->dmacount];
-				for (unsigned i = 0; i < msg_cpy->dmacount; i++)
-					memcpy(msg_cpy->dma + i, msg.dma + i, sizeof(DmaDescriptor));
-			}
-
-
-			/* for write operation */	
-			source_addr       += (sector - packet.block_number()) * blk_size;
-
-			/* check bounds for read and write operations */	
-			for (unsigned i = 0; i < msg_cpy->dmacount; i++) {
-				char * dma_addr = _backing_store_base + msg_cpy->dma[i].byteoffset
-				                  + msg_cpy->physoffset;
-
-				/* check for bounds */
-				if (dma_addr >= _backing_store_base + _backing_store_size
-				 || dma_addr < _backing_store_base) { 
-					/* drop allocated objects not needed in error case */
-					if (write)
-						destroy(disk_heap(), msg_cpy->dma);
-					destroy(&_tslab_msg, msg_cpy);
-					source->release_packet(packet);
-					return false;
-				}
-
-				if (write) {
-					memcpy(source_addr, dma_addr, msg.dma[i].bytecount);
-					source_addr += msg.dma[i].bytecount;
-				}
-			}
+			/*
+			 * Submit the request right away unless earlier requests still
+			 * wait for space. The request completes asynchronously via
+			 * '_signal_dispatch_entry'.
+			 */
+			Genode::Lock::Guard lock_guard(_diskcon[msg.disknr].tx_lock);
 
-			source->submit_packet(packet);
+			_diskcon[msg.disknr].pending.enqueue(pending);
+			_submit_pending(msg.disknr);
 		}
 		break;
 	default:
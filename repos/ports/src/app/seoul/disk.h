@@ -7,7 +7,7 @@
 
 /*
  * Copyright (C) 2012 Intel Corporation
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is distributed under the terms of the GNU General Public License
  * version 2.
@@ -27,7 +27,9 @@
 #include <base/printf.h>
 #include <base/thread.h>
 #include <block_session/connection.h>
+#include <util/fifo.h>
 #include <util/string.h>
+#include <base/lock.h>
 #include <base/synced_allocator.h>
 
 /* local includes */
@@ -84,14 +86,37 @@ class Vancouver_disk : public Genode::Thread<8192>, public StaticReceiver<Vancou
 				MessageDisk * msg() { return _msg; }
 		};
 
+		/*
+		 * Request for which no block packet could be submitted yet
+		 *
+		 * Requests are deferred if the packet buffer or the submit queue of
+		 * the block session is exhausted. They are submitted in order when
+		 * acknowledgements free up space.
+		 */
+		struct Pending : Genode::Fifo<Pending>::Element
+		{
+			MessageDisk * const msg;
+
+			Pending(MessageDisk *msg) : msg(msg) { }
+		};
+
 		/* block session used by disk models of VMM */
 		enum { MAX_DISKS = 4 };
+		enum { TX_BUF_SIZE = 4*512*1024 };
 		struct {
 			Block::Connection          *blk_con;
 			Block::Session::Operations  ops;
 			Genode::size_t              blk_size;
 			Block::sector_t             blk_cnt;
 			Vancouver_disk_signal      *dispatcher;
+
+			/*
+			 * The packet stream of the block session is used by the
+			 * thread of the disk model for submitting requests and by the
+			 * disk thread for processing acknowledgements.
+			 */
+			Genode::Lock                tx_lock;
+			Genode::Fifo<Pending>       pending;
 		} _diskcon[MAX_DISKS];
 
 		Synced_motherboard &_motherboard;
@@ -116,6 +141,15 @@ class Vancouver_disk : public Genode::Thread<8192>, public StaticReceiver<Vancou
 		/* entry function if signal must be dispatched */
 		void _signal_dispatch_entry(unsigned);
 
+		bool _dma_in_bounds(MessageDisk const &msg) const;
+
+		/*
+		 * The following methods must be called with the 'tx_lock' of the
+		 * disk held.
+		 */
+		bool _submit(unsigned disknr, MessageDisk *msg);
+		void _submit_pending(unsigned disknr);
+
 	public:
 
 		/**
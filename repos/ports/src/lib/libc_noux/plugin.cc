@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -131,14 +131,35 @@ static struct sigaction signal_action[NSIG+1];
 static sigset_t signal_mask;
 
 
-static bool noux_syscall(Noux::Session::Syscall opcode)
+/**
+ * Guard that preserves the 'sysio' object while executing a signal handler
+ *
+ * Signal handlers might do syscalls themselves, so the 'sysio' object
+ * needs to get saved before and restored after calling the signal handler.
+ * The 'sysio' object is too large to be kept on the stack of each syscall.
+ * Hence, the copy is allocated only if a handler is actually called.
+ */
+struct Saved_sysio
 {
-	/*
-	 * Signal handlers might do syscalls themselves, so the 'sysio' object
-	 * needs to get saved before and restored after calling the signal handler.
-	 */
-	Noux::Sysio saved_sysio;
+	Noux::Sysio * const copy;
+
+	Saved_sysio()
+	:
+		copy((Noux::Sysio *)Libc::mem_alloc()->alloc(sizeof(Noux::Sysio), 0))
+	{
+		memcpy(copy, sysio(), sizeof(Noux::Sysio));
+	}
+
+	~Saved_sysio()
+	{
+		memcpy(sysio(), copy, sizeof(Noux::Sysio));
+		Libc::mem_alloc()->free(copy);
+	}
+};
+
 
+static bool noux_syscall(Noux::Session::Syscall opcode)
+{
 	bool ret = noux()->syscall(opcode);
 
 	/* handle signals */
@@ -147,10 +168,9 @@ static bool noux_syscall(Noux::Session::Syscall opcode)
 		if (verbose_signals)
 			PDBG("received signal %d", signal);
 		if (signal_action[signal].sa_flags & SA_SIGINFO) {
-			memcpy(&saved_sysio, sysio(), sizeof(Noux::Sysio));
+			Saved_sysio saved_sysio;
 			/* TODO: pass siginfo_t struct */
 			signal_action[signal].sa_sigaction(signal, 0, 0);
-			memcpy(sysio(), &saved_sysio, sizeof(Noux::Sysio));
 		} else {
 			if (signal_action[signal].sa_handler == SIG_DFL) {
 				switch (signal) {
@@ -164,9 +184,8 @@ static bool noux_syscall(Noux::Session::Syscall opcode)
 			} else if (signal_action[signal].sa_handler == SIG_IGN) {
 				/* do nothing */
 			} else {
-				memcpy(&saved_sysio, sysio(), sizeof(Noux::Sysio));
+				Saved_sysio saved_sysio;
 				signal_action[signal].sa_handler(signal);
-				memcpy(sysio(), &saved_sysio, sizeof(Noux::Sysio));
 			}
 		}
 	}
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -178,6 +178,11 @@ namespace Noux {
 
 			/**
 			 * ELF binary handling
+			 *
+			 * A forked process shares the binary dataspace of its parent.
+			 * The address space replayed from the parent refers to this
+			 * dataspace anyway. Only the process that obtained the
+			 * dataspace from the VFS releases it.
 			 */
 			struct Elf
 			{
@@ -186,17 +191,22 @@ namespace Noux {
 
 				Vfs::Dir_file_system * const _root_dir;
 				Dataspace_capability   const _binary_ds;
+				bool                   const _owner;
 
 				Elf(char const * const binary_name, Vfs::Dir_file_system * root_dir,
-				    Dataspace_capability binary_ds)
+				    Dataspace_capability binary_ds, bool owner)
 				:
-					_root_dir(root_dir), _binary_ds(binary_ds)
+					_root_dir(root_dir), _binary_ds(binary_ds), _owner(owner)
 				{
 					strncpy(_name, binary_name, sizeof(_name));
 					_name[NAME_MAX_LEN - 1] = 0;
 				}
 
-				~Elf() { _root_dir->release(_name, _binary_ds); }
+				~Elf()
+				{
+					if (_owner)
+						_root_dir->release(_name, _binary_ds);
+				}
 			} _elf;
 
 			enum { PAGE_SIZE = 4096, PAGE_MASK = ~(PAGE_SIZE - 1) };
@@ -312,6 +322,10 @@ namespace Noux {
 			/**
 			 * Constructor
 			 *
+			 * \param binary_ds  dataspace of the binary as obtained from
+			 *                   the VFS and henceforth owned by the child,
+			 *                   or the binary dataspace of the parent if
+			 *                   the child is a fork
 			 * \param forked  false if the child is spawned directly from
 			 *                an executable binary (i.e., the init process,
 			 *                or children created via execve, or
@@ -331,6 +345,7 @@ namespace Noux {
 			      int                   pid,
 			      Signal_receiver      *sig_rec,
 			      Vfs::Dir_file_system *root_dir,
+			      Dataspace_capability  binary_ds,
 			      Args           const &args,
 			      Sysio::Env     const &env,
 			      Cap_session          *cap_session,
@@ -356,7 +371,7 @@ namespace Noux {
 				_resources(binary_name, resources_ep, false),
 				_args(ARGS_DS_SIZE, args),
 				_env(env),
-				_elf(binary_name, root_dir, root_dir->dataspace(binary_name)),
+				_elf(binary_name, root_dir, binary_ds, !forked),
 				_sysio_ds(Genode::env()->ram_session(), SYSIO_DS_SIZE),
 				_sysio(_sysio_ds.local_addr<Sysio>()),
 				_noux_session_cap(Session_capability(_entrypoint.manage(this))),
@@ -531,6 +546,7 @@ namespace Noux {
 			}
 
 			Family_member *do_execve(const char *filename,
+			                         Dataspace_capability binary_ds,
 			                         Args const &args,
 			                         Sysio::Env const &env,
 			                         bool verbose)
@@ -544,6 +560,7 @@ namespace Noux {
 					                     pid(),
 					                     _sig_rec,
 					                     root_dir(),
+					                     binary_ds,
 					                     args,
 					                     env,
 					                     _cap_session,
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -113,6 +113,7 @@ namespace Noux {
 
 			/* Called by the parent from 'execve_child()' */
 			virtual Family_member *do_execve(const char *filename,
+			                                 Genode::Dataspace_capability binary_ds,
 			                                 Args const &args,
 			                                 Sysio::Env const &env,
 			                                 bool verbose) = 0;
@@ -120,12 +121,14 @@ namespace Noux {
 			/* Called by the child on the parent (via Parent_execve) */
 			void execve_child(Family_member &child,
 			                  const char *filename,
+			                  Genode::Dataspace_capability binary_ds,
 			                  Args const &args,
 			                  Sysio::Env const &env,
 			                  bool verbose)
 			{
 				Lock::Guard guard(_lock);
 				Family_member *new_child = child.do_execve(filename,
+				                                           binary_ds,
 				                                           args,
 				                                           env,
 				                                           verbose);
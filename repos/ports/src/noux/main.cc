@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2013 Genode Labs GmbH
+ * Copyright (C) 2011-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -345,9 +345,9 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 		case SYSCALL_EXECVE:
 			{
 				/*
-				 * We have to check the dataspace twice because the binary
-				 * could be a script that uses an interpreter which maybe
-				 * does not exist.
+				 * The dataspace is obtained only once and handed over to
+				 * the new process because obtaining it may involve copying
+				 * the whole binary, e.g., from a file-system session.
 				 */
 				Dataspace_capability binary_ds =
 					root_dir()->dataspace(_sysio->execve_in.filename);
@@ -361,20 +361,26 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 					child_env(_sysio->execve_in.filename, binary_ds,
 					          _sysio->execve_in.args, _sysio->execve_in.env);
 
-				root_dir()->release(_sysio->execve_in.filename, binary_ds);
+				/*
+				 * A script is executed by its interpreter, which may not
+				 * exist.
+				 */
+				if (strcmp(child_env.binary_name(), _sysio->execve_in.filename)) {
 
-				binary_ds = root_dir()->dataspace(child_env.binary_name());
+					root_dir()->release(_sysio->execve_in.filename, binary_ds);
 
-				if (!binary_ds.valid()) {
-					_sysio->error.execve = Sysio::EXECVE_NONEXISTENT;
-					break;
-				}
+					binary_ds = root_dir()->dataspace(child_env.binary_name());
 
-				root_dir()->release(child_env.binary_name(), binary_ds);
+					if (!binary_ds.valid()) {
+						_sysio->error.execve = Sysio::EXECVE_NONEXISTENT;
+						break;
+					}
+				}
 
 				try {
 					_parent_execve.execve_child(*this,
 					                            child_env.binary_name(),
+					                            binary_ds,
 					                            child_env.args(),
 					                            child_env.env(),
 					                            verbose);
@@ -605,6 +611,7 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 					                  new_pid,
 					                  _sig_rec,
 					                  root_dir(),
+					                  _elf._binary_ds,
 					                  _args,
 					                  _env.env(),
 					                  _cap_session,
@@ -1204,6 +1211,7 @@ int main(int argc, char **argv)
 	                             pid_allocator()->alloc(),
 	                             &sig_rec,
 	                             &root_dir,
+	                             root_dir.dataspace(name_of_init_process()),
 	                             args_of_init_process(),
 	                             env_string_of_init_process(),
 	                             &cap,
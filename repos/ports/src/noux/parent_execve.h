@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014 Genode Labs GmbH
+ * Copyright (C) 2014-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -14,6 +14,9 @@
 #ifndef _NOUX__PARENT_EXECVE__H_
 #define _NOUX__PARENT_EXECVE__H_
 
+/* Genode includes */
+#include <dataspace/capability.h>
+
 /* Noux includes */
 #include <noux_session/sysio.h>
 
@@ -23,8 +26,15 @@ namespace Noux {
 
 	struct Parent_execve
 	{
+		/**
+		 * Replace child by a new process executing 'filename'
+		 *
+		 * \param binary_ds  dataspace of 'filename', which is henceforth
+		 *                   owned by the new process
+		 */
 		virtual void execve_child(Family_member &child,
 		                          const char *filename,
+		                          Genode::Dataspace_capability binary_ds,
 		                          Args const &args,
 		                          Sysio::Env const &env,
 		                          bool verbose) = 0;
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2012-2013 Genode Labs GmbH
+ * Copyright (C) 2012-2015 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
@@ -25,7 +25,11 @@ namespace Noux {
 
 			Lock mutable _lock;
 
-			enum { BUFFER_SIZE = 4096 };
+			/*
+			 * The buffer holds two syscall chunks so that the writer can
+			 * fill one chunk while the reader drains the other.
+			 */
+			enum { BUFFER_SIZE = 2*Sysio::CHUNK_SIZE };
 			char _buffer[BUFFER_SIZE];
 
 			unsigned _read_offset;
@@ -132,6 +136,13 @@ namespace Noux {
 					size_t const upper_len = min(dst_len, BUFFER_SIZE - _read_offset);
 					memcpy(dst, &_buffer[_read_offset], upper_len);
 
+					/* the read operation does not reach the buffer boundary */
+					if (upper_len < BUFFER_SIZE - _read_offset) {
+						_read_offset += upper_len;
+						_wake_up_writer();
+						return upper_len;
+					}
+
 					size_t const lower_len = min(dst_len - upper_len, _write_offset);
 					memcpy(dst + upper_len, &_buffer[0], lower_len);
 
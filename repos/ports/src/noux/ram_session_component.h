@@ -36,14 +36,62 @@ namespace Noux {
 	struct Ram_dataspace_info : Dataspace_info,
 	                            List<Ram_dataspace_info>::Element
 	{
+		/*
+		 * Noux keeps the dataspace attached once it accessed its content.
+		 * A process forks many times over its lifetime, e.g., a shell
+		 * running a script. With the persistent attachment, each fork
+		 * reads from memory that is already mapped instead of attaching
+		 * and faulting in the whole dataspace once again.
+		 */
+		char *_local_addr = nullptr;
+
+		enum { PAGE_SIZE = 4096 };
+
 		Ram_dataspace_info(Ram_dataspace_capability ds_cap)
 		: Dataspace_info(ds_cap) { }
 
+		~Ram_dataspace_info() { detach_local(); }
+
+		/**
+		 * Return noux-local address of the dataspace, or 0 on failure
+		 */
+		char *local_addr()
+		{
+			if (!_local_addr) {
+				try {
+					_local_addr = env()->rm_session()->attach(ds_cap());
+				} catch (...) { }
+			}
+			return _local_addr;
+		}
+
+		/**
+		 * Revert the noux-local attachment
+		 *
+		 * Must be called before freeing the dataspace.
+		 */
+		void detach_local()
+		{
+			if (_local_addr)
+				env()->rm_session()->detach(_local_addr);
+
+			_local_addr = nullptr;
+		}
+
+		static bool _zero_page(char const *page)
+		{
+			long const *p = (long const *)page;
+			for (size_t i = 0; i < PAGE_SIZE/sizeof(long); i++)
+				if (p[i])
+					return false;
+			return true;
+		}
+
 		Dataspace_capability fork(Ram_session_capability ram,
 		                          Dataspace_registry    &,
 		                          Rpc_entrypoint        &)
 		{
-			size_t const size = Dataspace_client(ds_cap()).size();
+			size_t const size = this->size();
 
 			Ram_dataspace_capability dst_ds;
 
@@ -53,20 +101,27 @@ namespace Noux {
 				return Dataspace_capability();
 			}
 
-			void *src = 0;
-			try {
-				src = env()->rm_session()->attach(ds_cap());
-			} catch (...) { }
+			char const *src = local_addr();
 
-			void *dst = 0;
+			char *dst = 0;
 			try {
 				dst = env()->rm_session()->attach(dst_ds);
 			} catch (...) { }
 
-			if (src && dst)
-				memcpy(dst, src, size);
+			/*
+			 * The new dataspace is cleared already. By skipping pages that
+			 * contain zeros only, we spare the writes and the page faults
+			 * for the untouched parts of heaps and stacks.
+			 */
+			if (src && dst) {
+				for (size_t offset = 0; offset < size; offset += PAGE_SIZE) {
+					size_t const len = min((size_t)PAGE_SIZE, size - offset);
+
+					if (len < PAGE_SIZE || !_zero_page(src + offset))
+						memcpy(dst + offset, src + offset, len);
+				}
+			}
 
-			if (src) env()->rm_session()->detach(src);
 			if (dst) env()->rm_session()->detach(dst);
 
 			if (!src || !dst) {
@@ -84,15 +139,10 @@ namespace Noux {
 			 	return;
 			}
 
-			char *dst = 0;
-			try {
-				dst = env()->rm_session()->attach(ds_cap());
-			} catch (...) { }
+			char *dst = local_addr();
 
 			if (src && dst)
 				memcpy(dst + dst_offset, src, len);
-
-			if (dst) env()->rm_session()->detach(dst);
 		}
 	};
 
@@ -170,6 +220,7 @@ namespace Noux {
 					_list.remove(ds_info);
 					_used_quota -= ds_info->size();
 
+					ds_info->detach_local();
 					env()->ram_session()->free(ds_cap);
 				};
 				_registry.apply(ds_cap, lambda);
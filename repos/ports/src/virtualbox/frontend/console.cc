@@ -12,9 +12,12 @@
  */
 
 #include <base/printf.h>
+#include <os/config.h>
 #include <util/xml_node.h>
 
 #include <VBox/settings.h>
+#include <VBox/vmm/vmapi.h>
+#include <iprt/path.h>
 #include <SharedClipboard/VBoxClipboard.h>
 #include <VBox/HostServices/VBoxClipboardSvc.h>
 
@@ -84,7 +87,6 @@ HRESULT Console::Resume()
 HRESULT Console::SleepButton()                                                  DUMMY(E_FAIL)
 HRESULT Console::GetPowerButtonHandled(bool*)                                   DUMMY(E_FAIL)
 HRESULT Console::GetGuestEnteredACPIMode(bool*)                                 DUMMY(E_FAIL)
-HRESULT Console::SaveState(IProgress**)                                         DUMMY(E_FAIL)
 HRESULT Console::AdoptSavedState(IN_BSTR)                                       DUMMY(E_FAIL)
 HRESULT Console::DiscardSavedState(bool)                                        DUMMY(E_FAIL)
 HRESULT Console::GetDeviceActivity(DeviceType_T, DeviceActivity_T*)             DUMMY(E_FAIL)
@@ -102,6 +104,41 @@ HRESULT Console::RestoreSnapshot(ISnapshot*, IProgress**)
 HRESULT Console::Teleport(IN_BSTR, ULONG, IN_BSTR, ULONG, IProgress **)         DUMMY(E_FAIL)
 HRESULT Console::setDiskEncryptionKeys(const Utf8Str &strCfg)                   DUMMY(E_FAIL)
 
+/**
+ * Save the VM state to the file named by the 'save_state' config attribute
+ *
+ * In contrast to the generic Main implementation, the state is written
+ * synchronously without involving the machine object and the VM continues
+ * to run afterwards. This way, several snapshots of a pre-warmed guest can
+ * be taken. A snapshot is restored at power-up if the 'stateFile' attribute
+ * of the 'Machine' node of the .vbox file refers to it.
+ */
+HRESULT Console::SaveState(IProgress **)
+{
+	char path[RTPATH_MAX];
+	try {
+		Genode::config()->xml_node().attribute("save_state").value(path, sizeof(path));
+	} catch (...) { return E_INVALIDARG; }
+
+	SafeVMPtr ptrVM(this);
+	if (!ptrVM.isOk())
+		return ptrVM.rc();
+
+	bool suspended = false;
+	int rc = VMR3Save(ptrVM.rawUVM(), path, true, NULL, NULL, &suspended);
+
+	if (suspended)
+		VMR3Resume(ptrVM.rawUVM(), VMRESUMEREASON_STATE_SAVED);
+
+	if (RT_FAILURE(rc)) {
+		PERR("saving VM state to '%s' failed - rc=%d", path, rc);
+		return E_FAIL;
+	}
+
+	PINF("saved VM state to '%s'", path);
+	return S_OK;
+}
+
 void    Console::onAdditionsOutdated()                                          DUMMY()
 
 void    Console::onKeyboardLedsChange(bool, bool, bool)                         TRACE()
@@ -365,6 +402,18 @@ void GenodeConsole::init_clipboard()
 	}
 }
 
+void GenodeConsole::handle_config_change(unsigned)
+{
+	Genode::config()->reload();
+
+	/* each config update with a 'save_state' attribute requests a snapshot */
+	if (!Genode::config()->xml_node().has_attribute("save_state"))
+		return;
+
+	ComPtr<IProgress> progress;
+	SaveState(progress.asOutParam());
+}
+
 void GenodeConsole::handle_cb_rom_change(unsigned)
 {
 	if (!_clipboard_rom)
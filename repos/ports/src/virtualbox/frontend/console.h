@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2013-2014 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is distributed under the terms of the GNU General Public License
  * version 2.
@@ -19,6 +19,7 @@
 #include <input_session/connection.h>
 #include <os/attached_dataspace.h>
 #include <os/attached_rom_dataspace.h>
+#include <os/config.h>
 #include <os/reporter.h>
 #include <report_session/connection.h>
 #include <timer_session/connection.h>
@@ -126,6 +127,7 @@ class GenodeConsole : public Console {
 		Genode::Signal_dispatcher<GenodeConsole>  _input_signal_dispatcher;
 		Genode::Signal_dispatcher<GenodeConsole>  _mode_change_signal_dispatcher;
 		Genode::Signal_dispatcher<GenodeConsole>  _clipboard_signal_dispatcher;
+		Genode::Signal_dispatcher<GenodeConsole>  _config_signal_dispatcher;
 
 		bool _key_status[Input::KEY_MAX + 1];
 
@@ -153,12 +155,14 @@ class GenodeConsole : public Console {
 			_vbox_mouse(0),
 			_input_signal_dispatcher(_receiver, *this, &GenodeConsole::handle_input),
 			_mode_change_signal_dispatcher(_receiver, *this, &GenodeConsole::handle_mode_change),
-			_clipboard_signal_dispatcher(_receiver, *this, &GenodeConsole::handle_cb_rom_change)
+			_clipboard_signal_dispatcher(_receiver, *this, &GenodeConsole::handle_cb_rom_change),
+			_config_signal_dispatcher(_receiver, *this, &GenodeConsole::handle_config_change)
 		{
 			for (unsigned i = 0; i <= Input::KEY_MAX; i++)
 				_key_status[i] = 0;
 
 			_input.sigh(_input_signal_dispatcher);
+			Genode::config()->sigh(_config_signal_dispatcher);
 		}
 
 		void init_clipboard();
@@ -232,4 +236,5 @@ class GenodeConsole : public Console {
 		void handle_input(unsigned);
 		void handle_mode_change(unsigned);
 		void handle_cb_rom_change(unsigned);
+		void handle_config_change(unsigned);
 };
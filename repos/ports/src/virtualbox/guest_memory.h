@@ -7,7 +7,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is distributed under the terms of the GNU General Public License
  * version 2.
@@ -298,6 +298,20 @@ class Guest_memory
 		}
 
 
+		/**
+		 * Call functor for each RAM region
+		 *
+		 * The functor is called with the guest-physical base address, the
+		 * size, and the VMM-local base address of the region.
+		 */
+		template <typename FUNC>
+		void for_each_ram_region(FUNC const &fn) const
+		{
+			for (Region const *r = _ram_regions.first(); r; r = r->next())
+				fn(r->GCPhys(), r->_cb, r->pv());
+		}
+
+
 		void dump() const
 		{
 			Genode::printf("guest-physical to VMM-local RAM mappings:\n");
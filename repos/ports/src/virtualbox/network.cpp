@@ -71,13 +71,15 @@ typedef struct DRVNIC
 
 class Nic_client
 {
-	private:
+	public:
 
 		enum {
 			PACKET_SIZE = Nic::Packet_allocator::DEFAULT_PACKET_SIZE,
 			BUF_SIZE    = Nic::Session::QUEUE_SIZE * PACKET_SIZE,
 		};
 
+	private:
+
 		Nic::Packet_allocator  *_tx_block_alloc;
 		Nic::Connection         _nic;
 		Genode::Signal_receiver _sig_rec;
@@ -91,6 +93,13 @@ class Nic_client
 		PPDMINETWORKDOWN   _down_rx;
 		PPDMINETWORKCONFIG _down_rx_config;
 
+		/*
+		 * The transmit buffers are allocated and submitted by different
+		 * calls of the device emulation, which may come from the EMT and
+		 * the I/O thread of the device.
+		 */
+		Genode::Lock _tx_lock;
+
 		void _handle_rx_packet_avail(unsigned)
 		{
 			while (_nic.rx()->packet_avail() && _nic.rx()->ready_to_ack()) {
@@ -183,6 +192,8 @@ class Nic_client
 
 		int send_packet(void *packet, uint32_t packet_len)
 		{
+			Genode::Lock::Guard guard(_tx_lock);
+
 			Nic::Packet_descriptor tx_packet = _alloc_tx_packet(packet_len);
 
 			char *tx_content = _nic.tx()->packet_content(tx_packet);
@@ -193,6 +204,45 @@ class Nic_client
 
 			return VINF_SUCCESS;
 		}
+
+		/**
+		 * Allocate packet within the transmit buffer of the session
+		 *
+		 * This way, the device emulation assembles the frame in place and
+		 * 'submit_tx_packet' does not need to copy it. The packet must not
+		 * exceed 'PACKET_SIZE' because the size of the packet is shrunk to
+		 * the actual frame size at submission time.
+		 *
+		 * \return  pointer to the packet content
+		 */
+		void *alloc_tx_packet(uint32_t len, Nic::Packet_descriptor &packet)
+		{
+			Genode::Lock::Guard guard(_tx_lock);
+
+			packet = _alloc_tx_packet(len);
+			return _nic.tx()->packet_content(packet);
+		}
+
+		void submit_tx_packet(Nic::Packet_descriptor packet, uint32_t len)
+		{
+			Genode::Lock::Guard guard(_tx_lock);
+
+			/* an empty packet would not be freed on acknowledgement */
+			if (!len) {
+				_nic.tx()->release_packet(packet);
+				return;
+			}
+
+			_nic.tx()->submit_packet(Nic::Packet_descriptor(packet.offset(), len));
+			_tx_ack();
+		}
+
+		void release_tx_packet(Nic::Packet_descriptor packet)
+		{
+			Genode::Lock::Guard guard(_tx_lock);
+
+			_nic.tx()->release_packet(packet);
+		}
 };
 
 
@@ -233,10 +283,39 @@ static DECLCALLBACK(int) drvNicNetworkUp_AllocBuf(PPDMINETWORKUP pInterface, siz
 {
 	PDRVNIC pThis = PDMINETWORKUP_2_DRVNIC(pInterface);
 
+	/*
+	 * Let the device emulation assemble ordinary frames directly within the
+	 * transmit buffer of the NIC session. The packet descriptor follows the
+	 * scatter / gather buffer descriptor and is referenced by 'pvAllocator'.
+	 */
+	if (!pGso && cbMin <= Nic_client::PACKET_SIZE)
+	{
+		PPDMSCATTERGATHER pSgBuf = (PPDMSCATTERGATHER)RTMemAlloc(RT_ALIGN_Z(sizeof(*pSgBuf), 16)
+		                                                         + sizeof(Nic::Packet_descriptor));
+		if (!pSgBuf)
+			return VERR_NO_MEMORY;
+
+		Nic::Packet_descriptor *packet = (Nic::Packet_descriptor *)
+			((uint8_t *)pSgBuf + RT_ALIGN_Z(sizeof(*pSgBuf), 16));
+
+		pSgBuf->fFlags         = PDMSCATTERGATHER_FLAGS_MAGIC | PDMSCATTERGATHER_FLAGS_OWNER_1;
+		pSgBuf->cbUsed         = 0;
+		pSgBuf->cbAvailable    = cbMin;
+		pSgBuf->pvAllocator    = packet;
+		pSgBuf->pvUser         = NULL;
+		pSgBuf->cSegs          = 1;
+		pSgBuf->aSegs[0].cbSeg = cbMin;
+		pSgBuf->aSegs[0].pvSeg = pThis->nic_client->alloc_tx_packet(cbMin, *packet);
+
+		*ppSgBuf = pSgBuf;
+		return VINF_SUCCESS;
+	}
+
 	/*
 	 * Allocate a scatter / gather buffer descriptor that is immediately
 	 * followed by the buffer space of its single segment.  The GSO context
-	 * comes after that again.
+	 * comes after that again. GSO frames are carved into segments at
+	 * transmission time.
 	 */
 	PPDMSCATTERGATHER pSgBuf = (PPDMSCATTERGATHER)RTMemAlloc(RT_ALIGN_Z(sizeof(*pSgBuf), 16)
 	                                                         + RT_ALIGN_Z(cbMin, 16)
@@ -276,6 +355,11 @@ static DECLCALLBACK(int) drvNicNetworkUp_FreeBuf(PPDMINETWORKUP pInterface, PPDM
 	if (pSgBuf)
 	{
 		Assert((pSgBuf->fFlags & PDMSCATTERGATHER_FLAGS_MAGIC_MASK) == PDMSCATTERGATHER_FLAGS_MAGIC);
+
+		/* return the unsent packet to the transmit buffer */
+		if (pSgBuf->pvAllocator)
+			pThis->nic_client->release_tx_packet(*(Nic::Packet_descriptor *)pSgBuf->pvAllocator);
+
 		pSgBuf->fFlags = 0;
 		RTMemFree(pSgBuf);
 	}
@@ -298,7 +382,14 @@ static DECLCALLBACK(int) drvNicNetworkUp_SendBuf(PPDMINETWORKUP pInterface, PPDM
 	PDMDrvHlpFTSetCheckpoint(pThis->pDrvIns, FTMCHECKPOINTTYPE_NETWORK);
 
 	int rc;
-	if (!pSgBuf->pvUser)
+	if (pSgBuf->pvAllocator)
+	{
+		/* the frame already resides in the transmit buffer */
+		nic_client->submit_tx_packet(*(Nic::Packet_descriptor *)pSgBuf->pvAllocator,
+		                             pSgBuf->cbUsed);
+		rc = VINF_SUCCESS;
+	}
+	else if (!pSgBuf->pvUser)
 	{
 		Log2(("drvNicSend: pSgBuf->aSegs[0].pvSeg=%p pSgBuf->cbUsed=%#x\n"
 		      "%.*Rhxd\n", pSgBuf->aSegs[0].pvSeg, pSgBuf->cbUsed, pSgBuf->cbUsed,
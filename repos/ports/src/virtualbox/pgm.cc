@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is distributed under the terms of the GNU General Public License
  * version 2.
@@ -25,6 +25,8 @@
 #include <VBox/vmm/vm.h>
 #include <VBox/vmm/pgm.h>
 #include <VBox/vmm/rem.h>
+#include <VBox/vmm/ssm.h>
+#include <iprt/asm.h>
 #include <iprt/err.h>
 
 /* local includes */
@@ -370,6 +372,28 @@ int PGMR3PhysRegisterRam(PVM pVM, RTGCPHYS GCPhys, RTGCPHYS cb,
 }
 
 
+/*
+ * Guest RAM is backed by large dataspaces, which cannot be partially
+ * returned to our RAM session whereas the balloon driver of the guest
+ * additions hands out arbitrary single pages. Hence, we decline the
+ * requests of the balloon driver. The guest additions deal with the
+ * failure by keeping the pages. Formerly, the request ended up in the
+ * dummy implementation, which stalled the EMT for good.
+ */
+int PGMR3PhysChangeMemBalloon(PVM pVM, bool fInflate, unsigned cPages,
+                              RTGCPHYS *paPhysPage)
+{
+	static bool warned = false;
+	if (!warned) {
+		PWRN("memory ballooning not supported, declined %s of %u pages",
+		     fInflate ? "inflation" : "deflation", cPages);
+		warned = true;
+	}
+
+	return VERR_NOT_SUPPORTED;
+}
+
+
 int PGMMapSetPage(PVM pVM, RTGCPTR GCPtr, uint64_t cb, uint64_t fFlags)
 {
 	if (verbose)
@@ -388,6 +412,126 @@ RTHCPHYS PGMGetHyperCR3(PVMCPU pVCpu)
 }
 
 
+/*
+ * Saved state of the guest RAM
+ *
+ * Because the port replaces the PGM of VirtualBox, the guest RAM is not
+ * covered by any other saved-state unit. The RAM regions are saved page by
+ * page. Pages that contain zeros only - the majority of the RAM of a freshly
+ * booted guest - are represented by their type only, which keeps snapshots
+ * small and leaves those pages untouched on restore.
+ */
+
+enum {
+	PGM_SAVED_STATE_VERSION = 1,
+	PGM_STATE_PAGE_ZERO     = 0,
+	PGM_STATE_PAGE_RAW      = 1,
+};
+
+static uint64_t const PGM_STATE_END = ~0ULL;
+
+
+static DECLCALLBACK(int) pgmR3SaveExec(PVM pVM, PSSMHANDLE pSSM)
+{
+	guest_memory()->for_each_ram_region([&] (RTGCPHYS GCPhys, RTGCPHYS cb,
+	                                         void *pv) {
+		SSMR3PutU64(pSSM, GCPhys);
+		SSMR3PutU64(pSSM, cb);
+
+		for (RTGCPHYS offset = 0; offset < cb; offset += PAGE_SIZE) {
+			void const *page = (char const *)pv + offset;
+
+			if (ASMMemIsZeroPage(page)) {
+				SSMR3PutU8(pSSM, PGM_STATE_PAGE_ZERO);
+				continue;
+			}
+
+			SSMR3PutU8(pSSM, PGM_STATE_PAGE_RAW);
+			SSMR3PutMem(pSSM, page, PAGE_SIZE);
+		}
+	});
+
+	/* errors of the put operations are sticky and reported here */
+	return SSMR3PutU64(pSSM, PGM_STATE_END);
+}
+
+
+static int pgmR3LoadRegion(PSSMHANDLE pSSM, char *pv, uint64_t cb)
+{
+	for (uint64_t offset = 0; offset < cb; offset += PAGE_SIZE) {
+
+		char * const page = pv + offset;
+
+		uint8_t type = 0;
+		int rc = SSMR3GetU8(pSSM, &type);
+		if (RT_FAILURE(rc))
+			return rc;
+
+		switch (type) {
+
+		case PGM_STATE_PAGE_ZERO:
+
+			/* avoid touching pages that are still untouched */
+			if (!ASMMemIsZeroPage(page))
+				memset(page, 0, PAGE_SIZE);
+			break;
+
+		case PGM_STATE_PAGE_RAW:
+
+			rc = SSMR3GetMem(pSSM, page, PAGE_SIZE);
+			if (RT_FAILURE(rc))
+				return rc;
+			break;
+
+		default:
+			return VERR_SSM_DATA_UNIT_FORMAT_CHANGED;
+		}
+	}
+	return VINF_SUCCESS;
+}
+
+
+static DECLCALLBACK(int) pgmR3LoadExec(PVM pVM, PSSMHANDLE pSSM,
+                                       uint32_t uVersion, uint32_t uPass)
+{
+	if (uVersion != PGM_SAVED_STATE_VERSION)
+		return VERR_SSM_UNSUPPORTED_DATA_UNIT_VERSION;
+
+	for (;;) {
+
+		uint64_t GCPhys = 0, cb = 0;
+
+		int rc = SSMR3GetU64(pSSM, &GCPhys);
+		if (RT_FAILURE(rc))
+			return rc;
+
+		if (GCPhys == PGM_STATE_END)
+			return VINF_SUCCESS;
+
+		rc = SSMR3GetU64(pSSM, &cb);
+		if (RT_FAILURE(rc))
+			return rc;
+
+		/* the RAM layout is defined by the configuration of the VM */
+		char *pv = nullptr;
+		guest_memory()->for_each_ram_region([&] (RTGCPHYS r_GCPhys,
+		                                         RTGCPHYS r_cb, void *r_pv) {
+			if (r_GCPhys == GCPhys && r_cb == cb)
+				pv = (char *)r_pv; });
+
+		if (!pv) {
+			PERR("saved RAM region [0x%llx,0x%llx) does not match configuration",
+			     (unsigned long long)GCPhys, (unsigned long long)(GCPhys + cb));
+			return VERR_SSM_LOAD_CONFIG_MISMATCH;
+		}
+
+		rc = pgmR3LoadRegion(pSSM, pv, cb);
+		if (RT_FAILURE(rc))
+			return rc;
+	}
+}
+
+
 int PGMR3Init(PVM pVM)
 {
 	/*
@@ -406,6 +550,12 @@ int PGMR3Init(PVM pVM)
     int rc = PDMR3CritSectInit(pVM, &pVM->pgm.s.CritSectX, RT_SRC_POS, "PGM");
     AssertRCReturn(rc, rc);
 
+	rc = SSMR3RegisterInternal(pVM, "pgm", 1, PGM_SAVED_STATE_VERSION, 0,
+	                           NULL, NULL, NULL,
+	                           NULL, pgmR3SaveExec, NULL,
+	                           NULL, pgmR3LoadExec, NULL);
+	AssertRCReturn(rc, rc);
+
 	return VINF_SUCCESS;
 }
 
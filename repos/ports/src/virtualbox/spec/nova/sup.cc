@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2013-2014 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is distributed under the terms of the GNU General Public License
  * version 2.
@@ -15,6 +15,7 @@
 /* Genode includes */
 #include <base/printf.h>
 #include <base/semaphore.h>
+#include <cpu/memory_barrier.h>
 #include <util/flex_iterator.h>
 #include <rom_session/connection.h>
 #include <timer_session/connection.h>
@@ -43,22 +44,18 @@
 #include <libc_mem_alloc.h>
 
 
-static Genode::List<Vcpu_handler> &vcpu_handler_list()
-{
-	static Genode::List<Vcpu_handler> _inst;
-	return _inst;
-}
+/*
+ * The handler of a vCPU is looked up on each entry into the guest and on
+ * each halt, wake-up, and poke. The table is indexed by the vCPU ID, so the
+ * lookup neither iterates over the other vCPUs nor needs a lock. Each entry
+ * is written only once when the vCPU gets created.
+ */
+static Vcpu_handler * volatile vcpu_handlers[VMM_MAX_CPU_COUNT];
 
 
 static Vcpu_handler *lookup_vcpu_handler(unsigned int cpu_id)
 {
-	for (Vcpu_handler *vcpu_handler = vcpu_handler_list().first();
-	     vcpu_handler;
-	     vcpu_handler = vcpu_handler->next())
-		if (vcpu_handler->cpu_id() == cpu_id)
-			return vcpu_handler;
-
-	return 0;
+	return cpu_id < VMM_MAX_CPU_COUNT ? vcpu_handlers[cpu_id] : 0;
 }
 
 
@@ -292,7 +289,11 @@ bool create_emt_vcpu(pthread_t * pthread, size_t stack,
 
 	Assert(!(reinterpret_cast<unsigned long>(vcpu_handler) & 0xf));
 
-	vcpu_handler_list().insert(vcpu_handler);
+	AssertRelease(cpu_id < VMM_MAX_CPU_COUNT);
+
+	/* publish the handler not before it is completely constructed */
+	Genode::memory_barrier();
+	vcpu_handlers[cpu_id] = vcpu_handler;
 
 	*pthread = vcpu_handler;
 	return true;
@@ -74,8 +74,7 @@ extern "C" int MMIO2_MAPPED_SYNC(PVM pVM, RTGCPHYS GCPhys, size_t cbWrite,
                                  bool &writeable);
 
 
-class Vcpu_handler : public Vmm::Vcpu_dispatcher<pthread>,
-                     public Genode::List<Vcpu_handler>::Element
+class Vcpu_handler : public Vmm::Vcpu_dispatcher<pthread>
 {
 	private:
 
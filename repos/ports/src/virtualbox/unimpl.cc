@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is distributed under the terms of the GNU General Public License
  * version 2.
@@ -82,7 +82,6 @@ DUMMY(PGMR3QueryMemoryStats)
 
 DUMMY(PGMR3PhysAllocateHandyPages)
 DUMMY(PGMR3PhysAllocateLargeHandyPage)
-DUMMY(PGMR3PhysChangeMemBalloon)
 DUMMY(PGMR3PhysChunkMap)
 DUMMY(PGMR3PhysGCPhys2CCPtrExternal)
 DUMMY(PGMR3PhysGCPhys2CCPtrReadOnlyExternal)
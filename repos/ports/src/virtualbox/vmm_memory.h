@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2013 Genode Labs GmbH
+ * Copyright (C) 2013-2015 Genode Labs GmbH
  *
  * This file is distributed under the terms of the GNU General Public License
  * version 2.
@@ -26,6 +26,7 @@
 #include <base/env.h>
 #include <base/lock.h>
 #include <util/list.h>
+#include <util/touch.h>
 #include <rm_session/connection.h>
 
 #define PAGE_SIZE BACKUP_PAGESIZE
@@ -148,9 +149,26 @@ class Vmm_memory
 			return alloc(cb, pDevIns, ~0U);
 		}
 
+		/**
+		 * Allocate guest RAM
+		 *
+		 * The RAM is populated within the VMM upfront. A fault of the guest
+		 * can be resolved only with memory present in the VMM. Without
+		 * populating, the first guest access of each page would involve an
+		 * additional page fault of the VMM within the handler of the vCPU.
+		 * Because the RAM is backed by large dataspaces with natural
+		 * alignment, the kernel can map it with large pages to the VMM and,
+		 * in turn, the vCPU handlers map the guest RAM with large pages.
+		 */
 		void *alloc_ram(size_t cb)
 		{
-			return alloc(cb, 0, ~0U);
+			void *pv = alloc(cb, 0, ~0U);
+
+			enum { TOUCH_STRIDE = 0x1000UL };
+			for (size_t offset = 0; offset < cb; offset += TOUCH_STRIDE)
+				Genode::touch_read((unsigned char *)pv + offset);
+
+			return pv;
 		}
 
 		bool add_handler(RTGCPHYS vm_phys, size_t size,